@@ -0,0 +1,484 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_ALLOCATION_TRACKER_CPP_H
+#define GASHA_INCLUDED_ALLOCATION_TRACKER_CPP_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// allocation_tracker.cpp.h
+// メモリアロケート追跡【関数定義部】
+//
+// ※クラスのインスタンス化が必要な場所でインクルード。
+// ※基本的に、ヘッダーファイル内でのインクルード禁止。
+// 　（コンパイル・リンク時間への影響を気にしないならOK）
+// ※明示的なインスタンス化を避けたい場合は、ヘッダーファイルと共にインクルード。
+// 　（この場合、実際に使用するメンバー関数しかインスタンス化されないので、対象クラスに不要なインターフェースを実装しなくても良い）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/allocation_tracker.inl>//メモリアロケート追跡【インライン関数／テンプレート関数定義部】
+
+#include <gasha/intro_sort.h>//イントロソート
+#include <gasha/lock_common.h>//ロック共通設定：defaultContextSwitch()
+#include <gasha/string.h>//文字列処理：spprintf()
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//メモリアロケート追跡クラス
+
+//集計リセット
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+void allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::reset()
+{
+	auto reset_stat = [](statInfo& info)
+	{
+		info.m_key.store(0);
+		info.m_isReady.store(false);
+		info.reset();
+	};
+	for (std::size_t index = 0; index < ADAPTER_TABLE_SIZE; ++index)
+	{
+		adapterInfo& info = m_adapters[index];
+		reset_stat(info);
+		info.m_name = nullptr;
+		info.m_mode = nullptr;
+	}
+	for (std::size_t index = 0; index < SITE_TABLE_SIZE; ++index)
+	{
+		siteInfo& info = m_sites[index];
+		reset_stat(info);
+		info.m_adapterName = nullptr;
+		info.m_adapterMode = nullptr;
+		info.m_fileName = nullptr;
+		info.m_funcName = nullptr;
+		info.m_cpName = nullptr;
+		info.m_typeName = nullptr;
+		info.m_adapterIndex = INVALID_INDEX;
+	}
+	for (std::size_t index = 0; index < PTR_TABLE_SIZE; ++index)
+	{
+		ptrInfo& info = m_ptrs[index];
+		info.m_ptr.store(EMPTY_PTR);
+		info.m_size = 0;
+		info.m_siteIndex = INVALID_INDEX;
+		info.m_adapterIndex = INVALID_INDEX;
+	}
+	//その他のコールポイント
+	reset_stat(m_otherSite);
+	m_otherSite.m_adapterName = "(overflow)";
+	m_otherSite.m_adapterMode = "(overflow)";
+	m_otherSite.m_fileName = "(overflow)";
+	m_otherSite.m_funcName = "(overflow)";
+	m_otherSite.m_cpName = "(overflow)";
+	m_otherSite.m_typeName = "(overflow)";
+	m_otherSite.m_adapterIndex = INVALID_INDEX;
+	//全体
+	reset_stat(m_total);
+	m_siteNum.store(0);
+	m_adapterNum.store(0);
+	m_untrackedCount.store(0);
+	m_unknownFreeCount.store(0);
+	m_elapsedTime.reset();
+}
+
+//new時のコールバック
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+void allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::atNew(const GASHA_ iAllocatorAdapter& adapter, const void* p, const std::size_t size, const GASHA_ debugAllocationInfo* info)
+{
+	if (!p)//確保に失敗したメモリは集計しない
+		return;
+	const std::size_t site_index = findOrAddSite(adapter, info);
+	const std::size_t adapter_index = site_index == INVALID_INDEX ? findOrAddAdapter(adapter) : m_sites[site_index].m_adapterIndex;
+	if (!addPtr(p, size, site_index, adapter_index))//ポインタテーブルに空きがない
+	{
+		m_untrackedCount.fetch_add(1);
+		return;
+	}
+	site(site_index).addAlloc(size);
+	if (adapter_index != INVALID_INDEX)
+		m_adapters[adapter_index].addAlloc(size);
+	m_total.addAlloc(size);
+}
+
+//delete時のコールバック
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+void allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::atDelete(const void* p)
+{
+	if (!p)//nullptrの解放は集計しない
+		return;
+	std::size_t size = 0;
+	std::size_t site_index = INVALID_INDEX;
+	std::size_t adapter_index = INVALID_INDEX;
+	if (!removePtr(p, size, site_index, adapter_index))//記録のないポインタ
+	{
+		m_unknownFreeCount.fetch_add(1);
+		return;
+	}
+	site(site_index).addFree(size);
+	if (adapter_index != INVALID_INDEX)
+		m_adapters[adapter_index].addFree(size);
+	m_total.addFree(size);
+}
+
+//コールポイントを検索／登録
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+std::size_t allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::findOrAddSite(const GASHA_ iAllocatorAdapter& adapter, const GASHA_ debugAllocationInfo* info)
+{
+	const char* adapter_name = adapter.name();
+	const char* adapter_mode = adapter.mode();
+	const char* file_name = nullptr;
+	const char* func_name = nullptr;
+	const char* cp_name = nullptr;
+	const char* type_name = nullptr;
+#ifdef GASHA_DEBUG_FEATURE_IS_ENABLED
+	if (info)
+	{
+		file_name = info->m_fileName;
+		func_name = info->m_funcName;
+		cp_name = info->m_cpName;
+		type_name = info->m_typeName;
+	}
+#endif//GASHA_DEBUG_FEATURE_IS_ENABLED
+	key_type key = 0xcbf29ce484222325ull;
+	key = mixKey(key, adapter_name);
+	key = mixKey(key, adapter_mode);
+	key = mixKey(key, file_name);
+	key = mixKey(key, func_name);
+	key = mixKey(key, cp_name);
+	key = mixKey(key, type_name);
+	key = finishKey(key);
+	bool is_new = false;
+	const std::size_t index = claimKey(m_sites, SITE_TABLE_SIZE, key, is_new);
+	if (index == INVALID_INDEX || !is_new)
+		return index;
+	//新規登録
+	siteInfo& site_info = m_sites[index];
+	site_info.m_adapterName = adapter_name;
+	site_info.m_adapterMode = adapter_mode;
+	site_info.m_fileName = file_name;
+	site_info.m_funcName = func_name;
+	site_info.m_cpName = cp_name;
+	site_info.m_typeName = type_name;
+	site_info.m_adapterIndex = findOrAddAdapter(adapter);
+	site_info.m_isReady.store(true);//登録完了
+	m_siteNum.fetch_add(1);
+	return index;
+}
+
+//アロケータアダプタを検索／登録
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+std::size_t allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::findOrAddAdapter(const GASHA_ iAllocatorAdapter& adapter)
+{
+	const char* adapter_name = adapter.name();
+	const char* adapter_mode = adapter.mode();
+	key_type key = 0xcbf29ce484222325ull;
+	key = mixKey(key, adapter_name);
+	key = mixKey(key, adapter_mode);
+	key = finishKey(key);
+	bool is_new = false;
+	const std::size_t index = claimKey(m_adapters, ADAPTER_TABLE_SIZE, key, is_new);
+	if (index == INVALID_INDEX || !is_new)
+		return index;
+	//新規登録
+	adapterInfo& adapter_info = m_adapters[index];
+	adapter_info.m_name = adapter_name;
+	adapter_info.m_mode = adapter_mode;
+	adapter_info.m_isReady.store(true);//登録完了
+	m_adapterNum.fetch_add(1);
+	return index;
+}
+
+//キーを検索／登録（テーブル共通処理）
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+template<class INFO>
+std::size_t allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::claimKey(INFO* table, const std::size_t table_size, const key_type key, bool& is_new)
+{
+	is_new = false;
+	std::size_t index = static_cast<std::size_t>(key) & (table_size - 1);
+	for (std::size_t i = 0; i < table_size; ++i)
+	{
+		INFO& info = table[index];
+		key_type now_key = info.m_key.load();
+		if (now_key == 0)//未使用
+		{
+			if (info.m_key.compare_exchange_strong(now_key, key))//キーのCAS
+			{
+				is_new = true;
+				return index;
+			}
+			//他のスレッドが先に登録した
+		}
+		if (now_key == key)//登録済み
+		{
+			//登録完了（情報の設定完了）を待つ
+			while (!info.m_isReady.load())
+				GASHA_ defaultContextSwitch();
+			return index;
+		}
+		index = (index + 1) & (table_size - 1);
+	}
+	return INVALID_INDEX;//テーブルが満杯
+}
+
+//ポインタを記録
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+bool allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::addPtr(const void* p, const std::size_t size, const std::size_t site_index, const std::size_t adapter_index)
+{
+	const std::uintptr_t ptr = reinterpret_cast<std::uintptr_t>(p);
+	std::size_t index = ptrHash(ptr);
+	for (std::size_t i = 0; i < PTR_PROBE_MAX; ++i)
+	{
+		ptrInfo& info = m_ptrs[index];
+		std::uintptr_t now_ptr = info.m_ptr.load();
+		//未使用か削除済みの要素を「書き込み中」にして専有
+		//※確保中の同じポインタが二重に記録されることはないので、削除済みの要素も再利用できる
+		while (now_ptr == EMPTY_PTR || now_ptr == DELETED_PTR)
+		{
+			if (info.m_ptr.compare_exchange_weak(now_ptr, BUSY_PTR))//ポインタのCAS
+			{
+				//情報を書き込んでから、ポインタを書き込む（公開する）
+				//※解放されたアドレスが別のスレッドで再利用された場合など、並行する削除処理が
+				//　書き込み途中の情報を参照しないようにする
+				info.m_size = size;
+				info.m_siteIndex = site_index;
+				info.m_adapterIndex = adapter_index;
+				info.m_ptr.store(ptr, std::memory_order_release);
+				return true;
+			}
+		}
+		index = (index + 1) & (PTR_TABLE_SIZE - 1);
+	}
+	return false;//探索範囲に空きがない
+}
+
+//ポインタの記録を削除
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+bool allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::removePtr(const void* p, std::size_t& size, std::size_t& site_index, std::size_t& adapter_index)
+{
+	const std::uintptr_t ptr = reinterpret_cast<std::uintptr_t>(p);
+	std::size_t index = ptrHash(ptr);
+	//※記録時と同じ探索範囲（PTR_PROBE_MAX）だけを探索する
+	//※削除済み（DELETED_PTR）と書き込み中（BUSY_PTR）の要素は読み飛ばす
+	for (std::size_t i = 0; i < PTR_PROBE_MAX; ++i)
+	{
+		ptrInfo& info = m_ptrs[index];
+		std::uintptr_t now_ptr = info.m_ptr.load(std::memory_order_acquire);
+		if (now_ptr == EMPTY_PTR)//未使用の要素に到達したら、記録なし
+			return false;
+		if (now_ptr == ptr)//※acquire により、記録時に書き込んだ情報を参照できる
+		{
+			size = info.m_size;
+			site_index = info.m_siteIndex;
+			adapter_index = info.m_adapterIndex;
+			return info.m_ptr.compare_exchange_strong(now_ptr, DELETED_PTR);//削除済みにする
+		}
+		index = (index + 1) & (PTR_TABLE_SIZE - 1);
+	}
+	return false;//記録なし
+}
+
+//デバッグ情報作成
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+std::size_t allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::debugInfo(char* message, const std::size_t max_size) const
+{
+	typedef unsigned long long ull;
+	std::size_t message_len = 0;
+	const GASHA_ sec_t elapsed_time = elapsed();
+	GASHA_ spprintf(message, max_size, message_len, "----- Debug-info for allocationTracker -----\n");
+	GASHA_ spprintf(message, max_size, message_len, "elapsed=%.3lf sec, sites=%d/%d, adapters=%d/%d, untracked=%llu, unknownFree=%llu\n", static_cast<double>(elapsed_time), static_cast<int>(siteNum()), static_cast<int>(SITE_TABLE_SIZE), static_cast<int>(adapterNum()), static_cast<int>(ADAPTER_TABLE_SIZE), static_cast<ull>(untrackedCount()), static_cast<ull>(unknownFreeCount()));
+	auto print_stat = [&message, &max_size, &message_len, &elapsed_time](const statInfo& info)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "live=%llu bytes(%llu), peak=%llu bytes, alloc=%llu bytes(%llu), free=%llu bytes(%llu), alloc/s=%.1lf, free/s=%.1lf", static_cast<ull>(info.liveBytes()), static_cast<ull>(info.liveCount()), static_cast<ull>(info.peakLiveBytes()), static_cast<ull>(info.allocBytes()), static_cast<ull>(info.allocCount()), static_cast<ull>(info.freeBytes()), static_cast<ull>(info.freeCount()), info.allocRate(elapsed_time), info.freeRate(elapsed_time));
+	};
+	GASHA_ spprintf(message, max_size, message_len, "[Total] ");
+	print_stat(m_total);
+	GASHA_ spprintf(message, max_size, message_len, "\n");
+	//アロケータアダプタごと
+	GASHA_ spprintf(message, max_size, message_len, "[Adapters]\n");
+	forEachAdapter([&message, &max_size, &message_len, &print_stat](const adapterInfo& info)
+		{
+			GASHA_ spprintf(message, max_size, message_len, "  %s(%s): ", labelOf(info.name()), labelOf(info.mode()));
+			print_stat(info);
+			GASHA_ spprintf(message, max_size, message_len, "\n");
+		}
+	);
+	//コールポイントごと（生存バイト数の降順）
+	//※集計中に値が変わっても整列が崩れないように、生存バイト数を先に取得してから整列する
+	struct sortInfo
+	{
+		counter_type m_liveBytes;//生存バイト数
+		const siteInfo* m_site;//コールポイント集計情報
+	};
+	sortInfo sorted[SITE_TABLE_SIZE + 1];
+	std::size_t sorted_num = 0;
+	forEachSite([&sorted, &sorted_num](const siteInfo& info)
+		{
+			sortInfo& sort_info = sorted[sorted_num++];
+			sort_info.m_liveBytes = info.liveBytes();
+			sort_info.m_site = &info;
+		}
+	);
+	GASHA_ introSort(sorted, sorted_num, [](const sortInfo& lhs, const sortInfo& rhs) -> bool { return lhs.m_liveBytes > rhs.m_liveBytes; });
+	GASHA_ spprintf(message, max_size, message_len, "[Call-points]\n");
+	for (std::size_t rank = 0; rank < sorted_num; ++rank)
+	{
+		const siteInfo& info = *sorted[rank].m_site;
+		GASHA_ spprintf(message, max_size, message_len, "  #%d %s(%s) %s %s \"%s\" <%s>: ", static_cast<int>(rank + 1), labelOf(info.adapterName()), labelOf(info.adapterMode()), labelOf(info.fileName()), labelOf(info.funcName()), labelOf(info.cpName()), labelOf(info.typeName()));
+		print_stat(info);
+		GASHA_ spprintf(message, max_size, message_len, "\n");
+	}
+	GASHA_ spprintf(message, max_size, message_len, "--------------------------------------------");//最終行改行なし
+	return message_len;
+}
+
+//FlameGraph用の折りたたみスタック形式で出力
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+std::size_t allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::writeFlameGraph(char* message, const std::size_t max_size, const allocationTrackerValue_type value_type) const
+{
+	std::size_t message_len = 0;
+	forEachSite([&message, &max_size, &message_len, &value_type](const siteInfo& info)
+		{
+			counter_type value = 0;
+			switch (value_type)
+			{
+			case trackLiveBytes: value = info.liveBytes(); break;
+			case trackLiveCount: value = info.liveCount(); break;
+			case trackAllocBytes: value = info.allocBytes(); break;
+			case trackAllocCount: value = info.allocCount(); break;
+			}
+			if (value == 0)
+				return;
+			GASHA_ spprintf(message, max_size, message_len, "%s(%s);%s;%s;%s;%s %llu\n", labelOf(info.adapterName()), labelOf(info.adapterMode()), labelOf(info.fileName()), labelOf(info.funcName()), labelOf(info.cpName()), labelOf(info.typeName()), static_cast<unsigned long long>(value));
+		}
+	);
+	return message_len;
+}
+
+//pprof用のヒーププロファイル形式で出力
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+std::size_t allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::writeHeapProfile(char* message, const std::size_t max_size) const
+{
+	typedef unsigned long long ull;
+	//擬似アドレス
+	//※コールポイントとアロケータアダプタでアドレス空間を分ける
+	static const ull SITE_ADDR_BASE = 0x10000000ull;
+	static const ull ADAPTER_ADDR_BASE = 0x20000000ull;
+	auto site_addr = [this](const siteInfo& info) -> ull
+	{
+		return &info == &m_otherSite ? SITE_ADDR_BASE : SITE_ADDR_BASE + static_cast<ull>(&info - m_sites + 1) * 0x10ull;
+	};
+	auto adapter_addr = [](const std::size_t index) -> ull
+	{
+		return ADAPTER_ADDR_BASE + static_cast<ull>(index + 1) * 0x10ull;
+	};
+	std::size_t message_len = 0;
+	//シンボル節
+	GASHA_ spprintf(message, max_size, message_len, "--- symbol\n");
+	GASHA_ spprintf(message, max_size, message_len, "binary=allocationTracker\n");
+	forEachSite([&message, &max_size, &message_len, &site_addr](const siteInfo& info)
+		{
+			GASHA_ spprintf(message, max_size, message_len, "0x%016llx %s@%s<%s>(%s)\n", site_addr(info), labelOf(info.funcName()), labelOf(info.cpName()), labelOf(info.typeName()), labelOf(info.fileName()));
+		}
+	);
+	for (std::size_t index = 0; index < ADAPTER_TABLE_SIZE; ++index)
+	{
+		const adapterInfo& info = m_adapters[index];
+		if (info.isReady())
+			GASHA_ spprintf(message, max_size, message_len, "0x%016llx %s(%s)\n", adapter_addr(index), labelOf(info.name()), labelOf(info.mode()));
+	}
+	GASHA_ spprintf(message, max_size, message_len, "---\n");
+	//ヒープ節
+	GASHA_ spprintf(message, max_size, message_len, "--- heap\n");
+	GASHA_ spprintf(message, max_size, message_len, "heap profile: %6llu: %8llu [%6llu: %8llu] @ heapprofile\n", static_cast<ull>(m_total.liveCount()), static_cast<ull>(m_total.liveBytes()), static_cast<ull>(m_total.allocCount()), static_cast<ull>(m_total.allocBytes()));
+	forEachSite([&message, &max_size, &message_len, &site_addr, &adapter_addr](const siteInfo& info)
+		{
+			GASHA_ spprintf(message, max_size, message_len, "%6llu: %8llu [%6llu: %8llu] @ 0x%016llx", static_cast<ull>(info.liveCount()), static_cast<ull>(info.liveBytes()), static_cast<ull>(info.allocCount()), static_cast<ull>(info.allocBytes()), site_addr(info));
+			if (info.adapterIndex() != INVALID_INDEX)
+				GASHA_ spprintf(message, max_size, message_len, " 0x%016llx", adapter_addr(info.adapterIndex()));
+			GASHA_ spprintf(message, max_size, message_len, "\n");
+		}
+	);
+	return message_len;
+}
+
+//コンストラクタ
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::allocationTracker() :
+	m_observer(),
+	m_elapsedTime()
+{
+	reset();
+	//デバッグ観察者のコールバックを設定
+	m_observer.m_atNew = [this](const GASHA_ iAllocatorAdapter& adapter, const void* p, std::size_t size, std::size_t align, const GASHA_ newMethod_type method, const GASHA_ debugAllocationInfo* info)
+	{
+		atNew(adapter, p, size, info);
+	};
+	m_observer.m_atDelete = [this](const GASHA_ iAllocatorAdapter& adapter, const void* p, const GASHA_ deleteMethod_type method, const GASHA_ debugAllocationInfo* info)
+	{
+		atDelete(p);
+	};
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//----------------------------------------
+//明示的なインスタンス化
+
+//メモリアロケート追跡の明示的なインスタンス化用マクロ
+#define GASHA_INSTANCING_allocationTracker() \
+	template class GASHA_ allocationTracker<>;
+//※テーブルサイズ指定版
+#define GASHA_INSTANCING_allocationTracker_withSize(_SITE_TABLE_SIZE, _PTR_TABLE_SIZE) \
+	template class GASHA_ allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>;
+
+//--------------------------------------------------------------------------------
+//【注】明示的インスタンス化に失敗する場合
+// ※このコメントは、「明示的なインスタンス化マクロ」が定義されている全てのソースコードに
+// 　同じ内容のものをコピーしています。
+//--------------------------------------------------------------------------------
+//【原因①】
+// 　対象クラスに必要なインターフェースが実装されていない。
+//
+// 　例えば、ソート処理に必要な「bool operator<(const value_type&) const」か「friend bool operator<(const value_type&, const value_type&)」や、
+// 　探索処理に必要な「bool operator==(const key_type&) const」か「friend bool operator==(const value_type&, const key_type&)」。
+//
+// 　明示的なインスタンス化を行う場合、実際に使用しない関数のためのインターフェースも確実に実装する必要がある。
+// 　逆に言えば、明示的なインスタンス化を行わない場合、使用しない関数のためのインターフェースを実装する必要がない。
+//
+//【対策１】
+// 　インターフェースをきちんと実装する。
+// 　（無難だが、手間がかかる。）
+//
+//【対策２】
+// 　明示的なインスタンス化を行わずに、.cpp.h をテンプレート使用前にインクルードする。
+// 　（手間がかからないが、コンパイル時の依存ファイルが増えるので、コンパイルが遅くなる可能性がある。）
+//
+//--------------------------------------------------------------------------------
+//【原因②】
+// 　同じ型のインスタンスが複数作成されている。
+//
+// 　通常、テンプレートクラス／関数の同じ型のインスタンスが複数作られても、リンク時に一つにまとめられるため問題がない。
+// 　しかし、一つのソースファイルの中で複数のインスタンスが生成されると、コンパイラによってはエラーになる。
+//   GCCの場合のエラーメッセージ例：（VC++ではエラーにならない）
+// 　  source_file.cpp.h:114:17: エラー: duplicate explicit instantiation of ‘class templateClass<>’ [-fpermissive]
+//
+//【対策１】
+// 　別のファイルに分けてインスタンス化する。
+// 　（コンパイルへの影響が少なく、良い方法だが、無駄にファイル数が増える可能性がある。）
+//
+//【対策２】
+// 　明示的なインスタンス化を行わずに、.cpp.h をテンプレート使用前にインクルードする。
+// 　（手間がかからないが、コンパイル時の依存ファイルが増えるので、コンパイルが遅くなる可能性がある。）
+//
+//【対策３】
+// 　GCCのコンパイラオプションに、 -fpermissive を指定し、エラーを警告に格下げする。
+// 　（最も手間がかからないが、常時多数の警告が出る状態になりかねないので注意。）
+//--------------------------------------------------------------------------------
+
+#endif//GASHA_INCLUDED_ALLOCATION_TRACKER_CPP_H
+
+// End of file
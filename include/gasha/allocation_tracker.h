@@ -0,0 +1,313 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_ALLOCATION_TRACKER_H
+#define GASHA_INCLUDED_ALLOCATION_TRACKER_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// allocation_tracker.h
+// メモリアロケート追跡【宣言部】
+//
+// ※クラスをインスタンス化する際は、別途 .cpp.h ファイルをインクルードする必要あり。
+// ※明示的なインスタンス化を避けたい場合は、ヘッダーファイルと共にインクルード。
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/poly_allocator.h>//多態アロケータ：debugAllocationObserver
+#include <gasha/chrono.h>//時間処理ユーティリティ
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint32_t, std::uint64_t, std::uintptr_t
+#include <atomic>//C++11 std::atomic
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//メモリアロケート追跡
+//--------------------------------------------------------------------------------
+//【概要】
+//・多態アロケータのデバッグ観察者（debugAllocationObserver）のコールバックを受け取り、
+//  コールポイント（アロケータ＋ソースファイル＋関数＋コールポイント名＋型）ごと、
+//  および、アロケータアダプタごとに、メモリ確保状況を集計する。
+//・集計項目は、アロケート数／バイト数、解放数／バイト数、生存数／バイト数、生存バイト数のピーク、
+//  および、経過時間に基づくアロケート／解放の頻度（チャーンレート）。
+//・集計結果は、下記の形式でテキスト出力できる。
+//    - debugInfo()        ... 生存バイト数の降順に並べた一覧
+//    - writeFlameGraph()  ... FlameGraph（flamegraph.pl）用の折りたたみスタック形式
+//    - writeHeapProfile() ... pprof（gperftools）用のシンボル付きヒーププロファイル形式
+//--------------------------------------------------------------------------------
+//【実装要件】
+//・コールバックはメモリ確保／解放のたびに呼び出されるため、ロックを使用しない。
+//  集計テーブルとポインタテーブルは、いずれも固定サイズの開番地法（線形探索）のハッシュテーブルとする。
+//・ポインタテーブルはロックフリー。要素を「書き込み中」の印で専有してからサイズなどを書き込み、
+//  最後にポインタを書き込む（release）ことで、削除時に書き込み途中の情報を参照しないようにする。
+//・ポインタテーブルの削除済み要素は、未使用に戻さずに再利用する。（並行する登録と競合せずに未使用に戻せないため）
+//  その代わり、探索の長さを PTR_PROBE_MAX 要素までに制限し、長時間の実行で削除済み要素が増えても、
+//  記録のないポインタの解放で全ての要素を探索しないようにする。（範囲内に空きがなければ「追跡不能数」として数える）
+//・集計テーブル（コールポイント／アロケータアダプタ）は、登録済みのキーの参照はロックフリーだが、
+//  初回登録時のみ、同じキーを先に登録したスレッドが情報を設定し終えるまで待つ（スピンウェイト）。
+//  そのため、厳密にはロックフリーではない。（待つのは、コールポイントごとに最初の一回の競合時のみ）
+//・コールバック中に new / delete を使用しない。（再帰呼び出しになるため）
+//・delete 時のコールバックにはサイズが渡されないため、確保中のポインタをポインタテーブルに記録し、
+//  delete 時にサイズとコールポイントを引き当てる。
+//・コールポイントの識別には、文字列のアドレスを使用する。（文字列リテラルであることを前提とする）
+//  64ビットのハッシュ値のみで識別するため、衝突した場合は同じコールポイントとして集計される点に注意。
+//・テーブルが満杯になった場合、コールポイントは「その他」として集計し、
+//  ポインタは記録せずに「追跡不能数」として数える。
+//--------------------------------------------------------------------------------
+//【使用法】
+//  static allocationTracker<> s_tracker;//十分なサイズのテーブルを持つため、静的変数にすることを推奨
+//  polyAllocator poly_allocator(adapter);
+//  poly_allocator.setDebugObserver(s_tracker.observer());
+//  ...
+//  s_tracker.writeFlameGraph(buff, sizeof(buff));//flamegraph.pl に渡す
+//※多態アロケータが無効（GASHA_ENABLE_POLY_ALLOCATOR 未定義）の場合、コールバックは呼び出されない。
+//※コールポイント名などのデバッグ情報は、GASHA_NEW / GASHA_DELETE マクロを使用し、
+//　かつ、デバッグ機能が有効（GASHA_DEBUG_FEATURE_IS_ENABLED 定義）な時のみ記録される。
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//FlameGraph出力時の値の種類
+enum allocationTrackerValue_type
+{
+	trackLiveBytes,//生存バイト数
+	trackLiveCount,//生存数
+	trackAllocBytes,//アロケートバイト数（累計）
+	trackAllocCount,//アロケート数（累計）
+};
+
+//----------------------------------------
+//メモリアロケート追跡クラス
+//※SITE_TABLE_SIZE：コールポイントの集計テーブルサイズ（2のべき乗）
+//※PTR_TABLE_SIZE：確保中のポインタの記録テーブルサイズ（2のべき乗）
+//　同時に確保中のポインタの最大数に対して、十分な余裕を持たせること。
+template<std::size_t _SITE_TABLE_SIZE = 1024, std::size_t _PTR_TABLE_SIZE = 65536>
+class allocationTracker
+{
+public:
+	//型
+	typedef std::uint64_t key_type;//キー型
+	typedef std::uint64_t counter_type;//カウンタ型
+
+public:
+	//定数
+	static const std::size_t SITE_TABLE_SIZE = _SITE_TABLE_SIZE;//コールポイントの集計テーブルサイズ
+	static const std::size_t PTR_TABLE_SIZE = _PTR_TABLE_SIZE;//ポインタの記録テーブルサイズ
+	static const std::size_t ADAPTER_TABLE_SIZE = 64;//アロケータアダプタの集計テーブルサイズ
+	static const std::size_t PTR_PROBE_MAX = PTR_TABLE_SIZE < 128 ? PTR_TABLE_SIZE : 128;//ポインタテーブルの最大探索数
+	static const std::size_t INVALID_INDEX = static_cast<std::size_t>(-1);//無効なインデックス
+	static_assert(SITE_TABLE_SIZE > 0 && (SITE_TABLE_SIZE & (SITE_TABLE_SIZE - 1)) == 0, "SITE_TABLE_SIZE must be power of 2.");
+	static_assert(PTR_TABLE_SIZE > 0 && (PTR_TABLE_SIZE & (PTR_TABLE_SIZE - 1)) == 0, "PTR_TABLE_SIZE must be power of 2.");
+
+public:
+	//----------------------------------------
+	//集計情報型
+	class statInfo
+	{
+		friend class allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>;
+	public:
+		//アクセッサ
+		inline counter_type allocCount() const { return m_allocCount.load(std::memory_order_relaxed); }//アロケート数（累計）
+		inline counter_type allocBytes() const { return m_allocBytes.load(std::memory_order_relaxed); }//アロケートバイト数（累計）
+		inline counter_type freeCount() const { return m_freeCount.load(std::memory_order_relaxed); }//解放数（累計）
+		inline counter_type freeBytes() const { return m_freeBytes.load(std::memory_order_relaxed); }//解放バイト数（累計）
+		inline counter_type liveCount() const;//生存数
+		inline counter_type liveBytes() const;//生存バイト数
+		inline counter_type peakLiveBytes() const { return m_peakLiveBytes.load(std::memory_order_relaxed); }//生存バイト数のピーク
+		inline double allocRate(const GASHA_ sec_t elapsed_time) const;//アロケート頻度（回／秒）
+		inline double freeRate(const GASHA_ sec_t elapsed_time) const;//解放頻度（回／秒）
+		inline bool isReady() const { return m_isReady.load(); }//登録済みか？
+	private:
+		//集計
+		inline void addAlloc(const std::size_t size);
+		inline void addFree(const std::size_t size);
+		//リセット
+		inline void reset();
+	private:
+		//フィールド
+		std::atomic<key_type> m_key;//キー ※0 で未使用
+		std::atomic<bool> m_isReady;//登録済み
+		std::atomic<counter_type> m_allocCount;//アロケート数
+		std::atomic<counter_type> m_allocBytes;//アロケートバイト数
+		std::atomic<counter_type> m_freeCount;//解放数
+		std::atomic<counter_type> m_freeBytes;//解放バイト数
+		std::atomic<counter_type> m_peakLiveBytes;//生存バイト数のピーク
+	};
+
+	//----------------------------------------
+	//アロケータアダプタ集計情報型
+	class adapterInfo : public statInfo
+	{
+		friend class allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>;
+	public:
+		//アクセッサ
+		inline const char* name() const { return m_name; }//アロケータ名
+		inline const char* mode() const { return m_mode; }//アロケータの実装モード名
+	private:
+		//フィールド
+		const char* m_name;//アロケータ名
+		const char* m_mode;//アロケータの実装モード名
+	};
+
+	//----------------------------------------
+	//コールポイント集計情報型
+	class siteInfo : public statInfo
+	{
+		friend class allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>;
+	public:
+		//アクセッサ
+		inline const char* adapterName() const { return m_adapterName; }//アロケータ名
+		inline const char* adapterMode() const { return m_adapterMode; }//アロケータの実装モード名
+		inline const char* fileName() const { return m_fileName; }//呼び出し元ソースファイル名
+		inline const char* funcName() const { return m_funcName; }//呼び出し元関数名
+		inline const char* cpName() const { return m_cpName; }//コールポイント名
+		inline const char* typeName() const { return m_typeName; }//型名
+		inline std::size_t adapterIndex() const { return m_adapterIndex; }//アロケータアダプタ集計情報のインデックス
+	private:
+		//フィールド
+		const char* m_adapterName;//アロケータ名
+		const char* m_adapterMode;//アロケータの実装モード名
+		const char* m_fileName;//呼び出し元ソースファイル名
+		const char* m_funcName;//呼び出し元関数名
+		const char* m_cpName;//コールポイント名
+		const char* m_typeName;//型名
+		std::size_t m_adapterIndex;//アロケータアダプタ集計情報のインデックス
+	};
+
+private:
+	//----------------------------------------
+	//ポインタ記録型
+	struct ptrInfo
+	{
+		std::atomic<std::uintptr_t> m_ptr;//ポインタ ※EMPTY_PTR で未使用、DELETED_PTR で削除済み、BUSY_PTR で書き込み中
+		std::size_t m_size;//サイズ
+		std::size_t m_siteIndex;//コールポイント集計情報のインデックス
+		std::size_t m_adapterIndex;//アロケータアダプタ集計情報のインデックス
+	};
+	static const std::uintptr_t EMPTY_PTR = 0;//未使用
+	static const std::uintptr_t DELETED_PTR = 1;//削除済み
+	static const std::uintptr_t BUSY_PTR = 2;//書き込み中
+
+public:
+	//アクセッサ
+	inline const GASHA_ debugAllocationObserver& observer() const { return m_observer; }//デバッグ観察者 ※多態アロケータにセットして使用
+	inline GASHA_ sec_t elapsed() const;//集計開始からの経過時間
+	inline std::size_t siteNum() const { return m_siteNum.load(); }//登録済みのコールポイント数
+	inline std::size_t adapterNum() const { return m_adapterNum.load(); }//登録済みのアロケータアダプタ数
+	inline const statInfo& total() const { return m_total; }//全体の集計情報
+	inline const siteInfo& otherSite() const { return m_otherSite; }//集計テーブルに登録できなかったコールポイントの集計情報
+	inline counter_type untrackedCount() const { return m_untrackedCount.load(); }//ポインタテーブルに空きがなく追跡できなかったアロケート数
+	inline counter_type unknownFreeCount() const { return m_unknownFreeCount.load(); }//記録のないポインタの解放数
+
+public:
+	//メソッド
+
+	//コールポイント集計情報を列挙
+	//※FUNCTOR は void(const siteInfo& info) 形式
+	template<class FUNCTOR>
+	void forEachSite(FUNCTOR functor) const;
+	//アロケータアダプタ集計情報を列挙
+	//※FUNCTOR は void(const adapterInfo& info) 形式
+	template<class FUNCTOR>
+	void forEachAdapter(FUNCTOR functor) const;
+
+	//集計リセット
+	//※コールポイントとポインタの記録も全て破棄し、経過時間もリセットする。
+	//　リセット前に確保されたメモリの解放は、「記録のないポインタの解放数」として数える。
+	//※【注意】追跡中のメモリ確保／解放と並行して実行してはいけない
+	void reset();
+
+	//デバッグ情報作成
+	//※十分なサイズのバッファを渡す必要あり。
+	//※使用したバッファのサイズを返す。
+	//※コールポイントは生存バイト数の降順に並べる。
+	//※作成中、他のスレッドで操作が発生すると、不整合が生じる可能性がある点に注意
+	std::size_t debugInfo(char* message, const std::size_t max_size) const;
+
+	//FlameGraph用の折りたたみスタック形式で出力
+	//※一行が「アロケータ;ソースファイル;関数;コールポイント;型 値」の形式。
+	//※flamegraph.pl などにそのまま渡すことができる。
+	//※使用したバッファのサイズを返す。
+	std::size_t writeFlameGraph(char* message, const std::size_t max_size, const allocationTrackerValue_type value_type = trackLiveBytes) const;
+
+	//pprof用のヒーププロファイル形式で出力
+	//※gperftools の pprof が扱う、シンボル付き（--- symbol 節を持つ）ヒーププロファイルの形式。
+	//※コールポイントとアロケータアダプタに擬似アドレスを割り当て、
+	//　「コールポイント ← アロケータアダプタ」の二段のスタックとして出力する。
+	//※使用したバッファのサイズを返す。
+	std::size_t writeHeapProfile(char* message, const std::size_t max_size) const;
+
+private:
+	//コールバック
+	void atNew(const GASHA_ iAllocatorAdapter& adapter, const void* p, const std::size_t size, const GASHA_ debugAllocationInfo* info);
+	void atDelete(const void* p);
+
+	//コールポイントを検索／登録
+	//※登録できなかった場合は INVALID_INDEX を返す
+	std::size_t findOrAddSite(const GASHA_ iAllocatorAdapter& adapter, const GASHA_ debugAllocationInfo* info);
+	//アロケータアダプタを検索／登録
+	//※登録できなかった場合は INVALID_INDEX を返す
+	std::size_t findOrAddAdapter(const GASHA_ iAllocatorAdapter& adapter);
+	//キーを検索／登録（テーブル共通処理）
+	//※登録済みのキーなら、登録完了を待ってからインデックスを返す。
+	//※新規に登録した場合は is_new が true になる。（呼び出し元で情報を設定し、登録完了にする）
+	//※テーブルが満杯なら INVALID_INDEX を返す。
+	template<class INFO>
+	static std::size_t claimKey(INFO* table, const std::size_t table_size, const key_type key, bool& is_new);
+
+	//ポインタを記録
+	//※探索範囲（PTR_PROBE_MAX）に空きがなければ false を返す
+	bool addPtr(const void* p, const std::size_t size, const std::size_t site_index, const std::size_t adapter_index);
+	//ポインタの記録を削除
+	//※記録がなければ false を返す
+	bool removePtr(const void* p, std::size_t& size, std::size_t& site_index, std::size_t& adapter_index);
+
+	//コールポイント集計情報を取得
+	inline siteInfo& site(const std::size_t index);
+	inline const siteInfo& site(const std::size_t index) const;
+
+	//キーの作成
+	inline static key_type mixKey(key_type key, const void* p);
+	inline static key_type finishKey(key_type key);
+	//ポインタのハッシュ値
+	inline static std::size_t ptrHash(const std::uintptr_t p);
+	//文字列の参照（nullptr の場合は代わりの文字列を返す）
+	inline static const char* labelOf(const char* str);
+
+public:
+	//コンストラクタ
+	allocationTracker();
+	//デストラクタ
+	inline ~allocationTracker();
+
+private:
+	//フィールド
+	GASHA_ debugAllocationObserver m_observer;//デバッグ観察者
+	mutable GASHA_ elapsedTime m_elapsedTime;//集計開始からの経過時間
+	statInfo m_total;//全体の集計情報
+	siteInfo m_otherSite;//集計テーブルに登録できなかったコールポイントの集計情報
+	std::atomic<std::size_t> m_siteNum;//登録済みのコールポイント数
+	std::atomic<std::size_t> m_adapterNum;//登録済みのアロケータアダプタ数
+	std::atomic<counter_type> m_untrackedCount;//追跡できなかったアロケート数
+	std::atomic<counter_type> m_unknownFreeCount;//記録のないポインタの解放数
+	adapterInfo m_adapters[ADAPTER_TABLE_SIZE];//アロケータアダプタ集計テーブル
+	siteInfo m_sites[SITE_TABLE_SIZE];//コールポイント集計テーブル
+	ptrInfo m_ptrs[PTR_TABLE_SIZE];//ポインタ記録テーブル
+};
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/allocation_tracker.inl>
+
+//.hファイルのインクルードに伴い、常に.cpp.hファイル（および.inlファイル）を自動インクルードする場合
+#ifdef GASHA_ALLOCATION_TRACKER_ALLWAYS_TOGETHER_CPP_H
+#include <gasha/allocation_tracker.cpp.h>
+#endif//GASHA_ALLOCATION_TRACKER_ALLWAYS_TOGETHER_CPP_H
+
+#endif//GASHA_INCLUDED_ALLOCATION_TRACKER_H
+
+// End of file
@@ -0,0 +1,187 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_ALLOCATION_TRACKER_INL
+#define GASHA_INCLUDED_ALLOCATION_TRACKER_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// allocation_tracker.inl
+// メモリアロケート追跡【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/allocation_tracker.h>//メモリアロケート追跡【宣言部】
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//メモリアロケート追跡クラス
+
+//----------------------------------------
+//集計情報型
+
+//生存数
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline typename allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::counter_type allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::statInfo::liveCount() const
+{
+	const counter_type free_count = freeCount();//解放数を先に取得（アロケート数より大きくならないようにする）
+	const counter_type alloc_count = allocCount();
+	return alloc_count > free_count ? alloc_count - free_count : 0;
+}
+
+//生存バイト数
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline typename allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::counter_type allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::statInfo::liveBytes() const
+{
+	const counter_type free_bytes = freeBytes();//解放バイト数を先に取得（アロケートバイト数より大きくならないようにする）
+	const counter_type alloc_bytes = allocBytes();
+	return alloc_bytes > free_bytes ? alloc_bytes - free_bytes : 0;
+}
+
+//アロケート頻度（回／秒）
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline double allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::statInfo::allocRate(const GASHA_ sec_t elapsed_time) const
+{
+	return elapsed_time > static_cast<GASHA_ sec_t>(0) ? static_cast<double>(allocCount()) / static_cast<double>(elapsed_time) : 0.;
+}
+
+//解放頻度（回／秒）
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline double allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::statInfo::freeRate(const GASHA_ sec_t elapsed_time) const
+{
+	return elapsed_time > static_cast<GASHA_ sec_t>(0) ? static_cast<double>(freeCount()) / static_cast<double>(elapsed_time) : 0.;
+}
+
+//アロケートを集計
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline void allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::statInfo::addAlloc(const std::size_t size)
+{
+	m_allocCount.fetch_add(1, std::memory_order_relaxed);
+	const counter_type alloc_bytes = m_allocBytes.fetch_add(static_cast<counter_type>(size), std::memory_order_relaxed) + static_cast<counter_type>(size);
+	const counter_type free_bytes = m_freeBytes.load(std::memory_order_relaxed);
+	const counter_type live_bytes = alloc_bytes > free_bytes ? alloc_bytes - free_bytes : 0;
+	//ピークを更新
+	counter_type peak = m_peakLiveBytes.load(std::memory_order_relaxed);
+	while (live_bytes > peak)
+	{
+		if (m_peakLiveBytes.compare_exchange_weak(peak, live_bytes, std::memory_order_relaxed))
+			break;
+	}
+}
+
+//解放を集計
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline void allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::statInfo::addFree(const std::size_t size)
+{
+	m_freeCount.fetch_add(1, std::memory_order_relaxed);
+	m_freeBytes.fetch_add(static_cast<counter_type>(size), std::memory_order_relaxed);
+}
+
+//リセット
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline void allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::statInfo::reset()
+{
+	m_allocCount.store(0);
+	m_allocBytes.store(0);
+	m_freeCount.store(0);
+	m_freeBytes.store(0);
+	m_peakLiveBytes.store(0);
+}
+
+//----------------------------------------
+//メモリアロケート追跡クラス
+
+//集計開始からの経過時間
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline GASHA_ sec_t allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::elapsed() const
+{
+	return m_elapsedTime.now();
+}
+
+//コールポイント集計情報を列挙
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+template<class FUNCTOR>
+void allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::forEachSite(FUNCTOR functor) const
+{
+	for (std::size_t index = 0; index < SITE_TABLE_SIZE; ++index)
+	{
+		const siteInfo& info = m_sites[index];
+		if (info.isReady())
+			functor(info);
+	}
+	if (m_otherSite.allocCount() > 0)
+		functor(m_otherSite);
+}
+
+//アロケータアダプタ集計情報を列挙
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+template<class FUNCTOR>
+void allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::forEachAdapter(FUNCTOR functor) const
+{
+	for (std::size_t index = 0; index < ADAPTER_TABLE_SIZE; ++index)
+	{
+		const adapterInfo& info = m_adapters[index];
+		if (info.isReady())
+			functor(info);
+	}
+}
+
+//コールポイント集計情報を取得
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline typename allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::siteInfo& allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::site(const std::size_t index)
+{
+	return index == INVALID_INDEX ? m_otherSite : m_sites[index];
+}
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline const typename allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::siteInfo& allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::site(const std::size_t index) const
+{
+	return index == INVALID_INDEX ? m_otherSite : m_sites[index];
+}
+
+//キーの作成
+//※FNV-1a をポインタ単位で適用
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline typename allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::key_type allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::mixKey(key_type key, const void* p)
+{
+	key ^= static_cast<key_type>(reinterpret_cast<std::uintptr_t>(p));
+	key *= 0x100000001b3ull;
+	return key;
+}
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline typename allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::key_type allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::finishKey(key_type key)
+{
+	key ^= key >> 29;
+	return key == 0 ? 1 : key;//0 は未使用を表すので使用しない
+}
+
+//ポインタのハッシュ値
+//※アラインメントで下位ビットが偏るため、乗算ハッシュで上位ビットを使用
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline std::size_t allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::ptrHash(const std::uintptr_t p)
+{
+	const std::uint64_t hash = static_cast<std::uint64_t>(p) * 0x9e3779b97f4a7c15ull;
+	return static_cast<std::size_t>(hash >> 32) & (PTR_TABLE_SIZE - 1);
+}
+
+//文字列の参照
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline const char* allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::labelOf(const char* str)
+{
+	return str ? str : "(unknown)";
+}
+
+//デストラクタ
+template<std::size_t _SITE_TABLE_SIZE, std::size_t _PTR_TABLE_SIZE>
+inline allocationTracker<_SITE_TABLE_SIZE, _PTR_TABLE_SIZE>::~allocationTracker()
+{}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_ALLOCATION_TRACKER_INL
+
+// End of file
@@ -0,0 +1,101 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_BENCHMARK_REPORT_H
+#define GASHA_INCLUDED_BENCHMARK_REPORT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// benchmark_report.h
+// ベンチマーク共通処理【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <cstddef>//std::size_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//ベンチマーク共通処理
+//※各ベンチマーク（〇〇_benchmark.h）で共通の、計測結果の表／CSVの作成処理と、処理時間の計測処理。
+//※表／CSVの作成処理には、ベンチマークごとに以下のメンバーを持つ定義クラスをテンプレート引数で渡す。
+//　ベンチマーク側は、定義クラスに計測処理と列の書式だけを記述する。
+//　・condition_type ... 計測条件の型
+//　・result_type    ... 計測結果の型
+//　・inline static void writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond);
+//　　... 表のタイトル（"[ ～ ]\n" の１行）
+//　・inline static void writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+//　・inline static void writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+//　　... 表の見出しと１行分
+//　・inline static void writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+//　・inline static void writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+//　　... CSVの見出しと１行分
+//　・template<class FUNCTOR> inline static bool testAll(const condition_type& cond, FUNCTOR functor);
+//　　... 条件の全ての組み合わせを計測し、計測結果ごとに functor(const result_type&) を呼び出す。
+//　　　　全ての結果が正しければ true を返す。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //表とCSVをバッファに作成
+//  static char table[64 * 1024];
+//  static char csv[64 * 1024];
+//  std::size_t table_len, csv_len;
+//  benchmarkReport<frustumCullingBenchmark::definition>(table, sizeof(table), table_len, csv, sizeof(csv), csv_len, frustumCullingBenchmark::condition());
+//
+//  //処理時間の計測（10回ずつ3回計測した最短の時間）
+//  const double elapsed = benchmarkElapsedMin(3, 10, [&](const std::size_t batch){ func(); });
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//全ての組み合わせを計測し、表とCSVを作成
+//※表またはCSVが不要な場合は、バッファに nullptr を指定する
+//※全ての結果が正しければ true を返す
+template<class BENCHMARK>
+inline bool benchmarkReport(char* table_message, const std::size_t table_max_size, std::size_t& table_message_len, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const typename BENCHMARK::condition_type& cond);
+
+//----------------------------------------
+//全ての組み合わせを計測し、表を１行ずつ出力しながら、CSVを作成
+//※表の見出しと計測結果ごとに、print(const char* line) を呼び出す
+//※CSVが不要な場合は、バッファに nullptr を指定する（または、CSVの引数を省略する）
+//※全ての結果が正しければ true を返す
+template<class BENCHMARK, class PRINT_FUNCTOR>
+inline bool benchmarkPrint(PRINT_FUNCTOR print, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const typename BENCHMARK::condition_type& cond);
+template<class BENCHMARK, class PRINT_FUNCTOR>
+inline bool benchmarkPrint(PRINT_FUNCTOR print, const typename BENCHMARK::condition_type& cond);
+
+//----------------------------------------
+//処理時間の計測
+//※run(batch_index) を batch_num 回呼び出す処理を repeat_num 回計測し、最短の処理時間（秒）を返す
+//※prepare() を指定した場合、計測ごとに、計測の前に呼び出す（処理時間に含まない）
+template<class RUN_FUNCTOR>
+inline double benchmarkElapsedMin(const int repeat_num, const std::size_t batch_num, RUN_FUNCTOR run);
+template<class PREPARE_FUNCTOR, class RUN_FUNCTOR>
+inline double benchmarkElapsedMin(const int repeat_num, const std::size_t batch_num, PREPARE_FUNCTOR prepare, RUN_FUNCTOR run);
+
+//----------------------------------------
+//１回の計測で処理を繰り返す回数
+//※件数×回数が repeat_element_num 以上になる回数（最低１回）
+inline std::size_t benchmarkBatchNum(const std::size_t size, const std::size_t repeat_element_num);
+
+//----------------------------------------
+//ユニットテスト用マクロ
+//※GASHA_UT_BEGIN() ～ GASHA_UT_END() の中で使用する
+//※定義クラスと計測条件を指定し、表を１行ずつ表示して、全ての結果が正しいか判定する
+#define GASHA_UT_BENCHMARK(BENCHMARK, cond) \
+	{ \
+		const bool bench_is_ok = GASHA_ benchmarkPrint<BENCHMARK>([&](const char* bench_line) \
+			{ \
+				GASHA_UT_PRINTF("%s", bench_line); \
+			}, cond); \
+		GASHA_UT_EXPECT_EQ_CHILD(bench_is_ok, true); \
+	}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/benchmark_report.inl>
+
+#endif//GASHA_INCLUDED_BENCHMARK_REPORT_H
+
+// End of file
@@ -0,0 +1,172 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_BENCHMARK_REPORT_INL
+#define GASHA_INCLUDED_BENCHMARK_REPORT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// benchmark_report.inl
+// ベンチマーク共通処理【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/benchmark_report.h>//ベンチマーク共通処理【宣言部】
+
+#include <gasha/chrono.h>//時間系ユーティリティ：elapsedTime
+#include <gasha/string.h>//文字列処理：spprintf()
+
+#ifdef _OPENMP
+#include <omp.h>//omp_get_max_threads(), omp_set_num_threads()
+#endif//_OPENMP
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//ベンチマーク共通処理
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//全ての組み合わせを計測し、表とCSVを作成
+template<class BENCHMARK>
+inline bool benchmarkReport(char* table_message, const std::size_t table_max_size, std::size_t& table_message_len, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const typename BENCHMARK::condition_type& cond)
+{
+	table_message_len = 0;
+	csv_message_len = 0;
+	if (table_message)
+	{
+		table_message[0] = '\0';
+		GASHA_ spprintf(table_message, table_max_size, table_message_len, "------------------------------------------------------------\n");
+		BENCHMARK::writeTitle(table_message, table_max_size, table_message_len, cond);
+		BENCHMARK::writeTableHeader(table_message, table_max_size, table_message_len);
+	}
+	if (csv_message)
+	{
+		csv_message[0] = '\0';
+		BENCHMARK::writeCsvHeader(csv_message, csv_max_size, csv_message_len);
+	}
+	const bool is_ok = BENCHMARK::testAll(cond, [&](const typename BENCHMARK::result_type& result)
+		{
+			if (table_message)
+				BENCHMARK::writeTable(table_message, table_max_size, table_message_len, result);
+			if (csv_message)
+				BENCHMARK::writeCsv(csv_message, csv_max_size, csv_message_len, result);
+		});
+	if (table_message)
+		GASHA_ spprintf(table_message, table_max_size, table_message_len, "------------------------------------------------------------\n");
+	return is_ok;
+}
+
+//----------------------------------------
+//全ての組み合わせを計測し、表を１行ずつ出力しながら、CSVを作成
+template<class BENCHMARK, class PRINT_FUNCTOR>
+inline bool benchmarkPrint(PRINT_FUNCTOR print, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const typename BENCHMARK::condition_type& cond)
+{
+	csv_message_len = 0;
+	if (csv_message)
+	{
+		csv_message[0] = '\0';
+		BENCHMARK::writeCsvHeader(csv_message, csv_max_size, csv_message_len);
+	}
+	char line[256];
+	std::size_t line_len = 0;
+	BENCHMARK::writeTableHeader(line, sizeof(line), line_len);
+	print(static_cast<const char*>(line));
+	return BENCHMARK::testAll(cond, [&](const typename BENCHMARK::result_type& result)
+		{
+			line_len = 0;
+			BENCHMARK::writeTable(line, sizeof(line), line_len, result);
+			print(static_cast<const char*>(line));
+			if (csv_message)
+				BENCHMARK::writeCsv(csv_message, csv_max_size, csv_message_len, result);
+		});
+}
+//※CSVなし
+template<class BENCHMARK, class PRINT_FUNCTOR>
+inline bool benchmarkPrint(PRINT_FUNCTOR print, const typename BENCHMARK::condition_type& cond)
+{
+	std::size_t csv_message_len = 0;
+	return benchmarkPrint<BENCHMARK>(print, nullptr, 0, csv_message_len, cond);
+}
+
+//----------------------------------------
+//処理時間の計測
+template<class RUN_FUNCTOR>
+inline double benchmarkElapsedMin(const int repeat_num, const std::size_t batch_num, RUN_FUNCTOR run)
+{
+	return benchmarkElapsedMin(repeat_num, batch_num, [](){}, run);
+}
+template<class PREPARE_FUNCTOR, class RUN_FUNCTOR>
+inline double benchmarkElapsedMin(const int repeat_num, const std::size_t batch_num, PREPARE_FUNCTOR prepare, RUN_FUNCTOR run)
+{
+	const int _repeat_num = repeat_num > 0 ? repeat_num : 1;
+	double elapsed_min = 0.;
+	for (int repeat = 0; repeat < _repeat_num; ++repeat)
+	{
+		prepare();
+		GASHA_ elapsedTime elapsed_time;
+		for (std::size_t batch = 0; batch < batch_num; ++batch)
+			run(batch);
+		const double elapsed = static_cast<double>(elapsed_time.now());
+		if (repeat == 0 || elapsed_min > elapsed)
+			elapsed_min = elapsed;
+	}
+	return elapsed_min;
+}
+
+//----------------------------------------
+//１回の計測で処理を繰り返す回数
+inline std::size_t benchmarkBatchNum(const std::size_t size, const std::size_t repeat_element_num)
+{
+	if (size == 0 || size >= repeat_element_num)
+		return 1;
+	return (repeat_element_num + size - 1) / size;
+}
+
+namespace _private
+{
+	//----------------------------------------
+	//並列処理のスレッド数
+	//※OpenMPが無効な場合は常に１
+	inline int benchmarkThreadNum()
+	{
+	#ifdef _OPENMP
+		return omp_get_max_threads();
+	#else//_OPENMP
+		return 1;
+	#endif//_OPENMP
+	}
+	inline void benchmarkSetThreadNum(const int thread_num)
+	{
+	#ifdef _OPENMP
+		omp_set_num_threads(thread_num < 1 ? 1 : thread_num);
+	#endif//_OPENMP
+	}
+
+	//スコープ内のスレッド数を変更
+	class benchmarkThreadScope
+	{
+	public:
+		inline benchmarkThreadScope(const int thread_num) :
+			m_prevThreadNum(benchmarkThreadNum())
+		{
+			benchmarkSetThreadNum(thread_num);
+		}
+		inline ~benchmarkThreadScope()
+		{
+			benchmarkSetThreadNum(m_prevThreadNum);
+		}
+	private:
+		const int m_prevThreadNum;//変更前のスレッド数
+	};
+}//namespace _private
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_BENCHMARK_REPORT_INL
+
+// End of file
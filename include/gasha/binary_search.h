@@ -41,6 +41,45 @@ template<class T, class COMPARISON>
 T* binarySearch(T* array, const std::size_t size, COMPARISON comparison);
 GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_COMPARISON(binarySearch);
 
+//----------------------------------------
+//アルゴリズム：分岐なし二分探索（下限探索）
+//----------------------------------------
+//・最良計算時間：O(log n)
+//・平均計算時間：O(log n)
+//・最悪計算時間：O(log n)
+//・探索失敗時：  O(log n)
+//----------------------------------------
+//※探索値以上となる最初の要素（std::lower_bound() と同じ位置）を返す。
+//　全要素が探索値より小さい場合は nullptr を返す。
+//※比較結果で探索範囲の先頭を進めるかどうかだけを決め、範囲の幅は比較結果に依らず半分にしていく。
+//　比較結果による分岐がなく（条件付き転送命令になる）、分岐予測ミスが発生しない。
+//※次の比較対象となる２箇所（左右どちらに進んでも良いように）をプリフェッチし、メモリの読み込み待ちを隠す。
+//※一致する要素を見つけても途中で終了しないため、最良計算時間も O(log n)。
+//　大きな配列を何度も探索する用途では、binarySearch() より高速。
+//----------------------------------------
+//プロトタイプ：
+//・bool COMPARISON(const T& value)//value == 探索値なら0を、value < 探索値なら-1以下を、value > 探索値なら1以上を返す
+template<class T, class COMPARISON>
+T* branchlessLowerBound(T* array, const std::size_t size, COMPARISON comparison);
+GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_COMPARISON(branchlessLowerBound);
+
+//----------------------------------------
+//アルゴリズム：分岐なし二分探索
+//----------------------------------------
+//・最良計算時間：O(log n)
+//・平均計算時間：O(log n)
+//・最悪計算時間：O(log n)
+//・探索失敗時：  O(log n)
+//----------------------------------------
+//※branchlessLowerBound() で探索し、見つかった要素が探索値と一致する場合のみ返す。
+//※binarySearch() と同様に、一致する要素が複数ある場合は先頭の要素を返す。
+//----------------------------------------
+//プロトタイプ：
+//・bool COMPARISON(const T& value)//value == 探索値なら0を、value < 探索値なら-1以下を、value > 探索値なら1以上を返す
+template<class T, class COMPARISON>
+T* branchlessBinarySearch(T* array, const std::size_t size, COMPARISON comparison);
+GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_COMPARISON(branchlessBinarySearch);
+
 //----------------------------------------
 //アルゴリズム：二分探索
 //※イテレータ対応版
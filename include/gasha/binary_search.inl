@@ -18,6 +18,7 @@
 #include <gasha/binary_search.h>//二分探索【宣言部】
 
 #include <gasha/iterator.h>//イテレータ用アルゴリズム
+#include <gasha/memory.h>//メモリ操作：prefetch()
 
 GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 
@@ -57,6 +58,38 @@ T* binarySearch(T* array, const std::size_t size, COMPARISON comparison)
 	return found;
 }
 
+//----------------------------------------
+//アルゴリズム：分岐なし二分探索（下限探索）
+template<class T, class COMPARISON>
+T* branchlessLowerBound(T* array, const std::size_t size, COMPARISON comparison)
+{
+	if (!array || size == 0)
+		return nullptr;
+	T* begin = array;
+	std::size_t range = size;
+	while (range > 1)
+	{
+		const std::size_t range_half = range / 2;//探索範囲の半分の範囲
+		range -= range_half;//次の探索範囲 ※比較結果に依らない
+		//次の比較対象をプリフェッチ ※左右どちらに進んでも良いように両方
+		GASHA_ prefetch(begin + range / 2);
+		GASHA_ prefetch(begin + (range_half + range / 2));
+		//探索値が前半の末尾要素より大きければ、探索範囲の先頭を後半に進める ※分岐なし
+		begin += (comparison(begin[range_half - 1]) > 0 ? range_half : 0);
+	}
+	T* found = begin + (comparison(*begin) > 0 ? 1 : 0);
+	return found == array + size ? nullptr : found;
+}
+
+//----------------------------------------
+//アルゴリズム：分岐なし二分探索
+template<class T, class COMPARISON>
+inline T* branchlessBinarySearch(T* array, const std::size_t size, COMPARISON comparison)
+{
+	T* found = GASHA_ branchlessLowerBound(array, size, comparison);
+	return found && comparison(*found) == 0 ? found : nullptr;
+}
+
 //----------------------------------------
 //アルゴリズム：二分探索
 //※イテレータ対応版
@@ -105,6 +105,33 @@
 		#define GASHA_USE_AVX
 	#endif//GASHA_USE_AVX
 
+	//FMA命令は、AVX命令が無効なら無効化する
+	#if defined(GASHA_USE_FMA3) && !defined(GASHA_USE_AVX)
+		#undef GASHA_USE_FMA3
+	#endif//GASHA_USE_FMA3
+
+	//F16C命令は、AVX命令が無効なら無効化する
+	#if defined(GASHA_USE_F16C) && !defined(GASHA_USE_AVX)
+		#undef GASHA_USE_F16C
+	#endif//GASHA_USE_F16C
+
+	//実行時のCPU機能判定による振り分けが有効なら、コンパイル時に無効な命令を振り分け対象にする
+	//※振り分け対象の命令は、関数単位の命令セット指定（GASHA_TARGET_*）を付けた関数でのみ使用する
+	#ifdef GASHA_USE_RUNTIME_CPU_DISPATCH
+		#if !defined(GASHA_USE_SSE4_2) && defined(GASHA_USE_SSE2)
+			#define GASHA_DISPATCH_SSE4_2
+		#endif//GASHA_DISPATCH_SSE4_2
+		#if !defined(GASHA_USE_AVX) && defined(GASHA_USE_SSE2)
+			#define GASHA_DISPATCH_AVX
+		#endif//GASHA_DISPATCH_AVX
+		#if !defined(GASHA_USE_AVX2) && defined(GASHA_USE_SSE2)
+			#define GASHA_DISPATCH_AVX2
+		#endif//GASHA_DISPATCH_AVX2
+		#if !defined(GASHA_USE_F16C) && defined(GASHA_USE_SSE2)
+			#define GASHA_DISPATCH_F16C
+		#endif//GASHA_DISPATCH_F16C
+	#endif//GASHA_USE_RUNTIME_CPU_DISPATCH
+
 #else//GASHA_IS_X86
 
 	//x86系以外のCPUでは、SSE命令を無効化する
@@ -157,6 +184,14 @@
 		#undef GASHA_USE_FMA3
 	#endif//GASHA_USE_FMA3
 
+	#ifdef GASHA_USE_F16C
+		#undef GASHA_USE_F16C
+	#endif//GASHA_USE_F16C
+
+	#ifdef GASHA_USE_RUNTIME_CPU_DISPATCH
+		#undef GASHA_USE_RUNTIME_CPU_DISPATCH
+	#endif//GASHA_USE_RUNTIME_CPU_DISPATCH
+
 #endif//GASHA_IS_X86
 
 //--------------------------------------------------------------------------------
@@ -179,6 +214,10 @@
 
 //AVX命令による高速化は、AVX命令が使えなければ無効化する
 #if defined(GASHA_FAST_ARITH_USE_AVX) && !defined(GASHA_USE_AVX)
+	//※実行時のCPU機能判定による振り分けが有効なら、実行時に振り分ける
+	#if defined(GASHA_DISPATCH_AVX) && defined(GASHA_FAST_ARITH_USE_SSE)
+		#define GASHA_FAST_ARITH_DISPATCH_AVX
+	#endif//GASHA_FAST_ARITH_DISPATCH_AVX
 	#undef GASHA_FAST_ARITH_USE_AVX
 #endif//GASHA_FAST_ARITH_USE_AVX
 
@@ -203,6 +242,10 @@
 
 //SSE4.2命令によるCRC計算の高速化は、SSE4.2命令が使えなければ無効化する
 #if defined(GASHA_CRC32_USE_SSE) && (!defined(GASHA_CRC32_IS_CRC32C) || !defined(GASHA_USE_SSE4_2))
+	//※実行時のCPU機能判定による振り分けが有効なら、実行時に振り分ける
+	#if defined(GASHA_CRC32_IS_CRC32C) && defined(GASHA_DISPATCH_SSE4_2)
+		#define GASHA_CRC32_DISPATCH_SSE
+	#endif//GASHA_CRC32_DISPATCH_SSE
 	#undef GASHA_CRC32_USE_SSE
 #endif//GASHA_CRC32_USE_SSE
 
@@ -211,11 +254,18 @@
 
 //SSE4.2命令による文字列処理の高速化は、SSE4.2命令が使えなければ無効化する
 #if defined(GASHA_FASE_STRING_USE_SSE4_2) && !defined(GASHA_USE_SSE4_2)
+	//※実行時のCPU機能判定による振り分けが有効なら、実行時に振り分ける
+	#ifdef GASHA_DISPATCH_SSE4_2
+		#define GASHA_FAST_STRING_DISPATCH_SSE4_2
+	#endif//GASHA_FAST_STRING_DISPATCH_SSE4_2
 	#undef GASHA_FASE_STRING_USE_SSE4_2
 #endif//GASHA_FASE_STRING_USE_SSE4_2
 
 //SSE4.2命令によるstrlenの高速化は、SSE4.2命令による文字列処理高速化が有効でなければ無効化する
 #if defined(GASHA_STRLEN_FAST_USE_SSE4_2) && !defined(GASHA_FASE_STRING_USE_SSE4_2)
+	#ifdef GASHA_FAST_STRING_DISPATCH_SSE4_2
+		#define GASHA_STRLEN_FAST_DISPATCH_SSE4_2
+	#endif//GASHA_STRLEN_FAST_DISPATCH_SSE4_2
 	#undef GASHA_STRLEN_FAST_USE_SSE4_2
 #endif//GASHA_STRLEN_FAST_USE_SSE4_2
 
@@ -246,6 +296,9 @@
 
 //SSE4.2命令によるstrstrの高速化は、SSE4.2命令による文字列処理高速化が有効でなければ無効化する
 #if defined(GASHA_STRSTR_FAST_USE_SSE4_2) && !defined(GASHA_FASE_STRING_USE_SSE4_2)
+	#ifdef GASHA_FAST_STRING_DISPATCH_SSE4_2
+		#define GASHA_STRSTR_FAST_DISPATCH_SSE4_2
+	#endif//GASHA_STRSTR_FAST_DISPATCH_SSE4_2
 	#undef GASHA_STRSTR_FAST_USE_SSE4_2
 #endif//GASHA_STRSTR_FAST_USE_SSE4_2
 
@@ -309,6 +362,22 @@
 	#undef GASHA_LF_DUAL_STACK_ALLOCATOR_ENABLE_ASSERTION
 #endif//GASHA_LF_DUAL_STACK_ALLOCATOR_ENABLE_ASSERTION
 
+//--------------------------------------------------------------------------------
+//【ロックフリーフレームアロケータ】
+
+//ロックフリーフレームアロケータのメモリ確保／破棄時のアサーションは、ビルド構成でアサーションが有効でなければ無効化する
+#if defined(GASHA_LF_FRAME_ALLOCATOR_ENABLE_ASSERTION) && !defined(GASHA_ASSERTION_IS_ENABLED)
+	#undef GASHA_LF_FRAME_ALLOCATOR_ENABLE_ASSERTION
+#endif//GASHA_LF_FRAME_ALLOCATOR_ENABLE_ASSERTION
+
+//--------------------------------------------------------------------------------
+//【ロックフリースレッド別スタックアロケータ】
+
+//ロックフリースレッド別スタックアロケータのメモリ確保／破棄時のアサーションは、ビルド構成でアサーションが有効でなければ無効化する
+#if defined(GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ENABLE_ASSERTION) && !defined(GASHA_ASSERTION_IS_ENABLED)
+	#undef GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ENABLE_ASSERTION
+#endif//GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ENABLE_ASSERTION
+
 //--------------------------------------------------------------------------------
 //【単一アロケータ】
 
@@ -341,6 +410,14 @@
 	#undef GASHA_LF_POOL_ALLOCATOR_ENABLE_ASSERTION
 #endif//GASHA_LF_POOL_ALLOCATOR_ENABLE_ASSERTION
 
+//--------------------------------------------------------------------------------
+//【コンパクションアロケータ】
+
+//コンパクションアロケータのメモリ確保／破棄時のアサーションは、ビルド構成でアサーションが有効でなければ無効化する
+#if defined(GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION) && !defined(GASHA_ASSERTION_IS_ENABLED)
+	#undef GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+#endif//GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+
 //--------------------------------------------------------------------------------
 //【標準アロケータ】
 
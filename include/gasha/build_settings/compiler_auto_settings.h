@@ -59,6 +59,9 @@
 #ifdef __cplusplus
 	#define GASHA_IS_CPP//言語：C++
 	#define GASHA_PROGRAM_LANGUAGE_NAME "C++"
+	#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+		#define GASHA_HAS_CPP17//言語：C++17対応
+	#endif
 	#if __cplusplus >= 201103L || defined(__GXX_EXPERIMENTAL_CXX0X__)
 		//#define GASHA_HAS_CPPTR1//言語：C++TR1対応（暫定）
 		#define GASHA_HAS_CPP11//言語：C++11対応
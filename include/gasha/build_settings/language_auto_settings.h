@@ -672,6 +672,22 @@
 	#define GASHA_HAS_CAMOUFLAGE_ALWAYS_INLINE
 #endif//GASHA_IS_GCC
 
+//--------------------
+//関数単位の命令セット指定
+//※実行時のCPU機能判定で振り分ける関数に指定し、コンパイルオプションで有効化していない命令を、その関数内でのみ使用可能にする
+//※VC++ は命令セットの指定なしに組み込み関数を使用できるため、空定義
+#if defined(GASHA_IS_GCC) && defined(GASHA_IS_X86)
+	#define GASHA_TARGET_SSE4_2 __attribute__ ((target("sse4.2")))
+	#define GASHA_TARGET_AVX __attribute__ ((target("avx")))
+	#define GASHA_TARGET_AVX2 __attribute__ ((target("avx2")))
+	#define GASHA_TARGET_F16C __attribute__ ((target("avx,f16c")))
+#else//GASHA_IS_GCC, GASHA_IS_X86
+	#define GASHA_TARGET_SSE4_2
+	#define GASHA_TARGET_AVX
+	#define GASHA_TARGET_AVX2
+	#define GASHA_TARGET_F16C
+#endif//GASHA_IS_GCC, GASHA_IS_X86
+
 //--------------------
 //標準new/deleteの例外指定
 #ifdef GASHA_IS_VC
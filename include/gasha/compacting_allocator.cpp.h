@@ -0,0 +1,576 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_COMPACTING_ALLOCATOR_CPP_H
+#define GASHA_INCLUDED_COMPACTING_ALLOCATOR_CPP_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// compacting_allocator.cpp.h
+// コンパクションアロケータ【関数定義部】
+//
+// ※クラスのインスタンス化が必要な場所でインクルード。
+// ※基本的に、ヘッダーファイル内でのインクルード禁止。
+// 　（コンパイル・リンク時間への影響を気にしないならOK）
+// ※明示的なインスタンス化を避けたい場合は、ヘッダーファイルと共にインクルード。
+// 　（この場合、実際に使用するメンバー関数しかインスタンス化されないので、対象クラスに不要なインターフェースを実装しなくても良い）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/compacting_allocator.inl>//コンパクションアロケータ【インライン関数／テンプレート関数定義部】
+
+#include <gasha/lock_guard.h>//スコープロック
+#include <gasha/string.h>//文字列処理：spprintf()
+#include <gasha/simple_assert.h>//シンプルアサーション
+
+#include <cstring>//std::memmove()
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//コンパクションアロケータクラス
+
+//確保可能な最大の連続領域サイズ
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::largestFreeSize() const
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	return _largestFreeSize();
+}
+
+//空きブロック（隙間）の数
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::freeBlockNum() const
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	return _freeBlockNum();
+}
+
+//メモリ確保
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::allocHandle(const std::size_t size, const std::size_t align)
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	return _allocHandle(size, align, 0);
+}
+
+//メモリ解放
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+bool compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::freeHandle(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle)
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	return _freeHandle(handle);
+}
+
+//ハンドルが有効か？
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+bool compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::isValid(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle) const
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	return refHandle(handle) != nullptr;
+}
+
+//ハンドルからポインタを取得
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+void* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::get(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle) const
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	const handleInfo* info = refHandle(handle);
+	if (!info)
+		return nullptr;
+	return data(info->m_offset);
+}
+
+//ブロックのサイズを取得
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::sizeOf(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle) const
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	const handleInfo* info = refHandle(handle);
+	if (!info)
+		return 0;
+	return header(info->m_offset)->m_size - HEADER_SIZE;
+}
+
+//ピン留め
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+void* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::pin(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle)
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	handleInfo* info = refHandle(handle);
+	if (!info)
+		return nullptr;
+#ifdef GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+	GASHA_SIMPLE_ASSERT(info->m_pinCount < 0xffff, "Pin count overflow.");
+#endif//GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+	if (info->m_pinCount == 0xffff)
+		return nullptr;
+	++info->m_pinCount;
+	return data(info->m_offset);
+}
+
+//ピン留め解除
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+bool compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::unpin(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle)
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	handleInfo* info = refHandle(handle);
+	if (!info || info->m_pinCount == 0)
+	{
+	#ifdef GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+		GASHA_SIMPLE_ASSERT(false, "Block is not pinned.");
+	#endif//GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+		return false;
+	}
+	--info->m_pinCount;
+	return true;
+}
+
+//ピン留め中か？
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+bool compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::isPinned(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle) const
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	const handleInfo* info = refHandle(handle);
+	return info && info->m_pinCount > 0;
+}
+
+//デフラグ（移動量指定版）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::defragment(const std::size_t max_move_size)
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	return _defragment([&max_move_size](const size_type block_size, const size_type moved_size) -> bool
+		{
+			return static_cast<std::size_t>(moved_size) + static_cast<std::size_t>(block_size) <= max_move_size;
+		}
+	);
+}
+
+//デフラグ（時間指定版）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::defragmentWithinTime(const GASHA_ sec_t time_limit)
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	const auto begin_time = GASHA_ nowTime();
+	return _defragment([&begin_time, &time_limit](const size_type block_size, const size_type moved_size) -> bool
+		{
+			return GASHA_ calcElapsedTime(begin_time) < time_limit;
+		}
+	);
+}
+
+//メモリ確保
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+void* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::alloc(const std::size_t size, const std::size_t align)
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	//ポインタ版は、解放まで常にピン留めする
+	const handle_type handle = _allocHandle(size, align, 1);
+	if (handle == INVALID_HANDLE)
+		return nullptr;
+	return data(m_handles[handleIndex(handle)].m_offset);
+}
+
+//メモリ解放
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+bool compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::free(void* p)
+{
+	if (!p)//nullptrの解放は常に成功扱い
+		return true;
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	const handle_type handle = handleOf(p);
+#ifdef GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+	GASHA_SIMPLE_ASSERT(handle != INVALID_HANDLE, "Pointer is not allocated.");
+#endif//GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+	if (handle == INVALID_HANDLE)
+		return false;
+	return _freeHandle(handle);
+}
+
+//メモリクリア
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+void compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::clear()
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	initHandles();
+	m_top = 0;
+	m_usingSize = 0;
+	m_count = 0;
+	m_defragPos = 0;
+	m_pinnedGapPos = m_maxSize;
+}
+
+//デバッグ情報作成
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+std::size_t compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::debugInfo(char* message, const std::size_t max_size) const
+{
+	GASHA_ lock_guard<lock_type> lock(m_lock);//ロック（スコープロック）
+	std::size_t message_len = 0;
+	GASHA_ spprintf(message, max_size, message_len, "----- Debug-info for compactingAllocator -----\n");
+	GASHA_ spprintf(message, max_size, message_len, "buff=%p, maxSize=%d, size=%d, remain=%d, count=%d, top=%d, largestFree=%d, freeBlocks=%d\n", m_buffRef, maxSize(), this->size(), remain(), count(), m_top, _largestFreeSize(), _freeBlockNum());
+	GASHA_ spprintf(message, max_size, message_len, "handleNum=%d/%d, defragPos=%d, defragmented=%s, moved=%d bytes(%d blocks)\n", count(), static_cast<int>(HANDLE_NUM), m_defragPos, isDefragmented() ? "yes" : "no", m_movedSize, m_movedCount);
+	GASHA_ spprintf(message, max_size, message_len, "Blocks:\n");
+	size_type offset = 0;
+	while (offset < m_top)
+	{
+		const blockHeader* h = header(offset);
+		if (h->m_handleIndex == INVALID_INDEX)
+			GASHA_ spprintf(message, max_size, message_len, "  [%d] size=%d (free)\n", offset, h->m_size);
+		else
+		{
+			const handleInfo& info = m_handles[h->m_handleIndex];
+			GASHA_ spprintf(message, max_size, message_len, "  [%d] size=%d, handle=0x%08x, pin=%d\n", offset, h->m_size, makeHandle(info.m_generation, h->m_handleIndex), info.m_pinCount);
+		}
+		offset += h->m_size;
+	}
+	GASHA_ spprintf(message, max_size, message_len, "----------------------------------------------");//最終行改行なし
+	return message_len;
+}
+
+//メモリ確保（共通処理）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::_allocHandle(const std::size_t size, const std::size_t align, const std::uint16_t pin_count)
+{
+	//サイズが0バイトならサイズを1に、アラインメントを0にする
+	//※要求サイズが0でも必ずメモリを割り当てる点に注意（ただし、アラインメントは守らない）
+	const std::size_t _size = size == 0 ? 1 : size;
+	const std::size_t _align = size == 0 ? 0 : align;
+#ifdef GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+	GASHA_SIMPLE_ASSERT(_align <= BLOCK_ALIGN, "Alignment is too large.");
+	GASHA_SIMPLE_ASSERT(m_freeHandle != INVALID_INDEX, "compactingAllocator has no free handle.");
+#endif//GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+	if (_align > BLOCK_ALIGN || m_freeHandle == INVALID_INDEX || _size > m_maxSize)
+		return INVALID_HANDLE;
+	//ブロックを確保
+	const size_type block_size = HEADER_SIZE + static_cast<size_type>(adjustAlign(_size, BLOCK_ALIGN));
+	const size_type offset = _allocBlock(block_size);
+#ifdef GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+	GASHA_SIMPLE_ASSERT(offset != m_maxSize, "compactingAllocator is not enough memory.");
+#endif//GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+	if (offset == m_maxSize)
+		return INVALID_HANDLE;
+	//ハンドルを割り当て
+	const index_type index = m_freeHandle;
+	handleInfo& info = m_handles[index];
+	m_freeHandle = info.m_offset;
+	info.m_offset = offset;
+	info.m_pinCount = pin_count;
+	info.m_isUsed = true;
+	//管理ヘッダーを設定
+	blockHeader* h = header(offset);
+	h->m_size = block_size;
+	h->m_handleIndex = index;
+	//使用中のサイズとメモリ確保数を更新
+	m_usingSize += block_size;
+	++m_count;
+	return makeHandle(info.m_generation, index);
+}
+
+//メモリ解放（共通処理）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+bool compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::_freeHandle(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle)
+{
+	handleInfo* info = refHandle(handle);
+	if (!info)
+		return false;
+	const size_type offset = info->m_offset;
+	blockHeader* h = header(offset);
+	//使用中のサイズとメモリ確保数を更新
+	m_usingSize -= h->m_size;
+	--m_count;
+	//ブロックを空きブロックにする
+	h->m_handleIndex = INVALID_INDEX;
+	//ハンドルを解放（世代を更新して、解放済みのハンドルを無効にする）
+	const index_type index = handleIndex(handle);
+	++info->m_generation;
+	info->m_pinCount = 0;
+	info->m_isUsed = false;
+	info->m_offset = m_freeHandle;
+	m_freeHandle = index;
+	//後続の空きブロックと結合
+	_mergeFreeBlocks(offset);
+	//デフラグ済みの位置を戻す
+	if (m_defragPos > offset)
+		m_defragPos = offset;
+	//終端のブロックなら終端位置を縮める
+	if (offset + h->m_size >= m_top)
+		_shrinkTop(offset);
+	return true;
+}
+
+//ブロック確保（共通処理）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::_allocBlock(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type block_size)
+{
+	//終端から確保
+	if (block_size <= m_maxSize - m_top)
+	{
+		const size_type offset = m_top;
+		m_top += block_size;
+		return offset;
+	}
+	//空きブロックから確保（ファーストフィット）
+	size_type offset = 0;
+	while (offset < m_top)
+	{
+		blockHeader* h = header(offset);
+		if (h->m_handleIndex == INVALID_INDEX)//空きブロック
+		{
+			_mergeFreeBlocks(offset);//後続の空きブロックと結合
+			if (offset + h->m_size >= m_top)//終端の空きブロックなら、終端位置を縮めて終端から確保
+			{
+				_shrinkTop(offset);
+				if (block_size <= m_maxSize - m_top)
+				{
+					m_top += block_size;
+					return offset;
+				}
+				return m_maxSize;//確保失敗
+			}
+			if (h->m_size >= block_size)
+			{
+				//ブロックを分割
+				//※サイズは BLOCK_ALIGN の倍数なので、残りは必ず管理ヘッダーが収まる
+				const size_type remain_size = h->m_size - block_size;
+				if (remain_size > 0)
+				{
+					blockHeader* remain_h = header(offset + block_size);
+					remain_h->m_size = remain_size;
+					remain_h->m_handleIndex = INVALID_INDEX;
+				}
+				return offset;
+			}
+		}
+		offset += h->m_size;
+	}
+	return m_maxSize;//確保失敗
+}
+
+//後続の空きブロックを結合（共通処理）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+void compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::_mergeFreeBlocks(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type offset)
+{
+	blockHeader* h = header(offset);
+	size_type next = offset + h->m_size;
+	while (next < m_top && header(next)->m_handleIndex == INVALID_INDEX)
+	{
+		h->m_size += header(next)->m_size;
+		next = offset + h->m_size;
+	}
+	//結合したブロックの途中を指す位置を補正
+	if (m_defragPos > offset && m_defragPos < next)
+		m_defragPos = offset;
+	if (m_pinnedGapPos > offset && m_pinnedGapPos < next)
+		m_pinnedGapPos = offset;
+}
+
+//終端位置を縮める（共通処理）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+void compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::_shrinkTop(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type offset)
+{
+	m_top = offset;
+	if (m_defragPos > m_top)
+		m_defragPos = m_top;
+	if (m_pinnedGapPos >= m_top)
+		m_pinnedGapPos = m_maxSize;//終端より後ろの隙間は無くなった
+}
+
+//確保可能な最大の連続領域サイズ（共通処理）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::_largestFreeSize() const
+{
+	size_type largest = m_maxSize - m_top;
+	size_type free_size = 0;//連続する空きブロックの合計
+	size_type offset = 0;
+	while (offset < m_top)
+	{
+		const blockHeader* h = header(offset);
+		if (h->m_handleIndex == INVALID_INDEX)
+		{
+			free_size += h->m_size;
+			if (offset + h->m_size >= m_top)//終端の空きブロックは、終端以降の未使用領域と連続する
+				free_size += m_maxSize - m_top;
+			if (largest < free_size)
+				largest = free_size;
+		}
+		else
+			free_size = 0;
+		offset += h->m_size;
+	}
+	return largest;
+}
+
+//空きブロックの数（共通処理）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::_freeBlockNum() const
+{
+	size_type num = 0;
+	bool prev_is_free = false;
+	size_type offset = 0;
+	while (offset < m_top)
+	{
+		const blockHeader* h = header(offset);
+		const bool is_free = h->m_handleIndex == INVALID_INDEX;
+		if (is_free && !prev_is_free)//連続する空きブロックは一つと数える
+			++num;
+		prev_is_free = is_free;
+		offset += h->m_size;
+	}
+	return num;
+}
+
+//デフラグ（共通処理）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+template<class CONTINUE_FUNC>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::_defragment(CONTINUE_FUNC continue_func)
+{
+	size_type moved_size = 0;
+	//デフラグ済みで、ピン留めで詰められなかった隙間が残っていれば、その位置から再試行
+	if (m_defragPos >= m_top && m_pinnedGapPos < m_top)
+	{
+		m_defragPos = m_pinnedGapPos;
+		m_pinnedGapPos = m_maxSize;
+	}
+	while (m_defragPos < m_top)
+	{
+		blockHeader* h = header(m_defragPos);
+		if (h->m_handleIndex != INVALID_INDEX)//使用中のブロックは詰め済み
+		{
+			m_defragPos += h->m_size;
+			continue;
+		}
+		//隙間（空きブロック）を発見
+		_mergeFreeBlocks(m_defragPos);//後続の空きブロックと結合
+		const size_type gap_size = h->m_size;
+		const size_type next_offset = m_defragPos + gap_size;
+		if (next_offset >= m_top)//終端の隙間なら、終端位置を縮めて終了
+		{
+			_shrinkTop(m_defragPos);
+			break;
+		}
+		//隙間の次のブロックを前方に移動
+		blockHeader* next_h = header(next_offset);
+		handleInfo& info = m_handles[next_h->m_handleIndex];
+		const size_type block_size = next_h->m_size;
+		if (info.m_pinCount > 0)//ピン留め中のブロックは移動できないので、隙間を残して先に進む
+		{
+			if (m_pinnedGapPos > m_defragPos)
+				m_pinnedGapPos = m_defragPos;
+			m_defragPos = next_offset + block_size;
+			continue;
+		}
+		if (!continue_func(block_size, moved_size))//予算切れ
+			break;
+		std::memmove(m_buffRef + m_defragPos, m_buffRef + next_offset, block_size);
+		info.m_offset = m_defragPos;
+		//移動したブロックの後ろを隙間にする
+		blockHeader* gap_h = header(m_defragPos + block_size);
+		gap_h->m_size = gap_size;
+		gap_h->m_handleIndex = INVALID_INDEX;
+		//移動量を更新
+		moved_size += block_size;
+		m_movedSize += block_size;
+		++m_movedCount;
+		m_defragPos += block_size;
+	}
+	return moved_size;
+}
+
+//ポインタからハンドルを取得
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handleOf(void* p) const
+{
+	const char* ptr = reinterpret_cast<const char*>(p);
+	if (ptr < m_buffRef + HEADER_SIZE || ptr >= m_buffRef + m_top)//範囲外
+		return INVALID_HANDLE;
+	const size_type offset = static_cast<size_type>(ptr - m_buffRef) - HEADER_SIZE;
+	if (offset % BLOCK_ALIGN != 0)//ブロックの先頭ではない
+		return INVALID_HANDLE;
+	const blockHeader* h = header(offset);
+	if (h->m_handleIndex >= HANDLE_NUM)//空きブロック
+		return INVALID_HANDLE;
+	const handleInfo& info = m_handles[h->m_handleIndex];
+	if (!info.m_isUsed || info.m_offset != offset)//ブロックの先頭ではない
+		return INVALID_HANDLE;
+	return makeHandle(info.m_generation, h->m_handleIndex);
+}
+
+//ハンドル情報の初期化
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+void compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::initHandles()
+{
+	for (index_type index = 0; index < HANDLE_NUM; ++index)
+	{
+		handleInfo& info = m_handles[index];
+		if (info.m_isUsed)//使用中だったハンドルは世代を更新して無効にする
+			++info.m_generation;
+		info.m_offset = index + 1 < HANDLE_NUM ? index + 1 : INVALID_INDEX;//未使用ハンドルの連結
+		info.m_pinCount = 0;
+		info.m_isUsed = false;
+	}
+	m_freeHandle = 0;
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//----------------------------------------
+//明示的なインスタンス化
+
+//コンパクションアロケータの明示的なインスタンス化用マクロ
+//※ロックなし版
+#define GASHA_INSTANCING_compactingAllocator(_HANDLE_NUM) \
+	template class GASHA_ compactingAllocator<_HANDLE_NUM>;
+//※ロック指定版
+#define GASHA_INSTANCING_compactingAllocator_withLock(_HANDLE_NUM, LOCK_POLICY) \
+	template class GASHA_ compactingAllocator<_HANDLE_NUM, LOCK_POLICY>;
+
+//--------------------------------------------------------------------------------
+//【注】明示的インスタンス化に失敗する場合
+// ※このコメントは、「明示的なインスタンス化マクロ」が定義されている全てのソースコードに
+// 　同じ内容のものをコピーしています。
+//--------------------------------------------------------------------------------
+//【原因①】
+// 　対象クラスに必要なインターフェースが実装されていない。
+//
+// 　例えば、ソート処理に必要な「bool operator<(const value_type&) const」か「friend bool operator<(const value_type&, const value_type&)」や、
+// 　探索処理に必要な「bool operator==(const key_type&) const」か「friend bool operator==(const value_type&, const key_type&)」。
+//
+// 　明示的なインスタンス化を行う場合、実際に使用しない関数のためのインターフェースも確実に実装する必要がある。
+// 　逆に言えば、明示的なインスタンス化を行わない場合、使用しない関数のためのインターフェースを実装する必要がない。
+//
+//【対策１】
+// 　インターフェースをきちんと実装する。
+// 　（無難だが、手間がかかる。）
+//
+//【対策２】
+// 　明示的なインスタンス化を行わずに、.cpp.h をテンプレート使用前にインクルードする。
+// 　（手間がかからないが、コンパイル時の依存ファイルが増えるので、コンパイルが遅くなる可能性がある。）
+//
+//--------------------------------------------------------------------------------
+//【原因②】
+// 　同じ型のインスタンスが複数作成されている。
+//
+// 　通常、テンプレートクラス／関数の同じ型のインスタンスが複数作られても、リンク時に一つにまとめられるため問題がない。
+// 　しかし、一つのソースファイルの中で複数のインスタンスが生成されると、コンパイラによってはエラーになる。
+//   GCCの場合のエラーメッセージ例：（VC++ではエラーにならない）
+// 　  source_file.cpp.h:114:17: エラー: duplicate explicit instantiation of ‘class templateClass<>’ [-fpermissive]
+//
+//【対策１】
+// 　別のファイルに分けてインスタンス化する。
+// 　（コンパイルへの影響が少なく、良い方法だが、無駄にファイル数が増える可能性がある。）
+//
+//【対策２】
+// 　明示的なインスタンス化を行わずに、.cpp.h をテンプレート使用前にインクルードする。
+// 　（手間がかからないが、コンパイル時の依存ファイルが増えるので、コンパイルが遅くなる可能性がある。）
+//
+//【対策３】
+// 　GCCのコンパイラオプションに、 -fpermissive を指定し、エラーを警告に格下げする。
+// 　（最も手間がかからないが、常時多数の警告が出る状態になりかねないので注意。）
+//--------------------------------------------------------------------------------
+
+#endif//GASHA_INCLUDED_COMPACTING_ALLOCATOR_CPP_H
+
+// End of file
@@ -0,0 +1,346 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_COMPACTING_ALLOCATOR_H
+#define GASHA_INCLUDED_COMPACTING_ALLOCATOR_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// compacting_allocator.h
+// コンパクションアロケータ【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/allocator_common.h>//メモリアロケータ共通設定
+#include <gasha/memory.h>//メモリ操作：adjustStaticAlign, adjustAlign()
+#include <gasha/allocator_adapter.h>//アロケータアダプタ
+#include <gasha/dummy_lock.h>//ダミーロック
+#include <gasha/chrono.h>//時間処理ユーティリティ
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint16_t, std::uint32_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//コンパクションアロケータ
+//--------------------------------------------------------------------------------
+//【概要】
+//・可変サイズのブロックを、バッファの先頭から順に詰めて配置するアロケータ。
+//・利用者はポインタではなく「ハンドル」を保持し、使用時にハンドルからポインタを取得する。
+//・解放によって生じた隙間（断片化）は、defragment() で後続のブロックを前方に移動して解消する。
+//  defragment() は移動量または時間の予算を指定して、複数回に分けて少しずつ実行できる。
+//・ピン留め（pin() / unpin()）中のブロックは移動しない。
+//--------------------------------------------------------------------------------
+//【実装要件】
+//・ブロックは、管理ヘッダー＋データ領域で構成し、BLOCK_ALIGN 単位で配置する。
+//  アラインメントは BLOCK_ALIGN まで保証する。（それ以上は確保失敗）
+//・メモリ確保は、まず終端（未使用領域）から行い、足りなければ空きブロックを先頭から探す（ファーストフィット）。
+//  空きブロックを探す際、連続する空きブロックを結合する。
+//・ハンドルは「世代＋インデックス」で構成し、解放済みのハンドルの使用を検出できるようにする。
+//・defragment() は、先頭から詰め終わった位置を記憶し、次回はその位置から続行する。
+//  ピン留め中のブロックの手前の隙間は詰められないため、次のパスで再試行する。
+//・ブロックの移動は単純なメモリコピー（memmove）で行うため、
+//  格納するデータはトリビアルにコピー可能（自身や他のブロックへのポインタを持たない）でなければならない。
+//--------------------------------------------------------------------------------
+//【ポインタ版インターフェースについて】
+//・alloc() / free() / newObj() / deleteObj() などのポインタ版インターフェースも使用できる。
+//  （アロケータアダプタ／多態アロケータから使用するため）
+//・ポインタ版で確保したブロックは、解放まで常にピン留めされる。（移動しない）
+//--------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------
+//コンパクションアロケータクラス
+//※バッファをコンストラクタで受け渡して使用
+//※HANDLE_NUM：ハンドルの最大数（同時に確保できるブロックの最大数）
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY = GASHA_ dummyLock>
+class compactingAllocator
+{
+public:
+	//型
+	typedef LOCK_POLICY lock_type;//ロック型
+	typedef std::uint32_t size_type;//サイズ型
+	typedef std::uint32_t handle_type;//ハンドル型（上位16ビット：世代、下位16ビット：インデックス）
+	typedef std::uint32_t index_type;//インデックス型
+
+public:
+	//定数
+	static const std::size_t HANDLE_NUM = _HANDLE_NUM;//ハンドルの最大数
+	static const size_type BLOCK_ALIGN = 16;//ブロックのアラインメント（保証する最大のアラインメント）
+	static const size_type HEADER_SIZE = BLOCK_ALIGN;//ブロックの管理ヘッダーサイズ
+	static const handle_type INVALID_HANDLE = 0xffffffffu;//無効なハンドル
+	static const index_type INVALID_INDEX = 0xffffffffu;//無効なインデックス
+	static_assert(HANDLE_NUM > 0 && HANDLE_NUM < 0xffff, "HANDLE_NUM is out of range.");
+
+private:
+	//ブロックの管理ヘッダー
+	struct blockHeader
+	{
+		size_type m_size;//ブロック全体のサイズ（管理ヘッダーを含む）
+		index_type m_handleIndex;//ハンドルのインデックス（INVALID_INDEX なら空きブロック）
+	};
+	static_assert(sizeof(blockHeader) <= HEADER_SIZE, "blockHeader is too large.");
+
+	//ハンドル情報
+	struct handleInfo
+	{
+		size_type m_offset;//ブロックの位置（バッファ先頭からのオフセット） ※未使用時は次の未使用ハンドルのインデックス
+		std::uint16_t m_generation;//世代
+		std::uint16_t m_pinCount;//ピン留め数
+		bool m_isUsed;//使用中
+	};
+
+public:
+	//アクセッサ
+	const char* name() const { return "compactingAllocator"; }
+	const char* mode() const { return "Compacting"; }
+	inline const void* buff() const { return reinterpret_cast<const void*>(m_buffRef); }//バッファの先頭アドレス
+	inline size_type maxSize() const { return m_maxSize; }//バッファの全体サイズ（バイト数）
+	inline size_type size() const { return m_usingSize; }//使用中のサイズ（バイト数） ※管理ヘッダーを含む
+	inline size_type remain() const { return m_maxSize - size(); }//残りサイズ（バイト数） ※断片化している空き領域を含む
+	inline size_type count() const { return m_count; }//アロケート中の数
+	inline size_type top() const { return m_top; }//使用中の終端位置（バイト数） ※これ以降は連続した未使用領域
+	inline size_type movedSize() const { return m_movedSize; }//defragment() で移動したサイズの累計（バイト数）
+	inline size_type movedCount() const { return m_movedCount; }//defragment() で移動したブロック数の累計
+	size_type largestFreeSize() const;//確保可能な最大の連続領域サイズ（バイト数） ※管理ヘッダーを含む
+	size_type freeBlockNum() const;//空きブロック（隙間）の数
+
+public:
+	//アロケータアダプタ取得
+	inline GASHA_ allocatorAdapter<compactingAllocator<_HANDLE_NUM, LOCK_POLICY>> adapter(){ GASHA_ allocatorAdapter<compactingAllocator<_HANDLE_NUM, LOCK_POLICY>> adapter(*this, name(), mode()); return adapter; }
+
+public:
+	//メソッド：ハンドル版
+
+	//メモリ確保
+	//※確保できなかった場合は INVALID_HANDLE を返す
+	handle_type allocHandle(const std::size_t size, const std::size_t align = GASHA_ DEFAULT_ALIGN);
+
+	//メモリ解放
+	//※ピン留め中のブロックも解放する
+	bool freeHandle(const handle_type handle);
+
+	//ハンドルが有効か？
+	bool isValid(const handle_type handle) const;
+
+	//ハンドルからポインタを取得
+	//※取得したポインタは、次の defragment() まで有効。（ピン留め中は常に有効）
+	//※無効なハンドルの場合は nullptr を返す
+	void* get(const handle_type handle) const;
+	//※型指定版
+	template<typename T>
+	inline T* get(const handle_type handle) const;
+
+	//ブロックのサイズを取得（データ領域のサイズ）
+	//※無効なハンドルの場合は 0 を返す
+	size_type sizeOf(const handle_type handle) const;
+
+	//ピン留め
+	//※ピン留め中のブロックは、defragment() で移動しない。
+	//※ポインタを返す。無効なハンドルの場合は nullptr を返す。
+	void* pin(const handle_type handle);
+	//ピン留め解除
+	//※pin() に成功した回数だけ呼び出す必要がある。
+	bool unpin(const handle_type handle);
+	//ピン留め中か？
+	bool isPinned(const handle_type handle) const;
+
+	//メモリ確保とコンストラクタ呼び出し
+	template<typename T, typename...Tx>
+	handle_type newHandle(Tx&&... args);
+	//メモリ解放とデストラクタ呼び出し
+	template<typename T>
+	bool deleteHandle(const handle_type handle);
+
+public:
+	//メソッド：デフラグ
+
+	//デフラグ（移動量指定版）
+	//※移動するブロックの合計サイズが max_move_size を超えない範囲でブロックを前方に詰める。
+	//※移動したサイズ（バイト数）を返す。
+	size_type defragment(const std::size_t max_move_size);
+
+	//デフラグ（時間指定版）
+	//※経過時間が time_limit（秒）を超えない範囲でブロックを前方に詰める。
+	//　（ブロック一つの移動ごとに時間を確認するため、多少超過する可能性がある）
+	//※移動したサイズ（バイト数）を返す。
+	size_type defragmentWithinTime(const GASHA_ sec_t time_limit);
+
+	//デフラグ済みか？
+	//※隙間がない状態か？（ピン留め中のブロックの手前の隙間は除く）
+	inline bool isDefragmented() const;
+
+public:
+	//メソッド：ポインタ版
+	//※確保したブロックは解放まで常にピン留めされる
+
+	//メモリ確保
+	void* alloc(const std::size_t size, const std::size_t align = GASHA_ DEFAULT_ALIGN);
+
+	//メモリ解放
+	bool free(void* p);
+
+	//メモリ確保とコンストラクタ呼び出し
+	template<typename T, typename...Tx>
+	T* newObj(Tx&&... args);
+	//※配列用
+	template<typename T, typename...Tx>
+	T* newArray(const std::size_t num, Tx&&... args);
+
+	//メモリ解放とデストラクタ呼び出し
+	template<typename T>
+	bool deleteObj(T* p);
+	//※配列用（要素数の指定が必要な点に注意）
+	template<typename T>
+	bool deleteArray(T* p, const std::size_t num);
+
+public:
+	//メソッド：共通
+
+	//メモリクリア
+	//※初期状態にする（全てのハンドルが無効になる）
+	//※【注意】メモリ確保状態（アロケート中の数）やピン留め状態と無関係に実行するので注意
+	void clear();
+
+	//デバッグ情報作成
+	//※十分なサイズのバッファを渡す必要あり。
+	//※使用したバッファのサイズを返す。
+	//※作成中、ロックを取得する。
+	std::size_t debugInfo(char* message, const std::size_t max_size) const;
+
+private:
+	//ハンドルの作成／分解
+	inline static handle_type makeHandle(const std::uint16_t generation, const index_type index);
+	inline static index_type handleIndex(const handle_type handle);
+	inline static std::uint16_t handleGeneration(const handle_type handle);
+
+	//管理ヘッダー取得
+	inline blockHeader* header(const size_type offset);
+	inline const blockHeader* header(const size_type offset) const;
+	//データ領域取得
+	inline void* data(const size_type offset) const;
+
+	//ハンドル情報取得（無効なハンドルなら nullptr を返す）
+	//※ロック取得は呼び出し元で行う
+	inline handleInfo* refHandle(const handle_type handle);
+	inline const handleInfo* refHandle(const handle_type handle) const;
+
+	//メモリ確保（共通処理）
+	//※ロック取得は呼び出し元で行う
+	handle_type _allocHandle(const std::size_t size, const std::size_t align, const std::uint16_t pin_count);
+	//メモリ解放（共通処理）
+	//※ロック取得は呼び出し元で行う
+	bool _freeHandle(const handle_type handle);
+	//ブロック確保（共通処理）
+	//※確保したブロックの位置を返す。確保できなかった場合は m_maxSize を返す。
+	size_type _allocBlock(const size_type block_size);
+	//後続の空きブロックを結合（共通処理）
+	void _mergeFreeBlocks(const size_type offset);
+	//終端位置を縮める（共通処理）
+	void _shrinkTop(const size_type offset);
+	//確保可能な最大の連続領域サイズ（共通処理）
+	size_type _largestFreeSize() const;
+	//空きブロックの数（共通処理）
+	size_type _freeBlockNum() const;
+	//デフラグ（共通処理）
+	template<class CONTINUE_FUNC>
+	size_type _defragment(CONTINUE_FUNC continue_func);
+
+	//ポインタからハンドルを取得
+	//※ロック取得は呼び出し元で行う
+	handle_type handleOf(void* p) const;
+
+	//ハンドル情報の初期化
+	void initHandles();
+
+public:
+	//コンストラクタ
+	inline compactingAllocator(void* buff, const std::size_t max_size);
+	template<typename T>
+	inline compactingAllocator(T* buff, const std::size_t num);
+	template<typename T, std::size_t N>
+	inline compactingAllocator(T (&buff)[N]);
+	//デストラクタ
+	inline ~compactingAllocator();
+
+private:
+	//フィールド
+	char* m_buffRef;//バッファの参照（BLOCK_ALIGN に合わせて調整済み）
+	size_type m_maxSize;//バッファの全体サイズ
+	size_type m_top;//使用中の終端位置
+	size_type m_usingSize;//使用中のサイズ
+	size_type m_count;//アロケート中の数
+	size_type m_defragPos;//デフラグ済みの位置（この位置まで隙間なく詰められている）
+	size_type m_pinnedGapPos;//デフラグ中にピン留めで詰められなかった最初の隙間の位置
+	size_type m_movedSize;//移動したサイズの累計
+	size_type m_movedCount;//移動したブロック数の累計
+	index_type m_freeHandle;//未使用ハンドルの先頭インデックス
+	handleInfo m_handles[HANDLE_NUM];//ハンドル情報
+	mutable lock_type m_lock;//ロックオブジェクト
+};
+
+//--------------------------------------------------------------------------------
+//バッファ付きコンパクションアロケータクラス
+template<std::size_t _MAX_SIZE, std::size_t _HANDLE_NUM, class LOCK_POLICY = GASHA_ dummyLock>
+class compactingAllocator_withBuff : public compactingAllocator<_HANDLE_NUM, LOCK_POLICY>
+{
+	//定数
+	static const std::size_t MAX_SIZE = _MAX_SIZE;//バッファの全体サイズ
+public:
+	//コンストラクタ
+	inline compactingAllocator_withBuff();
+	//デストラクタ
+	inline ~compactingAllocator_withBuff();
+private:
+	alignas(16) char m_buff[MAX_SIZE];//バッファ
+};
+
+//--------------------------------------------------------------------------------
+//スコープピン留めクラス
+//※コンストラクタでブロックをピン留めし、デストラクタでピン留めを解除する。
+template<class ALLOCATOR>
+class scopedPin
+{
+public:
+	//型
+	typedef ALLOCATOR allocator_type;//アロケータ型
+	typedef typename allocator_type::handle_type handle_type;//ハンドル型
+
+public:
+	//アクセッサ
+	inline void* get() const { return m_ptr; }//ピン留め中のポインタ ※ピン留めに失敗した場合は nullptr
+	template<typename T>
+	inline T* get() const { return static_cast<T*>(m_ptr); }//ピン留め中のポインタ（型指定版）
+	inline bool isPinned() const { return m_ptr != nullptr; }//ピン留め中か？
+
+public:
+	//コンストラクタ
+	inline scopedPin(allocator_type& allocator, const handle_type handle);
+	//ムーブコンストラクタ
+	inline scopedPin(scopedPin&& obj);
+	//コピーコンストラクタ
+	scopedPin(const scopedPin&) = delete;
+	//デストラクタ
+	inline ~scopedPin();
+private:
+	//フィールド
+	allocator_type& m_allocator;//アロケータ
+	handle_type m_handle;//ハンドル
+	void* m_ptr;//ピン留め中のポインタ
+};
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/compacting_allocator.inl>
+
+//.hファイルのインクルードに伴い、常に.cpp.hファイル（および.inlファイル）を自動インクルードする場合
+#ifdef GASHA_COMPACTING_ALLOCATOR_ALLWAYS_TOGETHER_CPP_H
+#include <gasha/compacting_allocator.cpp.h>
+#endif//GASHA_COMPACTING_ALLOCATOR_ALLWAYS_TOGETHER_CPP_H
+
+#endif//GASHA_INCLUDED_COMPACTING_ALLOCATOR_H
+
+// End of file
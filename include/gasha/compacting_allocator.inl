@@ -0,0 +1,282 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_COMPACTING_ALLOCATOR_INL
+#define GASHA_INCLUDED_COMPACTING_ALLOCATOR_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// compacting_allocator.inl
+// コンパクションアロケータ【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/compacting_allocator.h>//コンパクションアロケータ【宣言部】
+
+#include <gasha/allocator_common.h>//アロケータ共通設定・処理：コンストラクタ／デストラクタ呼び出し
+#include <gasha/simple_assert.h>//シンプルアサーション
+
+#include <utility>//C++11 std::forward
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//コンパクションアロケータクラス
+
+//ハンドルからポインタを取得
+//※型指定版
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+template<typename T>
+inline T* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::get(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle) const
+{
+	return static_cast<T*>(get(handle));
+}
+
+//メモリ確保とコンストラクタ呼び出し
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+template<typename T, typename...Tx>
+typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::newHandle(Tx&&... args)
+{
+	const handle_type handle = allocHandle(sizeof(T), alignof(T));
+	if (handle == INVALID_HANDLE)
+		return INVALID_HANDLE;
+	GASHA_ callConstructor<T>(get(handle), std::forward<Tx>(args)...);
+	return handle;
+}
+
+//メモリ解放とデストラクタ呼び出し
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+template<typename T>
+bool compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::deleteHandle(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle)
+{
+	T* p = get<T>(handle);
+	if (!p)
+		return false;
+	GASHA_ callDestructor(p);//デストラクタ呼び出し
+	return freeHandle(handle);
+}
+
+//デフラグ済みか？
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline bool compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::isDefragmented() const
+{
+	return m_defragPos >= m_top;
+}
+
+//メモリ確保とコンストラクタ呼び出し
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+template<typename T, typename...Tx>
+T* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::newObj(Tx&&... args)
+{
+	void* p = alloc(sizeof(T), alignof(T));
+	if (!p)
+		return nullptr;
+	return GASHA_ callConstructor<T>(p, std::forward<Tx>(args)...);
+}
+//※配列用
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+template<typename T, typename...Tx>
+T* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::newArray(const std::size_t num, Tx&&... args)
+{
+	void* p = alloc(sizeof(T) * num, alignof(T));
+	if (!p)
+		return nullptr;
+	T* top_obj = nullptr;
+	for (std::size_t i = 0; i < num; ++i)
+	{
+		T* obj = GASHA_ callConstructor<T>(p, std::forward<Tx>(args)...);
+		if (!top_obj)
+			top_obj = obj;
+		p = reinterpret_cast<void*>(reinterpret_cast<char*>(p) + sizeof(T));
+	}
+	return top_obj;
+}
+
+//メモリ解放とデストラクタ呼び出し
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+template<typename T>
+bool compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::deleteObj(T* p)
+{
+	if (!p)//nullptrの解放は常に成功扱い
+		return true;
+	GASHA_ callDestructor(p);//デストラクタ呼び出し
+	return free(p);
+}
+//※配列用
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+template<typename T>
+bool compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::deleteArray(T* p, const std::size_t num)
+{
+	if (!p)//nullptrの解放は常に成功扱い
+		return true;
+	T* obj = p;
+	for (std::size_t i = 0; i < num; ++i, ++obj)
+	{
+		GASHA_ callDestructor(obj);//デストラクタ呼び出し
+	}
+	return free(p);
+}
+
+//ハンドルの作成
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::makeHandle(const std::uint16_t generation, const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::index_type index)
+{
+	return (static_cast<handle_type>(generation) << 16) | static_cast<handle_type>(index);
+}
+
+//ハンドルからインデックスを取得
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::index_type compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handleIndex(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle)
+{
+	return static_cast<index_type>(handle & 0xffffu);
+}
+
+//ハンドルから世代を取得
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline std::uint16_t compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handleGeneration(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle)
+{
+	return static_cast<std::uint16_t>(handle >> 16);
+}
+
+//管理ヘッダー取得
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::blockHeader* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::header(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type offset)
+{
+	return reinterpret_cast<blockHeader*>(m_buffRef + offset);
+}
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::blockHeader* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::header(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type offset) const
+{
+	return reinterpret_cast<const blockHeader*>(m_buffRef + offset);
+}
+
+//データ領域取得
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline void* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::data(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::size_type offset) const
+{
+	return reinterpret_cast<void*>(m_buffRef + offset + HEADER_SIZE);
+}
+
+//ハンドル情報取得
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handleInfo* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::refHandle(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle)
+{
+	const index_type index = handleIndex(handle);
+	if (handle == INVALID_HANDLE || index >= HANDLE_NUM)
+		return nullptr;
+	handleInfo& info = m_handles[index];
+	if (!info.m_isUsed || info.m_generation != handleGeneration(handle))//未使用か解放済みのハンドル
+		return nullptr;
+	return &info;
+}
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handleInfo* compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::refHandle(const typename compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::handle_type handle) const
+{
+	const index_type index = handleIndex(handle);
+	if (handle == INVALID_HANDLE || index >= HANDLE_NUM)
+		return nullptr;
+	const handleInfo& info = m_handles[index];
+	if (!info.m_isUsed || info.m_generation != handleGeneration(handle))//未使用か解放済みのハンドル
+		return nullptr;
+	return &info;
+}
+
+//コンストラクタ
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::compactingAllocator(void* buff, const std::size_t max_size) :
+	m_buffRef(adjustAlign(reinterpret_cast<char*>(buff), BLOCK_ALIGN)),
+	m_maxSize(0),
+	m_top(0),
+	m_usingSize(0),
+	m_count(0),
+	m_defragPos(0),
+	m_pinnedGapPos(0),
+	m_movedSize(0),
+	m_movedCount(0),
+	m_freeHandle(INVALID_INDEX)
+{
+	//バッファの先頭をアラインメント調整した分、サイズを縮める
+	const std::size_t padding_size = static_cast<std::size_t>(m_buffRef - reinterpret_cast<char*>(buff));
+	const std::size_t usable_size = max_size > padding_size ? max_size - padding_size : 0;
+	m_maxSize = static_cast<size_type>(usable_size - usable_size % BLOCK_ALIGN);
+#ifdef GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+	GASHA_SIMPLE_ASSERT(buff != nullptr, "buff is nullptr.");
+	GASHA_SIMPLE_ASSERT(m_maxSize > 0, "max_size is too small.");
+#endif//GASHA_COMPACTING_ALLOCATOR_ENABLE_ASSERTION
+	m_pinnedGapPos = m_maxSize;
+	for (index_type index = 0; index < HANDLE_NUM; ++index)
+	{
+		handleInfo& info = m_handles[index];
+		info.m_generation = 0;
+		info.m_isUsed = false;
+	}
+	initHandles();
+}
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+template<typename T>
+inline compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::compactingAllocator(T* buff, const std::size_t num) :
+	compactingAllocator(reinterpret_cast<void*>(buff), sizeof(T) * num)//C++11 委譲コンストラクタ
+{}
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+template<typename T, std::size_t N>
+inline compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::compactingAllocator(T(&buff)[N]) :
+	compactingAllocator(reinterpret_cast<void*>(buff), sizeof(buff))//C++11 委譲コンストラクタ
+{}
+
+//デストラクタ
+template<std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline compactingAllocator<_HANDLE_NUM, LOCK_POLICY>::~compactingAllocator()
+{}
+
+//--------------------------------------------------------------------------------
+//バッファ付きコンパクションアロケータクラス
+
+//コンストラクタ
+template<std::size_t _MAX_SIZE, std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline compactingAllocator_withBuff<_MAX_SIZE, _HANDLE_NUM, LOCK_POLICY>::compactingAllocator_withBuff() :
+	compactingAllocator<_HANDLE_NUM, LOCK_POLICY>(m_buff, MAX_SIZE)
+{}
+
+//デストラクタ
+template<std::size_t _MAX_SIZE, std::size_t _HANDLE_NUM, class LOCK_POLICY>
+inline compactingAllocator_withBuff<_MAX_SIZE, _HANDLE_NUM, LOCK_POLICY>::~compactingAllocator_withBuff()
+{}
+
+//--------------------------------------------------------------------------------
+//スコープピン留めクラス
+
+//コンストラクタ
+template<class ALLOCATOR>
+inline scopedPin<ALLOCATOR>::scopedPin(typename scopedPin<ALLOCATOR>::allocator_type& allocator, const typename scopedPin<ALLOCATOR>::handle_type handle) :
+	m_allocator(allocator),
+	m_handle(handle),
+	m_ptr(allocator.pin(handle))
+{}
+
+//ムーブコンストラクタ
+template<class ALLOCATOR>
+inline scopedPin<ALLOCATOR>::scopedPin(scopedPin<ALLOCATOR>&& obj) :
+	m_allocator(obj.m_allocator),
+	m_handle(obj.m_handle),
+	m_ptr(obj.m_ptr)
+{
+	obj.m_ptr = nullptr;
+}
+
+//デストラクタ
+template<class ALLOCATOR>
+inline scopedPin<ALLOCATOR>::~scopedPin()
+{
+	if (m_ptr)
+		m_allocator.unpin(m_handle);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_COMPACTING_ALLOCATOR_INL
+
+// End of file
@@ -0,0 +1,107 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_CPU_FEATURES_H
+#define GASHA_INCLUDED_CPU_FEATURES_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// cpu_features.h
+// CPU機能判定（実行時の命令セット振り分け用）【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <cstdint>//C++11 std::uint32_t, std::uint64_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//CPU機能判定
+//※実行中のCPUが対応している命令セットを、CPUID命令で判定する。
+//※AVX/AVX-512 は、CPUの対応に加えて、OSがレジスタの退避に対応しているか（XCR0）も判定する。
+//※判定は初回の instance() 呼び出し時に一度だけ行い、以後はその結果を返す。
+//※ビルド設定 GASHA_USE_RUNTIME_CPU_DISPATCH が有効な場合、コンパイル時に有効化されていない命令を使用する処理
+//　（calcCRC32, strlen_fast, strstr_fast, 高速ベクトル演算のSoAバッチ処理, simdSmallSort）は、
+//　この判定結果に基づいて実行時に処理を振り分ける。
+//※x86系以外のCPUでは、常にすべての機能が非対応となる。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  if (cpuFeatures::instance().hasAVX2())
+//      ...
+//--------------------------------------------------------------------------------
+class cpuFeatures
+{
+public:
+	//型
+	enum feature_t : std::uint32_t//機能
+	{
+		SSE = 0x00000001,
+		SSE2 = 0x00000002,
+		SSE3 = 0x00000004,
+		SSSE3 = 0x00000008,
+		SSE4_1 = 0x00000010,
+		SSE4_2 = 0x00000020,
+		POPCNT = 0x00000040,
+		AVX = 0x00000080,
+		AVX2 = 0x00000100,
+		FMA3 = 0x00000200,
+		F16C = 0x00000400,
+		BMI1 = 0x00000800,
+		BMI2 = 0x00001000,
+		AVX512F = 0x00002000,
+		AVX512DQ = 0x00004000,
+		AVX512BW = 0x00008000,
+		AVX512VL = 0x00010000,
+	};
+
+public:
+	//アクセッサ
+	inline std::uint32_t features() const { return m_features; }//対応機能（feature_t の論理和）
+	inline bool has(const feature_t feature) const { return (m_features & feature) != 0; }//指定の機能に対応しているか？
+	inline bool hasSSE() const { return has(SSE); }
+	inline bool hasSSE2() const { return has(SSE2); }
+	inline bool hasSSE3() const { return has(SSE3); }
+	inline bool hasSSSE3() const { return has(SSSE3); }
+	inline bool hasSSE4_1() const { return has(SSE4_1); }
+	inline bool hasSSE4_2() const { return has(SSE4_2); }
+	inline bool hasPOPCNT() const { return has(POPCNT); }
+	inline bool hasAVX() const { return has(AVX); }
+	inline bool hasAVX2() const { return has(AVX2); }
+	inline bool hasFMA3() const { return has(FMA3); }
+	inline bool hasF16C() const { return has(F16C); }
+	inline bool hasBMI1() const { return has(BMI1); }
+	inline bool hasBMI2() const { return has(BMI2); }
+	inline bool hasAVX512F() const { return has(AVX512F); }
+	inline bool hasAVX512DQ() const { return has(AVX512DQ); }
+	inline bool hasAVX512BW() const { return has(AVX512BW); }
+	inline bool hasAVX512VL() const { return has(AVX512VL); }
+
+public:
+	//静的メソッド
+
+	//インスタンス取得
+	//※初回呼び出し時にCPU機能を判定する（スレッドセーフ）
+	inline static const cpuFeatures& instance();
+
+public:
+	//コンストラクタ
+	//※CPU機能を判定する
+	inline cpuFeatures();
+	//デストラクタ
+	inline ~cpuFeatures();
+
+private:
+	//フィールド
+	std::uint32_t m_features;//対応機能
+};
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/cpu_features.inl>
+
+#endif//GASHA_INCLUDED_CPU_FEATURES_H
+
+// End of file
@@ -0,0 +1,128 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_CPU_FEATURES_INL
+#define GASHA_INCLUDED_CPU_FEATURES_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// cpu_features.inl
+// CPU機能判定（実行時の命令セット振り分け用）【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/cpu_features.h>//CPU機能判定【宣言部】
+
+#if defined(GASHA_IS_X86) && defined(GASHA_IS_VC)
+#include <intrin.h>//__cpuidex(), _xgetbv()
+#endif//GASHA_IS_X86, GASHA_IS_VC
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//CPU機能判定
+
+#ifdef GASHA_IS_X86
+namespace _private
+{
+	//CPU情報取得
+	//※サブリーフ（ECX）の指定が必要な Type7 を取得するため、cpuid.h の __cpuid() は使用しない
+	inline void cpuidex(int cpu_info[4], const int type, const int sub_type)
+	{
+	#ifdef GASHA_IS_VC
+		__cpuidex(cpu_info, type, sub_type);
+	#else//GASHA_IS_VC
+		__asm__ __volatile__("cpuid" : "=a"(cpu_info[0]), "=b"(cpu_info[1]), "=c"(cpu_info[2]), "=d"(cpu_info[3]) : "a"(type), "c"(sub_type));
+	#endif//GASHA_IS_VC
+	}
+	//拡張コントロールレジスタ取得
+	//※OSXSAVE 対応を確認してから呼び出すこと
+	inline std::uint64_t xgetbv(const std::uint32_t xcr)
+	{
+	#ifdef GASHA_IS_VC
+		return _xgetbv(xcr);
+	#else//GASHA_IS_VC
+		std::uint32_t eax, edx;
+		__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(xcr));
+		return (static_cast<std::uint64_t>(edx) << 32) | eax;
+	#endif//GASHA_IS_VC
+	}
+}//namespace _private
+#endif//GASHA_IS_X86
+
+//インスタンス取得
+inline const cpuFeatures& cpuFeatures::instance()
+{
+	static const cpuFeatures s_instance;
+	return s_instance;
+}
+
+//コンストラクタ
+inline cpuFeatures::cpuFeatures() :
+	m_features(0)
+{
+#ifdef GASHA_IS_X86
+	int cpu_info[4];
+	_private::cpuidex(cpu_info, 0, 0);//CPU情報取得：Type0
+	const int max_type = cpu_info[0];
+	if (max_type < 1)
+		return;
+	_private::cpuidex(cpu_info, 1, 0);//CPU情報取得：Type1
+	const std::uint32_t ecx1 = static_cast<std::uint32_t>(cpu_info[2]);
+	const std::uint32_t edx1 = static_cast<std::uint32_t>(cpu_info[3]);
+	std::uint32_t ebx7 = 0;
+	if (max_type >= 7)
+	{
+		_private::cpuidex(cpu_info, 7, 0);//CPU情報取得：Type7
+		ebx7 = static_cast<std::uint32_t>(cpu_info[1]);
+	}
+	//OSによるレジスタの退避への対応
+	bool os_ymm = false;//YMMレジスタ（XCR0 の bit1:SSE, bit2:AVX）
+	bool os_zmm = false;//ZMMレジスタ（上記＋ bit5:opmask, bit6:ZMM上位, bit7:ZMM16-31）
+	if (ecx1 & (1u << 27))//OSXSAVE
+	{
+		const std::uint64_t xcr0 = _private::xgetbv(0);
+		os_ymm = (xcr0 & 0x06) == 0x06;
+		os_zmm = (xcr0 & 0xe6) == 0xe6;
+	}
+	std::uint32_t features = 0;
+	if (edx1 & (1u << 25)) features |= SSE;
+	if (edx1 & (1u << 26)) features |= SSE2;
+	if (ecx1 & (1u << 0)) features |= SSE3;
+	if (ecx1 & (1u << 9)) features |= SSSE3;
+	if (ecx1 & (1u << 19)) features |= SSE4_1;
+	if (ecx1 & (1u << 20)) features |= SSE4_2;
+	if (ecx1 & (1u << 23)) features |= POPCNT;
+	if (ebx7 & (1u << 3)) features |= BMI1;
+	if (ebx7 & (1u << 8)) features |= BMI2;
+	if (os_ymm)
+	{
+		if (ecx1 & (1u << 28)) features |= AVX;
+		if ((features & AVX) && (ebx7 & (1u << 5))) features |= AVX2;
+		if ((features & AVX) && (ecx1 & (1u << 12))) features |= FMA3;
+		if ((features & AVX) && (ecx1 & (1u << 29))) features |= F16C;
+	}
+	if (os_zmm)
+	{
+		if (ebx7 & (1u << 16)) features |= AVX512F;
+		if ((features & AVX512F) && (ebx7 & (1u << 17))) features |= AVX512DQ;
+		if ((features & AVX512F) && (ebx7 & (1u << 30))) features |= AVX512BW;
+		if ((features & AVX512F) && (ebx7 & (1u << 31))) features |= AVX512VL;
+	}
+	m_features = features;
+#endif//GASHA_IS_X86
+}
+
+//デストラクタ
+inline cpuFeatures::~cpuFeatures()
+{}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_CPU_FEATURES_INL
+
+// End of file
@@ -42,6 +42,8 @@ inline constexpr crc32_t operator "" _crc32(const char* str, const std::size_t l
 //--------------------
 //【ランタイム関数版】
 //※処理方法は、コンパイル時の設定に応じて、SSE命令版、事前計算済みテーブル版、ループ処理版のいずれかが適用される。
+//※ビルド設定 GASHA_USE_RUNTIME_CPU_DISPATCH が有効で、SSE4.2命令がコンパイル時に無効な場合、
+//　初回呼び出し時にCPUのSSE4.2命令対応を判定し、SSE命令版か事前計算済みテーブル版を選択する。（CRC-32C の場合のみ）
 inline crc32_t calcCRC32(const char* str);//文字列から算出
 inline crc32_t calcCRC32(const char* data, const std::size_t len);//バイナリデータから算出
 
@@ -16,6 +16,13 @@
 
 #include <gasha/crc32.h>//CRC32計算【宣言部】
 
+#ifdef GASHA_CRC32_DISPATCH_SSE
+#include <gasha/cpu_features.h>//CPU機能判定
+
+#include <cstring>//std::strlen(), std::memcpy()
+#include <nmmintrin.h>//SSE4.2
+#endif//GASHA_CRC32_DISPATCH_SSE
+
 GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 
 //--------------------
@@ -104,6 +111,49 @@ inline constexpr crc32_t operator "" _crc32(const char* str, const std::size_t l
 }
 #endif//GASHA_HAS_USER_DEFINED_LITERAL
 
+#ifdef GASHA_CRC32_DISPATCH_SSE
+//--------------------
+//実行時のCPU機能判定による振り分け用
+namespace _private
+{
+	//--------------------
+	//SSE4.2命令版：バイナリデータから算出
+	//※SSE4.2命令に対応したCPUでのみ呼び出すこと
+	GASHA_TARGET_SSE4_2 inline GASHA_ crc32_t calcCRC32_sse4_2(const char* data, const std::size_t len)
+	{
+		const char* p = data;
+		const char* end = data + len;
+	#ifdef GASHA_IS_64BIT
+		std::uint64_t crc64 = ~static_cast<GASHA_ crc32_t>(0);
+		for (; end - p >= 8; p += 8)
+		{
+			std::uint64_t value;
+			std::memcpy(&value, p, sizeof(value));
+			crc64 = _mm_crc32_u64(crc64, value);
+		}
+		GASHA_ crc32_t crc = static_cast<GASHA_ crc32_t>(crc64);
+	#else//GASHA_IS_64BIT
+		GASHA_ crc32_t crc = ~static_cast<GASHA_ crc32_t>(0);
+		for (; end - p >= 4; p += 4)
+		{
+			std::uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			crc = _mm_crc32_u32(crc, value);
+		}
+	#endif//GASHA_IS_64BIT
+		for (; p < end; ++p)
+			crc = _mm_crc32_u8(crc, static_cast<unsigned char>(*p));
+		return ~crc;
+	}
+	//--------------------
+	//SSE4.2命令版：文字列から算出
+	GASHA_TARGET_SSE4_2 inline GASHA_ crc32_t calcCRC32_sse4_2(const char* str)
+	{
+		return calcCRC32_sse4_2(str, std::strlen(str));
+	}
+}//namespace _private
+#endif//GASHA_CRC32_DISPATCH_SSE
+
 //--------------------
 //【ランタイム関数版】文字列から算出
 inline crc32_t calcCRC32(const char* str)
@@ -111,11 +161,19 @@ inline crc32_t calcCRC32(const char* str)
 #ifdef GASHA_CRC32_USE_SSE
 	return calcCRC32_sse(str);
 #else//GASHA_CRC32_USE_SSE
+#ifdef GASHA_CRC32_DISPATCH_SSE
+	//実行時のCPU機能判定による振り分け
+	//※初回呼び出し時に関数を選択し、以後は関数ポインタ経由で呼び出す
+	typedef crc32_t(*func_type)(const char*);
+	static const func_type func = GASHA_ cpuFeatures::instance().hasSSE4_2() ? static_cast<func_type>(_private::calcCRC32_sse4_2) : static_cast<func_type>(calcCRC32_table);
+	return func(str);
+#else//GASHA_CRC32_DISPATCH_SSE
 #ifdef GASHA_CRC32_USE_STATIC_TABLE
 	return calcCRC32_table(str);
 #else//GASHA_CRC32_USE_STATIC_TABLE
 	return calcCRC32_loop(str);
 #endif//GASHA_CRC32_USE_STATIC_TABLE
+#endif//GASHA_CRC32_DISPATCH_SSE
 #endif//GASHA_CRC32_USE_SSE
 }
 //--------------------
@@ -125,11 +183,19 @@ inline crc32_t calcCRC32(const char* data, const std::size_t len)
 #ifdef GASHA_CRC32_USE_SSE
 	return calcCRC32_sse(data, len);
 #else//GASHA_CRC32_USE_SSE
+#ifdef GASHA_CRC32_DISPATCH_SSE
+	//実行時のCPU機能判定による振り分け
+	//※初回呼び出し時に関数を選択し、以後は関数ポインタ経由で呼び出す
+	typedef crc32_t(*func_type)(const char*, const std::size_t);
+	static const func_type func = GASHA_ cpuFeatures::instance().hasSSE4_2() ? static_cast<func_type>(_private::calcCRC32_sse4_2) : static_cast<func_type>(calcCRC32_table);
+	return func(data, len);
+#else//GASHA_CRC32_DISPATCH_SSE
 #ifdef GASHA_CRC32_USE_STATIC_TABLE
 	return calcCRC32_table(data, len);
 #else//GASHA_CRC32_USE_STATIC_TABLE
 	return calcCRC32_loop(data, len);
 #endif//GASHA_CRC32_USE_STATIC_TABLE
+#endif//GASHA_CRC32_DISPATCH_SSE
 #endif//GASHA_CRC32_USE_SSE
 }
 
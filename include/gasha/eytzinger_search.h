@@ -0,0 +1,92 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_EYTZINGER_SEARCH_H
+#define GASHA_INCLUDED_EYTZINGER_SEARCH_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// eytzinger_search.h
+// Eytzinger配置探索【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/search_basic.h>//探索処理基本
+
+#include <cstddef>//std::size_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//探索アルゴリズムの説明
+//========================================
+
+//・計算時間：
+//    - O(n)       ... データ件数分の時間
+//    - O(n ^ 2)   ... データ件数の２乗分の時間
+//    - O(log n)   ... log2(データ件数)分の時間（4→2, 16→4, 1024→10,1048576→20）
+//    - O(n log n) ... n×log n 分の時間
+
+//----------------------------------------
+//Eytzinger配置の作成
+//----------------------------------------
+//・計算時間：O(n)
+//----------------------------------------
+//※整列済みの配列 sorted を、二分探索木を幅優先順に並べた配置（Eytzinger配置）にして、layout にコピーする。
+//　layout には size 件の領域が必要。sorted と同じ領域は指定できない。
+//※Eytzinger配置では、k 番目（1 起点）の要素の子が 2k 番目と 2k+1 番目に並ぶ。
+//　探索の経路が配列の先頭付近に集まり、同じ深さの要素が連続するため、キャッシュ効率が良い。
+//　また、子孫の位置が計算で求まるため、数段先の比較対象をプリフェッチできる。
+//※読み取り専用の静的なテーブルを、何度も探索する用途に使用する。
+//　要素の追加・削除を行う場合は、配置を作り直す必要がある。
+//※キーに値を対応付けたい場合は、キーと値をまとめた構造体の配列として配置を作成する。
+template<class T>
+void buildEytzingerLayout(const T* sorted, const std::size_t size, T* layout);
+
+//----------------------------------------
+//アルゴリズム：Eytzinger配置の下限探索
+//----------------------------------------
+//・最良計算時間：O(log n)
+//・平均計算時間：O(log n)
+//・最悪計算時間：O(log n)
+//・探索失敗時：  O(log n)
+//----------------------------------------
+//※buildEytzingerLayout() で作成した配置から、探索値以上となる最初の要素（整列済み配列での
+//　std::lower_bound() と同じ要素）を探索し、配置上の要素を返す。
+//　全要素が探索値より小さい場合は nullptr を返す。
+//※比較結果で子の位置を計算するだけのため、分岐予測ミスが発生しない。
+//※キャッシュライン１本分先の子孫（要素サイズが 4 バイトなら 4 段先）をプリフェッチする。
+//----------------------------------------
+//プロトタイプ：
+//・bool COMPARISON(const T& value)//value == 探索値なら0を、value < 探索値なら-1以下を、value > 探索値なら1以上を返す
+template<class T, class COMPARISON>
+T* eytzingerLowerBound(T* layout, const std::size_t size, COMPARISON comparison);
+GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_COMPARISON(eytzingerLowerBound);
+
+//----------------------------------------
+//アルゴリズム：Eytzinger配置の探索
+//----------------------------------------
+//・最良計算時間：O(log n)
+//・平均計算時間：O(log n)
+//・最悪計算時間：O(log n)
+//・探索失敗時：  O(log n)
+//----------------------------------------
+//※eytzingerLowerBound() で探索し、見つかった要素が探索値と一致する場合のみ返す。
+//※一致する要素が複数ある場合は、整列済み配列で先頭にあたる要素を返す。
+//----------------------------------------
+//プロトタイプ：
+//・bool COMPARISON(const T& value)//value == 探索値なら0を、value < 探索値なら-1以下を、value > 探索値なら1以上を返す
+template<class T, class COMPARISON>
+T* eytzingerSearch(T* layout, const std::size_t size, COMPARISON comparison);
+GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_COMPARISON(eytzingerSearch);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/eytzinger_search.inl>
+
+#endif//GASHA_INCLUDED_EYTZINGER_SEARCH_H
+
+// End of file
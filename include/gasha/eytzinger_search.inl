@@ -0,0 +1,88 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_EYTZINGER_SEARCH_INL
+#define GASHA_INCLUDED_EYTZINGER_SEARCH_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// eytzinger_search.inl
+// Eytzinger配置探索【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/eytzinger_search.h>//Eytzinger配置探索【宣言部】
+
+#include <gasha/memory.h>//メモリ操作：prefetch()
+
+#include <cstdint>//std::uintptr_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//----------------------------------------
+//Eytzinger配置の作成
+namespace _private
+{
+	//※中間順（in-order）に木をたどりながら、整列済みの要素を順に割り当てる
+	//※再帰の深さは log2(n) 段
+	template<class T>
+	void buildEytzingerLayout(const T*& sorted, const std::size_t size, T* layout, const std::size_t index)
+	{
+		if (index > size)
+			return;
+		buildEytzingerLayout(sorted, size, layout, index * 2);
+		layout[index - 1] = *(sorted++);
+		buildEytzingerLayout(sorted, size, layout, index * 2 + 1);
+	}
+}//namespace _private
+template<class T>
+void buildEytzingerLayout(const T* sorted, const std::size_t size, T* layout)
+{
+	if (!sorted || !layout || size == 0)
+		return;
+	_private::buildEytzingerLayout(sorted, size, layout, 1);
+}
+
+//----------------------------------------
+//アルゴリズム：Eytzinger配置の下限探索
+template<class T, class COMPARISON>
+T* eytzingerLowerBound(T* layout, const std::size_t size, COMPARISON comparison)
+{
+	if (!layout || size == 0)
+		return nullptr;
+	static const std::size_t CACHE_LINE_SIZE = 64;//キャッシュラインのサイズ
+	static const std::size_t PREFETCH_STRIDE = sizeof(T) < CACHE_LINE_SIZE ? CACHE_LINE_SIZE / sizeof(T) : 1;//プリフェッチする子孫の位置の倍率
+	const std::uintptr_t layout_addr = reinterpret_cast<std::uintptr_t>(layout);
+	std::size_t index = 1;//1 起点のインデックス
+	while (index <= size)
+	{
+		//キャッシュライン１本分先の子孫をプリフェッチ
+		//※配列の範囲外を指すことがあるが、プリフェッチは例外を発生しない
+		GASHA_ prefetch(reinterpret_cast<const void*>(layout_addr + (index * PREFETCH_STRIDE - 1) * sizeof(T)));
+		//探索値が要素より大きければ右の子、それ以外は左の子に進む ※分岐なし
+		index = index * 2 + (comparison(layout[index - 1]) > 0 ? 1 : 0);
+	}
+	//最後に左の子に進んだ位置まで戻る
+	//※右の子に進んだ回数（下位から連続する 1 のビット数）＋１段分戻す
+	index >>= (_private::searchCountTrailingOnes(index) + 1);
+	return index == 0 ? nullptr : layout + (index - 1);
+}
+
+//----------------------------------------
+//アルゴリズム：Eytzinger配置の探索
+template<class T, class COMPARISON>
+inline T* eytzingerSearch(T* layout, const std::size_t size, COMPARISON comparison)
+{
+	T* found = GASHA_ eytzingerLowerBound(layout, size, comparison);
+	return found && comparison(*found) == 0 ? found : nullptr;
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_EYTZINGER_SEARCH_INL
+
+// End of file
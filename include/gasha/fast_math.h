@@ -30,9 +30,13 @@
 #include <smmintrin.h>//SSE4.1
 #endif//GASHA_USE_SSE4_1
 
-#ifdef GASHA_USE_AVX
+#if defined(GASHA_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
 #include <immintrin.h>//AVX
-#endif//GASHA_USE_AVX
+#endif//GASHA_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+
+#ifdef GASHA_FAST_ARITH_DISPATCH_AVX
+#include <gasha/cpu_features.h>//CPU機能判定
+#endif//GASHA_FAST_ARITH_DISPATCH_AVX
 
 GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 
@@ -1738,6 +1742,183 @@ GASHA_FAST_VECTOR_OPERATION_SPECIALIZATION(float, 4);
 
 #endif//GASHA_USE_SSE4_1
 
+//--------------------------------------------------------------------------------
+//高速ベクトル演算：SoAバッチ処理
+//※x, y, z 成分をそれぞれ別の配列に格納した SoA（Structure of Arrays）形式の3次元ベクトル列を一括処理する。
+//※AVXが有効なら8要素ずつ、SSEが有効なら4要素ずつ処理し、端数はスカラー演算で処理する。
+//　1ベクトルずつ演算する場合と異なり、全レーンを使用し、水平加算も不要。
+//※ビルド設定 GASHA_USE_RUNTIME_CPU_DISPATCH が有効で、AVX命令がコンパイル時に無効な場合、
+//　CPUのAVX命令対応を実行時に判定し、対応していればAVX命令で8要素ずつ処理する。
+//※テンプレート引数 ARITH に演算クラス（fastA, fastestA, semiA, sseA, normA）を指定し、平方根の精度を選択する。
+//　・fastA    ... 逆平方根の近似値を元にニュートン法を1回適用する。（デフォルト）
+//　・fastestA ... 逆平方根の近似値をそのまま使用する。
+//　・semiA    ... 逆平方根の近似値を元にニュートン法を2回適用する。
+//　・その他   ... 通常の平方根と除算を用いる。
+//　※GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION が無効な場合は、常に通常の平方根と除算を用いる。
+//※出力先に入力と同じ配列を指定してもよい。（ただし、ずれて重なる配列は不可）
+//※配列のアラインメントは問わない。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  dotBatch(ax, ay, az, bx, by, bz, out, n);//内積（fastA）
+//  normalizeBatch<semiA>(x, y, z, x, y, z, n);//正規化（semiA, 上書き）
+//--------------------------------------------------------------------------------
+
+//ノルム
+template<template<typename> class ARITH = fastA>
+inline void normBatch(const float* x, const float* y, const float* z, float* out, const std::size_t n);
+//ノルムの二乗
+template<template<typename> class ARITH = fastA>
+inline void normSqBatch(const float* x, const float* y, const float* z, float* out, const std::size_t n);
+//二点間の長さ
+template<template<typename> class ARITH = fastA>
+inline void lengthBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, const std::size_t n);
+//正規化
+template<template<typename> class ARITH = fastA>
+inline void normalizeBatch(const float* x, const float* y, const float* z, float* out_x, float* out_y, float* out_z, const std::size_t n);
+//スカラー長の進行
+template<template<typename> class ARITH = fastA>
+inline void forwardBatch(const float* x, const float* y, const float* z, const float scalar, float* out_x, float* out_y, float* out_z, const std::size_t n);
+//内積
+template<template<typename> class ARITH = fastA>
+inline void dotBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, const std::size_t n);
+//外積
+template<template<typename> class ARITH = fastA>
+inline void crossBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out_x, float* out_y, float* out_z, const std::size_t n);
+
+namespace _private
+{
+	//----------------------------------------
+	//SoAバッチ処理用：平方根／逆平方根
+	//※NEWTON_COUNT ... 逆平方根の近似値に適用するニュートン法の回数（負の値なら通常の平方根と除算を用いる）
+	template<int NEWTON_COUNT>
+	struct fastBatchSqr
+	{
+		static inline float sqrt(const float value);//平方根
+		static inline float rsqrt(const float value);//逆平方根
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		static inline __m128 sqrt(const __m128 value_m128);//平方根
+		static inline __m128 rsqrt(const __m128 value_m128);//逆平方根
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+		GASHA_TARGET_AVX static inline __m256 sqrt(const __m256 value_m256);//平方根
+		GASHA_TARGET_AVX static inline __m256 rsqrt(const __m256 value_m256);//逆平方根
+	#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+	};
+	//----------------------------------------
+	//SoAバッチ処理用：演算クラスごとの平方根／逆平方根
+	template<template<typename> class ARITH>
+	struct fastBatchOpe : public fastBatchSqr<-1>{};
+#ifdef GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION
+	template<>
+	struct fastBatchOpe<fastA> : public fastBatchSqr<1>{};
+	template<>
+	struct fastBatchOpe<fastestA> : public fastBatchSqr<0>{};
+	template<>
+	struct fastBatchOpe<semiA> : public fastBatchSqr<2>{};
+#endif//GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	//----------------------------------------
+	//SoAバッチ処理用：AVX命令を使用するか？
+	//※実行時に振り分ける場合、CPUのAVX命令対応を判定する
+	inline bool fastBatchIsAVX();
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+}//namespace _private
+
+//--------------------------------------------------------------------------------
+//高速超越関数
+//※多項式近似により、正弦／余弦／指数／対数／逆正接／べき乗を、float, __m128, __m256 で一括演算する。
+//※テンプレート引数 ARITH に演算クラス（fastA, fastestA, semiA, sseA, normA）を指定し、精度を選択する。
+//　・fastestA ... 相対誤差 約11～13ビット（最も少ない項数の多項式）
+//　・fastA    ... 相対誤差 約19～22ビット（デフォルト）
+//　・その他   ... 誤差 1ulp 以内（semiA など）
+//　　範囲縮小以降を倍精度で計算し、最後に１回だけ単精度に丸める。
+//　※演算クラスごとの誤差と処理時間は、fast_math_diag.h の fastTransDiagnosticReport() で計測できる。
+//　※fastestA, fastA の fastSin, fastCos は、結果が 0 に近い時は相対誤差ではなく絶対誤差で評価すること。
+//　※fastAtan2 は、GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION が有効なら、
+//　　fastestA では逆数の近似値、fastA では逆数の近似値にニュートン法を1回適用したものを除算に用いる。
+//※fastSin, fastCos, fastSinCos は、|x| ≦ 8192 の範囲で精度を保証する。それを超えると範囲縮小の誤差で精度が低下する。
+//　（その他の演算クラスでは |x| ≦ 1048576 の範囲）
+//※fastExp は、結果が非正規化数になる場合は 0 を返す。
+//※fastPow は、fastestA, fastA では exp(y * log(x)) を単精度で計算するため、|y * log(x)| が大きいほど精度が低下する。
+//　（結果が非正規化数になる場合も 0 を返す）その他の演算クラスでは、内部を倍精度で計算する。
+//※非数、無限大、負数の対数などは、標準ライブラリの関数に準じた値を返す。
+//※SSE2命令が無効な場合、float 版は倍精度の標準ライブラリの関数で計算し、単精度に丸める。
+//※__m128 版は SSE2命令、__m256 版は AVX命令が有効な場合のみ使用可能。（GASHA_FAST_ARITH_USE_SSE2, GASHA_FAST_ARITH_USE_AVX）
+//--------------------------------------------------------------------------------
+//【使用例】
+//  const float s = fastSin(angle);//正弦（fastA）
+//  const __m128 e_m128 = fastExp<semiA>(value_m128);//指数（semiA）
+//--------------------------------------------------------------------------------
+
+//正弦
+template<template<typename> class ARITH = fastA>
+inline float fastSin(const float x);
+//余弦
+template<template<typename> class ARITH = fastA>
+inline float fastCos(const float x);
+//正弦と余弦
+template<template<typename> class ARITH = fastA>
+inline void fastSinCos(const float x, float& sin_result, float& cos_result);
+//指数（e^x）
+template<template<typename> class ARITH = fastA>
+inline float fastExp(const float x);
+//自然対数
+template<template<typename> class ARITH = fastA>
+inline float fastLog(const float x);
+//逆正接（y/x の偏角）
+template<template<typename> class ARITH = fastA>
+inline float fastAtan2(const float y, const float x);
+//べき乗（x^y）
+template<template<typename> class ARITH = fastA>
+inline float fastPow(const float x, const float y);
+
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+template<template<typename> class ARITH = fastA>
+inline __m128 fastSin(const __m128 x);
+template<template<typename> class ARITH = fastA>
+inline __m128 fastCos(const __m128 x);
+template<template<typename> class ARITH = fastA>
+inline void fastSinCos(const __m128 x, __m128& sin_result, __m128& cos_result);
+template<template<typename> class ARITH = fastA>
+inline __m128 fastExp(const __m128 x);
+template<template<typename> class ARITH = fastA>
+inline __m128 fastLog(const __m128 x);
+template<template<typename> class ARITH = fastA>
+inline __m128 fastAtan2(const __m128 y, const __m128 x);
+template<template<typename> class ARITH = fastA>
+inline __m128 fastPow(const __m128 x, const __m128 y);
+#endif//GASHA_FAST_ARITH_USE_SSE2
+
+#ifdef GASHA_FAST_ARITH_USE_AVX
+template<template<typename> class ARITH = fastA>
+inline __m256 fastSin(const __m256 x);
+template<template<typename> class ARITH = fastA>
+inline __m256 fastCos(const __m256 x);
+template<template<typename> class ARITH = fastA>
+inline void fastSinCos(const __m256 x, __m256& sin_result, __m256& cos_result);
+template<template<typename> class ARITH = fastA>
+inline __m256 fastExp(const __m256 x);
+template<template<typename> class ARITH = fastA>
+inline __m256 fastLog(const __m256 x);
+template<template<typename> class ARITH = fastA>
+inline __m256 fastAtan2(const __m256 y, const __m256 x);
+template<template<typename> class ARITH = fastA>
+inline __m256 fastPow(const __m256 x, const __m256 y);
+#endif//GASHA_FAST_ARITH_USE_AVX
+
+namespace _private
+{
+	//----------------------------------------
+	//超越関数用：演算クラスごとの精度
+	//※0 ... fastestA, 1 ... fastA, 2 ... その他
+	template<template<typename> class ARITH>
+	struct fastTransPrecision{ static const int value = 2; };
+	template<>
+	struct fastTransPrecision<fastestA>{ static const int value = 0; };
+	template<>
+	struct fastTransPrecision<fastA>{ static const int value = 1; };
+}//namespace _private
+
 //--------------------------------------------------------------------------------
 //テンプレート行列
 //※fast_math.hをインクルードすることで、float×4×4の時に特殊化して、高速演算を利用可能
@@ -1776,23 +1957,16 @@ inline void m128_mul(__m128 (&mat_result)[4], const __m128 (&mat1_m128)[4], cons
 #define GASHA_FAST_MATRIX_SET_SPECIALIZATION(CLASS_NAME, T, N, M) \
 	template<> inline CLASS_NAME<T[N][M]> add<T, N, M>(const CLASS_NAME<T[N][M]>& mat1, const CLASS_NAME<T[N][M]>& mat2); \
 	template<> inline CLASS_NAME<T[N][M]> sub<T, N, M>(const CLASS_NAME<T[N][M]>& mat1, const CLASS_NAME<T[N][M]>& mat2); \
-	template<> inline CLASS_NAME<T[N][M]> mul<T, N, M>(const CLASS_NAME<T[N][M]>& mat, const T scalar);
+	template<> inline CLASS_NAME<T[N][M]> mul<T, N, M>(const CLASS_NAME<T[N][M]>& mat, const T scalar); \
+	template<> inline CLASS_NAME<T[N][M]> mul<T, N, M>(const CLASS_NAME<T[N][M]>& mat1, const CLASS_NAME<T[N][M]>& mat2);
 
 GASHA_FAST_MATRIX_SET_SPECIALIZATION(fastA, float, 4, 4);
 GASHA_FAST_MATRIX_SET_SPECIALIZATION(fastestA, float, 4, 4);
 GASHA_FAST_MATRIX_SET_SPECIALIZATION(semiA, float, 4, 4);
+GASHA_FAST_MATRIX_SET_SPECIALIZATION(sseA, float, 4, 4);
 
 #endif//GASHA_FAST_ARITH_USE_SSE
 
-#ifdef GASHA_FAST_ARITH_USE_SSE4_1
-
-#define GASHA_FAST_MATRIX_SET_SPECIALIZATION4_1(CLASS_NAME, T, N, M) \
-	template<> inline CLASS_NAME<T[N][M]> mul<T, N, M>(const CLASS_NAME<T[N][M]>& mat1, const CLASS_NAME<T[N][M]>& mat2);
-
-GASHA_FAST_MATRIX_SET_SPECIALIZATION4_1(sseA, float, 4, 4);
-
-#endif//GASHA_FAST_ARITH_USE_SSE4_1
-
 #ifdef GASHA_MATRIX_OPERATION_ALWAYS_USE_SSE4_1
 //----------
 //行列の加算
@@ -1820,6 +1994,98 @@ void mul<float, 4, 4, 4>(float(&mat_result)[4][4], const float(&mat1)[4][4], con
 
 #endif//GASHA_USE_SSE
 
+//----------------------------------------
+//高速行列演算：4×4行列
+//※float×4×4行列（行優先）と、float×4ベクトル（列ベクトル）の演算。
+//※演算クラスごとに、次のように命令を使い分ける。
+//　・fastA    ... 積和演算に FMA 命令を使用する。（GASHA_USE_FMA3 有効時）
+//　               逆数は、近似値を元にニュートン法を1回適用する。
+//　・fastestA ... 積和演算に FMA 命令を使用する。（GASHA_USE_FMA3 有効時）
+//　               逆数は、近似値をそのまま使用する。
+//　・semiA    ... 乗算と加算を個別に行う。（通常演算と同じ丸め方）
+//　               逆数は、近似値を元にニュートン法を2回適用する。
+//　・sseA, normA ... 乗算と加算を個別に行う。逆数は除算で算出する。
+//　※GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION が無効な場合、逆数は常に除算で算出する。
+//　※逆数は逆行列の算出（行列式の逆数）で使用する。
+//※AVXが有効なら、行列の乗算は2行ずつ、ベクトルのバッチ処理は2ベクトルずつ処理する。
+//※SSEが無効な場合は、通常の演算で処理する。
+//※逆行列は、行列式が 0 の（逆行列が存在しない）場合、結果が非数／無限大になる。
+//※座標変換は、座標（x, y, z, 1）に行列を乗算し、x, y, z を取り出す。（w による除算は行わない）
+//--------------------------------------------------------------------------------
+//【使用例】
+//  fastA_44f mat = ...;
+//  fastA_44f inv = inverse(mat);//逆行列
+//  fastA_4f vec = mul(mat, fastA_4f(vec4));//行列×ベクトル
+//  transformPoints(mat, points, out_points, n);//座標変換（バッチ処理）
+//--------------------------------------------------------------------------------
+
+#define GASHA_FAST_MATRIX44_SET(CLASS_NAME) \
+	inline CLASS_NAME<float[4][4]> transpose(const CLASS_NAME<float[4][4]>& mat); \
+	inline CLASS_NAME<float[4][4]> inverse(const CLASS_NAME<float[4][4]>& mat); \
+	inline CLASS_NAME<float[4]> mul(const CLASS_NAME<float[4][4]>& mat, const CLASS_NAME<float[4]>& vec); \
+	inline void mulBatch(const CLASS_NAME<float[4][4]>& mat, const float (*vec)[4], float (*result)[4], const std::size_t n); \
+	inline void transformPoints(const CLASS_NAME<float[4][4]>& mat, const float (*points)[3], float (*result)[3], const std::size_t n);
+
+GASHA_FAST_MATRIX44_SET(fastA);
+GASHA_FAST_MATRIX44_SET(fastestA);
+GASHA_FAST_MATRIX44_SET(semiA);
+GASHA_FAST_MATRIX44_SET(sseA);
+GASHA_FAST_MATRIX44_SET(normA);
+
+namespace _private
+{
+	//----------------------------------------
+	//4×4行列演算用：通常演算
+	struct fastMatrixScalarCalc
+	{
+		static inline void transpose(float (&mat_result)[4][4], const float (&mat)[4][4]);//転置
+		static inline void inverse(float (&mat_result)[4][4], const float (&mat)[4][4]);//逆行列
+		static inline void mul(float (&mat_result)[4][4], const float (&mat1)[4][4], const float (&mat2)[4][4]);//乗算
+		static inline void mul(float (&vec_result)[4], const float (&mat)[4][4], const float (&vec)[4]);//行列×ベクトル
+		static inline void mulBatch(const float (&mat)[4][4], const float (*vec)[4], float (*result)[4], const std::size_t n);//行列×ベクトル（バッチ処理）
+		static inline void transformPoints(const float (&mat)[4][4], const float (*points)[3], float (*result)[3], const std::size_t n);//座標変換（バッチ処理）
+	};
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	//----------------------------------------
+	//4×4行列演算用：SSE命令
+	//※NEWTON_COUNT ... 逆数の近似値に適用するニュートン法の回数（負の値なら除算で算出）
+	//※USE_FMA ... 積和演算に FMA 命令を使用するか？（GASHA_USE_FMA3 が無効なら無視）
+	template<int NEWTON_COUNT, bool USE_FMA>
+	struct fastMatrixCalc : public fastMatrixScalarCalc
+	{
+		using fastMatrixScalarCalc::transpose;
+		using fastMatrixScalarCalc::inverse;
+		using fastMatrixScalarCalc::mul;
+		using fastMatrixScalarCalc::mulBatch;
+		using fastMatrixScalarCalc::transformPoints;
+		static inline __m128 madd(const __m128 val1_m128, const __m128 val2_m128, const __m128 val3_m128);//積和（val1 * val2 + val3）
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		static inline __m256 madd(const __m256 val1_m256, const __m256 val2_m256, const __m256 val3_m256);//積和（val1 * val2 + val3）
+	#endif//GASHA_FAST_ARITH_USE_AVX
+		static inline __m128 rcp(const __m128 value_m128);//逆数
+		static inline void transpose(__m128 (&mat_result)[4], const __m128 (&mat_m128)[4]);//転置
+		static inline void inverse(__m128 (&mat_result)[4], const __m128 (&mat_m128)[4]);//逆行列
+		static inline void mul(__m128 (&mat_result)[4], const __m128 (&mat1_m128)[4], const __m128 (&mat2_m128)[4]);//乗算
+		static inline __m128 mul(const __m128 (&mat_m128)[4], const __m128 vec_m128);//行列×ベクトル
+		static inline void mulBatch(const __m128 (&mat_m128)[4], const float (*vec)[4], float (*result)[4], const std::size_t n);//行列×ベクトル（バッチ処理）
+		static inline void transformPoints(const __m128 (&mat_m128)[4], const float (*points)[3], float (*result)[3], const std::size_t n);//座標変換（バッチ処理）
+	};
+	//----------------------------------------
+	//4×4行列演算用：演算クラスごとの命令の使い分け
+	template<template<typename> class ARITH>
+	struct fastMatrixOpe : public fastMatrixCalc<-1, false>{};
+	template<>
+	struct fastMatrixOpe<fastA> : public fastMatrixCalc<1, true>{};
+	template<>
+	struct fastMatrixOpe<fastestA> : public fastMatrixCalc<0, true>{};
+	template<>
+	struct fastMatrixOpe<semiA> : public fastMatrixCalc<2, false>{};
+#else//GASHA_FAST_ARITH_USE_SSE
+	template<template<typename> class ARITH>
+	struct fastMatrixOpe : public fastMatrixScalarCalc{};
+#endif//GASHA_FAST_ARITH_USE_SSE
+}//namespace _private
+
 GASHA_NAMESPACE_END;//ネームスペース：終了
 
 //.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
@@ -17,6 +17,8 @@
 
 #include <gasha/fast_math.h>//高速算術【宣言部】
 
+#include <cmath>//std::sin(), std::cos(), std::exp(), std::log(), std::atan2(), std::pow()
+
 GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 
 //--------------------------------------------------------------------------------
@@ -83,7 +85,7 @@ GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 	template <typename T, std::size_t N> inline CLASS_NAME<T[N]>::CLASS_NAME(const normA<T[N]>& val){ for (std::size_t i = 0; i < N; ++i) m_val[i] = val.m_val[i]; } \
 	template <typename T, std::size_t N> inline CLASS_NAME<T[N]>::CLASS_NAME(const dummyA<T[N]>&& val){ for (std::size_t i = 0; i < N; ++i) m_val[i] = val.m_val[i]; } \
 	template <typename T, std::size_t N> inline CLASS_NAME<T[N]>::CLASS_NAME(const dummyA<T[N]>& val){ for (std::size_t i = 0; i < N; ++i) m_val[i] = val.m_val[i]; } \
-	template <typename T, std::size_t N> inline CLASS_NAME<T[N]>::CLASS_NAME(){ for (int i = 0; i < N; ++i) m_val[i] = static_cast<T>(0); } \
+	template <typename T, std::size_t N> inline CLASS_NAME<T[N]>::CLASS_NAME(){ for (std::size_t i = 0; i < N; ++i) m_val[i] = static_cast<T>(0); } \
 	template <typename T, std::size_t N> inline CLASS_NAME<T[N]>::~CLASS_NAME(){} \
 	template <typename T, std::size_t N, std::size_t M> inline CLASS_NAME<T[N][M]>& CLASS_NAME<T[N][M]>::operator=(const T(&&val)[N][M]){ for (std::size_t i = 0; i < N; ++i) for (std::size_t j = 0; j < M; ++j) m_val[i][j] = val[i][j]; return *this; } \
 	template <typename T, std::size_t N, std::size_t M> inline CLASS_NAME<T[N][M]>& CLASS_NAME<T[N][M]>::operator=(const T(&val)[N][M]){ for (std::size_t i = 0; i < N; ++i) for (std::size_t j = 0; j < M; ++j) m_val[i][j] = val[i][j]; return *this; } \
@@ -312,9 +314,21 @@ GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 	inline CLASS_NAME<__m256d>::CLASS_NAME() : m_val(_mm256_setzero_pd()){} \
 	inline CLASS_NAME<__m256d>::~CLASS_NAME(){} \
 
+#ifdef GASHA_FAST_ARITH_USE_SSE
+namespace _private
+{
+	//float[3] の配列を __m128 型に読み込み
+	//※配列の範囲外を読み込まないように、3要素（12バイト）のみ読み込む（4要素目は 0）
+	inline __m128 fastArithLoadFloat3(const float* p)
+	{
+		return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p)), _mm_load_ss(p + 2));
+	}
+}//namespace _private
+#endif//GASHA_FAST_ARITH_USE_SSE
+
 #define GASHA_FAST_ARITH_CLASS_SSE_FLOAT3_INSTANCING(CLASS_NAME) \
-	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const float (&&val)[3]){ m_val = _mm_loadu_ps(val); return *this; } \
-	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const float (&val)[3]){ m_val = _mm_loadu_ps(val); return *this; } \
+	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const float (&&val)[3]){ m_val = _private::fastArithLoadFloat3(val); return *this; } \
+	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const float (&val)[3]){ m_val = _private::fastArithLoadFloat3(val); return *this; } \
 	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const __m128&& val){ m_val = val; return *this; } \
 	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const __m128& val){ m_val = val; return *this; } \
 	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const fastA<float[3]>&& val){ m_val = val.m_val; return *this; } \
@@ -327,10 +341,10 @@ GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const sseA<float[3]>& val){ m_val = val.m_val; return *this; } \
 	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const normA<float[3]>&& val){ m_val = val.m_val; return *this; } \
 	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const normA<float[3]>& val){ m_val = val.m_val; return *this; } \
-	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const dummyA<float[3]>&& val){ m_val = _mm_loadu_ps(val.m_val); return *this; } \
-	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const dummyA<float[3]>& val){ m_val = _mm_loadu_ps(val.m_val); return *this; } \
-	inline CLASS_NAME<float[3]>::CLASS_NAME(const float (&&val)[3]) : m_val(_mm_loadu_ps(val)){} \
-	inline CLASS_NAME<float[3]>::CLASS_NAME(const float (&val)[3]) : m_val(_mm_loadu_ps(val)){} \
+	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const dummyA<float[3]>&& val){ m_val = _private::fastArithLoadFloat3(val.m_val); return *this; } \
+	inline CLASS_NAME<float[3]>& CLASS_NAME<float[3]>::operator=(const dummyA<float[3]>& val){ m_val = _private::fastArithLoadFloat3(val.m_val); return *this; } \
+	inline CLASS_NAME<float[3]>::CLASS_NAME(const float (&&val)[3]) : m_val(_private::fastArithLoadFloat3(val)){} \
+	inline CLASS_NAME<float[3]>::CLASS_NAME(const float (&val)[3]) : m_val(_private::fastArithLoadFloat3(val)){} \
 	inline CLASS_NAME<float[3]>::CLASS_NAME(const __m128&& val) : m_val(val){} \
 	inline CLASS_NAME<float[3]>::CLASS_NAME(const __m128& val) : m_val(val){} \
 	inline CLASS_NAME<float[3]>::CLASS_NAME(const fastA<float[3]>&& val) : m_val(val.m_val){} \
@@ -343,8 +357,8 @@ GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 	inline CLASS_NAME<float[3]>::CLASS_NAME(const sseA<float[3]>& val) : m_val(val.m_val){} \
 	inline CLASS_NAME<float[3]>::CLASS_NAME(const normA<float[3]>&& val) : m_val(val.m_val){} \
 	inline CLASS_NAME<float[3]>::CLASS_NAME(const normA<float[3]>& val) : m_val(val.m_val){} \
-	inline CLASS_NAME<float[3]>::CLASS_NAME(const dummyA<float[3]>&& val) : m_val(_mm_loadu_ps(val.m_val)){} \
-	inline CLASS_NAME<float[3]>::CLASS_NAME(const dummyA<float[3]>& val) : m_val(_mm_loadu_ps(val.m_val)){} \
+	inline CLASS_NAME<float[3]>::CLASS_NAME(const dummyA<float[3]>&& val) : m_val(_private::fastArithLoadFloat3(val.m_val)){} \
+	inline CLASS_NAME<float[3]>::CLASS_NAME(const dummyA<float[3]>& val) : m_val(_private::fastArithLoadFloat3(val.m_val)){} \
 	inline CLASS_NAME<float[3]>::CLASS_NAME() : m_val(_mm_setzero_ps()){} \
 	inline CLASS_NAME<float[3]>::~CLASS_NAME(){} \
 
@@ -1799,6 +1813,1279 @@ template<> inline void cross<float, 4>(float(&result)[4], const float(&vec1)[4],
 
 #endif//GASHA_USE_SSE4_1
 
+//--------------------------------------------------------------------------------
+//高速ベクトル演算：SoAバッチ処理
+//--------------------------------------------------------------------------------
+
+namespace _private
+{
+	//----------------------------------------
+	//SoAバッチ処理用：平方根／逆平方根
+
+	//平方根
+	template<int NEWTON_COUNT>
+	inline float fastBatchSqr<NEWTON_COUNT>::sqrt(const float value)
+	{
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		return _mm_cvtss_f32(sqrt(_mm_set_ss(value)));
+	#else//GASHA_FAST_ARITH_USE_SSE
+		return std::sqrt(value);
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	}
+	//逆平方根
+	template<int NEWTON_COUNT>
+	inline float fastBatchSqr<NEWTON_COUNT>::rsqrt(const float value)
+	{
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		return _mm_cvtss_f32(rsqrt(_mm_set_ss(value)));
+	#else//GASHA_FAST_ARITH_USE_SSE
+		return 1.f / std::sqrt(value);
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	}
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	//平方根
+	template<int NEWTON_COUNT>
+	inline __m128 fastBatchSqr<NEWTON_COUNT>::sqrt(const __m128 value_m128)
+	{
+		if (NEWTON_COUNT < 0)
+			return _mm_sqrt_ps(value_m128);
+		//逆平方根を乗算
+		//※0 の時は 0 * ∞ で非数になるので、マスクして 0 にする
+		const __m128 nonzero_m128 = _mm_cmpneq_ps(value_m128, _mm_setzero_ps());
+		return _mm_and_ps(_mm_mul_ps(value_m128, rsqrt(value_m128)), nonzero_m128);
+	}
+	//逆平方根
+	template<int NEWTON_COUNT>
+	inline __m128 fastBatchSqr<NEWTON_COUNT>::rsqrt(const __m128 value_m128)
+	{
+		if (NEWTON_COUNT < 0)
+			return _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(value_m128));
+		__m128 rcp_sqrt_m128 = _mm_rsqrt_ps(value_m128);//逆数の近似値算出
+		const __m128 const3_m128 = _mm_set1_ps(3.f);
+		const __m128 const0_5_m128 = _mm_set1_ps(0.5f);
+		for (int count = 0; count < NEWTON_COUNT; ++count)
+			rcp_sqrt_m128 = _mm_mul_ps(_mm_mul_ps(rcp_sqrt_m128, _mm_sub_ps(const3_m128, _mm_mul_ps(value_m128, _mm_mul_ps(rcp_sqrt_m128, rcp_sqrt_m128)))), const0_5_m128);//逆数の精度向上
+		return rcp_sqrt_m128;
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	//平方根
+	template<int NEWTON_COUNT>
+	GASHA_TARGET_AVX inline __m256 fastBatchSqr<NEWTON_COUNT>::sqrt(const __m256 value_m256)
+	{
+		if (NEWTON_COUNT < 0)
+			return _mm256_sqrt_ps(value_m256);
+		//逆平方根を乗算
+		//※0 の時は 0 * ∞ で非数になるので、マスクして 0 にする
+		const __m256 nonzero_m256 = _mm256_cmp_ps(value_m256, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+		return _mm256_and_ps(_mm256_mul_ps(value_m256, rsqrt(value_m256)), nonzero_m256);
+	}
+	//逆平方根
+	template<int NEWTON_COUNT>
+	GASHA_TARGET_AVX inline __m256 fastBatchSqr<NEWTON_COUNT>::rsqrt(const __m256 value_m256)
+	{
+		if (NEWTON_COUNT < 0)
+			return _mm256_div_ps(_mm256_set1_ps(1.f), _mm256_sqrt_ps(value_m256));
+		__m256 rcp_sqrt_m256 = _mm256_rsqrt_ps(value_m256);//逆数の近似値算出
+		const __m256 const3_m256 = _mm256_set1_ps(3.f);
+		const __m256 const0_5_m256 = _mm256_set1_ps(0.5f);
+		for (int count = 0; count < NEWTON_COUNT; ++count)
+			rcp_sqrt_m256 = _mm256_mul_ps(_mm256_mul_ps(rcp_sqrt_m256, _mm256_sub_ps(const3_m256, _mm256_mul_ps(value_m256, _mm256_mul_ps(rcp_sqrt_m256, rcp_sqrt_m256)))), const0_5_m256);//逆数の精度向上
+		return rcp_sqrt_m256;
+	}
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	//----------------------------------------
+	//SoAバッチ処理用：AVX命令を使用するか？
+	inline bool fastBatchIsAVX()
+	{
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		return true;
+	#else//GASHA_FAST_ARITH_USE_AVX
+		return GASHA_ cpuFeatures::instance().hasAVX();//実行時に判定（CPU機能の判定は初回のみ）
+	#endif//GASHA_FAST_ARITH_USE_AVX
+	}
+
+	//----------------------------------------
+	//SoAバッチ処理用：AVX命令版
+	//※先頭から8要素ずつ処理し、処理した要素数を返す（端数は呼び出し元で処理する）
+	//※実行時に振り分ける場合、AVX命令に対応したCPUでのみ呼び出すこと
+
+	//ノルム
+	template<template<typename> class ARITH>
+	GASHA_TARGET_AVX inline std::size_t normBatch_avx(const float* x, const float* y, const float* z, float* out, const std::size_t n)
+	{
+		typedef fastBatchOpe<ARITH> ope;
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256 x_m256 = _mm256_loadu_ps(x + i);
+			const __m256 y_m256 = _mm256_loadu_ps(y + i);
+			const __m256 z_m256 = _mm256_loadu_ps(z + i);
+			const __m256 sq_m256 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x_m256, x_m256), _mm256_mul_ps(y_m256, y_m256)), _mm256_mul_ps(z_m256, z_m256));
+			_mm256_storeu_ps(out + i, ope::sqrt(sq_m256));
+		}
+		return i;
+	}
+
+	//ノルムの二乗
+	GASHA_TARGET_AVX inline std::size_t normSqBatch_avx(const float* x, const float* y, const float* z, float* out, const std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256 x_m256 = _mm256_loadu_ps(x + i);
+			const __m256 y_m256 = _mm256_loadu_ps(y + i);
+			const __m256 z_m256 = _mm256_loadu_ps(z + i);
+			_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x_m256, x_m256), _mm256_mul_ps(y_m256, y_m256)), _mm256_mul_ps(z_m256, z_m256)));
+		}
+		return i;
+	}
+
+	//二点間の長さ
+	template<template<typename> class ARITH>
+	GASHA_TARGET_AVX inline std::size_t lengthBatch_avx(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, const std::size_t n)
+	{
+		typedef fastBatchOpe<ARITH> ope;
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256 x_m256 = _mm256_sub_ps(_mm256_loadu_ps(ax + i), _mm256_loadu_ps(bx + i));
+			const __m256 y_m256 = _mm256_sub_ps(_mm256_loadu_ps(ay + i), _mm256_loadu_ps(by + i));
+			const __m256 z_m256 = _mm256_sub_ps(_mm256_loadu_ps(az + i), _mm256_loadu_ps(bz + i));
+			const __m256 sq_m256 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x_m256, x_m256), _mm256_mul_ps(y_m256, y_m256)), _mm256_mul_ps(z_m256, z_m256));
+			_mm256_storeu_ps(out + i, ope::sqrt(sq_m256));
+		}
+		return i;
+	}
+
+	//正規化
+	template<template<typename> class ARITH>
+	GASHA_TARGET_AVX inline std::size_t normalizeBatch_avx(const float* x, const float* y, const float* z, float* out_x, float* out_y, float* out_z, const std::size_t n)
+	{
+		typedef fastBatchOpe<ARITH> ope;
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256 x_m256 = _mm256_loadu_ps(x + i);
+			const __m256 y_m256 = _mm256_loadu_ps(y + i);
+			const __m256 z_m256 = _mm256_loadu_ps(z + i);
+			const __m256 sq_m256 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x_m256, x_m256), _mm256_mul_ps(y_m256, y_m256)), _mm256_mul_ps(z_m256, z_m256));
+			const __m256 rcp_norm_m256 = ope::rsqrt(sq_m256);
+			_mm256_storeu_ps(out_x + i, _mm256_mul_ps(x_m256, rcp_norm_m256));
+			_mm256_storeu_ps(out_y + i, _mm256_mul_ps(y_m256, rcp_norm_m256));
+			_mm256_storeu_ps(out_z + i, _mm256_mul_ps(z_m256, rcp_norm_m256));
+		}
+		return i;
+	}
+
+	//スカラー長の進行
+	template<template<typename> class ARITH>
+	GASHA_TARGET_AVX inline std::size_t forwardBatch_avx(const float* x, const float* y, const float* z, const float scalar, float* out_x, float* out_y, float* out_z, const std::size_t n)
+	{
+		typedef fastBatchOpe<ARITH> ope;
+		std::size_t i = 0;
+		const __m256 scalar_m256 = _mm256_set1_ps(scalar);
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256 x_m256 = _mm256_loadu_ps(x + i);
+			const __m256 y_m256 = _mm256_loadu_ps(y + i);
+			const __m256 z_m256 = _mm256_loadu_ps(z + i);
+			const __m256 sq_m256 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x_m256, x_m256), _mm256_mul_ps(y_m256, y_m256)), _mm256_mul_ps(z_m256, z_m256));
+			const __m256 scale_m256 = _mm256_mul_ps(ope::rsqrt(sq_m256), scalar_m256);//正規化とスカラー倍をまとめる
+			_mm256_storeu_ps(out_x + i, _mm256_add_ps(x_m256, _mm256_mul_ps(x_m256, scale_m256)));
+			_mm256_storeu_ps(out_y + i, _mm256_add_ps(y_m256, _mm256_mul_ps(y_m256, scale_m256)));
+			_mm256_storeu_ps(out_z + i, _mm256_add_ps(z_m256, _mm256_mul_ps(z_m256, scale_m256)));
+		}
+		return i;
+	}
+
+	//内積
+	GASHA_TARGET_AVX inline std::size_t dotBatch_avx(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, const std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256 x_m256 = _mm256_mul_ps(_mm256_loadu_ps(ax + i), _mm256_loadu_ps(bx + i));
+			const __m256 y_m256 = _mm256_mul_ps(_mm256_loadu_ps(ay + i), _mm256_loadu_ps(by + i));
+			const __m256 z_m256 = _mm256_mul_ps(_mm256_loadu_ps(az + i), _mm256_loadu_ps(bz + i));
+			_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_add_ps(x_m256, y_m256), z_m256));
+		}
+		return i;
+	}
+
+	//外積
+	GASHA_TARGET_AVX inline std::size_t crossBatch_avx(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out_x, float* out_y, float* out_z, const std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m256 ax_m256 = _mm256_loadu_ps(ax + i);
+			const __m256 ay_m256 = _mm256_loadu_ps(ay + i);
+			const __m256 az_m256 = _mm256_loadu_ps(az + i);
+			const __m256 bx_m256 = _mm256_loadu_ps(bx + i);
+			const __m256 by_m256 = _mm256_loadu_ps(by + i);
+			const __m256 bz_m256 = _mm256_loadu_ps(bz + i);
+			const __m256 x_m256 = _mm256_sub_ps(_mm256_mul_ps(ay_m256, bz_m256), _mm256_mul_ps(az_m256, by_m256));
+			const __m256 y_m256 = _mm256_sub_ps(_mm256_mul_ps(az_m256, bx_m256), _mm256_mul_ps(ax_m256, bz_m256));
+			const __m256 z_m256 = _mm256_sub_ps(_mm256_mul_ps(ax_m256, by_m256), _mm256_mul_ps(ay_m256, bx_m256));
+			_mm256_storeu_ps(out_x + i, x_m256);
+			_mm256_storeu_ps(out_y + i, y_m256);
+			_mm256_storeu_ps(out_z + i, z_m256);
+		}
+		return i;
+	}
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+}//namespace _private
+
+//----------------------------------------
+//ノルム
+template<template<typename> class ARITH>
+inline void normBatch(const float* x, const float* y, const float* z, float* out, const std::size_t n)
+{
+	typedef _private::fastBatchOpe<ARITH> ope;
+	std::size_t i = 0;
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	if (_private::fastBatchIsAVX())
+		i = _private::normBatch_avx<ARITH>(x, y, z, out, n);
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128 x_m128 = _mm_loadu_ps(x + i);
+		const __m128 y_m128 = _mm_loadu_ps(y + i);
+		const __m128 z_m128 = _mm_loadu_ps(z + i);
+		const __m128 sq_m128 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x_m128, x_m128), _mm_mul_ps(y_m128, y_m128)), _mm_mul_ps(z_m128, z_m128));
+		_mm_storeu_ps(out + i, ope::sqrt(sq_m128));
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+	//端数
+	for (; i < n; ++i)
+		out[i] = ope::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+}
+
+//----------------------------------------
+//ノルムの二乗
+template<template<typename> class ARITH>
+inline void normSqBatch(const float* x, const float* y, const float* z, float* out, const std::size_t n)
+{
+	std::size_t i = 0;
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	if (_private::fastBatchIsAVX())
+		i = _private::normSqBatch_avx(x, y, z, out, n);
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128 x_m128 = _mm_loadu_ps(x + i);
+		const __m128 y_m128 = _mm_loadu_ps(y + i);
+		const __m128 z_m128 = _mm_loadu_ps(z + i);
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x_m128, x_m128), _mm_mul_ps(y_m128, y_m128)), _mm_mul_ps(z_m128, z_m128)));
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+	//端数
+	for (; i < n; ++i)
+		out[i] = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+}
+
+//----------------------------------------
+//二点間の長さ
+template<template<typename> class ARITH>
+inline void lengthBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, const std::size_t n)
+{
+	typedef _private::fastBatchOpe<ARITH> ope;
+	std::size_t i = 0;
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	if (_private::fastBatchIsAVX())
+		i = _private::lengthBatch_avx<ARITH>(ax, ay, az, bx, by, bz, out, n);
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128 x_m128 = _mm_sub_ps(_mm_loadu_ps(ax + i), _mm_loadu_ps(bx + i));
+		const __m128 y_m128 = _mm_sub_ps(_mm_loadu_ps(ay + i), _mm_loadu_ps(by + i));
+		const __m128 z_m128 = _mm_sub_ps(_mm_loadu_ps(az + i), _mm_loadu_ps(bz + i));
+		const __m128 sq_m128 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x_m128, x_m128), _mm_mul_ps(y_m128, y_m128)), _mm_mul_ps(z_m128, z_m128));
+		_mm_storeu_ps(out + i, ope::sqrt(sq_m128));
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+	//端数
+	for (; i < n; ++i)
+	{
+		const float x_diff = ax[i] - bx[i];
+		const float y_diff = ay[i] - by[i];
+		const float z_diff = az[i] - bz[i];
+		out[i] = ope::sqrt(x_diff * x_diff + y_diff * y_diff + z_diff * z_diff);
+	}
+}
+
+//----------------------------------------
+//正規化
+template<template<typename> class ARITH>
+inline void normalizeBatch(const float* x, const float* y, const float* z, float* out_x, float* out_y, float* out_z, const std::size_t n)
+{
+	typedef _private::fastBatchOpe<ARITH> ope;
+	std::size_t i = 0;
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	if (_private::fastBatchIsAVX())
+		i = _private::normalizeBatch_avx<ARITH>(x, y, z, out_x, out_y, out_z, n);
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128 x_m128 = _mm_loadu_ps(x + i);
+		const __m128 y_m128 = _mm_loadu_ps(y + i);
+		const __m128 z_m128 = _mm_loadu_ps(z + i);
+		const __m128 sq_m128 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x_m128, x_m128), _mm_mul_ps(y_m128, y_m128)), _mm_mul_ps(z_m128, z_m128));
+		const __m128 rcp_norm_m128 = ope::rsqrt(sq_m128);
+		_mm_storeu_ps(out_x + i, _mm_mul_ps(x_m128, rcp_norm_m128));
+		_mm_storeu_ps(out_y + i, _mm_mul_ps(y_m128, rcp_norm_m128));
+		_mm_storeu_ps(out_z + i, _mm_mul_ps(z_m128, rcp_norm_m128));
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+	//端数
+	for (; i < n; ++i)
+	{
+		const float vec_x = x[i];
+		const float vec_y = y[i];
+		const float vec_z = z[i];
+		const float rcp_norm = ope::rsqrt(vec_x * vec_x + vec_y * vec_y + vec_z * vec_z);
+		out_x[i] = vec_x * rcp_norm;
+		out_y[i] = vec_y * rcp_norm;
+		out_z[i] = vec_z * rcp_norm;
+	}
+}
+
+//----------------------------------------
+//スカラー長の進行
+template<template<typename> class ARITH>
+inline void forwardBatch(const float* x, const float* y, const float* z, const float scalar, float* out_x, float* out_y, float* out_z, const std::size_t n)
+{
+	typedef _private::fastBatchOpe<ARITH> ope;
+	std::size_t i = 0;
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	if (_private::fastBatchIsAVX())
+		i = _private::forwardBatch_avx<ARITH>(x, y, z, scalar, out_x, out_y, out_z, n);
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	const __m128 scalar_m128 = _mm_set1_ps(scalar);
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128 x_m128 = _mm_loadu_ps(x + i);
+		const __m128 y_m128 = _mm_loadu_ps(y + i);
+		const __m128 z_m128 = _mm_loadu_ps(z + i);
+		const __m128 sq_m128 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x_m128, x_m128), _mm_mul_ps(y_m128, y_m128)), _mm_mul_ps(z_m128, z_m128));
+		const __m128 scale_m128 = _mm_mul_ps(ope::rsqrt(sq_m128), scalar_m128);//正規化とスカラー倍をまとめる
+		_mm_storeu_ps(out_x + i, _mm_add_ps(x_m128, _mm_mul_ps(x_m128, scale_m128)));
+		_mm_storeu_ps(out_y + i, _mm_add_ps(y_m128, _mm_mul_ps(y_m128, scale_m128)));
+		_mm_storeu_ps(out_z + i, _mm_add_ps(z_m128, _mm_mul_ps(z_m128, scale_m128)));
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+	//端数
+	for (; i < n; ++i)
+	{
+		const float vec_x = x[i];
+		const float vec_y = y[i];
+		const float vec_z = z[i];
+		const float scale = ope::rsqrt(vec_x * vec_x + vec_y * vec_y + vec_z * vec_z) * scalar;
+		out_x[i] = vec_x + vec_x * scale;
+		out_y[i] = vec_y + vec_y * scale;
+		out_z[i] = vec_z + vec_z * scale;
+	}
+}
+
+//----------------------------------------
+//内積
+template<template<typename> class ARITH>
+inline void dotBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, const std::size_t n)
+{
+	std::size_t i = 0;
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	if (_private::fastBatchIsAVX())
+		i = _private::dotBatch_avx(ax, ay, az, bx, by, bz, out, n);
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128 x_m128 = _mm_mul_ps(_mm_loadu_ps(ax + i), _mm_loadu_ps(bx + i));
+		const __m128 y_m128 = _mm_mul_ps(_mm_loadu_ps(ay + i), _mm_loadu_ps(by + i));
+		const __m128 z_m128 = _mm_mul_ps(_mm_loadu_ps(az + i), _mm_loadu_ps(bz + i));
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(x_m128, y_m128), z_m128));
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+	//端数
+	for (; i < n; ++i)
+		out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+}
+
+//----------------------------------------
+//外積
+//※入力と同じ配列への上書きに対応するため、3成分とも算出してからストアする
+template<template<typename> class ARITH>
+inline void crossBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out_x, float* out_y, float* out_z, const std::size_t n)
+{
+	std::size_t i = 0;
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	if (_private::fastBatchIsAVX())
+		i = _private::crossBatch_avx(ax, ay, az, bx, by, bz, out_x, out_y, out_z, n);
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128 ax_m128 = _mm_loadu_ps(ax + i);
+		const __m128 ay_m128 = _mm_loadu_ps(ay + i);
+		const __m128 az_m128 = _mm_loadu_ps(az + i);
+		const __m128 bx_m128 = _mm_loadu_ps(bx + i);
+		const __m128 by_m128 = _mm_loadu_ps(by + i);
+		const __m128 bz_m128 = _mm_loadu_ps(bz + i);
+		const __m128 x_m128 = _mm_sub_ps(_mm_mul_ps(ay_m128, bz_m128), _mm_mul_ps(az_m128, by_m128));
+		const __m128 y_m128 = _mm_sub_ps(_mm_mul_ps(az_m128, bx_m128), _mm_mul_ps(ax_m128, bz_m128));
+		const __m128 z_m128 = _mm_sub_ps(_mm_mul_ps(ax_m128, by_m128), _mm_mul_ps(ay_m128, bx_m128));
+		_mm_storeu_ps(out_x + i, x_m128);
+		_mm_storeu_ps(out_y + i, y_m128);
+		_mm_storeu_ps(out_z + i, z_m128);
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+	//端数
+	for (; i < n; ++i)
+	{
+		const float vec1_x = ax[i], vec1_y = ay[i], vec1_z = az[i];
+		const float vec2_x = bx[i], vec2_y = by[i], vec2_z = bz[i];
+		out_x[i] = vec1_y * vec2_z - vec1_z * vec2_y;
+		out_y[i] = vec1_z * vec2_x - vec1_x * vec2_z;
+		out_z[i] = vec1_x * vec2_y - vec1_y * vec2_x;
+	}
+}
+
+//--------------------------------------------------------------------------------
+//高速超越関数
+//--------------------------------------------------------------------------------
+
+namespace _private
+{
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+	//----------------------------------------
+	//超越関数用：ベクトル演算
+	//※__m128 と __m256 の演算を共通化し、同じアルゴリズムで処理するための特性クラス
+	template<typename V>
+	struct fastTransVec;
+	//__m128用
+	template<>
+	struct fastTransVec<__m128>
+	{
+		typedef __m128 vec_type;//ベクトル型
+		typedef __m128i ivec_type;//整数ベクトル型
+		typedef __m128d dvec_type;//倍精度ベクトル型
+		inline static vec_type set(const float value){ return _mm_set1_ps(value); }
+		inline static vec_type setBits(const std::uint32_t bits){ return _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(bits))); }
+		inline static vec_type add(const vec_type a, const vec_type b){ return _mm_add_ps(a, b); }
+		inline static vec_type sub(const vec_type a, const vec_type b){ return _mm_sub_ps(a, b); }
+		inline static vec_type mul(const vec_type a, const vec_type b){ return _mm_mul_ps(a, b); }
+		inline static vec_type div(const vec_type a, const vec_type b){ return _mm_div_ps(a, b); }
+		//a * b + c
+		inline static vec_type madd(const vec_type a, const vec_type b, const vec_type c)
+		{
+		#ifdef GASHA_USE_FMA3
+			return _mm_fmadd_ps(a, b, c);
+		#else//GASHA_USE_FMA3
+			return _mm_add_ps(_mm_mul_ps(a, b), c);
+		#endif//GASHA_USE_FMA3
+		}
+		//c - a * b
+		inline static vec_type nmadd(const vec_type a, const vec_type b, const vec_type c)
+		{
+		#ifdef GASHA_USE_FMA3
+			return _mm_fnmadd_ps(a, b, c);
+		#else//GASHA_USE_FMA3
+			return _mm_sub_ps(c, _mm_mul_ps(a, b));
+		#endif//GASHA_USE_FMA3
+		}
+		inline static vec_type and_(const vec_type a, const vec_type b){ return _mm_and_ps(a, b); }
+		inline static vec_type andnot(const vec_type a, const vec_type b){ return _mm_andnot_ps(a, b); }//~a & b
+		inline static vec_type or_(const vec_type a, const vec_type b){ return _mm_or_ps(a, b); }
+		inline static vec_type xor_(const vec_type a, const vec_type b){ return _mm_xor_ps(a, b); }
+		inline static vec_type min(const vec_type a, const vec_type b){ return _mm_min_ps(a, b); }
+		inline static vec_type max(const vec_type a, const vec_type b){ return _mm_max_ps(a, b); }
+		inline static vec_type cmpLT(const vec_type a, const vec_type b){ return _mm_cmplt_ps(a, b); }
+		inline static vec_type cmpLE(const vec_type a, const vec_type b){ return _mm_cmple_ps(a, b); }
+		inline static vec_type cmpGT(const vec_type a, const vec_type b){ return _mm_cmpgt_ps(a, b); }
+		inline static vec_type cmpGE(const vec_type a, const vec_type b){ return _mm_cmpge_ps(a, b); }
+		inline static vec_type cmpEQ(const vec_type a, const vec_type b){ return _mm_cmpeq_ps(a, b); }
+		inline static vec_type cmpNEQ(const vec_type a, const vec_type b){ return _mm_cmpneq_ps(a, b); }
+		inline static vec_type cmpUnord(const vec_type a, const vec_type b){ return _mm_cmpunord_ps(a, b); }
+		//mask ? a : b
+		inline static vec_type select(const vec_type mask, const vec_type a, const vec_type b)
+		{
+		#ifdef GASHA_FAST_ARITH_USE_SSE4_1
+			return _mm_blendv_ps(b, a, mask);
+		#else//GASHA_FAST_ARITH_USE_SSE4_1
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		#endif//GASHA_FAST_ARITH_USE_SSE4_1
+		}
+		inline static vec_type rcp(const vec_type a){ return _mm_rcp_ps(a); }
+		inline static vec_type abs(const vec_type a){ return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+		//整数変換（最近接丸め）
+		inline static ivec_type toInt(const vec_type a){ return _mm_cvtps_epi32(a); }
+		inline static vec_type toFloat(const ivec_type a){ return _mm_cvtepi32_ps(a); }
+		//整数のビット判定（指定のビットがすべて立っているか？）
+		inline static vec_type testBits(const ivec_type a, const std::uint32_t bits)
+		{
+			const __m128i bits_m128i = _mm_set1_epi32(static_cast<int>(bits));
+			return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, bits_m128i), bits_m128i));
+		}
+		//2^n（n は -126～127 の整数値）
+		inline static vec_type pow2(const vec_type n)
+		{
+			return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23));
+		}
+		//指数部（バイアス付き）
+		inline static vec_type exponent(const vec_type a)
+		{
+			return _mm_cvtepi32_ps(_mm_srli_epi32(_mm_castps_si128(a), 23));
+		}
+		//倍精度変換
+		inline static void toDouble(const vec_type a, dvec_type& lo, dvec_type& hi)
+		{
+			lo = _mm_cvtps_pd(a);
+			hi = _mm_cvtps_pd(_mm_movehl_ps(a, a));
+		}
+		inline static vec_type fromDouble(const dvec_type lo, const dvec_type hi)
+		{
+			return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+		}
+	};
+	//----------------------------------------
+	//超越関数用：倍精度ベクトル演算
+	template<typename D>
+	struct fastTransDVec;
+	//__m128d用
+	template<>
+	struct fastTransDVec<__m128d>
+	{
+		typedef __m128d dvec_type;//倍精度ベクトル型
+		inline static dvec_type set(const double value){ return _mm_set1_pd(value); }
+		inline static dvec_type add(const dvec_type a, const dvec_type b){ return _mm_add_pd(a, b); }
+		inline static dvec_type sub(const dvec_type a, const dvec_type b){ return _mm_sub_pd(a, b); }
+		inline static dvec_type mul(const dvec_type a, const dvec_type b){ return _mm_mul_pd(a, b); }
+		inline static dvec_type div(const dvec_type a, const dvec_type b){ return _mm_div_pd(a, b); }
+		//a * b + c
+		inline static dvec_type madd(const dvec_type a, const dvec_type b, const dvec_type c)
+		{
+		#ifdef GASHA_USE_FMA3
+			return _mm_fmadd_pd(a, b, c);
+		#else//GASHA_USE_FMA3
+			return _mm_add_pd(_mm_mul_pd(a, b), c);
+		#endif//GASHA_USE_FMA3
+		}
+		inline static dvec_type min(const dvec_type a, const dvec_type b){ return _mm_min_pd(a, b); }
+		inline static dvec_type max(const dvec_type a, const dvec_type b){ return _mm_max_pd(a, b); }
+		//最近接整数への丸め（|a| < 2^51）
+		inline static dvec_type round(const dvec_type a)
+		{
+			const __m128d magic_m128d = _mm_set1_pd(6755399441055744.);//2^52 + 2^51
+			return _mm_sub_pd(_mm_add_pd(a, magic_m128d), magic_m128d);
+		}
+	};
+#endif//GASHA_FAST_ARITH_USE_SSE2
+#ifdef GASHA_FAST_ARITH_USE_AVX
+	//__m256用
+	//※AVX命令には256ビットの整数演算がないため、整数演算は浮動小数点の演算で代用する
+	template<>
+	struct fastTransVec<__m256>
+	{
+		typedef __m256 vec_type;//ベクトル型
+		typedef __m256i ivec_type;//整数ベクトル型
+		typedef __m256d dvec_type;//倍精度ベクトル型
+		inline static vec_type set(const float value){ return _mm256_set1_ps(value); }
+		inline static vec_type setBits(const std::uint32_t bits){ return _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(bits))); }
+		inline static vec_type add(const vec_type a, const vec_type b){ return _mm256_add_ps(a, b); }
+		inline static vec_type sub(const vec_type a, const vec_type b){ return _mm256_sub_ps(a, b); }
+		inline static vec_type mul(const vec_type a, const vec_type b){ return _mm256_mul_ps(a, b); }
+		inline static vec_type div(const vec_type a, const vec_type b){ return _mm256_div_ps(a, b); }
+		//a * b + c
+		inline static vec_type madd(const vec_type a, const vec_type b, const vec_type c)
+		{
+		#ifdef GASHA_USE_FMA3
+			return _mm256_fmadd_ps(a, b, c);
+		#else//GASHA_USE_FMA3
+			return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+		#endif//GASHA_USE_FMA3
+		}
+		//c - a * b
+		inline static vec_type nmadd(const vec_type a, const vec_type b, const vec_type c)
+		{
+		#ifdef GASHA_USE_FMA3
+			return _mm256_fnmadd_ps(a, b, c);
+		#else//GASHA_USE_FMA3
+			return _mm256_sub_ps(c, _mm256_mul_ps(a, b));
+		#endif//GASHA_USE_FMA3
+		}
+		inline static vec_type and_(const vec_type a, const vec_type b){ return _mm256_and_ps(a, b); }
+		inline static vec_type andnot(const vec_type a, const vec_type b){ return _mm256_andnot_ps(a, b); }//~a & b
+		inline static vec_type or_(const vec_type a, const vec_type b){ return _mm256_or_ps(a, b); }
+		inline static vec_type xor_(const vec_type a, const vec_type b){ return _mm256_xor_ps(a, b); }
+		inline static vec_type min(const vec_type a, const vec_type b){ return _mm256_min_ps(a, b); }
+		inline static vec_type max(const vec_type a, const vec_type b){ return _mm256_max_ps(a, b); }
+		inline static vec_type cmpLT(const vec_type a, const vec_type b){ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		inline static vec_type cmpLE(const vec_type a, const vec_type b){ return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+		inline static vec_type cmpGT(const vec_type a, const vec_type b){ return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		inline static vec_type cmpGE(const vec_type a, const vec_type b){ return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+		inline static vec_type cmpEQ(const vec_type a, const vec_type b){ return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+		inline static vec_type cmpNEQ(const vec_type a, const vec_type b){ return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+		inline static vec_type cmpUnord(const vec_type a, const vec_type b){ return _mm256_cmp_ps(a, b, _CMP_UNORD_Q); }
+		//mask ? a : b
+		inline static vec_type select(const vec_type mask, const vec_type a, const vec_type b){ return _mm256_blendv_ps(b, a, mask); }
+		inline static vec_type rcp(const vec_type a){ return _mm256_rcp_ps(a); }
+		inline static vec_type abs(const vec_type a){ return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+		//整数変換（最近接丸め）
+		inline static ivec_type toInt(const vec_type a){ return _mm256_cvtps_epi32(a); }
+		inline static vec_type toFloat(const ivec_type a){ return _mm256_cvtepi32_ps(a); }
+		//整数のビット判定（指定のビットがすべて立っているか？）
+		inline static vec_type testBits(const ivec_type a, const std::uint32_t bits)
+		{
+			const __m256 bits_m256 = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(bits)));
+			const __m256 masked_m256 = _mm256_and_ps(_mm256_castsi256_ps(a), bits_m256);
+			return _mm256_cmp_ps(_mm256_cvtepi32_ps(_mm256_castps_si256(masked_m256)), _mm256_cvtepi32_ps(_mm256_castps_si256(bits_m256)), _CMP_EQ_OQ);
+		}
+		//2^n（n は -126～127 の整数値）
+		//※(n + 127) * 2^23 を整数化すると、2^n のビット表現になる
+		inline static vec_type pow2(const vec_type n)
+		{
+			return _mm256_castsi256_ps(_mm256_cvtps_epi32(_mm256_mul_ps(_mm256_add_ps(n, _mm256_set1_ps(127.f)), _mm256_set1_ps(8388608.f))));
+		}
+		//指数部（バイアス付き）
+		inline static vec_type exponent(const vec_type a)
+		{
+			const __m256 exp_m256 = _mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x7f800000)));
+			return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_castps_si256(exp_m256)), _mm256_set1_ps(1.f / 8388608.f));
+		}
+		//倍精度変換
+		inline static void toDouble(const vec_type a, dvec_type& lo, dvec_type& hi)
+		{
+			lo = _mm256_cvtps_pd(_mm256_castps256_ps128(a));
+			hi = _mm256_cvtps_pd(_mm256_extractf128_ps(a, 1));
+		}
+		inline static vec_type fromDouble(const dvec_type lo, const dvec_type hi)
+		{
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(lo)), _mm256_cvtpd_ps(hi), 1);
+		}
+	};
+	//__m256d用
+	template<>
+	struct fastTransDVec<__m256d>
+	{
+		typedef __m256d dvec_type;//倍精度ベクトル型
+		inline static dvec_type set(const double value){ return _mm256_set1_pd(value); }
+		inline static dvec_type add(const dvec_type a, const dvec_type b){ return _mm256_add_pd(a, b); }
+		inline static dvec_type sub(const dvec_type a, const dvec_type b){ return _mm256_sub_pd(a, b); }
+		inline static dvec_type mul(const dvec_type a, const dvec_type b){ return _mm256_mul_pd(a, b); }
+		inline static dvec_type div(const dvec_type a, const dvec_type b){ return _mm256_div_pd(a, b); }
+		//a * b + c
+		inline static dvec_type madd(const dvec_type a, const dvec_type b, const dvec_type c)
+		{
+		#ifdef GASHA_USE_FMA3
+			return _mm256_fmadd_pd(a, b, c);
+		#else//GASHA_USE_FMA3
+			return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+		#endif//GASHA_USE_FMA3
+		}
+		inline static dvec_type min(const dvec_type a, const dvec_type b){ return _mm256_min_pd(a, b); }
+		inline static dvec_type max(const dvec_type a, const dvec_type b){ return _mm256_max_pd(a, b); }
+		//最近接整数への丸め（|a| < 2^51）
+		inline static dvec_type round(const dvec_type a)
+		{
+			const __m256d magic_m256d = _mm256_set1_pd(6755399441055744.);//2^52 + 2^51
+			return _mm256_sub_pd(_mm256_add_pd(a, magic_m256d), magic_m256d);
+		}
+	};
+#endif//GASHA_FAST_ARITH_USE_AVX
+
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+	//----------------------------------------
+	//超越関数用：演算処理
+	//※PRECISION ... 精度（0 ... fastestA, 1 ... fastA, 2 ... その他）
+	//※PRECISION が 0, 1 の場合は単精度で計算し、多項式の係数はミニマックス近似を使用
+	//※PRECISION が 2 の場合は範囲縮小以降を倍精度で計算し、最後に１回だけ単精度に丸める（誤差 1ulp 以内）
+	template<typename V, int PRECISION>
+	struct fastTransCalc
+	{
+		typedef fastTransVec<V> ope;//ベクトル演算
+		typedef typename ope::vec_type vec_type;//ベクトル型
+		typedef typename ope::dvec_type dvec_type;//倍精度ベクトル型
+		typedef fastTransDVec<dvec_type> dope;//倍精度ベクトル演算
+
+		//定数
+		inline static vec_type k(const float value){ return ope::set(value); }
+		inline static vec_type signMask(){ return ope::set(-0.f); }
+		inline static vec_type inf(){ return ope::setBits(0x7f800000u); }
+
+		//除算
+		//※逆数の近似値を使用する場合、fastestA ではそのまま、fastA ではニュートン法を1回適用する
+		inline static vec_type divide(const vec_type n, const vec_type d)
+		{
+		#ifdef GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION
+			if (PRECISION == 0)
+				return ope::mul(n, ope::rcp(d));
+			if (PRECISION == 1)
+			{
+				vec_type rcp = ope::rcp(d);//逆数の近似値算出
+				rcp = ope::mul(rcp, ope::nmadd(d, rcp, k(2.f)));//逆数の精度向上
+				return ope::mul(n, rcp);
+			}
+		#endif//GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION
+			return ope::div(n, d);
+		}
+
+		//正弦／余弦の範囲縮小
+		//※x = q * π/2 + r となる q（整数値）と r（|r| ≦ π/4）を求める
+		//※π/2 を3つに分割して減算することで、誤差を抑える（Cody-Waite法）
+		//※範囲外の巨大な値でも結果が ±1 を超えないように r を制限し、∞ と非数は非数にする
+		inline static vec_type reduceSinCos(const vec_type x, vec_type& q)
+		{
+			q = ope::toFloat(ope::toInt(ope::mul(x, k(0.636619772367581343f))));//2/π
+			vec_type r = ope::nmadd(q, k(1.5703125f), x);
+			r = ope::nmadd(q, k(4.837512969970703125e-4f), r);
+			r = ope::nmadd(q, k(7.54978995489188216e-8f), r);
+			r = ope::min(ope::max(r, k(-1.f)), k(1.f));
+			return ope::or_(r, ope::cmpUnord(ope::sub(x, x), x));//x - x は ∞ と非数の時だけ非数
+		}
+		//正弦の多項式近似（|r| ≦ π/4）
+		inline static vec_type polySin(const vec_type r, const vec_type z)
+		{
+			vec_type p;
+			if (PRECISION == 0)
+				p = k(-1.6242791462e-1f);
+			else
+				p = ope::madd(z, k(8.1632818895e-3f), k(-1.6663390376e-1f));
+			return ope::madd(ope::mul(r, z), p, r);//r + r^3 * P(r^2)
+		}
+		//余弦の多項式近似（|r| ≦ π/4）
+		inline static vec_type polyCos(const vec_type z)
+		{
+			vec_type p;
+			if (PRECISION == 0)
+				p = k(4.0899305285e-2f);
+			else
+				p = ope::madd(z, k(-1.3648714318e-3f), k(4.1661071304e-2f));
+			return ope::madd(ope::mul(z, z), p, ope::nmadd(z, k(0.5f), k(1.f)));//1 - r^2/2 + r^4 * P(r^2)
+		}
+		//象限に応じて正弦／余弦を選択
+		//※q & 1 なら正弦と余弦を入れ替え、q & 2 なら符号を反転する
+		inline static vec_type selectQuadrant(const vec_type q, const vec_type sin_val, const vec_type cos_val)
+		{
+			const typename ope::ivec_type q_i = ope::toInt(q);
+			const vec_type swap = ope::testBits(q_i, 1);
+			const vec_type neg = ope::testBits(q_i, 2);
+			return ope::xor_(ope::select(swap, cos_val, sin_val), ope::and_(neg, signMask()));
+		}
+
+		//正弦と余弦の多項式近似（倍精度）
+		//※π/2 を2つに分割して減算する（Cody-Waite法、|q| < 2^20 なら q * π/2（上位）は誤差なし）
+		//※多項式の係数は fdlibm のもの
+		inline static void sinCosD(const vec_type x, vec_type& q, vec_type& sin_val, vec_type& cos_val)
+		{
+			dvec_type x_d[2], q_d[2], s_d[2], c_d[2];
+			ope::toDouble(x, x_d[0], x_d[1]);
+			for (int i = 0; i < 2; ++i)
+			{
+				const dvec_type qx = dope::mul(x_d[i], dope::set(6.36619772367581382433e-01));//2/π
+				q_d[i] = dope::round(dope::min(dope::max(qx, dope::set(-1.e15)), dope::set(1.e15)));
+				dvec_type r = dope::madd(q_d[i], dope::set(-1.57079632673412561417e+00), x_d[i]);
+				r = dope::madd(q_d[i], dope::set(-6.07710050650619224932e-11), r);
+				r = dope::min(dope::max(r, dope::set(-1.)), dope::set(1.));
+				const dvec_type z = dope::mul(r, r);
+				dvec_type ps = dope::set(1.58969099521155010221e-10);
+				ps = dope::madd(ps, z, dope::set(-2.50507602534068634195e-08));
+				ps = dope::madd(ps, z, dope::set(2.75573137070700676789e-06));
+				ps = dope::madd(ps, z, dope::set(-1.98412698298579493134e-04));
+				ps = dope::madd(ps, z, dope::set(8.33333333332248946124e-03));
+				ps = dope::madd(ps, z, dope::set(-1.66666666666666324348e-01));
+				s_d[i] = dope::mul(r, dope::madd(z, ps, dope::set(1.)));//r * (1 + r^2 * P(r^2)) ※-0 の符号を保つ
+				dvec_type pc = dope::set(-1.13596475577881948265e-11);
+				pc = dope::madd(pc, z, dope::set(2.08757232129817482790e-09));
+				pc = dope::madd(pc, z, dope::set(-2.75573143513906633035e-07));
+				pc = dope::madd(pc, z, dope::set(2.48015872894767294178e-05));
+				pc = dope::madd(pc, z, dope::set(-1.38888888888741095749e-03));
+				pc = dope::madd(pc, z, dope::set(4.16666666666666019037e-02));
+				c_d[i] = dope::madd(dope::mul(z, z), pc, dope::madd(z, dope::set(-0.5), dope::set(1.)));//1 - r^2/2 + r^4 * P(r^2)
+			}
+			q = ope::fromDouble(q_d[0], q_d[1]);
+			sin_val = ope::fromDouble(s_d[0], s_d[1]);
+			cos_val = ope::fromDouble(c_d[0], c_d[1]);
+		}
+		//∞ と非数を非数にする
+		inline static vec_type nanIfNotFinite(const vec_type x, const vec_type result)
+		{
+			return ope::or_(result, ope::cmpUnord(ope::sub(x, x), x));//x - x は ∞ と非数の時だけ非数
+		}
+
+		//正弦
+		inline static vec_type sin(const vec_type x)
+		{
+			if (PRECISION >= 2)
+			{
+				vec_type q, sin_val, cos_val;
+				sinCosD(x, q, sin_val, cos_val);
+				return nanIfNotFinite(x, selectQuadrant(q, sin_val, cos_val));
+			}
+			vec_type q;
+			const vec_type r = reduceSinCos(x, q);
+			const vec_type z = ope::mul(r, r);
+			return selectQuadrant(q, polySin(r, z), polyCos(z));
+		}
+		//余弦
+		//※cos(x) = sin(x + π/2) として、象限をずらす
+		inline static vec_type cos(const vec_type x)
+		{
+			if (PRECISION >= 2)
+			{
+				vec_type q, sin_val, cos_val;
+				sinCosD(x, q, sin_val, cos_val);
+				return nanIfNotFinite(x, selectQuadrant(ope::add(q, k(1.f)), sin_val, cos_val));
+			}
+			vec_type q;
+			const vec_type r = reduceSinCos(x, q);
+			const vec_type z = ope::mul(r, r);
+			return selectQuadrant(ope::add(q, k(1.f)), polySin(r, z), polyCos(z));
+		}
+		//正弦と余弦
+		inline static void sinCos(const vec_type x, vec_type& sin_result, vec_type& cos_result)
+		{
+			vec_type q, sin_val, cos_val;
+			if (PRECISION >= 2)
+				sinCosD(x, q, sin_val, cos_val);
+			else
+			{
+				const vec_type r = reduceSinCos(x, q);
+				const vec_type z = ope::mul(r, r);
+				sin_val = polySin(r, z);
+				cos_val = polyCos(z);
+			}
+			sin_result = selectQuadrant(q, sin_val, cos_val);
+			cos_result = selectQuadrant(ope::add(q, k(1.f)), sin_val, cos_val);
+			if (PRECISION >= 2)
+			{
+				sin_result = nanIfNotFinite(x, sin_result);
+				cos_result = nanIfNotFinite(x, cos_result);
+			}
+		}
+
+		//倍精度の指数／対数の共通処理
+		//|x| を 2^e * m（√0.5 ≦ m < √2）に分解
+		inline static void splitExponent(const vec_type ax, vec_type& e, vec_type& m)
+		{
+			const vec_type small = ope::cmpLT(ax, k(1.17549435e-38f));//非正規化数は 2^23 倍して正規化
+			const vec_type xs = ope::select(small, ope::mul(ax, k(8388608.f)), ax);
+			e = ope::sub(ope::sub(ope::exponent(xs), k(127.f)), ope::and_(small, k(23.f)));
+			m = ope::or_(ope::and_(xs, ope::setBits(0x007fffffu)), k(1.f));//1 ≦ m < 2
+			const vec_type gt = ope::cmpGT(m, k(1.41421356237309505f));
+			e = ope::add(e, ope::and_(gt, k(1.f)));
+			m = ope::select(gt, ope::mul(m, k(0.5f)), m);
+		}
+		//e * log(2) + log(m)（倍精度）
+		//※log(m) = 2s + 2s^3/3 + 2s^5/5 + ...（s = (m - 1) / (m + 1)）
+		inline static dvec_type logD(const dvec_type e, const dvec_type m)
+		{
+			const dvec_type f = dope::sub(m, dope::set(1.));
+			const dvec_type s = dope::div(f, dope::add(f, dope::set(2.)));
+			const dvec_type s2 = dope::mul(s, s);
+			dvec_type l = dope::set(1. / 13.);
+			l = dope::madd(l, s2, dope::set(1. / 11.));
+			l = dope::madd(l, s2, dope::set(1. / 9.));
+			l = dope::madd(l, s2, dope::set(1. / 7.));
+			l = dope::madd(l, s2, dope::set(1. / 5.));
+			l = dope::madd(l, s2, dope::set(1. / 3.));
+			l = dope::madd(l, s2, dope::set(1.));
+			l = dope::mul(dope::add(s, s), l);
+			return dope::madd(e, dope::set(6.93147180559945309417e-1), l);
+		}
+		//e^t = 2^n * p（倍精度）
+		//※n は整数値、|t| ≦ 2^50 / log2(e) であること
+		inline static void expD(const dvec_type t, dvec_type& n, dvec_type& p)
+		{
+			n = dope::round(dope::mul(t, dope::set(1.44269504088896340736)));//log2(e)
+			dvec_type r = dope::madd(n, dope::set(-6.93147180369123816490e-1), t);
+			r = dope::madd(n, dope::set(-1.90821492927058770002e-10), r);
+			dvec_type q = dope::set(1. / 3628800.);
+			q = dope::madd(q, r, dope::set(1. / 362880.));
+			q = dope::madd(q, r, dope::set(1. / 40320.));
+			q = dope::madd(q, r, dope::set(1. / 5040.));
+			q = dope::madd(q, r, dope::set(1. / 720.));
+			q = dope::madd(q, r, dope::set(1. / 120.));
+			q = dope::madd(q, r, dope::set(1. / 24.));
+			q = dope::madd(q, r, dope::set(1. / 6.));
+			q = dope::madd(q, r, dope::set(1. / 2.));
+			q = dope::madd(q, r, dope::set(1.));
+			p = dope::madd(q, r, dope::set(1.));
+		}
+		//2^n * p を単精度に変換
+		//※p を単精度に丸めてから、2^n を乗算する（非正規化数を扱えるように2回に分けて乗算）
+		inline static vec_type scaleD(const dvec_type (&n_d)[2], const dvec_type (&p_d)[2])
+		{
+			const vec_type p = ope::fromDouble(p_d[0], p_d[1]);
+			const vec_type n = ope::fromDouble(n_d[0], n_d[1]);
+			const vec_type n1 = ope::toFloat(ope::toInt(ope::mul(n, k(0.5f))));
+			return ope::mul(ope::mul(p, ope::pow2(n1)), ope::pow2(ope::sub(n, n1)));
+		}
+
+		//指数
+		//※x = n * log(2) + r となる n（整数値）と r（|r| ≦ log(2)/2）を求め、e^x = 2^n * e^r で計算する
+		//※精度 2 の場合、倍精度で計算する
+		inline static vec_type exp(const vec_type x)
+		{
+			const vec_type xc = ope::min(ope::max(x, k(-87.5f)), k(89.f));//2^n が表現可能な範囲に制限
+			if (PRECISION >= 2)
+			{
+				dvec_type t_d[2], n_d[2], p_d[2];
+				ope::toDouble(xc, t_d[0], t_d[1]);
+				for (int i = 0; i < 2; ++i)
+					expD(t_d[i], n_d[i], p_d[i]);
+				vec_type result = scaleD(n_d, p_d);
+				result = ope::andnot(ope::cmpLT(x, k(-87.3365447505531f)), result);//非正規化数になる場合は 0
+				return ope::select(ope::cmpUnord(x, x), x, result);//非数はそのまま返す
+			}
+			const vec_type n = ope::toFloat(ope::toInt(ope::mul(xc, k(1.44269504088896341f))));//log2(e)
+			vec_type r = ope::nmadd(n, k(0.693359375f), xc);
+			r = ope::nmadd(n, k(-2.12194440e-4f), r);
+			vec_type p;
+			if (PRECISION == 0)
+				p = ope::madd(r, k(1.6662811081e-1f), k(5.0394102920e-1f));
+			else
+				p = ope::madd(ope::madd(ope::madd(r, k(8.3125249458e-3f), k(4.1890113276e-2f)), r, k(1.6667114465e-1f)), r, k(4.9999231790e-1f));
+			p = ope::madd(ope::mul(r, r), p, ope::add(r, k(1.f)));//1 + r + r^2 * P(r)
+			//2^n を乗算（2^128 も扱えるように2回に分けて乗算）
+			const vec_type m = ope::min(n, k(127.f));
+			vec_type result = ope::mul(ope::mul(p, ope::pow2(m)), ope::pow2(ope::sub(n, m)));
+			result = ope::andnot(ope::cmpLT(x, k(-87.3365447505531f)), result);//非正規化数になる場合は 0
+			return ope::select(ope::cmpUnord(x, x), x, result);//非数はそのまま返す
+		}
+
+		//自然対数
+		//※x = 2^e * m（√0.5 ≦ m < √2）として、log(x) = e * log(2) + log(m) で計算する
+		//※精度 2 の場合、倍精度で計算する
+		inline static vec_type log(const vec_type x)
+		{
+			vec_type result;
+			if (PRECISION >= 2)
+			{
+				vec_type e, m;
+				splitExponent(x, e, m);
+				dvec_type e_d[2], m_d[2], l_d[2];
+				ope::toDouble(e, e_d[0], e_d[1]);
+				ope::toDouble(m, m_d[0], m_d[1]);
+				for (int i = 0; i < 2; ++i)
+					l_d[i] = logD(e_d[i], m_d[i]);
+				result = ope::fromDouble(l_d[0], l_d[1]);
+			}
+			else
+			{
+				//非正規化数は 2^23 倍して正規化
+				const vec_type small = ope::cmpLT(x, k(1.17549435e-38f));
+				const vec_type xs = ope::select(small, ope::mul(x, k(8388608.f)), x);
+				vec_type e = ope::sub(ope::sub(ope::exponent(xs), k(126.f)), ope::and_(small, k(23.f)));
+				vec_type m = ope::or_(ope::and_(xs, ope::setBits(0x007fffffu)), k(0.5f));//0.5 ≦ m < 1
+				const vec_type lt = ope::cmpLT(m, k(0.707106781186547524f));
+				e = ope::sub(e, ope::and_(lt, k(1.f)));
+				m = ope::sub(ope::add(m, ope::and_(lt, m)), k(1.f));
+				const vec_type z = ope::mul(m, m);
+				vec_type p;
+				if (PRECISION == 0)
+					p = ope::madd(ope::madd(m, k(1.7324999587e-1f), k(-2.6461247203e-1f)), m, k(3.3567332661e-1f));
+				else
+				{
+					p = ope::madd(m, k(-1.0191729093e-1f), k(1.6024380624e-1f));
+					p = ope::madd(p, m, k(-1.7137127229e-1f));
+					p = ope::madd(p, m, k(1.9924503492e-1f));
+					p = ope::madd(p, m, k(-2.4983266946e-1f));
+					p = ope::madd(p, m, k(3.3334245712e-1f));
+				}
+				vec_type y = ope::mul(ope::mul(m, z), p);//m^3 * P(m)
+				y = ope::madd(e, k(-2.12194440e-4f), y);
+				y = ope::nmadd(z, k(0.5f), y);
+				result = ope::madd(e, k(0.693359375f), ope::add(m, y));
+			}
+			//特殊な値
+			result = ope::or_(result, ope::or_(ope::cmpLT(x, k(0.f)), ope::cmpUnord(x, x)));//負数と非数は非数
+			result = ope::select(ope::cmpEQ(x, k(0.f)), ope::xor_(inf(), signMask()), result);//0 は -∞
+			result = ope::select(ope::cmpEQ(x, inf()), inf(), result);//∞ は ∞
+			return result;
+		}
+
+		//逆正接の倍精度計算（精度 2 用）
+		//※num ≦ den の atan(num / den) に、象限の補正 off + sign * a を加える
+		//※atan(u) の多項式の係数は fdlibm のもの（|u| ≦ 7/16）
+		//※補正の選択は単精度のマスクで行い、0／±1 の係数として倍精度に変換する
+		inline static vec_type atan2D(const vec_type num, const vec_type den, const vec_type big, const vec_type swap, const vec_type x_neg)
+		{
+			const vec_type one = k(1.f);
+			const vec_type big_f = ope::and_(big, one);
+			const vec_type zero_f = ope::and_(ope::cmpEQ(den, k(0.f)), one);//0 / 0 は 0 / 1 として扱う
+			const vec_type swap_sign = ope::select(swap, k(-1.f), one);
+			const vec_type x_neg_sign = ope::select(x_neg, k(-1.f), one);
+			dvec_type num_d[2], den_d[2], big_d[2], zero_d[2], swap_d[2], swap_sign_d[2], x_neg_d[2], x_neg_sign_d[2], a_d[2];
+			ope::toDouble(num, num_d[0], num_d[1]);
+			ope::toDouble(den, den_d[0], den_d[1]);
+			ope::toDouble(big_f, big_d[0], big_d[1]);
+			ope::toDouble(zero_f, zero_d[0], zero_d[1]);
+			ope::toDouble(ope::and_(swap, one), swap_d[0], swap_d[1]);
+			ope::toDouble(swap_sign, swap_sign_d[0], swap_sign_d[1]);
+			ope::toDouble(ope::and_(x_neg, one), x_neg_d[0], x_neg_d[1]);
+			ope::toDouble(x_neg_sign, x_neg_sign_d[0], x_neg_sign_d[1]);
+			for (int i = 0; i < 2; ++i)
+			{
+				//tan(π/8) を超える場合は、atan(u) = π/4 + atan((u - 1) / (u + 1)) で範囲縮小
+				const dvec_type n = dope::sub(num_d[i], dope::mul(big_d[i], den_d[i]));
+				const dvec_type d = dope::add(dope::add(den_d[i], dope::mul(big_d[i], num_d[i])), zero_d[i]);
+				const dvec_type u = dope::div(n, d);
+				const dvec_type z = dope::mul(u, u);
+				dvec_type p = dope::set(1.62858201153657823623e-02);
+				p = dope::madd(p, z, dope::set(-3.65315727442169155270e-02));
+				p = dope::madd(p, z, dope::set(4.97687799461593236017e-02));
+				p = dope::madd(p, z, dope::set(-5.83357013379057348645e-02));
+				p = dope::madd(p, z, dope::set(6.66107313738753120669e-02));
+				p = dope::madd(p, z, dope::set(-7.69187620504482999495e-02));
+				p = dope::madd(p, z, dope::set(9.09088713343650656196e-02));
+				p = dope::madd(p, z, dope::set(-1.11111104054623557880e-01));
+				p = dope::madd(p, z, dope::set(1.42857142725034663711e-01));
+				p = dope::madd(p, z, dope::set(-1.99999999998764832476e-01));
+				p = dope::madd(p, z, dope::set(3.33333333333329318027e-01));
+				dvec_type a = dope::sub(u, dope::mul(dope::mul(u, z), p));//u - u^3 * P(u^2)
+				a = dope::madd(big_d[i], dope::set(7.85398163397448278999e-01), a);//π/4
+				a = dope::madd(swap_d[i], dope::set(1.57079632679489655800e+00), dope::mul(swap_sign_d[i], a));//|y| > |x| なら π/2 - a
+				a_d[i] = dope::madd(x_neg_d[i], dope::set(3.14159265358979311600e+00), dope::mul(x_neg_sign_d[i], a));//x < 0 なら π - a
+			}
+			return ope::fromDouble(a_d[0], a_d[1]);
+		}
+
+		//逆正接（y/x の偏角）
+		//※|u| ≦ tan(π/8) に範囲縮小し、atan(u) の多項式近似と象限の補正で求める
+		//※精度 2 の場合、範囲縮小以降を倍精度で計算する
+		inline static vec_type atan2(const vec_type y, const vec_type x)
+		{
+			const vec_type ax = ope::abs(x);
+			const vec_type ay = ope::abs(y);
+			vec_type num = ope::min(ax, ay);
+			vec_type den = ope::max(ax, ay);
+			if (PRECISION >= 2)
+			{
+				//両方 ∞ の場合は 1 / 1、片方だけ ∞ の場合は 0 / 1 として扱う
+				const vec_type both_inf = ope::and_(ope::cmpEQ(ax, inf()), ope::cmpEQ(ay, inf()));
+				const vec_type den_inf = ope::andnot(both_inf, ope::cmpEQ(den, inf()));
+				num = ope::select(both_inf, k(1.f), ope::andnot(den_inf, num));
+				den = ope::select(ope::or_(both_inf, den_inf), k(1.f), den);
+				const vec_type big = ope::cmpGT(num, ope::mul(den, k(0.414213562373095049f)));
+				const vec_type x_neg = ope::cmpLT(ope::or_(ope::and_(x, signMask()), k(1.f)), k(0.f));
+				vec_type a = atan2D(num, den, big, ope::cmpGT(ay, ax), x_neg);
+				a = ope::or_(a, ope::and_(y, signMask()));//y の符号を付与
+				return ope::select(ope::cmpUnord(x, y), ope::add(x, y), a);//非数はそのまま返す
+			}
+			//除算がオーバーフロー／アンダーフローしないように、極端な値は縮小／拡大
+			const vec_type scale = ope::select(ope::cmpGT(den, k(1.26765060e+30f)), k(5.96046448e-8f), ope::select(ope::cmpLT(den, k(7.88860905e-31f)), k(16777216.f), k(1.f)));//2^100 超は 2^-24 倍、2^-100 未満は 2^24 倍
+			num = ope::mul(num, scale);
+			den = ope::mul(den, scale);
+			//両方 ∞ の場合は、1 / 1 として扱う
+			const vec_type both_inf = ope::and_(ope::cmpEQ(ax, inf()), ope::cmpEQ(ay, inf()));
+			num = ope::select(both_inf, k(1.f), num);
+			den = ope::select(both_inf, k(1.f), den);
+			//tan(π/8) を超える場合は、atan(u) = π/4 + atan((u - 1) / (u + 1)) で範囲縮小
+			const vec_type big = ope::cmpGT(num, ope::mul(den, k(0.414213562373095049f)));
+			const vec_type n = ope::select(big, ope::sub(num, den), num);
+			const vec_type d = ope::select(big, ope::add(num, den), den);
+			vec_type u = divide(n, d);
+			u = ope::andnot(ope::or_(ope::cmpEQ(d, k(0.f)), ope::cmpUnord(u, u)), u);//0 / 0 は 0
+			const vec_type z = ope::mul(u, u);
+			vec_type p;
+			if (PRECISION == 0)
+				p = ope::madd(z, k(1.7034177093e-1f), k(-3.3183377414e-1f));
+			else
+				p = ope::madd(ope::madd(z, k(-1.1225162352e-1f), k(1.9714143594e-1f)), z, k(-3.3325507777e-1f));
+			vec_type a = ope::madd(ope::mul(u, z), p, u);//u + u^3 * P(u^2)
+			a = ope::add(ope::add(a, ope::and_(big, k(-2.18556950009312142e-8f))), ope::and_(big, k(0.78539818525314331f)));//π/4
+			//|y| > |x| なら π/2 - a
+			a = ope::select(ope::cmpGT(ay, ax), ope::add(ope::sub(k(1.5707963705062866f), a), k(-4.37113900018624283e-8f)), a);//π/2
+			//x < 0（-0 を含む）なら π - a
+			const vec_type x_neg = ope::cmpLT(ope::or_(ope::and_(x, signMask()), k(1.f)), k(0.f));
+			a = ope::select(x_neg, ope::add(ope::sub(k(3.1415927410125732f), a), k(-8.74227800037248566e-8f)), a);//π
+			//y の符号を付与
+			a = ope::or_(a, ope::and_(y, signMask()));
+			return ope::select(ope::cmpUnord(x, y), ope::add(x, y), a);//非数はそのまま返す
+		}
+
+		//べき乗の本体（|x|^y）
+		//※精度 0, 1 の場合、exp(y * log(|x|)) を単精度で計算する
+		//※精度 2 の場合、y * log(|x|) と指数の多項式を倍精度で計算する
+		inline static vec_type powCore(const vec_type ax, const vec_type y)
+		{
+			if (PRECISION < 2)
+				return exp(ope::mul(y, log(ax)));
+			//|x| = 2^e * m（√0.5 ≦ m < √2）に分解
+			vec_type e, m;
+			splitExponent(ax, e, m);
+			//倍精度で t = y * log(|x|) と 2^n * e^r を計算
+			dvec_type e_d[2], m_d[2], y_d[2], n_d[2], p_d[2];
+			ope::toDouble(e, e_d[0], e_d[1]);
+			ope::toDouble(m, m_d[0], m_d[1]);
+			ope::toDouble(y, y_d[0], y_d[1]);
+			for (int i = 0; i < 2; ++i)
+			{
+				dvec_type t = dope::mul(y_d[i], logD(e_d[i], m_d[i]));
+				t = dope::min(dope::max(t, dope::set(-104.)), dope::set(89.));//結果が 0 または ∞ になる範囲で制限
+				expD(t, n_d[i], p_d[i]);
+			}
+			//単精度に変換し、2^n を乗算
+			return scaleD(n_d, p_d);
+		}
+		//べき乗（x^y）
+		inline static vec_type pow(const vec_type x, const vec_type y)
+		{
+			const vec_type ax = ope::abs(x);
+			const vec_type ay = ope::abs(y);
+			vec_type result = powCore(ax, y);
+			//|x| が 0 または ∞ の場合は、0 または ∞
+			const vec_type x_zero = ope::cmpEQ(ax, k(0.f));
+			const vec_type x_inf = ope::cmpEQ(ax, inf());
+			result = ope::select(ope::or_(x_zero, x_inf), ope::and_(ope::xor_(ope::cmpGT(y, k(0.f)), x_zero), inf()), result);
+			//y が整数か？（2^24 以上は常に偶数の整数）
+			const typename ope::ivec_type y_i = ope::toInt(y);
+			const vec_type y_large = ope::cmpGE(ay, k(16777216.f));
+			const vec_type y_int = ope::or_(ope::cmpEQ(ope::toFloat(y_i), y), y_large);
+			const vec_type y_odd = ope::andnot(y_large, ope::and_(y_int, ope::testBits(y_i, 1)));
+			//x が負（-0 を含む）で y が奇数なら符号を反転
+			const vec_type x_neg = ope::cmpLT(ope::or_(ope::and_(x, signMask()), k(1.f)), k(0.f));
+			result = ope::xor_(result, ope::and_(ope::and_(x_neg, y_odd), signMask()));
+			//x が有限の負数で y が整数でないなら非数
+			result = ope::or_(result, ope::andnot(y_int, ope::and_(ope::cmpLT(x, k(0.f)), ope::cmpNEQ(ax, inf()))));
+			//非数はそのまま返す
+			result = ope::select(ope::cmpUnord(x, y), ope::add(x, y), result);
+			//y が 0、x が 1、|x| が 1 で y が ±∞ なら 1
+			const vec_type one = ope::or_(ope::or_(ope::cmpEQ(y, k(0.f)), ope::cmpEQ(x, k(1.f))), ope::and_(ope::cmpEQ(ax, k(1.f)), ope::cmpEQ(ay, inf())));
+			return ope::select(one, k(1.f), result);
+		}
+	};
+#endif//GASHA_FAST_ARITH_USE_SSE2
+}//namespace _private
+
+//----------------------------------------
+//高速超越関数：float版
+//※SSE2命令が有効なら、__m128版で計算する
+//※SSE2命令が無効なら、倍精度の標準ライブラリの関数で計算し、単精度に丸める
+//　（単精度の標準ライブラリの関数は、実装によって 1ulp を超える誤差がある）
+
+//正弦
+template<template<typename> class ARITH>
+inline float fastSin(const float x)
+{
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+	return _mm_cvtss_f32(fastSin<ARITH>(_mm_set_ss(x)));
+#else//GASHA_FAST_ARITH_USE_SSE2
+	return static_cast<float>(std::sin(static_cast<double>(x)));
+#endif//GASHA_FAST_ARITH_USE_SSE2
+}
+//余弦
+template<template<typename> class ARITH>
+inline float fastCos(const float x)
+{
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+	return _mm_cvtss_f32(fastCos<ARITH>(_mm_set_ss(x)));
+#else//GASHA_FAST_ARITH_USE_SSE2
+	return static_cast<float>(std::cos(static_cast<double>(x)));
+#endif//GASHA_FAST_ARITH_USE_SSE2
+}
+//正弦と余弦
+template<template<typename> class ARITH>
+inline void fastSinCos(const float x, float& sin_result, float& cos_result)
+{
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+	__m128 sin_m128;
+	__m128 cos_m128;
+	fastSinCos<ARITH>(_mm_set_ss(x), sin_m128, cos_m128);
+	sin_result = _mm_cvtss_f32(sin_m128);
+	cos_result = _mm_cvtss_f32(cos_m128);
+#else//GASHA_FAST_ARITH_USE_SSE2
+	sin_result = static_cast<float>(std::sin(static_cast<double>(x)));
+	cos_result = static_cast<float>(std::cos(static_cast<double>(x)));
+#endif//GASHA_FAST_ARITH_USE_SSE2
+}
+//指数（e^x）
+template<template<typename> class ARITH>
+inline float fastExp(const float x)
+{
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+	return _mm_cvtss_f32(fastExp<ARITH>(_mm_set_ss(x)));
+#else//GASHA_FAST_ARITH_USE_SSE2
+	return static_cast<float>(std::exp(static_cast<double>(x)));
+#endif//GASHA_FAST_ARITH_USE_SSE2
+}
+//自然対数
+template<template<typename> class ARITH>
+inline float fastLog(const float x)
+{
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+	return _mm_cvtss_f32(fastLog<ARITH>(_mm_set_ss(x)));
+#else//GASHA_FAST_ARITH_USE_SSE2
+	return static_cast<float>(std::log(static_cast<double>(x)));
+#endif//GASHA_FAST_ARITH_USE_SSE2
+}
+//逆正接（y/x の偏角）
+template<template<typename> class ARITH>
+inline float fastAtan2(const float y, const float x)
+{
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+	return _mm_cvtss_f32(fastAtan2<ARITH>(_mm_set_ss(y), _mm_set_ss(x)));
+#else//GASHA_FAST_ARITH_USE_SSE2
+	return static_cast<float>(std::atan2(static_cast<double>(y), static_cast<double>(x)));
+#endif//GASHA_FAST_ARITH_USE_SSE2
+}
+//べき乗（x^y）
+template<template<typename> class ARITH>
+inline float fastPow(const float x, const float y)
+{
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+	return _mm_cvtss_f32(fastPow<ARITH>(_mm_set_ss(x), _mm_set_ss(y)));
+#else//GASHA_FAST_ARITH_USE_SSE2
+	return static_cast<float>(std::pow(static_cast<double>(x), static_cast<double>(y)));
+#endif//GASHA_FAST_ARITH_USE_SSE2
+}
+
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+//----------------------------------------
+//高速超越関数：__m128版
+template<template<typename> class ARITH>
+inline __m128 fastSin(const __m128 x){ return _private::fastTransCalc<__m128, _private::fastTransPrecision<ARITH>::value>::sin(x); }
+template<template<typename> class ARITH>
+inline __m128 fastCos(const __m128 x){ return _private::fastTransCalc<__m128, _private::fastTransPrecision<ARITH>::value>::cos(x); }
+template<template<typename> class ARITH>
+inline void fastSinCos(const __m128 x, __m128& sin_result, __m128& cos_result){ _private::fastTransCalc<__m128, _private::fastTransPrecision<ARITH>::value>::sinCos(x, sin_result, cos_result); }
+template<template<typename> class ARITH>
+inline __m128 fastExp(const __m128 x){ return _private::fastTransCalc<__m128, _private::fastTransPrecision<ARITH>::value>::exp(x); }
+template<template<typename> class ARITH>
+inline __m128 fastLog(const __m128 x){ return _private::fastTransCalc<__m128, _private::fastTransPrecision<ARITH>::value>::log(x); }
+template<template<typename> class ARITH>
+inline __m128 fastAtan2(const __m128 y, const __m128 x){ return _private::fastTransCalc<__m128, _private::fastTransPrecision<ARITH>::value>::atan2(y, x); }
+template<template<typename> class ARITH>
+inline __m128 fastPow(const __m128 x, const __m128 y){ return _private::fastTransCalc<__m128, _private::fastTransPrecision<ARITH>::value>::pow(x, y); }
+#endif//GASHA_FAST_ARITH_USE_SSE2
+
+#ifdef GASHA_FAST_ARITH_USE_AVX
+//----------------------------------------
+//高速超越関数：__m256版
+template<template<typename> class ARITH>
+inline __m256 fastSin(const __m256 x){ return _private::fastTransCalc<__m256, _private::fastTransPrecision<ARITH>::value>::sin(x); }
+template<template<typename> class ARITH>
+inline __m256 fastCos(const __m256 x){ return _private::fastTransCalc<__m256, _private::fastTransPrecision<ARITH>::value>::cos(x); }
+template<template<typename> class ARITH>
+inline void fastSinCos(const __m256 x, __m256& sin_result, __m256& cos_result){ _private::fastTransCalc<__m256, _private::fastTransPrecision<ARITH>::value>::sinCos(x, sin_result, cos_result); }
+template<template<typename> class ARITH>
+inline __m256 fastExp(const __m256 x){ return _private::fastTransCalc<__m256, _private::fastTransPrecision<ARITH>::value>::exp(x); }
+template<template<typename> class ARITH>
+inline __m256 fastLog(const __m256 x){ return _private::fastTransCalc<__m256, _private::fastTransPrecision<ARITH>::value>::log(x); }
+template<template<typename> class ARITH>
+inline __m256 fastAtan2(const __m256 y, const __m256 x){ return _private::fastTransCalc<__m256, _private::fastTransPrecision<ARITH>::value>::atan2(y, x); }
+template<template<typename> class ARITH>
+inline __m256 fastPow(const __m256 x, const __m256 y){ return _private::fastTransCalc<__m256, _private::fastTransPrecision<ARITH>::value>::pow(x, y); }
+#endif//GASHA_FAST_ARITH_USE_AVX
+
 //--------------------------------------------------------------------------------
 //テンプレート行列
 //--------------------------------------------------------------------------------
@@ -1880,10 +3167,10 @@ inline void m128_sub(__m128 (&mat_result)[4], const __m128 (&mat1_m128)[4], cons
 inline void m128_mul(__m128 (&mat_result)[4], const __m128 (&mat_m128)[4], const float scalar)
 {
 	const __m128 scalar_m128 = _mm_set1_ps(scalar);
-	mat_result[0] = _mm_sub_ps(mat_m128[0], scalar_m128);
-	mat_result[1] = _mm_sub_ps(mat_m128[1], scalar_m128);
-	mat_result[2] = _mm_sub_ps(mat_m128[2], scalar_m128);
-	mat_result[3] = _mm_sub_ps(mat_m128[3], scalar_m128);
+	mat_result[0] = _mm_mul_ps(mat_m128[0], scalar_m128);
+	mat_result[1] = _mm_mul_ps(mat_m128[1], scalar_m128);
+	mat_result[2] = _mm_mul_ps(mat_m128[2], scalar_m128);
+	mat_result[3] = _mm_mul_ps(mat_m128[3], scalar_m128);
 }
 
 #ifdef GASHA_USE_SSE4_1
@@ -1970,30 +3257,19 @@ inline void m128_mul(__m128 (&mat_result)[4], const __m128 (&mat1_m128)[4], cons
 		m128_mul(result.m_val, mat.m_val, scalar); \
 		return result; \
 	} \
-
-GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION_INSTANCING(fastA, float, 4, 4);
-GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION_INSTANCING(fastestA, float, 4, 4);
-GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION_INSTANCING(semiA, float, 4, 4);
-GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION_INSTANCING(sseA, float, 4, 4);
-
-#endif//GASHA_FAST_ARITH_USE_SSE
-
-#ifdef GASHA_FAST_ARITH_USE_SSE4_1
-
-#define GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION4_1_INSTANCING(CLASS_NAME, T, N, M) \
 	template<> inline CLASS_NAME<T[N][M]> mul<T, N, M>(const CLASS_NAME<T[N][M]>& mat1, const CLASS_NAME<T[N][M]>& mat2) \
 	{ \
 		CLASS_NAME<T[N][M]> result; \
-		m128_mul(result.m_val, mat1.m_val, mat2.m_val); \
+		_private::fastMatrixOpe<CLASS_NAME>::mul(result.m_val, mat1.m_val, mat2.m_val); \
 		return result; \
 	} \
 
-GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION4_1_INSTANCING(fastA, float, 4, 4);
-GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION4_1_INSTANCING(fastestA, float, 4, 4);
-GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION4_1_INSTANCING(semiA, float, 4, 4);
-GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION4_1_INSTANCING(sseA, float, 4, 4);
+GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION_INSTANCING(fastA, float, 4, 4);
+GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION_INSTANCING(fastestA, float, 4, 4);
+GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION_INSTANCING(semiA, float, 4, 4);
+GASHA_FAST_MATRIX_SET_SSE_SPECIALIZATION_INSTANCING(sseA, float, 4, 4);
 
-#endif//GASHA_FAST_ARITH_USE_SSE4_1
+#endif//GASHA_FAST_ARITH_USE_SSE
 
 #ifdef GASHA_MATRIX_OPERATION_ALWAYS_USE_SSE4_1
 
@@ -2065,6 +3341,374 @@ void mul<float, 4, 4, 4>(float(&mat_result)[4][4], const float(&mat1)[4][4], con
 
 #endif//GASHA_USE_SSE
 
+//--------------------------------------------------------------------------------
+//高速行列演算：4×4行列
+//--------------------------------------------------------------------------------
+
+namespace _private
+{
+	//----------------------------------------
+	//4×4行列演算用：通常演算
+
+	//転置
+	inline void fastMatrixScalarCalc::transpose(float (&mat_result)[4][4], const float (&mat)[4][4])
+	{
+		float tmp[4][4];
+		for (int row = 0; row < 4; ++row)
+		{
+			for (int col = 0; col < 4; ++col)
+				tmp[col][row] = mat[row][col];
+		}
+		for (int row = 0; row < 4; ++row)
+		{
+			for (int col = 0; col < 4; ++col)
+				mat_result[row][col] = tmp[row][col];
+		}
+	}
+	//逆行列
+	//※余因子展開
+	inline void fastMatrixScalarCalc::inverse(float (&mat_result)[4][4], const float (&mat)[4][4])
+	{
+		const float* m = mat[0];
+		float inv[16];
+		inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+		inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+		inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+		inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+		inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+		inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+		inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+		inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+		inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+		inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+		inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+		inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+		inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+		inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+		inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+		inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+		const float rcp_det = 1.f / (m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12]);
+		for (int index = 0; index < 16; ++index)
+			mat_result[index >> 2][index & 3] = inv[index] * rcp_det;
+	}
+	//乗算
+	inline void fastMatrixScalarCalc::mul(float (&mat_result)[4][4], const float (&mat1)[4][4], const float (&mat2)[4][4])
+	{
+		float tmp[4][4];
+		for (int row = 0; row < 4; ++row)
+		{
+			for (int col = 0; col < 4; ++col)
+				tmp[row][col] = mat1[row][0] * mat2[0][col] + mat1[row][1] * mat2[1][col] + mat1[row][2] * mat2[2][col] + mat1[row][3] * mat2[3][col];
+		}
+		for (int row = 0; row < 4; ++row)
+		{
+			for (int col = 0; col < 4; ++col)
+				mat_result[row][col] = tmp[row][col];
+		}
+	}
+	//行列×ベクトル
+	inline void fastMatrixScalarCalc::mul(float (&vec_result)[4], const float (&mat)[4][4], const float (&vec)[4])
+	{
+		const float x = vec[0], y = vec[1], z = vec[2], w = vec[3];
+		for (int row = 0; row < 4; ++row)
+			vec_result[row] = mat[row][0] * x + mat[row][1] * y + mat[row][2] * z + mat[row][3] * w;
+	}
+	//行列×ベクトル（バッチ処理）
+	inline void fastMatrixScalarCalc::mulBatch(const float (&mat)[4][4], const float (*vec)[4], float (*result)[4], const std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			mul(result[i], mat, vec[i]);
+	}
+	//座標変換（バッチ処理）
+	inline void fastMatrixScalarCalc::transformPoints(const float (&mat)[4][4], const float (*points)[3], float (*result)[3], const std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const float x = points[i][0], y = points[i][1], z = points[i][2];
+			for (int row = 0; row < 3; ++row)
+				result[i][row] = mat[row][0] * x + mat[row][1] * y + mat[row][2] * z + mat[row][3];
+		}
+	}
+
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	//----------------------------------------
+	//4×4行列演算用：SSE命令
+
+	//積和（val1 * val2 + val3）
+	template<int NEWTON_COUNT, bool USE_FMA>
+	inline __m128 fastMatrixCalc<NEWTON_COUNT, USE_FMA>::madd(const __m128 val1_m128, const __m128 val2_m128, const __m128 val3_m128)
+	{
+	#ifdef GASHA_USE_FMA3
+		if (USE_FMA)
+			return _mm_fmadd_ps(val1_m128, val2_m128, val3_m128);
+	#endif//GASHA_USE_FMA3
+		return _mm_add_ps(_mm_mul_ps(val1_m128, val2_m128), val3_m128);
+	}
+#ifdef GASHA_FAST_ARITH_USE_AVX
+	//積和（val1 * val2 + val3）
+	template<int NEWTON_COUNT, bool USE_FMA>
+	inline __m256 fastMatrixCalc<NEWTON_COUNT, USE_FMA>::madd(const __m256 val1_m256, const __m256 val2_m256, const __m256 val3_m256)
+	{
+	#ifdef GASHA_USE_FMA3
+		if (USE_FMA)
+			return _mm256_fmadd_ps(val1_m256, val2_m256, val3_m256);
+	#endif//GASHA_USE_FMA3
+		return _mm256_add_ps(_mm256_mul_ps(val1_m256, val2_m256), val3_m256);
+	}
+#endif//GASHA_FAST_ARITH_USE_AVX
+	//逆数
+	template<int NEWTON_COUNT, bool USE_FMA>
+	inline __m128 fastMatrixCalc<NEWTON_COUNT, USE_FMA>::rcp(const __m128 value_m128)
+	{
+		if (NEWTON_COUNT < 0)
+			return _mm_div_ps(_mm_set1_ps(1.f), value_m128);
+		__m128 rcp_m128 = _mm_rcp_ps(value_m128);//逆数の近似値算出
+		const __m128 const2_m128 = _mm_set1_ps(2.f);
+		for (int count = 0; count < NEWTON_COUNT; ++count)
+			rcp_m128 = _mm_mul_ps(rcp_m128, _mm_sub_ps(const2_m128, _mm_mul_ps(value_m128, rcp_m128)));//逆数の精度向上
+		return rcp_m128;
+	}
+	//転置
+	template<int NEWTON_COUNT, bool USE_FMA>
+	inline void fastMatrixCalc<NEWTON_COUNT, USE_FMA>::transpose(__m128 (&mat_result)[4], const __m128 (&mat_m128)[4])
+	{
+		const __m128 tmp0_m128 = _mm_unpacklo_ps(mat_m128[0], mat_m128[1]);
+		const __m128 tmp1_m128 = _mm_unpacklo_ps(mat_m128[2], mat_m128[3]);
+		const __m128 tmp2_m128 = _mm_unpackhi_ps(mat_m128[0], mat_m128[1]);
+		const __m128 tmp3_m128 = _mm_unpackhi_ps(mat_m128[2], mat_m128[3]);
+		mat_result[0] = _mm_movelh_ps(tmp0_m128, tmp1_m128);
+		mat_result[1] = _mm_movehl_ps(tmp1_m128, tmp0_m128);
+		mat_result[2] = _mm_movelh_ps(tmp2_m128, tmp3_m128);
+		mat_result[3] = _mm_movehl_ps(tmp3_m128, tmp2_m128);
+	}
+	//逆行列
+	//※クラメルの公式を SSE 命令で並列化したもの（Intel AP-928 の手法）
+	//※行列式の逆数の算出に、演算クラスごとの逆数を用いる
+	template<int NEWTON_COUNT, bool USE_FMA>
+	inline void fastMatrixCalc<NEWTON_COUNT, USE_FMA>::inverse(__m128 (&mat_result)[4], const __m128 (&mat_m128)[4])
+	{
+		//転置し、2行目と4行目の上下64ビットを入れ替える
+		__m128 row_m128[4];
+		transpose(row_m128, mat_m128);
+		const __m128 row0_m128 = row_m128[0];
+		const __m128 row1_m128 = _mm_shuffle_ps(row_m128[1], row_m128[1], 0x4e);
+		__m128 row2_m128 = row_m128[2];
+		const __m128 row3_m128 = _mm_shuffle_ps(row_m128[3], row_m128[3], 0x4e);
+		//余因子を算出
+		__m128 minor0_m128, minor1_m128, minor2_m128, minor3_m128;
+		__m128 tmp_m128;
+		tmp_m128 = _mm_mul_ps(row2_m128, row3_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0xb1);
+		minor0_m128 = _mm_mul_ps(row1_m128, tmp_m128);
+		minor1_m128 = _mm_mul_ps(row0_m128, tmp_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0x4e);
+		minor0_m128 = _mm_sub_ps(_mm_mul_ps(row1_m128, tmp_m128), minor0_m128);
+		minor1_m128 = _mm_sub_ps(_mm_mul_ps(row0_m128, tmp_m128), minor1_m128);
+		minor1_m128 = _mm_shuffle_ps(minor1_m128, minor1_m128, 0x4e);
+
+		tmp_m128 = _mm_mul_ps(row1_m128, row2_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0xb1);
+		minor0_m128 = _mm_add_ps(_mm_mul_ps(row3_m128, tmp_m128), minor0_m128);
+		minor3_m128 = _mm_mul_ps(row0_m128, tmp_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0x4e);
+		minor0_m128 = _mm_sub_ps(minor0_m128, _mm_mul_ps(row3_m128, tmp_m128));
+		minor3_m128 = _mm_sub_ps(_mm_mul_ps(row0_m128, tmp_m128), minor3_m128);
+		minor3_m128 = _mm_shuffle_ps(minor3_m128, minor3_m128, 0x4e);
+
+		tmp_m128 = _mm_mul_ps(_mm_shuffle_ps(row1_m128, row1_m128, 0x4e), row3_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0xb1);
+		row2_m128 = _mm_shuffle_ps(row2_m128, row2_m128, 0x4e);
+		minor0_m128 = _mm_add_ps(_mm_mul_ps(row2_m128, tmp_m128), minor0_m128);
+		minor2_m128 = _mm_mul_ps(row0_m128, tmp_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0x4e);
+		minor0_m128 = _mm_sub_ps(minor0_m128, _mm_mul_ps(row2_m128, tmp_m128));
+		minor2_m128 = _mm_sub_ps(_mm_mul_ps(row0_m128, tmp_m128), minor2_m128);
+		minor2_m128 = _mm_shuffle_ps(minor2_m128, minor2_m128, 0x4e);
+
+		tmp_m128 = _mm_mul_ps(row0_m128, row1_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0xb1);
+		minor2_m128 = _mm_add_ps(_mm_mul_ps(row3_m128, tmp_m128), minor2_m128);
+		minor3_m128 = _mm_sub_ps(_mm_mul_ps(row2_m128, tmp_m128), minor3_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0x4e);
+		minor2_m128 = _mm_sub_ps(_mm_mul_ps(row3_m128, tmp_m128), minor2_m128);
+		minor3_m128 = _mm_sub_ps(minor3_m128, _mm_mul_ps(row2_m128, tmp_m128));
+
+		tmp_m128 = _mm_mul_ps(row0_m128, row3_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0xb1);
+		minor1_m128 = _mm_sub_ps(minor1_m128, _mm_mul_ps(row2_m128, tmp_m128));
+		minor2_m128 = _mm_add_ps(_mm_mul_ps(row1_m128, tmp_m128), minor2_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0x4e);
+		minor1_m128 = _mm_add_ps(_mm_mul_ps(row2_m128, tmp_m128), minor1_m128);
+		minor2_m128 = _mm_sub_ps(minor2_m128, _mm_mul_ps(row1_m128, tmp_m128));
+
+		tmp_m128 = _mm_mul_ps(row0_m128, row2_m128);
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0xb1);
+		minor1_m128 = _mm_add_ps(_mm_mul_ps(row3_m128, tmp_m128), minor1_m128);
+		minor3_m128 = _mm_sub_ps(minor3_m128, _mm_mul_ps(row1_m128, tmp_m128));
+		tmp_m128 = _mm_shuffle_ps(tmp_m128, tmp_m128, 0x4e);
+		minor1_m128 = _mm_sub_ps(minor1_m128, _mm_mul_ps(row3_m128, tmp_m128));
+		minor3_m128 = _mm_add_ps(_mm_mul_ps(row1_m128, tmp_m128), minor3_m128);
+		//行列式
+		__m128 det_m128 = _mm_mul_ps(row0_m128, minor0_m128);
+		det_m128 = _mm_add_ps(_mm_shuffle_ps(det_m128, det_m128, 0x4e), det_m128);
+		det_m128 = _mm_add_ps(_mm_shuffle_ps(det_m128, det_m128, 0xb1), det_m128);//全要素に行列式
+		const __m128 rcp_det_m128 = rcp(det_m128);
+		//余因子行列に行列式の逆数を乗算
+		mat_result[0] = _mm_mul_ps(rcp_det_m128, minor0_m128);
+		mat_result[1] = _mm_mul_ps(rcp_det_m128, minor1_m128);
+		mat_result[2] = _mm_mul_ps(rcp_det_m128, minor2_m128);
+		mat_result[3] = _mm_mul_ps(rcp_det_m128, minor3_m128);
+	}
+	//乗算
+	//※mat1 の各要素をブロードキャストし、mat2 の各行に積和する（転置や水平加算が不要）
+	template<int NEWTON_COUNT, bool USE_FMA>
+	inline void fastMatrixCalc<NEWTON_COUNT, USE_FMA>::mul(__m128 (&mat_result)[4], const __m128 (&mat1_m128)[4], const __m128 (&mat2_m128)[4])
+	{
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		//2行ずつ処理
+		const __m256 mat2_row0_m256 = _mm256_insertf128_ps(_mm256_castps128_ps256(mat2_m128[0]), mat2_m128[0], 1);
+		const __m256 mat2_row1_m256 = _mm256_insertf128_ps(_mm256_castps128_ps256(mat2_m128[1]), mat2_m128[1], 1);
+		const __m256 mat2_row2_m256 = _mm256_insertf128_ps(_mm256_castps128_ps256(mat2_m128[2]), mat2_m128[2], 1);
+		const __m256 mat2_row3_m256 = _mm256_insertf128_ps(_mm256_castps128_ps256(mat2_m128[3]), mat2_m128[3], 1);
+		const __m256 mat1_row01_m256 = _mm256_insertf128_ps(_mm256_castps128_ps256(mat1_m128[0]), mat1_m128[1], 1);
+		const __m256 mat1_row23_m256 = _mm256_insertf128_ps(_mm256_castps128_ps256(mat1_m128[2]), mat1_m128[3], 1);
+		__m256 row01_m256 = _mm256_mul_ps(_mm256_permute_ps(mat1_row01_m256, 0x00), mat2_row0_m256);
+		__m256 row23_m256 = _mm256_mul_ps(_mm256_permute_ps(mat1_row23_m256, 0x00), mat2_row0_m256);
+		row01_m256 = madd(_mm256_permute_ps(mat1_row01_m256, 0x55), mat2_row1_m256, row01_m256);
+		row23_m256 = madd(_mm256_permute_ps(mat1_row23_m256, 0x55), mat2_row1_m256, row23_m256);
+		row01_m256 = madd(_mm256_permute_ps(mat1_row01_m256, 0xaa), mat2_row2_m256, row01_m256);
+		row23_m256 = madd(_mm256_permute_ps(mat1_row23_m256, 0xaa), mat2_row2_m256, row23_m256);
+		row01_m256 = madd(_mm256_permute_ps(mat1_row01_m256, 0xff), mat2_row3_m256, row01_m256);
+		row23_m256 = madd(_mm256_permute_ps(mat1_row23_m256, 0xff), mat2_row3_m256, row23_m256);
+		mat_result[0] = _mm256_castps256_ps128(row01_m256);
+		mat_result[1] = _mm256_extractf128_ps(row01_m256, 1);
+		mat_result[2] = _mm256_castps256_ps128(row23_m256);
+		mat_result[3] = _mm256_extractf128_ps(row23_m256, 1);
+	#else//GASHA_FAST_ARITH_USE_AVX
+		__m128 tmp_m128[4];
+		for (int row = 0; row < 4; ++row)
+		{
+			const __m128 mat1_row_m128 = mat1_m128[row];
+			__m128 row_m128 = _mm_mul_ps(_mm_shuffle_ps(mat1_row_m128, mat1_row_m128, 0x00), mat2_m128[0]);
+			row_m128 = madd(_mm_shuffle_ps(mat1_row_m128, mat1_row_m128, 0x55), mat2_m128[1], row_m128);
+			row_m128 = madd(_mm_shuffle_ps(mat1_row_m128, mat1_row_m128, 0xaa), mat2_m128[2], row_m128);
+			row_m128 = madd(_mm_shuffle_ps(mat1_row_m128, mat1_row_m128, 0xff), mat2_m128[3], row_m128);
+			tmp_m128[row] = row_m128;
+		}
+		for (int row = 0; row < 4; ++row)
+			mat_result[row] = tmp_m128[row];
+	#endif//GASHA_FAST_ARITH_USE_AVX
+	}
+	//行列×ベクトル
+	//※転置した列ベクトルに、ベクトルの各要素をブロードキャストして積和する
+	template<int NEWTON_COUNT, bool USE_FMA>
+	inline __m128 fastMatrixCalc<NEWTON_COUNT, USE_FMA>::mul(const __m128 (&mat_m128)[4], const __m128 vec_m128)
+	{
+		__m128 col_m128[4];
+		transpose(col_m128, mat_m128);
+		__m128 result_m128 = _mm_mul_ps(col_m128[0], _mm_shuffle_ps(vec_m128, vec_m128, 0x00));
+		result_m128 = madd(col_m128[1], _mm_shuffle_ps(vec_m128, vec_m128, 0x55), result_m128);
+		result_m128 = madd(col_m128[2], _mm_shuffle_ps(vec_m128, vec_m128, 0xaa), result_m128);
+		result_m128 = madd(col_m128[3], _mm_shuffle_ps(vec_m128, vec_m128, 0xff), result_m128);
+		return result_m128;
+	}
+	//行列×ベクトル（バッチ処理）
+	//※行列の転置は最初に一度だけ行う
+	template<int NEWTON_COUNT, bool USE_FMA>
+	inline void fastMatrixCalc<NEWTON_COUNT, USE_FMA>::mulBatch(const __m128 (&mat_m128)[4], const float (*vec)[4], float (*result)[4], const std::size_t n)
+	{
+		__m128 col_m128[4];
+		transpose(col_m128, mat_m128);
+		std::size_t i = 0;
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		//2ベクトルずつ処理
+		const __m256 col0_m256 = _mm256_insertf128_ps(_mm256_castps128_ps256(col_m128[0]), col_m128[0], 1);
+		const __m256 col1_m256 = _mm256_insertf128_ps(_mm256_castps128_ps256(col_m128[1]), col_m128[1], 1);
+		const __m256 col2_m256 = _mm256_insertf128_ps(_mm256_castps128_ps256(col_m128[2]), col_m128[2], 1);
+		const __m256 col3_m256 = _mm256_insertf128_ps(_mm256_castps128_ps256(col_m128[3]), col_m128[3], 1);
+		for (; i + 2 <= n; i += 2)
+		{
+			const __m256 vec_m256 = _mm256_loadu_ps(vec[i]);
+			__m256 result_m256 = _mm256_mul_ps(col0_m256, _mm256_permute_ps(vec_m256, 0x00));
+			result_m256 = madd(col1_m256, _mm256_permute_ps(vec_m256, 0x55), result_m256);
+			result_m256 = madd(col2_m256, _mm256_permute_ps(vec_m256, 0xaa), result_m256);
+			result_m256 = madd(col3_m256, _mm256_permute_ps(vec_m256, 0xff), result_m256);
+			_mm256_storeu_ps(result[i], result_m256);
+		}
+	#endif//GASHA_FAST_ARITH_USE_AVX
+		for (; i < n; ++i)
+		{
+			const __m128 vec_m128 = _mm_loadu_ps(vec[i]);
+			__m128 result_m128 = _mm_mul_ps(col_m128[0], _mm_shuffle_ps(vec_m128, vec_m128, 0x00));
+			result_m128 = madd(col_m128[1], _mm_shuffle_ps(vec_m128, vec_m128, 0x55), result_m128);
+			result_m128 = madd(col_m128[2], _mm_shuffle_ps(vec_m128, vec_m128, 0xaa), result_m128);
+			result_m128 = madd(col_m128[3], _mm_shuffle_ps(vec_m128, vec_m128, 0xff), result_m128);
+			_mm_storeu_ps(result[i], result_m128);
+		}
+	}
+	//座標変換（バッチ処理）
+	//※w = 1 として、平行移動成分（4列目）を初期値に積和する
+	template<int NEWTON_COUNT, bool USE_FMA>
+	inline void fastMatrixCalc<NEWTON_COUNT, USE_FMA>::transformPoints(const __m128 (&mat_m128)[4], const float (*points)[3], float (*result)[3], const std::size_t n)
+	{
+		__m128 col_m128[4];
+		transpose(col_m128, mat_m128);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const float* point = points[i];
+			__m128 result_m128 = madd(col_m128[0], _mm_set1_ps(point[0]), col_m128[3]);
+			result_m128 = madd(col_m128[1], _mm_set1_ps(point[1]), result_m128);
+			result_m128 = madd(col_m128[2], _mm_set1_ps(point[2]), result_m128);
+			_mm_storel_pi(reinterpret_cast<__m64*>(result[i]), result_m128);
+			_mm_store_ss(&result[i][2], _mm_movehl_ps(result_m128, result_m128));
+		}
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+}//namespace _private
+
+//----------------------------------------
+//高速行列演算：4×4行列
+#define GASHA_FAST_MATRIX44_SET_INSTANCING(CLASS_NAME) \
+	inline CLASS_NAME<float[4][4]> transpose(const CLASS_NAME<float[4][4]>& mat) \
+	{ \
+		CLASS_NAME<float[4][4]> result; \
+		_private::fastMatrixOpe<CLASS_NAME>::transpose(result.m_val, mat.m_val); \
+		return result; \
+	} \
+	inline CLASS_NAME<float[4][4]> inverse(const CLASS_NAME<float[4][4]>& mat) \
+	{ \
+		CLASS_NAME<float[4][4]> result; \
+		_private::fastMatrixOpe<CLASS_NAME>::inverse(result.m_val, mat.m_val); \
+		return result; \
+	} \
+	inline CLASS_NAME<float[4]> mul(const CLASS_NAME<float[4][4]>& mat, const CLASS_NAME<float[4]>& vec) \
+	{ \
+		GASHA_FAST_MATRIX44_MUL_VEC(CLASS_NAME); \
+	} \
+	inline void mulBatch(const CLASS_NAME<float[4][4]>& mat, const float (*vec)[4], float (*result)[4], const std::size_t n) \
+	{ \
+		_private::fastMatrixOpe<CLASS_NAME>::mulBatch(mat.m_val, vec, result, n); \
+	} \
+	inline void transformPoints(const CLASS_NAME<float[4][4]>& mat, const float (*points)[3], float (*result)[3], const std::size_t n) \
+	{ \
+		_private::fastMatrixOpe<CLASS_NAME>::transformPoints(mat.m_val, points, result, n); \
+	}
+#ifdef GASHA_FAST_ARITH_USE_SSE
+#define GASHA_FAST_MATRIX44_MUL_VEC(CLASS_NAME) \
+		return _private::fastMatrixOpe<CLASS_NAME>::mul(mat.m_val, vec.m_val)
+#else//GASHA_FAST_ARITH_USE_SSE
+#define GASHA_FAST_MATRIX44_MUL_VEC(CLASS_NAME) \
+		CLASS_NAME<float[4]> result; \
+		_private::fastMatrixOpe<CLASS_NAME>::mul(result.m_val, mat.m_val, vec.m_val); \
+		return result
+#endif//GASHA_FAST_ARITH_USE_SSE
+
+GASHA_FAST_MATRIX44_SET_INSTANCING(fastA);
+GASHA_FAST_MATRIX44_SET_INSTANCING(fastestA);
+GASHA_FAST_MATRIX44_SET_INSTANCING(semiA);
+GASHA_FAST_MATRIX44_SET_INSTANCING(sseA);
+GASHA_FAST_MATRIX44_SET_INSTANCING(normA);
+
 GASHA_NAMESPACE_END;//ネームスペース：終了
 
 #endif//GASHA_INCLUDED_FAST_MATH_INL
@@ -0,0 +1,430 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_FAST_MATH_DIAG_H
+#define GASHA_INCLUDED_FAST_MATH_DIAG_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// fast_math_diag.h
+// 高速算術診断【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/fast_math.h>//高速算術
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint32_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//高速算術診断
+//※演算クラス（fastestA, fastA, semiA, sseA, normA）ごとに、除算／平方根／正規化／長さの
+//　最大誤差（ulp）と処理時間を計測し、演算クラスを選ぶ根拠にする。
+//※入力値は、正の浮動小数点数のビットパターンを下位から順に（step 間隔で）走査して作る。
+//　step に 1 を指定すると、範囲内の全ての値を検査する。
+//　（fastArithDiagnosticReport() で全ての演算クラスを検査すると30分以上かかるため、通常は素数の step で間引く）
+//　・除算（DIV）        ... a / x。x は 2^-125～2^125、a は x から作った 1.0～2.0 の値。
+//　・平方根（SQRT）      ... sqrt(x)。x は正規化数の全範囲。
+//　・正規化（NORMALIZE） ... (x, x*r1, x*r2) を正規化。x は 2^-60～2^60、r は x から作った -1.0～1.0 の値。
+//　・長さ（LENGTH）      ... 二点 (x, x*r1, x*r2) と (-x*r3, -x*r4, -x*r5) の間の長さ。x と r は正規化と同じ。
+//※誤差は倍精度で計算した値との差を、結果の ulp 単位で表す。（正しく丸めた結果でも最大 0.5ulp）
+//　正規化は、結果の長さ（1.0）の ulp 単位で表す。
+//※対象の型ごとに、次の処理を計測する。
+//　・SCALAR ... ARITH<float>, ARITH<float[3]> の演算。（除算：operator/, 平方根：sqr, 正規化：normalize, 長さ：length）
+//　・M128   ... ARITH<__m128> の除算／平方根と、SoAバッチ処理と同じ __m128 の正規化／長さ。（GASHA_FAST_ARITH_USE_SSE 有効時）
+//　・M256   ... ARITH<__m256> の除算／平方根と、SoAバッチ処理と同じ __m256 の正規化／長さ。（GASHA_FAST_ARITH_USE_AVX 有効時）
+//　使用できない型の結果は m_isAvailable が false になる。
+//※処理時間は、入力範囲から均等に選んだ値の配列を繰り返し演算して計測する。
+//　（入力の読み込みと結果の書き込みを含む、1要素あたりの時間）
+//--------------------------------------------------------------------------------
+//【誤差の計測結果】
+//※SSE4.1／AVX有効時、FMA無効時の計測結果（step = 1、最大誤差 ulp）
+//　                   DIV      SQRT  NORMALIZE   LENGTH
+//　fastestA SCALAR  5032.68   4095.00      1.39      2.15
+//　         M128    5032.68   4095.00   2732.89   4095.80
+//　         M256       0.50      0.50   2732.89   4095.80
+//　fastA    SCALAR     3.79      4.47      1.39      2.15
+//　         M128       3.79      4.47      2.60      4.85
+//　         M256       0.50      0.50      2.60      4.85
+//　semiA    SCALAR     2.74      3.84      1.39      2.15
+//　         M128       2.74      3.84      1.81      3.80
+//　         M256       0.50      0.50      1.81      3.80
+//　sseA     SCALAR     0.50      0.50      1.39      2.15
+//　         M128       0.50      0.50      1.57      2.15
+//　         M256       0.50      0.50      1.57      2.15
+//　normA    (sseA と同じ)
+//※ARITH<__m256> の除算／平方根は、どの演算クラスでも _mm256_div_ps／_mm256_sqrt_ps を使用するため誤差がない。
+//※ARITH<float[3]> の正規化／長さは、どの演算クラスでも近似を使用しないため、SCALAR の結果は同じになる。
+//　（処理時間は normA 以外が大きい。演算クラスの選択は M128／M256 の結果を参考にする）
+//※fastArithDiag::maxUlp() は、この結果に余裕を持たせた上限値を返す。（ユニットテストの判定に使用）
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //個別に計測
+//  const fastArithDiag::result result = fastArithDiagnosticTest<fastA>(fastArithDiag::DIV, fastArithDiag::M128, 1);
+//  printf("max=%.2lf ulp, %.3lf ns/op\n", result.m_maxUlp, result.m_nsPerOp);
+//
+//  //全ての演算クラスの結果を表にする
+//  char message[8192];
+//  std::size_t size;
+//  fastArithDiagnosticReport(message, sizeof(message), size, 97);
+//
+//  //ユニットテストで判定（最大誤差が上限値以下か判定し、計測結果を表示）
+//  GASHA_UT_BEGIN(fast_math_diag, 0, GASHA_ ut::ATTR_MANUAL)
+//  {
+//      GASHA_UT_FAST_ARITH_DIAG(97);
+//  }
+//  GASHA_UT_END()
+//--------------------------------------------------------------------------------
+
+namespace fastArithDiag
+{
+	//診断対象の演算
+	enum opeEnum : int
+	{
+		DIV = 0,   //除算
+		SQRT,      //平方根
+		NORMALIZE, //正規化
+		LENGTH,    //長さ
+		OPE_NUM,
+	};
+	//診断対象の型
+	enum typeEnum : int
+	{
+		SCALAR = 0, //float
+		M128,       //__m128
+		M256,       //__m256
+		TYPE_NUM,
+	};
+	//診断結果
+	struct result
+	{
+		bool m_isAvailable;//診断できたか？
+		double m_maxUlp;//最大誤差（ulp）
+		double m_avgUlp;//平均誤差（ulp）
+		float m_worstInput;//最大誤差になった入力値（x）
+		std::size_t m_count;//検査した値の数
+		double m_nsPerOp;//1要素あたりの処理時間（ナノ秒）
+	};
+	//名前
+	inline const char* opeName(const opeEnum ope);
+	inline const char* typeName(const typeEnum type);
+	template<template<typename> class ARITH>
+	inline const char* arithName();
+	//最大誤差の上限値（ulp）
+	template<template<typename> class ARITH>
+	inline double maxUlp(const opeEnum ope);
+}//namespace fastArithDiag
+
+//----------------------------------------
+//演算の誤差と処理時間を計測
+//※step ... 入力値のビットパターンの走査間隔（1 で全ての値を検査）
+template<template<typename> class ARITH>
+inline fastArithDiag::result fastArithDiagnosticTest(const fastArithDiag::opeEnum ope, const fastArithDiag::typeEnum type, const std::uint32_t step = 1);
+
+//----------------------------------------
+//全ての演算クラスの計測結果を表にする
+//※全ての最大誤差が上限値以下なら true を返す
+//※診断結果メッセージとそのサイズを受け取るための変数を引数に渡す（バッファは8KBもあれば十分）。
+inline bool fastArithDiagnosticReport(char* message, const std::size_t max_size, std::size_t& message_len, const std::uint32_t step = 1);
+
+namespace _private
+{
+	//----------------------------------------
+	//高速算術診断用：入出力ブロック
+	struct fastArithDiagBlock
+	{
+		static const std::size_t SIZE = 256;//1ブロックの要素数（8の倍数）
+		float m_in[6][SIZE];//入力
+		float m_out[3][SIZE];//出力
+		float m_x[SIZE];//入力値（x）
+	};
+	//----------------------------------------
+	//高速算術診断用：演算処理の型
+	typedef void(*fastArithDiagCalc)(fastArithDiagBlock&, const std::size_t);
+	//----------------------------------------
+	//高速算術診断用：演算ごとの処理
+	//※DIAG_OPE ... 演算（fastArithDiag::opeEnum）
+	template<int DIAG_OPE>
+	struct fastArithDiagOpe;
+	//----------------------------------------
+	//高速算術診断用：演算クラスごとの計測
+	template<template<typename> class ARITH>
+	inline bool fastArithDiagReport(char* message, const std::size_t max_size, std::size_t& message_len, const std::uint32_t step);
+}//namespace _private
+
+//--------------------------------------------------------------------------------
+//ユニットテスト用マクロ
+//※GASHA_UT_BEGIN() ～ GASHA_UT_END() の間で使用する。（unit_test.h のインクルードが必要）
+//※全ての演算クラス／演算／型について、最大誤差が上限値以下か判定し、計測結果を表示する。
+//--------------------------------------------------------------------------------
+#define GASHA_UT_FAST_ARITH_DIAG_ARITH(ARITH, step) \
+	for (int diag_ope = 0; diag_ope < GASHA_ fastArithDiag::OPE_NUM; ++diag_ope) \
+	{ \
+		for (int diag_type = 0; diag_type < GASHA_ fastArithDiag::TYPE_NUM; ++diag_type) \
+		{ \
+			const GASHA_ fastArithDiag::opeEnum ope = static_cast<GASHA_ fastArithDiag::opeEnum>(diag_ope); \
+			const GASHA_ fastArithDiag::typeEnum type = static_cast<GASHA_ fastArithDiag::typeEnum>(diag_type); \
+			const GASHA_ fastArithDiag::result diag_result = GASHA_ fastArithDiagnosticTest<GASHA_ ARITH>(ope, type, step); \
+			if (!diag_result.m_isAvailable) \
+				continue; \
+			GASHA_UT_PRINTF("%-8s %-9s %-6s: max=%.2lf ulp, avg=%.3lf ulp, %.3lf ns/op\n", GASHA_ fastArithDiag::arithName<GASHA_ ARITH>(), GASHA_ fastArithDiag::opeName(ope), GASHA_ fastArithDiag::typeName(type), diag_result.m_maxUlp, diag_result.m_avgUlp, diag_result.m_nsPerOp); \
+			GASHA_UT_EXPECT_LE_CHILD(diag_result.m_maxUlp, GASHA_ fastArithDiag::maxUlp<GASHA_ ARITH>(ope)); \
+		} \
+	}
+#define GASHA_UT_FAST_ARITH_DIAG(step) \
+	GASHA_UT_FAST_ARITH_DIAG_ARITH(fastestA, step); \
+	GASHA_UT_FAST_ARITH_DIAG_ARITH(fastA, step); \
+	GASHA_UT_FAST_ARITH_DIAG_ARITH(semiA, step); \
+	GASHA_UT_FAST_ARITH_DIAG_ARITH(sseA, step); \
+	GASHA_UT_FAST_ARITH_DIAG_ARITH(normA, step);
+
+//--------------------------------------------------------------------------------
+//高速超越関数診断
+//※演算クラス（fastestA, fastA, semiA, sseA, normA）ごとに、高速超越関数の最大誤差（ulp）と処理時間を計測し、
+//　演算クラスごとの精度（fast_math.h の高速超越関数の説明を参照）を満たしているか確認する。
+//※入力値は、高速算術診断と同じく、浮動小数点数のビットパターンを（step 間隔で）走査して作る。
+//　・正弦（SIN）     ... fastSin(x)。|x| は 2^-20～8192、符号は x から作る。
+//　・余弦（COS）     ... fastCos(x)。x は正弦と同じ。
+//　・指数（EXP）     ... fastExp(x)。|x| は 2^-20～87、符号は x から作る。
+//　・対数（LOG）     ... fastLog(x)。x は正規化数の全範囲。
+//　・逆正接（ATAN2） ... fastAtan2(y, x)。|y| は 2^-60～2^60、x は y から作った -4y～4y の値。符号は y から作る。
+//　・べき乗（POW）   ... fastPow(x, y)。x は 2^-4～2^4、y は x から作った -8.0～8.0 の値。
+//※誤差は倍精度の標準ライブラリの関数で計算した値との差を、結果の ulp 単位で表す。（正しく丸めた結果でも最大 0.5ulp）
+//　ただし、fastestA, fastA の正弦／余弦は、結果が 0 に近い時は絶対誤差で評価するため、1.0 の ulp を下限とする。
+//※対象の型は高速算術診断と同じ。（__m128 は GASHA_FAST_ARITH_USE_SSE2 有効時）
+//※処理時間は、入力範囲から均等に選んだ値の配列を繰り返し演算して計測した、1要素あたりの時間。
+//--------------------------------------------------------------------------------
+//【誤差の計測結果】
+//※SSE4.1／AVX／FMA有効時、GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION 有効時の計測結果（step = 1、最大誤差 ulp）
+//　                 SIN      COS      EXP      LOG    ATAN2      POW
+//　fastestA     3406.05  3363.93  1642.02  1480.72  4971.43  5064.45
+//　fastA          11.83    11.51     2.62     4.90    11.89    43.55
+//　semiA           0.50     0.50     0.50     0.50     0.50     0.50
+//　sseA, normA  (semiA と同じ)
+//※float, __m128, __m256 は同じ処理で計算するため、型によらず同じ結果になる。
+//※GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION 無効時は、fastestA の ATAN2 が約300ulp になる。
+//※fastTransDiag::maxUlp() は、この結果に余裕を持たせた上限値を返す。（ユニットテストの判定に使用）
+//　semiA, sseA, normA は、全ての演算で 1ulp。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //個別に計測
+//  const fastArithDiag::result result = fastTransDiagnosticTest<semiA>(fastTransDiag::SIN, fastArithDiag::M128, 1);
+//  printf("max=%.2lf ulp, %.3lf ns/op\n", result.m_maxUlp, result.m_nsPerOp);
+//
+//  //全ての演算クラスの結果を表にする
+//  char message[8192];
+//  std::size_t size;
+//  fastTransDiagnosticReport(message, sizeof(message), size, 97);
+//
+//  //ユニットテストで判定（最大誤差が上限値以下か判定し、計測結果を表示）
+//  GASHA_UT_BEGIN(fast_trans_diag, 0, GASHA_ ut::ATTR_MANUAL)
+//  {
+//      GASHA_UT_FAST_TRANS_DIAG(97);
+//  }
+//  GASHA_UT_END()
+//--------------------------------------------------------------------------------
+
+namespace fastTransDiag
+{
+	//診断対象の演算
+	enum opeEnum : int
+	{
+		SIN = 0, //正弦
+		COS,     //余弦
+		EXP,     //指数
+		LOG,     //自然対数
+		ATAN2,   //逆正接
+		POW,     //べき乗
+		OPE_NUM,
+	};
+	//名前
+	inline const char* opeName(const opeEnum ope);
+	//最大誤差の上限値（ulp）
+	template<template<typename> class ARITH>
+	inline double maxUlp(const opeEnum ope);
+}//namespace fastTransDiag
+
+//----------------------------------------
+//高速超越関数の誤差と処理時間を計測
+//※型と診断結果は、高速算術診断のものを使用する
+//※step ... 入力値のビットパターンの走査間隔（1 で全ての値を検査）
+template<template<typename> class ARITH>
+inline fastArithDiag::result fastTransDiagnosticTest(const fastTransDiag::opeEnum ope, const fastArithDiag::typeEnum type, const std::uint32_t step = 1);
+
+//----------------------------------------
+//全ての演算クラスの計測結果を表にする
+//※全ての最大誤差が上限値以下なら true を返す
+//※診断結果メッセージとそのサイズを受け取るための変数を引数に渡す（バッファは8KBもあれば十分）。
+inline bool fastTransDiagnosticReport(char* message, const std::size_t max_size, std::size_t& message_len, const std::uint32_t step = 1);
+
+namespace _private
+{
+	//----------------------------------------
+	//高速超越関数診断用：演算ごとの処理
+	//※DIAG_OPE ... 演算（fastTransDiag::opeEnum）
+	//※PRECISION ... 演算クラスの精度（fastTransPrecision::value）
+	template<int DIAG_OPE, int PRECISION>
+	struct fastTransDiagOpe;
+	//----------------------------------------
+	//高速超越関数診断用：演算クラスごとの計測
+	template<template<typename> class ARITH>
+	inline bool fastTransDiagReport(char* message, const std::size_t max_size, std::size_t& message_len, const std::uint32_t step);
+}//namespace _private
+
+//--------------------------------------------------------------------------------
+//ユニットテスト用マクロ
+//※GASHA_UT_BEGIN() ～ GASHA_UT_END() の間で使用する。（unit_test.h のインクルードが必要）
+//※全ての演算クラス／演算／型について、最大誤差が上限値以下か判定し、計測結果を表示する。
+//--------------------------------------------------------------------------------
+#define GASHA_UT_FAST_TRANS_DIAG_ARITH(ARITH, step) \
+	for (int diag_ope = 0; diag_ope < GASHA_ fastTransDiag::OPE_NUM; ++diag_ope) \
+	{ \
+		for (int diag_type = 0; diag_type < GASHA_ fastArithDiag::TYPE_NUM; ++diag_type) \
+		{ \
+			const GASHA_ fastTransDiag::opeEnum ope = static_cast<GASHA_ fastTransDiag::opeEnum>(diag_ope); \
+			const GASHA_ fastArithDiag::typeEnum type = static_cast<GASHA_ fastArithDiag::typeEnum>(diag_type); \
+			const GASHA_ fastArithDiag::result diag_result = GASHA_ fastTransDiagnosticTest<GASHA_ ARITH>(ope, type, step); \
+			if (!diag_result.m_isAvailable) \
+				continue; \
+			GASHA_UT_PRINTF("%-8s %-5s %-6s: max=%.2lf ulp, avg=%.3lf ulp, %.3lf ns/op\n", GASHA_ fastArithDiag::arithName<GASHA_ ARITH>(), GASHA_ fastTransDiag::opeName(ope), GASHA_ fastArithDiag::typeName(type), diag_result.m_maxUlp, diag_result.m_avgUlp, diag_result.m_nsPerOp); \
+			GASHA_UT_EXPECT_LE_CHILD(diag_result.m_maxUlp, GASHA_ fastTransDiag::maxUlp<GASHA_ ARITH>(ope)); \
+		} \
+	}
+#define GASHA_UT_FAST_TRANS_DIAG(step) \
+	GASHA_UT_FAST_TRANS_DIAG_ARITH(fastestA, step); \
+	GASHA_UT_FAST_TRANS_DIAG_ARITH(fastA, step); \
+	GASHA_UT_FAST_TRANS_DIAG_ARITH(semiA, step); \
+	GASHA_UT_FAST_TRANS_DIAG_ARITH(sseA, step); \
+	GASHA_UT_FAST_TRANS_DIAG_ARITH(normA, step);
+
+//--------------------------------------------------------------------------------
+//高速行列演算診断
+//※演算クラス（fastestA, fastA, semiA, sseA, normA）ごとに、4×4行列演算の処理時間を計測し、
+//　通常演算（SSE命令を使用しない float の演算）に対する速度向上率と、結果の誤差を求める。
+//　・転置（TRANSPOSE）               ... transpose(mat)
+//　・逆行列（INVERSE）               ... inverse(mat)
+//　・行列×行列（MUL_MAT）            ... mul(mat1, mat2)
+//　・行列×ベクトル（MUL_VEC）        ... mul(mat, vec)
+//　・行列×ベクトルのバッチ（MUL_BATCH） ... mulBatch(mat, vec, result, n)
+//　・座標変換のバッチ（TRANSFORM）   ... transformPoints(mat, points, result, n)
+//※入力は、固定の乱数で作った行列（対角優位で逆行列が安定して求まるもの）、ベクトル、座標を
+//　それぞれ fastMatrixDiagBlock::SIZE 個ずつ用意する。
+//　バッチ処理は、１つの行列で SIZE 個のベクトル（座標）をまとめて処理する。
+//※処理時間は、SIZE 個の演算を繰り返して計測した、１演算（ベクトル）あたりの時間。
+//※誤差は、通常演算の結果との差を、結果の要素（行列／ベクトル単位）の絶対値の最大値に対する
+//　相対誤差として、FLT_EPSILON 単位で表す。
+//　（通常演算とは乗算／加算の順序や FMA 命令の有無が異なるため、正しく計算していても数 eps の差が出る）
+//※fastMatrixDiag::maxEps() は、誤差の上限値を返す。（ユニットテストの判定に使用）
+//　逆行列以外は演算クラスによらず 4eps、逆行列は逆数の算出方法に応じた値。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //個別に計測
+//  const fastMatrixDiag::result result = fastMatrixDiagnosticTest<fastA>(fastMatrixDiag::MUL_BATCH);
+//  printf("%.3lf ns/op (x%.2lf), max=%.2lf eps\n", result.m_nsPerOp, result.m_speedUp, result.m_maxEps);
+//
+//  //全ての演算クラスの結果を表にする
+//  char message[8192];
+//  std::size_t size;
+//  fastMatrixDiagnosticReport(message, sizeof(message), size);
+//
+//  //ユニットテストで判定（誤差が上限値以下か判定し、計測結果を表示）
+//  GASHA_UT_BEGIN(fast_matrix_diag, 0, GASHA_ ut::ATTR_MANUAL)
+//  {
+//      GASHA_UT_FAST_MATRIX_DIAG();
+//  }
+//  GASHA_UT_END()
+//--------------------------------------------------------------------------------
+
+namespace fastMatrixDiag
+{
+	//診断対象の演算
+	enum opeEnum : int
+	{
+		TRANSPOSE = 0, //転置
+		INVERSE,       //逆行列
+		MUL_MAT,       //行列×行列
+		MUL_VEC,       //行列×ベクトル
+		MUL_BATCH,     //行列×ベクトルのバッチ処理
+		TRANSFORM,     //座標変換のバッチ処理
+		OPE_NUM,
+	};
+	//診断結果
+	struct result
+	{
+		double m_nsPerOp;//1演算あたりの処理時間（ナノ秒）
+		double m_scalarNsPerOp;//通常演算の1演算あたりの処理時間（ナノ秒）
+		double m_speedUp;//通常演算に対する速度向上率
+		double m_maxEps;//通常演算の結果に対する最大誤差（FLT_EPSILON 単位の相対誤差）
+	};
+	//名前
+	inline const char* opeName(const opeEnum ope);
+	//最大誤差の上限値（FLT_EPSILON 単位）
+	template<template<typename> class ARITH>
+	inline double maxEps(const opeEnum ope);
+}//namespace fastMatrixDiag
+
+//----------------------------------------
+//4×4行列演算の処理時間と誤差を計測
+template<template<typename> class ARITH>
+inline fastMatrixDiag::result fastMatrixDiagnosticTest(const fastMatrixDiag::opeEnum ope);
+
+//----------------------------------------
+//全ての演算クラスの計測結果を表にする
+//※全ての最大誤差が上限値以下なら true を返す
+//※診断結果メッセージとそのサイズを受け取るための変数を引数に渡す（バッファは8KBもあれば十分）。
+inline bool fastMatrixDiagnosticReport(char* message, const std::size_t max_size, std::size_t& message_len);
+
+namespace _private
+{
+	//----------------------------------------
+	//高速行列演算診断用：入出力ブロック
+	struct fastMatrixDiagBlock
+	{
+		static const std::size_t SIZE = 256;//1ブロックの要素数
+		float m_mat[SIZE][4][4];//入力：行列
+		float m_mat2[SIZE][4][4];//入力：行列（乗算の右辺）
+		float m_vec[SIZE][4];//入力：ベクトル
+		float m_point[SIZE][3];//入力：座標
+		float m_outMat[SIZE][4][4];//出力：行列
+		float m_outVec[SIZE][4];//出力：ベクトル
+		float m_outPoint[SIZE][3];//出力：座標
+	};
+	//----------------------------------------
+	//高速行列演算診断用：演算ごとの処理
+	//※DIAG_OPE ... 演算（fastMatrixDiag::opeEnum）
+	template<int DIAG_OPE>
+	struct fastMatrixDiagOpe;
+}//namespace _private
+
+//--------------------------------------------------------------------------------
+//ユニットテスト用マクロ
+//※GASHA_UT_BEGIN() ～ GASHA_UT_END() の間で使用する。（unit_test.h のインクルードが必要）
+//※全ての演算クラス／演算について、誤差が上限値以下か判定し、計測結果を表示する。
+//--------------------------------------------------------------------------------
+#define GASHA_UT_FAST_MATRIX_DIAG_ARITH(ARITH) \
+	for (int diag_ope = 0; diag_ope < GASHA_ fastMatrixDiag::OPE_NUM; ++diag_ope) \
+	{ \
+		const GASHA_ fastMatrixDiag::opeEnum ope = static_cast<GASHA_ fastMatrixDiag::opeEnum>(diag_ope); \
+		const GASHA_ fastMatrixDiag::result diag_result = GASHA_ fastMatrixDiagnosticTest<GASHA_ ARITH>(ope); \
+		GASHA_UT_PRINTF("%-8s %-9s: %.3lf ns/op (scalar %.3lf ns/op, x%.2lf), max=%.2lf eps\n", GASHA_ fastArithDiag::arithName<GASHA_ ARITH>(), GASHA_ fastMatrixDiag::opeName(ope), diag_result.m_nsPerOp, diag_result.m_scalarNsPerOp, diag_result.m_speedUp, diag_result.m_maxEps); \
+		GASHA_UT_EXPECT_LE_CHILD(diag_result.m_maxEps, GASHA_ fastMatrixDiag::maxEps<GASHA_ ARITH>(ope)); \
+	}
+#define GASHA_UT_FAST_MATRIX_DIAG() \
+	GASHA_UT_FAST_MATRIX_DIAG_ARITH(fastestA); \
+	GASHA_UT_FAST_MATRIX_DIAG_ARITH(fastA); \
+	GASHA_UT_FAST_MATRIX_DIAG_ARITH(semiA); \
+	GASHA_UT_FAST_MATRIX_DIAG_ARITH(sseA); \
+	GASHA_UT_FAST_MATRIX_DIAG_ARITH(normA);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/fast_math_diag.inl>
+
+#endif//GASHA_INCLUDED_FAST_MATH_DIAG_H
+
+// End of file
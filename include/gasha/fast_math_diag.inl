@@ -0,0 +1,1131 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_FAST_MATH_DIAG_INL
+#define GASHA_INCLUDED_FAST_MATH_DIAG_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// fast_math_diag.inl
+// 高速算術診断【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/fast_math_diag.h>//高速算術診断【宣言部】
+
+#include <gasha/chrono.h>//時間系ユーティリティ：elapsedTime
+#include <gasha/string.h>//文字列処理：spprintf()
+
+#include <cmath>//std::sqrt(), std::fabs(), std::sin(), std::cos(), std::exp(), std::log(), std::atan2(), std::pow()
+#include <cstring>//std::memcpy()
+#include <cfloat>//FLT_EPSILON
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+namespace fastArithDiag
+{
+	//----------------------------------------
+	//名前
+
+	//演算の名前
+	inline const char* opeName(const opeEnum ope)
+	{
+		static const char* names[OPE_NUM] = { "div", "sqrt", "normalize", "length" };
+		return ope >= 0 && ope < OPE_NUM ? names[ope] : "?";
+	}
+	//型の名前
+	inline const char* typeName(const typeEnum type)
+	{
+		static const char* names[TYPE_NUM] = { "float", "__m128", "__m256" };
+		return type >= 0 && type < TYPE_NUM ? names[type] : "?";
+	}
+	//演算クラスの名前
+	template<template<typename> class ARITH>
+	inline const char* arithName(){ return "?"; }
+	template<>
+	inline const char* arithName<fastestA>(){ return "fastestA"; }
+	template<>
+	inline const char* arithName<fastA>(){ return "fastA"; }
+	template<>
+	inline const char* arithName<semiA>(){ return "semiA"; }
+	template<>
+	inline const char* arithName<sseA>(){ return "sseA"; }
+	template<>
+	inline const char* arithName<normA>(){ return "normA"; }
+
+	//----------------------------------------
+	//最大誤差の上限値（ulp）
+	//※【誤差の計測結果】に余裕を持たせた値
+	template<template<typename> class ARITH>
+	inline double maxUlp(const opeEnum ope)
+	{
+		static const double max_ulp[OPE_NUM] = { 0.6, 0.6, 2., 2.5 };
+		return ope >= 0 && ope < OPE_NUM ? max_ulp[ope] : 0.;
+	}
+#ifdef GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION
+	template<>
+	inline double maxUlp<fastestA>(const opeEnum ope)
+	{
+		static const double max_ulp[OPE_NUM] = { 6000., 5000., 3300., 5000. };
+		return ope >= 0 && ope < OPE_NUM ? max_ulp[ope] : 0.;
+	}
+	template<>
+	inline double maxUlp<fastA>(const opeEnum ope)
+	{
+		static const double max_ulp[OPE_NUM] = { 4.5, 5.5, 3., 6. };
+		return ope >= 0 && ope < OPE_NUM ? max_ulp[ope] : 0.;
+	}
+	template<>
+	inline double maxUlp<semiA>(const opeEnum ope)
+	{
+		static const double max_ulp[OPE_NUM] = { 3.5, 4.5, 2.5, 4.5 };
+		return ope >= 0 && ope < OPE_NUM ? max_ulp[ope] : 0.;
+	}
+#endif//GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION
+}//namespace fastArithDiag
+
+namespace _private
+{
+	//----------------------------------------
+	//高速算術診断用：補助処理
+
+	//ビットパターンを浮動小数点数に変換
+	inline float fastArithDiagBitsToFloat(const std::uint32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+	//入力値から 0.0～1.0 の値を作る
+	inline float fastArithDiagRand(const float x, const std::uint32_t salt)
+	{
+		std::uint32_t hash;
+		std::memcpy(&hash, &x, sizeof(hash));
+		hash ^= salt * 0x9e3779b9u;
+		hash ^= hash >> 16;
+		hash *= 0x85ebca6bu;
+		hash ^= hash >> 13;
+		hash *= 0xc2b2ae35u;
+		hash ^= hash >> 16;
+		return static_cast<float>(hash >> 8) * (1.f / 16777216.f);
+	}
+	//参照値の ulp（単精度）
+	inline double fastArithDiagUlp(const double ref)
+	{
+		const float ref_f = static_cast<float>(ref < 0. ? -ref : ref);
+		std::uint32_t bits;
+		std::memcpy(&bits, &ref_f, sizeof(bits));
+		const int exp = static_cast<int>(bits >> 23) - 127 - 23;
+		return std::ldexp(1., exp < -149 ? -149 : exp);
+	}
+	//3次元ベクトルの作成
+	//※float[3] の配列を経由せず、16バイトに拡張した領域から __m128 型で渡す
+	template<template<typename> class ARITH>
+	inline ARITH<float[3]> fastArithDiagVec3(const float x, const float y, const float z)
+	{
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		alignas(16) const float vec[4] = { x, y, z, 0.f };
+		return ARITH<float[3]>(_mm_load_ps(vec));
+	#else//GASHA_FAST_ARITH_USE_SSE
+		const float vec[3] = { x, y, z };
+		return ARITH<float[3]>(vec);
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	}
+
+	//----------------------------------------
+	//高速算術診断用：除算（a / x）
+	template<>
+	struct fastArithDiagOpe<fastArithDiag::DIV>
+	{
+		static const std::uint32_t BEGIN = (127u - 125u) << 23;//走査範囲の開始（ビットパターン）
+		static const std::uint32_t END = (127u + 125u) << 23;//走査範囲の終了（ビットパターン、含まない）
+		static inline void input(fastArithDiagBlock& block, const std::size_t index, const float x)
+		{
+			block.m_in[0][index] = 1.f + fastArithDiagRand(x, 0);
+			block.m_in[1][index] = x;
+		}
+		static inline double error(const fastArithDiagBlock& block, const std::size_t index)
+		{
+			const double ref = static_cast<double>(block.m_in[0][index]) / static_cast<double>(block.m_in[1][index]);
+			return std::fabs(static_cast<double>(block.m_out[0][index]) - ref) / fastArithDiagUlp(ref);
+		}
+		template<template<typename> class ARITH>
+		static void calc(fastArithDiagBlock& block, const std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+				block.m_out[0][i] = ARITH<float>(block.m_in[0][i]) / ARITH<float>(block.m_in[1][i]);
+		}
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		template<template<typename> class ARITH>
+		static void calc_m128(fastArithDiagBlock& block, const std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; i += 4)
+				_mm_storeu_ps(block.m_out[0] + i, ARITH<__m128>(_mm_loadu_ps(block.m_in[0] + i)) / ARITH<__m128>(_mm_loadu_ps(block.m_in[1] + i)));
+		}
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		template<template<typename> class ARITH>
+		static void calc_m256(fastArithDiagBlock& block, const std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; i += 8)
+				_mm256_storeu_ps(block.m_out[0] + i, ARITH<__m256>(_mm256_loadu_ps(block.m_in[0] + i)) / ARITH<__m256>(_mm256_loadu_ps(block.m_in[1] + i)));
+		}
+	#endif//GASHA_FAST_ARITH_USE_AVX
+	};
+
+	//----------------------------------------
+	//高速算術診断用：平方根（sqrt(x)）
+	template<>
+	struct fastArithDiagOpe<fastArithDiag::SQRT>
+	{
+		static const std::uint32_t BEGIN = 1u << 23;//走査範囲の開始（ビットパターン）
+		static const std::uint32_t END = 255u << 23;//走査範囲の終了（ビットパターン、含まない）
+		static inline void input(fastArithDiagBlock& block, const std::size_t index, const float x)
+		{
+			block.m_in[0][index] = x;
+		}
+		static inline double error(const fastArithDiagBlock& block, const std::size_t index)
+		{
+			const double ref = std::sqrt(static_cast<double>(block.m_in[0][index]));
+			return std::fabs(static_cast<double>(block.m_out[0][index]) - ref) / fastArithDiagUlp(ref);
+		}
+		template<template<typename> class ARITH>
+		static void calc(fastArithDiagBlock& block, const std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+				block.m_out[0][i] = GASHA_ sqr(ARITH<float>(block.m_in[0][i]));
+		}
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		template<template<typename> class ARITH>
+		static void calc_m128(fastArithDiagBlock& block, const std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; i += 4)
+				_mm_storeu_ps(block.m_out[0] + i, GASHA_ sqr(ARITH<__m128>(_mm_loadu_ps(block.m_in[0] + i))));
+		}
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		template<template<typename> class ARITH>
+		static void calc_m256(fastArithDiagBlock& block, const std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; i += 8)
+				_mm256_storeu_ps(block.m_out[0] + i, GASHA_ sqr(ARITH<__m256>(_mm256_loadu_ps(block.m_in[0] + i))));
+		}
+	#endif//GASHA_FAST_ARITH_USE_AVX
+	};
+
+	//----------------------------------------
+	//高速算術診断用：正規化（(x, x*r1, x*r2) の正規化）
+	template<>
+	struct fastArithDiagOpe<fastArithDiag::NORMALIZE>
+	{
+		static const std::uint32_t BEGIN = (127u - 60u) << 23;//走査範囲の開始（ビットパターン）
+		static const std::uint32_t END = (127u + 60u) << 23;//走査範囲の終了（ビットパターン、含まない）
+		static inline void input(fastArithDiagBlock& block, const std::size_t index, const float x)
+		{
+			block.m_in[0][index] = x;
+			block.m_in[1][index] = x * (fastArithDiagRand(x, 1) * 2.f - 1.f);
+			block.m_in[2][index] = x * (fastArithDiagRand(x, 2) * 2.f - 1.f);
+		}
+		static inline double error(const fastArithDiagBlock& block, const std::size_t index)
+		{
+			const double x = block.m_in[0][index];
+			const double y = block.m_in[1][index];
+			const double z = block.m_in[2][index];
+			const double norm = std::sqrt(x * x + y * y + z * z);
+			const double error_x = std::fabs(static_cast<double>(block.m_out[0][index]) - x / norm);
+			const double error_y = std::fabs(static_cast<double>(block.m_out[1][index]) - y / norm);
+			const double error_z = std::fabs(static_cast<double>(block.m_out[2][index]) - z / norm);
+			const double error_max = error_x > error_y ? (error_x > error_z ? error_x : error_z) : (error_y > error_z ? error_y : error_z);
+			return error_max / fastArithDiagUlp(1.);
+		}
+		template<template<typename> class ARITH>
+		static void calc(fastArithDiagBlock& block, const std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const ARITH<float[3]> result = GASHA_ normalize(fastArithDiagVec3<ARITH>(block.m_in[0][i], block.m_in[1][i], block.m_in[2][i]));
+				block.m_out[0][i] = result[0];
+				block.m_out[1][i] = result[1];
+				block.m_out[2][i] = result[2];
+			}
+		}
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		template<template<typename> class ARITH>
+		static void calc_m128(fastArithDiagBlock& block, const std::size_t n)
+		{
+			typedef fastBatchOpe<ARITH> ope;
+			for (std::size_t i = 0; i < n; i += 4)
+			{
+				const __m128 x_m128 = _mm_loadu_ps(block.m_in[0] + i);
+				const __m128 y_m128 = _mm_loadu_ps(block.m_in[1] + i);
+				const __m128 z_m128 = _mm_loadu_ps(block.m_in[2] + i);
+				const __m128 rcp_norm_m128 = ope::rsqrt(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x_m128, x_m128), _mm_mul_ps(y_m128, y_m128)), _mm_mul_ps(z_m128, z_m128)));
+				_mm_storeu_ps(block.m_out[0] + i, _mm_mul_ps(x_m128, rcp_norm_m128));
+				_mm_storeu_ps(block.m_out[1] + i, _mm_mul_ps(y_m128, rcp_norm_m128));
+				_mm_storeu_ps(block.m_out[2] + i, _mm_mul_ps(z_m128, rcp_norm_m128));
+			}
+		}
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		template<template<typename> class ARITH>
+		static void calc_m256(fastArithDiagBlock& block, const std::size_t n)
+		{
+			typedef fastBatchOpe<ARITH> ope;
+			for (std::size_t i = 0; i < n; i += 8)
+			{
+				const __m256 x_m256 = _mm256_loadu_ps(block.m_in[0] + i);
+				const __m256 y_m256 = _mm256_loadu_ps(block.m_in[1] + i);
+				const __m256 z_m256 = _mm256_loadu_ps(block.m_in[2] + i);
+				const __m256 rcp_norm_m256 = ope::rsqrt(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x_m256, x_m256), _mm256_mul_ps(y_m256, y_m256)), _mm256_mul_ps(z_m256, z_m256)));
+				_mm256_storeu_ps(block.m_out[0] + i, _mm256_mul_ps(x_m256, rcp_norm_m256));
+				_mm256_storeu_ps(block.m_out[1] + i, _mm256_mul_ps(y_m256, rcp_norm_m256));
+				_mm256_storeu_ps(block.m_out[2] + i, _mm256_mul_ps(z_m256, rcp_norm_m256));
+			}
+		}
+	#endif//GASHA_FAST_ARITH_USE_AVX
+	};
+
+	//----------------------------------------
+	//高速算術診断用：長さ（(x, x*r1, x*r2) と (-x*r3, -x*r4, -x*r5) の間の長さ）
+	//※差の計算で桁落ちしないように、二点の各成分の符号を逆にする
+	template<>
+	struct fastArithDiagOpe<fastArithDiag::LENGTH>
+	{
+		static const std::uint32_t BEGIN = (127u - 60u) << 23;//走査範囲の開始（ビットパターン）
+		static const std::uint32_t END = (127u + 60u) << 23;//走査範囲の終了（ビットパターン、含まない）
+		static inline void input(fastArithDiagBlock& block, const std::size_t index, const float x)
+		{
+			block.m_in[0][index] = x;
+			block.m_in[1][index] = x * fastArithDiagRand(x, 1);
+			block.m_in[2][index] = x * fastArithDiagRand(x, 2);
+			block.m_in[3][index] = -x * fastArithDiagRand(x, 3);
+			block.m_in[4][index] = -x * fastArithDiagRand(x, 4);
+			block.m_in[5][index] = -x * fastArithDiagRand(x, 5);
+		}
+		static inline double error(const fastArithDiagBlock& block, const std::size_t index)
+		{
+			const double x = static_cast<double>(block.m_in[0][index]) - static_cast<double>(block.m_in[3][index]);
+			const double y = static_cast<double>(block.m_in[1][index]) - static_cast<double>(block.m_in[4][index]);
+			const double z = static_cast<double>(block.m_in[2][index]) - static_cast<double>(block.m_in[5][index]);
+			const double ref = std::sqrt(x * x + y * y + z * z);
+			return std::fabs(static_cast<double>(block.m_out[0][index]) - ref) / fastArithDiagUlp(ref);
+		}
+		template<template<typename> class ARITH>
+		static void calc(fastArithDiagBlock& block, const std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				block.m_out[0][i] = GASHA_ length(fastArithDiagVec3<ARITH>(block.m_in[0][i], block.m_in[1][i], block.m_in[2][i]), fastArithDiagVec3<ARITH>(block.m_in[3][i], block.m_in[4][i], block.m_in[5][i]));
+			}
+		}
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		template<template<typename> class ARITH>
+		static void calc_m128(fastArithDiagBlock& block, const std::size_t n)
+		{
+			typedef fastBatchOpe<ARITH> ope;
+			for (std::size_t i = 0; i < n; i += 4)
+			{
+				const __m128 x_m128 = _mm_sub_ps(_mm_loadu_ps(block.m_in[0] + i), _mm_loadu_ps(block.m_in[3] + i));
+				const __m128 y_m128 = _mm_sub_ps(_mm_loadu_ps(block.m_in[1] + i), _mm_loadu_ps(block.m_in[4] + i));
+				const __m128 z_m128 = _mm_sub_ps(_mm_loadu_ps(block.m_in[2] + i), _mm_loadu_ps(block.m_in[5] + i));
+				_mm_storeu_ps(block.m_out[0] + i, ope::sqrt(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x_m128, x_m128), _mm_mul_ps(y_m128, y_m128)), _mm_mul_ps(z_m128, z_m128))));
+			}
+		}
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		template<template<typename> class ARITH>
+		static void calc_m256(fastArithDiagBlock& block, const std::size_t n)
+		{
+			typedef fastBatchOpe<ARITH> ope;
+			for (std::size_t i = 0; i < n; i += 8)
+			{
+				const __m256 x_m256 = _mm256_sub_ps(_mm256_loadu_ps(block.m_in[0] + i), _mm256_loadu_ps(block.m_in[3] + i));
+				const __m256 y_m256 = _mm256_sub_ps(_mm256_loadu_ps(block.m_in[1] + i), _mm256_loadu_ps(block.m_in[4] + i));
+				const __m256 z_m256 = _mm256_sub_ps(_mm256_loadu_ps(block.m_in[2] + i), _mm256_loadu_ps(block.m_in[5] + i));
+				_mm256_storeu_ps(block.m_out[0] + i, ope::sqrt(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x_m256, x_m256), _mm256_mul_ps(y_m256, y_m256)), _mm256_mul_ps(z_m256, z_m256))));
+			}
+		}
+	#endif//GASHA_FAST_ARITH_USE_AVX
+	};
+
+	//----------------------------------------
+	//高速算術診断用：計測（共通処理）
+	//※OPE ... 演算ごとの処理（入力値の作成と誤差の算出）
+	//※calc ... 演算処理
+	template<class OPE>
+	fastArithDiag::result fastArithDiagMeasure(fastArithDiagCalc calc, const std::uint32_t step)
+	{
+		typedef OPE ope;
+		typedef fastArithDiagCalc calc_type;
+		fastArithDiag::result result = { false, 0., 0., 0.f, 0, 0. };
+		if (!calc)
+			return result;
+		result.m_isAvailable = true;
+		static const std::size_t SIZE = fastArithDiagBlock::SIZE;
+		fastArithDiagBlock block;
+
+		//誤差の計測
+		//※範囲内の値を走査し、ブロック単位で演算する（ブロックの端数は直前の値で埋める）
+		const std::uint32_t step_ = step > 0 ? step : 1;
+		double sum_ulp = 0.;
+		std::uint64_t bits = ope::BEGIN;
+		while (bits < ope::END)
+		{
+			std::size_t n = 0;
+			for (; n < SIZE && bits < ope::END; ++n, bits += step_)
+			{
+				const float x = fastArithDiagBitsToFloat(static_cast<std::uint32_t>(bits));
+				block.m_x[n] = x;
+				ope::input(block, n, x);
+			}
+			for (std::size_t i = n; i < SIZE; ++i)
+				ope::input(block, i, block.m_x[n - 1]);
+			calc(block, SIZE);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const double ulp = ope::error(block, i);
+				sum_ulp += ulp;
+				if (ulp > result.m_maxUlp || ulp != ulp)
+				{
+					result.m_maxUlp = ulp;
+					result.m_worstInput = block.m_x[i];
+				}
+			}
+			result.m_count += n;
+		}
+		result.m_avgUlp = result.m_count > 0 ? sum_ulp / static_cast<double>(result.m_count) : 0.;
+
+		//処理時間の計測
+		//※範囲内から均等に選んだ値のブロックを繰り返し演算する
+		static const int REPEAT = 4096;
+		for (std::size_t i = 0; i < SIZE; ++i)
+		{
+			const std::uint64_t sample_bits = ope::BEGIN + (static_cast<std::uint64_t>(ope::END - ope::BEGIN) * i) / SIZE;
+			ope::input(block, i, fastArithDiagBitsToFloat(static_cast<std::uint32_t>(sample_bits)));
+		}
+		calc_type volatile calc_opaque = calc;//最適化で繰り返しが省略されないように、関数ポインタを volatile 経由で呼び出す
+		calc_opaque(block, SIZE);//ウォームアップ
+		GASHA_ elapsedTime elapsed_time;
+		for (int i = 0; i < REPEAT; ++i)
+			calc_opaque(block, SIZE);
+		result.m_nsPerOp = static_cast<double>(elapsed_time.now()) * 1000000000. / static_cast<double>(SIZE * REPEAT);
+		return result;
+	}
+
+	//----------------------------------------
+	//高速算術診断用：計測
+	template<template<typename> class ARITH, int DIAG_OPE>
+	fastArithDiag::result fastArithDiagRun(const fastArithDiag::typeEnum type, const std::uint32_t step)
+	{
+		typedef fastArithDiagOpe<DIAG_OPE> ope;
+		fastArithDiagCalc calc = nullptr;
+		switch (type)
+		{
+		case fastArithDiag::SCALAR: calc = &ope::template calc<ARITH>; break;
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		case fastArithDiag::M128: calc = &ope::template calc_m128<ARITH>; break;
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		case fastArithDiag::M256: calc = &ope::template calc_m256<ARITH>; break;
+	#endif//GASHA_FAST_ARITH_USE_AVX
+		default: break;
+		}
+		return fastArithDiagMeasure<ope>(calc, step);
+	}
+
+	//----------------------------------------
+	//高速算術診断用：演算クラスごとの計測
+	template<template<typename> class ARITH>
+	inline bool fastArithDiagReport(char* message, const std::size_t max_size, std::size_t& message_len, const std::uint32_t step)
+	{
+		bool is_ok = true;
+		for (int diag_ope = 0; diag_ope < fastArithDiag::OPE_NUM; ++diag_ope)
+		{
+			for (int diag_type = 0; diag_type < fastArithDiag::TYPE_NUM; ++diag_type)
+			{
+				const fastArithDiag::opeEnum ope = static_cast<fastArithDiag::opeEnum>(diag_ope);
+				const fastArithDiag::typeEnum type = static_cast<fastArithDiag::typeEnum>(diag_type);
+				const fastArithDiag::result result = GASHA_ fastArithDiagnosticTest<ARITH>(ope, type, step);
+				if (!result.m_isAvailable)
+					continue;
+				const bool is_passed = result.m_maxUlp <= fastArithDiag::maxUlp<ARITH>(ope);
+				if (!is_passed)
+					is_ok = false;
+				GASHA_ spprintf(message, max_size, message_len, "%-8s %-9s %-6s %10.2lf %10.3lf %9.3lf   %-15.8g %s\n", fastArithDiag::arithName<ARITH>(), fastArithDiag::opeName(ope), fastArithDiag::typeName(type), result.m_maxUlp, result.m_avgUlp, result.m_nsPerOp, static_cast<double>(result.m_worstInput), is_passed ? "[OK]" : "[NG]");
+			}
+		}
+		return is_ok;
+	}
+}//namespace _private
+
+//----------------------------------------
+//演算の誤差と処理時間を計測
+template<template<typename> class ARITH>
+inline fastArithDiag::result fastArithDiagnosticTest(const fastArithDiag::opeEnum ope, const fastArithDiag::typeEnum type, const std::uint32_t step)
+{
+	switch (ope)
+	{
+	case fastArithDiag::DIV: return _private::fastArithDiagRun<ARITH, fastArithDiag::DIV>(type, step);
+	case fastArithDiag::SQRT: return _private::fastArithDiagRun<ARITH, fastArithDiag::SQRT>(type, step);
+	case fastArithDiag::NORMALIZE: return _private::fastArithDiagRun<ARITH, fastArithDiag::NORMALIZE>(type, step);
+	case fastArithDiag::LENGTH: return _private::fastArithDiagRun<ARITH, fastArithDiag::LENGTH>(type, step);
+	default: break;
+	}
+	const fastArithDiag::result result = { false, 0., 0., 0.f, 0, 0. };
+	return result;
+}
+
+//----------------------------------------
+//全ての演算クラスの計測結果を表にする
+inline bool fastArithDiagnosticReport(char* message, const std::size_t max_size, std::size_t& message_len, const std::uint32_t step)
+{
+	message_len = 0;
+	message[0] = '\0';
+	GASHA_ spprintf(message, max_size, message_len, "------------------------------------------------------------------------------\n");
+	GASHA_ spprintf(message, max_size, message_len, "[ Fast arithmetic diagnostic test (step=%u) ]\n", static_cast<unsigned int>(step));
+	GASHA_ spprintf(message, max_size, message_len, "\n");
+	GASHA_ spprintf(message, max_size, message_len, "arith    ope       type      max(ulp)   avg(ulp)   ns/op   worst input\n");
+	bool is_ok = true;
+	if (!_private::fastArithDiagReport<fastestA>(message, max_size, message_len, step))
+		is_ok = false;
+	if (!_private::fastArithDiagReport<fastA>(message, max_size, message_len, step))
+		is_ok = false;
+	if (!_private::fastArithDiagReport<semiA>(message, max_size, message_len, step))
+		is_ok = false;
+	if (!_private::fastArithDiagReport<sseA>(message, max_size, message_len, step))
+		is_ok = false;
+	if (!_private::fastArithDiagReport<normA>(message, max_size, message_len, step))
+		is_ok = false;
+	GASHA_ spprintf(message, max_size, message_len, "------------------------------------------------------------------------------\n");
+	return is_ok;
+}
+
+//--------------------------------------------------------------------------------
+//高速超越関数診断
+
+namespace fastTransDiag
+{
+	//----------------------------------------
+	//名前
+
+	//演算の名前
+	inline const char* opeName(const opeEnum ope)
+	{
+		static const char* names[OPE_NUM] = { "sin", "cos", "exp", "log", "atan2", "pow" };
+		return ope >= 0 && ope < OPE_NUM ? names[ope] : "?";
+	}
+
+	//----------------------------------------
+	//最大誤差の上限値（ulp）
+	//※【誤差の計測結果】に余裕を持たせた値
+	template<template<typename> class ARITH>
+	inline double maxUlp(const opeEnum ope)
+	{
+		return ope >= 0 && ope < OPE_NUM ? 1. : 0.;
+	}
+	template<>
+	inline double maxUlp<fastestA>(const opeEnum ope)
+	{
+		static const double max_ulp[OPE_NUM] = { 4096., 4096., 2048., 2048., 6144., 6144. };
+		return ope >= 0 && ope < OPE_NUM ? max_ulp[ope] : 0.;
+	}
+	template<>
+	inline double maxUlp<fastA>(const opeEnum ope)
+	{
+		static const double max_ulp[OPE_NUM] = { 16., 16., 4., 6., 16., 64. };
+		return ope >= 0 && ope < OPE_NUM ? max_ulp[ope] : 0.;
+	}
+}//namespace fastTransDiag
+
+namespace _private
+{
+	//----------------------------------------
+	//高速超越関数診断用：補助処理
+
+	//誤差（ulp）
+	//※min_ulp ... ulp の下限（絶対誤差で評価する場合に指定）
+	inline double fastTransDiagError(const float value, const double ref, const double min_ulp)
+	{
+		const double ulp = fastArithDiagUlp(ref);
+		return std::fabs(static_cast<double>(value) - ref) / (ulp > min_ulp ? ulp : min_ulp);
+	}
+	//入力値に符号を付ける
+	inline float fastTransDiagSign(const float x, const std::uint32_t salt)
+	{
+		return fastArithDiagRand(x, salt) < 0.5f ? -x : x;
+	}
+
+	//----------------------------------------
+	//高速超越関数診断用：正弦（sin(x)）
+	template<int PRECISION>
+	struct fastTransDiagOpe<fastTransDiag::SIN, PRECISION>
+	{
+		static const std::uint32_t BEGIN = (127u - 20u) << 23;//走査範囲の開始（ビットパターン）
+		static const std::uint32_t END = (127u + 13u) << 23;//走査範囲の終了（ビットパターン、含まない）
+		static inline void input(fastArithDiagBlock& block, const std::size_t index, const float x)
+		{
+			block.m_in[0][index] = fastTransDiagSign(x, 0);
+			block.m_in[1][index] = 0.f;
+		}
+		static inline double error(const fastArithDiagBlock& block, const std::size_t index)
+		{
+			return fastTransDiagError(block.m_out[0][index], std::sin(static_cast<double>(block.m_in[0][index])), PRECISION < 2 ? fastArithDiagUlp(1.) : 0.);
+		}
+		template<template<typename> class ARITH, typename T>
+		static inline T calc(const T x, const T){ return GASHA_ fastSin<ARITH>(x); }
+	};
+
+	//----------------------------------------
+	//高速超越関数診断用：余弦（cos(x)）
+	template<int PRECISION>
+	struct fastTransDiagOpe<fastTransDiag::COS, PRECISION>
+	{
+		static const std::uint32_t BEGIN = (127u - 20u) << 23;//走査範囲の開始（ビットパターン）
+		static const std::uint32_t END = (127u + 13u) << 23;//走査範囲の終了（ビットパターン、含まない）
+		static inline void input(fastArithDiagBlock& block, const std::size_t index, const float x)
+		{
+			block.m_in[0][index] = fastTransDiagSign(x, 0);
+			block.m_in[1][index] = 0.f;
+		}
+		static inline double error(const fastArithDiagBlock& block, const std::size_t index)
+		{
+			return fastTransDiagError(block.m_out[0][index], std::cos(static_cast<double>(block.m_in[0][index])), PRECISION < 2 ? fastArithDiagUlp(1.) : 0.);
+		}
+		template<template<typename> class ARITH, typename T>
+		static inline T calc(const T x, const T){ return GASHA_ fastCos<ARITH>(x); }
+	};
+
+	//----------------------------------------
+	//高速超越関数診断用：指数（e^x）
+	template<int PRECISION>
+	struct fastTransDiagOpe<fastTransDiag::EXP, PRECISION>
+	{
+		static const std::uint32_t BEGIN = (127u - 20u) << 23;//走査範囲の開始（ビットパターン）
+		static const std::uint32_t END = 0x42ae0000u;//走査範囲の終了（ビットパターン、含まない） ※87.0
+		static inline void input(fastArithDiagBlock& block, const std::size_t index, const float x)
+		{
+			block.m_in[0][index] = fastTransDiagSign(x, 0);
+			block.m_in[1][index] = 0.f;
+		}
+		static inline double error(const fastArithDiagBlock& block, const std::size_t index)
+		{
+			return fastTransDiagError(block.m_out[0][index], std::exp(static_cast<double>(block.m_in[0][index])), 0.);
+		}
+		template<template<typename> class ARITH, typename T>
+		static inline T calc(const T x, const T){ return GASHA_ fastExp<ARITH>(x); }
+	};
+
+	//----------------------------------------
+	//高速超越関数診断用：自然対数（log(x)）
+	template<int PRECISION>
+	struct fastTransDiagOpe<fastTransDiag::LOG, PRECISION>
+	{
+		static const std::uint32_t BEGIN = 1u << 23;//走査範囲の開始（ビットパターン）
+		static const std::uint32_t END = 255u << 23;//走査範囲の終了（ビットパターン、含まない）
+		static inline void input(fastArithDiagBlock& block, const std::size_t index, const float x)
+		{
+			block.m_in[0][index] = x;
+			block.m_in[1][index] = 0.f;
+		}
+		static inline double error(const fastArithDiagBlock& block, const std::size_t index)
+		{
+			return fastTransDiagError(block.m_out[0][index], std::log(static_cast<double>(block.m_in[0][index])), 0.);
+		}
+		template<template<typename> class ARITH, typename T>
+		static inline T calc(const T x, const T){ return GASHA_ fastLog<ARITH>(x); }
+	};
+
+	//----------------------------------------
+	//高速超越関数診断用：逆正接（atan2(y, x)）
+	template<int PRECISION>
+	struct fastTransDiagOpe<fastTransDiag::ATAN2, PRECISION>
+	{
+		static const std::uint32_t BEGIN = (127u - 60u) << 23;//走査範囲の開始（ビットパターン）
+		static const std::uint32_t END = (127u + 60u) << 23;//走査範囲の終了（ビットパターン、含まない）
+		static inline void input(fastArithDiagBlock& block, const std::size_t index, const float y)
+		{
+			block.m_in[0][index] = fastTransDiagSign(y, 0);
+			block.m_in[1][index] = y * (fastArithDiagRand(y, 1) * 8.f - 4.f);
+		}
+		static inline double error(const fastArithDiagBlock& block, const std::size_t index)
+		{
+			return fastTransDiagError(block.m_out[0][index], std::atan2(static_cast<double>(block.m_in[0][index]), static_cast<double>(block.m_in[1][index])), 0.);
+		}
+		template<template<typename> class ARITH, typename T>
+		static inline T calc(const T y, const T x){ return GASHA_ fastAtan2<ARITH>(y, x); }
+	};
+
+	//----------------------------------------
+	//高速超越関数診断用：べき乗（x^y）
+	template<int PRECISION>
+	struct fastTransDiagOpe<fastTransDiag::POW, PRECISION>
+	{
+		static const std::uint32_t BEGIN = (127u - 4u) << 23;//走査範囲の開始（ビットパターン）
+		static const std::uint32_t END = (127u + 4u) << 23;//走査範囲の終了（ビットパターン、含まない）
+		static inline void input(fastArithDiagBlock& block, const std::size_t index, const float x)
+		{
+			block.m_in[0][index] = x;
+			block.m_in[1][index] = fastArithDiagRand(x, 1) * 16.f - 8.f;
+		}
+		static inline double error(const fastArithDiagBlock& block, const std::size_t index)
+		{
+			return fastTransDiagError(block.m_out[0][index], std::pow(static_cast<double>(block.m_in[0][index]), static_cast<double>(block.m_in[1][index])), 0.);
+		}
+		template<template<typename> class ARITH, typename T>
+		static inline T calc(const T x, const T y){ return GASHA_ fastPow<ARITH>(x, y); }
+	};
+
+	//----------------------------------------
+	//高速超越関数診断用：演算処理
+	//※m_in[0], m_in[1] を引数に演算し、m_out[0] に格納する
+	template<template<typename> class ARITH, class OPE>
+	void fastTransDiagCalc(fastArithDiagBlock& block, const std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			block.m_out[0][i] = OPE::template calc<ARITH, float>(block.m_in[0][i], block.m_in[1][i]);
+	}
+#ifdef GASHA_FAST_ARITH_USE_SSE2
+	template<template<typename> class ARITH, class OPE>
+	void fastTransDiagCalc_m128(fastArithDiagBlock& block, const std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; i += 4)
+			_mm_storeu_ps(block.m_out[0] + i, OPE::template calc<ARITH, __m128>(_mm_loadu_ps(block.m_in[0] + i), _mm_loadu_ps(block.m_in[1] + i)));
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE2
+#ifdef GASHA_FAST_ARITH_USE_AVX
+	template<template<typename> class ARITH, class OPE>
+	void fastTransDiagCalc_m256(fastArithDiagBlock& block, const std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; i += 8)
+			_mm256_storeu_ps(block.m_out[0] + i, OPE::template calc<ARITH, __m256>(_mm256_loadu_ps(block.m_in[0] + i), _mm256_loadu_ps(block.m_in[1] + i)));
+	}
+#endif//GASHA_FAST_ARITH_USE_AVX
+
+	//----------------------------------------
+	//高速超越関数診断用：計測
+	template<template<typename> class ARITH, int DIAG_OPE>
+	fastArithDiag::result fastTransDiagRun(const fastArithDiag::typeEnum type, const std::uint32_t step)
+	{
+		typedef fastTransDiagOpe<DIAG_OPE, fastTransPrecision<ARITH>::value> ope;
+		fastArithDiagCalc calc = nullptr;
+		switch (type)
+		{
+		case fastArithDiag::SCALAR: calc = &fastTransDiagCalc<ARITH, ope>; break;
+	#ifdef GASHA_FAST_ARITH_USE_SSE2
+		case fastArithDiag::M128: calc = &fastTransDiagCalc_m128<ARITH, ope>; break;
+	#endif//GASHA_FAST_ARITH_USE_SSE2
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		case fastArithDiag::M256: calc = &fastTransDiagCalc_m256<ARITH, ope>; break;
+	#endif//GASHA_FAST_ARITH_USE_AVX
+		default: break;
+		}
+		return fastArithDiagMeasure<ope>(calc, step);
+	}
+
+	//----------------------------------------
+	//高速超越関数診断用：演算クラスごとの計測
+	template<template<typename> class ARITH>
+	inline bool fastTransDiagReport(char* message, const std::size_t max_size, std::size_t& message_len, const std::uint32_t step)
+	{
+		bool is_ok = true;
+		for (int diag_ope = 0; diag_ope < fastTransDiag::OPE_NUM; ++diag_ope)
+		{
+			for (int diag_type = 0; diag_type < fastArithDiag::TYPE_NUM; ++diag_type)
+			{
+				const fastTransDiag::opeEnum ope = static_cast<fastTransDiag::opeEnum>(diag_ope);
+				const fastArithDiag::typeEnum type = static_cast<fastArithDiag::typeEnum>(diag_type);
+				const fastArithDiag::result result = GASHA_ fastTransDiagnosticTest<ARITH>(ope, type, step);
+				if (!result.m_isAvailable)
+					continue;
+				const bool is_passed = result.m_maxUlp <= fastTransDiag::maxUlp<ARITH>(ope);
+				if (!is_passed)
+					is_ok = false;
+				GASHA_ spprintf(message, max_size, message_len, "%-8s %-5s %-6s %10.2lf %10.3lf %9.3lf   %-15.8g %s\n", fastArithDiag::arithName<ARITH>(), fastTransDiag::opeName(ope), fastArithDiag::typeName(type), result.m_maxUlp, result.m_avgUlp, result.m_nsPerOp, static_cast<double>(result.m_worstInput), is_passed ? "[OK]" : "[NG]");
+			}
+		}
+		return is_ok;
+	}
+}//namespace _private
+
+//----------------------------------------
+//高速超越関数の誤差と処理時間を計測
+template<template<typename> class ARITH>
+inline fastArithDiag::result fastTransDiagnosticTest(const fastTransDiag::opeEnum ope, const fastArithDiag::typeEnum type, const std::uint32_t step)
+{
+	switch (ope)
+	{
+	case fastTransDiag::SIN: return _private::fastTransDiagRun<ARITH, fastTransDiag::SIN>(type, step);
+	case fastTransDiag::COS: return _private::fastTransDiagRun<ARITH, fastTransDiag::COS>(type, step);
+	case fastTransDiag::EXP: return _private::fastTransDiagRun<ARITH, fastTransDiag::EXP>(type, step);
+	case fastTransDiag::LOG: return _private::fastTransDiagRun<ARITH, fastTransDiag::LOG>(type, step);
+	case fastTransDiag::ATAN2: return _private::fastTransDiagRun<ARITH, fastTransDiag::ATAN2>(type, step);
+	case fastTransDiag::POW: return _private::fastTransDiagRun<ARITH, fastTransDiag::POW>(type, step);
+	default: break;
+	}
+	const fastArithDiag::result result = { false, 0., 0., 0.f, 0, 0. };
+	return result;
+}
+
+//----------------------------------------
+//全ての演算クラスの計測結果を表にする
+inline bool fastTransDiagnosticReport(char* message, const std::size_t max_size, std::size_t& message_len, const std::uint32_t step)
+{
+	message_len = 0;
+	message[0] = '\0';
+	GASHA_ spprintf(message, max_size, message_len, "------------------------------------------------------------------------------\n");
+	GASHA_ spprintf(message, max_size, message_len, "[ Fast transcendental function diagnostic test (step=%u) ]\n", static_cast<unsigned int>(step));
+	GASHA_ spprintf(message, max_size, message_len, "\n");
+	GASHA_ spprintf(message, max_size, message_len, "arith    ope   type      max(ulp)   avg(ulp)   ns/op   worst input\n");
+	bool is_ok = true;
+	if (!_private::fastTransDiagReport<fastestA>(message, max_size, message_len, step))
+		is_ok = false;
+	if (!_private::fastTransDiagReport<fastA>(message, max_size, message_len, step))
+		is_ok = false;
+	if (!_private::fastTransDiagReport<semiA>(message, max_size, message_len, step))
+		is_ok = false;
+	if (!_private::fastTransDiagReport<sseA>(message, max_size, message_len, step))
+		is_ok = false;
+	if (!_private::fastTransDiagReport<normA>(message, max_size, message_len, step))
+		is_ok = false;
+	GASHA_ spprintf(message, max_size, message_len, "------------------------------------------------------------------------------\n");
+	return is_ok;
+}
+
+//--------------------------------------------------------------------------------
+//高速行列演算診断
+
+namespace fastMatrixDiag
+{
+	//----------------------------------------
+	//名前
+
+	//演算の名前
+	inline const char* opeName(const opeEnum ope)
+	{
+		static const char* names[OPE_NUM] = { "transpose", "inverse", "mul_mat", "mul_vec", "mul_batch", "transform" };
+		return ope >= 0 && ope < OPE_NUM ? names[ope] : "?";
+	}
+
+	//----------------------------------------
+	//最大誤差の上限値（FLT_EPSILON 単位）
+	//※逆行列は、逆数の近似値の精度に余裕を持たせた値
+	template<template<typename> class ARITH>
+	inline double maxEps(const opeEnum ope)
+	{
+		static const double max_eps[OPE_NUM] = { 4., 8., 4., 4., 4., 4. };
+		return ope >= 0 && ope < OPE_NUM ? max_eps[ope] : 0.;
+	}
+#ifdef GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION
+	template<>
+	inline double maxEps<fastestA>(const opeEnum ope)
+	{
+		static const double max_eps[OPE_NUM] = { 4., 4096., 4., 4., 4., 4. };
+		return ope >= 0 && ope < OPE_NUM ? max_eps[ope] : 0.;
+	}
+#endif//GASHA_FAST_ARITH_USE_RECIPROCAL_FOR_DIVISION
+}//namespace fastMatrixDiag
+
+namespace _private
+{
+	//----------------------------------------
+	//高速行列演算診断用：補助処理
+
+	//入力を作成
+	//※行列は、対角成分を 3.0～5.0、それ以外を -1.0～1.0 にする（対角優位）
+	inline void fastMatrixDiagInput(fastMatrixDiagBlock& block)
+	{
+		static const std::size_t SIZE = fastMatrixDiagBlock::SIZE;
+		for (std::size_t i = 0; i < SIZE; ++i)
+		{
+			const float seed = static_cast<float>(i);
+			for (std::size_t row = 0; row < 4; ++row)
+			{
+				for (std::size_t col = 0; col < 4; ++col)
+				{
+					const std::uint32_t salt = static_cast<std::uint32_t>(row * 4 + col);
+					const float diag = row == col ? 4.f : 0.f;
+					block.m_mat[i][row][col] = diag + fastArithDiagRand(seed, salt) * 2.f - 1.f;
+					block.m_mat2[i][row][col] = diag + fastArithDiagRand(seed, salt + 16) * 2.f - 1.f;
+				}
+				block.m_vec[i][row] = fastArithDiagRand(seed, static_cast<std::uint32_t>(32 + row)) * 200.f - 100.f;
+			}
+			for (std::size_t col = 0; col < 3; ++col)
+				block.m_point[i][col] = fastArithDiagRand(seed, static_cast<std::uint32_t>(36 + col)) * 200.f - 100.f;
+		}
+	}
+	//誤差（FLT_EPSILON 単位の相対誤差）
+	//※num 個の結果（stride 要素ずつ）ごとに、要素の絶対値の最大値に対する相対誤差を求め、最大値を返す
+	inline double fastMatrixDiagError(const float* out, const float* ref, const std::size_t num, const std::size_t stride)
+	{
+		double max_eps = 0.;
+		for (std::size_t i = 0; i < num; ++i, out += stride, ref += stride)
+		{
+			double scale = 0.;
+			double error = 0.;
+			for (std::size_t j = 0; j < stride; ++j)
+			{
+				const double abs_ref = std::fabs(static_cast<double>(ref[j]));
+				const double abs_error = std::fabs(static_cast<double>(out[j]) - static_cast<double>(ref[j]));
+				scale = abs_ref > scale ? abs_ref : scale;
+				error = abs_error > error || abs_error != abs_error ? abs_error : error;
+			}
+			const double eps = scale > 0. ? error / (scale * static_cast<double>(FLT_EPSILON)) : error;
+			if (eps > max_eps || eps != eps)
+				max_eps = eps;
+		}
+		return max_eps;
+	}
+
+	//----------------------------------------
+	//高速行列演算診断用：転置
+	template<>
+	struct fastMatrixDiagOpe<fastMatrixDiag::TRANSPOSE>
+	{
+		template<template<typename> class ARITH>
+		static void calc(fastMatrixDiagBlock& block)
+		{
+			for (std::size_t i = 0; i < fastMatrixDiagBlock::SIZE; ++i)
+			{
+				const ARITH<float[4][4]> result = GASHA_ transpose(ARITH<float[4][4]>(block.m_mat[i]));
+				std::memcpy(block.m_outMat[i], *result, sizeof(block.m_outMat[i]));
+			}
+		}
+		static void calcScalar(fastMatrixDiagBlock& block)
+		{
+			for (std::size_t i = 0; i < fastMatrixDiagBlock::SIZE; ++i)
+				fastMatrixScalarCalc::transpose(block.m_outMat[i], block.m_mat[i]);
+		}
+		static inline double error(const fastMatrixDiagBlock& block, const fastMatrixDiagBlock& ref)
+		{
+			return fastMatrixDiagError(&block.m_outMat[0][0][0], &ref.m_outMat[0][0][0], fastMatrixDiagBlock::SIZE, 16);
+		}
+	};
+
+	//----------------------------------------
+	//高速行列演算診断用：逆行列
+	template<>
+	struct fastMatrixDiagOpe<fastMatrixDiag::INVERSE>
+	{
+		template<template<typename> class ARITH>
+		static void calc(fastMatrixDiagBlock& block)
+		{
+			for (std::size_t i = 0; i < fastMatrixDiagBlock::SIZE; ++i)
+			{
+				const ARITH<float[4][4]> result = GASHA_ inverse(ARITH<float[4][4]>(block.m_mat[i]));
+				std::memcpy(block.m_outMat[i], *result, sizeof(block.m_outMat[i]));
+			}
+		}
+		static void calcScalar(fastMatrixDiagBlock& block)
+		{
+			for (std::size_t i = 0; i < fastMatrixDiagBlock::SIZE; ++i)
+				fastMatrixScalarCalc::inverse(block.m_outMat[i], block.m_mat[i]);
+		}
+		static inline double error(const fastMatrixDiagBlock& block, const fastMatrixDiagBlock& ref)
+		{
+			return fastMatrixDiagError(&block.m_outMat[0][0][0], &ref.m_outMat[0][0][0], fastMatrixDiagBlock::SIZE, 16);
+		}
+	};
+
+	//----------------------------------------
+	//高速行列演算診断用：行列×行列
+	template<>
+	struct fastMatrixDiagOpe<fastMatrixDiag::MUL_MAT>
+	{
+		template<template<typename> class ARITH>
+		static void calc(fastMatrixDiagBlock& block)
+		{
+			for (std::size_t i = 0; i < fastMatrixDiagBlock::SIZE; ++i)
+			{
+				const ARITH<float[4][4]> result = GASHA_ mul(ARITH<float[4][4]>(block.m_mat[i]), ARITH<float[4][4]>(block.m_mat2[i]));
+				std::memcpy(block.m_outMat[i], *result, sizeof(block.m_outMat[i]));
+			}
+		}
+		static void calcScalar(fastMatrixDiagBlock& block)
+		{
+			for (std::size_t i = 0; i < fastMatrixDiagBlock::SIZE; ++i)
+				fastMatrixScalarCalc::mul(block.m_outMat[i], block.m_mat[i], block.m_mat2[i]);
+		}
+		static inline double error(const fastMatrixDiagBlock& block, const fastMatrixDiagBlock& ref)
+		{
+			return fastMatrixDiagError(&block.m_outMat[0][0][0], &ref.m_outMat[0][0][0], fastMatrixDiagBlock::SIZE, 16);
+		}
+	};
+
+	//----------------------------------------
+	//高速行列演算診断用：行列×ベクトル
+	template<>
+	struct fastMatrixDiagOpe<fastMatrixDiag::MUL_VEC>
+	{
+		template<template<typename> class ARITH>
+		static void calc(fastMatrixDiagBlock& block)
+		{
+			for (std::size_t i = 0; i < fastMatrixDiagBlock::SIZE; ++i)
+			{
+				const ARITH<float[4]> result = GASHA_ mul(ARITH<float[4][4]>(block.m_mat[i]), ARITH<float[4]>(block.m_vec[i]));
+				std::memcpy(block.m_outVec[i], *result, sizeof(block.m_outVec[i]));
+			}
+		}
+		static void calcScalar(fastMatrixDiagBlock& block)
+		{
+			for (std::size_t i = 0; i < fastMatrixDiagBlock::SIZE; ++i)
+				fastMatrixScalarCalc::mul(block.m_outVec[i], block.m_mat[i], block.m_vec[i]);
+		}
+		static inline double error(const fastMatrixDiagBlock& block, const fastMatrixDiagBlock& ref)
+		{
+			return fastMatrixDiagError(&block.m_outVec[0][0], &ref.m_outVec[0][0], fastMatrixDiagBlock::SIZE, 4);
+		}
+	};
+
+	//----------------------------------------
+	//高速行列演算診断用：行列×ベクトルのバッチ処理
+	template<>
+	struct fastMatrixDiagOpe<fastMatrixDiag::MUL_BATCH>
+	{
+		template<template<typename> class ARITH>
+		static void calc(fastMatrixDiagBlock& block)
+		{
+			GASHA_ mulBatch(ARITH<float[4][4]>(block.m_mat[0]), block.m_vec, block.m_outVec, fastMatrixDiagBlock::SIZE);
+		}
+		static void calcScalar(fastMatrixDiagBlock& block)
+		{
+			fastMatrixScalarCalc::mulBatch(block.m_mat[0], block.m_vec, block.m_outVec, fastMatrixDiagBlock::SIZE);
+		}
+		static inline double error(const fastMatrixDiagBlock& block, const fastMatrixDiagBlock& ref)
+		{
+			return fastMatrixDiagError(&block.m_outVec[0][0], &ref.m_outVec[0][0], fastMatrixDiagBlock::SIZE, 4);
+		}
+	};
+
+	//----------------------------------------
+	//高速行列演算診断用：座標変換のバッチ処理
+	template<>
+	struct fastMatrixDiagOpe<fastMatrixDiag::TRANSFORM>
+	{
+		template<template<typename> class ARITH>
+		static void calc(fastMatrixDiagBlock& block)
+		{
+			GASHA_ transformPoints(ARITH<float[4][4]>(block.m_mat[0]), block.m_point, block.m_outPoint, fastMatrixDiagBlock::SIZE);
+		}
+		static void calcScalar(fastMatrixDiagBlock& block)
+		{
+			fastMatrixScalarCalc::transformPoints(block.m_mat[0], block.m_point, block.m_outPoint, fastMatrixDiagBlock::SIZE);
+		}
+		static inline double error(const fastMatrixDiagBlock& block, const fastMatrixDiagBlock& ref)
+		{
+			return fastMatrixDiagError(&block.m_outPoint[0][0], &ref.m_outPoint[0][0], fastMatrixDiagBlock::SIZE, 3);
+		}
+	};
+
+	//----------------------------------------
+	//高速行列演算診断用：処理時間の計測
+	//※ブロックを繰り返し演算し、1演算あたりの時間を返す
+	inline double fastMatrixDiagTime(void (*calc)(fastMatrixDiagBlock&), fastMatrixDiagBlock& block)
+	{
+		static const int REPEAT = 4096;
+		void (* volatile calc_opaque)(fastMatrixDiagBlock&) = calc;//最適化で繰り返しが省略されないように、関数ポインタを volatile 経由で呼び出す
+		calc_opaque(block);//ウォームアップ
+		GASHA_ elapsedTime elapsed_time;
+		for (int i = 0; i < REPEAT; ++i)
+			calc_opaque(block);
+		return static_cast<double>(elapsed_time.now()) * 1000000000. / static_cast<double>(fastMatrixDiagBlock::SIZE * REPEAT);
+	}
+
+	//----------------------------------------
+	//高速行列演算診断用：計測
+	template<template<typename> class ARITH, int DIAG_OPE>
+	fastMatrixDiag::result fastMatrixDiagRun()
+	{
+		typedef fastMatrixDiagOpe<DIAG_OPE> ope;
+		fastMatrixDiag::result result = { 0., 0., 0., 0. };
+		//※ブロックが大きいため、スタックではなくヒープに確保する
+		fastMatrixDiagBlock* block = new fastMatrixDiagBlock;
+		fastMatrixDiagBlock* ref = new fastMatrixDiagBlock;
+		fastMatrixDiagInput(*block);
+		std::memcpy(ref, block, sizeof(fastMatrixDiagBlock));
+
+		//誤差の計測
+		ope::calcScalar(*ref);
+		ope::template calc<ARITH>(*block);
+		result.m_maxEps = ope::error(*block, *ref);
+
+		//処理時間の計測
+		result.m_scalarNsPerOp = fastMatrixDiagTime(&ope::calcScalar, *ref);
+		result.m_nsPerOp = fastMatrixDiagTime(&ope::template calc<ARITH>, *block);
+		result.m_speedUp = result.m_nsPerOp > 0. ? result.m_scalarNsPerOp / result.m_nsPerOp : 0.;
+		delete block;
+		delete ref;
+		return result;
+	}
+
+	//----------------------------------------
+	//高速行列演算診断用：演算クラスごとの計測
+	template<template<typename> class ARITH>
+	inline bool fastMatrixDiagReport(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		bool is_ok = true;
+		for (int diag_ope = 0; diag_ope < fastMatrixDiag::OPE_NUM; ++diag_ope)
+		{
+			const fastMatrixDiag::opeEnum ope = static_cast<fastMatrixDiag::opeEnum>(diag_ope);
+			const fastMatrixDiag::result result = GASHA_ fastMatrixDiagnosticTest<ARITH>(ope);
+			const bool is_passed = result.m_maxEps <= fastMatrixDiag::maxEps<ARITH>(ope);
+			if (!is_passed)
+				is_ok = false;
+			GASHA_ spprintf(message, max_size, message_len, "%-8s %-9s %9.3lf %9.3lf %8.2lfx %10.2lf   %s\n", fastArithDiag::arithName<ARITH>(), fastMatrixDiag::opeName(ope), result.m_nsPerOp, result.m_scalarNsPerOp, result.m_speedUp, result.m_maxEps, is_passed ? "[OK]" : "[NG]");
+		}
+		return is_ok;
+	}
+}//namespace _private
+
+//----------------------------------------
+//4×4行列演算の処理時間と誤差を計測
+template<template<typename> class ARITH>
+inline fastMatrixDiag::result fastMatrixDiagnosticTest(const fastMatrixDiag::opeEnum ope)
+{
+	switch (ope)
+	{
+	case fastMatrixDiag::TRANSPOSE: return _private::fastMatrixDiagRun<ARITH, fastMatrixDiag::TRANSPOSE>();
+	case fastMatrixDiag::INVERSE: return _private::fastMatrixDiagRun<ARITH, fastMatrixDiag::INVERSE>();
+	case fastMatrixDiag::MUL_MAT: return _private::fastMatrixDiagRun<ARITH, fastMatrixDiag::MUL_MAT>();
+	case fastMatrixDiag::MUL_VEC: return _private::fastMatrixDiagRun<ARITH, fastMatrixDiag::MUL_VEC>();
+	case fastMatrixDiag::MUL_BATCH: return _private::fastMatrixDiagRun<ARITH, fastMatrixDiag::MUL_BATCH>();
+	case fastMatrixDiag::TRANSFORM: return _private::fastMatrixDiagRun<ARITH, fastMatrixDiag::TRANSFORM>();
+	default: break;
+	}
+	const fastMatrixDiag::result result = { 0., 0., 0., 0. };
+	return result;
+}
+
+//----------------------------------------
+//全ての演算クラスの計測結果を表にする
+inline bool fastMatrixDiagnosticReport(char* message, const std::size_t max_size, std::size_t& message_len)
+{
+	message_len = 0;
+	message[0] = '\0';
+	GASHA_ spprintf(message, max_size, message_len, "------------------------------------------------------------------------------\n");
+	GASHA_ spprintf(message, max_size, message_len, "[ Fast matrix diagnostic test ]\n");
+	GASHA_ spprintf(message, max_size, message_len, "\n");
+	GASHA_ spprintf(message, max_size, message_len, "arith    ope           ns/op    scalar  speed-up   max(eps)\n");
+	bool is_ok = true;
+	if (!_private::fastMatrixDiagReport<fastestA>(message, max_size, message_len))
+		is_ok = false;
+	if (!_private::fastMatrixDiagReport<fastA>(message, max_size, message_len))
+		is_ok = false;
+	if (!_private::fastMatrixDiagReport<semiA>(message, max_size, message_len))
+		is_ok = false;
+	if (!_private::fastMatrixDiagReport<sseA>(message, max_size, message_len))
+		is_ok = false;
+	if (!_private::fastMatrixDiagReport<normA>(message, max_size, message_len))
+		is_ok = false;
+	GASHA_ spprintf(message, max_size, message_len, "------------------------------------------------------------------------------\n");
+	return is_ok;
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_FAST_MATH_DIAG_INL
+
+// End of file
@@ -0,0 +1,284 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_FAST_MATH_EXPR_H
+#define GASHA_INCLUDED_FAST_MATH_EXPR_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// fast_math_expr.h
+// 高速算術：式テンプレート【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/fast_math.h>//高速算術
+
+#include <cstddef>//std::size_t
+#include <cmath>//std::sqrt()
+#include <type_traits>//C++11 std::is_same
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//高速ベクトル／行列演算：式テンプレート
+//※高速演算クラス（fastA, fastestA, semiA, sseA, normA）のベクトル／行列の演算を遅延評価し、
+//　連続した要素ごとの演算を、一時オブジェクトを作らずに1回のループで演算する。
+//　例えば merge(mul(a, s), difference(b, c)) は、通常は演算ごとに結果の配列を作るが、
+//　式テンプレートでは、要素ごとに a * s + (b - c) を演算して、結果を一度だけ書き込む。
+//※lazy() で演算クラスのオブジェクトを式に変換し、以下の関数で式を組み立てる。
+//　・merge, difference ... ベクトルの合成（加算）／二点間の差（減算）
+//　・add, sub          ... 行列の加算／減算
+//　・mul               ... スカラー倍（ベクトル／行列）
+//　式と演算クラスのオブジェクトは混在してもよい。（lazy() が必要なのは、式の起点となる演算のみ）
+//※式は以下の方法で評価する。
+//　・eval(expr)         ... 評価して、演算結果の型のオブジェクトを返す。
+//　・eval(result, expr) ... 評価して、既存のオブジェクトに書き込む。（演算クラスは問わない）
+//　・演算結果の型への暗黙の変換
+//　・dot, normSq, norm  ... 評価と同時に内積／ノルムの二乗／ノルムを算出する。（結果の配列は作らない）
+//　　　　　　　　　　　　　全要素を対象に演算する。（4次元ベクトルは4要素の内積）
+//※演算結果の型は、通常の演算と同様に、左辺値（最も左のオブジェクト）と同じ型になる。
+//　異なる演算クラスへの変換は、通常の演算クラスの変換規則に従う。
+//　norm の平方根の精度は、演算結果の型の演算クラスに従う。（高速ベクトル演算：SoAバッチ処理と同じ）
+//※float型の場合、AVXが有効なら8要素ずつ、SSEが有効なら4要素ずつ処理し、端数はスカラー演算で処理する。
+//　3次元ベクトルは、SSE命令用の4要素分の領域をそのまま用いて処理する。
+//　その他の型の場合、スカラー演算で処理する。
+//※行列の乗算や正規化などの要素ごとではない演算は、eval() で評価してから、通常の関数で演算すること。
+//※式は演算対象のオブジェクトへの参照を保持するため、式を変数に保持せず、その場で評価すること。
+//※評価結果の書き込み先に、式の中のオブジェクトを指定してもよい。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  fastA_4f a, b, c;
+//  const fastA_4f result = eval(merge(mul(lazy(a), 2.f), difference(lazy(b), c)));//a * 2 + (b - c)
+//  eval(a, merge(lazy(a), mul(lazy(b), dt)));//a += b * dt（a に上書き）
+//  const float d = dot(difference(lazy(a), b), lazy(c));//(a - b)・c
+//  const fastA_44f mat = add(lazy(mat1), mul(lazy(mat2), 0.5f));//mat1 + mat2 * 0.5
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//式の基底クラス
+//※EXPR ... 派生クラス（式の種類ごとのクラス）
+template<class EXPR>
+struct fastExpr
+{
+	inline const EXPR& self() const { return static_cast<const EXPR&>(*this); }
+};
+
+//----------------------------------------
+//式：オブジェクトの参照
+//※ARITH_TYPE ... 演算クラスの型（fastA<float[4]> など）
+template<class ARITH_TYPE>
+struct fastExprRef : public fastExpr<fastExprRef<ARITH_TYPE> >
+{
+	typedef typename ARITH_TYPE::result_type result_type;
+	typedef typename ARITH_TYPE::value_type value_type;
+	typedef typename ARITH_TYPE::basic_value_type basic_value_type;
+	static const std::size_t rank = ARITH_TYPE::rank;
+	static const std::size_t extent = ARITH_TYPE::extent;
+	const basic_value_type* m_val;
+	inline basic_value_type get(const std::size_t index) const;
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	inline __m128 m128(const std::size_t index) const;
+#endif//GASHA_FAST_ARITH_USE_SSE
+#ifdef GASHA_FAST_ARITH_USE_AVX
+	inline __m256 m256(const std::size_t index) const;
+#endif//GASHA_FAST_ARITH_USE_AVX
+	inline operator result_type() const;
+	inline fastExprRef(const ARITH_TYPE& val);
+};
+
+//----------------------------------------
+//式：二項演算（要素ごと）
+//※OPE ... 要素ごとの演算
+template<class OPE, class EXPR1, class EXPR2>
+struct fastExprBinary : public fastExpr<fastExprBinary<OPE, EXPR1, EXPR2> >
+{
+	typedef typename EXPR1::result_type result_type;
+	typedef typename EXPR1::value_type value_type;
+	typedef typename EXPR1::basic_value_type basic_value_type;
+	static const std::size_t rank = EXPR1::rank;
+	static const std::size_t extent = EXPR1::extent;
+	static_assert(std::is_same<value_type, typename EXPR2::value_type>::value, "fastExprBinary: EXPR1 and EXPR2 must have the same value_type.");
+	EXPR1 m_expr1;
+	EXPR2 m_expr2;
+	inline basic_value_type get(const std::size_t index) const;
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	inline __m128 m128(const std::size_t index) const;
+#endif//GASHA_FAST_ARITH_USE_SSE
+#ifdef GASHA_FAST_ARITH_USE_AVX
+	inline __m256 m256(const std::size_t index) const;
+#endif//GASHA_FAST_ARITH_USE_AVX
+	inline operator result_type() const;
+	inline fastExprBinary(const EXPR1& expr1, const EXPR2& expr2);
+};
+
+//----------------------------------------
+//式：スカラー倍
+template<class EXPR>
+struct fastExprScale : public fastExpr<fastExprScale<EXPR> >
+{
+	typedef typename EXPR::result_type result_type;
+	typedef typename EXPR::value_type value_type;
+	typedef typename EXPR::basic_value_type basic_value_type;
+	static const std::size_t rank = EXPR::rank;
+	static const std::size_t extent = EXPR::extent;
+	EXPR m_expr;
+	basic_value_type m_scalar;
+	inline basic_value_type get(const std::size_t index) const;
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	inline __m128 m128(const std::size_t index) const;
+#endif//GASHA_FAST_ARITH_USE_SSE
+#ifdef GASHA_FAST_ARITH_USE_AVX
+	inline __m256 m256(const std::size_t index) const;
+#endif//GASHA_FAST_ARITH_USE_AVX
+	inline operator result_type() const;
+	inline fastExprScale(const EXPR& expr, const basic_value_type scalar);
+};
+
+namespace _private
+{
+	//----------------------------------------
+	//式テンプレート用：要素ごとの演算
+	struct fastExprOpeAdd
+	{
+		template<typename T>
+		static inline T calc(const T value1, const T value2){ return value1 + value2; }
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		static inline __m128 calc(const __m128 value1_m128, const __m128 value2_m128){ return _mm_add_ps(value1_m128, value2_m128); }
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		static inline __m256 calc(const __m256 value1_m256, const __m256 value2_m256){ return _mm256_add_ps(value1_m256, value2_m256); }
+	#endif//GASHA_FAST_ARITH_USE_AVX
+	};
+	struct fastExprOpeSub
+	{
+		template<typename T>
+		static inline T calc(const T value1, const T value2){ return value1 - value2; }
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		static inline __m128 calc(const __m128 value1_m128, const __m128 value2_m128){ return _mm_sub_ps(value1_m128, value2_m128); }
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		static inline __m256 calc(const __m256 value1_m256, const __m256 value2_m256){ return _mm256_sub_ps(value1_m256, value2_m256); }
+	#endif//GASHA_FAST_ARITH_USE_AVX
+	};
+
+	//----------------------------------------
+	//式テンプレート用：評価
+	//※EXTENT ... 要素数（行列の場合は全要素数）
+	//※RANK ... 次元数（1:ベクトル, 2:行列）
+	template<typename T, std::size_t EXTENT, std::size_t RANK>
+	struct fastExprCalc
+	{
+		template<class EXPR>
+		static inline void eval(T* result, const EXPR& expr);//評価
+		template<class EXPR1, class EXPR2>
+		static inline T dot(const EXPR1& expr1, const EXPR2& expr2);//内積
+		template<class EXPR>
+		static inline T normSq(const EXPR& expr);//ノルムの二乗
+	};
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	//float型：SSE命令／AVX命令
+	template<std::size_t EXTENT, std::size_t RANK>
+	struct fastExprCalc<float, EXTENT, RANK>
+	{
+		template<class EXPR>
+		static inline void eval(float* result, const EXPR& expr);
+		template<class EXPR1, class EXPR2>
+		static inline float dot(const EXPR1& expr1, const EXPR2& expr2);
+		template<class EXPR>
+		static inline float normSq(const EXPR& expr);
+	};
+	//3次元ベクトル：SSE命令用の4要素分の領域を用いる
+	template<>
+	struct fastExprCalc<float, 3, 1>
+	{
+		template<class EXPR>
+		static inline void eval(float* result, const EXPR& expr);
+		template<class EXPR1, class EXPR2>
+		static inline float dot(const EXPR1& expr1, const EXPR2& expr2);
+		template<class EXPR>
+		static inline float normSq(const EXPR& expr);
+	};
+	//SSE命令用：4要素の合計
+	inline float fastExprSum(const __m128 value_m128);
+	//SSE命令用：先頭3要素の合計
+	inline float fastExprSum3(const __m128 value_m128);
+#endif//GASHA_FAST_ARITH_USE_SSE
+
+	//----------------------------------------
+	//式テンプレート用：演算クラスごとの平方根
+	template<class RESULT_TYPE>
+	struct fastExprSqr;
+#define GASHA_FAST_EXPR_SQR(CLASS_NAME) \
+	template<typename VALUE_TYPE> \
+	struct fastExprSqr<CLASS_NAME<VALUE_TYPE> > \
+	{ \
+		template<typename T> \
+		static inline T sqrt(const T value){ return static_cast<T>(std::sqrt(value)); } \
+		static inline float sqrt(const float value){ return fastBatchOpe<CLASS_NAME>::sqrt(value); } \
+	};
+	GASHA_FAST_EXPR_SQR(fastA);
+	GASHA_FAST_EXPR_SQR(fastestA);
+	GASHA_FAST_EXPR_SQR(semiA);
+	GASHA_FAST_EXPR_SQR(sseA);
+	GASHA_FAST_EXPR_SQR(normA);
+
+	//----------------------------------------
+	//式テンプレート用：評価結果の書き込み先
+	template<class ARITH_TYPE>
+	inline typename ARITH_TYPE::basic_value_type* fastExprData(ARITH_TYPE& val);
+}//namespace _private
+
+//----------------------------------------
+//式の別名
+template<class EXPR1, class EXPR2>
+using fastExprAdd = fastExprBinary<_private::fastExprOpeAdd, EXPR1, EXPR2>;
+template<class EXPR1, class EXPR2>
+using fastExprSub = fastExprBinary<_private::fastExprOpeSub, EXPR1, EXPR2>;
+
+//----------------------------------------
+//式の組み立て：式同士
+template<class EXPR1, class EXPR2> inline fastExprAdd<EXPR1, EXPR2> merge(const fastExpr<EXPR1>& vec1, const fastExpr<EXPR2>& vec2);
+template<class EXPR1, class EXPR2> inline fastExprSub<EXPR1, EXPR2> difference(const fastExpr<EXPR1>& vec1, const fastExpr<EXPR2>& vec2);
+template<class EXPR1, class EXPR2> inline fastExprAdd<EXPR1, EXPR2> add(const fastExpr<EXPR1>& mat1, const fastExpr<EXPR2>& mat2);
+template<class EXPR1, class EXPR2> inline fastExprSub<EXPR1, EXPR2> sub(const fastExpr<EXPR1>& mat1, const fastExpr<EXPR2>& mat2);
+template<class EXPR> inline fastExprScale<EXPR> mul(const fastExpr<EXPR>& expr, const typename EXPR::basic_value_type scalar);
+
+//----------------------------------------
+//式の評価
+template<class EXPR> inline typename EXPR::result_type eval(const fastExpr<EXPR>& expr);
+template<class EXPR1, class EXPR2> inline typename EXPR1::basic_value_type dot(const fastExpr<EXPR1>& vec1, const fastExpr<EXPR2>& vec2);
+template<class EXPR> inline typename EXPR::basic_value_type normSq(const fastExpr<EXPR>& vec);
+template<class EXPR> inline typename EXPR::basic_value_type norm(const fastExpr<EXPR>& vec);
+
+//----------------------------------------
+//演算クラスごとの関数
+//※式の起点（lazy）、式と演算クラスのオブジェクトの混在、既存のオブジェクトへの評価
+#define GASHA_FAST_EXPR_SET(CLASS_NAME) \
+	template<typename T, std::size_t N> inline fastExprRef<CLASS_NAME<T[N]> > lazy(const CLASS_NAME<T[N]>& vec); \
+	template<typename T, std::size_t N, std::size_t M> inline fastExprRef<CLASS_NAME<T[N][M]> > lazy(const CLASS_NAME<T[N][M]>& mat); \
+	template<class EXPR, typename T, std::size_t N> inline fastExprAdd<EXPR, fastExprRef<CLASS_NAME<T[N]> > > merge(const fastExpr<EXPR>& vec1, const CLASS_NAME<T[N]>& vec2); \
+	template<class EXPR, typename T, std::size_t N> inline fastExprAdd<fastExprRef<CLASS_NAME<T[N]> >, EXPR> merge(const CLASS_NAME<T[N]>& vec1, const fastExpr<EXPR>& vec2); \
+	template<class EXPR, typename T, std::size_t N> inline fastExprSub<EXPR, fastExprRef<CLASS_NAME<T[N]> > > difference(const fastExpr<EXPR>& vec1, const CLASS_NAME<T[N]>& vec2); \
+	template<class EXPR, typename T, std::size_t N> inline fastExprSub<fastExprRef<CLASS_NAME<T[N]> >, EXPR> difference(const CLASS_NAME<T[N]>& vec1, const fastExpr<EXPR>& vec2); \
+	template<class EXPR, typename T, std::size_t N, std::size_t M> inline fastExprAdd<EXPR, fastExprRef<CLASS_NAME<T[N][M]> > > add(const fastExpr<EXPR>& mat1, const CLASS_NAME<T[N][M]>& mat2); \
+	template<class EXPR, typename T, std::size_t N, std::size_t M> inline fastExprAdd<fastExprRef<CLASS_NAME<T[N][M]> >, EXPR> add(const CLASS_NAME<T[N][M]>& mat1, const fastExpr<EXPR>& mat2); \
+	template<class EXPR, typename T, std::size_t N, std::size_t M> inline fastExprSub<EXPR, fastExprRef<CLASS_NAME<T[N][M]> > > sub(const fastExpr<EXPR>& mat1, const CLASS_NAME<T[N][M]>& mat2); \
+	template<class EXPR, typename T, std::size_t N, std::size_t M> inline fastExprSub<fastExprRef<CLASS_NAME<T[N][M]> >, EXPR> sub(const CLASS_NAME<T[N][M]>& mat1, const fastExpr<EXPR>& mat2); \
+	template<class EXPR, typename VALUE_TYPE> inline CLASS_NAME<VALUE_TYPE>& eval(CLASS_NAME<VALUE_TYPE>& result, const fastExpr<EXPR>& expr);
+
+GASHA_FAST_EXPR_SET(fastA);
+GASHA_FAST_EXPR_SET(fastestA);
+GASHA_FAST_EXPR_SET(semiA);
+GASHA_FAST_EXPR_SET(sseA);
+GASHA_FAST_EXPR_SET(normA);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/fast_math_expr.inl>
+
+#endif//GASHA_INCLUDED_FAST_MATH_EXPR_H
+
+// End of file
@@ -0,0 +1,445 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_FAST_MATH_EXPR_INL
+#define GASHA_INCLUDED_FAST_MATH_EXPR_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// fast_math_expr.inl
+// 高速算術：式テンプレート【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/fast_math_expr.h>//高速算術：式テンプレート【宣言部】
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//----------------------------------------
+//式：オブジェクトの参照
+
+//要素を取得
+template<class ARITH_TYPE>
+inline typename fastExprRef<ARITH_TYPE>::basic_value_type fastExprRef<ARITH_TYPE>::get(const std::size_t index) const
+{
+	return m_val[index];
+}
+#ifdef GASHA_FAST_ARITH_USE_SSE
+//4要素を取得
+template<class ARITH_TYPE>
+inline __m128 fastExprRef<ARITH_TYPE>::m128(const std::size_t index) const
+{
+	return _mm_loadu_ps(m_val + index);
+}
+#endif//GASHA_FAST_ARITH_USE_SSE
+#ifdef GASHA_FAST_ARITH_USE_AVX
+//8要素を取得
+template<class ARITH_TYPE>
+inline __m256 fastExprRef<ARITH_TYPE>::m256(const std::size_t index) const
+{
+	return _mm256_loadu_ps(m_val + index);
+}
+#endif//GASHA_FAST_ARITH_USE_AVX
+//演算結果の型に変換
+template<class ARITH_TYPE>
+inline fastExprRef<ARITH_TYPE>::operator result_type() const
+{
+	return GASHA_ eval(*this);
+}
+//コンストラクタ
+template<class ARITH_TYPE>
+inline fastExprRef<ARITH_TYPE>::fastExprRef(const ARITH_TYPE& val) :
+	m_val(reinterpret_cast<const basic_value_type*>(&*val))
+{}
+
+//----------------------------------------
+//式：二項演算（要素ごと）
+
+//要素を取得
+template<class OPE, class EXPR1, class EXPR2>
+inline typename fastExprBinary<OPE, EXPR1, EXPR2>::basic_value_type fastExprBinary<OPE, EXPR1, EXPR2>::get(const std::size_t index) const
+{
+	return OPE::calc(m_expr1.get(index), m_expr2.get(index));
+}
+#ifdef GASHA_FAST_ARITH_USE_SSE
+//4要素を取得
+template<class OPE, class EXPR1, class EXPR2>
+inline __m128 fastExprBinary<OPE, EXPR1, EXPR2>::m128(const std::size_t index) const
+{
+	return OPE::calc(m_expr1.m128(index), m_expr2.m128(index));
+}
+#endif//GASHA_FAST_ARITH_USE_SSE
+#ifdef GASHA_FAST_ARITH_USE_AVX
+//8要素を取得
+template<class OPE, class EXPR1, class EXPR2>
+inline __m256 fastExprBinary<OPE, EXPR1, EXPR2>::m256(const std::size_t index) const
+{
+	return OPE::calc(m_expr1.m256(index), m_expr2.m256(index));
+}
+#endif//GASHA_FAST_ARITH_USE_AVX
+//演算結果の型に変換
+template<class OPE, class EXPR1, class EXPR2>
+inline fastExprBinary<OPE, EXPR1, EXPR2>::operator result_type() const
+{
+	return GASHA_ eval(*this);
+}
+//コンストラクタ
+template<class OPE, class EXPR1, class EXPR2>
+inline fastExprBinary<OPE, EXPR1, EXPR2>::fastExprBinary(const EXPR1& expr1, const EXPR2& expr2) :
+	m_expr1(expr1),
+	m_expr2(expr2)
+{}
+
+//----------------------------------------
+//式：スカラー倍
+
+//要素を取得
+template<class EXPR>
+inline typename fastExprScale<EXPR>::basic_value_type fastExprScale<EXPR>::get(const std::size_t index) const
+{
+	return m_expr.get(index) * m_scalar;
+}
+#ifdef GASHA_FAST_ARITH_USE_SSE
+//4要素を取得
+template<class EXPR>
+inline __m128 fastExprScale<EXPR>::m128(const std::size_t index) const
+{
+	return _mm_mul_ps(m_expr.m128(index), _mm_set1_ps(m_scalar));
+}
+#endif//GASHA_FAST_ARITH_USE_SSE
+#ifdef GASHA_FAST_ARITH_USE_AVX
+//8要素を取得
+template<class EXPR>
+inline __m256 fastExprScale<EXPR>::m256(const std::size_t index) const
+{
+	return _mm256_mul_ps(m_expr.m256(index), _mm256_set1_ps(m_scalar));
+}
+#endif//GASHA_FAST_ARITH_USE_AVX
+//演算結果の型に変換
+template<class EXPR>
+inline fastExprScale<EXPR>::operator result_type() const
+{
+	return GASHA_ eval(*this);
+}
+//コンストラクタ
+template<class EXPR>
+inline fastExprScale<EXPR>::fastExprScale(const EXPR& expr, const basic_value_type scalar) :
+	m_expr(expr),
+	m_scalar(scalar)
+{}
+
+namespace _private
+{
+	//----------------------------------------
+	//式テンプレート用：評価
+
+	//評価
+	template<typename T, std::size_t EXTENT, std::size_t RANK>
+	template<class EXPR>
+	inline void fastExprCalc<T, EXTENT, RANK>::eval(T* result, const EXPR& expr)
+	{
+		for (std::size_t i = 0; i < EXTENT; ++i)
+			result[i] = expr.get(i);
+	}
+	//内積
+	template<typename T, std::size_t EXTENT, std::size_t RANK>
+	template<class EXPR1, class EXPR2>
+	inline T fastExprCalc<T, EXTENT, RANK>::dot(const EXPR1& expr1, const EXPR2& expr2)
+	{
+		T sum = static_cast<T>(0);
+		for (std::size_t i = 0; i < EXTENT; ++i)
+			sum += expr1.get(i) * expr2.get(i);
+		return sum;
+	}
+	//ノルムの二乗
+	template<typename T, std::size_t EXTENT, std::size_t RANK>
+	template<class EXPR>
+	inline T fastExprCalc<T, EXTENT, RANK>::normSq(const EXPR& expr)
+	{
+		T sum = static_cast<T>(0);
+		for (std::size_t i = 0; i < EXTENT; ++i)
+		{
+			const T value = expr.get(i);
+			sum += value * value;
+		}
+		return sum;
+	}
+
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	//SSE命令用：4要素の合計
+	inline float fastExprSum(const __m128 value_m128)
+	{
+		const __m128 shuffled_m128 = _mm_shuffle_ps(value_m128, value_m128, _MM_SHUFFLE(2, 3, 0, 1));
+		const __m128 sum_m128 = _mm_add_ps(value_m128, shuffled_m128);
+		return _mm_cvtss_f32(_mm_add_ss(sum_m128, _mm_movehl_ps(shuffled_m128, sum_m128)));
+	}
+	//SSE命令用：先頭3要素の合計
+	inline float fastExprSum3(const __m128 value_m128)
+	{
+		const __m128 y_m128 = _mm_shuffle_ps(value_m128, value_m128, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 z_m128 = _mm_shuffle_ps(value_m128, value_m128, _MM_SHUFFLE(2, 2, 2, 2));
+		return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(value_m128, y_m128), z_m128));
+	}
+
+	//--------------------
+	//float型：SSE命令／AVX命令
+
+	//評価
+	template<std::size_t EXTENT, std::size_t RANK>
+	template<class EXPR>
+	inline void fastExprCalc<float, EXTENT, RANK>::eval(float* result, const EXPR& expr)
+	{
+		std::size_t i = 0;
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		for (; i + 8 <= EXTENT; i += 8)
+			_mm256_storeu_ps(result + i, expr.m256(i));
+	#endif//GASHA_FAST_ARITH_USE_AVX
+		for (; i + 4 <= EXTENT; i += 4)
+			_mm_storeu_ps(result + i, expr.m128(i));
+		//端数
+		//※要素数が4の倍数なら端数はないので、ループ自体を生成しない
+		if (EXTENT % 4 != 0)
+		{
+			for (; i < EXTENT; ++i)
+				result[i] = expr.get(i);
+		}
+	}
+	//内積
+	template<std::size_t EXTENT, std::size_t RANK>
+	template<class EXPR1, class EXPR2>
+	inline float fastExprCalc<float, EXTENT, RANK>::dot(const EXPR1& expr1, const EXPR2& expr2)
+	{
+		std::size_t i = 0;
+		__m128 sum_m128 = _mm_setzero_ps();
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		if (EXTENT >= 8)
+		{
+			__m256 sum_m256 = _mm256_setzero_ps();
+			for (; i + 8 <= EXTENT; i += 8)
+				sum_m256 = _mm256_add_ps(sum_m256, _mm256_mul_ps(expr1.m256(i), expr2.m256(i)));
+			sum_m128 = _mm_add_ps(_mm256_castps256_ps128(sum_m256), _mm256_extractf128_ps(sum_m256, 1));
+		}
+	#endif//GASHA_FAST_ARITH_USE_AVX
+		for (; i + 4 <= EXTENT; i += 4)
+			sum_m128 = _mm_add_ps(sum_m128, _mm_mul_ps(expr1.m128(i), expr2.m128(i)));
+		float sum = fastExprSum(sum_m128);
+		//端数
+		if (EXTENT % 4 != 0)
+		{
+			for (; i < EXTENT; ++i)
+				sum += expr1.get(i) * expr2.get(i);
+		}
+		return sum;
+	}
+	//ノルムの二乗
+	template<std::size_t EXTENT, std::size_t RANK>
+	template<class EXPR>
+	inline float fastExprCalc<float, EXTENT, RANK>::normSq(const EXPR& expr)
+	{
+		std::size_t i = 0;
+		__m128 sum_m128 = _mm_setzero_ps();
+	#ifdef GASHA_FAST_ARITH_USE_AVX
+		if (EXTENT >= 8)
+		{
+			__m256 sum_m256 = _mm256_setzero_ps();
+			for (; i + 8 <= EXTENT; i += 8)
+			{
+				const __m256 value_m256 = expr.m256(i);
+				sum_m256 = _mm256_add_ps(sum_m256, _mm256_mul_ps(value_m256, value_m256));
+			}
+			sum_m128 = _mm_add_ps(_mm256_castps256_ps128(sum_m256), _mm256_extractf128_ps(sum_m256, 1));
+		}
+	#endif//GASHA_FAST_ARITH_USE_AVX
+		for (; i + 4 <= EXTENT; i += 4)
+		{
+			const __m128 value_m128 = expr.m128(i);
+			sum_m128 = _mm_add_ps(sum_m128, _mm_mul_ps(value_m128, value_m128));
+		}
+		float sum = fastExprSum(sum_m128);
+		//端数
+		if (EXTENT % 4 != 0)
+		{
+			for (; i < EXTENT; ++i)
+			{
+				const float value = expr.get(i);
+				sum += value * value;
+			}
+		}
+		return sum;
+	}
+
+	//--------------------
+	//3次元ベクトル：SSE命令用の4要素分の領域を用いる
+	//※4要素目は不定値のまま演算し、内積などの集計からは除外する
+
+	//評価
+	template<class EXPR>
+	inline void fastExprCalc<float, 3, 1>::eval(float* result, const EXPR& expr)
+	{
+		_mm_storeu_ps(result, expr.m128(0));
+	}
+	//内積
+	template<class EXPR1, class EXPR2>
+	inline float fastExprCalc<float, 3, 1>::dot(const EXPR1& expr1, const EXPR2& expr2)
+	{
+		return fastExprSum3(_mm_mul_ps(expr1.m128(0), expr2.m128(0)));
+	}
+	//ノルムの二乗
+	template<class EXPR>
+	inline float fastExprCalc<float, 3, 1>::normSq(const EXPR& expr)
+	{
+		const __m128 value_m128 = expr.m128(0);
+		return fastExprSum3(_mm_mul_ps(value_m128, value_m128));
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+
+	//----------------------------------------
+	//式テンプレート用：評価結果の書き込み先
+	template<class ARITH_TYPE>
+	inline typename ARITH_TYPE::basic_value_type* fastExprData(ARITH_TYPE& val)
+	{
+		return reinterpret_cast<typename ARITH_TYPE::basic_value_type*>(&*val);
+	}
+}//namespace _private
+
+//----------------------------------------
+//式の組み立て：式同士
+
+//ベクトルの合成
+template<class EXPR1, class EXPR2>
+inline fastExprAdd<EXPR1, EXPR2> merge(const fastExpr<EXPR1>& vec1, const fastExpr<EXPR2>& vec2)
+{
+	static_assert(EXPR1::rank == 1, "merge() is for vectors.");
+	return fastExprAdd<EXPR1, EXPR2>(vec1.self(), vec2.self());
+}
+
+//ベクトルの二点間の差
+template<class EXPR1, class EXPR2>
+inline fastExprSub<EXPR1, EXPR2> difference(const fastExpr<EXPR1>& vec1, const fastExpr<EXPR2>& vec2)
+{
+	static_assert(EXPR1::rank == 1, "difference() is for vectors.");
+	return fastExprSub<EXPR1, EXPR2>(vec1.self(), vec2.self());
+}
+
+//行列の加算
+template<class EXPR1, class EXPR2>
+inline fastExprAdd<EXPR1, EXPR2> add(const fastExpr<EXPR1>& mat1, const fastExpr<EXPR2>& mat2)
+{
+	static_assert(EXPR1::rank == 2, "add() is for matrices.");
+	return fastExprAdd<EXPR1, EXPR2>(mat1.self(), mat2.self());
+}
+
+//行列の減算
+template<class EXPR1, class EXPR2>
+inline fastExprSub<EXPR1, EXPR2> sub(const fastExpr<EXPR1>& mat1, const fastExpr<EXPR2>& mat2)
+{
+	static_assert(EXPR1::rank == 2, "sub() is for matrices.");
+	return fastExprSub<EXPR1, EXPR2>(mat1.self(), mat2.self());
+}
+
+//スカラー倍
+template<class EXPR>
+inline fastExprScale<EXPR> mul(const fastExpr<EXPR>& expr, const typename EXPR::basic_value_type scalar)
+{
+	return fastExprScale<EXPR>(expr.self(), scalar);
+}
+
+//----------------------------------------
+//式の評価
+
+//評価
+template<class EXPR>
+inline typename EXPR::result_type eval(const fastExpr<EXPR>& expr)
+{
+	typename EXPR::result_type result;
+	_private::fastExprCalc<typename EXPR::basic_value_type, EXPR::extent, EXPR::rank>::eval(_private::fastExprData(result), expr.self());
+	return result;
+}
+
+//内積
+template<class EXPR1, class EXPR2>
+inline typename EXPR1::basic_value_type dot(const fastExpr<EXPR1>& vec1, const fastExpr<EXPR2>& vec2)
+{
+	static_assert(std::is_same<typename EXPR1::value_type, typename EXPR2::value_type>::value, "dot(): EXPR1 and EXPR2 must have the same value_type.");
+	return _private::fastExprCalc<typename EXPR1::basic_value_type, EXPR1::extent, EXPR1::rank>::dot(vec1.self(), vec2.self());
+}
+
+//ノルムの二乗
+template<class EXPR>
+inline typename EXPR::basic_value_type normSq(const fastExpr<EXPR>& vec)
+{
+	return _private::fastExprCalc<typename EXPR::basic_value_type, EXPR::extent, EXPR::rank>::normSq(vec.self());
+}
+
+//ノルム
+template<class EXPR>
+inline typename EXPR::basic_value_type norm(const fastExpr<EXPR>& vec)
+{
+	return _private::fastExprSqr<typename EXPR::result_type>::sqrt(GASHA_ normSq(vec));
+}
+
+//----------------------------------------
+//演算クラスごとの関数
+#define GASHA_FAST_EXPR_SET_INSTANCING(CLASS_NAME) \
+	template<typename T, std::size_t N> inline fastExprRef<CLASS_NAME<T[N]> > lazy(const CLASS_NAME<T[N]>& vec) \
+	{ \
+		return fastExprRef<CLASS_NAME<T[N]> >(vec); \
+	} \
+	template<typename T, std::size_t N, std::size_t M> inline fastExprRef<CLASS_NAME<T[N][M]> > lazy(const CLASS_NAME<T[N][M]>& mat) \
+	{ \
+		return fastExprRef<CLASS_NAME<T[N][M]> >(mat); \
+	} \
+	template<class EXPR, typename T, std::size_t N> inline fastExprAdd<EXPR, fastExprRef<CLASS_NAME<T[N]> > > merge(const fastExpr<EXPR>& vec1, const CLASS_NAME<T[N]>& vec2) \
+	{ \
+		return GASHA_ merge(vec1, GASHA_ lazy(vec2)); \
+	} \
+	template<class EXPR, typename T, std::size_t N> inline fastExprAdd<fastExprRef<CLASS_NAME<T[N]> >, EXPR> merge(const CLASS_NAME<T[N]>& vec1, const fastExpr<EXPR>& vec2) \
+	{ \
+		return GASHA_ merge(GASHA_ lazy(vec1), vec2); \
+	} \
+	template<class EXPR, typename T, std::size_t N> inline fastExprSub<EXPR, fastExprRef<CLASS_NAME<T[N]> > > difference(const fastExpr<EXPR>& vec1, const CLASS_NAME<T[N]>& vec2) \
+	{ \
+		return GASHA_ difference(vec1, GASHA_ lazy(vec2)); \
+	} \
+	template<class EXPR, typename T, std::size_t N> inline fastExprSub<fastExprRef<CLASS_NAME<T[N]> >, EXPR> difference(const CLASS_NAME<T[N]>& vec1, const fastExpr<EXPR>& vec2) \
+	{ \
+		return GASHA_ difference(GASHA_ lazy(vec1), vec2); \
+	} \
+	template<class EXPR, typename T, std::size_t N, std::size_t M> inline fastExprAdd<EXPR, fastExprRef<CLASS_NAME<T[N][M]> > > add(const fastExpr<EXPR>& mat1, const CLASS_NAME<T[N][M]>& mat2) \
+	{ \
+		return GASHA_ add(mat1, GASHA_ lazy(mat2)); \
+	} \
+	template<class EXPR, typename T, std::size_t N, std::size_t M> inline fastExprAdd<fastExprRef<CLASS_NAME<T[N][M]> >, EXPR> add(const CLASS_NAME<T[N][M]>& mat1, const fastExpr<EXPR>& mat2) \
+	{ \
+		return GASHA_ add(GASHA_ lazy(mat1), mat2); \
+	} \
+	template<class EXPR, typename T, std::size_t N, std::size_t M> inline fastExprSub<EXPR, fastExprRef<CLASS_NAME<T[N][M]> > > sub(const fastExpr<EXPR>& mat1, const CLASS_NAME<T[N][M]>& mat2) \
+	{ \
+		return GASHA_ sub(mat1, GASHA_ lazy(mat2)); \
+	} \
+	template<class EXPR, typename T, std::size_t N, std::size_t M> inline fastExprSub<fastExprRef<CLASS_NAME<T[N][M]> >, EXPR> sub(const CLASS_NAME<T[N][M]>& mat1, const fastExpr<EXPR>& mat2) \
+	{ \
+		return GASHA_ sub(GASHA_ lazy(mat1), mat2); \
+	} \
+	template<class EXPR, typename VALUE_TYPE> inline CLASS_NAME<VALUE_TYPE>& eval(CLASS_NAME<VALUE_TYPE>& result, const fastExpr<EXPR>& expr) \
+	{ \
+		static_assert(std::is_same<VALUE_TYPE, typename EXPR::value_type>::value, "eval(): result and EXPR must have the same value_type."); \
+		_private::fastExprCalc<typename EXPR::basic_value_type, EXPR::extent, EXPR::rank>::eval(_private::fastExprData(result), expr.self()); \
+		return result; \
+	}
+
+GASHA_FAST_EXPR_SET_INSTANCING(fastA);
+GASHA_FAST_EXPR_SET_INSTANCING(fastestA);
+GASHA_FAST_EXPR_SET_INSTANCING(semiA);
+GASHA_FAST_EXPR_SET_INSTANCING(sseA);
+GASHA_FAST_EXPR_SET_INSTANCING(normA);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_FAST_MATH_EXPR_INL
+
+// End of file
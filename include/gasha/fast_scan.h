@@ -0,0 +1,138 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_FAST_SCAN_H
+#define GASHA_INCLUDED_FAST_SCAN_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// fast_scan.h
+// 高速集計処理（スキャン／リダクション／ヒストグラム）【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/basic_math.h>//基本算術
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::int32_t, std::uint32_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//高速集計処理
+//※配列の累積和（スキャン）、合計／最小／最大（リダクション）、少数のビンのヒストグラムを求める。
+//　基数ソートの分布集計、ストリームコンパクションの出力位置算出、プロファイラの集計、
+//　カリング結果の集計などの基本処理として使用する。
+//※要素型が std::int32_t, std::uint32_t, float の場合、SIMD命令で処理し、端数はスカラー演算で処理する。
+//　・AVX2が有効なら8要素ずつ処理する。
+//　・SSE4.1が有効なら（float は SSE2 が有効なら）4要素ずつ処理する。
+//　それ以外の要素型は、スカラー演算で処理する。
+//※ビルド設定 GASHA_USE_RUNTIME_CPU_DISPATCH が有効で、AVX2命令がコンパイル時に無効な場合、
+//　CPUのAVX2命令対応を実行時に判定し、対応していればAVX2命令で8要素ずつ処理する。
+//※累積和は、レジスタ内で対数段のシフトと加算で求め、前のブロックの合計（最終レーン）を全レーンに足して繋ぐ。
+//※整数の加算は、オーバーフローすると2の補数で折り返す。
+//※float の合計と累積和は、SIMD版では加算の順序が異なるため、逐次加算と丸め誤差が一致しない。
+//　（並列版は、さらにスレッド数によって結果が変わる）
+//※float の最小／最大は、NaN を含む配列の結果は不定。
+//※出力先に入力と同じ配列を指定してもよい。（ただし、ずれて重なる配列は不可）
+//※配列のアラインメントは問わない。
+//--------------------------------------------------------------------------------
+//【並列版】
+//※parallel～ の関数は、OpenMPを使用し、配列をスレッド数分のブロックに分けて並列に処理する。
+//　（OpenMPが無効な環境や、要素数が少ない場合は、非並列版に切り替える）
+//※累積和は、以下の2段階で処理する。
+//　1. ブロックごとの合計を並列に算出。
+//　2. ブロックの合計の累積を初期値にして、ブロックごとの累積和を並列に算出。
+//※ヒストグラムは、ブロックごとに並列に集計し、最後に合算する。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //累積和
+//  std::uint32_t counts[256], offsets[256];
+//  exclusiveScan(counts, offsets, 256);//offsets[i] = counts[0] + ... + counts[i - 1]
+//
+//  //合計／最小／最大
+//  const float sum = reduceSum(values, n);
+//  float min_value, max_value;
+//  reduceMinMax(values, n, min_value, max_value);
+//
+//  //ヒストグラム（0.0～100.0 を16区間に分けて集計）
+//  std::size_t bins[16];
+//  histogram(values, n, bins, 16, 0.f, 100.f);
+//
+//  //並列版
+//  parallelInclusiveScan(values, values, n);//上書き
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//累積和（スキャン）
+//※結果の配列 dst に、src の先頭からの累積和を格納し、全体の合計（init を含む）を返す。
+//※init ... 累積和の初期値
+//包含的累積和：dst[i] = init + src[0] + ... + src[i]
+template<typename T>
+inline T inclusiveScan(const T* src, T* dst, const std::size_t n, const T init = T());
+//排他的累積和：dst[i] = init + src[0] + ... + src[i - 1]（dst[0] = init）
+template<typename T>
+inline T exclusiveScan(const T* src, T* dst, const std::size_t n, const T init = T());
+
+//----------------------------------------
+//リダクション
+//※n が 0 の場合、合計は T()、最小は型の最大値、最大は型の最小値（float は -FLT_MAX）を返す。
+//合計
+template<typename T>
+inline T reduceSum(const T* src, const std::size_t n);
+//最小
+template<typename T>
+inline T reduceMin(const T* src, const std::size_t n);
+//最大
+template<typename T>
+inline T reduceMax(const T* src, const std::size_t n);
+//最小と最大
+template<typename T>
+inline void reduceMinMax(const T* src, const std::size_t n, T& min_value, T& max_value);
+
+//----------------------------------------
+//ヒストグラム
+//※配列 counts（bin_num 件）に、ビンごとの要素数を格納する。（counts を初期化する必要はない）
+//※ビンの数が HISTOGRAM_SMALL_BIN_NUM 以下なら、複数の作業用ヒストグラムに交互に集計し、
+//　同じビンへの連続した加算による依存待ちを抑える。
+//整数版：値をそのままビンの番号とする
+//※範囲外の値は、0 未満なら先頭、bin_num 以上なら末尾のビンに集計する。
+template<typename T>
+inline void histogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num);
+//範囲指定版：[min_value, max_value) を bin_num 個の等幅の区間に分ける
+//※範囲外の値は、先頭／末尾のビンに集計する。（float の NaN は先頭のビンに集計する）
+template<typename T>
+inline void histogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num, const T min_value, const T max_value);
+
+//少数のビンとみなす最大数
+static const int HISTOGRAM_SMALL_BIN_NUM = 256;
+
+//----------------------------------------
+//並列版
+template<typename T>
+inline T parallelInclusiveScan(const T* src, T* dst, const std::size_t n, const T init = T());
+template<typename T>
+inline T parallelExclusiveScan(const T* src, T* dst, const std::size_t n, const T init = T());
+template<typename T>
+inline T parallelReduceSum(const T* src, const std::size_t n);
+template<typename T>
+inline T parallelReduceMin(const T* src, const std::size_t n);
+template<typename T>
+inline T parallelReduceMax(const T* src, const std::size_t n);
+template<typename T>
+inline void parallelReduceMinMax(const T* src, const std::size_t n, T& min_value, T& max_value);
+template<typename T>
+inline void parallelHistogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num);
+template<typename T>
+inline void parallelHistogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num, const T min_value, const T max_value);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/fast_scan.inl>
+
+#endif//GASHA_INCLUDED_FAST_SCAN_H
+
+// End of file
@@ -0,0 +1,1003 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_FAST_SCAN_INL
+#define GASHA_INCLUDED_FAST_SCAN_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// fast_scan.inl
+// 高速集計処理（スキャン／リダクション／ヒストグラム）【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/fast_scan.h>//高速集計処理【宣言部】
+
+#include <limits>//std::numeric_limits
+#include <type_traits>//C++11 std::conditional, std::is_same
+#include <cstring>//std::memset()
+#include <new>//std::nothrow
+
+#ifdef GASHA_USE_SSE2
+#include <emmintrin.h>//SSE2
+#endif//GASHA_USE_SSE2
+
+#ifdef GASHA_USE_SSE4_1
+#include <smmintrin.h>//SSE4.1
+#endif//GASHA_USE_SSE4_1
+
+#if defined(GASHA_USE_AVX2) || defined(GASHA_DISPATCH_AVX2)
+#include <immintrin.h>//AVX2
+#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+
+#ifdef GASHA_DISPATCH_AVX2
+#include <gasha/cpu_features.h>//CPU機能判定
+#endif//GASHA_DISPATCH_AVX2
+
+#ifdef _OPENMP
+#include <omp.h>//omp_get_max_threads()
+#endif//_OPENMP
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+namespace _private
+{
+	//----------------------------------------
+	//高速集計処理用：定数
+
+	//並列化する要素数
+	static const std::size_t PARALLEL_FAST_SCAN_SIZE_THRESHOLD = 65536;
+	//並列処理時の最大ブロック数
+	static const int PARALLEL_FAST_SCAN_BLOCK_NUM_MAX = 64;
+	//ヒストグラムの作業用ヒストグラム数
+	static const int HISTOGRAM_SUB_NUM = 4;
+	//ヒストグラムのビン番号を算出するブロックの要素数
+	static const std::size_t HISTOGRAM_BLOCK_SIZE = 256;
+
+	//リダクションの種類
+	enum fastReduceEnum : int
+	{
+		FAST_REDUCE_SUM = 0,//合計
+		FAST_REDUCE_MIN,//最小
+		FAST_REDUCE_MAX,//最大
+	};
+
+	//----------------------------------------
+	//高速集計処理用：スカラー演算
+
+	//リダクションの演算
+	template<int REDUCE, typename T>
+	inline T fastReduceCalc(const T value1, const T value2)
+	{
+		return REDUCE == FAST_REDUCE_SUM ? static_cast<T>(value1 + value2) :
+		       REDUCE == FAST_REDUCE_MIN ? (value2 < value1 ? value2 : value1) :
+		                                   (value1 < value2 ? value2 : value1);
+	}
+	//リダクションの初期値
+	template<int REDUCE, typename T>
+	inline T fastReduceInit()
+	{
+		return REDUCE == FAST_REDUCE_SUM ? T() :
+		       REDUCE == FAST_REDUCE_MIN ? std::numeric_limits<T>::max() :
+		                                   std::numeric_limits<T>::lowest();
+	}
+	//ヒストグラムのビン番号（整数版）
+	template<typename T>
+	inline std::int32_t fastHistogramIndex(const T value, const int bin_num)
+	{
+		if (!(value > T()))//0 以下と NaN は先頭のビン
+			return 0;
+		if (!(value < static_cast<T>(bin_num - 1)))
+			return bin_num - 1;
+		return static_cast<std::int32_t>(value);
+	}
+	//ヒストグラムのビン番号の算出型（範囲指定版）
+	//※float は SIMD版と結果を一致させるため float で、それ以外は double で算出する
+	template<typename T>
+	struct fastHistogramCalcType
+	{
+		typedef typename std::conditional<std::is_same<T, float>::value, float, double>::type type;
+	};
+	//ヒストグラムのビン番号（範囲指定版）
+	template<typename T>
+	inline std::int32_t fastHistogramIndex(const T value, const int bin_num, const typename fastHistogramCalcType<T>::type min_value, const typename fastHistogramCalcType<T>::type scale)
+	{
+		typedef typename fastHistogramCalcType<T>::type calc_type;
+		const calc_type pos = (static_cast<calc_type>(value) - min_value) * scale;
+		if (!(pos > static_cast<calc_type>(0)))//範囲の前と NaN は先頭のビン
+			return 0;
+		if (!(pos < static_cast<calc_type>(bin_num - 1)))
+			return bin_num - 1;
+		return static_cast<std::int32_t>(pos);
+	}
+
+	//----------------------------------------
+	//高速集計処理用：SSE命令（4要素）の演算
+	//※IS_AVAILABLE ... 使用可能な型か？
+	template<typename T>
+	struct fastScanOpe128
+	{
+		static const bool IS_AVAILABLE = false;
+	};
+#ifdef GASHA_USE_SSE4_1
+	//整数型共通
+	template<typename T>
+	struct fastScanOpe128Int
+	{
+		static const bool IS_AVAILABLE = true;
+		static const std::size_t WIDTH = 4;
+		typedef T value_type;
+		typedef __m128i vec_type;
+		inline static vec_type load(const value_type* p){ return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+		inline static void store(value_type* p, const vec_type v){ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+		inline static vec_type set1(const value_type value){ return _mm_set1_epi32(static_cast<int>(value)); }
+		inline static vec_type add(const vec_type a, const vec_type b){ return _mm_add_epi32(a, b); }
+		//レジスタ内の累積和
+		inline static vec_type scan(vec_type v)
+		{
+			v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+			return _mm_add_epi32(v, _mm_slli_si128(v, 8));
+		}
+		//最終レーンを全レーンに複製
+		inline static vec_type last(const vec_type v){ return _mm_shuffle_epi32(v, 0xff); }
+		//1レーンずらして、先頭レーンに c の先頭レーンを入れる
+		inline static vec_type shiftIn(const vec_type v, const vec_type c){ return _mm_blend_epi16(_mm_slli_si128(v, 4), c, 0x03); }
+	};
+	template<>
+	struct fastScanOpe128<std::int32_t> : public fastScanOpe128Int<std::int32_t>
+	{
+		inline static vec_type min(const vec_type a, const vec_type b){ return _mm_min_epi32(a, b); }
+		inline static vec_type max(const vec_type a, const vec_type b){ return _mm_max_epi32(a, b); }
+		inline static __m128i toIndex(const vec_type v, const vec_type last_index){ return _mm_max_epi32(_mm_min_epi32(v, last_index), _mm_setzero_si128()); }
+	};
+	template<>
+	struct fastScanOpe128<std::uint32_t> : public fastScanOpe128Int<std::uint32_t>
+	{
+		inline static vec_type min(const vec_type a, const vec_type b){ return _mm_min_epu32(a, b); }
+		inline static vec_type max(const vec_type a, const vec_type b){ return _mm_max_epu32(a, b); }
+		inline static __m128i toIndex(const vec_type v, const vec_type last_index){ return _mm_min_epu32(v, last_index); }
+	};
+#endif//GASHA_USE_SSE4_1
+#ifdef GASHA_USE_SSE2
+	template<>
+	struct fastScanOpe128<float>
+	{
+		static const bool IS_AVAILABLE = true;
+		static const std::size_t WIDTH = 4;
+		typedef float value_type;
+		typedef __m128 vec_type;
+		inline static vec_type load(const value_type* p){ return _mm_loadu_ps(p); }
+		inline static void store(value_type* p, const vec_type v){ _mm_storeu_ps(p, v); }
+		inline static vec_type set1(const value_type value){ return _mm_set1_ps(value); }
+		inline static vec_type add(const vec_type a, const vec_type b){ return _mm_add_ps(a, b); }
+		inline static vec_type min(const vec_type a, const vec_type b){ return _mm_min_ps(a, b); }
+		inline static vec_type max(const vec_type a, const vec_type b){ return _mm_max_ps(a, b); }
+		//レジスタ内の累積和
+		inline static vec_type scan(vec_type v)
+		{
+			v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)));
+			return _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)));
+		}
+		//最終レーンを全レーンに複製
+		inline static vec_type last(const vec_type v){ return _mm_shuffle_ps(v, v, 0xff); }
+		//1レーンずらして、先頭レーンに c の先頭レーンを入れる
+		inline static vec_type shiftIn(const vec_type v, const vec_type c){ return _mm_move_ss(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)), c); }
+		//ビン番号（0 以下と NaN は 0、last_index 以上は last_index）
+		inline static __m128i toIndex(const vec_type v, const vec_type last_index){ return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), last_index)); }
+		inline static vec_type toPos(const vec_type v, const vec_type min_value, const vec_type scale){ return _mm_mul_ps(_mm_sub_ps(v, min_value), scale); }
+	};
+#endif//GASHA_USE_SSE2
+
+	//----------------------------------------
+	//高速集計処理用：AVX2命令（8要素）の演算
+	//※実行時に振り分ける場合、AVX2命令に対応したCPUでのみ呼び出すこと
+	template<typename T>
+	struct fastScanOpe256
+	{
+		static const bool IS_AVAILABLE = false;
+	};
+#if defined(GASHA_USE_AVX2) || defined(GASHA_DISPATCH_AVX2)
+	//整数型共通
+	template<typename T>
+	struct fastScanOpe256Int
+	{
+		static const bool IS_AVAILABLE = true;
+		static const std::size_t WIDTH = 8;
+		typedef T value_type;
+		typedef __m256i vec_type;
+		GASHA_TARGET_AVX2 inline static vec_type load(const value_type* p){ return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+		GASHA_TARGET_AVX2 inline static void store(value_type* p, const vec_type v){ _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+		GASHA_TARGET_AVX2 inline static vec_type set1(const value_type value){ return _mm256_set1_epi32(static_cast<int>(value)); }
+		GASHA_TARGET_AVX2 inline static vec_type add(const vec_type a, const vec_type b){ return _mm256_add_epi32(a, b); }
+		//レジスタ内の累積和
+		//※128ビットレーン内で累積した後、下位レーンの合計を上位レーンに足す
+		GASHA_TARGET_AVX2 inline static vec_type scan(vec_type v)
+		{
+			v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+			v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+			return _mm256_add_epi32(v, _mm256_shuffle_epi32(_mm256_permute2x128_si256(v, v, 0x08), 0xff));
+		}
+		//最終レーンを全レーンに複製
+		GASHA_TARGET_AVX2 inline static vec_type last(const vec_type v){ return _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(7)); }
+		//1レーンずらして、先頭レーンに c の先頭レーンを入れる
+		GASHA_TARGET_AVX2 inline static vec_type shiftIn(const vec_type v, const vec_type c){ return _mm256_blend_epi32(_mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6)), c, 0x01); }
+	};
+	template<>
+	struct fastScanOpe256<std::int32_t> : public fastScanOpe256Int<std::int32_t>
+	{
+		GASHA_TARGET_AVX2 inline static vec_type min(const vec_type a, const vec_type b){ return _mm256_min_epi32(a, b); }
+		GASHA_TARGET_AVX2 inline static vec_type max(const vec_type a, const vec_type b){ return _mm256_max_epi32(a, b); }
+		GASHA_TARGET_AVX2 inline static __m256i toIndex(const vec_type v, const vec_type last_index){ return _mm256_max_epi32(_mm256_min_epi32(v, last_index), _mm256_setzero_si256()); }
+	};
+	template<>
+	struct fastScanOpe256<std::uint32_t> : public fastScanOpe256Int<std::uint32_t>
+	{
+		GASHA_TARGET_AVX2 inline static vec_type min(const vec_type a, const vec_type b){ return _mm256_min_epu32(a, b); }
+		GASHA_TARGET_AVX2 inline static vec_type max(const vec_type a, const vec_type b){ return _mm256_max_epu32(a, b); }
+		GASHA_TARGET_AVX2 inline static __m256i toIndex(const vec_type v, const vec_type last_index){ return _mm256_min_epu32(v, last_index); }
+	};
+	template<>
+	struct fastScanOpe256<float>
+	{
+		static const bool IS_AVAILABLE = true;
+		static const std::size_t WIDTH = 8;
+		typedef float value_type;
+		typedef __m256 vec_type;
+		GASHA_TARGET_AVX2 inline static vec_type load(const value_type* p){ return _mm256_loadu_ps(p); }
+		GASHA_TARGET_AVX2 inline static void store(value_type* p, const vec_type v){ _mm256_storeu_ps(p, v); }
+		GASHA_TARGET_AVX2 inline static vec_type set1(const value_type value){ return _mm256_set1_ps(value); }
+		GASHA_TARGET_AVX2 inline static vec_type add(const vec_type a, const vec_type b){ return _mm256_add_ps(a, b); }
+		GASHA_TARGET_AVX2 inline static vec_type min(const vec_type a, const vec_type b){ return _mm256_min_ps(a, b); }
+		GASHA_TARGET_AVX2 inline static vec_type max(const vec_type a, const vec_type b){ return _mm256_max_ps(a, b); }
+		//レジスタ内の累積和
+		//※128ビットレーン内で累積した後、下位レーンの合計を上位レーンに足す
+		GASHA_TARGET_AVX2 inline static vec_type scan(vec_type v)
+		{
+			v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 4)));
+			v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 8)));
+			const __m256i v_m256i = _mm256_castps_si256(v);
+			return _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_shuffle_epi32(_mm256_permute2x128_si256(v_m256i, v_m256i, 0x08), 0xff)));
+		}
+		//最終レーンを全レーンに複製
+		GASHA_TARGET_AVX2 inline static vec_type last(const vec_type v){ return _mm256_permutevar8x32_ps(v, _mm256_set1_epi32(7)); }
+		//1レーンずらして、先頭レーンに c の先頭レーンを入れる
+		GASHA_TARGET_AVX2 inline static vec_type shiftIn(const vec_type v, const vec_type c){ return _mm256_blend_ps(_mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6)), c, 0x01); }
+		//ビン番号（0 以下と NaN は 0、last_index 以上は last_index）
+		GASHA_TARGET_AVX2 inline static __m256i toIndex(const vec_type v, const vec_type last_index){ return _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), last_index)); }
+		GASHA_TARGET_AVX2 inline static vec_type toPos(const vec_type v, const vec_type min_value, const vec_type scale){ return _mm256_mul_ps(_mm256_sub_ps(v, min_value), scale); }
+	};
+#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+
+	//----------------------------------------
+	//高速集計処理用：SSE命令版
+	//※先頭から4要素ずつ処理し、処理した要素数を返す（端数は呼び出し元で処理する）
+	template<typename T, bool IS_AVAILABLE = fastScanOpe128<T>::IS_AVAILABLE>
+	struct fastScanSse
+	{
+		inline static std::size_t inclusiveScan(const T* src, T* dst, const std::size_t n, T& sum){ return 0; }
+		inline static std::size_t exclusiveScan(const T* src, T* dst, const std::size_t n, T& sum){ return 0; }
+		template<int REDUCE>
+		inline static std::size_t reduce(const T* src, const std::size_t n, T& result){ return 0; }
+		inline static std::size_t reduceMinMax(const T* src, const std::size_t n, T& min_value, T& max_value){ return 0; }
+		inline static std::size_t histogramIndex(const T* src, const std::size_t n, std::int32_t* index, const int bin_num){ return 0; }
+		inline static std::size_t histogramIndex(const T* src, const std::size_t n, std::int32_t* index, const int bin_num, const T min_value, const T scale){ return 0; }
+	};
+#ifdef GASHA_USE_SSE2
+	template<typename T>
+	struct fastScanSse<T, true>
+	{
+		typedef fastScanOpe128<T> ope;
+		typedef typename ope::vec_type vec_type;
+		static const std::size_t WIDTH = ope::WIDTH;
+		inline static std::size_t inclusiveScan(const T* src, T* dst, const std::size_t n, T& sum)
+		{
+			vec_type carry = ope::set1(sum);
+			std::size_t i = 0;
+			for (; i + WIDTH <= n; i += WIDTH)
+			{
+				carry = ope::add(ope::scan(ope::load(src + i)), carry);
+				ope::store(dst + i, carry);
+				carry = ope::last(carry);
+			}
+			if (i > 0)
+				sum = dst[i - 1];
+			return i;
+		}
+		inline static std::size_t exclusiveScan(const T* src, T* dst, const std::size_t n, T& sum)
+		{
+			vec_type carry = ope::set1(sum);
+			std::size_t i = 0;
+			for (; i + WIDTH <= n; i += WIDTH)
+			{
+				const vec_type total = ope::add(ope::scan(ope::load(src + i)), carry);
+				ope::store(dst + i, ope::shiftIn(total, carry));
+				carry = ope::last(total);
+			}
+			T carry_array[WIDTH];
+			ope::store(carry_array, carry);
+			sum = carry_array[0];
+			return i;
+		}
+		template<int REDUCE>
+		inline static std::size_t reduce(const T* src, const std::size_t n, T& result)
+		{
+			if (n < WIDTH)
+				return 0;
+			//2系統で集計して、依存待ちを抑える
+			vec_type acc0 = ope::load(src);
+			vec_type acc1 = REDUCE == FAST_REDUCE_SUM ? ope::set1(T()) : acc0;
+			std::size_t i = WIDTH;
+			for (; i + WIDTH * 2 <= n; i += WIDTH * 2)
+			{
+				const vec_type v0 = ope::load(src + i);
+				const vec_type v1 = ope::load(src + i + WIDTH);
+				acc0 = REDUCE == FAST_REDUCE_SUM ? ope::add(acc0, v0) : REDUCE == FAST_REDUCE_MIN ? ope::min(acc0, v0) : ope::max(acc0, v0);
+				acc1 = REDUCE == FAST_REDUCE_SUM ? ope::add(acc1, v1) : REDUCE == FAST_REDUCE_MIN ? ope::min(acc1, v1) : ope::max(acc1, v1);
+			}
+			if (i + WIDTH <= n)
+			{
+				const vec_type v0 = ope::load(src + i);
+				acc0 = REDUCE == FAST_REDUCE_SUM ? ope::add(acc0, v0) : REDUCE == FAST_REDUCE_MIN ? ope::min(acc0, v0) : ope::max(acc0, v0);
+				i += WIDTH;
+			}
+			acc0 = REDUCE == FAST_REDUCE_SUM ? ope::add(acc0, acc1) : REDUCE == FAST_REDUCE_MIN ? ope::min(acc0, acc1) : ope::max(acc0, acc1);
+			T acc_array[WIDTH];
+			ope::store(acc_array, acc0);
+			for (std::size_t lane = 0; lane < WIDTH; ++lane)
+				result = fastReduceCalc<REDUCE>(result, acc_array[lane]);
+			return i;
+		}
+		inline static std::size_t reduceMinMax(const T* src, const std::size_t n, T& min_value, T& max_value)
+		{
+			if (n < WIDTH)
+				return 0;
+			vec_type min_acc = ope::load(src);
+			vec_type max_acc = min_acc;
+			std::size_t i = WIDTH;
+			for (; i + WIDTH <= n; i += WIDTH)
+			{
+				const vec_type v = ope::load(src + i);
+				min_acc = ope::min(min_acc, v);
+				max_acc = ope::max(max_acc, v);
+			}
+			T min_array[WIDTH];
+			T max_array[WIDTH];
+			ope::store(min_array, min_acc);
+			ope::store(max_array, max_acc);
+			for (std::size_t lane = 0; lane < WIDTH; ++lane)
+			{
+				min_value = fastReduceCalc<FAST_REDUCE_MIN>(min_value, min_array[lane]);
+				max_value = fastReduceCalc<FAST_REDUCE_MAX>(max_value, max_array[lane]);
+			}
+			return i;
+		}
+		inline static std::size_t histogramIndex(const T* src, const std::size_t n, std::int32_t* index, const int bin_num)
+		{
+			const vec_type last_index = ope::set1(static_cast<T>(bin_num - 1));
+			std::size_t i = 0;
+			for (; i + WIDTH <= n; i += WIDTH)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(index + i), ope::toIndex(ope::load(src + i), last_index));
+			return i;
+		}
+		inline static std::size_t histogramIndex(const T* src, const std::size_t n, std::int32_t* index, const int bin_num, const T min_value, const T scale)
+		{
+			const vec_type last_index = ope::set1(static_cast<T>(bin_num - 1));
+			const vec_type min_value_vec = ope::set1(min_value);
+			const vec_type scale_vec = ope::set1(scale);
+			std::size_t i = 0;
+			for (; i + WIDTH <= n; i += WIDTH)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(index + i), ope::toIndex(ope::toPos(ope::load(src + i), min_value_vec, scale_vec), last_index));
+			return i;
+		}
+	};
+
+#endif//GASHA_USE_SSE2
+
+	//----------------------------------------
+	//高速集計処理用：AVX2命令版
+	//※先頭から8要素ずつ処理し、処理した要素数を返す（端数は呼び出し元で処理する）
+	//※実行時に振り分ける場合、AVX2命令に対応したCPUでのみ呼び出すこと
+	template<typename T, bool IS_AVAILABLE = fastScanOpe256<T>::IS_AVAILABLE>
+	struct fastScanAvx2 : public fastScanSse<T, false>
+	{};
+#if defined(GASHA_USE_AVX2) || defined(GASHA_DISPATCH_AVX2)
+	template<typename T>
+	struct fastScanAvx2<T, true>
+	{
+		typedef fastScanOpe256<T> ope;
+		typedef typename ope::vec_type vec_type;
+		static const std::size_t WIDTH = ope::WIDTH;
+		GASHA_TARGET_AVX2 inline static std::size_t inclusiveScan(const T* src, T* dst, const std::size_t n, T& sum)
+		{
+			vec_type carry = ope::set1(sum);
+			std::size_t i = 0;
+			for (; i + WIDTH <= n; i += WIDTH)
+			{
+				carry = ope::add(ope::scan(ope::load(src + i)), carry);
+				ope::store(dst + i, carry);
+				carry = ope::last(carry);
+			}
+			if (i > 0)
+				sum = dst[i - 1];
+			return i;
+		}
+		GASHA_TARGET_AVX2 inline static std::size_t exclusiveScan(const T* src, T* dst, const std::size_t n, T& sum)
+		{
+			vec_type carry = ope::set1(sum);
+			std::size_t i = 0;
+			for (; i + WIDTH <= n; i += WIDTH)
+			{
+				const vec_type total = ope::add(ope::scan(ope::load(src + i)), carry);
+				ope::store(dst + i, ope::shiftIn(total, carry));
+				carry = ope::last(total);
+			}
+			T carry_array[WIDTH];
+			ope::store(carry_array, carry);
+			sum = carry_array[0];
+			return i;
+		}
+		template<int REDUCE>
+		GASHA_TARGET_AVX2 inline static std::size_t reduce(const T* src, const std::size_t n, T& result)
+		{
+			if (n < WIDTH)
+				return 0;
+			//2系統で集計して、依存待ちを抑える
+			vec_type acc0 = ope::load(src);
+			vec_type acc1 = REDUCE == FAST_REDUCE_SUM ? ope::set1(T()) : acc0;
+			std::size_t i = WIDTH;
+			for (; i + WIDTH * 2 <= n; i += WIDTH * 2)
+			{
+				const vec_type v0 = ope::load(src + i);
+				const vec_type v1 = ope::load(src + i + WIDTH);
+				acc0 = REDUCE == FAST_REDUCE_SUM ? ope::add(acc0, v0) : REDUCE == FAST_REDUCE_MIN ? ope::min(acc0, v0) : ope::max(acc0, v0);
+				acc1 = REDUCE == FAST_REDUCE_SUM ? ope::add(acc1, v1) : REDUCE == FAST_REDUCE_MIN ? ope::min(acc1, v1) : ope::max(acc1, v1);
+			}
+			if (i + WIDTH <= n)
+			{
+				const vec_type v0 = ope::load(src + i);
+				acc0 = REDUCE == FAST_REDUCE_SUM ? ope::add(acc0, v0) : REDUCE == FAST_REDUCE_MIN ? ope::min(acc0, v0) : ope::max(acc0, v0);
+				i += WIDTH;
+			}
+			acc0 = REDUCE == FAST_REDUCE_SUM ? ope::add(acc0, acc1) : REDUCE == FAST_REDUCE_MIN ? ope::min(acc0, acc1) : ope::max(acc0, acc1);
+			T acc_array[WIDTH];
+			ope::store(acc_array, acc0);
+			for (std::size_t lane = 0; lane < WIDTH; ++lane)
+				result = fastReduceCalc<REDUCE>(result, acc_array[lane]);
+			return i;
+		}
+		GASHA_TARGET_AVX2 inline static std::size_t reduceMinMax(const T* src, const std::size_t n, T& min_value, T& max_value)
+		{
+			if (n < WIDTH)
+				return 0;
+			vec_type min_acc = ope::load(src);
+			vec_type max_acc = min_acc;
+			std::size_t i = WIDTH;
+			for (; i + WIDTH <= n; i += WIDTH)
+			{
+				const vec_type v = ope::load(src + i);
+				min_acc = ope::min(min_acc, v);
+				max_acc = ope::max(max_acc, v);
+			}
+			T min_array[WIDTH];
+			T max_array[WIDTH];
+			ope::store(min_array, min_acc);
+			ope::store(max_array, max_acc);
+			for (std::size_t lane = 0; lane < WIDTH; ++lane)
+			{
+				min_value = fastReduceCalc<FAST_REDUCE_MIN>(min_value, min_array[lane]);
+				max_value = fastReduceCalc<FAST_REDUCE_MAX>(max_value, max_array[lane]);
+			}
+			return i;
+		}
+		GASHA_TARGET_AVX2 inline static std::size_t histogramIndex(const T* src, const std::size_t n, std::int32_t* index, const int bin_num)
+		{
+			const vec_type last_index = ope::set1(static_cast<T>(bin_num - 1));
+			std::size_t i = 0;
+			for (; i + WIDTH <= n; i += WIDTH)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(index + i), ope::toIndex(ope::load(src + i), last_index));
+			return i;
+		}
+		GASHA_TARGET_AVX2 inline static std::size_t histogramIndex(const T* src, const std::size_t n, std::int32_t* index, const int bin_num, const T min_value, const T scale)
+		{
+			const vec_type last_index = ope::set1(static_cast<T>(bin_num - 1));
+			const vec_type min_value_vec = ope::set1(min_value);
+			const vec_type scale_vec = ope::set1(scale);
+			std::size_t i = 0;
+			for (; i + WIDTH <= n; i += WIDTH)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(index + i), ope::toIndex(ope::toPos(ope::load(src + i), min_value_vec, scale_vec), last_index));
+			return i;
+		}
+	};
+#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+
+	//----------------------------------------
+	//高速集計処理用：SIMD命令版の振り分け
+	//※AVX2命令が使用可能ならAVX2命令版を、そうでなければSSE命令版を使用する
+	//※処理した要素数を返す（SIMD命令版がなければ 0）
+	template<typename T>
+	inline bool fastScanIsAVX2()
+	{
+	#if defined(GASHA_USE_AVX2)
+		return fastScanOpe256<T>::IS_AVAILABLE;
+	#elif defined(GASHA_DISPATCH_AVX2)
+		return fastScanOpe256<T>::IS_AVAILABLE && GASHA_ cpuFeatures::instance().hasAVX2();//実行時に判定（CPU機能の判定は初回のみ）
+	#else//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+		return false;
+	#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+	}
+	template<typename T>
+	struct fastScanSimd
+	{
+		inline static std::size_t inclusiveScan(const T* src, T* dst, const std::size_t n, T& sum)
+		{
+			return fastScanIsAVX2<T>() ? fastScanAvx2<T>::inclusiveScan(src, dst, n, sum) : fastScanSse<T>::inclusiveScan(src, dst, n, sum);
+		}
+		inline static std::size_t exclusiveScan(const T* src, T* dst, const std::size_t n, T& sum)
+		{
+			return fastScanIsAVX2<T>() ? fastScanAvx2<T>::exclusiveScan(src, dst, n, sum) : fastScanSse<T>::exclusiveScan(src, dst, n, sum);
+		}
+		template<int REDUCE>
+		inline static std::size_t reduce(const T* src, const std::size_t n, T& result)
+		{
+			return fastScanIsAVX2<T>() ? fastScanAvx2<T>::template reduce<REDUCE>(src, n, result) : fastScanSse<T>::template reduce<REDUCE>(src, n, result);
+		}
+		inline static std::size_t reduceMinMax(const T* src, const std::size_t n, T& min_value, T& max_value)
+		{
+			return fastScanIsAVX2<T>() ? fastScanAvx2<T>::reduceMinMax(src, n, min_value, max_value) : fastScanSse<T>::reduceMinMax(src, n, min_value, max_value);
+		}
+		inline static std::size_t histogramIndex(const T* src, const std::size_t n, std::int32_t* index, const int bin_num)
+		{
+			return fastScanIsAVX2<T>() ? fastScanAvx2<T>::histogramIndex(src, n, index, bin_num) : fastScanSse<T>::histogramIndex(src, n, index, bin_num);
+		}
+		//範囲指定版（float のみSIMD命令で処理する）
+		template<typename CALC_TYPE>
+		inline static std::size_t histogramIndex(const T* src, const std::size_t n, std::int32_t* index, const int bin_num, const CALC_TYPE min_value, const CALC_TYPE scale){ return 0; }
+		inline static std::size_t histogramIndex(const float* src, const std::size_t n, std::int32_t* index, const int bin_num, const float min_value, const float scale)
+		{
+			return fastScanIsAVX2<float>() ? fastScanAvx2<float>::histogramIndex(src, n, index, bin_num, min_value, scale) : fastScanSse<float>::histogramIndex(src, n, index, bin_num, min_value, scale);
+		}
+	};
+
+	//----------------------------------------
+	//高速集計処理用：処理本体
+
+	//包含的累積和
+	template<typename T>
+	inline T inclusiveScan(const T* src, T* dst, const std::size_t n, T sum)
+	{
+		std::size_t i = fastScanSimd<T>::inclusiveScan(src, dst, n, sum);
+		for (; i < n; ++i)
+		{
+			sum = static_cast<T>(sum + src[i]);
+			dst[i] = sum;
+		}
+		return sum;
+	}
+	//排他的累積和
+	template<typename T>
+	inline T exclusiveScan(const T* src, T* dst, const std::size_t n, T sum)
+	{
+		std::size_t i = fastScanSimd<T>::exclusiveScan(src, dst, n, sum);
+		for (; i < n; ++i)
+		{
+			const T value = src[i];
+			dst[i] = sum;
+			sum = static_cast<T>(sum + value);
+		}
+		return sum;
+	}
+	//リダクション
+	template<int REDUCE, typename T>
+	inline T reduce(const T* src, const std::size_t n, T result)
+	{
+		std::size_t i = fastScanSimd<T>::template reduce<REDUCE>(src, n, result);
+		for (; i < n; ++i)
+			result = fastReduceCalc<REDUCE>(result, src[i]);
+		return result;
+	}
+	//最小と最大
+	template<typename T>
+	inline void reduceMinMax(const T* src, const std::size_t n, T& min_value, T& max_value)
+	{
+		std::size_t i = fastScanSimd<T>::reduceMinMax(src, n, min_value, max_value);
+		for (; i < n; ++i)
+		{
+			min_value = fastReduceCalc<FAST_REDUCE_MIN>(min_value, src[i]);
+			max_value = fastReduceCalc<FAST_REDUCE_MAX>(max_value, src[i]);
+		}
+	}
+	//ヒストグラム
+	//※CALC_INDEX ... void calc_index(const T* src, const std::size_t n, std::int32_t* index)//ビン番号を算出
+	template<typename T, class CALC_INDEX>
+	void histogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num, CALC_INDEX calc_index)
+	{
+		std::memset(counts, 0, sizeof(std::size_t) * bin_num);
+		std::int32_t index[HISTOGRAM_BLOCK_SIZE];
+		if (bin_num > HISTOGRAM_SMALL_BIN_NUM)
+		{
+			for (std::size_t begin = 0; begin < n; begin += HISTOGRAM_BLOCK_SIZE)
+			{
+				const std::size_t block_n = n - begin < HISTOGRAM_BLOCK_SIZE ? n - begin : HISTOGRAM_BLOCK_SIZE;
+				calc_index(src + begin, block_n, index);
+				for (std::size_t i = 0; i < block_n; ++i)
+					++counts[index[i]];
+			}
+			return;
+		}
+		//少数のビンの場合、作業用ヒストグラムに交互に集計
+		std::size_t sub_counts[HISTOGRAM_SUB_NUM][HISTOGRAM_SMALL_BIN_NUM];
+		for (int sub = 0; sub < HISTOGRAM_SUB_NUM; ++sub)
+			std::memset(sub_counts[sub], 0, sizeof(std::size_t) * bin_num);
+		for (std::size_t begin = 0; begin < n; begin += HISTOGRAM_BLOCK_SIZE)
+		{
+			const std::size_t block_n = n - begin < HISTOGRAM_BLOCK_SIZE ? n - begin : HISTOGRAM_BLOCK_SIZE;
+			calc_index(src + begin, block_n, index);
+			std::size_t i = 0;
+			for (; i + HISTOGRAM_SUB_NUM <= block_n; i += HISTOGRAM_SUB_NUM)
+			{
+				++sub_counts[0][index[i + 0]];
+				++sub_counts[1][index[i + 1]];
+				++sub_counts[2][index[i + 2]];
+				++sub_counts[3][index[i + 3]];
+			}
+			for (; i < block_n; ++i)
+				++sub_counts[0][index[i]];
+		}
+		for (int bin = 0; bin < bin_num; ++bin)
+			counts[bin] = sub_counts[0][bin] + sub_counts[1][bin] + sub_counts[2][bin] + sub_counts[3][bin];
+	}
+	//ヒストグラム（整数版）
+	template<typename T>
+	inline void histogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num)
+	{
+		histogram(src, n, counts, bin_num,
+			[bin_num](const T* block_src, const std::size_t block_n, std::int32_t* index)
+			{
+				std::size_t i = fastScanSimd<T>::histogramIndex(block_src, block_n, index, bin_num);
+				for (; i < block_n; ++i)
+					index[i] = fastHistogramIndex(block_src[i], bin_num);
+			}
+		);
+	}
+	//ヒストグラム（範囲指定版）
+	template<typename T>
+	inline void histogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num, const T min_value, const T max_value)
+	{
+		typedef typename fastHistogramCalcType<T>::type calc_type;
+		if (!(min_value < max_value))//範囲が空なら全て先頭のビン
+		{
+			std::memset(counts, 0, sizeof(std::size_t) * bin_num);
+			counts[0] = n;
+			return;
+		}
+		const calc_type min_value_c = static_cast<calc_type>(min_value);
+		const calc_type scale = static_cast<calc_type>(bin_num) / (static_cast<calc_type>(max_value) - min_value_c);
+		histogram(src, n, counts, bin_num,
+			[bin_num, min_value_c, scale](const T* block_src, const std::size_t block_n, std::int32_t* index)
+			{
+				std::size_t i = fastScanSimd<T>::histogramIndex(block_src, block_n, index, bin_num, min_value_c, scale);
+				for (; i < block_n; ++i)
+					index[i] = fastHistogramIndex(block_src[i], bin_num, min_value_c, scale);
+			}
+		);
+	}
+
+	//----------------------------------------
+	//高速集計処理用：並列処理
+
+	//並列処理のブロック数を取得
+	//※並列化しない場合は 1 を返す
+	inline int parallelFastScanBlockNum(const std::size_t n)
+	{
+	#ifdef _OPENMP
+		if (n < PARALLEL_FAST_SCAN_SIZE_THRESHOLD)
+			return 1;
+		const int thread_num = omp_get_max_threads();
+		return thread_num < PARALLEL_FAST_SCAN_BLOCK_NUM_MAX ? thread_num : PARALLEL_FAST_SCAN_BLOCK_NUM_MAX;
+	#else//_OPENMP
+		return 1;
+	#endif//_OPENMP
+	}
+	//ブロックの範囲を取得
+	inline void parallelFastScanBlockRange(const std::size_t n, const int block_num, const int block, std::size_t& begin, std::size_t& end)
+	{
+		const std::size_t block_size = (n + block_num - 1) / block_num;
+		begin = block_size * block;
+		begin = begin < n ? begin : n;
+		end = begin + block_size < n ? begin + block_size : n;
+	}
+	//累積和
+	template<bool IS_EXCLUSIVE, typename T>
+	T parallelScan(const T* src, T* dst, const std::size_t n, const T init)
+	{
+		const int block_num = parallelFastScanBlockNum(n);
+		if (block_num <= 1)
+			return IS_EXCLUSIVE ? exclusiveScan(src, dst, n, init) : inclusiveScan(src, dst, n, init);
+		//1. ブロックごとの合計を並列に算出
+		T block_offset[PARALLEL_FAST_SCAN_BLOCK_NUM_MAX];
+	#pragma omp parallel for
+		for (int block = 0; block < block_num; ++block)
+		{
+			std::size_t begin, end;
+			parallelFastScanBlockRange(n, block_num, block, begin, end);
+			block_offset[block] = reduce<FAST_REDUCE_SUM>(src + begin, end - begin, T());
+		}
+		//ブロックの合計を累積して、ブロックごとの初期値にする
+		T sum = init;
+		for (int block = 0; block < block_num; ++block)
+		{
+			const T block_sum = block_offset[block];
+			block_offset[block] = sum;
+			sum = static_cast<T>(sum + block_sum);
+		}
+		//2. ブロックごとの累積和を並列に算出
+	#pragma omp parallel for
+		for (int block = 0; block < block_num; ++block)
+		{
+			std::size_t begin, end;
+			parallelFastScanBlockRange(n, block_num, block, begin, end);
+			if (IS_EXCLUSIVE)
+				exclusiveScan(src + begin, dst + begin, end - begin, block_offset[block]);
+			else
+				inclusiveScan(src + begin, dst + begin, end - begin, block_offset[block]);
+		}
+		return sum;
+	}
+	//リダクション
+	template<int REDUCE, typename T>
+	T parallelReduce(const T* src, const std::size_t n)
+	{
+		const int block_num = parallelFastScanBlockNum(n);
+		if (block_num <= 1)
+			return reduce<REDUCE>(src, n, fastReduceInit<REDUCE, T>());
+		T block_result[PARALLEL_FAST_SCAN_BLOCK_NUM_MAX];
+	#pragma omp parallel for
+		for (int block = 0; block < block_num; ++block)
+		{
+			std::size_t begin, end;
+			parallelFastScanBlockRange(n, block_num, block, begin, end);
+			block_result[block] = reduce<REDUCE>(src + begin, end - begin, fastReduceInit<REDUCE, T>());
+		}
+		T result = fastReduceInit<REDUCE, T>();
+		for (int block = 0; block < block_num; ++block)
+			result = fastReduceCalc<REDUCE>(result, block_result[block]);
+		return result;
+	}
+	//最小と最大
+	template<typename T>
+	void parallelReduceMinMax(const T* src, const std::size_t n, T& min_value, T& max_value)
+	{
+		min_value = fastReduceInit<FAST_REDUCE_MIN, T>();
+		max_value = fastReduceInit<FAST_REDUCE_MAX, T>();
+		const int block_num = parallelFastScanBlockNum(n);
+		if (block_num <= 1)
+		{
+			reduceMinMax(src, n, min_value, max_value);
+			return;
+		}
+		T block_min[PARALLEL_FAST_SCAN_BLOCK_NUM_MAX];
+		T block_max[PARALLEL_FAST_SCAN_BLOCK_NUM_MAX];
+	#pragma omp parallel for
+		for (int block = 0; block < block_num; ++block)
+		{
+			std::size_t begin, end;
+			parallelFastScanBlockRange(n, block_num, block, begin, end);
+			block_min[block] = fastReduceInit<FAST_REDUCE_MIN, T>();
+			block_max[block] = fastReduceInit<FAST_REDUCE_MAX, T>();
+			reduceMinMax(src + begin, end - begin, block_min[block], block_max[block]);
+		}
+		for (int block = 0; block < block_num; ++block)
+		{
+			min_value = fastReduceCalc<FAST_REDUCE_MIN>(min_value, block_min[block]);
+			max_value = fastReduceCalc<FAST_REDUCE_MAX>(max_value, block_max[block]);
+		}
+	}
+	//ヒストグラム
+	//※HISTOGRAM ... void histogram(const T* src, const std::size_t n, std::size_t* counts)//非並列版のヒストグラム
+	template<typename T, class HISTOGRAM>
+	void parallelHistogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num, HISTOGRAM histogram)
+	{
+		const int block_num = parallelFastScanBlockNum(n);
+		std::size_t* block_counts = block_num > 1 ? new(std::nothrow) std::size_t[static_cast<std::size_t>(block_num) * bin_num] : nullptr;
+		if (!block_counts)//並列化しない場合や、メモリ確保に失敗した場合は、非並列版に切り替え
+		{
+			histogram(src, n, counts);
+			return;
+		}
+		//ブロックごとに並列に集計
+	#pragma omp parallel for
+		for (int block = 0; block < block_num; ++block)
+		{
+			std::size_t begin, end;
+			parallelFastScanBlockRange(n, block_num, block, begin, end);
+			histogram(src + begin, end - begin, block_counts + static_cast<std::size_t>(block) * bin_num);
+		}
+		//合算
+		for (int bin = 0; bin < bin_num; ++bin)
+		{
+			std::size_t count = 0;
+			for (int block = 0; block < block_num; ++block)
+				count += block_counts[static_cast<std::size_t>(block) * bin_num + bin];
+			counts[bin] = count;
+		}
+		delete[] block_counts;//メモリ破棄
+	}
+}//namespace _private
+
+//----------------------------------------
+//累積和（スキャン）
+
+//包含的累積和
+template<typename T>
+inline T inclusiveScan(const T* src, T* dst, const std::size_t n, const T init)
+{
+	if (!src || !dst)
+		return init;
+	return _private::inclusiveScan(src, dst, n, init);
+}
+//排他的累積和
+template<typename T>
+inline T exclusiveScan(const T* src, T* dst, const std::size_t n, const T init)
+{
+	if (!src || !dst)
+		return init;
+	return _private::exclusiveScan(src, dst, n, init);
+}
+
+//----------------------------------------
+//リダクション
+
+//合計
+template<typename T>
+inline T reduceSum(const T* src, const std::size_t n)
+{
+	if (!src)
+		return T();
+	return _private::reduce<_private::FAST_REDUCE_SUM>(src, n, T());
+}
+//最小
+template<typename T>
+inline T reduceMin(const T* src, const std::size_t n)
+{
+	if (!src)
+		return _private::fastReduceInit<_private::FAST_REDUCE_MIN, T>();
+	return _private::reduce<_private::FAST_REDUCE_MIN>(src, n, _private::fastReduceInit<_private::FAST_REDUCE_MIN, T>());
+}
+//最大
+template<typename T>
+inline T reduceMax(const T* src, const std::size_t n)
+{
+	if (!src)
+		return _private::fastReduceInit<_private::FAST_REDUCE_MAX, T>();
+	return _private::reduce<_private::FAST_REDUCE_MAX>(src, n, _private::fastReduceInit<_private::FAST_REDUCE_MAX, T>());
+}
+//最小と最大
+template<typename T>
+inline void reduceMinMax(const T* src, const std::size_t n, T& min_value, T& max_value)
+{
+	min_value = _private::fastReduceInit<_private::FAST_REDUCE_MIN, T>();
+	max_value = _private::fastReduceInit<_private::FAST_REDUCE_MAX, T>();
+	if (!src)
+		return;
+	_private::reduceMinMax(src, n, min_value, max_value);
+}
+
+//----------------------------------------
+//ヒストグラム
+
+//整数版
+template<typename T>
+inline void histogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num)
+{
+	if (!counts || bin_num <= 0)
+		return;
+	if (!src)
+	{
+		std::memset(counts, 0, sizeof(std::size_t) * bin_num);
+		return;
+	}
+	_private::histogram(src, n, counts, bin_num);
+}
+//範囲指定版
+template<typename T>
+inline void histogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num, const T min_value, const T max_value)
+{
+	if (!counts || bin_num <= 0)
+		return;
+	if (!src)
+	{
+		std::memset(counts, 0, sizeof(std::size_t) * bin_num);
+		return;
+	}
+	_private::histogram(src, n, counts, bin_num, min_value, max_value);
+}
+
+//----------------------------------------
+//並列版
+
+template<typename T>
+inline T parallelInclusiveScan(const T* src, T* dst, const std::size_t n, const T init)
+{
+	if (!src || !dst)
+		return init;
+	return _private::parallelScan<false>(src, dst, n, init);
+}
+template<typename T>
+inline T parallelExclusiveScan(const T* src, T* dst, const std::size_t n, const T init)
+{
+	if (!src || !dst)
+		return init;
+	return _private::parallelScan<true>(src, dst, n, init);
+}
+template<typename T>
+inline T parallelReduceSum(const T* src, const std::size_t n)
+{
+	if (!src)
+		return T();
+	return _private::parallelReduce<_private::FAST_REDUCE_SUM>(src, n);
+}
+template<typename T>
+inline T parallelReduceMin(const T* src, const std::size_t n)
+{
+	if (!src)
+		return _private::fastReduceInit<_private::FAST_REDUCE_MIN, T>();
+	return _private::parallelReduce<_private::FAST_REDUCE_MIN>(src, n);
+}
+template<typename T>
+inline T parallelReduceMax(const T* src, const std::size_t n)
+{
+	if (!src)
+		return _private::fastReduceInit<_private::FAST_REDUCE_MAX, T>();
+	return _private::parallelReduce<_private::FAST_REDUCE_MAX>(src, n);
+}
+template<typename T>
+inline void parallelReduceMinMax(const T* src, const std::size_t n, T& min_value, T& max_value)
+{
+	if (!src)
+	{
+		min_value = _private::fastReduceInit<_private::FAST_REDUCE_MIN, T>();
+		max_value = _private::fastReduceInit<_private::FAST_REDUCE_MAX, T>();
+		return;
+	}
+	_private::parallelReduceMinMax(src, n, min_value, max_value);
+}
+template<typename T>
+inline void parallelHistogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num)
+{
+	if (!src || !counts || bin_num <= 0)
+	{
+		GASHA_ histogram(src, n, counts, bin_num);
+		return;
+	}
+	_private::parallelHistogram(src, n, counts, bin_num,
+		[bin_num](const T* block_src, const std::size_t block_n, std::size_t* block_counts)
+		{
+			_private::histogram(block_src, block_n, block_counts, bin_num);
+		}
+	);
+}
+template<typename T>
+inline void parallelHistogram(const T* src, const std::size_t n, std::size_t* counts, const int bin_num, const T min_value, const T max_value)
+{
+	if (!src || !counts || bin_num <= 0)
+	{
+		GASHA_ histogram(src, n, counts, bin_num, min_value, max_value);
+		return;
+	}
+	_private::parallelHistogram(src, n, counts, bin_num,
+		[bin_num, min_value, max_value](const T* block_src, const std::size_t block_n, std::size_t* block_counts)
+		{
+			_private::histogram(block_src, block_n, block_counts, bin_num, min_value, max_value);
+		}
+	);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_FAST_SCAN_INL
+
+// End of file
@@ -87,6 +87,10 @@ inline const char* strncpy_fast(char* dst, const char* src, const std::size_t ma
 //------------------------------------------------------------------------------
 //SSE版
 //------------------------------------------------------------------------------
+//※ビルド設定 GASHA_USE_RUNTIME_CPU_DISPATCH が有効で、SSE4.2命令がコンパイル時に無効な場合、
+//　strlen_sse, strstr_sse は、初回呼び出し時にCPUのSSE4.2命令対応を判定し、SSE版か通常版を選択する。
+//　（高速版の strlen_fast, strstr_fast も、この振り分けを利用する）
+//------------------------------------------------------------------------------
 
 //----------------------------------------
 //SSE版strlen
@@ -20,9 +20,13 @@
 
 #include <cstdint>//std::intptr_t
 
-#ifdef GASHA_USE_SSE4_2
+#if defined(GASHA_USE_SSE4_2) || defined(GASHA_FAST_STRING_DISPATCH_SSE4_2)
 #include <nmmintrin.h>//SSE4.2
-#endif//GASHA_USE_SSE4_2
+#endif//GASHA_USE_SSE4_2, GASHA_FAST_STRING_DISPATCH_SSE4_2
+
+#ifdef GASHA_FAST_STRING_DISPATCH_SSE4_2
+#include <gasha/cpu_features.h>//CPU機能判定
+#endif//GASHA_FAST_STRING_DISPATCH_SSE4_2
 
 GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 
@@ -34,7 +38,7 @@ GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 //高速版strlen
 inline std::size_t strlen_fast(const char* str)
 {
-#ifdef GASHA_STRLEN_FAST_USE_SSE4_2
+#if defined(GASHA_STRLEN_FAST_USE_SSE4_2) || defined(GASHA_STRLEN_FAST_DISPATCH_SSE4_2)
 	return GASHA_ strlen_sse(str);
 #else//GASHA_STRLEN_FAST_USE_SSE4_2
 	return GASHA_ strlen(str);
@@ -100,7 +104,7 @@ inline const char* strrchr_fast(const char* str, const char c)
 //高速版strstr
 inline const char* strstr_fast(const char* str, const char* pattern)
 {
-#ifdef GASHA_STRSTR_FAST_USE_SSE4_2
+#if defined(GASHA_STRSTR_FAST_USE_SSE4_2) || defined(GASHA_STRSTR_FAST_DISPATCH_SSE4_2)
 	return GASHA_ strstr_sse(str, pattern);
 #else//GASHA_STRSTR_FAST_USE_SSE4_2
 	return GASHA_ strstr(str, pattern);
@@ -157,38 +161,58 @@ inline const char* strncpy_fast(char* dst, const char* src, const std::size_t ma
 
 //----------------------------------------
 //SSE版strlen
-#ifdef GASHA_USE_SSE4_2
-inline std::size_t strlen_sse(const char* str)
+#if defined(GASHA_USE_SSE4_2) || defined(GASHA_FAST_STRING_DISPATCH_SSE4_2)
+namespace _private
 {
+	//SSE4.2命令版strlen
+	//※SSE4.2命令に対応したCPUでのみ呼び出すこと
+	GASHA_TARGET_SSE4_2 inline std::size_t strlen_sse4_2(const char* str)
+	{
 //nullチェックしない
 //	if (!str)
 //		return 0;
-	static const int flags = _SIDD_SBYTE_OPS | _SIDD_CMP_EQUAL_EACH | _SIDD_POSITIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT;
-	const __m128i null = _mm_setzero_si128();
-	const char* p = str;
-	const std::size_t str_over = reinterpret_cast<std::intptr_t>(str)& 0xf;
-	if (str_over != 0)
-	{
-		//非16バイトアランイメント時
-		const __m128i str16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
-		const int         zf  = _mm_cmpistrz(null, str16, flags);//※この二行は、コンパイル後は1回の cmpistri になる（はず）
-		const std::size_t pos = _mm_cmpistri(null, str16, flags);
-		if (zf)
-			return pos;
-		p += (16 - str_over);
-	}
-	//16バイトアランイメント時
-	const __m128i* p128 = reinterpret_cast<const __m128i*>(p);
-	while (true)
-	{
-		const __m128i str16 = _mm_load_si128(p128);
-		const int         zf  = _mm_cmpistrz(null, str16, flags);//※この二行は、コンパイル後は1回の cmpistri になる（はず）
-		const std::size_t pos = _mm_cmpistri(null, str16, flags);
-		if (zf)
-			return (reinterpret_cast<const char*>(p128)-str) + pos;
-		++p128;
+		static const int flags = _SIDD_SBYTE_OPS | _SIDD_CMP_EQUAL_EACH | _SIDD_POSITIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT;
+		const __m128i null = _mm_setzero_si128();
+		const char* p = str;
+		const std::size_t str_over = reinterpret_cast<std::intptr_t>(str)& 0xf;
+		if (str_over != 0)
+		{
+			//非16バイトアランイメント時
+			const __m128i str16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const int         zf  = _mm_cmpistrz(null, str16, flags);//※この二行は、コンパイル後は1回の cmpistri になる（はず）
+			const std::size_t pos = _mm_cmpistri(null, str16, flags);
+			if (zf)
+				return pos;
+			p += (16 - str_over);
+		}
+		//16バイトアランイメント時
+		const __m128i* p128 = reinterpret_cast<const __m128i*>(p);
+		while (true)
+		{
+			const __m128i str16 = _mm_load_si128(p128);
+			const int         zf  = _mm_cmpistrz(null, str16, flags);//※この二行は、コンパイル後は1回の cmpistri になる（はず）
+			const std::size_t pos = _mm_cmpistri(null, str16, flags);
+			if (zf)
+				return (reinterpret_cast<const char*>(p128)-str) + pos;
+			++p128;
+		}
+		return 0;//dummy
 	}
-	return 0;//dummy
+}//namespace _private
+#endif//GASHA_USE_SSE4_2, GASHA_FAST_STRING_DISPATCH_SSE4_2
+#ifdef GASHA_USE_SSE4_2
+inline std::size_t strlen_sse(const char* str)
+{
+	return _private::strlen_sse4_2(str);
+}
+#elif defined(GASHA_FAST_STRING_DISPATCH_SSE4_2)//GASHA_USE_SSE4_2
+inline std::size_t strlen_sse(const char* str)
+{
+	//実行時のCPU機能判定による振り分け
+	//※初回呼び出し時に関数を選択し、以後は関数ポインタ経由で呼び出す
+	typedef std::size_t(*func_type)(const char*);
+	static const func_type func = GASHA_ cpuFeatures::instance().hasSSE4_2() ? static_cast<func_type>(_private::strlen_sse4_2) : static_cast<func_type>(GASHA_ strlen);
+	return func(str);
 }
 #else//GASHA_USE_SSE4_2
 inline std::size_t strlen_sse(const char* str)
@@ -441,6 +465,70 @@ inline const char* strstr_sse(const char* str, const char* pattern)
 {
 	return _private::strstr_sse(str, pattern);
 }
+#elif defined(GASHA_FAST_STRING_DISPATCH_SSE4_2)//GASHA_USE_SSE4_2
+namespace _private
+{
+	//SSE4.2命令版strstr補助関数
+	//※パターン全体が一致するか判定
+	inline bool strstr_sse4_2_match(const char* str, const char* pattern)
+	{
+		for (; *pattern != '\0'; ++str, ++pattern)
+		{
+			if (*str != *pattern)
+				return false;
+		}
+		return true;
+	}
+	//SSE4.2命令版strstr
+	//※パターンの先頭16文字で候補位置を検索し、候補位置ごとにパターン全体を照合する
+	//※16バイトアラインメントまでの先頭部分は1文字ずつ処理する（ページ境界を越えて読み込まないため）
+	//※SSE4.2命令に対応したCPUでのみ呼び出すこと
+	GASHA_TARGET_SSE4_2 inline const char* strstr_sse4_2(const char* str, const char* pattern)
+	{
+		alignas(16) char pattern_head[16] = { 0 };//パターンの先頭16文字（ヌル以降は0埋め）
+		std::size_t pattern_head_len = 0;
+		for (; pattern_head_len < 16 && pattern[pattern_head_len] != '\0'; ++pattern_head_len)
+			pattern_head[pattern_head_len] = pattern[pattern_head_len];
+		if (pattern_head_len == 0)
+			return str;
+		const char* p = str;
+		//非16バイトアランイメント部
+		for (; (reinterpret_cast<std::intptr_t>(p) & 0xf) != 0; ++p)
+		{
+			if (*p == '\0')
+				return nullptr;
+			if (strstr_sse4_2_match(p, pattern))
+				return p;
+		}
+		//16バイトアランイメント部
+		static const int flags = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ORDERED | _SIDD_POSITIVE_POLARITY | _SIDD_BIT_MASK;
+		const __m128i pattern16 = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern_head));
+		while (true)
+		{
+			const __m128i str16 = _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+			//候補位置のビットマスク
+			//※16バイト境界をまたぐ部分一致も候補になる
+			unsigned int candidates = static_cast<unsigned int>(_mm_cvtsi128_si32(_mm_cmpistrm(pattern16, str16, flags)));
+			for (const char* candidate = p; candidates != 0; ++candidate, candidates >>= 1)
+			{
+				if ((candidates & 1) && strstr_sse4_2_match(candidate, pattern))
+					return candidate;
+			}
+			if (_mm_cmpistrz(pattern16, str16, flags))//文字列の終端を含む
+				return nullptr;
+			p += 16;
+		}
+		return nullptr;//dummy
+	}
+}//namespace _private
+inline const char* strstr_sse(const char* str, const char* pattern)
+{
+	//実行時のCPU機能判定による振り分け
+	//※初回呼び出し時に関数を選択し、以後は関数ポインタ経由で呼び出す
+	typedef const char*(*func_type)(const char*, const char*);
+	static const func_type func = GASHA_ cpuFeatures::instance().hasSSE4_2() ? static_cast<func_type>(_private::strstr_sse4_2) : static_cast<func_type>(GASHA_ strstr);
+	return func(str, pattern);
+}
 #else//GASHA_USE_SSE4_2
 inline const char* strstr_sse(const char* str, const char* pattern)
 {
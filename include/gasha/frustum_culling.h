@@ -0,0 +1,128 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_FRUSTUM_CULLING_H
+#define GASHA_INCLUDED_FRUSTUM_CULLING_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// frustum_culling.h
+// 視錐台カリング【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/fast_math.h>//高速算術
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint32_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//視錐台カリング
+//※SoA形式のバウンディングボリューム（球／AABB）の配列を、視錐台の平面群と一括判定する。
+//※平面は float[4] の (a, b, c, d) で表し、a*x + b*y + c*z + d ≧ 0 の側を内側とする。
+//　（法線 (a, b, c) は内側向き。バウンディング球の判定には正規化した平面が必要）
+//※いずれかの平面の完全に外側にあるものだけを不可視とする保守的な判定。
+//　（視錐台の角の外側にあるものも、可視と判定されることがある）
+//※平面の数は任意。（視錐台の6平面のほか、ポータルなどの追加平面も指定可能）
+//※結果は、ビットマスクか、可視要素のインデックスの配列で出力する。
+//　・ビットマスク ... out_mask[i / 32] の (i % 32) ビット目が可視なら 1。(n + 31) / 32 要素の配列が必要。
+//　　　　　　　　　　 端数のビットは 0 にする。
+//　・インデックス ... 可視要素のインデックスを昇順に格納し、可視数を返す。n 要素の配列が必要。
+//※AVXが有効なら8要素ずつ、SSEが有効なら4要素ずつ処理し、端数はスカラー演算で処理する。
+//　全平面で外側と判定されたら、残りの平面の判定を打ち切る。
+//※ビルド設定 GASHA_USE_RUNTIME_CPU_DISPATCH が有効で、AVX命令がコンパイル時に無効な場合、
+//　CPUのAVX命令対応を実行時に判定し、対応していればAVX命令で8要素ずつ処理する。
+//※並列版（parallel～）は、OpenMPを使用して配列をスレッド数分のブロックに分け、並列に判定する。
+//　（OpenMPが無効な環境や、要素数が少ない場合は、通常版に切り替える）
+//　インデックス版は、ブロックごとに判定した後、可視要素のインデックスを前に詰める。
+//※配列のアラインメントは問わない。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  float planes[6][4];
+//  extractFrustumPlanes(planes, view_proj);//ビュー×プロジェクション行列から平面を抽出
+//  const std::size_t visible_num = cullSpheresIndex(x, y, z, radius, n, planes, 6, visible_indices);
+//  parallelCullAABBsMask(min_x, min_y, min_z, max_x, max_y, max_z, n, planes, 6, visible_mask);
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//視錐台の平面抽出
+//※ビュー×プロジェクション行列（行優先、列ベクトルに乗算する形式）から、
+//　左、右、下、上、近、遠の順に、正規化した6平面を抽出する。
+//※is_zero_to_one_depth が true なら、クリップ空間の深度を 0～w（Direct3D形式）、
+//　false なら -w～w（OpenGL形式）として近平面を抽出する。
+inline void extractFrustumPlanes(float (&planes)[6][4], const float (&view_proj)[4][4], const bool is_zero_to_one_depth = true);
+
+//----------------------------------------
+//バウンディング球の視錐台カリング
+//※x, y, z ... 中心座標, radius ... 半径
+//ビットマスク出力
+inline void cullSpheresMask(const float* x, const float* y, const float* z, const float* radius, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask);
+//インデックス出力
+inline std::size_t cullSpheresIndex(const float* x, const float* y, const float* z, const float* radius, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices);
+
+//----------------------------------------
+//AABBの視錐台カリング
+//※min_x, min_y, min_z ... 最小座標, max_x, max_y, max_z ... 最大座標
+//※平面ごとに、法線方向に最も遠い頂点（p-vertex）を判定する。
+//ビットマスク出力
+inline void cullAABBsMask(const float* min_x, const float* min_y, const float* min_z, const float* max_x, const float* max_y, const float* max_z, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask);
+//インデックス出力
+inline std::size_t cullAABBsIndex(const float* min_x, const float* min_y, const float* min_z, const float* max_x, const float* max_y, const float* max_z, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices);
+
+//----------------------------------------
+//並列版
+inline void parallelCullSpheresMask(const float* x, const float* y, const float* z, const float* radius, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask);
+inline std::size_t parallelCullSpheresIndex(const float* x, const float* y, const float* z, const float* radius, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices);
+inline void parallelCullAABBsMask(const float* min_x, const float* min_y, const float* min_z, const float* max_x, const float* max_y, const float* max_z, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask);
+inline std::size_t parallelCullAABBsIndex(const float* min_x, const float* min_y, const float* min_z, const float* max_x, const float* max_y, const float* max_z, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices);
+
+namespace _private
+{
+	//----------------------------------------
+	//視錐台カリング用：バウンディング球
+	struct frustumCullSphere
+	{
+		const float* m_x;//中心座標X
+		const float* m_y;//中心座標Y
+		const float* m_z;//中心座標Z
+		const float* m_radius;//半径
+		//判定
+		//※可視なら true（SSE/AVX版は、可視の要素のビットが 1 のマスク）を返す
+		inline bool test(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const;
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		inline std::uint32_t test_sse(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const;
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+		GASHA_TARGET_AVX inline std::uint32_t test_avx(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const;
+	#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+	};
+	//----------------------------------------
+	//視錐台カリング用：AABB
+	struct frustumCullAABB
+	{
+		const float* m_min[3];//最小座標（X, Y, Z）
+		const float* m_max[3];//最大座標（X, Y, Z）
+		//判定
+		//※可視なら true（SSE/AVX版は、可視の要素のビットが 1 のマスク）を返す
+		inline bool test(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const;
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		inline std::uint32_t test_sse(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const;
+	#endif//GASHA_FAST_ARITH_USE_SSE
+	#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+		GASHA_TARGET_AVX inline std::uint32_t test_avx(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const;
+	#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+	};
+}//namespace _private
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/frustum_culling.inl>
+
+#endif//GASHA_INCLUDED_FRUSTUM_CULLING_H
+
+// End of file
@@ -0,0 +1,433 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_FRUSTUM_CULLING_INL
+#define GASHA_INCLUDED_FRUSTUM_CULLING_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// frustum_culling.inl
+// 視錐台カリング【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/frustum_culling.h>//視錐台カリング【宣言部】
+
+#include <cmath>//std::sqrt()
+#include <cstring>//std::memmove()
+
+#ifdef _OPENMP
+#include <omp.h>//omp_get_max_threads()
+#endif//_OPENMP
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//視錐台カリング
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//視錐台の平面抽出
+//※クリップ座標 (x, y, z, w) が -w ≦ x ≦ w などを満たす条件を、行列の行の和／差で平面として表す
+inline void extractFrustumPlanes(float (&planes)[6][4], const float (&view_proj)[4][4], const bool is_zero_to_one_depth)
+{
+	for (int col = 0; col < 4; ++col)
+	{
+		const float row0 = view_proj[0][col];
+		const float row1 = view_proj[1][col];
+		const float row2 = view_proj[2][col];
+		const float row3 = view_proj[3][col];
+		planes[0][col] = row3 + row0;//左
+		planes[1][col] = row3 - row0;//右
+		planes[2][col] = row3 + row1;//下
+		planes[3][col] = row3 - row1;//上
+		planes[4][col] = is_zero_to_one_depth ? row2 : row3 + row2;//近
+		planes[5][col] = row3 - row2;//遠
+	}
+	//正規化
+	for (int plane = 0; plane < 6; ++plane)
+	{
+		float (&p)[4] = planes[plane];
+		const float len = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+		if (len > 0.f)
+		{
+			const float rcp_len = 1.f / len;
+			p[0] *= rcp_len;
+			p[1] *= rcp_len;
+			p[2] *= rcp_len;
+			p[3] *= rcp_len;
+		}
+	}
+}
+
+namespace _private
+{
+	//並列化する要素数
+	static const std::size_t PARALLEL_FRUSTUM_CULLING_SIZE_THRESHOLD = 16384;
+	//並列処理の最大ブロック数
+	static const int PARALLEL_FRUSTUM_CULLING_BLOCK_NUM_MAX = 64;
+
+	//並列処理数を取得
+	inline int parallelFrustumCullingThreadNum()
+	{
+	#ifdef _OPENMP
+		const int thread_num = omp_get_max_threads();
+		return thread_num < PARALLEL_FRUSTUM_CULLING_BLOCK_NUM_MAX ? thread_num : PARALLEL_FRUSTUM_CULLING_BLOCK_NUM_MAX;
+	#else//_OPENMP
+		return 1;
+	#endif//_OPENMP
+	}
+
+	//----------------------------------------
+	//視錐台カリング用：バウンディング球
+	//※中心から平面までの距離が -半径 未満なら外側
+	//※非数は可視と判定する（SSE/AVX版と結果を合わせる）
+
+	//判定
+	inline bool frustumCullSphere::test(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const
+	{
+		const float x = m_x[index];
+		const float y = m_y[index];
+		const float z = m_z[index];
+		const float neg_radius = -m_radius[index];
+		for (std::size_t plane = 0; plane < plane_num; ++plane)
+		{
+			const float (&p)[4] = planes[plane];
+			if (p[0] * x + p[1] * y + p[2] * z + p[3] < neg_radius)
+				return false;
+		}
+		return true;
+	}
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	//判定（SSE版：4要素）
+	inline std::uint32_t frustumCullSphere::test_sse(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const
+	{
+		const __m128 x_m128 = _mm_loadu_ps(m_x + index);
+		const __m128 y_m128 = _mm_loadu_ps(m_y + index);
+		const __m128 z_m128 = _mm_loadu_ps(m_z + index);
+		const __m128 neg_radius_m128 = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(m_radius + index));
+		__m128 visible_m128 = _mm_setzero_ps();
+		for (std::size_t plane = 0; plane < plane_num; ++plane)
+		{
+			const float (&p)[4] = planes[plane];
+			const __m128 dist_m128 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[0]), x_m128), _mm_mul_ps(_mm_set1_ps(p[1]), y_m128)), _mm_mul_ps(_mm_set1_ps(p[2]), z_m128)), _mm_set1_ps(p[3]));
+			const __m128 inside_m128 = _mm_cmpnlt_ps(dist_m128, neg_radius_m128);
+			visible_m128 = plane == 0 ? inside_m128 : _mm_and_ps(visible_m128, inside_m128);
+			if (_mm_movemask_ps(visible_m128) == 0)//全要素が外側なら打ち切り
+				break;
+		}
+		return plane_num == 0 ? 0xf : static_cast<std::uint32_t>(_mm_movemask_ps(visible_m128));
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	//判定（AVX版：8要素）
+	GASHA_TARGET_AVX inline std::uint32_t frustumCullSphere::test_avx(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const
+	{
+		const __m256 x_m256 = _mm256_loadu_ps(m_x + index);
+		const __m256 y_m256 = _mm256_loadu_ps(m_y + index);
+		const __m256 z_m256 = _mm256_loadu_ps(m_z + index);
+		const __m256 neg_radius_m256 = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(m_radius + index));
+		__m256 visible_m256 = _mm256_setzero_ps();
+		for (std::size_t plane = 0; plane < plane_num; ++plane)
+		{
+			const float (&p)[4] = planes[plane];
+			const __m256 dist_m256 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p[0]), x_m256), _mm256_mul_ps(_mm256_set1_ps(p[1]), y_m256)), _mm256_mul_ps(_mm256_set1_ps(p[2]), z_m256)), _mm256_set1_ps(p[3]));
+			const __m256 inside_m256 = _mm256_cmp_ps(dist_m256, neg_radius_m256, _CMP_NLT_UQ);
+			visible_m256 = plane == 0 ? inside_m256 : _mm256_and_ps(visible_m256, inside_m256);
+			if (_mm256_movemask_ps(visible_m256) == 0)//全要素が外側なら打ち切り
+				break;
+		}
+		return plane_num == 0 ? 0xff : static_cast<std::uint32_t>(_mm256_movemask_ps(visible_m256));
+	}
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+
+	//----------------------------------------
+	//視錐台カリング用：AABB
+	//※平面の法線の各成分の符号から、法線方向に最も遠い頂点（p-vertex）を選び、
+	//　その頂点が平面の外側なら、AABB全体が外側
+	//※頂点の選択は平面ごとに配列を選ぶだけなので、要素ごとの分岐や選択命令は不要
+
+	//判定
+	inline bool frustumCullAABB::test(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const
+	{
+		for (std::size_t plane = 0; plane < plane_num; ++plane)
+		{
+			const float (&p)[4] = planes[plane];
+			const float px = (p[0] >= 0.f ? m_max[0] : m_min[0])[index];
+			const float py = (p[1] >= 0.f ? m_max[1] : m_min[1])[index];
+			const float pz = (p[2] >= 0.f ? m_max[2] : m_min[2])[index];
+			if (p[0] * px + p[1] * py + p[2] * pz + p[3] < 0.f)
+				return false;
+		}
+		return true;
+	}
+#ifdef GASHA_FAST_ARITH_USE_SSE
+	//判定（SSE版：4要素）
+	inline std::uint32_t frustumCullAABB::test_sse(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const
+	{
+		__m128 visible_m128 = _mm_setzero_ps();
+		for (std::size_t plane = 0; plane < plane_num; ++plane)
+		{
+			const float (&p)[4] = planes[plane];
+			const __m128 px_m128 = _mm_loadu_ps((p[0] >= 0.f ? m_max[0] : m_min[0]) + index);
+			const __m128 py_m128 = _mm_loadu_ps((p[1] >= 0.f ? m_max[1] : m_min[1]) + index);
+			const __m128 pz_m128 = _mm_loadu_ps((p[2] >= 0.f ? m_max[2] : m_min[2]) + index);
+			const __m128 dist_m128 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[0]), px_m128), _mm_mul_ps(_mm_set1_ps(p[1]), py_m128)), _mm_mul_ps(_mm_set1_ps(p[2]), pz_m128)), _mm_set1_ps(p[3]));
+			const __m128 inside_m128 = _mm_cmpnlt_ps(dist_m128, _mm_setzero_ps());
+			visible_m128 = plane == 0 ? inside_m128 : _mm_and_ps(visible_m128, inside_m128);
+			if (_mm_movemask_ps(visible_m128) == 0)//全要素が外側なら打ち切り
+				break;
+		}
+		return plane_num == 0 ? 0xf : static_cast<std::uint32_t>(_mm_movemask_ps(visible_m128));
+	}
+#endif//GASHA_FAST_ARITH_USE_SSE
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	//判定（AVX版：8要素）
+	GASHA_TARGET_AVX inline std::uint32_t frustumCullAABB::test_avx(const std::size_t index, const float (*planes)[4], const std::size_t plane_num) const
+	{
+		__m256 visible_m256 = _mm256_setzero_ps();
+		for (std::size_t plane = 0; plane < plane_num; ++plane)
+		{
+			const float (&p)[4] = planes[plane];
+			const __m256 px_m256 = _mm256_loadu_ps((p[0] >= 0.f ? m_max[0] : m_min[0]) + index);
+			const __m256 py_m256 = _mm256_loadu_ps((p[1] >= 0.f ? m_max[1] : m_min[1]) + index);
+			const __m256 pz_m256 = _mm256_loadu_ps((p[2] >= 0.f ? m_max[2] : m_min[2]) + index);
+			const __m256 dist_m256 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p[0]), px_m256), _mm256_mul_ps(_mm256_set1_ps(p[1]), py_m256)), _mm256_mul_ps(_mm256_set1_ps(p[2]), pz_m256)), _mm256_set1_ps(p[3]));
+			const __m256 inside_m256 = _mm256_cmp_ps(dist_m256, _mm256_setzero_ps(), _CMP_NLT_UQ);
+			visible_m256 = plane == 0 ? inside_m256 : _mm256_and_ps(visible_m256, inside_m256);
+			if (_mm256_movemask_ps(visible_m256) == 0)//全要素が外側なら打ち切り
+				break;
+		}
+		return plane_num == 0 ? 0xff : static_cast<std::uint32_t>(_mm256_movemask_ps(visible_m256));
+	}
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+
+	//----------------------------------------
+	//視錐台カリング用：マスクから可視要素のインデックスを詰めて格納
+	//※分岐を避けるため、不可視の要素も書き込み、可視の場合だけ書き込み位置を進める
+	//　（書き込み位置は処理済みの要素数を超えないため、出力先は要素数分あれば足りる）
+	inline std::size_t frustumCullCompact(const std::uint32_t mask, const std::size_t lane_num, const std::size_t index, std::uint32_t* out_indices)
+	{
+		std::size_t count = 0;
+		for (std::size_t lane = 0; lane < lane_num; ++lane)
+		{
+			out_indices[count] = static_cast<std::uint32_t>(index + lane);
+			count += (mask >> lane) & 1u;
+		}
+		return count;
+	}
+
+#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+	//----------------------------------------
+	//視錐台カリング用：AVX命令版
+	//※実行時に振り分ける場合、AVX命令に対応したCPUでのみ呼び出すこと
+
+	//ビットマスク出力
+	//※先頭から32要素（マスク1要素分）ずつ処理し、処理を終えた位置を返す
+	template<class SHAPE>
+	GASHA_TARGET_AVX inline std::size_t frustumCullMask_avx(const SHAPE& shape, const std::size_t begin, const std::size_t end, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask)
+	{
+		std::size_t i = begin;
+		for (; i + 32 <= end; i += 32)
+		{
+			out_mask[(i - begin) >> 5] = shape.test_avx(i, planes, plane_num) |
+			                            (shape.test_avx(i + 8, planes, plane_num) << 8) |
+			                            (shape.test_avx(i + 16, planes, plane_num) << 16) |
+			                            (shape.test_avx(i + 24, planes, plane_num) << 24);
+		}
+		return i;
+	}
+	//インデックス出力
+	//※先頭から8要素ずつ処理し、処理を終えた位置を返す
+	template<class SHAPE>
+	GASHA_TARGET_AVX inline std::size_t frustumCullIndex_avx(const SHAPE& shape, const std::size_t begin, const std::size_t end, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices, std::size_t& count)
+	{
+		std::size_t i = begin;
+		for (; i + 8 <= end; i += 8)
+			count += frustumCullCompact(shape.test_avx(i, planes, plane_num), 8, i, out_indices + count);
+		return i;
+	}
+#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+
+	//----------------------------------------
+	//視錐台カリング用：ビットマスク出力
+	//※[begin, end) の範囲を判定し、out_mask の先頭から格納する（begin は 32 の倍数であること）
+	template<class SHAPE>
+	inline void frustumCullMask(const SHAPE& shape, const std::size_t begin, const std::size_t end, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask)
+	{
+		std::size_t i = begin;
+	#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+		if (fastBatchIsAVX())
+			i = frustumCullMask_avx(shape, begin, end, planes, plane_num, out_mask);
+	#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+		for (; i < end; i += 32)
+		{
+			const std::size_t word_end = i + 32 < end ? i + 32 : end;
+			std::uint32_t bits = 0;
+			std::size_t j = i;
+		#ifdef GASHA_FAST_ARITH_USE_SSE
+			for (; j + 4 <= word_end; j += 4)
+				bits |= shape.test_sse(j, planes, plane_num) << (j - i);
+		#endif//GASHA_FAST_ARITH_USE_SSE
+			//端数
+			for (; j < word_end; ++j)
+				bits |= static_cast<std::uint32_t>(shape.test(j, planes, plane_num)) << (j - i);
+			out_mask[(i - begin) >> 5] = bits;
+		}
+	}
+	//----------------------------------------
+	//視錐台カリング用：インデックス出力
+	//※[begin, end) の範囲を判定し、可視要素のインデックスを out_indices の先頭から格納して、可視数を返す
+	template<class SHAPE>
+	inline std::size_t frustumCullIndex(const SHAPE& shape, const std::size_t begin, const std::size_t end, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices)
+	{
+		std::size_t i = begin;
+		std::size_t count = 0;
+	#if defined(GASHA_FAST_ARITH_USE_AVX) || defined(GASHA_FAST_ARITH_DISPATCH_AVX)
+		if (fastBatchIsAVX())
+			i = frustumCullIndex_avx(shape, begin, end, planes, plane_num, out_indices, count);
+	#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_DISPATCH_AVX
+	#ifdef GASHA_FAST_ARITH_USE_SSE
+		for (; i + 4 <= end; i += 4)
+			count += frustumCullCompact(shape.test_sse(i, planes, plane_num), 4, i, out_indices + count);
+	#endif//GASHA_FAST_ARITH_USE_SSE
+		//端数
+		for (; i < end; ++i)
+		{
+			out_indices[count] = static_cast<std::uint32_t>(i);
+			count += shape.test(i, planes, plane_num) ? 1 : 0;
+		}
+		return count;
+	}
+
+	//----------------------------------------
+	//視錐台カリング用：並列ビットマスク出力
+	//※ブロックの境界をマスク1要素分（32要素）に揃えて、ブロックごとに並列に判定する
+	template<class SHAPE>
+	inline void parallelFrustumCullMask(const SHAPE& shape, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask)
+	{
+		const int thread_num = parallelFrustumCullingThreadNum();
+		if (thread_num <= 1 || n < PARALLEL_FRUSTUM_CULLING_SIZE_THRESHOLD)
+		{
+			frustumCullMask(shape, 0, n, planes, plane_num, out_mask);//通常版に切り替え
+			return;
+		}
+		const int block_num = thread_num;
+		const std::size_t block_size = ((n + 31) / 32 + block_num - 1) / block_num * 32;
+	#pragma omp parallel for
+		for (int block = 0; block < block_num; ++block)
+		{
+			const std::size_t begin = block_size * block;
+			if (begin >= n)
+				continue;
+			const std::size_t end = begin + block_size < n ? begin + block_size : n;
+			frustumCullMask(shape, begin, end, planes, plane_num, out_mask + (begin >> 5));
+		}
+	}
+	//----------------------------------------
+	//視錐台カリング用：並列インデックス出力
+	//※ブロックごとに並列に判定し、出力先のブロックと同じ位置に可視要素のインデックスを格納した後、
+	//　ブロックの順に前に詰める
+	template<class SHAPE>
+	inline std::size_t parallelFrustumCullIndex(const SHAPE& shape, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices)
+	{
+		const int thread_num = parallelFrustumCullingThreadNum();
+		if (thread_num <= 1 || n < PARALLEL_FRUSTUM_CULLING_SIZE_THRESHOLD)
+			return frustumCullIndex(shape, 0, n, planes, plane_num, out_indices);//通常版に切り替え
+		const int block_num = thread_num;
+		const std::size_t block_size = (n + block_num - 1) / block_num;
+		std::size_t counts[PARALLEL_FRUSTUM_CULLING_BLOCK_NUM_MAX];//ブロックごとの可視数
+	#pragma omp parallel for
+		for (int block = 0; block < block_num; ++block)
+		{
+			const std::size_t begin = block_size * block;
+			const std::size_t end = begin + block_size < n ? begin + block_size : n;
+			counts[block] = begin < n ? frustumCullIndex(shape, begin, end, planes, plane_num, out_indices + begin) : 0;
+		}
+		//前に詰める
+		std::size_t count = counts[0];
+		for (int block = 1; block < block_num; ++block)
+		{
+			const std::size_t begin = block_size * block;
+			if (counts[block] > 0 && count != begin)
+				std::memmove(out_indices + count, out_indices + begin, sizeof(std::uint32_t) * counts[block]);
+			count += counts[block];
+		}
+		return count;
+	}
+
+	//----------------------------------------
+	//視錐台カリング用：形状作成
+	inline frustumCullSphere makeFrustumCullSphere(const float* x, const float* y, const float* z, const float* radius)
+	{
+		frustumCullSphere shape = { x, y, z, radius };
+		return shape;
+	}
+	inline frustumCullAABB makeFrustumCullAABB(const float* min_x, const float* min_y, const float* min_z, const float* max_x, const float* max_y, const float* max_z)
+	{
+		frustumCullAABB shape = { { min_x, min_y, min_z }, { max_x, max_y, max_z } };
+		return shape;
+	}
+}//namespace _private
+
+//----------------------------------------
+//バウンディング球の視錐台カリング
+
+//ビットマスク出力
+inline void cullSpheresMask(const float* x, const float* y, const float* z, const float* radius, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask)
+{
+	_private::frustumCullMask(_private::makeFrustumCullSphere(x, y, z, radius), 0, n, planes, plane_num, out_mask);
+}
+//インデックス出力
+inline std::size_t cullSpheresIndex(const float* x, const float* y, const float* z, const float* radius, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices)
+{
+	return _private::frustumCullIndex(_private::makeFrustumCullSphere(x, y, z, radius), 0, n, planes, plane_num, out_indices);
+}
+
+//----------------------------------------
+//AABBの視錐台カリング
+
+//ビットマスク出力
+inline void cullAABBsMask(const float* min_x, const float* min_y, const float* min_z, const float* max_x, const float* max_y, const float* max_z, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask)
+{
+	_private::frustumCullMask(_private::makeFrustumCullAABB(min_x, min_y, min_z, max_x, max_y, max_z), 0, n, planes, plane_num, out_mask);
+}
+//インデックス出力
+inline std::size_t cullAABBsIndex(const float* min_x, const float* min_y, const float* min_z, const float* max_x, const float* max_y, const float* max_z, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices)
+{
+	return _private::frustumCullIndex(_private::makeFrustumCullAABB(min_x, min_y, min_z, max_x, max_y, max_z), 0, n, planes, plane_num, out_indices);
+}
+
+//----------------------------------------
+//並列版
+
+//バウンディング球：ビットマスク出力
+inline void parallelCullSpheresMask(const float* x, const float* y, const float* z, const float* radius, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask)
+{
+	_private::parallelFrustumCullMask(_private::makeFrustumCullSphere(x, y, z, radius), n, planes, plane_num, out_mask);
+}
+//バウンディング球：インデックス出力
+inline std::size_t parallelCullSpheresIndex(const float* x, const float* y, const float* z, const float* radius, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices)
+{
+	return _private::parallelFrustumCullIndex(_private::makeFrustumCullSphere(x, y, z, radius), n, planes, plane_num, out_indices);
+}
+//AABB：ビットマスク出力
+inline void parallelCullAABBsMask(const float* min_x, const float* min_y, const float* min_z, const float* max_x, const float* max_y, const float* max_z, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask)
+{
+	_private::parallelFrustumCullMask(_private::makeFrustumCullAABB(min_x, min_y, min_z, max_x, max_y, max_z), n, planes, plane_num, out_mask);
+}
+//AABB：インデックス出力
+inline std::size_t parallelCullAABBsIndex(const float* min_x, const float* min_y, const float* min_z, const float* max_x, const float* max_y, const float* max_z, const std::size_t n, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_indices)
+{
+	return _private::parallelFrustumCullIndex(_private::makeFrustumCullAABB(min_x, min_y, min_z, max_x, max_y, max_z), n, planes, plane_num, out_indices);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_FRUSTUM_CULLING_INL
+
+// End of file
@@ -0,0 +1,177 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_FRUSTUM_CULLING_BENCHMARK_H
+#define GASHA_INCLUDED_FRUSTUM_CULLING_BENCHMARK_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// frustum_culling_benchmark.h
+// 視錐台カリングベンチマーク【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/frustum_culling.h>//視錐台カリング
+#include <gasha/benchmark_report.h>//ベンチマーク共通処理
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint32_t, std::uint64_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//視錐台カリングベンチマーク
+//※バウンディングボリュームの種類 × 件数 の組み合わせごとに、全ての判定方法を実行し、
+//　１要素あたりの処理時間と、スカラー版に対する速度向上率を計測する。
+//　・バウンディングボリューム ... バウンディング球、AABB
+//　・件数   ... 1000件から10倍ずつ、条件の最大件数（デフォルトは100万件）まで
+//　・判定方法
+//　　・スカラー版       ... 1要素ずつ判定してビットマスクを作る。（SSE/AVX命令を使用しない基準の処理）
+//　　・ビットマスク版   ... cullSpheresMask(), cullAABBsMask()
+//　　・インデックス版   ... cullSpheresIndex(), cullAABBsIndex()
+//　　・並列ビットマスク版／並列インデックス版 ... parallelCull～()
+//※入力データは、一辺 2000 の立方体の中に一様に配置した中心座標と、半径（AABB は各軸の半分の大きさ）1～10 のボリューム。
+//　視錐台は、原点から +Z 方向を向いた、垂直画角 90 度、アスペクト比 16:9、近平面 1、遠平面 1000 の透視投影から抽出する。
+//　（固定シードの xoshiro256pp で作るため、毎回同じ内容になる。可視率は約２割）
+//※処理時間は、件数×回数が条件の一定数（repeatElementNum）以上になるように繰り返し判定し、
+//　repeatNum 回計測した最短の時間を採用する。（出力先の確保と入力データの作成時間は含まない）
+//※全ての判定方法の結果をスカラー版の結果と比較し、全て一致すれば true を返す。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //表とCSVをバッファに作成
+//  static char table[64 * 1024];
+//  static char csv[64 * 1024];
+//  std::size_t table_len, csv_len;
+//  frustumCullingBenchmarkReport(table, sizeof(table), table_len, csv, sizeof(csv), csv_len);
+//
+//  //ユニットテストで実行（計測結果を表示し、全ての結果が正しいか判定）
+//  GASHA_UT_BEGIN(frustum_culling_benchmark, 0, GASHA_ ut::ATTR_MANUAL)
+//  {
+//      GASHA_UT_FRUSTUM_CULLING_BENCHMARK(1000000);
+//  }
+//  GASHA_UT_END()
+//--------------------------------------------------------------------------------
+
+namespace frustumCullingBenchmark
+{
+	//バウンディングボリュームの種類
+	enum shape_type
+	{
+		shapeSphere = 0,//バウンディング球
+		shapeAABB,//AABB
+	};
+	static const int SHAPE_TYPE_NUM = 2;//バウンディングボリュームの種類数
+	//バウンディングボリュームの種類名
+	inline const char* shapeName(const shape_type shape);
+
+	//判定方法
+	enum method_type
+	{
+		methodScalar = 0,//スカラー版
+		methodMask,//ビットマスク版
+		methodIndex,//インデックス版
+		methodParallelMask,//並列ビットマスク版
+		methodParallelIndex,//並列インデックス版
+	};
+	static const int METHOD_TYPE_NUM = 5;//判定方法の数
+	//判定方法名
+	inline const char* methodName(const method_type method);
+
+	static const std::uint64_t SEED = 0xc011c011c011c011ull;//入力データ作成用の乱数のシード
+
+	//計測条件
+	struct condition
+	{
+		std::size_t m_sizeMin;//最小件数（10倍ずつ最大件数まで計測）
+		std::size_t m_sizeMax;//最大件数
+		std::size_t m_repeatElementNum;//１回の計測で判定する最小の要素数（件数×回数）
+		int m_repeatNum;//組み合わせごとの計測回数
+		inline condition();
+	};
+
+	//計測結果
+	struct result
+	{
+		shape_type m_shape;//バウンディングボリュームの種類
+		method_type m_method;//判定方法
+		std::size_t m_size;//件数
+		int m_threadNum;//スレッド数
+		double m_nsPerElement;//１要素あたりの処理時間（ナノ秒）
+		double m_mElementsPerSec;//１秒あたりの処理件数（100万件単位）
+		double m_speedUp;//スカラー版に対する速度向上率
+		std::size_t m_visibleNum;//可視数
+		bool m_isOk;//結果が正しいか？（スカラー版の結果と一致するか？）
+	};
+
+	//ベンチマーク定義
+	//※benchmarkReport() などに渡す（benchmark_report.h 参照）
+	struct definition
+	{
+		typedef condition condition_type;//計測条件の型
+		typedef result result_type;//計測結果の型
+		//表のタイトル
+		inline static void writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond);
+		//表形式
+		inline static void writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+		inline static void writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+		//CSV形式
+		inline static void writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+		inline static void writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+		//全ての組み合わせを計測
+		template<class FUNCTOR>
+		inline static bool testAll(const condition_type& cond, FUNCTOR functor);
+	};
+}//namespace frustumCullingBenchmark
+
+//----------------------------------------
+//バウンディングボリュームの種類と件数を指定して、全ての判定方法を計測
+//※判定方法ごとに functor(const frustumCullingBenchmark::result&) を呼び出す
+//※全ての結果が正しければ true を返す
+template<class FUNCTOR>
+bool frustumCullingBenchmarkTest(const frustumCullingBenchmark::shape_type shape, const std::size_t size, const frustumCullingBenchmark::condition& cond, FUNCTOR functor);
+
+//----------------------------------------
+//条件の全ての組み合わせを計測
+//※計測結果ごとに functor(const frustumCullingBenchmark::result&) を呼び出す
+//※全ての結果が正しければ true を返す
+template<class FUNCTOR>
+bool frustumCullingBenchmarkTestAll(const frustumCullingBenchmark::condition& cond, FUNCTOR functor);
+
+//----------------------------------------
+//全ての組み合わせを計測し、表とCSVを作成
+//※表またはCSVが不要な場合は、バッファに nullptr を指定する
+//※全ての結果が正しければ true を返す
+//※メッセージとそのサイズを受け取るための変数を引数に渡す（表／CSVともに16KBもあれば十分）。
+inline bool frustumCullingBenchmarkReport(char* table_message, const std::size_t table_max_size, std::size_t& table_message_len, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const frustumCullingBenchmark::condition& cond = frustumCullingBenchmark::condition());
+
+namespace _private
+{
+	//----------------------------------------
+	//視錐台カリングベンチマーク用：入力データ
+	struct frustumCullingBenchmarkInput
+	{
+		float* m_val[6];//座標などの配列（球は X, Y, Z, 半径、AABB は最小 X, Y, Z, 最大 X, Y, Z）
+		float m_planes[6][4];//視錐台の平面
+	};
+}//namespace _private
+
+//----------------------------------------
+//ユニットテスト用マクロ
+//※GASHA_UT_BEGIN() ～ GASHA_UT_END() の中で使用する
+#define GASHA_UT_FRUSTUM_CULLING_BENCHMARK(size_max) \
+	{ \
+		GASHA_ frustumCullingBenchmark::condition bench_cond; \
+		bench_cond.m_sizeMax = size_max; \
+		GASHA_UT_BENCHMARK(GASHA_ frustumCullingBenchmark::definition, bench_cond); \
+	}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/frustum_culling_benchmark.inl>
+
+#endif//GASHA_INCLUDED_FRUSTUM_CULLING_BENCHMARK_H
+
+// End of file
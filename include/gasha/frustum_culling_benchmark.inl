@@ -0,0 +1,301 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_FRUSTUM_CULLING_BENCHMARK_INL
+#define GASHA_INCLUDED_FRUSTUM_CULLING_BENCHMARK_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// frustum_culling_benchmark.inl
+// 視錐台カリングベンチマーク【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/frustum_culling_benchmark.h>//視錐台カリングベンチマーク【宣言部】
+
+#include <gasha/random_engine.h>//乱数生成器：xoshiro256pp
+#include <gasha/string.h>//文字列処理：spprintf()
+
+#include <cstring>//std::memcmp()
+#include <new>//std::nothrow
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//視錐台カリングベンチマーク
+//--------------------------------------------------------------------------------
+
+namespace frustumCullingBenchmark
+{
+	//バウンディングボリュームの種類名
+	inline const char* shapeName(const shape_type shape)
+	{
+		static const char* names[SHAPE_TYPE_NUM] = { "sphere", "AABB" };
+		return shape >= 0 && shape < SHAPE_TYPE_NUM ? names[shape] : "?";
+	}
+	//判定方法名
+	inline const char* methodName(const method_type method)
+	{
+		static const char* names[METHOD_TYPE_NUM] = { "scalar", "mask", "index", "parallel-mask", "parallel-index" };
+		return method >= 0 && method < METHOD_TYPE_NUM ? names[method] : "?";
+	}
+
+	//計測条件：コンストラクタ
+	inline condition::condition() :
+		m_sizeMin(1000),
+		m_sizeMax(1000000),
+		m_repeatElementNum(10000000),
+		m_repeatNum(3)
+	{}
+
+	//ベンチマーク定義
+	//表のタイトル
+	inline void definition::writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "[ Frustum culling benchmark (size=%llu-%llu) ]\n", static_cast<unsigned long long>(cond.m_sizeMin), static_cast<unsigned long long>(cond.m_sizeMax));
+	}
+	//表形式
+	inline void definition::writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%-6s %-14s %10s %7s %10s %10s %8s %10s %s\n", "shape", "method", "size", "threads", "ns/elem", "Melem/s", "speed-up", "visible", "result");
+	}
+	inline void definition::writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%-6s %-14s %10llu %7d %10.3lf %10.1lf %7.2lfx %10llu %s\n", shapeName(result.m_shape), methodName(result.m_method), static_cast<unsigned long long>(result.m_size), result.m_threadNum, result.m_nsPerElement, result.m_mElementsPerSec, result.m_speedUp, static_cast<unsigned long long>(result.m_visibleNum), result.m_isOk ? "[OK]" : "[NG]");
+	}
+	//CSV形式
+	inline void definition::writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "shape,method,size,threads,ns_per_element,melements_per_sec,speed_up,visible,ok\n");
+	}
+	inline void definition::writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%s,%s,%llu,%d,%.3lf,%.3lf,%.3lf,%llu,%d\n", shapeName(result.m_shape), methodName(result.m_method), static_cast<unsigned long long>(result.m_size), result.m_threadNum, result.m_nsPerElement, result.m_mElementsPerSec, result.m_speedUp, static_cast<unsigned long long>(result.m_visibleNum), result.m_isOk ? 1 : 0);
+	}
+	//全ての組み合わせを計測
+	template<class FUNCTOR>
+	inline bool definition::testAll(const condition_type& cond, FUNCTOR functor)
+	{
+		return frustumCullingBenchmarkTestAll(cond, functor);
+	}
+}//namespace frustumCullingBenchmark
+
+namespace _private
+{
+	//----------------------------------------
+	//入力データを作成
+	inline void frustumCullingBenchmarkMakeInput(frustumCullingBenchmarkInput& input, const std::size_t size, const frustumCullingBenchmark::shape_type shape)
+	{
+		static const float SCENE_HALF_SIZE = 1000.f;//配置範囲の立方体の一辺の半分
+		GASHA_ xoshiro256pp rnd(frustumCullingBenchmark::SEED);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			float center[3];
+			for (int axis = 0; axis < 3; ++axis)
+				center[axis] = (rnd.nextFloat() * 2.f - 1.f) * SCENE_HALF_SIZE;
+			if (shape == frustumCullingBenchmark::shapeSphere)
+			{
+				for (int axis = 0; axis < 3; ++axis)
+					input.m_val[axis][i] = center[axis];
+				input.m_val[3][i] = 1.f + rnd.nextFloat() * 9.f;
+			}
+			else
+			{
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					const float extent = 1.f + rnd.nextFloat() * 9.f;
+					input.m_val[axis][i] = center[axis] - extent;
+					input.m_val[axis + 3][i] = center[axis] + extent;
+				}
+			}
+		}
+		//視錐台
+		//※原点から +Z 方向を向いた透視投影（垂直画角 90 度、深度 0～1）
+		static const float ASPECT = 16.f / 9.f;//アスペクト比
+		static const float NEAR_Z = 1.f;//近平面
+		static const float FAR_Z = 1000.f;//遠平面
+		const float view_proj[4][4] =
+		{
+			{ 1.f / ASPECT, 0.f, 0.f, 0.f },
+			{ 0.f, 1.f, 0.f, 0.f },
+			{ 0.f, 0.f, FAR_Z / (FAR_Z - NEAR_Z), -NEAR_Z * FAR_Z / (FAR_Z - NEAR_Z) },
+			{ 0.f, 0.f, 1.f, 0.f },
+		};
+		GASHA_ extractFrustumPlanes(input.m_planes, view_proj, true);
+	}
+
+	//----------------------------------------
+	//スカラー版の判定
+	//※1要素ずつ判定してビットマスクを作る
+	template<class SHAPE>
+	inline void frustumCullingBenchmarkScalar(const SHAPE& shape, const std::size_t size, const float (*planes)[4], const std::size_t plane_num, std::uint32_t* out_mask)
+	{
+		for (std::size_t begin = 0; begin < size; begin += 32)
+		{
+			const std::size_t end = begin + 32 < size ? begin + 32 : size;
+			std::uint32_t bits = 0;
+			for (std::size_t i = begin; i < end; ++i)
+				bits |= shape.test(i, planes, plane_num) ? (1u << (i - begin)) : 0u;
+			out_mask[begin >> 5] = bits;
+		}
+	}
+
+	//----------------------------------------
+	//判定
+	inline void frustumCullingBenchmarkCull(const frustumCullingBenchmark::shape_type shape, const frustumCullingBenchmark::method_type method, const frustumCullingBenchmarkInput& input, const std::size_t size, std::uint32_t* out_mask, std::uint32_t* out_indices)
+	{
+		float* const* v = input.m_val;
+		const float (*planes)[4] = input.m_planes;
+		if (shape == frustumCullingBenchmark::shapeSphere)
+		{
+			switch (method)
+			{
+			case frustumCullingBenchmark::methodScalar: frustumCullingBenchmarkScalar(makeFrustumCullSphere(v[0], v[1], v[2], v[3]), size, planes, 6, out_mask); break;
+			case frustumCullingBenchmark::methodMask: GASHA_ cullSpheresMask(v[0], v[1], v[2], v[3], size, planes, 6, out_mask); break;
+			case frustumCullingBenchmark::methodIndex: GASHA_ cullSpheresIndex(v[0], v[1], v[2], v[3], size, planes, 6, out_indices); break;
+			case frustumCullingBenchmark::methodParallelMask: GASHA_ parallelCullSpheresMask(v[0], v[1], v[2], v[3], size, planes, 6, out_mask); break;
+			case frustumCullingBenchmark::methodParallelIndex: GASHA_ parallelCullSpheresIndex(v[0], v[1], v[2], v[3], size, planes, 6, out_indices); break;
+			}
+		}
+		else
+		{
+			switch (method)
+			{
+			case frustumCullingBenchmark::methodScalar: frustumCullingBenchmarkScalar(makeFrustumCullAABB(v[0], v[1], v[2], v[3], v[4], v[5]), size, planes, 6, out_mask); break;
+			case frustumCullingBenchmark::methodMask: GASHA_ cullAABBsMask(v[0], v[1], v[2], v[3], v[4], v[5], size, planes, 6, out_mask); break;
+			case frustumCullingBenchmark::methodIndex: GASHA_ cullAABBsIndex(v[0], v[1], v[2], v[3], v[4], v[5], size, planes, 6, out_indices); break;
+			case frustumCullingBenchmark::methodParallelMask: GASHA_ parallelCullAABBsMask(v[0], v[1], v[2], v[3], v[4], v[5], size, planes, 6, out_mask); break;
+			case frustumCullingBenchmark::methodParallelIndex: GASHA_ parallelCullAABBsIndex(v[0], v[1], v[2], v[3], v[4], v[5], size, planes, 6, out_indices); break;
+			}
+		}
+	}
+
+	//----------------------------------------
+	//結果の検証
+	//※スカラー版のビットマスク（ref_mask）と比較し、可視数を返す
+	inline bool frustumCullingBenchmarkVerify(const frustumCullingBenchmark::method_type method, const std::size_t size, const std::uint32_t* ref_mask, const std::uint32_t* out_mask, const std::uint32_t* out_indices, const std::size_t index_num, std::size_t& visible_num)
+	{
+		const std::size_t mask_num = (size + 31) / 32;
+		visible_num = 0;
+		for (std::size_t i = 0; i < size; ++i)
+			visible_num += (ref_mask[i >> 5] >> (i & 31)) & 1u;
+		if (method == frustumCullingBenchmark::methodIndex || method == frustumCullingBenchmark::methodParallelIndex)
+		{
+			if (index_num != visible_num)
+				return false;
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				if ((ref_mask[i >> 5] >> (i & 31)) & 1u)
+				{
+					if (out_indices[count] != static_cast<std::uint32_t>(i))
+						return false;
+					++count;
+				}
+			}
+			return true;
+		}
+		return std::memcmp(ref_mask, out_mask, sizeof(std::uint32_t) * mask_num) == 0;
+	}
+}//namespace _private
+
+//----------------------------------------
+//バウンディングボリュームの種類と件数を指定して、全ての判定方法を計測
+template<class FUNCTOR>
+bool frustumCullingBenchmarkTest(const frustumCullingBenchmark::shape_type shape, const std::size_t size, const frustumCullingBenchmark::condition& cond, FUNCTOR functor)
+{
+	if (size == 0)
+		return true;
+	const std::size_t mask_num = (size + 31) / 32;
+	const int val_num = shape == frustumCullingBenchmark::shapeSphere ? 4 : 6;
+	_private::frustumCullingBenchmarkInput input;
+	bool is_allocated = true;
+	for (int i = 0; i < 6; ++i)
+	{
+		input.m_val[i] = i < val_num ? new(std::nothrow) float[size] : nullptr;
+		if (i < val_num && !input.m_val[i])
+			is_allocated = false;
+	}
+	std::uint32_t* ref_mask = new(std::nothrow) std::uint32_t[mask_num];
+	std::uint32_t* out_mask = new(std::nothrow) std::uint32_t[mask_num];
+	std::uint32_t* out_indices = new(std::nothrow) std::uint32_t[size];
+	bool is_ok = is_allocated && ref_mask && out_mask && out_indices;
+	if (is_ok)
+	{
+		_private::frustumCullingBenchmarkMakeInput(input, size, shape);
+		_private::frustumCullingBenchmarkCull(shape, frustumCullingBenchmark::methodScalar, input, size, ref_mask, out_indices);//検証用の結果
+		const std::size_t batch_num = GASHA_ benchmarkBatchNum(size, cond.m_repeatElementNum);
+		const int parallel_thread_num = size < _private::PARALLEL_FRUSTUM_CULLING_SIZE_THRESHOLD ? 1 : _private::parallelFrustumCullingThreadNum();
+		double scalar_elapsed = 0.;
+		for (int method_no = 0; method_no < frustumCullingBenchmark::METHOD_TYPE_NUM; ++method_no)
+		{
+			const frustumCullingBenchmark::method_type method = static_cast<frustumCullingBenchmark::method_type>(method_no);
+			const bool is_parallel = method == frustumCullingBenchmark::methodParallelMask || method == frustumCullingBenchmark::methodParallelIndex;
+			frustumCullingBenchmark::result result = { shape, method, size, is_parallel ? parallel_thread_num : 1, 0., 0., 0., 0, true };
+			//検証
+			std::memset(out_mask, 0, sizeof(std::uint32_t) * mask_num);
+			std::size_t index_num = 0;
+			if (method == frustumCullingBenchmark::methodIndex)
+				index_num = shape == frustumCullingBenchmark::shapeSphere ?
+					GASHA_ cullSpheresIndex(input.m_val[0], input.m_val[1], input.m_val[2], input.m_val[3], size, input.m_planes, 6, out_indices) :
+					GASHA_ cullAABBsIndex(input.m_val[0], input.m_val[1], input.m_val[2], input.m_val[3], input.m_val[4], input.m_val[5], size, input.m_planes, 6, out_indices);
+			else if (method == frustumCullingBenchmark::methodParallelIndex)
+				index_num = shape == frustumCullingBenchmark::shapeSphere ?
+					GASHA_ parallelCullSpheresIndex(input.m_val[0], input.m_val[1], input.m_val[2], input.m_val[3], size, input.m_planes, 6, out_indices) :
+					GASHA_ parallelCullAABBsIndex(input.m_val[0], input.m_val[1], input.m_val[2], input.m_val[3], input.m_val[4], input.m_val[5], size, input.m_planes, 6, out_indices);
+			else
+				_private::frustumCullingBenchmarkCull(shape, method, input, size, out_mask, out_indices);
+			result.m_isOk = _private::frustumCullingBenchmarkVerify(method, size, ref_mask, out_mask, out_indices, index_num, result.m_visibleNum);
+			//計測
+			const double elapsed_min = GASHA_ benchmarkElapsedMin(cond.m_repeatNum, batch_num, [&](const std::size_t)
+				{
+					_private::frustumCullingBenchmarkCull(shape, method, input, size, out_mask, out_indices);
+				});
+			if (method == frustumCullingBenchmark::methodScalar)
+				scalar_elapsed = elapsed_min;
+			const double element_num = static_cast<double>(size) * static_cast<double>(batch_num);
+			result.m_nsPerElement = elapsed_min * 1000000000. / element_num;
+			result.m_mElementsPerSec = elapsed_min > 0. ? element_num / elapsed_min / 1000000. : 0.;
+			result.m_speedUp = elapsed_min > 0. ? scalar_elapsed / elapsed_min : 0.;
+			functor(result);
+			is_ok &= result.m_isOk;
+		}
+	}
+	for (int i = 0; i < 6; ++i)
+		delete[] input.m_val[i];
+	delete[] ref_mask;
+	delete[] out_mask;
+	delete[] out_indices;
+	return is_ok;
+}
+
+//----------------------------------------
+//条件の全ての組み合わせを計測
+template<class FUNCTOR>
+bool frustumCullingBenchmarkTestAll(const frustumCullingBenchmark::condition& cond, FUNCTOR functor)
+{
+	bool is_ok = true;
+	for (std::size_t size = cond.m_sizeMin; size > 0 && size <= cond.m_sizeMax; size *= 10)
+	{
+		for (int shape = 0; shape < frustumCullingBenchmark::SHAPE_TYPE_NUM; ++shape)
+			is_ok &= frustumCullingBenchmarkTest(static_cast<frustumCullingBenchmark::shape_type>(shape), size, cond, functor);
+	}
+	return is_ok;
+}
+
+//----------------------------------------
+//全ての組み合わせを計測し、表とCSVを作成
+inline bool frustumCullingBenchmarkReport(char* table_message, const std::size_t table_max_size, std::size_t& table_message_len, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const frustumCullingBenchmark::condition& cond)
+{
+	return GASHA_ benchmarkReport<frustumCullingBenchmark::definition>(table_message, table_max_size, table_message_len, csv_message, csv_max_size, csv_message_len, cond);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_FRUSTUM_CULLING_BENCHMARK_INL
+
+// End of file
@@ -63,6 +63,9 @@ GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 //※再帰が一定以上深くなったときに切り替えるアルゴリズムは、
 //　本来のヒープソートではなく、シェルソートを使用するスタイルに改良。
 //※整列済み判定を最初に一度行うことで最適化する。
+//※要素型が std::int32_t, std::uint32_t, float で、プレディケート関数が less<T> または std::less<T> の場合、
+//　AVX2が有効なら、（再帰の末）対象件数が64件未満になったときに、
+//　SIMD小規模ソート（ソーティングネットワーク）に切り替える。
 //----------------------------------------
 //プロトタイプ：
 //・bool PREDICATE(const T& value1, const T& value2)//value1 == value2 ならtrueを返す
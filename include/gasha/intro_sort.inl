@@ -23,6 +23,7 @@
 #include <gasha/insertion_sort.h>//挿入ソート
 #include <gasha/shell_sort.h>//シェルソート
 #include <gasha/heap_sort.h>//ヒープソート
+#include <gasha/simd_small_sort.h>//SIMD小規模ソート
 
 #include <gasha/iterator.h>//イテレータ用アルゴリズム
 
@@ -45,7 +46,8 @@ namespace _private
 		//クイックソート：スタック処理版
 		//※再帰処理版は省略。
 		//※純粋なクイックソートと異なり、一定の再帰レベルでクイックソートを打ち切るので、スタックオーバーフローの危険性がない。
-		static const std::size_t SIZE_THRESHOLD = 16;//32;//挿入ソートに切り替える残り件数
+		static const bool IS_SIMD_SMALL_SORT = GASHA_ isSimdSmallSortable<T, PREDICATE>::value;//SIMD小規模ソートが使用可能か？
+		static const std::size_t SIZE_THRESHOLD = IS_SIMD_SMALL_SORT ? GASHA_ SIMD_SMALL_SORT_SIZE_MAX : 16;//32;//挿入ソートに切り替える残り件数
 		std::size_t swapped_count = 0;
 		struct stack_t
 		{
@@ -112,8 +114,13 @@ namespace _private
 				{
 					if (new_size < SIZE_THRESHOLD)
 					{
-						//swapped_count += GASHA_ insertionSort(new_array, new_size, predicate);//【本来の処理】挿入ソートに切り替え
-						swapped_count += GASHA_ shellSort(new_array, new_size, predicate);//【改良】シェルソートに切り替え
+						if (IS_SIMD_SMALL_SORT)
+							swapped_count += GASHA_ simdSmallSort(new_array, new_size, predicate);//【改良】SIMD小規模ソート（ソーティングネットワーク）に切り替え
+						else
+						{
+							//swapped_count += GASHA_ insertionSort(new_array, new_size, predicate);//【本来の処理】挿入ソートに切り替え
+							swapped_count += GASHA_ shellSort(new_array, new_size, predicate);//【改良】シェルソートに切り替え
+						}
 					}
 					else if (new_depth == 0)
 					{
@@ -141,6 +148,8 @@ inline std::size_t introSort(T* array, const std::size_t size, PREDICATE predica
 		return 0;
 	if (GASHA_ isOrdered(array, size, predicate))
 		return 0;
+	if (GASHA_ isSimdSmallSortable<T, PREDICATE>::value && size <= GASHA_ SIMD_SMALL_SORT_SIZE_MAX)
+		return GASHA_ simdSmallSort(array, size, predicate);//SIMD小規模ソート
 	return _private::introSort(array, size, predicate);
 }
 
@@ -0,0 +1,223 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_LF_FRAME_ALLOCATOR_CPP_H
+#define GASHA_INCLUDED_LF_FRAME_ALLOCATOR_CPP_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// lf_frame_allocator.cpp.h
+// ロックフリーフレームアロケータ【関数定義部】
+//
+// ※クラスのインスタンス化が必要な場所でインクルード。
+// ※基本的に、ヘッダーファイル内でのインクルード禁止。
+// 　（コンパイル・リンク時間への影響を気にしないならOK）
+// ※明示的なインスタンス化を避けたい場合は、ヘッダーファイルと共にインクルード。
+// 　（この場合、実際に使用するメンバー関数しかインスタンス化されないので、対象クラスに不要なインターフェースを実装しなくても良い）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/lf_frame_allocator.inl>//ロックフリーフレームアロケータ【インライン関数／テンプレート関数定義部】
+
+#include <gasha/lf_stack_allocator.cpp.h>//ロックフリースタックアロケータ【関数定義部】
+#include <gasha/string.h>//文字列処理：spprintf()
+#include <gasha/simple_assert.h>//シンプルアサーション
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//ロックフリーフレームアロケータクラス
+
+//メモリ確保
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+void* lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::alloc(const std::size_t size, const std::size_t align)
+{
+	while (true)
+	{
+		//現在のフレームをピン留め
+		//※確保中にフレームが破棄（クリア）されないように、確保が終わるまでピン留めする
+		//※ピン留めに失敗した場合は、フレームの切り替え中なのでリトライ
+		const epoch_type epoch = m_epoch.load();
+		if (!pin(epoch))
+			continue;
+		//現在のフレームから確保
+		void* p = stack(frameIndex(epoch)).alloc(size, align);
+		//ピン留め解除
+		unpin(epoch);
+		return p;
+	}
+	return nullptr;//ダミー
+}
+
+//フレームを進める
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+bool lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::nextFrame()
+{
+	const epoch_type now_epoch = m_epoch.load();
+	const epoch_type next_epoch = now_epoch + 1;
+	const std::size_t index = frameIndex(next_epoch);
+	//破棄するフレームの世代を更新
+	//※ピン留めされていたらフェンスポリシーに従って待つ
+	//※世代を更新した時点で、以後、破棄されたフレームのピン留めは失敗する
+	fence_type fence;
+	while (true)
+	{
+		state_type now_state = m_state[index].load();
+		if (statePinCount(now_state) > 0)//ピン留め中
+		{
+			if (!fence.waitForUnpin())
+				return false;
+			continue;
+		}
+		if (m_state[index].compare_exchange_weak(now_state, makeState(next_epoch, 0)))//世代＋ピン留め数のCAS
+			break;
+	}
+	//破棄したフレームの領域をクリアして新しいフレームにする
+	stack(index).clear();
+	//現在のフレームを更新
+	m_epoch.store(next_epoch);
+	return true;
+}
+
+//フレームのピン留め
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::epoch_type lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::pin()
+{
+	while (true)
+	{
+		const epoch_type epoch = m_epoch.load();
+		if (pin(epoch))
+			return epoch;
+		//フレームの切り替え中ならリトライ
+	}
+	return 0;//ダミー
+}
+//※世代指定版
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+bool lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::pin(const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::epoch_type epoch)
+{
+	const std::size_t index = frameIndex(epoch);
+	while (true)
+	{
+		state_type now_state = m_state[index].load();
+		if (stateEpoch(now_state) != epoch)//破棄済み
+			return false;
+		if (m_state[index].compare_exchange_weak(now_state, now_state + 1))//ピン留め数のCAS
+			return true;
+	}
+	return false;//ダミー
+}
+
+//フレームのピン留め解除
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+bool lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::unpin(const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::epoch_type epoch)
+{
+	const std::size_t index = frameIndex(epoch);
+	while (true)
+	{
+		state_type now_state = m_state[index].load();
+		if (stateEpoch(now_state) != epoch || statePinCount(now_state) == 0)//ピン留めされていない
+		{
+		#ifdef GASHA_LF_FRAME_ALLOCATOR_ENABLE_ASSERTION
+			GASHA_SIMPLE_ASSERT(false, "Frame is not pinned.");
+		#endif//GASHA_LF_FRAME_ALLOCATOR_ENABLE_ASSERTION
+			return false;
+		}
+		if (m_state[index].compare_exchange_weak(now_state, now_state - 1))//ピン留め数のCAS
+			return true;
+	}
+	return false;//ダミー
+}
+
+//メモリクリア
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+void lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::clear()
+{
+	for (std::size_t index = 0; index < FRAME_NUM; ++index)
+		stack(index).clear();
+}
+
+//デバッグ情報作成
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+std::size_t lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::debugInfo(char* message, const std::size_t max_size) const
+{
+	std::size_t message_len = 0;
+	const epoch_type now_epoch = epoch();
+	GASHA_ spprintf(message, max_size, message_len, "----- Debug-info for lfFrameAllocator -----\n");
+	GASHA_ spprintf(message, max_size, message_len, "buff=%p, maxSize=%d, size=%d, remain=%d, count=%d, frameNum=%d, frameMaxSize=%d, epoch=%u, fence=%s\n", m_buffRef, maxSize(), this->size(), remain(), count(), static_cast<int>(FRAME_NUM), frameMaxSize(), now_epoch, mode());
+	for (std::size_t index = 0; index < FRAME_NUM; ++index)
+	{
+		const state_type state = m_state[index].load();
+		const stack_type& frame = stack(index);
+		GASHA_ spprintf(message, max_size, message_len, "[%d] epoch=%u, pin=%d, size=%d, remain=%d, count=%d%s\n", static_cast<int>(index), stateEpoch(state), statePinCount(state), frame.size(), frame.remain(), frame.count(), stateEpoch(state) == now_epoch ? " <- current" : "");
+	}
+	GASHA_ spprintf(message, max_size, message_len, "-------------------------------------------");//最終行改行なし
+	return message_len;
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//----------------------------------------
+//明示的なインスタンス化
+
+//ロックフリーフレームアロケータの明示的なインスタンス化用マクロ
+//※フレーム数指定版
+#define GASHA_INSTANCING_lfFrameAllocator(_FRAME_NUM) \
+	template class GASHA_ lfFrameAllocator<_FRAME_NUM>;
+//※フレーム数とフェンス指定版
+#define GASHA_INSTANCING_lfFrameAllocator_withFence(_FRAME_NUM, FENCE_POLICY) \
+	template class GASHA_ lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>;
+
+//ダブルバッファフレームアロケータの明示的なインスタンス化用マクロ
+#define GASHA_INSTANCING_lfDoubleBufferedFrameAllocator() \
+	template class GASHA_ lfFrameAllocator<2>;
+
+//--------------------------------------------------------------------------------
+//【注】明示的インスタンス化に失敗する場合
+// ※このコメントは、「明示的なインスタンス化マクロ」が定義されている全てのソースコードに
+// 　同じ内容のものをコピーしています。
+//--------------------------------------------------------------------------------
+//【原因①】
+// 　対象クラスに必要なインターフェースが実装されていない。
+//
+// 　例えば、ソート処理に必要な「bool operator<(const value_type&) const」か「friend bool operator<(const value_type&, const value_type&)」や、
+// 　探索処理に必要な「bool operator==(const key_type&) const」か「friend bool operator==(const value_type&, const key_type&)」。
+//
+// 　明示的なインスタンス化を行う場合、実際に使用しない関数のためのインターフェースも確実に実装する必要がある。
+// 　逆に言えば、明示的なインスタンス化を行わない場合、使用しない関数のためのインターフェースを実装する必要がない。
+//
+//【対策１】
+// 　インターフェースをきちんと実装する。
+// 　（無難だが、手間がかかる。）
+//
+//【対策２】
+// 　明示的なインスタンス化を行わずに、.cpp.h をテンプレート使用前にインクルードする。
+// 　（手間がかからないが、コンパイル時の依存ファイルが増えるので、コンパイルが遅くなる可能性がある。）
+//
+//--------------------------------------------------------------------------------
+//【原因②】
+// 　同じ型のインスタンスが複数作成されている。
+//
+// 　通常、テンプレートクラス／関数の同じ型のインスタンスが複数作られても、リンク時に一つにまとめられるため問題がない。
+// 　しかし、一つのソースファイルの中で複数のインスタンスが生成されると、コンパイラによってはエラーになる。
+//   GCCの場合のエラーメッセージ例：（VC++ではエラーにならない）
+// 　  source_file.cpp.h:114:17: エラー: duplicate explicit instantiation of ‘class templateClass<>’ [-fpermissive]
+//
+//【対策１】
+// 　別のファイルに分けてインスタンス化する。
+// 　（コンパイルへの影響が少なく、良い方法だが、無駄にファイル数が増える可能性がある。）
+//
+//【対策２】
+// 　明示的なインスタンス化を行わずに、.cpp.h をテンプレート使用前にインクルードする。
+// 　（手間がかからないが、コンパイル時の依存ファイルが増えるので、コンパイルが遅くなる可能性がある。）
+//
+//【対策３】
+// 　GCCのコンパイラオプションに、 -fpermissive を指定し、エラーを警告に格下げする。
+// 　（最も手間がかからないが、常時多数の警告が出る状態になりかねないので注意。）
+//--------------------------------------------------------------------------------
+
+#endif//GASHA_INCLUDED_LF_FRAME_ALLOCATOR_CPP_H
+
+// End of file
@@ -0,0 +1,267 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_LF_FRAME_ALLOCATOR_H
+#define GASHA_INCLUDED_LF_FRAME_ALLOCATOR_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// lf_frame_allocator.h
+// ロックフリーフレームアロケータ【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/allocator_common.h>//メモリアロケータ共通設定
+#include <gasha/lf_stack_allocator.h>//ロックフリースタックアロケータ
+#include <gasha/allocator_adapter.h>//アロケータアダプタ
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint32_t, std::uint64_t
+#include <atomic>//C++11 std::atomic
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//ロックフリーフレームアロケータ補助クラス
+
+//----------------------------------------
+//フレームフェンス：ピン留め解除待ち
+//※フレーム破棄時に、対象フレームがピン留めされていたら、解除されるまで待つ
+class lfFrameAllocatorWaitFence
+{
+public:
+	//名前
+	inline static const char* name(){ return "WaitFence"; }
+	//ピン留め解除待ち
+	//※リトライする場合は true を返す
+	inline bool waitForUnpin();
+};
+
+//----------------------------------------
+//フレームフェンス（ダミー）
+//※待たない（フレーム破棄に失敗する）
+class dummyLfFrameAllocatorFence
+{
+public:
+	//名前
+	inline static const char* name(){ return "NoWait"; }
+	//ピン留め解除待ち
+	//※リトライする場合は true を返す
+	inline bool waitForUnpin();
+};
+
+//--------------------------------------------------------------------------------
+//ロックフリーフレームアロケータクラス
+//※バッファを FRAME_NUM 個のフレーム領域に等分し、フレームごとにロックフリースタックアロケータとして使用する。
+//※メモリ確保は、常に現在のフレーム領域から行う。
+//※nextFrame() でフレームを進めると、FRAME_NUM フレーム前の領域が破棄（クリア）され、新しいフレームの領域として再利用される。
+//　（例えば、FRAME_NUM = 2 ならダブルバッファになり、前のフレームのデータを他のスレッドが使用している間に、次のフレームのデータを作成できる）
+//※FRAME_NUM は 2 のべき乗であること。（32ビットの世代が一周しても、世代 % FRAME_NUM の対応が崩れないようにするため）
+//※各フレームには世代番号（エポック）が付き、pin() / unpin() でピン留めしている間は破棄されない。
+//　ピン留めされたフレームを破棄しようとした時の挙動は、フェンスポリシーで指定する。
+//※alloc() も確保中はフレームを一時的にピン留めする。
+//　そのため、破棄するフレームで確保中のスレッドがあると、nextFrame() はフェンスポリシーに従って待つ（または失敗する）。
+//※free()を呼んでも、フレームが破棄されるまでバッファは解放されない。
+//※【注意】破棄されたフレームのポインタに対して free() を呼んではいけない。
+template<std::size_t _FRAME_NUM = 2, class FENCE_POLICY = lfFrameAllocatorWaitFence>
+class lfFrameAllocator
+{
+public:
+	//型
+	typedef FENCE_POLICY fence_type;//フェンス型
+	typedef std::uint32_t size_type;//サイズ型
+	typedef std::uint32_t epoch_type;//世代型
+	typedef std::uint64_t state_type;//世代＋ピン留め数混成型
+	typedef GASHA_ lfStackAllocator<> stack_type;//フレーム領域のスタックアロケータ型
+
+public:
+	//定数
+	static const std::size_t FRAME_NUM = _FRAME_NUM;//フレーム数
+	static_assert(FRAME_NUM >= 2, "FRAME_NUM must be 2 or more.");
+	static_assert((FRAME_NUM & (FRAME_NUM - 1)) == 0, "FRAME_NUM must be a power of 2.");//世代が一周しても、世代とフレームの対応が崩れないようにするため
+
+public:
+	//アクセッサ
+	const char* name() const { return "lfFrameAllocator"; }//アロケータ名
+	const char* mode() const { return fence_type::name(); }//実装モード名
+	inline const void* buff() const { return reinterpret_cast<const void*>(m_buffRef); }//バッファの先頭アドレス
+	inline size_type maxSize() const { return m_maxSize; }//バッファの全体サイズ（バイト数）
+	inline size_type frameMaxSize() const { return m_frameMaxSize; }//フレーム一つ当たりのサイズ（バイト数）
+	inline size_type size() const;//使用中のサイズ（バイト数） ※全フレームの合計
+	inline size_type remain() const;//残りサイズ（バイト数） ※現在のフレームで確保可能なサイズ
+	inline size_type count() const;//アロケート中の数 ※全フレームの合計
+	inline epoch_type epoch() const { return m_epoch.load(); }//現在のフレームの世代
+	inline size_type frameSize(const epoch_type epoch) const;//指定世代のフレームの使用中のサイズ（バイト数） ※破棄済みなら 0
+	inline size_type frameCount(const epoch_type epoch) const;//指定世代のフレームのアロケート中の数 ※破棄済みなら 0
+	inline size_type pinCount(const epoch_type epoch) const;//指定世代のフレームのピン留め数 ※破棄済みなら 0
+	inline bool isAlive(const epoch_type epoch) const;//指定世代のフレームが有効か？（破棄されていないか？）
+
+public:
+	//アロケータアダプタ取得
+	inline GASHA_ allocatorAdapter<lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>> adapter(){ GASHA_ allocatorAdapter<lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>> adapter(*this, name(), mode()); return adapter; }
+
+public:
+	//メソッド
+
+	//メモリ確保
+	//※現在のフレームから確保する
+	void* alloc(const std::size_t size, const std::size_t align = GASHA_ DEFAULT_ALIGN);
+
+	//メモリ解放
+	//※実際にはメモリを解放しない（できない）ので注意。
+	//※フレームのアロケート中の数を減らすだけ。
+	inline bool free(void* p);
+
+	//メモリ確保とコンストラクタ呼び出し
+	template<typename T, typename...Tx>
+	T* newObj(Tx&&... args);
+	//※配列用
+	template<typename T, typename...Tx>
+	T* newArray(const std::size_t num, Tx&&... args);
+
+	//メモリ解放とデストラクタ呼び出し
+	template<typename T>
+	bool deleteObj(T* p);
+	//※配列用（要素数の指定が必要な点に注意）
+	template<typename T>
+	bool deleteArray(T* p, const std::size_t num);
+
+	//フレームを進める
+	//※FRAME_NUM フレーム前のフレームを破棄し、その領域をクリアして新しいフレームにする。
+	//※破棄するフレームがピン留めされている場合、フェンスポリシーに従って待つ。
+	//　待たずに失敗した場合は false を返す。（フレームは進まない）
+	//※【注意】複数のスレッドから同時に呼び出してはいけない。
+	bool nextFrame();
+
+	//フレームのピン留め
+	//※ピン留め中のフレームは破棄されない。
+	//※現在のフレームをピン留めし、その世代を返す。
+	epoch_type pin();
+	//※世代指定版
+	//※既に破棄されたフレームの場合は false を返す。
+	bool pin(const epoch_type epoch);
+
+	//フレームのピン留め解除
+	//※pin() に成功した回数だけ呼び出す必要がある。
+	bool unpin(const epoch_type epoch);
+
+	//メモリクリア
+	//※全てのフレームのメモリをクリアする（世代は変わらない）
+	//※【注意】メモリ確保状態（アロケート中の数）やピン留め状態と無関係に実行するので注意
+	void clear();
+
+	//デバッグ情報作成
+	//※十分なサイズのバッファを渡す必要あり。
+	//※使用したバッファのサイズを返す。
+	//※作成中、他のスレッドで操作が発生すると、不整合が生じる可能性がある点に注意
+	std::size_t debugInfo(char* message, const std::size_t max_size) const;
+
+private:
+	//世代からフレームのインデックスを取得
+	inline static std::size_t frameIndex(const epoch_type epoch);
+	//世代＋ピン留め数混成値の作成／分解
+	inline static state_type makeState(const epoch_type epoch, const size_type pin_count);
+	inline static epoch_type stateEpoch(const state_type state);
+	inline static size_type statePinCount(const state_type state);
+	//フレーム領域のスタックアロケータ取得
+	inline stack_type& stack(const std::size_t index);
+	inline const stack_type& stack(const std::size_t index) const;
+	//ポインタが含まれるフレームのインデックスを取得
+	//※どこにも含まれない場合は FRAME_NUM を返す
+	inline std::size_t findFrameIndex(void* p) const;
+
+public:
+	//コンストラクタ
+	inline lfFrameAllocator(void* buff, const std::size_t max_size);
+	template<typename T>
+	inline lfFrameAllocator(T* buff, const std::size_t num);
+	template<typename T, std::size_t N>
+	inline lfFrameAllocator(T (&buff)[N]);
+	//デストラクタ
+	inline ~lfFrameAllocator();
+
+private:
+	//フィールド
+	char* m_buffRef;//バッファの参照
+	const size_type m_maxSize;//バッファの全体サイズ
+	const size_type m_frameMaxSize;//フレーム一つ当たりのサイズ
+	std::atomic<epoch_type> m_epoch;//現在のフレームの世代
+	std::atomic<state_type> m_state[FRAME_NUM];//フレームごとの世代＋ピン留め数
+	GASHA_ALIGNAS_OF(stack_type) char m_stackBuff[FRAME_NUM][sizeof(stack_type)];//フレームごとのスタックアロケータ
+};
+
+//--------------------------------------------------------------------------------
+//バッファ付きロックフリーフレームアロケータクラス
+template<std::size_t _MAX_SIZE, std::size_t _FRAME_NUM = 2, class FENCE_POLICY = lfFrameAllocatorWaitFence>
+class lfFrameAllocator_withBuff : public lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>
+{
+	//定数
+	static const std::size_t MAX_SIZE = _MAX_SIZE;//バッファの全体サイズ
+public:
+	//コンストラクタ
+	inline lfFrameAllocator_withBuff();
+	//デストラクタ
+	inline ~lfFrameAllocator_withBuff();
+private:
+	char m_buff[MAX_SIZE];//バッファ
+};
+
+//----------------------------------------
+//ロックフリーフレームアロケータ別名定義：ダブルバッファフレームアロケータ
+template<class FENCE_POLICY = lfFrameAllocatorWaitFence>
+using lfDoubleBufferedFrameAllocator = lfFrameAllocator<2, FENCE_POLICY>;
+
+//※バッファ付き
+template<std::size_t _MAX_SIZE, class FENCE_POLICY = lfFrameAllocatorWaitFence>
+using lfDoubleBufferedFrameAllocator_withBuff = lfFrameAllocator_withBuff<_MAX_SIZE, 2, FENCE_POLICY>;
+
+//--------------------------------------------------------------------------------
+//スコープフレームピン留めクラス
+//※コンストラクタでフレームをピン留めし、デストラクタでピン留めを解除する。
+template<class ALLOCATOR>
+class scopedFramePin
+{
+public:
+	//型
+	typedef ALLOCATOR allocator_type;//アロケータ型
+	typedef typename allocator_type::epoch_type epoch_type;//世代型
+
+public:
+	//アクセッサ
+	inline epoch_type epoch() const { return m_epoch; }//ピン留め中の世代
+	inline bool isPinned() const { return m_isPinned; }//ピン留め中か？
+
+public:
+	//コンストラクタ
+	//※現在のフレームをピン留め
+	inline scopedFramePin(allocator_type& allocator);
+	//※世代指定版
+	inline scopedFramePin(allocator_type& allocator, const epoch_type epoch);
+	//ムーブコンストラクタ
+	inline scopedFramePin(scopedFramePin&& obj);
+	//コピーコンストラクタ
+	scopedFramePin(const scopedFramePin&) = delete;
+	//デストラクタ
+	inline ~scopedFramePin();
+private:
+	//フィールド
+	allocator_type& m_allocator;//アロケータ
+	epoch_type m_epoch;//ピン留め中の世代
+	bool m_isPinned;//ピン留め中か？
+};
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/lf_frame_allocator.inl>
+
+//.hファイルのインクルードに伴い、常に.cpp.hファイル（および.inlファイル）を自動インクルードする場合
+#ifdef GASHA_LF_FRAME_ALLOCATOR_ALLWAYS_TOGETHER_CPP_H
+#include <gasha/lf_frame_allocator.cpp.h>
+#endif//GASHA_LF_FRAME_ALLOCATOR_ALLWAYS_TOGETHER_CPP_H
+
+#endif//GASHA_INCLUDED_LF_FRAME_ALLOCATOR_H
+
+// End of file
@@ -0,0 +1,335 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_LF_FRAME_ALLOCATOR_INL
+#define GASHA_INCLUDED_LF_FRAME_ALLOCATOR_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// lf_frame_allocator.inl
+// ロックフリーフレームアロケータ【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/lf_frame_allocator.h>//ロックフリーフレームアロケータ【宣言部】
+
+#include <gasha/allocator_common.h>//アロケータ共通設定・処理：コンストラクタ／デストラクタ呼び出し
+#include <gasha/lock_common.h>//ロック共通設定：defaultContextSwitch()
+#include <gasha/simple_assert.h>//シンプルアサーション
+
+#include <utility>//C++11 std::forward
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//ロックフリーフレームアロケータ補助クラス
+
+//----------------------------------------
+//フレームフェンス：ピン留め解除待ち
+
+//ピン留め解除待ち
+inline bool lfFrameAllocatorWaitFence::waitForUnpin()
+{
+	GASHA_ defaultContextSwitch();//コンテキストスイッチ
+	return true;//リトライ
+}
+
+//----------------------------------------
+//フレームフェンス（ダミー）
+
+//ピン留め解除待ち
+inline bool dummyLfFrameAllocatorFence::waitForUnpin()
+{
+	return false;//リトライしない
+}
+
+//--------------------------------------------------------------------------------
+//ロックフリーフレームアロケータクラス
+
+//使用中のサイズ
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::size_type lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::size() const
+{
+	size_type total = 0;
+	for (std::size_t index = 0; index < FRAME_NUM; ++index)
+		total += stack(index).size();
+	return total;
+}
+
+//残りサイズ
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::size_type lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::remain() const
+{
+	return stack(frameIndex(m_epoch.load())).remain();
+}
+
+//アロケート中の数
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::size_type lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::count() const
+{
+	size_type total = 0;
+	for (std::size_t index = 0; index < FRAME_NUM; ++index)
+		total += stack(index).count();
+	return total;
+}
+
+//指定世代のフレームの使用中のサイズ
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::size_type lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::frameSize(const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::epoch_type epoch) const
+{
+	if (!isAlive(epoch))
+		return 0;
+	return stack(frameIndex(epoch)).size();
+}
+
+//指定世代のフレームのアロケート中の数
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::size_type lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::frameCount(const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::epoch_type epoch) const
+{
+	if (!isAlive(epoch))
+		return 0;
+	return stack(frameIndex(epoch)).count();
+}
+
+//指定世代のフレームのピン留め数
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::size_type lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::pinCount(const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::epoch_type epoch) const
+{
+	const state_type state = m_state[frameIndex(epoch)].load();
+	if (stateEpoch(state) != epoch)
+		return 0;
+	return statePinCount(state);
+}
+
+//指定世代のフレームが有効か？
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline bool lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::isAlive(const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::epoch_type epoch) const
+{
+	return stateEpoch(m_state[frameIndex(epoch)].load()) == epoch;
+}
+
+//メモリ解放
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline bool lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::free(void* p)
+{
+	if (!p)//nullptrの解放は常に成功扱い
+		return true;
+	const std::size_t index = findFrameIndex(p);
+	if (index == FRAME_NUM)//正しいポインタか判定
+		return false;
+	return stack(index).free(p);
+}
+
+//メモリ確保とコンストラクタ呼び出し
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+template<typename T, typename...Tx>
+T* lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::newObj(Tx&&... args)
+{
+	void* p = alloc(sizeof(T), alignof(T));
+	if (!p)
+		return nullptr;
+	return GASHA_ callConstructor<T>(p, std::forward<Tx>(args)...);
+}
+//※配列用
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+template<typename T, typename...Tx>
+T* lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::newArray(const std::size_t num, Tx&&... args)
+{
+	void* p = alloc(sizeof(T) * num, alignof(T));
+	if (!p)
+		return nullptr;
+	T* top_obj = nullptr;
+	for (std::size_t i = 0; i < num; ++i)
+	{
+		T* obj = GASHA_ callConstructor<T>(p, std::forward<Tx>(args)...);
+		if (!top_obj)
+			top_obj = obj;
+		p = reinterpret_cast<void*>(reinterpret_cast<char*>(p) + sizeof(T));
+	}
+	return top_obj;
+}
+
+//メモリ解放とデストラクタ呼び出し
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+template<typename T>
+bool lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::deleteObj(T* p)
+{
+	if (!p)//nullptrの解放は常に成功扱い
+		return true;
+	const std::size_t index = findFrameIndex(p);
+	if (index == FRAME_NUM)//正しいポインタか判定
+		return false;
+	GASHA_ callDestructor(p);//デストラクタ呼び出し
+	return stack(index).free(p);
+}
+//※配列用
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+template<typename T>
+bool lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::deleteArray(T* p, const std::size_t num)
+{
+	if (!p)//nullptrの解放は常に成功扱い
+		return true;
+	const std::size_t index = findFrameIndex(p);
+	if (index == FRAME_NUM)//正しいポインタか判定
+		return false;
+	T* obj = p;
+	for (std::size_t i = 0; i < num; ++i, ++obj)
+	{
+		GASHA_ callDestructor(obj);//デストラクタ呼び出し
+	}
+	return stack(index).free(p);
+}
+
+//世代からフレームのインデックスを取得
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline std::size_t lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::frameIndex(const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::epoch_type epoch)
+{
+	return static_cast<std::size_t>(epoch) % FRAME_NUM;
+}
+
+//世代＋ピン留め数混成値の作成
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::state_type lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::makeState(const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::epoch_type epoch, const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::size_type pin_count)
+{
+	return (static_cast<state_type>(epoch) << 32) | static_cast<state_type>(pin_count);
+}
+
+//世代＋ピン留め数混成値から世代を取得
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::epoch_type lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::stateEpoch(const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::state_type state)
+{
+	return static_cast<epoch_type>(state >> 32);
+}
+
+//世代＋ピン留め数混成値からピン留め数を取得
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::size_type lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::statePinCount(const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::state_type state)
+{
+	return static_cast<size_type>(state & 0xffffffffull);
+}
+
+//フレーム領域のスタックアロケータ取得
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::stack_type& lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::stack(const std::size_t index)
+{
+	return *reinterpret_cast<stack_type*>(m_stackBuff[index]);
+}
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline const typename lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::stack_type& lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::stack(const std::size_t index) const
+{
+	return *reinterpret_cast<const stack_type*>(m_stackBuff[index]);
+}
+
+//ポインタが含まれるフレームのインデックスを取得
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline std::size_t lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::findFrameIndex(void* p) const
+{
+	const char* ptr = reinterpret_cast<const char*>(p);
+	if (ptr < m_buffRef || ptr >= m_buffRef + m_frameMaxSize * FRAME_NUM)//範囲外のポインタ
+	{
+	#ifdef GASHA_LF_FRAME_ALLOCATOR_ENABLE_ASSERTION
+		GASHA_SIMPLE_ASSERT(false, "Pointer is not in range.");
+	#endif//GASHA_LF_FRAME_ALLOCATOR_ENABLE_ASSERTION
+		return FRAME_NUM;
+	}
+	return static_cast<std::size_t>(ptr - m_buffRef) / m_frameMaxSize;
+}
+
+//コンストラクタ
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::lfFrameAllocator(void* buff, const std::size_t max_size) :
+	m_buffRef(reinterpret_cast<char*>(buff)),
+	m_maxSize(static_cast<size_type>(max_size)),
+	m_frameMaxSize(static_cast<size_type>(max_size / FRAME_NUM)),
+	m_epoch(0)
+{
+#ifdef GASHA_LF_FRAME_ALLOCATOR_ENABLE_ASSERTION
+	GASHA_SIMPLE_ASSERT(m_buffRef != nullptr, "buff is nullptr.");
+	GASHA_SIMPLE_ASSERT(m_frameMaxSize > 0, "max_size is too small.");
+#endif//GASHA_LF_FRAME_ALLOCATOR_ENABLE_ASSERTION
+	//フレームごとのスタックアロケータと世代を初期化
+	//※世代 0 のフレームが現在のフレーム、それ以外は世代 -(FRAME_NUM - index) の破棄待ちフレームとして扱う
+	for (std::size_t index = 0; index < FRAME_NUM; ++index)
+	{
+		GASHA_ callConstructor<stack_type>(m_stackBuff[index], m_buffRef + m_frameMaxSize * index, m_frameMaxSize);
+		const epoch_type epoch = index == 0 ? 0 : static_cast<epoch_type>(index - FRAME_NUM);
+		m_state[index].store(makeState(epoch, 0));
+	}
+}
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+template<typename T>
+inline lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::lfFrameAllocator(T* buff, const std::size_t num) :
+	lfFrameAllocator(reinterpret_cast<void*>(buff), sizeof(T) * num)//C++11 委譲コンストラクタ
+{}
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+template<typename T, std::size_t N>
+inline lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::lfFrameAllocator(T(&buff)[N]) :
+	lfFrameAllocator(reinterpret_cast<void*>(buff), sizeof(buff))//C++11 委譲コンストラクタ
+{}
+
+//デストラクタ
+template<std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>::~lfFrameAllocator()
+{
+	for (std::size_t index = 0; index < FRAME_NUM; ++index)
+		GASHA_ callDestructor(&stack(index));
+}
+
+//--------------------------------------------------------------------------------
+//バッファ付きロックフリーフレームアロケータクラス
+
+//コンストラクタ
+template<std::size_t _MAX_SIZE, std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline lfFrameAllocator_withBuff<_MAX_SIZE, _FRAME_NUM, FENCE_POLICY>::lfFrameAllocator_withBuff() :
+	lfFrameAllocator<_FRAME_NUM, FENCE_POLICY>(m_buff, MAX_SIZE)
+{}
+
+//デストラクタ
+template<std::size_t _MAX_SIZE, std::size_t _FRAME_NUM, class FENCE_POLICY>
+inline lfFrameAllocator_withBuff<_MAX_SIZE, _FRAME_NUM, FENCE_POLICY>::~lfFrameAllocator_withBuff()
+{}
+
+//--------------------------------------------------------------------------------
+//スコープフレームピン留めクラス
+
+//コンストラクタ
+template<class ALLOCATOR>
+inline scopedFramePin<ALLOCATOR>::scopedFramePin(typename scopedFramePin<ALLOCATOR>::allocator_type& allocator) :
+	m_allocator(allocator),
+	m_epoch(allocator.pin()),
+	m_isPinned(true)
+{}
+template<class ALLOCATOR>
+inline scopedFramePin<ALLOCATOR>::scopedFramePin(typename scopedFramePin<ALLOCATOR>::allocator_type& allocator, const typename scopedFramePin<ALLOCATOR>::epoch_type epoch) :
+	m_allocator(allocator),
+	m_epoch(epoch),
+	m_isPinned(allocator.pin(epoch))
+{}
+
+//ムーブコンストラクタ
+template<class ALLOCATOR>
+inline scopedFramePin<ALLOCATOR>::scopedFramePin(scopedFramePin<ALLOCATOR>&& obj) :
+	m_allocator(obj.m_allocator),
+	m_epoch(obj.m_epoch),
+	m_isPinned(obj.m_isPinned)
+{
+	obj.m_isPinned = false;
+}
+
+//デストラクタ
+template<class ALLOCATOR>
+inline scopedFramePin<ALLOCATOR>::~scopedFramePin()
+{
+	if (m_isPinned)
+		m_allocator.unpin(m_epoch);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_LF_FRAME_ALLOCATOR_INL
+
+// End of file
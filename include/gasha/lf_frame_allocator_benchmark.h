@@ -0,0 +1,144 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_LF_FRAME_ALLOCATOR_BENCHMARK_H
+#define GASHA_INCLUDED_LF_FRAME_ALLOCATOR_BENCHMARK_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// lf_frame_allocator_benchmark.h
+// ロックフリーフレームアロケータベンチマーク【宣言部】
+//
+// ※ロックフリーフレームアロケータの関数定義部（.cpp.h）を含むため、
+// 　ユニットテストなどのソースファイルでインクルードすること。
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/lf_frame_allocator.h>//ロックフリーフレームアロケータ
+#include <gasha/benchmark_report.h>//ベンチマーク共通処理
+
+#include <cstddef>//std::size_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//ロックフリーフレームアロケータベンチマーク
+//※フレームごとに alloc_num 個のメモリを確保し、フレームを進める処理を繰り返して、
+//　1回の確保あたりの時間を、フレームごとの new / delete と比較する。
+//　・lfFrameAllocator ... alloc() で確保し、nextFrame() で FRAME_NUM フレーム前の領域をまとめて破棄。
+//　・new / delete     ... new char[] で確保し、FRAME_NUM フレーム後に delete[] で個別に解放。
+//　（どちらも、確保したメモリの先頭に1バイト書き込む）
+//※thread_num に 2 以上を指定すると、フレーム内の確保を OpenMP で並列に行う。
+//　（OpenMP 無効時は常に1スレッド）
+//※表／CSVは、確保サイズ（ALLOC_SIZE_LIST）× スレッド数（1, 2, 4, ... , omp_get_max_threads()）の組み合わせごとに計測して作る。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //個別に計測
+//  const lfFrameAllocatorBenchmark::result result = lfFrameAllocatorBenchmarkTest<2>(1000, 1024, 64, 4);
+//  printf("frame=%.2lf ns, new/delete=%.2lf ns\n", result.m_frameAllocNs, result.m_newDeleteNs);
+//
+//  //確保サイズとスレッド数ごとの結果を表にする
+//  char message[4096];
+//  std::size_t size;
+//  lfFrameAllocatorBenchmarkReport(message, sizeof(message), size, 1000);
+//
+//  //表とCSVをバッファに作成
+//  lfFrameAllocatorBenchmark::condition cond;
+//  static char table[4096];
+//  static char csv[4096];
+//  std::size_t table_len, csv_len;
+//  benchmarkReport<lfFrameAllocatorBenchmark::definition>(table, sizeof(table), table_len, csv, sizeof(csv), csv_len, cond);
+//
+//  //ユニットテストで実行（全ての確保に成功したか判定し、計測結果を表示）
+//  GASHA_UT_BEGIN(lf_frame_allocator_benchmark, 0, GASHA_ ut::ATTR_MANUAL)
+//  {
+//      GASHA_UT_LF_FRAME_ALLOCATOR_BENCHMARK(1000);
+//  }
+//  GASHA_UT_END()
+//--------------------------------------------------------------------------------
+
+namespace lfFrameAllocatorBenchmark
+{
+	//計測結果
+	struct result
+	{
+		bool m_isOk;//全ての確保に成功し、最後にアロケート中の数が 0 になったか？
+		int m_threadNum;//実際のスレッド数
+		double m_frameAllocNs;//lfFrameAllocator：1回の確保あたりの時間（ナノ秒）
+		double m_newDeleteNs;//new / delete：1回の確保あたりの時間（ナノ秒）
+		std::size_t m_allocSize;//1回の確保サイズ
+	};
+	//計測する確保サイズ
+	static const std::size_t ALLOC_SIZE_LIST[] = { 16, 64, 256, 1024 };
+	static const int ALLOC_SIZE_NUM = static_cast<int>(sizeof(ALLOC_SIZE_LIST) / sizeof(ALLOC_SIZE_LIST[0]));
+
+	//計測条件
+	struct condition
+	{
+		std::size_t m_frameCount;//計測するフレーム数
+		std::size_t m_allocNum;//1フレームあたりの確保数
+		inline condition();
+	};
+
+	//ベンチマーク定義
+	//※benchmarkReport() などに渡す（benchmark_report.h 参照）
+	struct definition
+	{
+		typedef condition condition_type;//計測条件の型
+		typedef result result_type;//計測結果の型
+		//表のタイトル
+		inline static void writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond);
+		//表形式
+		inline static void writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+		inline static void writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+		//CSV形式
+		inline static void writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+		inline static void writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+		//全ての組み合わせを計測
+		template<class FUNCTOR>
+		inline static bool testAll(const condition_type& cond, FUNCTOR functor);
+	};
+}//namespace lfFrameAllocatorBenchmark
+
+//----------------------------------------
+//フレームアロケータと new / delete の処理時間を計測
+//※frame_count ... 計測するフレーム数
+//※alloc_num ... 1フレームあたりの確保数
+//※alloc_size ... 1回の確保サイズ
+//※thread_num ... 並列に確保するスレッド数
+template<std::size_t FRAME_NUM>
+lfFrameAllocatorBenchmark::result lfFrameAllocatorBenchmarkTest(const std::size_t frame_count, const std::size_t alloc_num, const std::size_t alloc_size, const int thread_num);
+
+//----------------------------------------
+//確保サイズとスレッド数の全ての組み合わせを計測（ダブルバッファ）
+//※計測結果ごとに functor(const lfFrameAllocatorBenchmark::result&) を呼び出す
+//※全ての計測で確保に成功したら true を返す
+template<class FUNCTOR>
+bool lfFrameAllocatorBenchmarkTestAll(const lfFrameAllocatorBenchmark::condition& cond, FUNCTOR functor);
+
+//----------------------------------------
+//確保サイズとスレッド数ごとの計測結果を表にする（ダブルバッファ）
+//※全ての計測で確保に成功したら true を返す
+//※診断結果メッセージとそのサイズを受け取るための変数を引数に渡す（バッファは4KBもあれば十分）。
+inline bool lfFrameAllocatorBenchmarkReport(char* message, const std::size_t max_size, std::size_t& message_len, const std::size_t frame_count = 1000, const std::size_t alloc_num = 1024);
+
+//----------------------------------------
+//ユニットテスト用マクロ
+//※GASHA_UT_BEGIN() ～ GASHA_UT_END() の中で使用する
+#define GASHA_UT_LF_FRAME_ALLOCATOR_BENCHMARK(frame_count) \
+	{ \
+		GASHA_ lfFrameAllocatorBenchmark::condition bench_cond; \
+		bench_cond.m_frameCount = frame_count; \
+		GASHA_UT_BENCHMARK(GASHA_ lfFrameAllocatorBenchmark::definition, bench_cond); \
+	}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/lf_frame_allocator_benchmark.inl>
+
+#endif//GASHA_INCLUDED_LF_FRAME_ALLOCATOR_BENCHMARK_H
+
+// End of file
@@ -0,0 +1,187 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_LF_FRAME_ALLOCATOR_BENCHMARK_INL
+#define GASHA_INCLUDED_LF_FRAME_ALLOCATOR_BENCHMARK_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// lf_frame_allocator_benchmark.inl
+// ロックフリーフレームアロケータベンチマーク【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/lf_frame_allocator_benchmark.h>//ロックフリーフレームアロケータベンチマーク【宣言部】
+
+#include <gasha/lf_frame_allocator.cpp.h>//ロックフリーフレームアロケータ【関数定義部】
+#include <gasha/string.h>//文字列処理：spprintf()
+
+#include <new>//std::nothrow
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+namespace lfFrameAllocatorBenchmark
+{
+	//計測条件：コンストラクタ
+	inline condition::condition() :
+		m_frameCount(1000),
+		m_allocNum(1024)
+	{}
+
+	//ベンチマーク定義
+	//表のタイトル
+	inline void definition::writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "[ lfFrameAllocator benchmark (frames=%d, allocs/frame=%d) ]\n", static_cast<int>(cond.m_frameCount), static_cast<int>(cond.m_allocNum));
+	}
+	//表形式
+	inline void definition::writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "  size threads  frame(ns)  new/delete(ns)   speedup\n");
+	}
+	inline void definition::writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%6d %7d %10.2lf %15.2lf %9.2lf %s\n", static_cast<int>(result.m_allocSize), result.m_threadNum, result.m_frameAllocNs, result.m_newDeleteNs, result.m_frameAllocNs > 0. ? result.m_newDeleteNs / result.m_frameAllocNs : 0., result.m_isOk ? "[OK]" : "[NG]");
+	}
+	//CSV形式
+	inline void definition::writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "alloc_size,threads,frame_alloc_ns,new_delete_ns,speed_up,ok\n");
+	}
+	inline void definition::writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%d,%d,%.3lf,%.3lf,%.3lf,%d\n", static_cast<int>(result.m_allocSize), result.m_threadNum, result.m_frameAllocNs, result.m_newDeleteNs, result.m_frameAllocNs > 0. ? result.m_newDeleteNs / result.m_frameAllocNs : 0., result.m_isOk ? 1 : 0);
+	}
+	//全ての組み合わせを計測
+	template<class FUNCTOR>
+	inline bool definition::testAll(const condition_type& cond, FUNCTOR functor)
+	{
+		return lfFrameAllocatorBenchmarkTestAll(cond, functor);
+	}
+}//namespace lfFrameAllocatorBenchmark
+
+//----------------------------------------
+//フレームアロケータと new / delete の処理時間を計測
+template<std::size_t FRAME_NUM>
+lfFrameAllocatorBenchmark::result lfFrameAllocatorBenchmarkTest(const std::size_t frame_count, const std::size_t alloc_num, const std::size_t alloc_size, const int thread_num)
+{
+	lfFrameAllocatorBenchmark::result result = { false, 1, 0., 0., alloc_size };
+	const int alloc_num_i = static_cast<int>(alloc_num);
+	const std::size_t total_alloc = frame_count * alloc_num;
+	if (total_alloc == 0)
+		return result;
+
+	//フレームアロケータ
+	//※1フレーム分の確保が収まるサイズ（アラインメントの余裕込み）のフレーム領域を FRAME_NUM 個用意する
+	const std::size_t frame_size = (alloc_size + GASHA_ DEFAULT_ALIGN) * alloc_num;
+	char* buff = new(std::nothrow) char[frame_size * FRAME_NUM];
+	void** ptrs = new(std::nothrow) void*[alloc_num * FRAME_NUM];
+	if (!buff || !ptrs)
+	{
+		delete[] buff;
+		delete[] ptrs;
+		return result;
+	}
+	_private::benchmarkThreadScope thread_scope(thread_num);
+	result.m_threadNum = _private::benchmarkThreadNum();
+	bool is_ok = true;
+	{
+		GASHA_ lfFrameAllocator<FRAME_NUM> allocator(buff, frame_size * FRAME_NUM);
+		int failed = 0;
+		const double elapsed = GASHA_ benchmarkElapsedMin(1, frame_count, [&](const std::size_t)
+			{
+				int frame_failed = 0;
+			#pragma omp parallel for reduction(+:frame_failed)
+				for (int i = 0; i < alloc_num_i; ++i)
+				{
+					char* p = static_cast<char*>(allocator.alloc(alloc_size));
+					if (p)
+						*p = static_cast<char>(i);
+					else
+						++frame_failed;
+				}
+				failed += frame_failed;
+				allocator.nextFrame();
+			});
+		result.m_frameAllocNs = elapsed * 1000000000. / static_cast<double>(total_alloc);
+		//全てのフレームを破棄したら、アロケート中の数は 0 になる
+		for (std::size_t frame = 1; frame < FRAME_NUM; ++frame)
+			allocator.nextFrame();
+		if (failed > 0 || allocator.count() != 0)
+			is_ok = false;
+	}
+
+	//new / delete
+	//※FRAME_NUM フレーム前に確保したメモリを、フレームの切り替え時に解放する
+	{
+		for (std::size_t i = 0; i < alloc_num * FRAME_NUM; ++i)
+			ptrs[i] = nullptr;
+		int failed = 0;
+		const double elapsed = GASHA_ benchmarkElapsedMin(1, frame_count, [&](const std::size_t frame)
+			{
+				void** frame_ptrs = ptrs + (frame % FRAME_NUM) * alloc_num;
+				int frame_failed = 0;
+			#pragma omp parallel for reduction(+:frame_failed)
+				for (int i = 0; i < alloc_num_i; ++i)
+				{
+					delete[] static_cast<char*>(frame_ptrs[i]);//FRAME_NUM フレーム前のメモリを解放
+					char* p = new(std::nothrow) char[alloc_size];
+					if (p)
+						*p = static_cast<char>(i);
+					else
+						++frame_failed;
+					frame_ptrs[i] = p;
+				}
+				failed += frame_failed;
+			});
+		result.m_newDeleteNs = elapsed * 1000000000. / static_cast<double>(total_alloc);
+		for (std::size_t i = 0; i < alloc_num * FRAME_NUM; ++i)
+			delete[] static_cast<char*>(ptrs[i]);
+		if (failed > 0)
+			is_ok = false;
+	}
+	delete[] buff;
+	delete[] ptrs;
+	result.m_isOk = is_ok;
+	return result;
+}
+
+//----------------------------------------
+//確保サイズとスレッド数の全ての組み合わせを計測
+template<class FUNCTOR>
+bool lfFrameAllocatorBenchmarkTestAll(const lfFrameAllocatorBenchmark::condition& cond, FUNCTOR functor)
+{
+	bool is_ok = true;
+	const int thread_num_max = _private::benchmarkThreadNum();
+	for (int size_index = 0; size_index < lfFrameAllocatorBenchmark::ALLOC_SIZE_NUM; ++size_index)
+	{
+		for (int thread_num = 1; thread_num <= thread_num_max; thread_num *= 2)
+		{
+			const lfFrameAllocatorBenchmark::result result = lfFrameAllocatorBenchmarkTest<2>(cond.m_frameCount, cond.m_allocNum, lfFrameAllocatorBenchmark::ALLOC_SIZE_LIST[size_index], thread_num);
+			functor(result);
+			is_ok &= result.m_isOk;
+		}
+	}
+	return is_ok;
+}
+
+//----------------------------------------
+//確保サイズとスレッド数ごとの計測結果を表にする
+inline bool lfFrameAllocatorBenchmarkReport(char* message, const std::size_t max_size, std::size_t& message_len, const std::size_t frame_count, const std::size_t alloc_num)
+{
+	lfFrameAllocatorBenchmark::condition cond;
+	cond.m_frameCount = frame_count;
+	cond.m_allocNum = alloc_num;
+	std::size_t csv_message_len = 0;
+	return GASHA_ benchmarkReport<lfFrameAllocatorBenchmark::definition>(message, max_size, message_len, nullptr, 0, csv_message_len, cond);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_LF_FRAME_ALLOCATOR_BENCHMARK_INL
+
+// End of file
@@ -0,0 +1,276 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_LF_PER_THREAD_STACK_ALLOCATOR_CPP_H
+#define GASHA_INCLUDED_LF_PER_THREAD_STACK_ALLOCATOR_CPP_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// lf_per_thread_stack_allocator.cpp.h
+// ロックフリースレッド別スタックアロケータ【関数定義部】
+//
+// ※クラスのインスタンス化が必要な場所でインクルード。
+// ※基本的に、ヘッダーファイル内でのインクルード禁止。
+// 　（コンパイル・リンク時間への影響を気にしないならOK）
+// ※明示的なインスタンス化を避けたい場合は、ヘッダーファイルと共にインクルード。
+// 　（この場合、実際に使用するメンバー関数しかインスタンス化されないので、対象クラスに不要なインターフェースを実装しなくても良い）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/lf_per_thread_stack_allocator.inl>//ロックフリースレッド別スタックアロケータ【インライン関数／テンプレート関数定義部】
+
+#include <gasha/string.h>//文字列処理：spprintf()
+#include <gasha/simple_assert.h>//シンプルアサーション
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//ロックフリースレッド別スタックアロケータクラス
+
+//メモリ確保
+template<std::size_t _SLOT_NUM>
+void* lfPerThreadStackAllocator<_SLOT_NUM>::alloc(const std::size_t size, const std::size_t align)
+{
+	//サイズが0バイトならサイズを1に、アラインメントを0にする
+	//※要求サイズが0でも必ずメモリを割り当てる点に注意（ただし、アラインメントは守らない）
+	const std::size_t _size = size == 0 ? 1 : size;
+	const std::size_t _align = size == 0 ? 0 : align;
+	
+	//チャンクから確保
+	//※チャンクの半分を超えるサイズの場合は、チャンクを使用しない
+	slot_type* slot = _size + _align <= m_chunkSize / 2 ? thisSlot() : nullptr;
+	if (slot)
+	{
+		const size_type generation = stateGeneration(m_state.load());
+		if (slot->m_generation != generation || adjustAlign(m_buffRef + slot->m_chunkPos, _align) + _size > m_buffRef + slot->m_chunkEnd)
+		{
+			//チャンクを補充
+			//※世代が変わっていたら（clear() / rewind() されていたら）チャンクを破棄して補充する
+			size_type chunk_generation = 0;
+			const size_type chunk_pos = _allocFromRegion(m_chunkSize, 0, chunk_generation);
+			if (chunk_pos == m_maxSize)//領域の残りが足りない場合、チャンクを使用せずに確保する
+				slot = nullptr;
+			else
+			{
+				slot->m_generation = chunk_generation;
+				slot->m_chunkPos = chunk_pos;
+				slot->m_chunkEnd = chunk_pos + m_chunkSize;
+				slot->m_chunkCount.store(slot->m_chunkCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			}
+		}
+		if (slot)
+		{
+			//チャンク内でポインタを進める
+			//※専有スレッドのみが操作するので、アトミック操作は不要
+			char* new_ptr = adjustAlign(m_buffRef + slot->m_chunkPos, _align);
+			slot->m_chunkPos = static_cast<size_type>(new_ptr + _size - m_buffRef);
+			slot->m_allocCount.store(slot->m_allocCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			return reinterpret_cast<void*>(new_ptr);
+		}
+	}
+
+	//領域から直接確保
+	size_type generation = 0;
+	const size_type pos = _allocFromRegion(_size, _align, generation);
+#ifdef GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ENABLE_ASSERTION
+	GASHA_SIMPLE_ASSERT(pos != m_maxSize, "lfPerThreadStackAllocator is not enough memory.");
+#endif//GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ENABLE_ASSERTION
+	if (pos == m_maxSize)
+		return nullptr;
+	m_directAllocCount.fetch_add(1);//領域から直接確保した数
+	return reinterpret_cast<void*>(m_buffRef + pos);
+}
+
+//使用中のサイズを指定位置に戻す
+//※ポインタ指定版
+template<std::size_t _SLOT_NUM>
+bool lfPerThreadStackAllocator<_SLOT_NUM>::rewind(void* p)
+{
+	if (reinterpret_cast<char*>(p) < m_buffRef)
+		return false;
+	const size_type new_size = static_cast<size_type>(reinterpret_cast<char*>(p) - m_buffRef);
+	while (true)
+	{
+		state_type now_state = m_state.load();
+		if (stateSize(now_state) < new_size)
+			return false;
+		//世代を更新し、全スレッドのチャンクを無効化
+		if (m_state.compare_exchange_weak(now_state, makeState(stateGeneration(now_state) + 1, new_size)))//世代＋サイズのCAS
+			return true;
+	}
+	return false;//ダミー
+}
+
+//メモリクリア
+template<std::size_t _SLOT_NUM>
+void lfPerThreadStackAllocator<_SLOT_NUM>::clear()
+{
+	//アロケート中の数をリセット
+	//※スロットごとのアロケート数は専有スレッドしか更新できないため、現在の総計を基準値として記録する
+	m_clearedCount.store(totalAllocCount());
+	m_freeCount.store(0);
+	while (true)
+	{
+		state_type now_state = m_state.load();
+		//世代を更新し、全スレッドのチャンクを無効化
+		if (m_state.compare_exchange_weak(now_state, makeState(stateGeneration(now_state) + 1, 0)))//世代＋サイズのCAS
+			return;
+	}
+}
+
+//現在のスレッドのスロットを解放
+template<std::size_t _SLOT_NUM>
+bool lfPerThreadStackAllocator<_SLOT_NUM>::releaseThisThread()
+{
+	GASHA_ threadId thread_id;
+	const thread_id_type id = thread_id.id();
+	for (std::size_t index = 0; index < SLOT_NUM; ++index)
+	{
+		slot_type& slot = m_slots[index];
+		if (slot.m_threadId.load() == id)
+		{
+			slot.m_threadId.store(GASHA_ threadId::INITIAL_ID);
+			return true;
+		}
+	}
+	return false;
+}
+
+//デバッグ情報作成
+template<std::size_t _SLOT_NUM>
+std::size_t lfPerThreadStackAllocator<_SLOT_NUM>::debugInfo(char* message, const std::size_t max_size) const
+{
+	std::size_t message_len = 0;
+	const size_type now_generation = generation();
+	GASHA_ spprintf(message, max_size, message_len, "----- Debug-info for lfPerThreadStackAllocator -----\n");
+	GASHA_ spprintf(message, max_size, message_len, "buff=%p, maxSize=%d, size=%d, remain=%d, count=%d, chunkSize=%d, generation=%d, slots=%d/%d, directAllocCount=%d\n", m_buffRef, maxSize(), this->size(), remain(), count(), chunkSize(), now_generation, static_cast<int>(usingSlotNum()), static_cast<int>(SLOT_NUM), m_directAllocCount.load());
+	for (std::size_t index = 0; index < SLOT_NUM; ++index)
+	{
+		const slot_type& slot = m_slots[index];
+		const thread_id_type id = slot.m_threadId.load();
+		if (id == GASHA_ threadId::INITIAL_ID)
+			continue;
+		const bool is_valid_chunk = slot.m_generation == now_generation && slot.m_chunkEnd > 0;
+		//※チャンク未取得／無効化済みのスロットは、範囲を 0-0 と表示する
+		const size_type chunk_begin = is_valid_chunk ? slot.m_chunkEnd - m_chunkSize : 0;
+		const size_type chunk_end = is_valid_chunk ? slot.m_chunkEnd : 0;
+		GASHA_ spprintf(message, max_size, message_len, "[%d] thread=0x%08x, chunk=%d-%d, used=%d, allocCount=%d, chunkCount=%d%s\n", static_cast<int>(index), static_cast<unsigned int>(id), chunk_begin, chunk_end, is_valid_chunk ? slot.m_chunkPos - chunk_begin : 0, slot.m_allocCount.load(std::memory_order_relaxed), slot.m_chunkCount.load(std::memory_order_relaxed), is_valid_chunk ? "" : " (expired)");
+	}
+	GASHA_ spprintf(message, max_size, message_len, "----------------------------------------------------");//最終行改行なし
+	return message_len;
+}
+
+//現在のスレッドのスロットを取得
+template<std::size_t _SLOT_NUM>
+typename lfPerThreadStackAllocator<_SLOT_NUM>::slot_type* lfPerThreadStackAllocator<_SLOT_NUM>::thisSlot()
+{
+	GASHA_ threadId thread_id;
+	const thread_id_type id = thread_id.id();
+	const std::size_t begin = static_cast<std::size_t>(id % SLOT_NUM);
+	//専有済みのスロットを探す
+	for (std::size_t i = 0, index = begin; i < SLOT_NUM; ++i, index = (index + 1) % SLOT_NUM)
+	{
+		slot_type& slot = m_slots[index];
+		if (slot.m_threadId.load() == id)
+			return &slot;
+	}
+	//空きスロットを専有する
+	for (std::size_t i = 0, index = begin; i < SLOT_NUM; ++i, index = (index + 1) % SLOT_NUM)
+	{
+		slot_type& slot = m_slots[index];
+		thread_id_type owner = slot.m_threadId.load();
+		if (owner == id)
+			return &slot;
+		if (owner == GASHA_ threadId::INITIAL_ID && slot.m_threadId.compare_exchange_strong(owner, id))//スレッドIDのCAS
+			return &slot;
+	}
+	//スロット不足
+	return nullptr;
+}
+
+//領域から直接メモリ確保（共通処理）
+template<std::size_t _SLOT_NUM>
+typename lfPerThreadStackAllocator<_SLOT_NUM>::size_type lfPerThreadStackAllocator<_SLOT_NUM>::_allocFromRegion(const std::size_t size, const std::size_t align, typename lfPerThreadStackAllocator<_SLOT_NUM>::size_type& generation)
+{
+	while (true)
+	{
+		//サイズとアラインメントをチェック
+		state_type now_state = m_state.load();
+		const size_type now_size = stateSize(now_state);
+		char* now_ptr = m_buffRef + now_size;
+		char* new_ptr = adjustAlign(now_ptr, align);
+		const std::size_t new_size = static_cast<std::size_t>(new_ptr - m_buffRef) + size;
+		if (new_size > m_maxSize)
+			return m_maxSize;
+		
+		//使用中のサイズを更新
+		if (m_state.compare_exchange_weak(now_state, makeState(stateGeneration(now_state), static_cast<size_type>(new_size))))//世代＋サイズのCAS
+		{
+			generation = stateGeneration(now_state);
+			return static_cast<size_type>(new_ptr - m_buffRef);
+		}
+	}
+	return m_maxSize;//ダミー
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//----------------------------------------
+//明示的なインスタンス化
+
+//ロックフリースレッド別スタックアロケータの明示的なインスタンス化用マクロ
+#define GASHA_INSTANCING_lfPerThreadStackAllocator() \
+	template class GASHA_ lfPerThreadStackAllocator<>;
+//※スロット数指定版
+#define GASHA_INSTANCING_lfPerThreadStackAllocator_withSlot(_SLOT_NUM) \
+	template class GASHA_ lfPerThreadStackAllocator<_SLOT_NUM>;
+
+//--------------------------------------------------------------------------------
+//【注】明示的インスタンス化に失敗する場合
+// ※このコメントは、「明示的なインスタンス化マクロ」が定義されている全てのソースコードに
+// 　同じ内容のものをコピーしています。
+//--------------------------------------------------------------------------------
+//【原因①】
+// 　対象クラスに必要なインターフェースが実装されていない。
+//
+// 　例えば、ソート処理に必要な「bool operator<(const value_type&) const」か「friend bool operator<(const value_type&, const value_type&)」や、
+// 　探索処理に必要な「bool operator==(const key_type&) const」か「friend bool operator==(const value_type&, const key_type&)」。
+//
+// 　明示的なインスタンス化を行う場合、実際に使用しない関数のためのインターフェースも確実に実装する必要がある。
+// 　逆に言えば、明示的なインスタンス化を行わない場合、使用しない関数のためのインターフェースを実装する必要がない。
+//
+//【対策１】
+// 　インターフェースをきちんと実装する。
+// 　（無難だが、手間がかかる。）
+//
+//【対策２】
+// 　明示的なインスタンス化を行わずに、.cpp.h をテンプレート使用前にインクルードする。
+// 　（手間がかからないが、コンパイル時の依存ファイルが増えるので、コンパイルが遅くなる可能性がある。）
+//
+//--------------------------------------------------------------------------------
+//【原因②】
+// 　同じ型のインスタンスが複数作成されている。
+//
+// 　通常、テンプレートクラス／関数の同じ型のインスタンスが複数作られても、リンク時に一つにまとめられるため問題がない。
+// 　しかし、一つのソースファイルの中で複数のインスタンスが生成されると、コンパイラによってはエラーになる。
+//   GCCの場合のエラーメッセージ例：（VC++ではエラーにならない）
+// 　  source_file.cpp.h:114:17: エラー: duplicate explicit instantiation of ‘class templateClass<>’ [-fpermissive]
+//
+//【対策１】
+// 　別のファイルに分けてインスタンス化する。
+// 　（コンパイルへの影響が少なく、良い方法だが、無駄にファイル数が増える可能性がある。）
+//
+//【対策２】
+// 　明示的なインスタンス化を行わずに、.cpp.h をテンプレート使用前にインクルードする。
+// 　（手間がかからないが、コンパイル時の依存ファイルが増えるので、コンパイルが遅くなる可能性がある。）
+//
+//【対策３】
+// 　GCCのコンパイラオプションに、 -fpermissive を指定し、エラーを警告に格下げする。
+// 　（最も手間がかからないが、常時多数の警告が出る状態になりかねないので注意。）
+//--------------------------------------------------------------------------------
+
+#endif//GASHA_INCLUDED_LF_PER_THREAD_STACK_ALLOCATOR_CPP_H
+
+// End of file
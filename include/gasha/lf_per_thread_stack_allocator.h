@@ -0,0 +1,211 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_LF_PER_THREAD_STACK_ALLOCATOR_H
+#define GASHA_INCLUDED_LF_PER_THREAD_STACK_ALLOCATOR_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// lf_per_thread_stack_allocator.h
+// ロックフリースレッド別スタックアロケータ【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/allocator_common.h>//メモリアロケータ共通設定
+#include <gasha/memory.h>//メモリ操作：adjustStaticAlign, adjustAlign()
+#include <gasha/allocator_adapter.h>//アロケータアダプタ
+#include <gasha/thread_id.h>//スレッドID
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint32_t, std::uint64_t
+#include <atomic>//C++11 std::atomic
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//ロックフリースレッド別スタックアロケータクラス
+//※スタック用のバッファをコンストラクタで受け渡して使用
+//※バッファ（領域）から、スレッドごとに一定サイズのチャンクを切り出し、各スレッドはチャンク内でメモリを確保する。
+//※チャンク内のメモリ確保はスレッド専有のため、アトミック操作を伴わない単純なポインタ加算で行う。
+//　アトミック操作（CAS）を行うのは、チャンクの補充時のみ。
+//※スレッドは、最初のメモリ確保時にスロットを一つ専有する。スロットが不足したスレッドは、
+//　ロックフリースタックアロケータと同様に、領域から直接（CASで）メモリを確保する。
+//※チャンクの半分を超えるサイズのメモリ確保も、領域から直接確保する。
+//※アロケート中の数は、スロットごとに集計し、参照時に合算する。
+//※rewind() / clear() は領域単位で行い、全スレッドのチャンクを無効化する。
+//　（各スレッドは、次回のメモリ確保時にチャンクを補充する）
+//※【注意】rewind() は領域単位で戻すため、スタックアロケータのような LIFO の意味を持たない。（rewind() の説明を参照）
+//※free()を呼んでも、明示的に clear() または rewind() しない限り、バッファが解放されないので注意。
+template<std::size_t _SLOT_NUM = 16>
+class lfPerThreadStackAllocator
+{
+public:
+	//型
+	typedef std::uint32_t size_type;//サイズ型
+	typedef std::uint64_t state_type;//世代＋使用中サイズ混成型
+	typedef GASHA_ threadId::id_type thread_id_type;//スレッドID型
+
+public:
+	//定数
+	static const std::size_t SLOT_NUM = _SLOT_NUM;//スレッドスロット数
+	static const size_type DEFAULT_CHUNK_SIZE = 4096;//デフォルトのチャンクサイズ
+
+public:
+	//スレッドスロット型
+	//※キャッシュラインを共有しないように、アラインメントを調整
+	struct alignas(64) slot_type
+	{
+		std::atomic<thread_id_type> m_threadId;//専有スレッドID
+		size_type m_generation;//チャンク取得時の世代 ※専有スレッドのみ更新
+		size_type m_chunkPos;//チャンクの使用位置（バッファ先頭からのオフセット） ※専有スレッドのみ更新
+		size_type m_chunkEnd;//チャンクの終端（バッファ先頭からのオフセット） ※専有スレッドのみ更新
+		std::atomic<size_type> m_allocCount;//アロケート数 ※専有スレッドのみ更新（読み書きのみで、アトミック操作は行わない）
+		std::atomic<size_type> m_chunkCount;//チャンク補充数 ※専有スレッドのみ更新（読み書きのみで、アトミック操作は行わない）
+	};
+
+public:
+	//アクセッサ
+	const char* name() const { return "lfPerThreadStackAllocator"; }
+	const char* mode() const { return "PerThread"; }
+	inline const void* buff() const { return reinterpret_cast<const void*>(m_buffRef); }//バッファの先頭アドレス
+	inline size_type maxSize() const { return m_maxSize; }//バッファの全体サイズ（バイト数）
+	inline size_type size() const { return stateSize(m_state.load()); }//使用中のサイズ（バイト数） ※各スレッドのチャンクの未使用部分を含む
+	inline size_type remain() const { return m_maxSize - size(); }//残りサイズ（バイト数）
+	inline size_type count() const;//アロケート中の数
+	inline size_type chunkSize() const { return m_chunkSize; }//チャンクサイズ（バイト数）
+	inline size_type generation() const { return stateGeneration(m_state.load()); }//世代（clear() / rewind() のたびに更新）
+	inline std::size_t usingSlotNum() const;//使用中のスレッドスロット数
+
+public:
+	//アロケータアダプタ取得
+	inline GASHA_ allocatorAdapter<lfPerThreadStackAllocator<_SLOT_NUM>> adapter(){ GASHA_ allocatorAdapter<lfPerThreadStackAllocator<_SLOT_NUM>> adapter(*this, name(), mode()); return adapter; }
+
+public:
+	//メソッド
+
+	//メモリ確保
+	void* alloc(const std::size_t size, const std::size_t align = GASHA_ DEFAULT_ALIGN);
+
+	//メモリ解放
+	//※実際にはメモリを解放しない（できない）ので注意。
+	//※アロケート中の数を減らすだけ。
+	inline bool free(void* p);
+
+	//メモリ確保とコンストラクタ呼び出し
+	template<typename T, typename...Tx>
+	T* newObj(Tx&&... args);
+	//※配列用
+	template<typename T, typename...Tx>
+	T* newArray(const std::size_t num, Tx&&... args);
+
+	//メモリ解放とデストラクタ呼び出し
+	template<typename T>
+	bool deleteObj(T* p);
+	//※配列用（要素数の指定が必要な点に注意）
+	template<typename T>
+	bool deleteArray(T* p, const std::size_t num);
+
+	//使用中のサイズを指定位置に戻す
+	//※【注意】メモリ確保状態（アロケート中の数）と無関係に実行するので注意
+	//※全スレッドのチャンクを無効化する
+	//※【注意】領域単位で戻すため、LIFO（後に確保したものから解放）にはならない。
+	//　指定位置より前に切り出された他のスレッドのチャンクには、指定位置のメモリより後に確保されたメモリが
+	//　含まれていることがあるが、それらは解放されずに残る（チャンクの無効化により、以後は使われない）。
+	//　逆に、指定位置より後ろは、どのスレッドがいつ確保したものでも破棄されるので、
+	//　全スレッドの確保が止まっている時点の位置（size() の値など）に戻す場合にのみ使用すること。
+	//※位置指定版
+	inline bool rewind(const size_type pos);
+	//※ポインタ指定版
+	bool rewind(void* p);
+
+	//メモリクリア
+	//※初期状態にする（スレッドスロットの専有状態は維持する）
+	//※全スレッドのチャンクを無効化する
+	//※【注意】メモリ確保状態（アロケート中の数）と無関係に実行するので注意
+	void clear();
+
+	//現在のスレッドのスロットを解放
+	//※スレッド終了前に呼び出すと、スロットを他のスレッドが利用できるようになる。
+	//※チャンクの未使用部分は、次にスロットを専有したスレッドが引き継ぐ。
+	bool releaseThisThread();
+
+	//デバッグ情報作成
+	//※十分なサイズのバッファを渡す必要あり。
+	//※使用したバッファのサイズを返す。
+	//※作成中、他のスレッドで操作が発生すると、不整合が生じる可能性がある点に注意
+	std::size_t debugInfo(char* message, const std::size_t max_size) const;
+
+private:
+	//世代＋使用中サイズ混成値の作成／分解
+	inline static state_type makeState(const size_type generation, const size_type size);
+	inline static size_type stateGeneration(const state_type state);
+	inline static size_type stateSize(const state_type state);
+
+	//現在のスレッドのスロットを取得
+	//※未専有ならスロットを専有する。スロットが不足していたら nullptr を返す。
+	slot_type* thisSlot();
+
+	//領域から直接メモリ確保（共通処理）
+	//※確保した位置（オフセット）を返す。確保できなかった場合は m_maxSize を返す。
+	//※確保時の世代を受け取る
+	size_type _allocFromRegion(const std::size_t size, const std::size_t align, size_type& generation);
+
+	//アロケート数の総計（解放数を差し引かない）
+	inline size_type totalAllocCount() const;
+
+	//ポインタが範囲内か判定
+	inline bool isInUsingRange(void* p);
+
+public:
+	//コンストラクタ
+	inline lfPerThreadStackAllocator(void* buff, const std::size_t max_size, const std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+	template<typename T>
+	inline lfPerThreadStackAllocator(T* buff, const std::size_t num, const std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+	template<typename T, std::size_t N>
+	inline lfPerThreadStackAllocator(T (&buff)[N], const std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+	//デストラクタ
+	inline ~lfPerThreadStackAllocator();
+
+private:
+	//フィールド
+	char* m_buffRef;//バッファの参照
+	const size_type m_maxSize;//バッファの全体サイズ
+	const size_type m_chunkSize;//チャンクサイズ
+	std::atomic<state_type> m_state;//世代＋バッファの使用中サイズ
+	std::atomic<size_type> m_directAllocCount;//領域から直接確保した数
+	std::atomic<size_type> m_freeCount;//解放数
+	std::atomic<size_type> m_clearedCount;//クリア時点のアロケート数（集計の基準値）
+	slot_type m_slots[SLOT_NUM];//スレッドスロット
+};
+
+//--------------------------------------------------------------------------------
+//バッファ付きロックフリースレッド別スタックアロケータクラス
+template<std::size_t _MAX_SIZE, std::size_t _SLOT_NUM = 16>
+class lfPerThreadStackAllocator_withBuff : public lfPerThreadStackAllocator<_SLOT_NUM>
+{
+	//定数
+	static const std::size_t MAX_SIZE = _MAX_SIZE;//バッファの全体サイズ
+public:
+	//コンストラクタ
+	inline lfPerThreadStackAllocator_withBuff(const std::size_t chunk_size = lfPerThreadStackAllocator<_SLOT_NUM>::DEFAULT_CHUNK_SIZE);
+	//デストラクタ
+	inline ~lfPerThreadStackAllocator_withBuff();
+private:
+	char m_buff[MAX_SIZE];//バッファ
+};
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/lf_per_thread_stack_allocator.inl>
+
+//.hファイルのインクルードに伴い、常に.cpp.hファイル（および.inlファイル）を自動インクルードする場合
+#ifdef GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ALLWAYS_TOGETHER_CPP_H
+#include <gasha/lf_per_thread_stack_allocator.cpp.h>
+#endif//GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ALLWAYS_TOGETHER_CPP_H
+
+#endif//GASHA_INCLUDED_LF_PER_THREAD_STACK_ALLOCATOR_H
+
+// End of file
@@ -0,0 +1,238 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_LF_PER_THREAD_STACK_ALLOCATOR_INL
+#define GASHA_INCLUDED_LF_PER_THREAD_STACK_ALLOCATOR_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// lf_per_thread_stack_allocator.inl
+// ロックフリースレッド別スタックアロケータ【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/lf_per_thread_stack_allocator.h>//ロックフリースレッド別スタックアロケータ【宣言部】
+
+#include <gasha/allocator_common.h>//アロケータ共通設定・処理：コンストラクタ／デストラクタ呼び出し
+#include <gasha/simple_assert.h>//シンプルアサーション
+
+#include <utility>//C++11 std::forward
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//ロックフリースレッド別スタックアロケータクラス
+
+//アロケート中の数
+template<std::size_t _SLOT_NUM>
+inline typename lfPerThreadStackAllocator<_SLOT_NUM>::size_type lfPerThreadStackAllocator<_SLOT_NUM>::count() const
+{
+	return totalAllocCount() - m_clearedCount.load() - m_freeCount.load();
+}
+
+//使用中のスレッドスロット数
+template<std::size_t _SLOT_NUM>
+inline std::size_t lfPerThreadStackAllocator<_SLOT_NUM>::usingSlotNum() const
+{
+	std::size_t num = 0;
+	for (std::size_t index = 0; index < SLOT_NUM; ++index)
+	{
+		if (m_slots[index].m_threadId.load() != GASHA_ threadId::INITIAL_ID)
+			++num;
+	}
+	return num;
+}
+
+//メモリ解放
+template<std::size_t _SLOT_NUM>
+inline bool lfPerThreadStackAllocator<_SLOT_NUM>::free(void* p)
+{
+	if (!p)//nullptrの解放は常に成功扱い
+		return true;
+	if (!isInUsingRange(p))//正しいポインタか判定
+		return false;
+	m_freeCount.fetch_add(1);//解放数
+	return true;
+}
+
+//メモリ確保とコンストラクタ呼び出し
+template<std::size_t _SLOT_NUM>
+template<typename T, typename...Tx>
+T* lfPerThreadStackAllocator<_SLOT_NUM>::newObj(Tx&&... args)
+{
+	void* p = alloc(sizeof(T), alignof(T));
+	if (!p)
+		return nullptr;
+	return GASHA_ callConstructor<T>(p, std::forward<Tx>(args)...);
+}
+//※配列用
+template<std::size_t _SLOT_NUM>
+template<typename T, typename...Tx>
+T* lfPerThreadStackAllocator<_SLOT_NUM>::newArray(const std::size_t num, Tx&&... args)
+{
+	void* p = alloc(sizeof(T) * num, alignof(T));
+	if (!p)
+		return nullptr;
+	T* top_obj = nullptr;
+	for (std::size_t i = 0; i < num; ++i)
+	{
+		T* obj = GASHA_ callConstructor<T>(p, std::forward<Tx>(args)...);
+		if (!top_obj)
+			top_obj = obj;
+		p = reinterpret_cast<void*>(reinterpret_cast<char*>(p) + sizeof(T));
+	}
+	return top_obj;
+}
+
+//メモリ解放とデストラクタ呼び出し
+template<std::size_t _SLOT_NUM>
+template<typename T>
+bool lfPerThreadStackAllocator<_SLOT_NUM>::deleteObj(T* p)
+{
+	if (!p)//nullptrの解放は常に成功扱い
+		return true;
+	if (!isInUsingRange(p))//正しいポインタか判定
+		return false;
+	GASHA_ callDestructor(p);//デストラクタ呼び出し
+	m_freeCount.fetch_add(1);//解放数
+	return true;
+}
+//※配列用
+template<std::size_t _SLOT_NUM>
+template<typename T>
+bool lfPerThreadStackAllocator<_SLOT_NUM>::deleteArray(T* p, const std::size_t num)
+{
+	if (!p)//nullptrの解放は常に成功扱い
+		return true;
+	if (!isInUsingRange(p))//正しいポインタか判定
+		return false;
+	T* obj = p;
+	for (std::size_t i = 0; i < num; ++i, ++obj)
+	{
+		GASHA_ callDestructor(obj);//デストラクタ呼び出し
+	}
+	m_freeCount.fetch_add(1);//解放数
+	return true;
+}
+
+//使用中のサイズを指定位置に戻す
+//※位置指定版
+template<std::size_t _SLOT_NUM>
+inline bool lfPerThreadStackAllocator<_SLOT_NUM>::rewind(const size_type pos)
+{
+	return rewind(m_buffRef + pos);
+}
+
+//世代＋使用中サイズ混成値の作成
+template<std::size_t _SLOT_NUM>
+inline typename lfPerThreadStackAllocator<_SLOT_NUM>::state_type lfPerThreadStackAllocator<_SLOT_NUM>::makeState(const typename lfPerThreadStackAllocator<_SLOT_NUM>::size_type generation, const typename lfPerThreadStackAllocator<_SLOT_NUM>::size_type size)
+{
+	return (static_cast<state_type>(generation) << 32) | static_cast<state_type>(size);
+}
+
+//世代＋使用中サイズ混成値から世代を取得
+template<std::size_t _SLOT_NUM>
+inline typename lfPerThreadStackAllocator<_SLOT_NUM>::size_type lfPerThreadStackAllocator<_SLOT_NUM>::stateGeneration(const typename lfPerThreadStackAllocator<_SLOT_NUM>::state_type state)
+{
+	return static_cast<size_type>(state >> 32);
+}
+
+//世代＋使用中サイズ混成値から使用中サイズを取得
+template<std::size_t _SLOT_NUM>
+inline typename lfPerThreadStackAllocator<_SLOT_NUM>::size_type lfPerThreadStackAllocator<_SLOT_NUM>::stateSize(const typename lfPerThreadStackAllocator<_SLOT_NUM>::state_type state)
+{
+	return static_cast<size_type>(state & 0xffffffffull);
+}
+
+//アロケート数の総計
+template<std::size_t _SLOT_NUM>
+inline typename lfPerThreadStackAllocator<_SLOT_NUM>::size_type lfPerThreadStackAllocator<_SLOT_NUM>::totalAllocCount() const
+{
+	size_type total = m_directAllocCount.load();
+	for (std::size_t index = 0; index < SLOT_NUM; ++index)
+		total += m_slots[index].m_allocCount.load(std::memory_order_relaxed);
+	return total;
+}
+
+//ポインタが範囲内か判定
+template<std::size_t _SLOT_NUM>
+inline bool lfPerThreadStackAllocator<_SLOT_NUM>::isInUsingRange(void* p)
+{
+	const size_type now_size = size();
+#ifdef GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ENABLE_ASSERTION
+	GASHA_SIMPLE_ASSERT(p >= m_buffRef && p < m_buffRef + now_size, "Pointer is not in range.");
+#endif//GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ENABLE_ASSERTION
+	if (p >= m_buffRef && p < m_buffRef + now_size)//範囲内
+		return true;
+	//範囲外のポインタ
+	return false;
+}
+
+//コンストラクタ
+template<std::size_t _SLOT_NUM>
+inline lfPerThreadStackAllocator<_SLOT_NUM>::lfPerThreadStackAllocator(void* buff, const std::size_t max_size, const std::size_t chunk_size) :
+	m_buffRef(reinterpret_cast<char*>(buff)),
+	m_maxSize(static_cast<size_type>(max_size)),
+	m_chunkSize(static_cast<size_type>(chunk_size)),
+	m_state(makeState(0, 0)),
+	m_directAllocCount(0),
+	m_freeCount(0),
+	m_clearedCount(0)
+{
+#ifdef GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ENABLE_ASSERTION
+	GASHA_SIMPLE_ASSERT(m_buffRef != nullptr, "buff is nullptr.");
+	GASHA_SIMPLE_ASSERT(m_maxSize > 0, "max_size is zero.");
+	GASHA_SIMPLE_ASSERT(m_chunkSize > 0, "chunk_size is zero.");
+#endif//GASHA_LF_PER_THREAD_STACK_ALLOCATOR_ENABLE_ASSERTION
+	//スレッドスロットを初期化
+	//※チャンクは空の状態にしておき、最初のメモリ確保時に補充する
+	for (std::size_t index = 0; index < SLOT_NUM; ++index)
+	{
+		slot_type& slot = m_slots[index];
+		slot.m_threadId.store(GASHA_ threadId::INITIAL_ID);
+		slot.m_generation = 0;
+		slot.m_chunkPos = 0;
+		slot.m_chunkEnd = 0;
+		slot.m_allocCount.store(0);
+		slot.m_chunkCount.store(0);
+	}
+}
+template<std::size_t _SLOT_NUM>
+template<typename T>
+inline lfPerThreadStackAllocator<_SLOT_NUM>::lfPerThreadStackAllocator(T* buff, const std::size_t num, const std::size_t chunk_size) :
+	lfPerThreadStackAllocator(reinterpret_cast<void*>(buff), sizeof(T) * num, chunk_size)//C++11 委譲コンストラクタ
+{}
+template<std::size_t _SLOT_NUM>
+template<typename T, std::size_t N>
+inline lfPerThreadStackAllocator<_SLOT_NUM>::lfPerThreadStackAllocator(T(&buff)[N], const std::size_t chunk_size) :
+	lfPerThreadStackAllocator(reinterpret_cast<void*>(buff), sizeof(buff), chunk_size)//C++11 委譲コンストラクタ
+{}
+
+//デストラクタ
+template<std::size_t _SLOT_NUM>
+inline lfPerThreadStackAllocator<_SLOT_NUM>::~lfPerThreadStackAllocator()
+{}
+
+//--------------------------------------------------------------------------------
+//バッファ付きロックフリースレッド別スタックアロケータクラス
+
+//コンストラクタ
+template<std::size_t _MAX_SIZE, std::size_t _SLOT_NUM>
+inline lfPerThreadStackAllocator_withBuff<_MAX_SIZE, _SLOT_NUM>::lfPerThreadStackAllocator_withBuff(const std::size_t chunk_size) :
+	lfPerThreadStackAllocator<_SLOT_NUM>(m_buff, MAX_SIZE, chunk_size)
+{}
+
+//デストラクタ
+template<std::size_t _MAX_SIZE, std::size_t _SLOT_NUM>
+inline lfPerThreadStackAllocator_withBuff<_MAX_SIZE, _SLOT_NUM>::~lfPerThreadStackAllocator_withBuff()
+{}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_LF_PER_THREAD_STACK_ALLOCATOR_INL
+
+// End of file
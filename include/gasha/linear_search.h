@@ -15,6 +15,8 @@
 
 #include <gasha/search_basic.h>//探索処理基本
 
+#include <cstddef>//std::size_t
+
 GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 
 //========================================
@@ -35,11 +37,67 @@ GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 //・最悪計算時間：O(n)
 //・探索失敗時：  O(n)
 //----------------------------------------
+//※探索値指定版（linearSearchValue()）は、要素型が std::int32_t, std::uint32_t（crc32_t）, float で、
+//　プレディケート関数が equal_to<T>（GASHA）または std::equal_to<T> の場合（プレディケート関数を省略した場合を含む）、
+//　SIMD版を使用する。SIMD版は、SSE/AVX命令で一度に 16 件の要素を探索値と比較する。
+//　（探索値の型は、要素型と同じ型か、32ビット以下の整数型に限る。それ以外の場合は通常版を使用する）
+//※float のSIMD版は、通常の == 演算子と同じく、0.f と -0.f を一致とみなし、NaN はどの値とも一致しない。
+//----------------------------------------
 //プロトタイプ：
 //・bool PREDICATE(const T& value)//value == 探索値ならtrueを返す
+//・bool PREDICATE(const T& value1, const V& value2)//value1 == value2 ならtrueを返す ※探索値指定版
 template<class T, class PREDICATE>
 T* linearSearch(T* array, const std::size_t size, PREDICATE predicate);
-GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_PREDICATE(linearSearch);
+template<class T, typename V, class PREDICATE>
+T* linearSearchValue(T* array, const std::size_t size, const V& value, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_VALUE_SEARCH(linearSearch);
+
+//----------------------------------------
+//アルゴリズム：線形探索による計数
+//----------------------------------------
+//・最良計算時間：O(n)
+//・平均計算時間：O(n)
+//・最悪計算時間：O(n)
+//----------------------------------------
+//※条件に一致する要素の数を返す。
+//※探索値指定版（linearCountValue()）は、linearSearchValue() と同じ条件でSIMD版を使用する。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value)//value == 探索値ならtrueを返す
+//・bool PREDICATE(const T& value1, const V& value2)//value1 == value2 ならtrueを返す ※探索値指定版
+template<class T, class PREDICATE>
+std::size_t linearCount(const T* array, const std::size_t size, PREDICATE predicate);
+template<class T, typename V, class PREDICATE>
+std::size_t linearCountValue(const T* array, const std::size_t size, const V& value, PREDICATE predicate);
+template<class T, typename V>
+inline std::size_t linearCountValue(const T* array, const std::size_t size, const V& value);
+
+//----------------------------------------
+//アルゴリズム：線形探索による全件探索
+//----------------------------------------
+//・最良計算時間：O(n)
+//・平均計算時間：O(n)
+//・最悪計算時間：O(n)
+//----------------------------------------
+//※条件に一致する要素のインデックスを、先頭から順に found_indices に格納し、格納した件数を返す。
+//　found_max 件格納した時点で探索を終了する。
+//※探索値指定版（linearSearchAllValue()）は、linearSearchValue() と同じ条件でSIMD版を使用する。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value)//value == 探索値ならtrueを返す
+//・bool PREDICATE(const T& value1, const V& value2)//value1 == value2 ならtrueを返す ※探索値指定版
+template<class T, class PREDICATE>
+std::size_t linearSearchAll(const T* array, const std::size_t size, std::size_t* found_indices, const std::size_t found_max, PREDICATE predicate);
+template<class T, typename V, class PREDICATE>
+std::size_t linearSearchAllValue(const T* array, const std::size_t size, std::size_t* found_indices, const std::size_t found_max, const V& value, PREDICATE predicate);
+template<class T, typename V>
+inline std::size_t linearSearchAllValue(const T* array, const std::size_t size, std::size_t* found_indices, const std::size_t found_max, const V& value);
+
+//----------------------------------------
+//SIMD線形探索が使用可能な型とプレディケート関数の組み合わせか？
+//※SSE/SSE2が無効な場合は常に false
+template<class T, class PREDICATE>
+struct isSimdLinearSearchable;
 
 //----------------------------------------
 //アルゴリズム：線形探索
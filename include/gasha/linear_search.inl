@@ -17,6 +17,22 @@
 
 #include <gasha/linear_search.h>//線形探索【宣言部】
 
+#include <cstdint>//C++11 std::int32_t, std::uint32_t
+#include <functional>//std::equal_to
+#include <type_traits>//C++11 std::integral_constant, std::is_same
+
+#ifdef GASHA_USE_SSE
+#include <xmmintrin.h>//SSE1
+#endif//GASHA_USE_SSE
+
+#ifdef GASHA_USE_SSE2
+#include <emmintrin.h>//SSE2
+#endif//GASHA_USE_SSE2
+
+#ifdef GASHA_USE_AVX
+#include <immintrin.h>//AVX, AVX2
+#endif//GASHA_USE_AVX
+
 GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 
 //----------------------------------------
@@ -35,6 +51,299 @@ T* linearSearch(T* array, const std::size_t size, PREDICATE predicate)
 	return nullptr;//探索失敗
 }
 
+//----------------------------------------
+//SIMD線形探索が使用可能な型とプレディケート関数の組み合わせか？
+namespace _private
+{
+	//SIMD対応の要素型か？
+	template<class T>
+	struct isSimdLinearSearchType : std::integral_constant<bool,
+	#ifdef GASHA_USE_SSE2
+		std::is_same<T, std::int32_t>::value ||
+		std::is_same<T, std::uint32_t>::value ||
+	#endif//GASHA_USE_SSE2
+	#ifdef GASHA_USE_SSE
+		std::is_same<T, float>::value ||
+	#endif//GASHA_USE_SSE
+		false
+	>{};
+	//一致判定のプレディケート関数か？
+	template<class T, class PREDICATE>
+	struct isSimdLinearSearchPredicate : std::integral_constant<bool,
+		std::is_same<PREDICATE, GASHA_ equal_to<T>>::value ||
+		std::is_same<PREDICATE, std::equal_to<T>>::value
+	>{};
+	//SIMD版で比較できる探索値の型か？
+	//※要素型に変換しても、== 演算子による比較結果が変わらない型に限る
+	template<class T, typename V>
+	struct isSimdLinearSearchValue : std::integral_constant<bool,
+		std::is_same<typename std::remove_cv<V>::type, T>::value ||
+		(std::is_integral<V>::value && sizeof(V) <= sizeof(std::int32_t))
+	>{};
+	//SIMD版で扱う要素型
+	//※std::uint32_t は、ビット列が一致するかどうかだけを判定するので std::int32_t として扱う
+	template<class T>
+	struct simdLinearSearchKernelType{ typedef T type; };
+	template<>
+	struct simdLinearSearchKernelType<std::uint32_t>{ typedef std::int32_t type; };
+}//namespace _private
+template<class T, class PREDICATE>
+struct isSimdLinearSearchable : std::integral_constant<bool,
+	_private::isSimdLinearSearchType<T>::value &&
+	_private::isSimdLinearSearchPredicate<T, PREDICATE>::value
+>{};
+
+//----------------------------------------
+//SIMD線形探索
+namespace _private
+{
+	//SIMD演算
+	//※16件の要素を探索値と比較し、一致した要素のビットを立てたマスクを返す
+	template<class T>
+	struct simdLinearSearchOpe;
+#ifdef GASHA_USE_SSE2
+	//※std::int32_t用
+	template<>
+	struct simdLinearSearchOpe<std::int32_t>
+	{
+	#ifdef GASHA_USE_AVX2
+		typedef __m256i vec_type;
+		inline static vec_type broadcast(const std::int32_t value){ return _mm256_set1_epi32(value); }
+		inline static unsigned int equalMask(const std::int32_t* p, const vec_type value_v)
+		{
+			const __m256i eq0 = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), value_v);
+			const __m256i eq1 = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 8)), value_v);
+			return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(eq0))) |
+			       static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(eq1))) << 8;
+		}
+	#else//GASHA_USE_AVX2
+		typedef __m128i vec_type;
+		inline static vec_type broadcast(const std::int32_t value){ return _mm_set1_epi32(value); }
+		inline static unsigned int equalMask(const std::int32_t* p, const vec_type value_v)
+		{
+			const __m128i eq0 = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), value_v);
+			const __m128i eq1 = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 4)), value_v);
+			const __m128i eq2 = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8)), value_v);
+			const __m128i eq3 = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12)), value_v);
+			//32ビット×16件の比較結果を、16ビット×8件に２回詰めてバイト単位のマスクにする
+			return static_cast<unsigned int>(_mm_movemask_epi8(_mm_packs_epi16(_mm_packs_epi32(eq0, eq1), _mm_packs_epi32(eq2, eq3))));
+		}
+	#endif//GASHA_USE_AVX2
+	};
+#endif//GASHA_USE_SSE2
+#ifdef GASHA_USE_SSE
+	//※float用
+	template<>
+	struct simdLinearSearchOpe<float>
+	{
+	#ifdef GASHA_USE_AVX
+		typedef __m256 vec_type;
+		inline static vec_type broadcast(const float value){ return _mm256_set1_ps(value); }
+		inline static unsigned int equalMask(const float* p, const vec_type value_v)
+		{
+			return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), value_v, _CMP_EQ_OQ))) |
+			       static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + 8), value_v, _CMP_EQ_OQ))) << 8;
+		}
+	#else//GASHA_USE_AVX
+		typedef __m128 vec_type;
+		inline static vec_type broadcast(const float value){ return _mm_set1_ps(value); }
+		inline static unsigned int equalMask(const float* p, const vec_type value_v)
+		{
+			return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p), value_v))) |
+			       static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + 4), value_v))) << 4 |
+			       static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + 8), value_v))) << 8 |
+			       static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + 12), value_v))) << 12;
+		}
+	#endif//GASHA_USE_AVX
+	};
+#endif//GASHA_USE_SSE
+
+	//１回のSIMD演算で比較する件数
+	static const std::size_t SIMD_LINEAR_SEARCH_BLOCK = 16;
+
+	//SIMD線形探索
+	//※一致した最初の要素のインデックスを返す。見つからなければ size を返す
+	template<class T>
+	std::size_t simdLinearSearch(const T* array, const std::size_t size, const T value)
+	{
+		typedef simdLinearSearchOpe<T> ope;
+		const typename ope::vec_type value_v = ope::broadcast(value);
+		std::size_t index = 0;
+		for (; index + SIMD_LINEAR_SEARCH_BLOCK <= size; index += SIMD_LINEAR_SEARCH_BLOCK)
+		{
+			const unsigned int mask = ope::equalMask(array + index, value_v);
+			if (mask != 0)
+				return index + searchCountTrailingOnes(~static_cast<unsigned long long>(mask));//最初に立っているビットの位置
+		}
+		for (; index < size; ++index)//端数
+		{
+			if (array[index] == value)
+				return index;
+		}
+		return size;
+	}
+	//SIMD線形探索による計数
+	template<class T>
+	std::size_t simdLinearCount(const T* array, const std::size_t size, const T value)
+	{
+		typedef simdLinearSearchOpe<T> ope;
+		const typename ope::vec_type value_v = ope::broadcast(value);
+		std::size_t count = 0;
+		std::size_t index = 0;
+		for (; index + SIMD_LINEAR_SEARCH_BLOCK <= size; index += SIMD_LINEAR_SEARCH_BLOCK)
+			count += searchCountBits(ope::equalMask(array + index, value_v));
+		for (; index < size; ++index)//端数
+			count += (array[index] == value ? 1 : 0);
+		return count;
+	}
+	//SIMD線形探索による全件探索
+	template<class T>
+	std::size_t simdLinearSearchAll(const T* array, const std::size_t size, std::size_t* found_indices, const std::size_t found_max, const T value)
+	{
+		typedef simdLinearSearchOpe<T> ope;
+		const typename ope::vec_type value_v = ope::broadcast(value);
+		std::size_t found_num = 0;
+		std::size_t index = 0;
+		for (; index + SIMD_LINEAR_SEARCH_BLOCK <= size; index += SIMD_LINEAR_SEARCH_BLOCK)
+		{
+			for (unsigned int mask = ope::equalMask(array + index, value_v); mask != 0; mask &= mask - 1)//立っているビットを下位から順に処理
+			{
+				found_indices[found_num++] = index + searchCountTrailingOnes(~static_cast<unsigned long long>(mask));
+				if (found_num == found_max)
+					return found_num;
+			}
+		}
+		for (; index < size; ++index)//端数
+		{
+			if (array[index] == value)
+			{
+				found_indices[found_num++] = index;
+				if (found_num == found_max)
+					return found_num;
+			}
+		}
+		return found_num;
+	}
+
+	//探索値指定版の処理振り分け
+	template<class T, typename V, class PREDICATE, bool IS_SIMD = isSimdLinearSearchable<T, PREDICATE>::value && isSimdLinearSearchValue<T, V>::value>
+	struct linearSearchValue
+	{
+		//通常版
+		inline static T* search(T* array, const std::size_t size, const V& value, PREDICATE predicate)
+		{
+			auto _equal = [&value, &predicate](const T& val1) -> bool { return predicate(val1, value); };
+			return GASHA_ linearSearch(array, size, _equal);
+		}
+		inline static std::size_t count(const T* array, const std::size_t size, const V& value, PREDICATE predicate)
+		{
+			auto _equal = [&value, &predicate](const T& val1) -> bool { return predicate(val1, value); };
+			return GASHA_ linearCount(array, size, _equal);
+		}
+		inline static std::size_t searchAll(const T* array, const std::size_t size, std::size_t* found_indices, const std::size_t found_max, const V& value, PREDICATE predicate)
+		{
+			auto _equal = [&value, &predicate](const T& val1) -> bool { return predicate(val1, value); };
+			return GASHA_ linearSearchAll(array, size, found_indices, found_max, _equal);
+		}
+	};
+	template<class T, typename V, class PREDICATE>
+	struct linearSearchValue<T, V, PREDICATE, true>
+	{
+		//SIMD版
+		typedef typename simdLinearSearchKernelType<T>::type kernel_type;
+		inline static kernel_type toKernel(const V& value){ return static_cast<kernel_type>(static_cast<T>(value)); }
+		inline static const kernel_type* toKernel(const T* array){ return reinterpret_cast<const kernel_type*>(array); }
+		inline static T* search(T* array, const std::size_t size, const V& value, PREDICATE predicate)
+		{
+			const std::size_t index = simdLinearSearch(toKernel(array), size, toKernel(value));
+			return index == size ? nullptr : array + index;
+		}
+		inline static std::size_t count(const T* array, const std::size_t size, const V& value, PREDICATE predicate)
+		{
+			return simdLinearCount(toKernel(array), size, toKernel(value));
+		}
+		inline static std::size_t searchAll(const T* array, const std::size_t size, std::size_t* found_indices, const std::size_t found_max, const V& value, PREDICATE predicate)
+		{
+			return simdLinearSearchAll(toKernel(array), size, found_indices, found_max, toKernel(value));
+		}
+	};
+}//namespace _private
+
+//----------------------------------------
+//アルゴリズム：線形探索
+//※探索値指定版
+template<class T, typename V, class PREDICATE>
+inline T* linearSearchValue(T* array, const std::size_t size, const V& value, PREDICATE predicate)
+{
+	if (!array || size == 0)
+		return nullptr;
+	return _private::linearSearchValue<T, V, PREDICATE>::search(array, size, value, predicate);
+}
+
+//----------------------------------------
+//アルゴリズム：線形探索による計数
+template<class T, class PREDICATE>
+std::size_t linearCount(const T* array, const std::size_t size, PREDICATE predicate)
+{
+	if (!array || size == 0)
+		return 0;
+	std::size_t count = 0;
+	const T* now = array;
+	for (std::size_t i = 0; i < size; ++i, ++now)//順次探索
+	{
+		if (predicate(*now))//探索値と一致したら計数
+			++count;
+	}
+	return count;
+}
+//※探索値指定版
+template<class T, typename V, class PREDICATE>
+inline std::size_t linearCountValue(const T* array, const std::size_t size, const V& value, PREDICATE predicate)
+{
+	if (!array || size == 0)
+		return 0;
+	return _private::linearSearchValue<T, V, PREDICATE>::count(array, size, value, predicate);
+}
+template<class T, typename V>
+inline std::size_t linearCountValue(const T* array, const std::size_t size, const V& value)
+{
+	return GASHA_ linearCountValue(array, size, value, GASHA_ equal_to<T>());
+}
+
+//----------------------------------------
+//アルゴリズム：線形探索による全件探索
+template<class T, class PREDICATE>
+std::size_t linearSearchAll(const T* array, const std::size_t size, std::size_t* found_indices, const std::size_t found_max, PREDICATE predicate)
+{
+	if (!array || size == 0 || !found_indices || found_max == 0)
+		return 0;
+	std::size_t found_num = 0;
+	const T* now = array;
+	for (std::size_t i = 0; i < size; ++i, ++now)//順次探索
+	{
+		if (predicate(*now))//探索値と一致したら記録
+		{
+			found_indices[found_num++] = i;
+			if (found_num == found_max)//格納先が一杯になったら終了
+				break;
+		}
+	}
+	return found_num;
+}
+//※探索値指定版
+template<class T, typename V, class PREDICATE>
+inline std::size_t linearSearchAllValue(const T* array, const std::size_t size, std::size_t* found_indices, const std::size_t found_max, const V& value, PREDICATE predicate)
+{
+	if (!array || size == 0 || !found_indices || found_max == 0)
+		return 0;
+	return _private::linearSearchValue<T, V, PREDICATE>::searchAll(array, size, found_indices, found_max, value, predicate);
+}
+template<class T, typename V>
+inline std::size_t linearSearchAllValue(const T* array, const std::size_t size, std::size_t* found_indices, const std::size_t found_max, const V& value)
+{
+	return GASHA_ linearSearchAllValue(array, size, found_indices, found_max, value, GASHA_ equal_to<T>());
+}
+
 //----------------------------------------
 //アルゴリズム：線形探索
 //※イテレータ対応版
@@ -282,6 +282,12 @@ namespace linked_list
 	std::size_t shellSort(typename OPE_TYPE::node_type*& first, typename OPE_TYPE::node_type*& last);
 	template<class OPE_TYPE, class PREDICATE>
 	std::size_t shellSort(typename OPE_TYPE::node_type*& first, typename OPE_TYPE::node_type*& last, PREDICATE predicate);
+	//----------------------------------------
+	//双方向連結リスト操作関数：ティムソート
+	template<class OPE_TYPE>
+	std::size_t timSort(typename OPE_TYPE::node_type*& first, typename OPE_TYPE::node_type*& last);
+	template<class OPE_TYPE, class PREDICATE>
+	std::size_t timSort(typename OPE_TYPE::node_type*& first, typename OPE_TYPE::node_type*& last, PREDICATE predicate);
 
 	//----------------------------------------
 	//双方向連結リストコンテナ
@@ -644,7 +650,7 @@ namespace linked_list
 
 	#ifdef GASHA_LINKED_LIST_ENABLE_STABLE_SORT
 		//安定ソート
-		//※挿入ソートを使用
+		//※ティムソート（自然マージソート）を使用
 		//※ope_type::predicateForSort() を使用して探索（標準では、データ型の operator<() に従って探索）
 		//※自動的なロック取得は行わないので、マルチスレッドで利用する際は、
 		//　一連の処理ブロックの前後で排他ロック（ライトロック）の取得と解放を行う必要がある
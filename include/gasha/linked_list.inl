@@ -21,6 +21,7 @@
 
 #include <gasha/intro_sort.h>//イントロソート
 #include <gasha/insertion_sort.h>//挿入ソート
+#include <gasha/tim_sort.h>//ティムソート
 
 #include <gasha/linear_search.h>//線形探索
 #include <gasha/binary_search.h>//二分探索
@@ -339,6 +340,19 @@ namespace linked_list
 		return GASHA_ linkedListShellSort(first, last, OPE_TYPE::getNext, OPE_TYPE::getPrev, insertNodeBefore<OPE_TYPE>, removeNode<OPE_TYPE>, predicate);
 	}
 
+	//----------------------------------------
+	//双方向連結リスト操作関数：ティムソート
+	template<class OPE_TYPE>
+	std::size_t timSort(typename OPE_TYPE::node_type*& first, typename OPE_TYPE::node_type*& last)
+	{
+		return GASHA_ linkedListTimSort(first, last, OPE_TYPE::getNext, OPE_TYPE::getPrev, insertNodeBefore<OPE_TYPE>, removeNode<OPE_TYPE>);
+	}
+	template<class OPE_TYPE, class PREDICATE>
+	std::size_t timSort(typename OPE_TYPE::node_type*& first, typename OPE_TYPE::node_type*& last, PREDICATE predicate)
+	{
+		return GASHA_ linkedListTimSort(first, last, OPE_TYPE::getNext, OPE_TYPE::getPrev, insertNodeBefore<OPE_TYPE>, removeNode<OPE_TYPE>, predicate);
+	}
+
 	//--------------------
 	//イテレータのインライン関数
 	
@@ -701,14 +715,14 @@ namespace linked_list
 	template<class OPE_TYPE>
 	inline void container<OPE_TYPE>::stableSort()
 	{
-		insertionSort<ope_type>(m_first, m_last, typename ope_type::predicateForSort());
+		timSort<ope_type>(m_first, m_last, typename ope_type::predicateForSort());
 	}
 	//※プレディケート関数指定版
 	template<class OPE_TYPE>
 	template<class PREDICATE>
 	inline void container<OPE_TYPE>::stableSort(PREDICATE predicate)
 	{
-		insertionSort<ope_type>(m_first, m_last, predicate);
+		timSort<ope_type>(m_first, m_last, predicate);
 	}
 #endif//GASHA_LINKED_LIST_ENABLE_STABLE_SORT
 
@@ -0,0 +1,88 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_LSD_RADIX_SORT_H
+#define GASHA_INCLUDED_LSD_RADIX_SORT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// lsd_radix_sort.h
+// LSD基数ソート【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/sort_basic.h>//ソート処理基本
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズムの説明
+//========================================
+
+//・計算時間：
+//    - O(n)       ... データ件数分の時間
+//    - O(n ^ 2)   ... データ件数の２乗分の時間
+//    - O(log n)   ... log2(データ件数)分の時間（4→2, 16→4, 1024→10,1048576→20）
+//    - O(n log n) ... n×log n 分の時間
+//・メモリ使用量：
+//    - O(1)       ... １件分のメモリが必要
+//    - O(n)       ... データ件数分のメモリが必要
+//    - O(log n)   ... log2(データ件数)分のメモリが必要
+//・安定性：
+//    - ○         ... キーが同じデータの順序性が維持されることを保証する
+//                     例：{ 3-a, 5-b, 4-c, 5-d, 9-e, 3-f, 4-g, 3-h, 5-i } → { 3-a, 3-f, 3-h, 4-c, 4-g, 5-b, 5-d, 5-i, 9-e }
+//    - ×         ... 例：(同上)                        
+
+//========================================
+//ソートアルゴリズム分類：分布ソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：LSD基数ソート
+//----------------------------------------
+//・最良計算時間：O(n*k/d) ※k=キーの範囲、d=基数(256)
+//・平均計算時間：O(n*k/d)
+//・最悪計算時間：O(n*k/d)
+//・メモリ使用量：O(n) ※作業用配列(n件) + O(256 * キーのバイト数) の分布情報
+//・安定性：　　　○
+//----------------------------------------
+//※下位の桁から順に、配列と作業用配列の間で交互に分配（スキャッター）する。
+//※全ての桁の分布（ヒストグラム）を最初の一回の走査でまとめて集計する。
+//※全要素が同じ値の桁（キーの上位の0など）は、分配処理を省略する。
+//※キー情報の連結リストなどを作らず、連続したメモリを順に処理するため、
+//　基数ソート（radixSort）より高速。
+//※キー型には、符号なし整数型、符号付き整数型、浮動小数点型（float, double）が使用可能。
+//　符号付き整数型と浮動小数点型は、ビット列を順序が保たれる符号なし整数に変換してソートする。
+//　（浮動小数点型の場合、-0.0 は +0.0 より前に並び、NaN の位置は不定）
+//※作業用配列は、呼び出し元で用意するか、GASHAのアロケータから確保する。
+//　作業用配列を指定しない場合は、new で確保する。（多態アロケータ（polyAllocator）の影響を受ける）
+//※作業用配列の要素はムーブ代入されるため、要素型はデフォルトコンストラクタとムーブ代入が可能である必要がある。
+//※交換回数として、分配によって位置が変わった要素の数の合計を返す。
+//----------------------------------------
+//プロトタイプ：
+//・KEY_TYPE GET_KEY_FUNCTOR(const T& value)//オブジェクトを受け取りキーを返す
+//　※GET_KEY_FUNCTOR::key_type にキー型を定義しておく必要あり
+//作業用配列指定版
+//※work_array には size 件以上の配列を指定する。
+template<class T, class GET_KEY_FUNCTOR>
+std::size_t lsdRadixSortWithBuff(T* array, const std::size_t size, T* work_array, GET_KEY_FUNCTOR get_key_functor);
+//アロケータ指定版
+//※作業用配列を allocator.newArray() で確保し、ソート後に deleteArray() で解放する。
+template<class T, class ALLOCATOR, class GET_KEY_FUNCTOR>
+std::size_t lsdRadixSortWithAllocator(T* array, const std::size_t size, ALLOCATOR& allocator, GET_KEY_FUNCTOR get_key_functor);
+//LSD基数ソート本体
+//※作業用配列を new で確保する。
+template<class T, class GET_KEY_FUNCTOR>
+std::size_t lsdRadixSort(T* array, const std::size_t size, GET_KEY_FUNCTOR get_key_functor);
+GASHA_OVERLOAD_SET_FOR_DISTRIBUTED_SORT(lsdRadixSort);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/lsd_radix_sort.inl>
+
+#endif//GASHA_INCLUDED_LSD_RADIX_SORT_H
+
+// End of file
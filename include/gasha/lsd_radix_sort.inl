@@ -0,0 +1,182 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_LSD_RADIX_SORT_INL
+#define GASHA_INCLUDED_LSD_RADIX_SORT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// lsd_radix_sort.inl
+// LSD基数ソート【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/lsd_radix_sort.h>//LSD基数ソート【宣言部】
+
+#include <type_traits>//C++11 std::is_signed, std::is_floating_point, std::make_unsigned, std::conditional
+#include <utility>//C++11 std::move
+#include <cstdint>//C++11 std::uint32_t, std::uint64_t
+#include <cstring>//std::memcpy(), std::memset()
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズム分類：分布ソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：LSD基数ソート
+namespace _private
+{
+	//キーの変換
+	//※キーを、大小関係が保たれる符号なし整数に変換する
+	template<typename KEY_TYPE, bool IS_FLOAT = std::is_floating_point<KEY_TYPE>::value, bool IS_SIGNED = std::is_signed<KEY_TYPE>::value>
+	struct lsdRadixKey;
+	//※キーが符号なし整数型の場合
+	template<typename KEY_TYPE>
+	struct lsdRadixKey<KEY_TYPE, false, false>
+	{
+		typedef KEY_TYPE key_type;
+		inline static key_type conv(const KEY_TYPE key){ return key; }
+	};
+	//※キーが符号付き整数型の場合
+	//　符号ビットを反転する
+	template<typename KEY_TYPE>
+	struct lsdRadixKey<KEY_TYPE, false, true>
+	{
+		typedef typename std::make_unsigned<KEY_TYPE>::type key_type;
+		static const key_type SIGN_BIT = static_cast<key_type>(static_cast<key_type>(1) << (sizeof(key_type) * 8 - 1));
+		inline static key_type conv(const KEY_TYPE key){ return static_cast<key_type>(static_cast<key_type>(key) ^ SIGN_BIT); }
+	};
+	//※キーが浮動小数点型の場合
+	//　正の値は符号ビットを立て、負の値は全ビットを反転する
+	template<typename KEY_TYPE>
+	struct lsdRadixKey<KEY_TYPE, true, true>
+	{
+		static_assert(sizeof(KEY_TYPE) == sizeof(std::uint32_t) || sizeof(KEY_TYPE) == sizeof(std::uint64_t), "KEY_TYPE is not supported.");
+		typedef typename std::conditional<sizeof(KEY_TYPE) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>::type key_type;
+		static const key_type SIGN_BIT = static_cast<key_type>(static_cast<key_type>(1) << (sizeof(key_type) * 8 - 1));
+		inline static key_type conv(const KEY_TYPE key)
+		{
+			key_type bits;
+			std::memcpy(&bits, &key, sizeof(key_type));
+			return (bits & SIGN_BIT) ? ~bits : (bits | SIGN_BIT);
+		}
+	};
+
+	//LSD基数ソート処理
+	template<class T, class GET_KEY_FUNCTOR>
+	std::size_t lsdRadixSort(T* array, const std::size_t size, T* work_array, GET_KEY_FUNCTOR get_key_functor)
+	{
+		typedef typename GET_KEY_FUNCTOR::key_type KEY_TYPE;//キー型
+		typedef lsdRadixKey<KEY_TYPE> radix_key_t;//キー変換型
+		typedef typename radix_key_t::key_type KEY_TYPE_U;//符号なしキー型
+
+		static const std::size_t RADIX = 256;//基数
+		static const std::size_t DIGIT_NUM = sizeof(KEY_TYPE_U);//桁数
+
+		auto calcDigit = [](const KEY_TYPE_U key, const std::size_t column) -> std::size_t
+		{
+			return static_cast<std::size_t>((key >> (column << 3)) & 0xff);
+		};
+
+		//全ての桁の分布を一度の走査で集計
+		std::size_t histogram[DIGIT_NUM][RADIX];
+		std::memset(histogram, 0, sizeof(histogram));
+		{
+			const T* elem_p = array;
+			const T* elem_end = array + size;
+			for (; elem_p < elem_end; ++elem_p)
+			{
+				const KEY_TYPE_U key = radix_key_t::conv(get_key_functor(*elem_p));
+				for (std::size_t column = 0; column < DIGIT_NUM; ++column)
+					++histogram[column][calcDigit(key, column)];
+			}
+		}
+
+		//下位の桁から順に分配
+		std::size_t swapped_count = 0;
+		T* src = array;
+		T* dst = work_array;
+		const KEY_TYPE_U first_key = radix_key_t::conv(get_key_functor(*array));
+		for (std::size_t column = 0; column < DIGIT_NUM; ++column)
+		{
+			std::size_t* counts = histogram[column];
+			//全要素が同じ値の桁は処理しない
+			if (counts[calcDigit(first_key, column)] == size)
+				continue;
+			//分布から分配先の位置を算出
+			std::size_t offset = 0;
+			for (std::size_t digit = 0; digit < RADIX; ++digit)
+			{
+				const std::size_t count = counts[digit];
+				counts[digit] = offset;
+				offset += count;
+			}
+			//分配
+			for (std::size_t index = 0; index < size; ++index)
+			{
+				T& elem = src[index];
+				const std::size_t dst_index = counts[calcDigit(radix_key_t::conv(get_key_functor(elem)), column)]++;
+				if (dst_index != index)
+					++swapped_count;
+				dst[dst_index] = std::move(elem);
+			}
+			T* tmp = src;
+			src = dst;
+			dst = tmp;
+		}
+
+		//ソート結果が作業用配列にあれば元の配列に戻す
+		if (src != array)
+		{
+			for (std::size_t index = 0; index < size; ++index)
+				array[index] = std::move(src[index]);
+		}
+		return swapped_count;
+	}
+}//namespace _private
+//作業用配列指定版
+template<class T, class GET_KEY_FUNCTOR>
+inline std::size_t lsdRadixSortWithBuff(T* array, const std::size_t size, T* work_array, GET_KEY_FUNCTOR get_key_functor)
+{
+	if (!array || size <= 1 || !work_array)
+		return 0;
+	return _private::lsdRadixSort(array, size, work_array, get_key_functor);
+}
+//アロケータ指定版
+template<class T, class ALLOCATOR, class GET_KEY_FUNCTOR>
+inline std::size_t lsdRadixSortWithAllocator(T* array, const std::size_t size, ALLOCATOR& allocator, GET_KEY_FUNCTOR get_key_functor)
+{
+	if (!array || size <= 1)
+		return 0;
+	T* work_array = allocator.template newArray<T>(size);
+	if (!work_array)//メモリ確保に失敗したら終了
+		return 0;
+	const std::size_t swapped_count = _private::lsdRadixSort(array, size, work_array, get_key_functor);
+	allocator.deleteArray(work_array, size);
+	return swapped_count;
+}
+//LSD基数ソート本体
+template<class T, class GET_KEY_FUNCTOR>
+inline std::size_t lsdRadixSort(T* array, const std::size_t size, GET_KEY_FUNCTOR get_key_functor)
+{
+	if (!array || size <= 1)
+		return 0;
+	T* work_array = new T[size];
+	if (!work_array)//メモリ確保に失敗したら終了
+		return 0;
+	const std::size_t swapped_count = _private::lsdRadixSort(array, size, work_array, get_key_functor);
+	delete[] work_array;
+	return swapped_count;
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_LSD_RADIX_SORT_INL
+
+// End of file
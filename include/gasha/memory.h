@@ -47,6 +47,17 @@ template<std::size_t VAL>                    struct adjustStaticAlign<VAL, 0>{ s
 template<std::size_t ALIGN> struct isValidStaticAlign{    static const bool value = (countStaticBits<ALIGN>::value == 1); };//アラインメントとして適正な値か判定
 template<>                  struct isValidStaticAlign<0>{ static const bool value = true; };                                //アラインメントとして適正な値か判定
 
+//--------------------------------------------------------------------------------
+//プリフェッチ
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//プリフェッチ
+//※指定のアドレスを含むキャッシュラインを、あらかじめキャッシュに読み込むように要求する。
+//※要求のみで、読み込みの完了は待たない。また、無効なアドレスを指定しても例外は発生しない。
+//※二分探索の次の比較対象など、近いうちに参照するメモリの読み込み待ちを隠すために使用する。
+inline void prefetch(const void* p);
+
 GASHA_NAMESPACE_END;//ネームスペース：終了
 
 //--------------------------------------------------------------------------------
@@ -25,6 +25,10 @@
 #include <stdlib.h>//posix_memalign(), free()
 #endif//GASHA_IS_GCC
 
+#if defined(GASHA_IS_VC) && defined(GASHA_USE_SSE)
+#include <xmmintrin.h>//_mm_prefetch()
+#endif//GASHA_IS_VC, GASHA_USE_SSE
+
 GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 
 //--------------------------------------------------------------------------------
@@ -75,6 +79,23 @@ inline bool isValidAlign(const std::size_t align)
 	return (countBits(static_cast<unsigned int>(align)) == 1);
 }
 
+//--------------------------------------------------------------------------------
+//プリフェッチ
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//プリフェッチ
+inline void prefetch(const void* p)
+{
+#if defined(GASHA_IS_GCC)
+	__builtin_prefetch(p);
+#elif defined(GASHA_IS_VC) && defined(GASHA_USE_SSE)
+	_mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0);
+#else
+	(void)p;//プリフェッチ非対応環境では何もしない
+#endif
+}
+
 GASHA_NAMESPACE_END;//ネームスペース：終了
 
 //--------------------------------------------------------------------------------
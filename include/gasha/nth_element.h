@@ -0,0 +1,76 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_NTH_ELEMENT_H
+#define GASHA_INCLUDED_NTH_ELEMENT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// nth_element.h
+// n番目の要素の選択【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/sort_basic.h>//ソート処理基本
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズムの説明
+//========================================
+
+//・計算時間：
+//    - O(n)       ... データ件数分の時間
+//    - O(n ^ 2)   ... データ件数の２乗分の時間
+//    - O(log n)   ... log2(データ件数)分の時間（4→2, 16→4, 1024→10,1048576→20）
+//    - O(n log n) ... n×log n 分の時間
+//・メモリ使用量：
+//    - O(1)       ... １件分のメモリが必要
+//    - O(n)       ... データ件数分のメモリが必要
+//    - O(log n)   ... log2(データ件数)分のメモリが必要
+//・安定性：
+//    - ○         ... キーが同じデータの順序性が維持されることを保証する
+//                     例：{ 3-a, 5-b, 4-c, 5-d, 9-e, 3-f, 4-g, 3-h, 5-i } → { 3-a, 3-f, 3-h, 4-c, 4-g, 5-b, 5-d, 5-i, 9-e }
+//    - ×         ... 例：(同上)                        
+
+//========================================
+//ソートアルゴリズム分類：選択アルゴリズム
+//========================================
+
+//----------------------------------------
+//アルゴリズム：イントロセレクト（n番目の要素の選択）
+//----------------------------------------
+//・最良計算時間：O(n)
+//・平均計算時間：O(n)
+//・最悪計算時間：O(n log n)
+//・メモリ使用量：O(1)
+//・安定性：　　　×
+//----------------------------------------
+//※配列を部分的に整列し、nth 番目（0 から数える）の位置に、全体を整列した時にその位置に来る要素を置く。
+//　nth より前の要素は全て nth 番目の要素以下、nth より後の要素は全て nth 番目の要素以上になる。
+//　（前後それぞれの範囲内の並び順は不定）
+//※std::nth_element() と同様の処理。
+//※クイックソートと同じ手順で配列を分割し、nth 番目を含む側だけを処理し続ける（クイックセレクト）。
+//　分割はパターン打破クイックソート（pdqSort）と同じ処理を用いる。
+//　（軸の選択、ブロック分割、同値キーの分割、パターン打破）
+//※偏った分割が log n 回に達したら、ヒープによる選択に切り替えて最悪計算時間を保証する。
+//※対象件数が一定数（24件）未満になったら挿入ソートに切り替える。
+//※nth が size 以上の場合は何もしない。
+//※ランキングの上位 n 件を取り出す用途などでは、partialSort() や topK を使用すると良い。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value1, const T& value2)//value1 == value2 ならtrueを返す
+template<class T, class PREDICATE>
+std::size_t nthElement(T* array, const std::size_t size, const std::size_t nth, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_SELECTION(nthElement);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/nth_element.inl>
+
+#endif//GASHA_INCLUDED_NTH_ELEMENT_H
+
+// End of file
@@ -0,0 +1,174 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_NTH_ELEMENT_INL
+#define GASHA_INCLUDED_NTH_ELEMENT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// nth_element.inl
+// n番目の要素の選択【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/nth_element.h>//n番目の要素の選択【宣言部】
+
+#include <gasha/utility.h>//汎用ユーティリティ（値交換用）
+
+#include <gasha/pdq_sort.h>//パターン打破クイックソート（分割処理）
+
+#include <utility>//C++11 std::move
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズム分類：選択アルゴリズム
+//========================================
+
+//----------------------------------------
+//ヒープによる選択
+namespace _private
+{
+	//ダウンヒープ
+	//※index の要素を、子の方が大きい限り下方に移動する
+	template<class T, class PREDICATE>
+	inline void selectionDownHeap(T* heap, const std::size_t size, std::size_t index, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		T value(std::move(heap[index]));
+		while (true)
+		{
+			std::size_t child = index * 2 + 1;
+			if (child >= size)
+				break;
+			if (child + 1 < size && predicate(heap[child], heap[child + 1]))
+				++child;
+			if (!predicate(value, heap[child]))
+				break;
+			heap[index] = std::move(heap[child]);
+			index = child;
+			++swapped_count;
+		}
+		heap[index] = std::move(value);
+	}
+
+	//ヒープ選択
+	//※[begin, middle) に、[begin, end) の小さい方から (middle - begin) 件の要素を、最大ヒープとして集める
+	template<class T, class PREDICATE>
+	void selectionHeapSelect(T* begin, T* middle, T* end, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		const std::size_t heap_size = static_cast<std::size_t>(middle - begin);
+		if (heap_size == 0)
+			return;
+		//最大ヒープを作成
+		for (std::size_t index = heap_size / 2; index > 0; --index)
+			selectionDownHeap(begin, heap_size, index - 1, predicate, swapped_count);
+		//残りの要素のうち、根（ヒープ内の最大値）より小さいものと入れ替える
+		for (T* now = middle; now < end; ++now)
+		{
+			if (predicate(*now, *begin))
+			{
+				GASHA_ swapValues(*now, *begin);
+				++swapped_count;
+				selectionDownHeap(begin, heap_size, 0, predicate, swapped_count);
+			}
+		}
+	}
+}//namespace _private
+
+//----------------------------------------
+//アルゴリズム：イントロセレクト
+namespace _private
+{
+	template<class T, class PREDICATE>
+	std::size_t nthElement(T* begin, T* end, T* nth, PREDICATE predicate)
+	{
+		static const bool IS_BLOCK_PARTITION = isPdqSortBlockPartitionable<T, PREDICATE>::value;//ブロック分割が使用可能か？
+		std::size_t swapped_count = 0;
+		int bad_allowed = 0;//偏った分割の許容回数※log2(全体サイズ)で計算
+		for (std::size_t size_tmp = static_cast<std::size_t>(end - begin); size_tmp > 1; size_tmp >>= 1, ++bad_allowed);
+		bool leftmost = true;//配列の直前に要素がないか？
+		while (true)
+		{
+			const std::size_t size = static_cast<std::size_t>(end - begin);
+			//対象件数が一定数未満なら挿入ソートに切り替え
+			if (size < PDQ_SORT_INSERTION_SORT_THRESHOLD)
+			{
+				swapped_count += pdqSortInsertion<false>(begin, end, predicate);
+				return swapped_count;
+			}
+			//軸を決定し、先頭に配置
+			const std::size_t half = size / 2;
+			if (size > PDQ_SORT_NINTHER_THRESHOLD)
+			{
+				pdqSortSort3(begin, begin + half, end - 1, predicate, swapped_count);
+				pdqSortSort3(begin + 1, begin + (half - 1), end - 2, predicate, swapped_count);
+				pdqSortSort3(begin + 2, begin + (half + 1), end - 3, predicate, swapped_count);
+				pdqSortSort3(begin + (half - 1), begin + half, begin + (half + 1), predicate, swapped_count);
+				GASHA_ swapValues(*begin, *(begin + half));
+				++swapped_count;
+			}
+			else
+				pdqSortSort3(begin + half, begin, end - 1, predicate, swapped_count);
+			//軸が直前の要素（全要素以下）と等しければ、軸と等しい要素を左側にまとめる
+			//※nth が左側に含まれれば、全て等しい要素なので終了
+			if (!leftmost && !predicate(*(begin - 1), *begin))
+			{
+				T* pivot_pos = pdqSortPartitionLeft(begin, end, predicate, swapped_count);
+				if (nth <= pivot_pos)
+					return swapped_count;
+				begin = pivot_pos + 1;
+				continue;
+			}
+			//軸未満の配列と軸以上の配列に二分
+			bool already_partitioned = false;
+			T* pivot_pos = pdqSortPartitionRight<IS_BLOCK_PARTITION>(begin, end, predicate, already_partitioned, swapped_count);
+			if (pivot_pos == nth)
+				return swapped_count;
+			const std::size_t l_size = static_cast<std::size_t>(pivot_pos - begin);
+			const std::size_t r_size = static_cast<std::size_t>(end - (pivot_pos + 1));
+			if (l_size < size / 8 || r_size < size / 8)
+			{
+				//偏った分割が続いたらヒープによる選択に切り替え
+				if (--bad_allowed == 0)
+				{
+					T* range_begin = nth < pivot_pos ? begin : pivot_pos + 1;
+					T* range_end = nth < pivot_pos ? pivot_pos : end;
+					selectionHeapSelect(range_begin, nth + 1, range_end, predicate, swapped_count);
+					GASHA_ swapValues(*range_begin, *nth);//ヒープの根（選択した中の最大値）が nth 番目の要素
+					++swapped_count;
+					return swapped_count;
+				}
+				//パターン打破
+				if (l_size >= PDQ_SORT_INSERTION_SORT_THRESHOLD)
+					pdqSortBreakPatterns(begin, pivot_pos, swapped_count);
+				if (r_size >= PDQ_SORT_INSERTION_SORT_THRESHOLD)
+					pdqSortBreakPatterns(pivot_pos + 1, end, swapped_count);
+			}
+			//nth を含む側だけを処理
+			if (nth < pivot_pos)
+				end = pivot_pos;
+			else
+			{
+				begin = pivot_pos + 1;
+				leftmost = false;
+			}
+		}
+	}
+}//namespace _private
+template<class T, class PREDICATE>
+inline std::size_t nthElement(T* array, const std::size_t size, const std::size_t nth, PREDICATE predicate)
+{
+	if (!array || size <= 1 || nth >= size)
+		return 0;
+	return _private::nthElement(array, array + size, array + nth, predicate);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_NTH_ELEMENT_INL
+
+// End of file
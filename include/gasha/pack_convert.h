@@ -0,0 +1,129 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PACK_CONVERT_H
+#define GASHA_INCLUDED_PACK_CONVERT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// pack_convert.h
+// パック形式変換【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint*_t, std::int*_t
+
+#ifdef GASHA_USE_SSE
+#include <xmmintrin.h>//SSE1
+#endif//GASHA_USE_SSE
+
+#ifdef GASHA_USE_SSE2
+#include <emmintrin.h>//SSE2
+#endif//GASHA_USE_SSE2
+
+#if defined(GASHA_USE_AVX) || defined(GASHA_USE_F16C) || defined(GASHA_DISPATCH_F16C)
+#include <immintrin.h>//AVX, F16C
+#endif//GASHA_USE_AVX, GASHA_USE_F16C, GASHA_DISPATCH_F16C
+
+#ifdef GASHA_DISPATCH_F16C
+#include <gasha/cpu_features.h>//CPU機能判定
+#endif//GASHA_DISPATCH_F16C
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//パック形式変換
+//※座標や法線などを低い精度で格納し、メモリ使用量とメモリ帯域を削減するための変換処理。
+//※以下の形式と float の相互変換に対応する。
+//　・半精度浮動小数点数（half） ... IEEE 754 binary16。std::uint16_t に格納。
+//　　　　　　　　　　　　　　　　   丸めは最近接偶数丸め。範囲外は ±∞、非数は非数（quiet NaN）に変換する。
+//　・snorm16 ... -1.0～1.0 を -32767～32767 に対応させた固定小数点数。（-32768 は -1.0 として扱う）
+//　・unorm16 ... 0.0～1.0 を 0～65535 に対応させた固定小数点数。
+//　・unorm8  ... 0.0～1.0 を 0～255 に対応させた固定小数点数。
+//　※固定小数点数への変換は、範囲外の値を範囲内に丸め、最近接偶数丸めで整数化する。非数の結果は不定。
+//※配列の一括変換（～Batch）は、SSE2命令が有効なら8要素ずつ（unorm8 は16要素ずつ）処理し、端数はスカラー演算で処理する。
+//※半精度浮動小数点数は、F16C命令が有効なら（GASHA_USE_F16C）、F16C命令で変換する。
+//　ビルド設定 GASHA_USE_RUNTIME_CPU_DISPATCH が有効で、F16C命令がコンパイル時に無効な場合、
+//　配列の一括変換では、CPUのF16C命令対応を実行時に判定し、対応していればF16C命令で8要素ずつ処理する。
+//　F16C命令を使用しない場合は、整数演算で変換する。（非正規化数も正しく変換する）
+//※配列のアラインメントは問わない。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  const std::uint16_t h = floatToHalf(1.5f);//半精度に変換
+//  floatToHalfBatch(positions, packed_positions, n);//配列を一括変換
+//  floatToSnorm16Batch(normals, packed_normals, n);
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//半精度浮動小数点数
+inline std::uint16_t floatToHalf(const float value);
+inline float halfToFloat(const std::uint16_t value);
+
+//----------------------------------------
+//固定小数点数
+inline std::int16_t floatToSnorm16(const float value);
+inline float snorm16ToFloat(const std::int16_t value);
+inline std::uint16_t floatToUnorm16(const float value);
+inline float unorm16ToFloat(const std::uint16_t value);
+inline std::uint8_t floatToUnorm8(const float value);
+inline float unorm8ToFloat(const std::uint8_t value);
+
+//----------------------------------------
+//SSE命令専用関数
+//※半精度浮動小数点数は、ベクトルの下位から順に std::uint16_t の要素として格納する。
+#ifdef GASHA_USE_SSE2
+inline __m128i m128_floatToHalf(const __m128 value_m128);//4要素を半精度に変換（下位64ビットに格納）
+inline __m128 m128_halfToFloat(const __m128i value_m128i);//下位64ビットの4要素を単精度に変換
+#endif//GASHA_USE_SSE2
+#ifdef GASHA_USE_AVX
+inline __m128i m256_floatToHalf(const __m256 value_m256);//8要素を半精度に変換
+inline __m256 m256_halfToFloat(const __m128i value_m128i);//8要素を単精度に変換
+#endif//GASHA_USE_AVX
+
+//----------------------------------------
+//配列の一括変換
+inline void floatToHalfBatch(const float* src, std::uint16_t* dst, const std::size_t n);
+inline void halfToFloatBatch(const std::uint16_t* src, float* dst, const std::size_t n);
+inline void floatToSnorm16Batch(const float* src, std::int16_t* dst, const std::size_t n);
+inline void snorm16ToFloatBatch(const std::int16_t* src, float* dst, const std::size_t n);
+inline void floatToUnorm16Batch(const float* src, std::uint16_t* dst, const std::size_t n);
+inline void unorm16ToFloatBatch(const std::uint16_t* src, float* dst, const std::size_t n);
+inline void floatToUnorm8Batch(const float* src, std::uint8_t* dst, const std::size_t n);
+inline void unorm8ToFloatBatch(const std::uint8_t* src, float* dst, const std::size_t n);
+
+//--------------------------------------------------------------------------------
+//クォータニオンの圧縮（smallest three）
+//※正規化されたクォータニオン（x, y, z, w）の、絶対値が最大の成分を除いた3成分を量子化して格納する。
+//　除いた成分は、単位長の条件から復元する。（q と -q は同じ回転なので、最大成分が正になるように符号を揃える）
+//※残りの3成分は ±1/√2 の範囲に収まるため、その範囲を量子化する。
+//　・32ビット版 ... 最大成分の位置（2ビット）＋ 10ビット×3（各成分の最大誤差 約0.002）
+//　・64ビット版 ... 最大成分の位置（2ビット）＋ 20ビット×3（各成分の最大誤差 約0.000002）
+//※復元したクォータニオンの符号は、元のクォータニオンと逆になることがある。
+//※配列の一括変換は、スカラー演算で処理する。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  const std::uint32_t packed = packQuaternion32(rotation);
+//  float q[4];
+//  unpackQuaternion32(q, packed);
+//--------------------------------------------------------------------------------
+
+inline std::uint32_t packQuaternion32(const float (&q)[4]);
+inline void unpackQuaternion32(float (&q)[4], const std::uint32_t packed);
+inline std::uint64_t packQuaternion64(const float (&q)[4]);
+inline void unpackQuaternion64(float (&q)[4], const std::uint64_t packed);
+inline void packQuaternion32Batch(const float (*q)[4], std::uint32_t* dst, const std::size_t n);
+inline void unpackQuaternion32Batch(const std::uint32_t* src, float (*q)[4], const std::size_t n);
+inline void packQuaternion64Batch(const float (*q)[4], std::uint64_t* dst, const std::size_t n);
+inline void unpackQuaternion64Batch(const std::uint64_t* src, float (*q)[4], const std::size_t n);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/pack_convert.inl>
+
+#endif//GASHA_INCLUDED_PACK_CONVERT_H
+
+// End of file
@@ -0,0 +1,555 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PACK_CONVERT_INL
+#define GASHA_INCLUDED_PACK_CONVERT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// pack_convert.inl
+// パック形式変換【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/pack_convert.h>//パック形式変換【宣言部】
+
+#include <cmath>//std::sqrt(), std::nearbyint()
+#include <cstring>//std::memcpy()
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+namespace _private
+{
+	//----------------------------------------
+	//ビットパターンの変換
+	inline std::uint32_t packFloatToBits(const float value)
+	{
+		std::uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+	inline float packBitsToFloat(const std::uint32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	//----------------------------------------
+	//範囲内に丸めて最近接偶数丸めで整数化
+	inline int packClampRound(const float value, const float min_value, const float max_value)
+	{
+		const float clamped = value < min_value ? min_value : value > max_value ? max_value : value;
+	#ifdef GASHA_USE_SSE
+		return _mm_cvtss_si32(_mm_set_ss(clamped));
+	#else//GASHA_USE_SSE
+		return static_cast<int>(std::nearbyint(clamped));
+	#endif//GASHA_USE_SSE
+	}
+
+#ifdef GASHA_USE_SSE2
+	//----------------------------------------
+	//SSE2命令による半精度浮動小数点数変換
+	//※単精度→半精度は、符号拡張した32ビット整数として返す（_mm_packs_epi32() でそのまま16ビットに詰められる）
+	//※半精度→単精度は、ゼロ拡張した32ビット整数を受け取る
+	inline __m128i floatToHalf_sse2(const __m128 value_m128)
+	{
+		const __m128 sign_m128 = _mm_and_ps(value_m128, _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u))));
+		const __m128 abs_m128 = _mm_xor_ps(value_m128, sign_m128);
+		const __m128i abs_m128i = _mm_castps_si128(abs_m128);
+		//非数／∞
+		const __m128i is_regular_m128i = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), abs_m128i);
+		const __m128i nan_bit_m128i = _mm_and_si128(_mm_castps_si128(_mm_cmpunord_ps(abs_m128, abs_m128)), _mm_set1_epi32(0x0200));
+		const __m128i inf_nan_m128i = _mm_or_si128(nan_bit_m128i, _mm_set1_epi32(0x7c00));
+		//非正規化数：加算で仮数部を所定の位置にずらす（丸めは加算時の最近接偶数丸め）
+		const __m128i is_subnormal_m128i = _mm_cmpgt_epi32(_mm_set1_epi32((127 - 14) << 23), abs_m128i);
+		const __m128i subnormal_magic_m128i = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		const __m128i subnormal_m128i = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(abs_m128, _mm_castsi128_ps(subnormal_magic_m128i))), subnormal_magic_m128i);
+		//正規化数：指数部の補正と最近接偶数丸め
+		const __m128i mant_odd_m128i = _mm_srai_epi32(_mm_slli_epi32(abs_m128i, 31 - 13), 31);
+		const __m128i normal_m128i = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(abs_m128i, _mm_set1_epi32(0xfff - ((127 - 15) << 23))), mant_odd_m128i), 13);
+		//合成
+		const __m128i finite_m128i = _mm_or_si128(_mm_and_si128(is_subnormal_m128i, subnormal_m128i), _mm_andnot_si128(is_subnormal_m128i, normal_m128i));
+		const __m128i result_m128i = _mm_or_si128(_mm_and_si128(is_regular_m128i, finite_m128i), _mm_andnot_si128(is_regular_m128i, inf_nan_m128i));
+		return _mm_or_si128(result_m128i, _mm_srai_epi32(_mm_castps_si128(sign_m128), 16));
+	}
+	inline __m128 halfToFloat_sse2(const __m128i value_m128i)
+	{
+		const __m128i exp_mant_m128i = _mm_and_si128(value_m128i, _mm_set1_epi32(0x7fff));
+		const __m128i sign_m128i = _mm_slli_epi32(_mm_xor_si128(value_m128i, exp_mant_m128i), 16);
+		//指数部の補正を乗算で行う（非正規化数も正しく正規化される）
+		const __m128 scaled_m128 = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exp_mant_m128i, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+		//非数／∞
+		const __m128i is_inf_nan_m128i = _mm_cmpgt_epi32(exp_mant_m128i, _mm_set1_epi32(0x7bff));
+		const __m128i inf_nan_exp_m128i = _mm_and_si128(is_inf_nan_m128i, _mm_set1_epi32(255 << 23));
+		return _mm_or_ps(scaled_m128, _mm_castsi128_ps(_mm_or_si128(sign_m128i, inf_nan_exp_m128i)));
+	}
+#endif//GASHA_USE_SSE2
+
+#if defined(GASHA_USE_F16C) || defined(GASHA_DISPATCH_F16C)
+	//----------------------------------------
+	//F16C命令を使用するか？
+	inline bool packIsF16C()
+	{
+	#ifdef GASHA_USE_F16C
+		return true;
+	#else//GASHA_USE_F16C
+		return GASHA_ cpuFeatures::instance().hasF16C();//実行時に判定（CPU機能の判定は初回のみ）
+	#endif//GASHA_USE_F16C
+	}
+
+	//----------------------------------------
+	//配列の一括変換：F16C命令版
+	//※先頭から8要素ずつ処理し、処理した要素数を返す（端数は呼び出し元で処理する）
+	//※実行時に振り分ける場合、F16C命令に対応したCPUでのみ呼び出すこと
+	GASHA_TARGET_F16C inline std::size_t floatToHalfBatch_f16c(const float* src, std::uint16_t* dst, const std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), 0));
+		return i;
+	}
+	GASHA_TARGET_F16C inline std::size_t halfToFloatBatch_f16c(const std::uint16_t* src, float* dst, const std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+		return i;
+	}
+#endif//GASHA_USE_F16C, GASHA_DISPATCH_F16C
+
+	//----------------------------------------
+	//クォータニオンの圧縮（smallest three）
+	template<typename UINT, int BITS>
+	struct packQuaternion
+	{
+		static const UINT MASK = (static_cast<UINT>(1u) << BITS) - 1u;
+
+		//圧縮
+		inline static UINT pack(const float (&q)[4])
+		{
+			//絶対値が最大の成分を探す
+			int max_index = 0;
+			float max_abs = q[0] < 0.f ? -q[0] : q[0];
+			for (int i = 1; i < 4; ++i)
+			{
+				const float abs_value = q[i] < 0.f ? -q[i] : q[i];
+				if (abs_value > max_abs)
+				{
+					max_index = i;
+					max_abs = abs_value;
+				}
+			}
+			//最大成分が正になるように符号を揃えて、残りの3成分を量子化
+			//※[-1/√2, 1/√2] → [0, MASK - 1]（0.0 を正確に表現できるように、段階数を偶数にする）
+			const float sign = q[max_index] < 0.f ? -1.f : 1.f;
+			const float max_value = static_cast<float>(MASK - 1u);
+			const float scale = max_value * 0.70710678f;
+			const float offset = max_value * 0.5f;
+			UINT packed = static_cast<UINT>(max_index);
+			for (int i = 0; i < 4; ++i)
+			{
+				if (i == max_index)
+					continue;
+				const int quantized = packClampRound(q[i] * sign * scale + offset, 0.f, max_value);
+				packed = (packed << BITS) | static_cast<UINT>(quantized);
+			}
+			return packed;
+		}
+
+		//展開
+		inline static void unpack(float (&q)[4], const UINT packed)
+		{
+			const float scale = 1.41421356f / static_cast<float>(MASK - 1u);
+			const float offset = -0.70710678f;
+			const int max_index = static_cast<int>((packed >> (BITS * 3)) & 3u);
+			int shift = BITS * 2;
+			float sum = 0.f;
+			for (int i = 0; i < 4; ++i)
+			{
+				if (i == max_index)
+					continue;
+				const float value = static_cast<float>((packed >> shift) & MASK) * scale + offset;
+				q[i] = value;
+				sum += value * value;
+				shift -= BITS;
+			}
+			//最大成分を単位長の条件から復元
+			const float rest = 1.f - sum;
+			q[max_index] = std::sqrt(rest > 0.f ? rest : 0.f);
+		}
+	};
+}//namespace _private
+
+//----------------------------------------
+//半精度浮動小数点数
+
+//単精度→半精度
+inline std::uint16_t floatToHalf(const float value)
+{
+#ifdef GASHA_USE_F16C
+	return static_cast<std::uint16_t>(_cvtss_sh(value, 0));
+#else//GASHA_USE_F16C
+	const std::uint32_t bits = _private::packFloatToBits(value);
+	const std::uint32_t sign = bits & 0x80000000u;
+	const std::uint32_t abs_bits = bits ^ sign;
+	std::uint32_t result;
+	if (abs_bits >= ((127u + 16u) << 23))//∞／非数
+		result = abs_bits > (255u << 23) ? 0x7e00u : 0x7c00u;
+	else if (abs_bits < ((127u - 14u) << 23))//非正規化数／ゼロ
+	{
+		//加算で仮数部を所定の位置にずらす（丸めは加算時の最近接偶数丸め）
+		const std::uint32_t magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+		result = _private::packFloatToBits(_private::packBitsToFloat(abs_bits) + _private::packBitsToFloat(magic)) - magic;
+	}
+	else//正規化数
+	{
+		const std::uint32_t mant_odd = (abs_bits >> 13) & 1u;
+		result = (abs_bits + (0xfffu - ((127u - 15u) << 23)) + mant_odd) >> 13;
+	}
+	return static_cast<std::uint16_t>(result | (sign >> 16));
+#endif//GASHA_USE_F16C
+}
+
+//半精度→単精度
+inline float halfToFloat(const std::uint16_t value)
+{
+#ifdef GASHA_USE_F16C
+	return _cvtsh_ss(value);
+#else//GASHA_USE_F16C
+	const std::uint32_t shifted_exp = 0x7c00u << 13;
+	std::uint32_t bits = (static_cast<std::uint32_t>(value) & 0x7fffu) << 13;
+	const std::uint32_t exp = bits & shifted_exp;
+	bits += (127u - 15u) << 23;//指数部の補正
+	if (exp == shifted_exp)//∞／非数
+		bits += (128u - 16u) << 23;
+	else if (exp == 0)//非正規化数／ゼロ
+	{
+		const std::uint32_t magic = 113u << 23;
+		bits = _private::packFloatToBits(_private::packBitsToFloat(bits + (1u << 23)) - _private::packBitsToFloat(magic));
+	}
+	return _private::packBitsToFloat(bits | ((static_cast<std::uint32_t>(value) & 0x8000u) << 16));
+#endif//GASHA_USE_F16C
+}
+
+//----------------------------------------
+//固定小数点数
+
+//単精度→snorm16
+inline std::int16_t floatToSnorm16(const float value)
+{
+	return static_cast<std::int16_t>(_private::packClampRound(value * 32767.f, -32767.f, 32767.f));
+}
+
+//snorm16→単精度
+inline float snorm16ToFloat(const std::int16_t value)
+{
+	const float result = static_cast<float>(value) * (1.f / 32767.f);
+	return result < -1.f ? -1.f : result;
+}
+
+//単精度→unorm16
+inline std::uint16_t floatToUnorm16(const float value)
+{
+	return static_cast<std::uint16_t>(_private::packClampRound(value * 65535.f, 0.f, 65535.f));
+}
+
+//unorm16→単精度
+inline float unorm16ToFloat(const std::uint16_t value)
+{
+	return static_cast<float>(value) * (1.f / 65535.f);
+}
+
+//単精度→unorm8
+inline std::uint8_t floatToUnorm8(const float value)
+{
+	return static_cast<std::uint8_t>(_private::packClampRound(value * 255.f, 0.f, 255.f));
+}
+
+//unorm8→単精度
+inline float unorm8ToFloat(const std::uint8_t value)
+{
+	return static_cast<float>(value) * (1.f / 255.f);
+}
+
+//----------------------------------------
+//SSE命令専用関数
+
+#ifdef GASHA_USE_SSE2
+//4要素を半精度に変換（下位64ビットに格納）
+inline __m128i m128_floatToHalf(const __m128 value_m128)
+{
+#ifdef GASHA_USE_F16C
+	return _mm_cvtps_ph(value_m128, 0);
+#else//GASHA_USE_F16C
+	return _mm_packs_epi32(_private::floatToHalf_sse2(value_m128), _mm_setzero_si128());
+#endif//GASHA_USE_F16C
+}
+
+//下位64ビットの4要素を単精度に変換
+inline __m128 m128_halfToFloat(const __m128i value_m128i)
+{
+#ifdef GASHA_USE_F16C
+	return _mm_cvtph_ps(value_m128i);
+#else//GASHA_USE_F16C
+	return _private::halfToFloat_sse2(_mm_unpacklo_epi16(value_m128i, _mm_setzero_si128()));
+#endif//GASHA_USE_F16C
+}
+#endif//GASHA_USE_SSE2
+
+#ifdef GASHA_USE_AVX
+//8要素を半精度に変換
+inline __m128i m256_floatToHalf(const __m256 value_m256)
+{
+#ifdef GASHA_USE_F16C
+	return _mm256_cvtps_ph(value_m256, 0);
+#else//GASHA_USE_F16C
+	return _mm_packs_epi32(_private::floatToHalf_sse2(_mm256_castps256_ps128(value_m256)), _private::floatToHalf_sse2(_mm256_extractf128_ps(value_m256, 1)));
+#endif//GASHA_USE_F16C
+}
+
+//8要素を単精度に変換
+inline __m256 m256_halfToFloat(const __m128i value_m128i)
+{
+#ifdef GASHA_USE_F16C
+	return _mm256_cvtph_ps(value_m128i);
+#else//GASHA_USE_F16C
+	const __m128 lo_m128 = _private::halfToFloat_sse2(_mm_unpacklo_epi16(value_m128i, _mm_setzero_si128()));
+	const __m128 hi_m128 = _private::halfToFloat_sse2(_mm_unpackhi_epi16(value_m128i, _mm_setzero_si128()));
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(lo_m128), hi_m128, 1);
+#endif//GASHA_USE_F16C
+}
+#endif//GASHA_USE_AVX
+
+//----------------------------------------
+//配列の一括変換
+
+//単精度→半精度
+inline void floatToHalfBatch(const float* src, std::uint16_t* dst, const std::size_t n)
+{
+	std::size_t i = 0;
+#if defined(GASHA_USE_F16C) || defined(GASHA_DISPATCH_F16C)
+	if (_private::packIsF16C())
+		i = _private::floatToHalfBatch_f16c(src, dst, n);
+#endif//GASHA_USE_F16C, GASHA_DISPATCH_F16C
+#ifdef GASHA_USE_SSE2
+	for (; i + 8 <= n; i += 8)
+	{
+		const __m128i lo_m128i = _private::floatToHalf_sse2(_mm_loadu_ps(src + i));
+		const __m128i hi_m128i = _private::floatToHalf_sse2(_mm_loadu_ps(src + i + 4));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo_m128i, hi_m128i));
+	}
+#endif//GASHA_USE_SSE2
+	//端数
+	for (; i < n; ++i)
+		dst[i] = floatToHalf(src[i]);
+}
+
+//半精度→単精度
+inline void halfToFloatBatch(const std::uint16_t* src, float* dst, const std::size_t n)
+{
+	std::size_t i = 0;
+#if defined(GASHA_USE_F16C) || defined(GASHA_DISPATCH_F16C)
+	if (_private::packIsF16C())
+		i = _private::halfToFloatBatch_f16c(src, dst, n);
+#endif//GASHA_USE_F16C, GASHA_DISPATCH_F16C
+#ifdef GASHA_USE_SSE2
+	for (; i + 8 <= n; i += 8)
+	{
+		const __m128i value_m128i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		_mm_storeu_ps(dst + i, _private::halfToFloat_sse2(_mm_unpacklo_epi16(value_m128i, _mm_setzero_si128())));
+		_mm_storeu_ps(dst + i + 4, _private::halfToFloat_sse2(_mm_unpackhi_epi16(value_m128i, _mm_setzero_si128())));
+	}
+#endif//GASHA_USE_SSE2
+	//端数
+	for (; i < n; ++i)
+		dst[i] = halfToFloat(src[i]);
+}
+
+//単精度→snorm16
+inline void floatToSnorm16Batch(const float* src, std::int16_t* dst, const std::size_t n)
+{
+	std::size_t i = 0;
+#ifdef GASHA_USE_SSE2
+	const __m128 min_m128 = _mm_set1_ps(-1.f);
+	const __m128 max_m128 = _mm_set1_ps(1.f);
+	const __m128 scale_m128 = _mm_set1_ps(32767.f);
+	for (; i + 8 <= n; i += 8)
+	{
+		const __m128i lo_m128i = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), min_m128), max_m128), scale_m128));
+		const __m128i hi_m128i = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), min_m128), max_m128), scale_m128));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo_m128i, hi_m128i));
+	}
+#endif//GASHA_USE_SSE2
+	//端数
+	for (; i < n; ++i)
+		dst[i] = floatToSnorm16(src[i]);
+}
+
+//snorm16→単精度
+inline void snorm16ToFloatBatch(const std::int16_t* src, float* dst, const std::size_t n)
+{
+	std::size_t i = 0;
+#ifdef GASHA_USE_SSE2
+	const __m128 min_m128 = _mm_set1_ps(-1.f);
+	const __m128 scale_m128 = _mm_set1_ps(1.f / 32767.f);
+	for (; i + 8 <= n; i += 8)
+	{
+		const __m128i value_m128i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		//符号拡張
+		const __m128i lo_m128i = _mm_srai_epi32(_mm_unpacklo_epi16(value_m128i, value_m128i), 16);
+		const __m128i hi_m128i = _mm_srai_epi32(_mm_unpackhi_epi16(value_m128i, value_m128i), 16);
+		_mm_storeu_ps(dst + i, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(lo_m128i), scale_m128), min_m128));
+		_mm_storeu_ps(dst + i + 4, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(hi_m128i), scale_m128), min_m128));
+	}
+#endif//GASHA_USE_SSE2
+	//端数
+	for (; i < n; ++i)
+		dst[i] = snorm16ToFloat(src[i]);
+}
+
+//単精度→unorm16
+inline void floatToUnorm16Batch(const float* src, std::uint16_t* dst, const std::size_t n)
+{
+	std::size_t i = 0;
+#ifdef GASHA_USE_SSE2
+	const __m128 min_m128 = _mm_setzero_ps();
+	const __m128 max_m128 = _mm_set1_ps(1.f);
+	const __m128 scale_m128 = _mm_set1_ps(65535.f);
+	const __m128i bias_m128i = _mm_set1_epi32(32768);
+	const __m128i flip_m128i = _mm_set1_epi16(static_cast<short>(0x8000));
+	for (; i + 8 <= n; i += 8)
+	{
+		//SSE2命令には符号なし飽和パック（32→16ビット）がないため、符号付きの範囲にずらしてパックし、最上位ビットを反転して戻す
+		const __m128i lo_m128i = _mm_sub_epi32(_mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), min_m128), max_m128), scale_m128)), bias_m128i);
+		const __m128i hi_m128i = _mm_sub_epi32(_mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), min_m128), max_m128), scale_m128)), bias_m128i);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(_mm_packs_epi32(lo_m128i, hi_m128i), flip_m128i));
+	}
+#endif//GASHA_USE_SSE2
+	//端数
+	for (; i < n; ++i)
+		dst[i] = floatToUnorm16(src[i]);
+}
+
+//unorm16→単精度
+inline void unorm16ToFloatBatch(const std::uint16_t* src, float* dst, const std::size_t n)
+{
+	std::size_t i = 0;
+#ifdef GASHA_USE_SSE2
+	const __m128 scale_m128 = _mm_set1_ps(1.f / 65535.f);
+	for (; i + 8 <= n; i += 8)
+	{
+		const __m128i value_m128i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		const __m128i lo_m128i = _mm_unpacklo_epi16(value_m128i, _mm_setzero_si128());
+		const __m128i hi_m128i = _mm_unpackhi_epi16(value_m128i, _mm_setzero_si128());
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo_m128i), scale_m128));
+		_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi_m128i), scale_m128));
+	}
+#endif//GASHA_USE_SSE2
+	//端数
+	for (; i < n; ++i)
+		dst[i] = unorm16ToFloat(src[i]);
+}
+
+//単精度→unorm8
+inline void floatToUnorm8Batch(const float* src, std::uint8_t* dst, const std::size_t n)
+{
+	std::size_t i = 0;
+#ifdef GASHA_USE_SSE2
+	const __m128 min_m128 = _mm_setzero_ps();
+	const __m128 max_m128 = _mm_set1_ps(1.f);
+	const __m128 scale_m128 = _mm_set1_ps(255.f);
+	for (; i + 16 <= n; i += 16)
+	{
+		const __m128i v0_m128i = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), min_m128), max_m128), scale_m128));
+		const __m128i v1_m128i = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), min_m128), max_m128), scale_m128));
+		const __m128i v2_m128i = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 8), min_m128), max_m128), scale_m128));
+		const __m128i v3_m128i = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 12), min_m128), max_m128), scale_m128));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(_mm_packs_epi32(v0_m128i, v1_m128i), _mm_packs_epi32(v2_m128i, v3_m128i)));
+	}
+#endif//GASHA_USE_SSE2
+	//端数
+	for (; i < n; ++i)
+		dst[i] = floatToUnorm8(src[i]);
+}
+
+//unorm8→単精度
+inline void unorm8ToFloatBatch(const std::uint8_t* src, float* dst, const std::size_t n)
+{
+	std::size_t i = 0;
+#ifdef GASHA_USE_SSE2
+	const __m128 scale_m128 = _mm_set1_ps(1.f / 255.f);
+	for (; i + 16 <= n; i += 16)
+	{
+		const __m128i value_m128i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		const __m128i lo_m128i = _mm_unpacklo_epi8(value_m128i, _mm_setzero_si128());
+		const __m128i hi_m128i = _mm_unpackhi_epi8(value_m128i, _mm_setzero_si128());
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo_m128i, _mm_setzero_si128())), scale_m128));
+		_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo_m128i, _mm_setzero_si128())), scale_m128));
+		_mm_storeu_ps(dst + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi_m128i, _mm_setzero_si128())), scale_m128));
+		_mm_storeu_ps(dst + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi_m128i, _mm_setzero_si128())), scale_m128));
+	}
+#endif//GASHA_USE_SSE2
+	//端数
+	for (; i < n; ++i)
+		dst[i] = unorm8ToFloat(src[i]);
+}
+
+//----------------------------------------
+//クォータニオンの圧縮
+
+//32ビットに圧縮
+inline std::uint32_t packQuaternion32(const float (&q)[4])
+{
+	return _private::packQuaternion<std::uint32_t, 10>::pack(q);
+}
+
+//32ビットから展開
+inline void unpackQuaternion32(float (&q)[4], const std::uint32_t packed)
+{
+	_private::packQuaternion<std::uint32_t, 10>::unpack(q, packed);
+}
+
+//64ビットに圧縮
+inline std::uint64_t packQuaternion64(const float (&q)[4])
+{
+	return _private::packQuaternion<std::uint64_t, 20>::pack(q);
+}
+
+//64ビットから展開
+inline void unpackQuaternion64(float (&q)[4], const std::uint64_t packed)
+{
+	_private::packQuaternion<std::uint64_t, 20>::unpack(q, packed);
+}
+
+//配列の一括変換
+inline void packQuaternion32Batch(const float (*q)[4], std::uint32_t* dst, const std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i)
+		dst[i] = packQuaternion32(q[i]);
+}
+inline void unpackQuaternion32Batch(const std::uint32_t* src, float (*q)[4], const std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i)
+		unpackQuaternion32(q[i], src[i]);
+}
+inline void packQuaternion64Batch(const float (*q)[4], std::uint64_t* dst, const std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i)
+		dst[i] = packQuaternion64(q[i]);
+}
+inline void unpackQuaternion64Batch(const std::uint64_t* src, float (*q)[4], const std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i)
+		unpackQuaternion64(q[i], src[i]);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_PACK_CONVERT_INL
+
+// End of file
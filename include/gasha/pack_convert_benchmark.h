@@ -0,0 +1,176 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PACK_CONVERT_BENCHMARK_H
+#define GASHA_INCLUDED_PACK_CONVERT_BENCHMARK_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// pack_convert_benchmark.h
+// パック形式変換ベンチマーク【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/pack_convert.h>//パック形式変換
+#include <gasha/benchmark_report.h>//ベンチマーク共通処理
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint64_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//パック形式変換ベンチマーク
+//※変換の種類 × 件数 の組み合わせごとに、スカラー版と一括変換版を実行し、
+//　１要素あたりの処理時間と、スループット（バイト／秒）を計測する。
+//　・変換の種類 ... 単精度と half / snorm16 / unorm16 / unorm8 の相互変換、
+//　　　　　　　　　 クォータニオンの圧縮（32ビット版／64ビット版）と復元
+//　・件数   ... 1000件から10倍ずつ、条件の最大件数（デフォルトは100万件）まで
+//　・変換方法
+//　　・スカラー版   ... 1要素ずつの変換関数（floatToHalf() など）をループで呼び出す。
+//　　・一括変換版   ... 配列の一括変換関数（floatToHalfBatch() など）
+//※スループットは、変換元と変換先を合わせたバイト数（読み込み＋書き込み）を処理時間で割った値。
+//　（例：単精度→half なら１要素あたり 4 + 2 = 6 バイト）
+//※入力データは、固定シードの xoshiro256pp で作る。（毎回同じ内容になる）
+//　単精度の値は、half は ±1000、snorm16 は ±1.2、unorm16 / unorm8 は -0.2～1.2 の範囲に一様に分布させる。（範囲外の丸めも含めて計測する）
+//　パック形式からの変換の入力データは、それらの値をスカラー版で変換して作る。
+//　クォータニオンは、各成分を ±1 の範囲に一様に分布させて正規化したもの。
+//※処理時間は、件数×回数が条件の一定数（repeatElementNum）以上になるように繰り返し変換し、
+//　repeatNum 回計測した最短の時間を採用する。（出力先の確保と入力データの作成時間は含まない）
+//※一括変換版の結果をスカラー版の結果とバイト単位で比較し、全て一致すれば true を返す。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //表とCSVをバッファに作成
+//  static char table[64 * 1024];
+//  static char csv[64 * 1024];
+//  std::size_t table_len, csv_len;
+//  packConvertBenchmarkReport(table, sizeof(table), table_len, csv, sizeof(csv), csv_len);
+//
+//  //ユニットテストで実行（計測結果を表示し、全ての結果が正しいか判定）
+//  GASHA_UT_BEGIN(pack_convert_benchmark, 0, GASHA_ ut::ATTR_MANUAL)
+//  {
+//      GASHA_UT_PACK_CONVERT_BENCHMARK(1000000);
+//  }
+//  GASHA_UT_END()
+//--------------------------------------------------------------------------------
+
+namespace packConvertBenchmark
+{
+	//変換の種類
+	enum convert_type
+	{
+		convertFloatToHalf = 0,//単精度→half
+		convertHalfToFloat,//half→単精度
+		convertFloatToSnorm16,//単精度→snorm16
+		convertSnorm16ToFloat,//snorm16→単精度
+		convertFloatToUnorm16,//単精度→unorm16
+		convertUnorm16ToFloat,//unorm16→単精度
+		convertFloatToUnorm8,//単精度→unorm8
+		convertUnorm8ToFloat,//unorm8→単精度
+		convertPackQuaternion32,//クォータニオン→32ビット
+		convertUnpackQuaternion32,//32ビット→クォータニオン
+		convertPackQuaternion64,//クォータニオン→64ビット
+		convertUnpackQuaternion64,//64ビット→クォータニオン
+	};
+	static const int CONVERT_TYPE_NUM = 12;//変換の種類数
+	//変換の種類名
+	inline const char* convertName(const convert_type convert);
+	//１要素あたりの変換元／変換先のバイト数
+	inline std::size_t srcElementSize(const convert_type convert);
+	inline std::size_t dstElementSize(const convert_type convert);
+
+	//変換方法
+	enum method_type
+	{
+		methodScalar = 0,//スカラー版
+		methodBatch,//一括変換版
+	};
+	static const int METHOD_TYPE_NUM = 2;//変換方法の数
+	//変換方法名
+	inline const char* methodName(const method_type method);
+
+	static const std::uint64_t SEED = 0x9ac69ac69ac69ac6ull;//入力データ作成用の乱数のシード
+
+	//計測条件
+	struct condition
+	{
+		std::size_t m_sizeMin;//最小件数（10倍ずつ最大件数まで計測）
+		std::size_t m_sizeMax;//最大件数
+		std::size_t m_repeatElementNum;//１回の計測で変換する最小の要素数（件数×回数）
+		int m_repeatNum;//組み合わせごとの計測回数
+		inline condition();
+	};
+
+	//計測結果
+	struct result
+	{
+		convert_type m_convert;//変換の種類
+		method_type m_method;//変換方法
+		std::size_t m_size;//件数
+		double m_nsPerElement;//１要素あたりの処理時間（ナノ秒）
+		double m_gBytesPerSec;//１秒あたりの処理バイト数（変換元＋変換先、10億バイト単位）
+		double m_speedUp;//スカラー版に対する速度向上率
+		bool m_isOk;//結果が正しいか？（スカラー版の結果と一致するか？）
+	};
+
+	//ベンチマーク定義
+	//※benchmarkReport() などに渡す（benchmark_report.h 参照）
+	struct definition
+	{
+		typedef condition condition_type;//計測条件の型
+		typedef result result_type;//計測結果の型
+		//表のタイトル
+		inline static void writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond);
+		//表形式
+		inline static void writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+		inline static void writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+		//CSV形式
+		inline static void writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+		inline static void writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+		//全ての組み合わせを計測
+		template<class FUNCTOR>
+		inline static bool testAll(const condition_type& cond, FUNCTOR functor);
+	};
+}//namespace packConvertBenchmark
+
+//----------------------------------------
+//変換の種類と件数を指定して、全ての変換方法を計測
+//※変換方法ごとに functor(const packConvertBenchmark::result&) を呼び出す
+//※全ての結果が正しければ true を返す
+template<class FUNCTOR>
+bool packConvertBenchmarkTest(const packConvertBenchmark::convert_type convert, const std::size_t size, const packConvertBenchmark::condition& cond, FUNCTOR functor);
+
+//----------------------------------------
+//条件の全ての組み合わせを計測
+//※計測結果ごとに functor(const packConvertBenchmark::result&) を呼び出す
+//※全ての結果が正しければ true を返す
+template<class FUNCTOR>
+bool packConvertBenchmarkTestAll(const packConvertBenchmark::condition& cond, FUNCTOR functor);
+
+//----------------------------------------
+//全ての組み合わせを計測し、表とCSVを作成
+//※表またはCSVが不要な場合は、バッファに nullptr を指定する
+//※全ての結果が正しければ true を返す
+//※メッセージとそのサイズを受け取るための変数を引数に渡す（表／CSVともに16KBもあれば十分）。
+inline bool packConvertBenchmarkReport(char* table_message, const std::size_t table_max_size, std::size_t& table_message_len, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const packConvertBenchmark::condition& cond = packConvertBenchmark::condition());
+
+//----------------------------------------
+//ユニットテスト用マクロ
+//※GASHA_UT_BEGIN() ～ GASHA_UT_END() の中で使用する
+#define GASHA_UT_PACK_CONVERT_BENCHMARK(size_max) \
+	{ \
+		GASHA_ packConvertBenchmark::condition bench_cond; \
+		bench_cond.m_sizeMax = size_max; \
+		GASHA_UT_BENCHMARK(GASHA_ packConvertBenchmark::definition, bench_cond); \
+	}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/pack_convert_benchmark.inl>
+
+#endif//GASHA_INCLUDED_PACK_CONVERT_BENCHMARK_H
+
+// End of file
@@ -0,0 +1,320 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PACK_CONVERT_BENCHMARK_INL
+#define GASHA_INCLUDED_PACK_CONVERT_BENCHMARK_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// pack_convert_benchmark.inl
+// パック形式変換ベンチマーク【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/pack_convert_benchmark.h>//パック形式変換ベンチマーク【宣言部】
+
+#include <gasha/random_engine.h>//乱数生成器：xoshiro256pp
+#include <gasha/string.h>//文字列処理：spprintf()
+
+#include <cmath>//std::sqrt()
+#include <cstring>//std::memcmp()
+#include <new>//std::nothrow
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//パック形式変換ベンチマーク
+//--------------------------------------------------------------------------------
+
+namespace packConvertBenchmark
+{
+	//変換の種類名
+	inline const char* convertName(const convert_type convert)
+	{
+		static const char* names[CONVERT_TYPE_NUM] =
+		{
+			"float->half", "half->float",
+			"float->snorm16", "snorm16->float",
+			"float->unorm16", "unorm16->float",
+			"float->unorm8", "unorm8->float",
+			"quat->packed32", "packed32->quat",
+			"quat->packed64", "packed64->quat",
+		};
+		return convert >= 0 && convert < CONVERT_TYPE_NUM ? names[convert] : "?";
+	}
+	//１要素あたりの変換元のバイト数
+	inline std::size_t srcElementSize(const convert_type convert)
+	{
+		static const std::size_t sizes[CONVERT_TYPE_NUM] =
+		{
+			sizeof(float), sizeof(std::uint16_t),
+			sizeof(float), sizeof(std::int16_t),
+			sizeof(float), sizeof(std::uint16_t),
+			sizeof(float), sizeof(std::uint8_t),
+			sizeof(float[4]), sizeof(std::uint32_t),
+			sizeof(float[4]), sizeof(std::uint64_t),
+		};
+		return convert >= 0 && convert < CONVERT_TYPE_NUM ? sizes[convert] : 0;
+	}
+	//１要素あたりの変換先のバイト数
+	inline std::size_t dstElementSize(const convert_type convert)
+	{
+		static const std::size_t sizes[CONVERT_TYPE_NUM] =
+		{
+			sizeof(std::uint16_t), sizeof(float),
+			sizeof(std::int16_t), sizeof(float),
+			sizeof(std::uint16_t), sizeof(float),
+			sizeof(std::uint8_t), sizeof(float),
+			sizeof(std::uint32_t), sizeof(float[4]),
+			sizeof(std::uint64_t), sizeof(float[4]),
+		};
+		return convert >= 0 && convert < CONVERT_TYPE_NUM ? sizes[convert] : 0;
+	}
+	//変換方法名
+	inline const char* methodName(const method_type method)
+	{
+		static const char* names[METHOD_TYPE_NUM] = { "scalar", "batch" };
+		return method >= 0 && method < METHOD_TYPE_NUM ? names[method] : "?";
+	}
+
+	//計測条件：コンストラクタ
+	inline condition::condition() :
+		m_sizeMin(1000),
+		m_sizeMax(1000000),
+		m_repeatElementNum(10000000),
+		m_repeatNum(3)
+	{}
+
+	//ベンチマーク定義
+	//表のタイトル
+	inline void definition::writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "[ Pack convert benchmark (size=%llu-%llu) ]\n", static_cast<unsigned long long>(cond.m_sizeMin), static_cast<unsigned long long>(cond.m_sizeMax));
+	}
+	//表形式
+	inline void definition::writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%-16s %-6s %10s %10s %10s %8s %8s %s\n", "convert", "method", "size", "ns/elem", "Melem/s", "GB/s", "speed-up", "result");
+	}
+	inline void definition::writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result)
+	{
+		const double m_elements_per_sec = result.m_nsPerElement > 0. ? 1000. / result.m_nsPerElement : 0.;
+		GASHA_ spprintf(message, max_size, message_len, "%-16s %-6s %10llu %10.3lf %10.1lf %8.2lf %7.2lfx %s\n", convertName(result.m_convert), methodName(result.m_method), static_cast<unsigned long long>(result.m_size), result.m_nsPerElement, m_elements_per_sec, result.m_gBytesPerSec, result.m_speedUp, result.m_isOk ? "[OK]" : "[NG]");
+	}
+	//CSV形式
+	inline void definition::writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "convert,method,size,src_bytes,dst_bytes,ns_per_element,gbytes_per_sec,speed_up,ok\n");
+	}
+	inline void definition::writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%s,%s,%llu,%llu,%llu,%.3lf,%.3lf,%.3lf,%d\n", convertName(result.m_convert), methodName(result.m_method), static_cast<unsigned long long>(result.m_size), static_cast<unsigned long long>(srcElementSize(result.m_convert)), static_cast<unsigned long long>(dstElementSize(result.m_convert)), result.m_nsPerElement, result.m_gBytesPerSec, result.m_speedUp, result.m_isOk ? 1 : 0);
+	}
+	//全ての組み合わせを計測
+	template<class FUNCTOR>
+	inline bool definition::testAll(const condition_type& cond, FUNCTOR functor)
+	{
+		return packConvertBenchmarkTestAll(cond, functor);
+	}
+}//namespace packConvertBenchmark
+
+namespace _private
+{
+	//----------------------------------------
+	//入力データ作成用：指定範囲の一様乱数
+	inline float packConvertBenchmarkRandom(GASHA_ xoshiro256pp& rnd, const float min, const float max)
+	{
+		return min + rnd.nextFloat() * (max - min);
+	}
+	//入力データ作成用：正規化されたクォータニオン
+	inline void packConvertBenchmarkRandomQuaternion(GASHA_ xoshiro256pp& rnd, float (&q)[4])
+	{
+		float len_sq = 0.f;
+		for (int i = 0; i < 4; ++i)
+		{
+			q[i] = packConvertBenchmarkRandom(rnd, -1.f, 1.f);
+			len_sq += q[i] * q[i];
+		}
+		if (len_sq < 0.000001f)
+		{
+			q[0] = q[1] = q[2] = 0.f;
+			q[3] = 1.f;
+			return;
+		}
+		const float len_rcp = 1.f / std::sqrt(len_sq);
+		for (int i = 0; i < 4; ++i)
+			q[i] *= len_rcp;
+	}
+
+	//----------------------------------------
+	//入力データを作成
+	inline void packConvertBenchmarkMakeInput(const packConvertBenchmark::convert_type convert, char* src, const std::size_t size)
+	{
+		GASHA_ xoshiro256pp rnd(packConvertBenchmark::SEED);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			float q[4];
+			switch (convert)
+			{
+			case packConvertBenchmark::convertFloatToHalf: reinterpret_cast<float*>(src)[i] = packConvertBenchmarkRandom(rnd, -1000.f, 1000.f); break;
+			case packConvertBenchmark::convertHalfToFloat: reinterpret_cast<std::uint16_t*>(src)[i] = GASHA_ floatToHalf(packConvertBenchmarkRandom(rnd, -1000.f, 1000.f)); break;
+			case packConvertBenchmark::convertFloatToSnorm16: reinterpret_cast<float*>(src)[i] = packConvertBenchmarkRandom(rnd, -1.2f, 1.2f); break;
+			case packConvertBenchmark::convertSnorm16ToFloat: reinterpret_cast<std::int16_t*>(src)[i] = GASHA_ floatToSnorm16(packConvertBenchmarkRandom(rnd, -1.2f, 1.2f)); break;
+			case packConvertBenchmark::convertFloatToUnorm16: reinterpret_cast<float*>(src)[i] = packConvertBenchmarkRandom(rnd, -0.2f, 1.2f); break;
+			case packConvertBenchmark::convertUnorm16ToFloat: reinterpret_cast<std::uint16_t*>(src)[i] = GASHA_ floatToUnorm16(packConvertBenchmarkRandom(rnd, -0.2f, 1.2f)); break;
+			case packConvertBenchmark::convertFloatToUnorm8: reinterpret_cast<float*>(src)[i] = packConvertBenchmarkRandom(rnd, -0.2f, 1.2f); break;
+			case packConvertBenchmark::convertUnorm8ToFloat: reinterpret_cast<std::uint8_t*>(src)[i] = GASHA_ floatToUnorm8(packConvertBenchmarkRandom(rnd, -0.2f, 1.2f)); break;
+			case packConvertBenchmark::convertPackQuaternion32:
+			case packConvertBenchmark::convertPackQuaternion64: packConvertBenchmarkRandomQuaternion(rnd, reinterpret_cast<float (*)[4]>(src)[i]); break;
+			case packConvertBenchmark::convertUnpackQuaternion32: packConvertBenchmarkRandomQuaternion(rnd, q); reinterpret_cast<std::uint32_t*>(src)[i] = GASHA_ packQuaternion32(q); break;
+			case packConvertBenchmark::convertUnpackQuaternion64: packConvertBenchmarkRandomQuaternion(rnd, q); reinterpret_cast<std::uint64_t*>(src)[i] = GASHA_ packQuaternion64(q); break;
+			}
+		}
+	}
+
+	//----------------------------------------
+	//変換
+	//※変換関数をテンプレート引数で受け取り、スカラー版のループでも確実にインライン展開させる
+	//※スカラー値の変換
+	template<typename SRC, typename DST, DST (*SCALAR)(const SRC), void (*BATCH)(const SRC*, DST*, const std::size_t)>
+	inline void packConvertBenchmarkConvert(const char* src, char* dst, const std::size_t size, const bool is_batch)
+	{
+		const SRC* s = reinterpret_cast<const SRC*>(src);
+		DST* d = reinterpret_cast<DST*>(dst);
+		if (is_batch)
+			BATCH(s, d, size);
+		else
+		{
+			for (std::size_t i = 0; i < size; ++i)
+				d[i] = SCALAR(s[i]);
+		}
+	}
+	//※クォータニオンの圧縮
+	template<typename PACKED, PACKED (*PACK)(const float (&)[4]), void (*PACK_BATCH)(const float (*)[4], PACKED*, const std::size_t)>
+	inline void packConvertBenchmarkPackQuaternion(const char* src, char* dst, const std::size_t size, const bool is_batch)
+	{
+		const float (*s)[4] = reinterpret_cast<const float (*)[4]>(src);
+		PACKED* d = reinterpret_cast<PACKED*>(dst);
+		if (is_batch)
+			PACK_BATCH(s, d, size);
+		else
+		{
+			for (std::size_t i = 0; i < size; ++i)
+				d[i] = PACK(s[i]);
+		}
+	}
+	//※クォータニオンの復元
+	template<typename PACKED, void (*UNPACK)(float (&)[4], const PACKED), void (*UNPACK_BATCH)(const PACKED*, float (*)[4], const std::size_t)>
+	inline void packConvertBenchmarkUnpackQuaternion(const char* src, char* dst, const std::size_t size, const bool is_batch)
+	{
+		const PACKED* s = reinterpret_cast<const PACKED*>(src);
+		float (*d)[4] = reinterpret_cast<float (*)[4]>(dst);
+		if (is_batch)
+			UNPACK_BATCH(s, d, size);
+		else
+		{
+			for (std::size_t i = 0; i < size; ++i)
+				UNPACK(d[i], s[i]);
+		}
+	}
+	inline void packConvertBenchmarkRun(const packConvertBenchmark::convert_type convert, const packConvertBenchmark::method_type method, const char* src, char* dst, const std::size_t size)
+	{
+		const bool is_batch = method == packConvertBenchmark::methodBatch;
+		switch (convert)
+		{
+		case packConvertBenchmark::convertFloatToHalf: packConvertBenchmarkConvert<float, std::uint16_t, GASHA_ floatToHalf, GASHA_ floatToHalfBatch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertHalfToFloat: packConvertBenchmarkConvert<std::uint16_t, float, GASHA_ halfToFloat, GASHA_ halfToFloatBatch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertFloatToSnorm16: packConvertBenchmarkConvert<float, std::int16_t, GASHA_ floatToSnorm16, GASHA_ floatToSnorm16Batch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertSnorm16ToFloat: packConvertBenchmarkConvert<std::int16_t, float, GASHA_ snorm16ToFloat, GASHA_ snorm16ToFloatBatch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertFloatToUnorm16: packConvertBenchmarkConvert<float, std::uint16_t, GASHA_ floatToUnorm16, GASHA_ floatToUnorm16Batch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertUnorm16ToFloat: packConvertBenchmarkConvert<std::uint16_t, float, GASHA_ unorm16ToFloat, GASHA_ unorm16ToFloatBatch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertFloatToUnorm8: packConvertBenchmarkConvert<float, std::uint8_t, GASHA_ floatToUnorm8, GASHA_ floatToUnorm8Batch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertUnorm8ToFloat: packConvertBenchmarkConvert<std::uint8_t, float, GASHA_ unorm8ToFloat, GASHA_ unorm8ToFloatBatch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertPackQuaternion32: packConvertBenchmarkPackQuaternion<std::uint32_t, GASHA_ packQuaternion32, GASHA_ packQuaternion32Batch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertUnpackQuaternion32: packConvertBenchmarkUnpackQuaternion<std::uint32_t, GASHA_ unpackQuaternion32, GASHA_ unpackQuaternion32Batch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertPackQuaternion64: packConvertBenchmarkPackQuaternion<std::uint64_t, GASHA_ packQuaternion64, GASHA_ packQuaternion64Batch>(src, dst, size, is_batch); break;
+		case packConvertBenchmark::convertUnpackQuaternion64: packConvertBenchmarkUnpackQuaternion<std::uint64_t, GASHA_ unpackQuaternion64, GASHA_ unpackQuaternion64Batch>(src, dst, size, is_batch); break;
+		}
+	}
+}//namespace _private
+
+//----------------------------------------
+//変換の種類と件数を指定して、全ての変換方法を計測
+template<class FUNCTOR>
+bool packConvertBenchmarkTest(const packConvertBenchmark::convert_type convert, const std::size_t size, const packConvertBenchmark::condition& cond, FUNCTOR functor)
+{
+	if (size == 0)
+		return true;
+	const std::size_t src_size = packConvertBenchmark::srcElementSize(convert);
+	const std::size_t dst_size = packConvertBenchmark::dstElementSize(convert);
+	if (src_size == 0 || dst_size == 0)
+		return false;
+	char* src = new(std::nothrow) char[src_size * size];
+	char* ref_dst = new(std::nothrow) char[dst_size * size];
+	char* dst = new(std::nothrow) char[dst_size * size];
+	bool is_ok = src && ref_dst && dst;
+	if (is_ok)
+	{
+		_private::packConvertBenchmarkMakeInput(convert, src, size);
+		_private::packConvertBenchmarkRun(convert, packConvertBenchmark::methodScalar, src, ref_dst, size);//検証用の結果
+		const std::size_t batch_num = GASHA_ benchmarkBatchNum(size, cond.m_repeatElementNum);
+		double scalar_elapsed = 0.;
+		for (int method_no = 0; method_no < packConvertBenchmark::METHOD_TYPE_NUM; ++method_no)
+		{
+			const packConvertBenchmark::method_type method = static_cast<packConvertBenchmark::method_type>(method_no);
+			packConvertBenchmark::result result = { convert, method, size, 0., 0., 0., true };
+			//検証
+			std::memset(dst, 0, dst_size * size);
+			_private::packConvertBenchmarkRun(convert, method, src, dst, size);
+			result.m_isOk = std::memcmp(ref_dst, dst, dst_size * size) == 0;
+			//計測
+			const double elapsed_min = GASHA_ benchmarkElapsedMin(cond.m_repeatNum, batch_num, [&](const std::size_t)
+				{
+					_private::packConvertBenchmarkRun(convert, method, src, dst, size);
+				});
+			if (method == packConvertBenchmark::methodScalar)
+				scalar_elapsed = elapsed_min;
+			const double element_num = static_cast<double>(size) * static_cast<double>(batch_num);
+			result.m_nsPerElement = elapsed_min * 1000000000. / element_num;
+			result.m_gBytesPerSec = elapsed_min > 0. ? element_num * static_cast<double>(src_size + dst_size) / elapsed_min / 1000000000. : 0.;
+			result.m_speedUp = elapsed_min > 0. ? scalar_elapsed / elapsed_min : 0.;
+			functor(result);
+			is_ok &= result.m_isOk;
+		}
+	}
+	delete[] src;
+	delete[] ref_dst;
+	delete[] dst;
+	return is_ok;
+}
+
+//----------------------------------------
+//条件の全ての組み合わせを計測
+template<class FUNCTOR>
+bool packConvertBenchmarkTestAll(const packConvertBenchmark::condition& cond, FUNCTOR functor)
+{
+	bool is_ok = true;
+	for (std::size_t size = cond.m_sizeMin; size > 0 && size <= cond.m_sizeMax; size *= 10)
+	{
+		for (int convert = 0; convert < packConvertBenchmark::CONVERT_TYPE_NUM; ++convert)
+			is_ok &= packConvertBenchmarkTest(static_cast<packConvertBenchmark::convert_type>(convert), size, cond, functor);
+	}
+	return is_ok;
+}
+
+//----------------------------------------
+//全ての組み合わせを計測し、表とCSVを作成
+inline bool packConvertBenchmarkReport(char* table_message, const std::size_t table_max_size, std::size_t& table_message_len, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const packConvertBenchmark::condition& cond)
+{
+	return GASHA_ benchmarkReport<packConvertBenchmark::definition>(table_message, table_max_size, table_message_len, csv_message, csv_max_size, csv_message_len, cond);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_PACK_CONVERT_BENCHMARK_INL
+
+// End of file
@@ -0,0 +1,76 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PARALLEL_INTRO_SORT_H
+#define GASHA_INCLUDED_PARALLEL_INTRO_SORT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// parallel_intro_sort.h
+// 並列イントロソート【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/sort_basic.h>//ソート処理基本
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズムの説明
+//========================================
+
+//・計算時間：
+//    - O(n)       ... データ件数分の時間
+//    - O(n ^ 2)   ... データ件数の２乗分の時間
+//    - O(log n)   ... log2(データ件数)分の時間（4→2, 16→4, 1024→10,1048576→20）
+//    - O(n log n) ... n×log n 分の時間
+//・メモリ使用量：
+//    - O(1)       ... １件分のメモリが必要
+//    - O(n)       ... データ件数分のメモリが必要
+//    - O(log n)   ... log2(データ件数)分のメモリが必要
+//・安定性：
+//    - ○         ... キーが同じデータの順序性が維持されることを保証する
+//                     例：{ 3-a, 5-b, 4-c, 5-d, 9-e, 3-f, 4-g, 3-h, 5-i } → { 3-a, 3-f, 3-h, 4-c, 4-g, 5-b, 5-d, 5-i, 9-e }
+//    - ×         ... 例：(同上)                        
+
+//========================================
+//ソートアルゴリズム分類：混成ソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：並列イントロソート
+//----------------------------------------
+//・最良計算時間：O(n log n)／並列処理数
+//・平均計算時間：O(n log n)／並列処理数
+//・最悪計算時間：O(n log n)
+//・メモリ使用量：O(log n)×並列処理分
+//・安定性：　　　×
+//----------------------------------------
+//※OpenMPのタスクを使用し、並列化で最適化する。
+//　（OpenMPが無効な環境では、逐次処理のイントロソートと同じ動作になる）
+//※対象件数が一定数以上の場合、クイックソートの分割処理自体も並列化する。
+//　（配列をブロックに分けて並列に分割し、軸の前後に誤配置された要素を並列に交換する）
+//※分割後の配列をタスクとして並列に再帰する。
+//※対象件数が一定数未満になったら、逐次処理のイントロソートに切り替える。
+//※再帰が一定以上深くなったら、ヒープソートに切り替える。
+//※同じキーが大量にある場合に備え、軸未満の要素がない場合は、
+//　軸と同じキーの要素をまとめて除外する。
+//※軸の値をコピーして使用するため、要素はコピー可能である必要がある。
+//※整列済み判定を最初に一度行うことで最適化する。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value1, const T& value2)//value1 == value2 ならtrueを返す
+template<class T, class PREDICATE>
+std::size_t parallelIntroSort(T* array, const std::size_t size, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_SORT(parallelIntroSort);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/parallel_intro_sort.inl>
+
+#endif//GASHA_INCLUDED_PARALLEL_INTRO_SORT_H
+
+// End of file
@@ -0,0 +1,284 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PARALLEL_INTRO_SORT_INL
+#define GASHA_INCLUDED_PARALLEL_INTRO_SORT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// parallel_intro_sort.inl
+// 並列イントロソート【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/parallel_intro_sort.h>//並列イントロソート【宣言部】
+
+#include <gasha/is_ordered.h>//整列状態確認
+#include <gasha/utility.h>//汎用ユーティリティ（値交換用）
+
+#include <gasha/intro_sort.h>//イントロソート
+#include <gasha/heap_sort.h>//ヒープソート
+
+#ifdef _OPENMP
+#include <omp.h>//omp_get_max_threads()
+#endif//_OPENMP
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズム分類：混成ソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：並列イントロソート
+namespace _private
+{
+	//逐次処理に切り替える件数
+	static const std::size_t PARALLEL_INTRO_SORT_SIZE_THRESHOLD = 8192;
+	//分割処理を並列化する件数
+	static const std::size_t PARALLEL_INTRO_SORT_PARTITION_SIZE_THRESHOLD = 65536;
+	//分割処理の最大ブロック数
+	static const int PARALLEL_INTRO_SORT_PARTITION_BLOCK_MAX = 64;
+
+	//並列処理数を取得
+	inline int parallelIntroSortThreadNum()
+	{
+	#ifdef _OPENMP
+		return omp_get_max_threads();
+	#else//_OPENMP
+		return 1;
+	#endif//_OPENMP
+	}
+
+	//分割（逐次処理版）
+	//※is_left(要素) が true を返す要素を前方に、false を返す要素を後方に集める。
+	//※前方に集めた要素数を left_size に返す。
+	template<class T, class IS_LEFT_FUNC>
+	std::size_t parallelIntroSortPartition(T* array, const std::size_t size, IS_LEFT_FUNC is_left, std::size_t& left_size)
+	{
+		std::size_t swapped_count = 0;
+		T* left = array;
+		T* right = array + size;
+		while (true)
+		{
+			while (left < right && is_left(*left))
+				++left;
+			while (left < right && !is_left(*(right - 1)))
+				--right;
+			if (left >= right)
+				break;
+			--right;
+			GASHA_ swapValues(*left, *right);
+			++swapped_count;
+			++left;
+		}
+		left_size = left - array;
+		return swapped_count;
+	}
+
+	//分割（並列処理版）
+	//※配列をブロックに分けて、各ブロックを並列に分割した後、
+	//　全体の境界位置の前後に誤配置された要素同士を並列に交換する。
+	template<class T, class IS_LEFT_FUNC>
+	std::size_t parallelIntroSortParallelPartition(T* array, const std::size_t size, IS_LEFT_FUNC is_left, std::size_t& left_size, const int thread_num)
+	{
+		static const int BLOCK_MAX = PARALLEL_INTRO_SORT_PARTITION_BLOCK_MAX;
+		const int block_num = thread_num < BLOCK_MAX ? thread_num : BLOCK_MAX;
+		const std::size_t block_size = (size + block_num - 1) / block_num;
+		std::size_t block_left_size[BLOCK_MAX];
+		std::size_t block_swapped_count[BLOCK_MAX];
+		//各ブロックを並列に分割
+		for (int block = 0; block < block_num; ++block)
+		{
+		#pragma omp task shared(block_left_size, block_swapped_count) firstprivate(block)
+			{
+				const std::size_t begin = block_size * block;
+				const std::size_t end = begin + block_size < size ? begin + block_size : size;
+				block_swapped_count[block] = begin < end ? parallelIntroSortPartition(array + begin, end - begin, is_left, block_left_size[block]) : 0;
+				if (begin >= end)
+					block_left_size[block] = 0;
+			}
+		}
+	#pragma omp taskwait
+		//全体の境界位置を算出
+		std::size_t swapped_count = 0;
+		std::size_t mid = 0;
+		for (int block = 0; block < block_num; ++block)
+		{
+			swapped_count += block_swapped_count[block];
+			mid += block_left_size[block];
+		}
+		left_size = mid;
+		//境界位置の前方にある後方要素の範囲と、後方にある前方要素の範囲を収集
+		struct range_t
+		{
+			T* begin;
+			std::size_t size;
+		};
+		range_t right_ranges[BLOCK_MAX];//境界位置の前方にある、後方に移すべき要素の範囲
+		range_t left_ranges[BLOCK_MAX];//境界位置の後方にある、前方に移すべき要素の範囲
+		int right_range_num = 0;
+		int left_range_num = 0;
+		std::size_t misplaced_num = 0;
+		for (int block = 0; block < block_num; ++block)
+		{
+			const std::size_t begin = block_size * block;
+			const std::size_t end = begin + block_size < size ? begin + block_size : size;
+			if (begin >= end)
+				break;
+			const std::size_t pos = begin + block_left_size[block];//ブロック内の境界位置
+			//[pos, end) ∩ [0, mid) ... 後方に移すべき要素
+			if (pos < mid)
+			{
+				const std::size_t range_end = end < mid ? end : mid;
+				right_ranges[right_range_num].begin = array + pos;
+				right_ranges[right_range_num].size = range_end - pos;
+				misplaced_num += range_end - pos;
+				++right_range_num;
+			}
+			//[begin, pos) ∩ [mid, size) ... 前方に移すべき要素
+			if (pos > mid)
+			{
+				const std::size_t range_begin = begin > mid ? begin : mid;
+				left_ranges[left_range_num].begin = array + range_begin;
+				left_ranges[left_range_num].size = pos - range_begin;
+				++left_range_num;
+			}
+		}
+		if (misplaced_num == 0)
+			return swapped_count;
+		//誤配置された要素同士を並列に交換
+		//※両方の範囲の要素数は必ず一致する
+		auto locate = [](const range_t* ranges, std::size_t index, int& range_index, std::size_t& offset)
+		{
+			range_index = 0;
+			while (index >= ranges[range_index].size)
+				index -= ranges[range_index++].size;
+			offset = index;
+		};
+		for (int block = 0; block < block_num; ++block)
+		{
+			const std::size_t begin = misplaced_num * block / block_num;
+			const std::size_t end = misplaced_num * (block + 1) / block_num;
+			if (begin >= end)
+				continue;
+		#pragma omp task shared(right_ranges, left_ranges) firstprivate(begin, end)
+			{
+				int right_index;
+				std::size_t right_offset;
+				int left_index;
+				std::size_t left_offset;
+				locate(right_ranges, begin, right_index, right_offset);
+				locate(left_ranges, begin, left_index, left_offset);
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					GASHA_ swapValues(right_ranges[right_index].begin[right_offset], left_ranges[left_index].begin[left_offset]);
+					if (++right_offset == right_ranges[right_index].size)
+					{
+						++right_index;
+						right_offset = 0;
+					}
+					if (++left_offset == left_ranges[left_index].size)
+					{
+						++left_index;
+						left_offset = 0;
+					}
+				}
+			}
+		}
+	#pragma omp taskwait
+		return swapped_count + misplaced_num;
+	}
+
+	//分割（処理の振り分け）
+	template<class T, class IS_LEFT_FUNC>
+	inline std::size_t parallelIntroSortPartitionAny(T* array, const std::size_t size, IS_LEFT_FUNC is_left, std::size_t& left_size, const int thread_num)
+	{
+		if (thread_num > 1 && size >= PARALLEL_INTRO_SORT_PARTITION_SIZE_THRESHOLD)
+			return parallelIntroSortParallelPartition(array, size, is_left, left_size, thread_num);
+		return parallelIntroSortPartition(array, size, is_left, left_size);
+	}
+
+	//並列イントロソート（再帰処理）
+	template<class T, class PREDICATE>
+	std::size_t parallelIntroSort(T* array, const std::size_t size, const int depth, PREDICATE predicate, const int thread_num)
+	{
+		if (size < PARALLEL_INTRO_SORT_SIZE_THRESHOLD)
+			return GASHA_ _private::introSort(array, size, predicate);//逐次処理のイントロソートに切り替え
+		if (depth == 0)
+			return GASHA_ heapSort(array, size, predicate);//ヒープソートに切り替え
+		//軸を決定
+		//※分割中に要素が移動するため、値をコピーして保持する
+		const T* begin = array;
+		const T* mid = array + (size >> 1);
+		const T* end = array + size - 1;
+		const T pivot =
+			predicate(*begin, *mid) ?
+				predicate(*mid, *end) ?
+					*mid :
+					predicate(*end, *begin) ?
+						*begin :
+						*end :
+				predicate(*end, *mid) ?
+					*mid :
+					predicate(*begin, *end) ?
+						*begin :
+						*end;
+		//軸未満の配列と軸以上の配列に二分
+		std::size_t left_size = 0;
+		std::size_t swapped_count = parallelIntroSortPartitionAny(array, size, [&pivot, &predicate](const T& value) -> bool { return predicate(value, pivot); }, left_size, thread_num);
+		T* right_array = array + left_size;
+		std::size_t right_size = size - left_size;
+		if (left_size == 0)
+		{
+			//軸未満の要素がない場合、軸と同じキーの要素を前方に集めて除外する
+			//※前方の要素は全て軸と同じキーなので、ソート不要
+			std::size_t equal_size = 0;
+			swapped_count += parallelIntroSortPartitionAny(array, size, [&pivot, &predicate](const T& value) -> bool { return !predicate(pivot, value); }, equal_size, thread_num);
+			right_array = array + equal_size;
+			right_size = size - equal_size;
+		}
+		//分割した配列をタスクとして並列に再帰
+		std::size_t left_swapped_count = 0;
+		std::size_t right_swapped_count = 0;
+		if (left_size > 1)
+		{
+		#pragma omp task shared(left_swapped_count) firstprivate(array, left_size, depth, predicate, thread_num)
+			left_swapped_count = parallelIntroSort(array, left_size, depth - 1, predicate, thread_num);
+		}
+		if (right_size > 1)
+			right_swapped_count = parallelIntroSort(right_array, right_size, depth - 1, predicate, thread_num);
+	#pragma omp taskwait
+		return swapped_count + left_swapped_count + right_swapped_count;
+	}
+}//namespace _private
+template<class T, class PREDICATE>
+std::size_t parallelIntroSort(T* array, const std::size_t size, PREDICATE predicate)
+{
+	if (!array || size <= 1)
+		return 0;
+	if (GASHA_ isOrdered(array, size, predicate))
+		return 0;
+	const int thread_num = _private::parallelIntroSortThreadNum();
+	if (thread_num <= 1 || size < _private::PARALLEL_INTRO_SORT_SIZE_THRESHOLD)
+		return _private::introSort(array, size, predicate);//逐次処理のイントロソート
+	int depth_max = 0;//ヒープソートに切り替える再帰の深さ※2×log2(全体サイズ)で計算
+	for (std::size_t size_tmp = size; size_tmp > 1; size_tmp >>= 1, depth_max += 2);
+	std::size_t swapped_count = 0;
+#pragma omp parallel shared(swapped_count)
+	{
+	#pragma omp single
+		swapped_count = _private::parallelIntroSort(array, size, depth_max, predicate, thread_num);
+	}
+	return swapped_count;
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_PARALLEL_INTRO_SORT_INL
+
+// End of file
@@ -0,0 +1,88 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PARALLEL_LSD_RADIX_SORT_H
+#define GASHA_INCLUDED_PARALLEL_LSD_RADIX_SORT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// parallel_lsd_radix_sort.h
+// 並列LSD基数ソート【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/sort_basic.h>//ソート処理基本
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズムの説明
+//========================================
+
+//・計算時間：
+//    - O(n)       ... データ件数分の時間
+//    - O(n ^ 2)   ... データ件数の２乗分の時間
+//    - O(log n)   ... log2(データ件数)分の時間（4→2, 16→4, 1024→10,1048576→20）
+//    - O(n log n) ... n×log n 分の時間
+//・メモリ使用量：
+//    - O(1)       ... １件分のメモリが必要
+//    - O(n)       ... データ件数分のメモリが必要
+//    - O(log n)   ... log2(データ件数)分のメモリが必要
+//・安定性：
+//    - ○         ... キーが同じデータの順序性が維持されることを保証する
+//                     例：{ 3-a, 5-b, 4-c, 5-d, 9-e, 3-f, 4-g, 3-h, 5-i } → { 3-a, 3-f, 3-h, 4-c, 4-g, 5-b, 5-d, 5-i, 9-e }
+//    - ×         ... 例：(同上)                        
+
+//========================================
+//ソートアルゴリズム分類：分布ソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：並列LSD基数ソート
+//----------------------------------------
+//・最良計算時間：O(n*k/d)／並列処理数 ※k=キーの範囲、d=基数(256)
+//・平均計算時間：O(n*k/d)／並列処理数
+//・最悪計算時間：O(n*k/d)／並列処理数
+//・メモリ使用量：O(n) ※作業用配列(n件) + O(256 * キーのバイト数 * 並列処理数) の分布情報 + 書き込み結合バッファ
+//・安定性：　　　○
+//----------------------------------------
+//※OpenMPを使用し、LSD基数ソート（lsdRadixSort）を並列化する。
+//　（OpenMPが無効な環境や、対象件数が少ない場合は、LSD基数ソートに切り替える）
+//※以下の3段階で処理する。
+//　1. 配列をスレッド数分のブロックに分け、ブロックごとの分布を並列に集計。
+//　2. 桁ごとに、全ブロックの分布から分配先の位置を算出（基数→ブロックの順で累積し、安定性を保つ）。
+//　3. ブロックごとに並列に分配。
+//※最初の集計で全ての桁の分布をまとめて集計し、全要素が同じ値の桁の判定と、最初の分配に使用する。
+//　2回目以降の分配では、分配対象の桁の分布のみをブロックごとに再集計する。
+//※分配時は、基数ごとにキャッシュライン（64バイト）単位の書き込み結合バッファに要素を溜めて、
+//　まとめて書き出すことで、キャッシュミスとTLBミスを抑える。
+//　（書き込み結合バッファは、要素型がPOD型の場合のみ使用する）
+//※キー型と作業用配列の扱いは、LSD基数ソートと同じ。
+//----------------------------------------
+//プロトタイプ：
+//・KEY_TYPE GET_KEY_FUNCTOR(const T& value)//オブジェクトを受け取りキーを返す
+//　※GET_KEY_FUNCTOR::key_type にキー型を定義しておく必要あり
+//作業用配列指定版
+//※work_array には size 件以上の配列を指定する。
+template<class T, class GET_KEY_FUNCTOR>
+std::size_t parallelLsdRadixSortWithBuff(T* array, const std::size_t size, T* work_array, GET_KEY_FUNCTOR get_key_functor);
+//アロケータ指定版
+//※作業用配列を allocator.newArray() で確保し、ソート後に deleteArray() で解放する。
+template<class T, class ALLOCATOR, class GET_KEY_FUNCTOR>
+std::size_t parallelLsdRadixSortWithAllocator(T* array, const std::size_t size, ALLOCATOR& allocator, GET_KEY_FUNCTOR get_key_functor);
+//並列LSD基数ソート本体
+//※作業用配列を new で確保する。
+template<class T, class GET_KEY_FUNCTOR>
+std::size_t parallelLsdRadixSort(T* array, const std::size_t size, GET_KEY_FUNCTOR get_key_functor);
+GASHA_OVERLOAD_SET_FOR_DISTRIBUTED_SORT(parallelLsdRadixSort);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/parallel_lsd_radix_sort.inl>
+
+#endif//GASHA_INCLUDED_PARALLEL_LSD_RADIX_SORT_H
+
+// End of file
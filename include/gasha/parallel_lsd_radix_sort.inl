@@ -0,0 +1,300 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PARALLEL_LSD_RADIX_SORT_INL
+#define GASHA_INCLUDED_PARALLEL_LSD_RADIX_SORT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// parallel_lsd_radix_sort.inl
+// 並列LSD基数ソート【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/parallel_lsd_radix_sort.h>//並列LSD基数ソート【宣言部】
+
+#include <gasha/lsd_radix_sort.h>//LSD基数ソート
+#include <gasha/memory.h>//_aligned_malloc(), _aligned_free()
+
+#include <type_traits>//C++11 std::is_pod
+#include <utility>//C++11 std::move
+#include <cstring>//std::memcpy(), std::memset()
+#include <new>//std::nothrow
+
+#ifdef _OPENMP
+#include <omp.h>//omp_get_max_threads()
+#endif//_OPENMP
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズム分類：分布ソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：並列LSD基数ソート
+namespace _private
+{
+	//並列化する件数
+	static const std::size_t PARALLEL_LSD_RADIX_SORT_SIZE_THRESHOLD = 65536;
+	//書き込み結合バッファのサイズ（キャッシュラインサイズ）
+	static const std::size_t PARALLEL_LSD_RADIX_SORT_WC_BUFF_SIZE = 64;
+	//基数
+	static const std::size_t PARALLEL_LSD_RADIX_SORT_RADIX = 256;
+
+	//並列処理数を取得
+	inline int parallelLsdRadixSortThreadNum()
+	{
+	#ifdef _OPENMP
+		return omp_get_max_threads();
+	#else//_OPENMP
+		return 1;
+	#endif//_OPENMP
+	}
+
+	//指定の桁の基数を算出
+	template<typename KEY_TYPE_U>
+	inline std::size_t parallelLsdRadixSortDigit(const KEY_TYPE_U key, const std::size_t column)
+	{
+		return static_cast<std::size_t>((key >> (column << 3)) & 0xff);
+	}
+
+	//分配
+	//※src の [begin, end) の要素を、offsets の位置に従って dst に分配する。
+	//※USE_WC_BUFF が true なら、書き込み結合バッファを使用する。
+	template<class T, class GET_KEY_FUNCTOR, bool USE_WC_BUFF = std::is_pod<T>::value && sizeof(T) * 2 <= PARALLEL_LSD_RADIX_SORT_WC_BUFF_SIZE>
+	struct parallelLsdRadixSortScatter
+	{
+		static const bool IS_USE_WC_BUFF = false;//書き込み結合バッファを使用しない
+		inline static std::size_t exec(T* src, const std::size_t begin, const std::size_t end, T* dst, std::size_t* offsets, const std::size_t column, GET_KEY_FUNCTOR& get_key_functor, char* wc_buff)
+		{
+			typedef lsdRadixKey<typename GET_KEY_FUNCTOR::key_type> radix_key_t;//キー変換型
+			std::size_t swapped_count = 0;
+			for (std::size_t index = begin; index < end; ++index)
+			{
+				T& elem = src[index];
+				const std::size_t dst_index = offsets[parallelLsdRadixSortDigit(radix_key_t::conv(get_key_functor(elem)), column)]++;
+				if (dst_index != index)
+					++swapped_count;
+				dst[dst_index] = std::move(elem);
+			}
+			return swapped_count;
+		}
+	};
+	//※書き込み結合バッファ使用版
+	//　基数ごとにキャッシュライン分の要素を溜めて、まとめて書き出す
+	template<class T, class GET_KEY_FUNCTOR>
+	struct parallelLsdRadixSortScatter<T, GET_KEY_FUNCTOR, true>
+	{
+		static const bool IS_USE_WC_BUFF = true;//書き込み結合バッファを使用する
+		static const std::size_t WC_NUM = PARALLEL_LSD_RADIX_SORT_WC_BUFF_SIZE / sizeof(T);//バッファ当たりの要素数
+		static const std::size_t RADIX = PARALLEL_LSD_RADIX_SORT_RADIX;//基数
+		inline static std::size_t exec(T* src, const std::size_t begin, const std::size_t end, T* dst, std::size_t* offsets, const std::size_t column, GET_KEY_FUNCTOR& get_key_functor, char* wc_buff)
+		{
+			typedef lsdRadixKey<typename GET_KEY_FUNCTOR::key_type> radix_key_t;//キー変換型
+			std::size_t swapped_count = 0;
+			T* wc = reinterpret_cast<T*>(wc_buff);
+			std::size_t fill[RADIX];//基数ごとのバッファ使用数
+			std::memset(fill, 0, sizeof(fill));
+			for (std::size_t index = begin; index < end; ++index)
+			{
+				const T& elem = src[index];
+				const std::size_t digit = parallelLsdRadixSortDigit(radix_key_t::conv(get_key_functor(elem)), column);
+				std::size_t& fill_num = fill[digit];
+				if (offsets[digit] + fill_num != index)
+					++swapped_count;
+				T* wc_digit = wc + digit * WC_NUM;
+				wc_digit[fill_num] = elem;
+				if (++fill_num == WC_NUM)//バッファが一杯になったら書き出し
+				{
+					std::memcpy(dst + offsets[digit], wc_digit, sizeof(T) * WC_NUM);
+					offsets[digit] += WC_NUM;
+					fill_num = 0;
+				}
+			}
+			//残りを書き出し
+			for (std::size_t digit = 0; digit < RADIX; ++digit)
+			{
+				if (fill[digit] > 0)
+				{
+					std::memcpy(dst + offsets[digit], wc + digit * WC_NUM, sizeof(T) * fill[digit]);
+					offsets[digit] += fill[digit];
+				}
+			}
+			return swapped_count;
+		}
+	};
+
+	//並列LSD基数ソート処理
+	template<class T, class GET_KEY_FUNCTOR>
+	std::size_t parallelLsdRadixSort(T* array, const std::size_t size, T* work_array, GET_KEY_FUNCTOR get_key_functor)
+	{
+		typedef typename GET_KEY_FUNCTOR::key_type KEY_TYPE;//キー型
+		typedef lsdRadixKey<KEY_TYPE> radix_key_t;//キー変換型
+		typedef typename radix_key_t::key_type KEY_TYPE_U;//符号なしキー型
+		typedef parallelLsdRadixSortScatter<T, GET_KEY_FUNCTOR> scatter_t;//分配処理型
+
+		static const std::size_t RADIX = PARALLEL_LSD_RADIX_SORT_RADIX;//基数
+		static const std::size_t DIGIT_NUM = sizeof(KEY_TYPE_U);//桁数
+		static const std::size_t WC_BUFF_SIZE = PARALLEL_LSD_RADIX_SORT_WC_BUFF_SIZE;//書き込み結合バッファのサイズ
+
+		const int thread_num = parallelLsdRadixSortThreadNum();
+		if (thread_num <= 1 || size < PARALLEL_LSD_RADIX_SORT_SIZE_THRESHOLD)
+			return GASHA_ _private::lsdRadixSort(array, size, work_array, get_key_functor);//LSD基数ソートに切り替え
+
+		//ブロック情報
+		const int block_num = thread_num;
+		const std::size_t block_size = (size + block_num - 1) / block_num;
+
+		//メモリ確保
+		//※分布情報：ブロック数×桁数×基数
+		//※書き込み結合バッファ：ブロック数×基数×キャッシュラインサイズ
+		std::size_t* histogram = new(std::nothrow) std::size_t[block_num * DIGIT_NUM * RADIX];
+		char* wc_buff = scatter_t::IS_USE_WC_BUFF ? static_cast<char*>(_aligned_malloc(block_num * RADIX * WC_BUFF_SIZE, WC_BUFF_SIZE)) : nullptr;
+		if (!histogram || (scatter_t::IS_USE_WC_BUFF && !wc_buff))//メモリ確保に失敗したらLSD基数ソートに切り替え
+		{
+			if (histogram)
+				delete[] histogram;//メモリ破棄
+			if (wc_buff)
+				_aligned_free(wc_buff);//メモリ破棄
+			return GASHA_ _private::lsdRadixSort(array, size, work_array, get_key_functor);
+		}
+		auto histogramOf = [histogram](const int block, const std::size_t column) -> std::size_t*
+		{
+			return histogram + (static_cast<std::size_t>(block) * DIGIT_NUM + column) * RADIX;
+		};
+
+		//1. ブロックごとに全ての桁の分布を並列に集計
+	#pragma omp parallel for
+		for (int block = 0; block < block_num; ++block)
+		{
+			std::size_t* block_histogram = histogramOf(block, 0);
+			std::memset(block_histogram, 0, sizeof(std::size_t) * DIGIT_NUM * RADIX);
+			const std::size_t begin = block_size * block;
+			const std::size_t end = begin + block_size < size ? begin + block_size : size;
+			for (std::size_t index = begin; index < end; ++index)
+			{
+				const KEY_TYPE_U key = radix_key_t::conv(get_key_functor(array[index]));
+				for (std::size_t column = 0; column < DIGIT_NUM; ++column)
+					++block_histogram[column * RADIX + parallelLsdRadixSortDigit(key, column)];
+			}
+		}
+
+		//下位の桁から順に分配
+		std::size_t swapped_count = 0;
+		T* src = array;
+		T* dst = work_array;
+		bool is_first_pass = true;//最初の分配か？
+		const KEY_TYPE_U first_key = radix_key_t::conv(get_key_functor(*array));
+		for (std::size_t column = 0; column < DIGIT_NUM; ++column)
+		{
+			//全要素が同じ値の桁は処理しない
+			{
+				const std::size_t first_digit = parallelLsdRadixSortDigit(first_key, column);
+				std::size_t count = 0;
+				for (int block = 0; block < block_num; ++block)
+					count += histogramOf(block, column)[first_digit];
+				if (count == size)
+					continue;
+			}
+			//2回目以降の分配では、各ブロックの要素が入れ替わっているため、ブロックごとの分布を並列に再集計
+			if (!is_first_pass)
+			{
+			#pragma omp parallel for
+				for (int block = 0; block < block_num; ++block)
+				{
+					std::size_t* block_histogram = histogramOf(block, column);
+					std::memset(block_histogram, 0, sizeof(std::size_t) * RADIX);
+					const std::size_t begin = block_size * block;
+					const std::size_t end = begin + block_size < size ? begin + block_size : size;
+					for (std::size_t index = begin; index < end; ++index)
+						++block_histogram[parallelLsdRadixSortDigit(radix_key_t::conv(get_key_functor(src[index])), column)];
+				}
+			}
+			//2. 全ブロックの分布から分配先の位置を算出
+			//※基数→ブロックの順に累積して、安定性を保つ
+			std::size_t offset = 0;
+			for (std::size_t digit = 0; digit < RADIX; ++digit)
+			{
+				for (int block = 0; block < block_num; ++block)
+				{
+					std::size_t& block_count = histogramOf(block, column)[digit];
+					const std::size_t count = block_count;
+					block_count = offset;
+					offset += count;
+				}
+			}
+			//3. ブロックごとに並列に分配
+		#pragma omp parallel for reduction(+:swapped_count)
+			for (int block = 0; block < block_num; ++block)
+			{
+				const std::size_t begin = block_size * block;
+				const std::size_t end = begin + block_size < size ? begin + block_size : size;
+				swapped_count += scatter_t::exec(src, begin, end, dst, histogramOf(block, column), column, get_key_functor, wc_buff ? wc_buff + static_cast<std::size_t>(block) * RADIX * WC_BUFF_SIZE : nullptr);
+			}
+			T* tmp = src;
+			src = dst;
+			dst = tmp;
+			is_first_pass = false;
+		}
+
+		//ソート結果が作業用配列にあれば元の配列に戻す
+		if (src != array)
+		{
+			const int size_i = static_cast<int>(size);
+		#pragma omp parallel for
+			for (int index = 0; index < size_i; ++index)
+				array[index] = std::move(src[index]);
+		}
+
+		//メモリ破棄
+		delete[] histogram;
+		if (wc_buff)
+			_aligned_free(wc_buff);
+		return swapped_count;
+	}
+}//namespace _private
+//作業用配列指定版
+template<class T, class GET_KEY_FUNCTOR>
+inline std::size_t parallelLsdRadixSortWithBuff(T* array, const std::size_t size, T* work_array, GET_KEY_FUNCTOR get_key_functor)
+{
+	if (!array || size <= 1 || !work_array)
+		return 0;
+	return _private::parallelLsdRadixSort(array, size, work_array, get_key_functor);
+}
+//アロケータ指定版
+template<class T, class ALLOCATOR, class GET_KEY_FUNCTOR>
+inline std::size_t parallelLsdRadixSortWithAllocator(T* array, const std::size_t size, ALLOCATOR& allocator, GET_KEY_FUNCTOR get_key_functor)
+{
+	if (!array || size <= 1)
+		return 0;
+	T* work_array = allocator.template newArray<T>(size);
+	if (!work_array)//メモリ確保に失敗したら終了
+		return 0;
+	const std::size_t swapped_count = _private::parallelLsdRadixSort(array, size, work_array, get_key_functor);
+	allocator.deleteArray(work_array, size);
+	return swapped_count;
+}
+//並列LSD基数ソート本体
+template<class T, class GET_KEY_FUNCTOR>
+inline std::size_t parallelLsdRadixSort(T* array, const std::size_t size, GET_KEY_FUNCTOR get_key_functor)
+{
+	if (!array || size <= 1)
+		return 0;
+	T* work_array = new T[size];
+	if (!work_array)//メモリ確保に失敗したら終了
+		return 0;
+	const std::size_t swapped_count = _private::parallelLsdRadixSort(array, size, work_array, get_key_functor);
+	delete[] work_array;
+	return swapped_count;
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_PARALLEL_LSD_RADIX_SORT_INL
+
+// End of file
@@ -0,0 +1,77 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PARALLEL_MERGE_SORT_H
+#define GASHA_INCLUDED_PARALLEL_MERGE_SORT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// parallel_merge_sort.h
+// 並列マージソート【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/sort_basic.h>//ソート処理基本
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズムの説明
+//========================================
+
+//・計算時間：
+//    - O(n)       ... データ件数分の時間
+//    - O(n ^ 2)   ... データ件数の２乗分の時間
+//    - O(log n)   ... log2(データ件数)分の時間（4→2, 16→4, 1024→10,1048576→20）
+//    - O(n log n) ... n×log n 分の時間
+//・メモリ使用量：
+//    - O(1)       ... １件分のメモリが必要
+//    - O(n)       ... データ件数分のメモリが必要
+//    - O(log n)   ... log2(データ件数)分のメモリが必要
+//・安定性：
+//    - ○         ... キーが同じデータの順序性が維持されることを保証する
+//                     例：{ 3-a, 5-b, 4-c, 5-d, 9-e, 3-f, 4-g, 3-h, 5-i } → { 3-a, 3-f, 3-h, 4-c, 4-g, 5-b, 5-d, 5-i, 9-e }
+//    - ×         ... 例：(同上)                        
+
+//========================================
+//ソートアルゴリズム分類：マージソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：並列マージソート
+//----------------------------------------
+//・最良計算時間：O(n log n)／並列処理数
+//・平均計算時間：O(n log n)／並列処理数
+//・最悪計算時間：O(n log n)／並列処理数
+//・メモリ使用量：O(n)
+//・安定性：　　　○
+//----------------------------------------
+//※OpenMPを使用し、並列化で最適化する。
+//　（OpenMPが無効な環境では、逐次処理のマージソートとして動作する）
+//※一定件数の小ブロックを挿入ソートで並列に整列した後、ボトムアップでマージする。
+//※マージ処理は、協調ランク（co-ranking）で出力範囲を均等に分割し、
+//　ブロック数が並列処理数より少なくなっても、一つのマージを複数のスレッドで並列に処理する。
+//※作業領域として、データ件数分のメモリを new で確保する。
+//　（多態アロケータ（polyAllocator）の影響を受ける）
+//　作業領域を確保できない場合は、インプレースマージソートに切り替える。
+//※要素はムーブ構築およびムーブ代入が可能である必要がある。
+//※整列済み判定を最初に一度行うことで最適化する。
+//※交換回数として、右ブロックの要素を左ブロックの要素より先に移動した回数を返す。
+//　（インプレースマージソートの挿入回数に相当）
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value1, const T& value2)//value1 == value2 ならtrueを返す
+template<class T, class PREDICATE>
+std::size_t parallelMergeSort(T* array, const std::size_t size, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_SORT(parallelMergeSort);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/parallel_merge_sort.inl>
+
+#endif//GASHA_INCLUDED_PARALLEL_MERGE_SORT_H
+
+// End of file
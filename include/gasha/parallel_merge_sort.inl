@@ -0,0 +1,207 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PARALLEL_MERGE_SORT_INL
+#define GASHA_INCLUDED_PARALLEL_MERGE_SORT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// parallel_merge_sort.inl
+// 並列マージソート【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/parallel_merge_sort.h>//並列マージソート【宣言部】
+
+#include <gasha/is_ordered.h>//整列状態確認
+
+#include <gasha/insertion_sort.h>//挿入ソート
+#include <gasha/inplace_merge_sort.h>//インプレースマージソート
+
+#include <utility>//C++11 std::move
+#include <new>//std::nothrow, 配置new
+
+#ifdef _OPENMP
+#include <omp.h>//omp_get_max_threads()
+#endif//_OPENMP
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズム分類：マージソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：並列マージソート
+namespace _private
+{
+	//最初に挿入ソートで整列するブロックの件数
+	static const std::size_t PARALLEL_MERGE_SORT_RUN_SIZE = 32;
+
+	//並列処理数を取得
+	inline int parallelMergeSortThreadNum()
+	{
+	#ifdef _OPENMP
+		return omp_get_max_threads();
+	#else//_OPENMP
+		return 1;
+	#endif//_OPENMP
+	}
+
+	//協調ランク（co-ranking）
+	//※左右のブロックをマージした結果の先頭 k 件に含まれる、左ブロックの要素数を二分探索で求める。
+	//※キーが同じ要素は左ブロックを優先する（安定性の維持）。
+	template<class T, class PREDICATE>
+	inline std::size_t parallelMergeSortCoRank(const std::size_t k, const T* left, const std::size_t left_size, const T* right, const std::size_t right_size, PREDICATE predicate)
+	{
+		std::size_t low = k > right_size ? k - right_size : 0;
+		std::size_t high = k < left_size ? k : left_size;
+		while (low < high)
+		{
+			const std::size_t i = (low + high) >> 1;
+			const std::size_t j = k - i;
+			if (j > 0 && !predicate(right[j - 1], left[i]))//左ブロックの要素が足りない
+				low = i + 1;
+			else
+				high = i;
+		}
+		return low;
+	}
+
+	//マージ（出力範囲指定）
+	//※マージ結果のうち [out_begin, out_end) の範囲のみを出力する。
+	//※left_begin, left_end には、協調ランクで求めた out_begin, out_end 時点の左ブロックの位置を指定する。
+	//　（範囲外の要素は他のスレッドがムーブするため、比較にも使用しない）
+	//※is_construct が true なら、出力先を（未構築領域として）ムーブ構築、false ならムーブ代入する。
+	template<class T, class PREDICATE>
+	std::size_t parallelMergeSortMerge(T* dst, T* left, const std::size_t left_size, T* right, const std::size_t out_begin, const std::size_t out_end, const std::size_t left_begin, const std::size_t left_end, PREDICATE predicate, const bool is_construct)
+	{
+		std::size_t swapped_count = 0;
+		std::size_t i = left_begin;
+		std::size_t j = out_begin - left_begin;
+		const std::size_t right_end = out_end - left_end;
+		for (std::size_t k = out_begin; k < out_end; ++k)
+		{
+			T* src;
+			if (j < right_end && (i >= left_end || predicate(right[j], left[i])))
+			{
+				src = &right[j++];
+				if (i < left_size)
+					++swapped_count;//右ブロックの要素を左ブロックの要素より先に移動
+			}
+			else
+				src = &left[i++];
+			if (is_construct)
+				new(&dst[k]) T(std::move(*src));
+			else
+				dst[k] = std::move(*src);
+		}
+		return swapped_count;
+	}
+}//namespace _private
+template<class T, class PREDICATE>
+std::size_t parallelMergeSort(T* array, const std::size_t size, PREDICATE predicate)
+{
+	if (!array || size <= 1)
+		return 0;
+	if (GASHA_ isOrdered(array, size, predicate))
+		return 0;
+	static const std::size_t RUN_SIZE = _private::PARALLEL_MERGE_SORT_RUN_SIZE;
+	std::size_t swapped_count = 0;
+	//小ブロックを挿入ソートで並列に整列
+	const int run_num = static_cast<int>((size + RUN_SIZE - 1) / RUN_SIZE);
+#pragma omp parallel for reduction(+:swapped_count)
+	for (int run = 0; run < run_num; ++run)
+	{
+		const std::size_t begin = RUN_SIZE * run;
+		const std::size_t run_size = begin + RUN_SIZE < size ? RUN_SIZE : size - begin;
+		swapped_count += GASHA_ insertionSort(array + begin, run_size, predicate);
+	}
+	if (run_num <= 1)
+		return swapped_count;
+	//作業領域を確保
+	char* work_buff = new(std::nothrow) char[sizeof(T) * size];
+	if (!work_buff)
+		return swapped_count + GASHA_ inplaceMergeSort(array, size, predicate);//インプレースマージソートに切り替え
+	T* work = reinterpret_cast<T*>(work_buff);
+	//ボトムアップでマージ
+	//※配列と作業領域を交互に入れ替えながらマージする
+	const int thread_num = _private::parallelMergeSortThreadNum();
+	//協調ランクの計算結果
+	//※マージ処理中は他のスレッドが要素をムーブするため、協調ランクは事前に全て求めておく
+	//※分割するのはマージ数が並列処理数より少ない時のみなので、分割数は並列処理数の2倍未満に収まる
+	const std::size_t co_rank_num = static_cast<std::size_t>(thread_num) * 2;
+	std::size_t* co_ranks = thread_num > 1 ? new(std::nothrow) std::size_t[co_rank_num] : nullptr;
+	T* src = array;
+	T* dst = work;
+	bool is_construct = true;//初回は作業領域が未構築
+	for (std::size_t block_size = RUN_SIZE; block_size < size; block_size <<= 1)
+	{
+		const std::size_t merge_size = block_size << 1;
+		const std::size_t pair_num = (size + merge_size - 1) / merge_size;
+		//マージ数が並列処理数より少ない場合、一つのマージを協調ランクで分割して並列に処理する
+		const std::size_t part_num = pair_num >= static_cast<std::size_t>(thread_num) || !co_ranks ? 1 : (thread_num + pair_num - 1) / pair_num;
+		const int task_num = static_cast<int>(pair_num * part_num);
+		auto task_range = [&](const int task, std::size_t& left_begin, std::size_t& left_size, std::size_t& right_size, std::size_t& out_begin, std::size_t& out_end)
+		{
+			const std::size_t pair = static_cast<std::size_t>(task) / part_num;
+			const std::size_t part = static_cast<std::size_t>(task) % part_num;
+			left_begin = pair * merge_size;
+			left_size = left_begin + block_size < size ? block_size : size - left_begin;
+			const std::size_t right_begin = left_begin + left_size;
+			right_size = right_begin + block_size < size ? block_size : size - right_begin;
+			const std::size_t total_size = left_size + right_size;
+			out_begin = total_size * part / part_num;
+			out_end = total_size * (part + 1) / part_num;
+		};
+		if (part_num > 1)
+		{
+		#pragma omp parallel for
+			for (int task = 0; task < task_num; ++task)
+			{
+				std::size_t left_begin, left_size, right_size, out_begin, out_end;
+				task_range(task, left_begin, left_size, right_size, out_begin, out_end);
+				co_ranks[task] = _private::parallelMergeSortCoRank(out_begin, src + left_begin, left_size, src + left_begin + left_size, right_size, predicate);
+			}
+		}
+	#pragma omp parallel for reduction(+:swapped_count)
+		for (int task = 0; task < task_num; ++task)
+		{
+			std::size_t left_begin, left_size, right_size, out_begin, out_end;
+			task_range(task, left_begin, left_size, right_size, out_begin, out_end);
+			const std::size_t part = static_cast<std::size_t>(task) % part_num;
+			const std::size_t co_rank_begin = part_num > 1 ? co_ranks[task] : 0;
+			const std::size_t co_rank_end = part + 1 < part_num ? co_ranks[task + 1] : left_size;
+			swapped_count += _private::parallelMergeSortMerge(dst + left_begin, src + left_begin, left_size, src + left_begin + left_size, out_begin, out_end, co_rank_begin, co_rank_end, predicate, is_construct);
+		}
+		is_construct = false;
+		T* tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+	//マージ結果が作業領域にあれば配列に戻す
+	const int size_i = static_cast<int>(size);
+	if (src == work)
+	{
+	#pragma omp parallel for
+		for (int i = 0; i < size_i; ++i)
+			array[i] = std::move(work[i]);
+	}
+	//作業領域を破棄
+	for (int i = 0; i < size_i; ++i)
+		work[i].~T();
+	delete[] work_buff;
+	if (co_ranks)
+		delete[] co_ranks;
+	return swapped_count;
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_PARALLEL_MERGE_SORT_INL
+
+// End of file
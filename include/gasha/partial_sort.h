@@ -0,0 +1,75 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PARTIAL_SORT_H
+#define GASHA_INCLUDED_PARTIAL_SORT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// partial_sort.h
+// 部分ソート【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/sort_basic.h>//ソート処理基本
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズムの説明
+//========================================
+
+//・計算時間：
+//    - O(n)       ... データ件数分の時間
+//    - O(n ^ 2)   ... データ件数の２乗分の時間
+//    - O(log n)   ... log2(データ件数)分の時間（4→2, 16→4, 1024→10,1048576→20）
+//    - O(n log n) ... n×log n 分の時間
+//・メモリ使用量：
+//    - O(1)       ... １件分のメモリが必要
+//    - O(n)       ... データ件数分のメモリが必要
+//    - O(log n)   ... log2(データ件数)分のメモリが必要
+//・安定性：
+//    - ○         ... キーが同じデータの順序性が維持されることを保証する
+//                     例：{ 3-a, 5-b, 4-c, 5-d, 9-e, 3-f, 4-g, 3-h, 5-i } → { 3-a, 3-f, 3-h, 4-c, 4-g, 5-b, 5-d, 5-i, 9-e }
+//    - ×         ... 例：(同上)                        
+
+//========================================
+//ソートアルゴリズム分類：選択アルゴリズム
+//========================================
+
+//----------------------------------------
+//アルゴリズム：部分ソート
+//----------------------------------------
+//・最良計算時間：O(n log k) ※k=整列する件数
+//・平均計算時間：O(n log k)
+//・最悪計算時間：O(n log k)
+//・メモリ使用量：O(1)
+//・安定性：　　　×
+//----------------------------------------
+//※配列の先頭 sorted_size 件に、全体を整列した時の先頭 sorted_size 件を整列して置く。
+//　残りの要素の並び順は不定。
+//※std::partial_sort() と同様の処理。
+//※sorted_size が小さい場合は、先頭 sorted_size 件で最大ヒープを作り、残りの要素のうち
+//　ヒープの根より小さいものと入れ替えながら選択（ヒープ選択）した後、ヒープソートで整列する。
+//　sorted_size が大きい場合は、nthElement() で先頭 sorted_size 件を選択した後、
+//　パターン打破クイックソート（pdqSort）で整列する。
+//※sorted_size が size 以上の場合は、全体を整列する。
+//※ランキングの上位 n 件の取得などに使用する。
+//　データを配列に貯めずに逐次的に上位 n 件を取得したい場合は、topK を使用すると良い。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value1, const T& value2)//value1 == value2 ならtrueを返す
+template<class T, class PREDICATE>
+std::size_t partialSort(T* array, const std::size_t size, const std::size_t sorted_size, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_SELECTION(partialSort);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/partial_sort.inl>
+
+#endif//GASHA_INCLUDED_PARTIAL_SORT_H
+
+// End of file
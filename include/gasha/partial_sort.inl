@@ -0,0 +1,70 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PARTIAL_SORT_INL
+#define GASHA_INCLUDED_PARTIAL_SORT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// partial_sort.inl
+// 部分ソート【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/partial_sort.h>//部分ソート【宣言部】
+
+#include <gasha/utility.h>//汎用ユーティリティ（値交換用）
+
+#include <gasha/nth_element.h>//n番目の要素の選択
+#include <gasha/pdq_sort.h>//パターン打破クイックソート
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズム分類：選択アルゴリズム
+//========================================
+
+//----------------------------------------
+//アルゴリズム：部分ソート
+namespace _private
+{
+	//ヒープ選択に切り替える整列件数の割合
+	//※sorted_size が (size / PARTIAL_SORT_HEAP_SELECT_RATIO) 以下ならヒープ選択を使用する
+	static const std::size_t PARTIAL_SORT_HEAP_SELECT_RATIO = 16;
+}//namespace _private
+template<class T, class PREDICATE>
+std::size_t partialSort(T* array, const std::size_t size, const std::size_t sorted_size, PREDICATE predicate)
+{
+	if (!array || size <= 1 || sorted_size == 0)
+		return 0;
+	if (sorted_size >= size)
+		return GASHA_ pdqSort(array, size, predicate);
+	std::size_t swapped_count = 0;
+	if (sorted_size <= size / _private::PARTIAL_SORT_HEAP_SELECT_RATIO)
+	{
+		//ヒープ選択
+		_private::selectionHeapSelect(array, array + sorted_size, array + size, predicate, swapped_count);
+		//ヒープソート
+		for (std::size_t heap_size = sorted_size - 1; heap_size > 0; --heap_size)
+		{
+			GASHA_ swapValues(array[0], array[heap_size]);
+			++swapped_count;
+			_private::selectionDownHeap(array, heap_size, 0, predicate, swapped_count);
+		}
+		return swapped_count;
+	}
+	//n番目の要素の選択＋パターン打破クイックソート
+	swapped_count += GASHA_ nthElement(array, size, sorted_size - 1, predicate);
+	swapped_count += GASHA_ pdqSort(array, sorted_size - 1, predicate);//sorted_size - 1 番目は確定済み
+	return swapped_count;
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_PARTIAL_SORT_INL
+
+// End of file
@@ -0,0 +1,103 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PDQ_SORT_H
+#define GASHA_INCLUDED_PDQ_SORT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// pdq_sort.h
+// パターン打破クイックソート【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/sort_basic.h>//ソート処理基本
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズムの説明
+//========================================
+
+//・計算時間：
+//    - O(n)       ... データ件数分の時間
+//    - O(n ^ 2)   ... データ件数の２乗分の時間
+//    - O(log n)   ... log2(データ件数)分の時間（4→2, 16→4, 1024→10,1048576→20）
+//    - O(n log n) ... n×log n 分の時間
+//・メモリ使用量：
+//    - O(1)       ... １件分のメモリが必要
+//    - O(n)       ... データ件数分のメモリが必要
+//    - O(log n)   ... log2(データ件数)分のメモリが必要
+//・安定性：
+//    - ○         ... キーが同じデータの順序性が維持されることを保証する
+//                     例：{ 3-a, 5-b, 4-c, 5-d, 9-e, 3-f, 4-g, 3-h, 5-i } → { 3-a, 3-f, 3-h, 4-c, 4-g, 5-b, 5-d, 5-i, 9-e }
+//    - ×         ... 例：(同上)                        
+
+//========================================
+//ソートアルゴリズム分類：混成ソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：パターン打破クイックソート（pdqsort）
+//----------------------------------------
+//・最良計算時間：O(n) ※整列済み／逆順の配列
+//・平均計算時間：O(n log n)
+//・最悪計算時間：O(n log n)
+//・メモリ使用量：O(log n) ※ブロック分割用のオフセットバッファ（64*2 バイト）を除く
+//・安定性：　　　×
+//----------------------------------------
+//※イントロソートの改良版。クイックソートを基本に、以下の手法を組み合わせる。
+//　- 軸の選択：件数が多い時は９点の中央値（ninther）、少ない時は３点の中央値を使用する。
+//　- ブロック分割：要素型が算術型で、プレディケート関数が less<T> または std::less<T> の場合、
+//　　64件単位のブロックで比較結果をオフセットバッファに記録し、分岐を伴わずに分割する。
+//　- 同値キーの分割：軸が直前の分割の軸と等しい場合、軸と等しい要素をまとめて左側に寄せ、
+//　　以降の処理対象から除外する。（同値キーが多い配列で O(n) に近づく）
+//　- 整列済み区間の検出：分割時に交換が発生しなかった場合、移動回数を制限した挿入ソートを試み、
+//　　成功したらその区間の処理を終える。
+//　- パターン打破：分割が大きく偏った場合、要素を入れ替えて軸の選択パターンを崩す。
+//　　偏った分割が log n 回に達したら、ヒープソートに切り替えて最悪計算時間を保証する。
+//※整列済み判定を最初に一度行うことで最適化する。
+//　また、逆順に整列済みの配列は、反転するだけで処理を終える。
+//※（再帰の末）対象件数が一定数（24件）未満になったら挿入ソートに切り替える。
+//　要素型が std::int32_t, std::uint32_t, float で、プレディケート関数が less<T> または std::less<T> の場合、
+//　AVX2が有効なら、64件未満になったときにSIMD小規模ソート（ソーティングネットワーク）に切り替える。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value1, const T& value2)//value1 == value2 ならtrueを返す
+template<class T, class PREDICATE>
+inline std::size_t pdqSort(T* array, const std::size_t size, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_SORT(pdqSort);
+
+//----------------------------------------
+//アルゴリズム：パターン打破クイックソート（pdqsort）
+//※イテレータ対応版
+//----------------------------------------
+//・最良計算時間：O(n) ※整列済み／逆順の配列
+//・平均計算時間：O(n log n)
+//・最悪計算時間：O(n log n) ※偏った分割が続いた場合はシェルソートに切り替える
+//・メモリ使用量：O(log n)
+//・安定性：　　　×
+//----------------------------------------
+//※ランダムアクセスイテレータが必要。
+//※ポインタ版と同じく、軸の選択（ninther／３点の中央値）、同値キーの分割、
+//　整列済み区間の検出、パターン打破を行う。
+//※ブロック分割とSIMD小規模ソートは使用せず、通常の分割（Hoare分割）と挿入ソートで処理する。
+//※偏った分割が log n 回に達した場合は、イントロソート（イテレータ対応版）と同様に、
+//　シェルソートに切り替える。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const typename ITERATOR::value_type& value1, const typename ITERATOR::value_type& value2)//value1 == value2 ならtrueを返す
+template<class ITERATOR, class PREDICATE>
+inline std::size_t iteratorPdqSort(ITERATOR begin, ITERATOR end, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_ITERATOR_SORT(iteratorPdqSort);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/pdq_sort.inl>
+
+#endif//GASHA_INCLUDED_PDQ_SORT_H
+
+// End of file
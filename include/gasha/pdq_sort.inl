@@ -0,0 +1,774 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_PDQ_SORT_INL
+#define GASHA_INCLUDED_PDQ_SORT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// pdq_sort.inl
+// パターン打破クイックソート【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/pdq_sort.h>//パターン打破クイックソート【宣言部】
+
+#include <gasha/is_ordered.h>//整列状態確認
+#include <gasha/utility.h>//汎用ユーティリティ（値交換用）
+
+#include <gasha/shell_sort.h>//シェルソート
+#include <gasha/heap_sort.h>//ヒープソート
+#include <gasha/simd_small_sort.h>//SIMD小規模ソート
+
+#include <gasha/iterator.h>//イテレータ用アルゴリズム
+
+#include <utility>//C++11 std::move
+#include <type_traits>//C++11 std::is_arithmetic
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズム分類：混成ソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：パターン打破クイックソート
+namespace _private
+{
+	static const std::size_t PDQ_SORT_INSERTION_SORT_THRESHOLD = 24;//挿入ソートに切り替える残り件数
+	static const std::size_t PDQ_SORT_NINTHER_THRESHOLD = 128;//軸の選択に９点の中央値を使用する件数
+	static const std::size_t PDQ_SORT_PARTIAL_INSERTION_SORT_LIMIT = 8;//整列済み区間の検出に用いる挿入ソートの移動回数の上限
+	static const std::size_t PDQ_SORT_BLOCK_SIZE = 64;//ブロック分割の１ブロックの件数※オフセットを unsigned char で扱うため 256 以下
+
+	//ブロック分割が使用可能な型とプレディケート関数の組み合わせか？
+	//※比較が安価で、比較結果を分岐せずに扱える場合のみ使用する
+	template<class T, class PREDICATE>
+	struct isPdqSortBlockPartitionable : std::integral_constant<bool,
+		std::is_arithmetic<T>::value &&
+		_private::isSimdSmallSortPredicate<T, PREDICATE>::value
+	>{};
+
+	//挿入ソート
+	//※UNGUARDED = true の場合、配列の直前の要素が全要素以下であることを前提に、範囲チェックを省略する
+	template<bool UNGUARDED, class T, class PREDICATE>
+	inline std::size_t pdqSortInsertion(T* begin, T* end, PREDICATE predicate)
+	{
+		std::size_t swapped_count = 0;
+		if (begin == end)
+			return 0;
+		for (T* now = begin + 1; now != end; ++now)
+		{
+			T* sift = now;
+			T* sift_prev = now - 1;
+			if (predicate(*sift, *sift_prev))
+			{
+				T tmp(std::move(*sift));
+				do
+				{
+					*sift-- = std::move(*sift_prev);
+				} while ((UNGUARDED || sift != begin) && predicate(tmp, *--sift_prev));
+				*sift = std::move(tmp);
+				++swapped_count;
+			}
+		}
+		return swapped_count;
+	}
+
+	//移動回数制限付き挿入ソート（整列済み区間の検出用）
+	//※移動回数が上限を超えたら中断し、false を返す（配列は一部整列された状態になる）
+	template<class T, class PREDICATE>
+	inline bool pdqSortPartialInsertion(T* begin, T* end, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		if (begin == end)
+			return true;
+		std::size_t moved = 0;
+		for (T* now = begin + 1; now != end; ++now)
+		{
+			T* sift = now;
+			T* sift_prev = now - 1;
+			if (predicate(*sift, *sift_prev))
+			{
+				T tmp(std::move(*sift));
+				do
+				{
+					*sift-- = std::move(*sift_prev);
+				} while (sift != begin && predicate(tmp, *--sift_prev));
+				*sift = std::move(tmp);
+				++swapped_count;
+				moved += static_cast<std::size_t>(now - sift);
+				if (moved > PDQ_SORT_PARTIAL_INSERTION_SORT_LIMIT)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	//２点／３点の整列（軸の選択用）
+	template<class T, class PREDICATE>
+	inline void pdqSortSort2(T* a, T* b, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		if (predicate(*b, *a))
+		{
+			GASHA_ swapValues(*a, *b);
+			++swapped_count;
+		}
+	}
+	template<class T, class PREDICATE>
+	inline void pdqSortSort3(T* a, T* b, T* c, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		pdqSortSort2(a, b, predicate, swapped_count);
+		pdqSortSort2(b, c, predicate, swapped_count);
+		pdqSortSort2(a, b, predicate, swapped_count);
+	}
+
+	//ブロック分割のオフセットに従って要素を交換
+	//※USE_SWAPS = false の場合、交換ではなく巡回移動で移動回数を減らす
+	template<class T>
+	inline void pdqSortSwapOffsets(T* first, T* last, const unsigned char* offsets_l, const unsigned char* offsets_r, const std::size_t num, const bool use_swaps)
+	{
+		if (use_swaps)
+		{
+			//左右の要素数が同じ場合は、巡回移動だと最後の要素が正しく移動しないため、交換を使用
+			for (std::size_t i = 0; i < num; ++i)
+				GASHA_ swapValues(first[offsets_l[i]], *(last - offsets_r[i]));
+		}
+		else if (num > 0)
+		{
+			T* l = first + offsets_l[0];
+			T* r = last - offsets_r[0];
+			T tmp(std::move(*l));
+			*l = std::move(*r);
+			for (std::size_t i = 1; i < num; ++i)
+			{
+				l = first + offsets_l[i];
+				*r = std::move(*l);
+				r = last - offsets_r[i];
+				*l = std::move(*r);
+			}
+			*r = std::move(tmp);
+		}
+	}
+
+	//軸未満の配列と軸以上の配列に二分
+	//※配列の先頭要素を軸とし、軸の位置を返す
+	//※already_partitioned には、交換が一度も発生しなかったかどうかを返す
+	template<bool IS_BLOCK_PARTITION, class T, class PREDICATE>
+	T* pdqSortPartitionRight(T* begin, T* end, PREDICATE predicate, bool& already_partitioned, std::size_t& swapped_count)
+	{
+		T pivot(std::move(*begin));
+		T* first = begin;
+		T* last = end;
+		//軸以上の最初の要素を探索（３点の中央値により、必ず見つかる）
+		while (predicate(*++first, pivot));
+		//軸未満の最後の要素を探索
+		//※先頭要素の直後で見つかった場合は、番兵が存在しないため範囲チェックを行う
+		if (first - 1 == begin)
+			while (first < last && !predicate(*--last, pivot));
+		else
+			while (!predicate(*--last, pivot));
+		already_partitioned = first >= last;
+		if (!already_partitioned)
+		{
+			GASHA_ swapValues(*first, *last);
+			++swapped_count;
+			++first;
+			if (IS_BLOCK_PARTITION)
+			{
+				//ブロック分割
+				//※比較結果（0/1）をオフセットバッファへの書き込み位置の加算に用い、分岐を排除する
+				alignas(64) unsigned char offsets_l[PDQ_SORT_BLOCK_SIZE];
+				alignas(64) unsigned char offsets_r[PDQ_SORT_BLOCK_SIZE];
+				std::size_t num_l = 0;
+				std::size_t num_r = 0;
+				std::size_t start_l = 0;
+				std::size_t start_r = 0;
+				//左右から１ブロックずつ比較し、オフセットを使い切った側のブロックを進める
+				while (static_cast<std::size_t>(last - first) > PDQ_SORT_BLOCK_SIZE * 2)
+				{
+					//左側：軸以上の要素のオフセットを記録
+					if (num_l == 0)
+					{
+						start_l = 0;
+						T* p = first;
+						for (std::size_t i = 0; i < PDQ_SORT_BLOCK_SIZE; ++i, ++p)
+						{
+							offsets_l[num_l] = static_cast<unsigned char>(i);
+							num_l += !predicate(*p, pivot);
+						}
+					}
+					//右側：軸未満の要素のオフセットを記録
+					if (num_r == 0)
+					{
+						start_r = 0;
+						T* p = last;
+						for (std::size_t i = 0; i < PDQ_SORT_BLOCK_SIZE;)
+						{
+							offsets_r[num_r] = static_cast<unsigned char>(++i);
+							num_r += predicate(*--p, pivot);
+						}
+					}
+					//記録したオフセットの要素同士を交換
+					const std::size_t num = num_l < num_r ? num_l : num_r;
+					pdqSortSwapOffsets(first, last, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+					swapped_count += num;
+					num_l -= num;
+					num_r -= num;
+					start_l += num;
+					start_r += num;
+					if (num_l == 0)
+						first += PDQ_SORT_BLOCK_SIZE;
+					if (num_r == 0)
+						last -= PDQ_SORT_BLOCK_SIZE;
+				}
+				//残りの未処理の要素を、オフセットが残っていない側に割り当てる
+				std::size_t l_size = 0;
+				std::size_t r_size = 0;
+				const std::size_t unknown_left = static_cast<std::size_t>(last - first) - ((num_r || num_l) ? PDQ_SORT_BLOCK_SIZE : 0);
+				if (num_r)
+				{
+					l_size = unknown_left;
+					r_size = PDQ_SORT_BLOCK_SIZE;
+				}
+				else if (num_l)
+				{
+					l_size = PDQ_SORT_BLOCK_SIZE;
+					r_size = unknown_left;
+				}
+				else
+				{
+					l_size = unknown_left / 2;
+					r_size = unknown_left - l_size;
+				}
+				if (unknown_left && !num_l)
+				{
+					start_l = 0;
+					T* p = first;
+					for (std::size_t i = 0; i < l_size; ++i, ++p)
+					{
+						offsets_l[num_l] = static_cast<unsigned char>(i);
+						num_l += !predicate(*p, pivot);
+					}
+				}
+				if (unknown_left && !num_r)
+				{
+					start_r = 0;
+					T* p = last;
+					for (std::size_t i = 0; i < r_size;)
+					{
+						offsets_r[num_r] = static_cast<unsigned char>(++i);
+						num_r += predicate(*--p, pivot);
+					}
+				}
+				{
+					const std::size_t num = num_l < num_r ? num_l : num_r;
+					pdqSortSwapOffsets(first, last, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+					swapped_count += num;
+					num_l -= num;
+					num_r -= num;
+					start_l += num;
+					start_r += num;
+				}
+				if (num_l == 0)
+					first += l_size;
+				if (num_r == 0)
+					last -= r_size;
+				//残ったオフセットの要素を、境界側に寄せる
+				if (num_l)
+				{
+					while (num_l--)
+					{
+						GASHA_ swapValues(first[offsets_l[start_l + num_l]], *--last);
+						++swapped_count;
+					}
+					first = last;
+				}
+				if (num_r)
+				{
+					while (num_r--)
+					{
+						GASHA_ swapValues(*(last - offsets_r[start_r + num_r]), *first);
+						++swapped_count;
+						++first;
+					}
+					last = first;
+				}
+			}
+			else
+			{
+				//通常の分割
+				while (first < last)
+				{
+					while (predicate(*first, pivot))
+						++first;
+					while (!predicate(*--last, pivot));
+					if (first >= last)
+						break;
+					GASHA_ swapValues(*first, *last);
+					++swapped_count;
+					++first;
+				}
+			}
+		}
+		//軸を境界に配置
+		T* pivot_pos = first - 1;
+		*begin = std::move(*pivot_pos);
+		*pivot_pos = std::move(pivot);
+		return pivot_pos;
+	}
+
+	//軸以下の配列と軸より大きい配列に二分（同値キーの分割）
+	//※軸と等しい要素を左側にまとめ、軸の位置を返す
+	//※配列の直前の要素（直前の分割の軸）が、先頭要素と等しい場合に使用する
+	template<class T, class PREDICATE>
+	T* pdqSortPartitionLeft(T* begin, T* end, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		T pivot(std::move(*begin));
+		T* first = begin;
+		T* last = end;
+		while (predicate(pivot, *--last));
+		if (last + 1 == end)
+			while (first < last && !predicate(pivot, *++first));
+		else
+			while (!predicate(pivot, *++first));
+		while (first < last)
+		{
+			GASHA_ swapValues(*first, *last);
+			++swapped_count;
+			while (predicate(pivot, *--last));
+			while (!predicate(pivot, *++first));
+		}
+		T* pivot_pos = last;
+		*begin = std::move(*pivot_pos);
+		*pivot_pos = std::move(pivot);
+		return pivot_pos;
+	}
+
+	//パターン打破
+	//※偏った分割の後、先頭側と末尾側の要素を内側の要素と入れ替え、次回の軸の選択を変化させる
+	template<class T>
+	inline void pdqSortBreakPatterns(T* begin, T* end, std::size_t& swapped_count)
+	{
+		const std::size_t size = static_cast<std::size_t>(end - begin);
+		const std::size_t quarter = size / 4;
+		GASHA_ swapValues(begin[0], begin[quarter]);
+		GASHA_ swapValues(end[-1], end[-static_cast<std::ptrdiff_t>(quarter)]);
+		swapped_count += 2;
+		if (size > PDQ_SORT_NINTHER_THRESHOLD)
+		{
+			GASHA_ swapValues(begin[1], begin[quarter + 1]);
+			GASHA_ swapValues(begin[2], begin[quarter + 2]);
+			GASHA_ swapValues(end[-2], end[-static_cast<std::ptrdiff_t>(quarter + 1)]);
+			GASHA_ swapValues(end[-3], end[-static_cast<std::ptrdiff_t>(quarter + 2)]);
+			swapped_count += 4;
+		}
+	}
+
+	//メインループ
+	//※左側の配列を再帰処理し、右側の配列をループで処理する
+	//※偏った分割の許容回数（bad_allowed）を使い切ったらヒープソートに切り替えるため、再帰の深さは O(log n) に収まる
+	//※leftmost = false の場合、配列の直前の要素が全要素以下であることが保証される
+	template<class T, class PREDICATE>
+	std::size_t pdqSort(T* begin, T* end, PREDICATE predicate, int bad_allowed, bool leftmost)
+	{
+		static const bool IS_SIMD_SMALL_SORT = GASHA_ isSimdSmallSortable<T, PREDICATE>::value;//SIMD小規模ソートが使用可能か？
+		static const bool IS_BLOCK_PARTITION = isPdqSortBlockPartitionable<T, PREDICATE>::value;//ブロック分割が使用可能か？
+		static const std::size_t SIZE_THRESHOLD = IS_SIMD_SMALL_SORT ? GASHA_ SIMD_SMALL_SORT_SIZE_MAX : PDQ_SORT_INSERTION_SORT_THRESHOLD;//挿入ソートに切り替える残り件数
+		std::size_t swapped_count = 0;
+		while (true)
+		{
+			const std::size_t size = static_cast<std::size_t>(end - begin);
+			//対象件数が一定数未満なら挿入ソートに切り替え
+			if (size < SIZE_THRESHOLD)
+			{
+				if (IS_SIMD_SMALL_SORT)
+					swapped_count += GASHA_ simdSmallSort(begin, size, predicate);//SIMD小規模ソート（ソーティングネットワーク）に切り替え
+				else if (leftmost)
+					swapped_count += pdqSortInsertion<false>(begin, end, predicate);
+				else
+					swapped_count += pdqSortInsertion<true>(begin, end, predicate);
+				return swapped_count;
+			}
+			//軸を決定し、先頭に配置
+			const std::size_t half = size / 2;
+			if (size > PDQ_SORT_NINTHER_THRESHOLD)
+			{
+				//９点の中央値（ninther）
+				pdqSortSort3(begin, begin + half, end - 1, predicate, swapped_count);
+				pdqSortSort3(begin + 1, begin + (half - 1), end - 2, predicate, swapped_count);
+				pdqSortSort3(begin + 2, begin + (half + 1), end - 3, predicate, swapped_count);
+				pdqSortSort3(begin + (half - 1), begin + half, begin + (half + 1), predicate, swapped_count);
+				GASHA_ swapValues(*begin, *(begin + half));
+				++swapped_count;
+			}
+			else
+			{
+				//３点の中央値
+				pdqSortSort3(begin + half, begin, end - 1, predicate, swapped_count);
+			}
+			//軸が直前の分割の軸と等しければ、同値キーの分割を行い、軸と等しい要素を以降の処理対象から除外
+			if (!leftmost && !predicate(*(begin - 1), *begin))
+			{
+				begin = pdqSortPartitionLeft(begin, end, predicate, swapped_count) + 1;
+				continue;
+			}
+			//軸未満の配列と軸以上の配列に二分
+			bool already_partitioned = false;
+			T* pivot_pos = pdqSortPartitionRight<IS_BLOCK_PARTITION>(begin, end, predicate, already_partitioned, swapped_count);
+			const std::size_t l_size = static_cast<std::size_t>(pivot_pos - begin);
+			const std::size_t r_size = static_cast<std::size_t>(end - (pivot_pos + 1));
+			const bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+			if (highly_unbalanced)
+			{
+				//偏った分割が続いたらヒープソートに切り替え
+				if (--bad_allowed == 0)
+				{
+					swapped_count += GASHA_ heapSort(begin, size, predicate);
+					return swapped_count;
+				}
+				//パターン打破
+				if (l_size >= PDQ_SORT_INSERTION_SORT_THRESHOLD)
+					pdqSortBreakPatterns(begin, pivot_pos, swapped_count);
+				if (r_size >= PDQ_SORT_INSERTION_SORT_THRESHOLD)
+					pdqSortBreakPatterns(pivot_pos + 1, end, swapped_count);
+			}
+			else
+			{
+				//交換が発生しなかった場合は、整列済みの可能性があるので、移動回数制限付き挿入ソートを試す
+				if (already_partitioned &&
+				    pdqSortPartialInsertion(begin, pivot_pos, predicate, swapped_count) &&
+				    pdqSortPartialInsertion(pivot_pos + 1, end, predicate, swapped_count))
+					return swapped_count;
+			}
+			//左側を再帰処理し、右側をループで処理
+			swapped_count += pdqSort(begin, pivot_pos, predicate, bad_allowed, leftmost);
+			begin = pivot_pos + 1;
+			leftmost = false;
+		}
+	}
+
+	//逆順に整列済みか？
+	//※同値キーを含んでいても、昇順でなければ反転して整列できる
+	template<class T, class PREDICATE>
+	inline bool pdqSortIsReverseOrdered(const T* array, const std::size_t size, PREDICATE predicate)
+	{
+		const T* end = array + size;
+		for (const T* now = array + 1; now < end; ++now)
+		{
+			if (predicate(*(now - 1), *now))
+				return false;
+		}
+		return true;
+	}
+}//namespace _private
+template<class T, class PREDICATE>
+inline std::size_t pdqSort(T* array, const std::size_t size, PREDICATE predicate)
+{
+	if (!array || size <= 1)
+		return 0;
+	if (GASHA_ isOrdered(array, size, predicate))
+		return 0;
+	//逆順に整列済みなら反転して終了
+	if (_private::pdqSortIsReverseOrdered(array, size, predicate))
+	{
+		std::size_t swapped_count = 0;
+		for (T *begin = array, *end = array + size - 1; begin < end; ++begin, --end, ++swapped_count)
+			GASHA_ swapValues(*begin, *end);
+		return swapped_count;
+	}
+	int bad_allowed = 0;//偏った分割の許容回数※log2(全体サイズ)で計算
+	for (std::size_t size_tmp = size; size_tmp > 1; size_tmp >>= 1, ++bad_allowed);
+	return _private::pdqSort(array, array + size, predicate, bad_allowed, true);
+}
+
+//----------------------------------------
+//アルゴリズム：パターン打破クイックソート
+//※イテレータ対応版
+namespace _private
+{
+	//挿入ソート
+	//※UNGUARDED = true の場合、範囲の直前の要素が全要素以下であることを前提に、範囲チェックを省略する
+	template<bool UNGUARDED, class ITERATOR, class PREDICATE>
+	inline std::size_t iteratorPdqSortInsertion(ITERATOR begin, ITERATOR end, PREDICATE predicate)
+	{
+		typedef typename ITERATOR::value_type value_type;
+		std::size_t swapped_count = 0;
+		if (begin == end)
+			return 0;
+		ITERATOR now = begin;
+		for (++now; now != end; ++now)
+		{
+			ITERATOR sift = now;
+			ITERATOR sift_prev = now;
+			--sift_prev;
+			if (predicate(*sift, *sift_prev))
+			{
+				value_type tmp(std::move(*sift));
+				do
+				{
+					*sift = std::move(*sift_prev);
+					--sift;
+				} while ((UNGUARDED || sift != begin) && predicate(tmp, *--sift_prev));
+				*sift = std::move(tmp);
+				++swapped_count;
+			}
+		}
+		return swapped_count;
+	}
+
+	//移動回数制限付き挿入ソート（整列済み区間の検出用）
+	//※移動回数が上限を超えたら中断し、false を返す（範囲は一部整列された状態になる）
+	template<class ITERATOR, class PREDICATE>
+	inline bool iteratorPdqSortPartialInsertion(ITERATOR begin, ITERATOR end, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		typedef typename ITERATOR::value_type value_type;
+		if (begin == end)
+			return true;
+		std::size_t moved = 0;
+		ITERATOR now = begin;
+		for (++now; now != end; ++now)
+		{
+			ITERATOR sift = now;
+			ITERATOR sift_prev = now;
+			--sift_prev;
+			if (predicate(*sift, *sift_prev))
+			{
+				value_type tmp(std::move(*sift));
+				do
+				{
+					*sift = std::move(*sift_prev);
+					--sift;
+				} while (sift != begin && predicate(tmp, *--sift_prev));
+				*sift = std::move(tmp);
+				++swapped_count;
+				moved += static_cast<std::size_t>(now - sift);
+				if (moved > PDQ_SORT_PARTIAL_INSERTION_SORT_LIMIT)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	//２点／３点の整列（軸の選択用）
+	template<class ITERATOR, class PREDICATE>
+	inline void iteratorPdqSortSort2(ITERATOR a, ITERATOR b, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		if (predicate(*b, *a))
+		{
+			GASHA_ iteratorSwapValues(a, b);
+			++swapped_count;
+		}
+	}
+	template<class ITERATOR, class PREDICATE>
+	inline void iteratorPdqSortSort3(ITERATOR a, ITERATOR b, ITERATOR c, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		iteratorPdqSortSort2(a, b, predicate, swapped_count);
+		iteratorPdqSortSort2(b, c, predicate, swapped_count);
+		iteratorPdqSortSort2(a, b, predicate, swapped_count);
+	}
+
+	//軸未満の範囲と軸以上の範囲に二分（Hoare分割）
+	//※範囲の先頭要素を軸とし、軸の位置を返す
+	//※already_partitioned には、交換が一度も発生しなかったかどうかを返す
+	template<class ITERATOR, class PREDICATE>
+	ITERATOR iteratorPdqSortPartitionRight(ITERATOR begin, ITERATOR end, PREDICATE predicate, bool& already_partitioned, std::size_t& swapped_count)
+	{
+		typedef typename ITERATOR::value_type value_type;
+		value_type pivot(std::move(*begin));
+		ITERATOR first = begin;
+		ITERATOR last = end;
+		//軸以上の最初の要素を探索（３点の中央値により、必ず見つかる）
+		while (predicate(*++first, pivot));
+		//軸未満の最後の要素を探索
+		//※先頭要素の直後で見つかった場合は、番兵が存在しないため範囲チェックを行う
+		if (first - 1 == begin)
+			while (first < last && !predicate(*--last, pivot));
+		else
+			while (!predicate(*--last, pivot));
+		already_partitioned = first >= last;
+		while (first < last)
+		{
+			GASHA_ iteratorSwapValues(first, last);
+			++swapped_count;
+			while (predicate(*++first, pivot));
+			while (!predicate(*--last, pivot));
+		}
+		//軸を境界に配置
+		ITERATOR pivot_pos = first - 1;
+		*begin = std::move(*pivot_pos);
+		*pivot_pos = std::move(pivot);
+		return pivot_pos;
+	}
+
+	//軸以下の範囲と軸より大きい範囲に二分（同値キーの分割）
+	//※軸と等しい要素を左側にまとめ、軸の位置を返す
+	//※範囲の直前の要素（直前の分割の軸）が、先頭要素と等しい場合に使用する
+	template<class ITERATOR, class PREDICATE>
+	ITERATOR iteratorPdqSortPartitionLeft(ITERATOR begin, ITERATOR end, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		typedef typename ITERATOR::value_type value_type;
+		value_type pivot(std::move(*begin));
+		ITERATOR first = begin;
+		ITERATOR last = end;
+		while (predicate(pivot, *--last));
+		if (last + 1 == end)
+			while (first < last && !predicate(pivot, *++first));
+		else
+			while (!predicate(pivot, *++first));
+		while (first < last)
+		{
+			GASHA_ iteratorSwapValues(first, last);
+			++swapped_count;
+			while (predicate(pivot, *--last));
+			while (!predicate(pivot, *++first));
+		}
+		ITERATOR pivot_pos = last;
+		*begin = std::move(*pivot_pos);
+		*pivot_pos = std::move(pivot);
+		return pivot_pos;
+	}
+
+	//パターン打破
+	//※偏った分割の後、先頭側と末尾側の要素を内側の要素と入れ替え、次回の軸の選択を変化させる
+	template<class ITERATOR>
+	inline void iteratorPdqSortBreakPatterns(ITERATOR begin, ITERATOR end, std::size_t& swapped_count)
+	{
+		typedef typename ITERATOR::difference_type difference_type;
+		const difference_type size = end - begin;
+		const difference_type quarter = size / 4;
+		GASHA_ iteratorSwapValues(begin, begin + quarter);
+		GASHA_ iteratorSwapValues(end - 1, end - quarter);
+		swapped_count += 2;
+		if (size > static_cast<difference_type>(PDQ_SORT_NINTHER_THRESHOLD))
+		{
+			GASHA_ iteratorSwapValues(begin + 1, begin + (quarter + 1));
+			GASHA_ iteratorSwapValues(begin + 2, begin + (quarter + 2));
+			GASHA_ iteratorSwapValues(end - 2, end - (quarter + 1));
+			GASHA_ iteratorSwapValues(end - 3, end - (quarter + 2));
+			swapped_count += 4;
+		}
+	}
+
+	//メインループ
+	//※左側の範囲を再帰処理し、右側の範囲をループで処理する
+	//※偏った分割の許容回数（bad_allowed）を使い切ったらシェルソートに切り替えるため、再帰の深さは O(log n) に収まる
+	//※leftmost = false の場合、範囲の直前の要素が全要素以下であることが保証される
+	template<class ITERATOR, class PREDICATE>
+	std::size_t iteratorPdqSort(ITERATOR begin, ITERATOR end, PREDICATE predicate, int bad_allowed, bool leftmost)
+	{
+		typedef typename ITERATOR::difference_type difference_type;
+		std::size_t swapped_count = 0;
+		while (true)
+		{
+			const difference_type size = end - begin;
+			//対象件数が一定数未満なら挿入ソートに切り替え
+			if (size < static_cast<difference_type>(PDQ_SORT_INSERTION_SORT_THRESHOLD))
+			{
+				if (leftmost)
+					swapped_count += iteratorPdqSortInsertion<false>(begin, end, predicate);
+				else
+					swapped_count += iteratorPdqSortInsertion<true>(begin, end, predicate);
+				return swapped_count;
+			}
+			//軸を決定し、先頭に配置
+			const difference_type half = size / 2;
+			if (size > static_cast<difference_type>(PDQ_SORT_NINTHER_THRESHOLD))
+			{
+				//９点の中央値（ninther）
+				iteratorPdqSortSort3(begin, begin + half, end - 1, predicate, swapped_count);
+				iteratorPdqSortSort3(begin + 1, begin + (half - 1), end - 2, predicate, swapped_count);
+				iteratorPdqSortSort3(begin + 2, begin + (half + 1), end - 3, predicate, swapped_count);
+				iteratorPdqSortSort3(begin + (half - 1), begin + half, begin + (half + 1), predicate, swapped_count);
+				GASHA_ iteratorSwapValues(begin, begin + half);
+				++swapped_count;
+			}
+			else
+			{
+				//３点の中央値
+				iteratorPdqSortSort3(begin + half, begin, end - 1, predicate, swapped_count);
+			}
+			//軸が直前の分割の軸と等しければ、同値キーの分割を行い、軸と等しい要素を以降の処理対象から除外
+			if (!leftmost && !predicate(*(begin - 1), *begin))
+			{
+				begin = iteratorPdqSortPartitionLeft(begin, end, predicate, swapped_count) + 1;
+				continue;
+			}
+			//軸未満の範囲と軸以上の範囲に二分
+			bool already_partitioned = false;
+			ITERATOR pivot_pos = iteratorPdqSortPartitionRight(begin, end, predicate, already_partitioned, swapped_count);
+			const difference_type l_size = pivot_pos - begin;
+			const difference_type r_size = end - (pivot_pos + 1);
+			const bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+			if (highly_unbalanced)
+			{
+				//偏った分割が続いたらシェルソートに切り替え
+				//※イテレータ対応版のヒープソートがないため、イントロソート（イテレータ対応版）と同様にシェルソートを使用
+				if (--bad_allowed == 0)
+				{
+					swapped_count += GASHA_ iteratorShellSort(begin, end, predicate);
+					return swapped_count;
+				}
+				//パターン打破
+				if (l_size >= static_cast<difference_type>(PDQ_SORT_INSERTION_SORT_THRESHOLD))
+					iteratorPdqSortBreakPatterns(begin, pivot_pos, swapped_count);
+				if (r_size >= static_cast<difference_type>(PDQ_SORT_INSERTION_SORT_THRESHOLD))
+					iteratorPdqSortBreakPatterns(pivot_pos + 1, end, swapped_count);
+			}
+			else
+			{
+				//交換が発生しなかった場合は、整列済みの可能性があるので、移動回数制限付き挿入ソートを試す
+				if (already_partitioned &&
+				    iteratorPdqSortPartialInsertion(begin, pivot_pos, predicate, swapped_count) &&
+				    iteratorPdqSortPartialInsertion(pivot_pos + 1, end, predicate, swapped_count))
+					return swapped_count;
+			}
+			//左側を再帰処理し、右側をループで処理
+			swapped_count += iteratorPdqSort(begin, pivot_pos, predicate, bad_allowed, leftmost);
+			begin = pivot_pos + 1;
+			leftmost = false;
+		}
+	}
+
+	//逆順に整列済みか？
+	template<class ITERATOR, class PREDICATE>
+	inline bool iteratorPdqSortIsReverseOrdered(ITERATOR begin, ITERATOR end, PREDICATE predicate)
+	{
+		ITERATOR prev = begin;
+		ITERATOR now = begin;
+		for (++now; now != end; ++prev, ++now)
+		{
+			if (predicate(*prev, *now))
+				return false;
+		}
+		return true;
+	}
+}//namespace _private
+template<class ITERATOR, class PREDICATE>
+inline std::size_t iteratorPdqSort(ITERATOR begin, ITERATOR end, PREDICATE predicate)
+{
+	if (begin == end)
+		return 0;
+	if (GASHA_ iteratorIsOrdered(begin, end, predicate))
+		return 0;
+	//逆順に整列済みなら反転して終了
+	if (_private::iteratorPdqSortIsReverseOrdered(begin, end, predicate))
+	{
+		std::size_t swapped_count = 0;
+		ITERATOR last = end;
+		for (--last; begin < last; ++begin, --last, ++swapped_count)
+			GASHA_ iteratorSwapValues(begin, last);
+		return swapped_count;
+	}
+	int bad_allowed = 0;//偏った分割の許容回数※log2(全体サイズ)で計算
+	for (std::size_t size_tmp = static_cast<std::size_t>(GASHA_ iteratorDifference(begin, end)); size_tmp > 1; size_tmp >>= 1, ++bad_allowed);
+	return _private::iteratorPdqSort(begin, end, predicate, bad_allowed, true);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_PDQ_SORT_INL
+
+// End of file
@@ -0,0 +1,272 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_RANDOM_ENGINE_H
+#define GASHA_INCLUDED_RANDOM_ENGINE_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ含む】
+// random_engine.h
+// 乱数エンジン【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/fast_math.h>//高速算術：fastLog(), fastSinCos()
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint32_t, std::uint64_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//乱数エンジン
+//※rand() や std::mt19937 より高速で状態の小さい、以下の擬似乱数生成器を扱う。
+//　・xoshiro256pp      ... xoshiro256++。64ビットの乱数を生成する。周期 2^256-1。状態 32バイト。
+//　・pcg32             ... PCG-XSH-RR。32ビットの乱数を生成する。周期 2^64。状態 16バイト。（ストリームを選択可能）
+//　・xoshiro256ppBatch ... xoshiro256++ を4系統並べて、配列を一括で埋める。
+//※xoshiro256pp, pcg32 は、標準ライブラリの乱数生成器の要件（result_type, min(), max(), operator()）を満たし、
+//　std::uniform_int_distribution などの分布クラスと組み合わせて使用できる。
+//※暗号用途には使用しないこと。
+//--------------------------------------------------------------------------------
+//【シード】
+//※コンストラクタは constexpr のため、定数のシードを与えるとコンパイル時に初期状態が求まる。
+//　xoshiro256pp は、シードを SplitMix64 で拡張して状態を作る。（状態が全て 0 になることはない）
+//※randomSeed() で、文字列（ステージ名など）からコンパイル時にシードを作れる。（64ビット FNV-1a）
+//　ビルド設定や実行環境によらず同じ値になるため、リプレイ用のシードに使用できる。
+//※xoshiro256ppFixedSeed<SEED>, pcg32FixedSeed<SEED, STREAM> は、シードを型に持つ版。
+//　reset() で、いつでも同じ初期状態に戻せるため、決定論的なリプレイに使用する。
+//--------------------------------------------------------------------------------
+//【独立した系列（スレッドごとの乱数）】
+//※xoshiro256pp::jump() は 2^128 回分、longJump() は 2^192 回分、状態を進める。
+//　一つのシードから、jump() するごとにコピーを取ることで、重ならない系列をスレッド数分作れる。
+//※pcg32::advance() は、指定の回数分の状態を O(log n) で進める。jump() は 2^48 回分進める。
+//　また、pcg32 はコンストラクタのストリーム番号が異なれば、別の系列になる。
+//--------------------------------------------------------------------------------
+//【一括生成（xoshiro256ppBatch）】
+//※4系統の xoshiro256++ の状態を持ち、1回の更新で 64ビット×4 の乱数を生成する。
+//　各系統は、元のエンジンを jump() でずらした状態から始まるため、互いに重ならない。
+//※AVX2が有効なら、4系統をまとめてAVX2命令で更新する。無効なら、スカラー演算で同じ順序の結果を生成する。
+//　（どちらでも、同じシードなら同じ結果になる。正規分布は、fast_math の演算結果が演算方法によって異なるため一致しない）
+//※ビルド設定 GASHA_USE_RUNTIME_CPU_DISPATCH が有効で、AVX2命令がコンパイル時に無効な場合、
+//　CPUのAVX2命令対応を実行時に判定し、対応していればAVX2命令で処理する。
+//※1回の更新で 32ビット×8 の値を生成し、配列の要素数が 8 の倍数でない場合、余った値は捨てる。
+//　（正規分布は、16 の倍数でない場合に余った値を捨てる）
+//※正規分布は、Box-Muller法で生成する。対数と正弦／余弦には fast_math の高速超越関数を使用し、
+//　テンプレート引数 ARITH で精度を選択する。（デフォルトは fastA）
+//　一様乱数の精度（24ビット）により、平均から約 5.77σ を超える値は生成されない。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //スカラー
+//  xoshiro256pp rng(12345);
+//  const std::uint64_t value = rng();//64ビットの乱数
+//  const float f = rng.nextFloat();//[0.0, 1.0) の乱数
+//  std::uniform_int_distribution<int> dist(1, 6);
+//  const int dice = dist(rng);//標準ライブラリの分布クラスと組み合わせる
+//
+//  //スレッドごとの系列
+//  xoshiro256pp base(12345);
+//  xoshiro256pp per_thread[4];
+//  for (int i = 0; i < 4; ++i){ per_thread[i] = base; base.jump(); }
+//
+//  //リプレイ用
+//  xoshiro256ppFixedSeed<randomSeed("stage1")> replay_rng;
+//  replay_rng.reset();//リプレイ開始時に初期状態に戻す
+//
+//  //一括生成
+//  xoshiro256ppBatch batch(12345);
+//  batch.fillFloat(particle_life, particle_num);//[0.0, 1.0) の乱数で埋める
+//  batch.fillNormal(particle_speed, particle_num, 10.f, 2.f);//平均 10.0、標準偏差 2.0 の正規分布で埋める
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//文字列からシードを作成（64ビット FNV-1a）
+inline constexpr std::uint64_t randomSeed(const char* str);
+
+namespace _private
+{
+	//----------------------------------------
+	//SplitMix64（シードの拡張用）
+	//※seed から始まる系列の index 番目（1～）の値を返す
+	inline constexpr std::uint64_t splitMix64(const std::uint64_t seed, const std::uint64_t index);
+	//----------------------------------------
+	//64ビットの乱数を [0.0, 1.0) の float に変換
+	inline float randomToFloat(const std::uint64_t value);
+}//namespace _private
+
+//----------------------------------------
+//xoshiro256++
+class xoshiro256pp
+{
+public:
+	//型
+	typedef std::uint64_t result_type;//乱数の型
+public:
+	//定数
+	static const std::uint64_t DEFAULT_SEED = 0x853c49e6748fea9bull;//デフォルトのシード
+public:
+	//乱数の最小値／最大値
+	inline static constexpr result_type min(){ return 0; }
+	inline static constexpr result_type max(){ return ~static_cast<result_type>(0); }
+public:
+	//乱数を生成
+	inline result_type operator()();
+	//32ビットの乱数を生成
+	//※上位32ビットを使用する
+	inline std::uint32_t nextU32();
+	//[0.0, 1.0) の乱数を生成
+	inline float nextFloat();
+	//2^128 回分、状態を進める
+	inline void jump();
+	//2^192 回分、状態を進める
+	inline void longJump();
+	//シードを設定
+	inline void seed(const std::uint64_t seed);
+	//状態を取得／設定
+	inline std::uint64_t state(const int index) const;
+	inline void setState(const std::uint64_t s0, const std::uint64_t s1, const std::uint64_t s2, const std::uint64_t s3);
+public:
+	//コンストラクタ
+	inline constexpr xoshiro256pp(const std::uint64_t seed = DEFAULT_SEED);
+private:
+	//状態を進める
+	inline void jump(const std::uint64_t (&poly)[4]);
+private:
+	//フィールド
+	std::uint64_t m_s0;//状態
+	std::uint64_t m_s1;//状態
+	std::uint64_t m_s2;//状態
+	std::uint64_t m_s3;//状態
+};
+
+//----------------------------------------
+//xoshiro256++（シード固定版）
+//※SEED ... シード（randomSeed() で文字列から作成可能）
+template<std::uint64_t SEED>
+class xoshiro256ppFixedSeed : public xoshiro256pp
+{
+public:
+	//定数
+	static const std::uint64_t SEED_VALUE = SEED;//シード
+public:
+	//初期状態に戻す
+	inline void reset(){ seed(SEED); }
+public:
+	//コンストラクタ
+	inline constexpr xoshiro256ppFixedSeed() :
+		xoshiro256pp(SEED)
+	{}
+};
+
+//----------------------------------------
+//PCG32（PCG-XSH-RR）
+class pcg32
+{
+public:
+	//型
+	typedef std::uint32_t result_type;//乱数の型
+public:
+	//定数
+	static const std::uint64_t DEFAULT_SEED = 0x853c49e6748fea9bull;//デフォルトのシード
+	static const std::uint64_t DEFAULT_STREAM = 0xda3e39cb94b95bdbull;//デフォルトのストリーム番号
+	static const std::uint64_t MULTIPLIER = 6364136223846793005ull;//線形合同法の乗数
+public:
+	//乱数の最小値／最大値
+	inline static constexpr result_type min(){ return 0; }
+	inline static constexpr result_type max(){ return ~static_cast<result_type>(0); }
+public:
+	//乱数を生成
+	inline result_type operator()();
+	//[0.0, 1.0) の乱数を生成
+	inline float nextFloat();
+	//指定の回数分、状態を進める
+	inline void advance(const std::uint64_t delta);
+	//2^48 回分、状態を進める
+	inline void jump();
+	//シードを設定
+	inline void seed(const std::uint64_t seed, const std::uint64_t stream = DEFAULT_STREAM);
+	//状態を取得
+	inline std::uint64_t state() const { return m_state; }
+	inline std::uint64_t increment() const { return m_inc; }
+public:
+	//コンストラクタ
+	//※stream ... ストリーム番号（異なるストリームは別の系列になる）
+	inline constexpr pcg32(const std::uint64_t seed = DEFAULT_SEED, const std::uint64_t stream = DEFAULT_STREAM);
+private:
+	//フィールド
+	std::uint64_t m_state;//状態
+	std::uint64_t m_inc;//増分（奇数）
+};
+
+//----------------------------------------
+//PCG32（シード固定版）
+//※SEED ... シード（randomSeed() で文字列から作成可能）
+//※STREAM ... ストリーム番号
+template<std::uint64_t SEED, std::uint64_t STREAM = pcg32::DEFAULT_STREAM>
+class pcg32FixedSeed : public pcg32
+{
+public:
+	//定数
+	static const std::uint64_t SEED_VALUE = SEED;//シード
+	static const std::uint64_t STREAM_VALUE = STREAM;//ストリーム番号
+public:
+	//初期状態に戻す
+	inline void reset(){ seed(SEED, STREAM); }
+public:
+	//コンストラクタ
+	inline constexpr pcg32FixedSeed() :
+		pcg32(SEED, STREAM)
+	{}
+};
+
+//----------------------------------------
+//xoshiro256++ 一括生成
+class xoshiro256ppBatch
+{
+public:
+	//定数
+	static const int LANE_NUM = 4;//系統数
+	static const std::size_t U32_PER_STEP = LANE_NUM * 2;//1回の更新で生成する32ビットの値の数
+public:
+	//32ビットの乱数で配列を埋める
+	inline void fill(std::uint32_t* out, const std::size_t n);
+	//[0.0, 1.0) の乱数で配列を埋める
+	inline void fillFloat(float* out, const std::size_t n);
+	//正規分布の乱数で配列を埋める
+	//※mean ... 平均、stddev ... 標準偏差
+	template<template<typename> class ARITH = fastA>
+	inline void fillNormal(float* out, const std::size_t n, const float mean = 0.f, const float stddev = 1.f);
+	//全ての系統の状態を 2^192 回分進める
+	//※一つのエンジンから、longJump() するごとにコピーを取ることで、重ならない一括生成エンジンをスレッド数分作れる。
+	inline void longJump();
+	//シードを設定
+	inline void seed(const std::uint64_t seed);
+	//エンジンから状態を設定
+	//※系統 i は、engine を i 回 jump() した状態から始まる
+	inline void seed(const xoshiro256pp& engine);
+public:
+	//コンストラクタ
+	inline xoshiro256ppBatch(const std::uint64_t seed = xoshiro256pp::DEFAULT_SEED);
+	inline xoshiro256ppBatch(const xoshiro256pp& engine);
+private:
+	//状態を steps 回更新し、32ビットの値を steps * U32_PER_STEP 個生成
+	//※T が float なら、[0.0, 1.0) の値に変換する
+	template<typename T>
+	inline void generate(T* out, const std::size_t steps);
+	//配列を埋める（端数の処理を含む）
+	template<typename T>
+	inline void fillImpl(T* out, const std::size_t n);
+private:
+	//フィールド
+	std::uint64_t m_s[4][LANE_NUM];//状態（状態の要素ごとに全系統を並べる）
+};
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/random_engine.inl>
+
+#endif//GASHA_INCLUDED_RANDOM_ENGINE_H
+
+// End of file
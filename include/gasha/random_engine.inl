@@ -0,0 +1,488 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_RANDOM_ENGINE_INL
+#define GASHA_INCLUDED_RANDOM_ENGINE_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ含む】
+// random_engine.inl
+// 乱数エンジン【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/random_engine.h>//乱数エンジン【宣言部】
+
+#include <cmath>//std::sqrt()
+#include <cstring>//std::memcpy()
+
+#if defined(GASHA_USE_AVX2) || defined(GASHA_DISPATCH_AVX2)
+#include <immintrin.h>//AVX2
+#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+
+#ifdef GASHA_DISPATCH_AVX2
+#include <gasha/cpu_features.h>//CPU機能判定
+#endif//GASHA_DISPATCH_AVX2
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+namespace _private
+{
+	//----------------------------------------
+	//文字列からシードを作成：再帰処理
+	inline constexpr std::uint64_t randomSeedFnv1a(const char* str, const std::uint64_t hash)
+	{
+		return *str == '\0' ? hash : randomSeedFnv1a(str + 1, (hash ^ static_cast<std::uint64_t>(static_cast<unsigned char>(*str))) * 0x100000001b3ull);
+	}
+	//----------------------------------------
+	//SplitMix64：ビット撹拌
+	inline constexpr std::uint64_t splitMix64Mix3(const std::uint64_t z)
+	{
+		return z ^ (z >> 31);
+	}
+	inline constexpr std::uint64_t splitMix64Mix2(const std::uint64_t z)
+	{
+		return splitMix64Mix3((z ^ (z >> 27)) * 0x94d049bb133111ebull);
+	}
+	inline constexpr std::uint64_t splitMix64Mix1(const std::uint64_t z)
+	{
+		return splitMix64Mix2((z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull);
+	}
+	//----------------------------------------
+	//SplitMix64（シードの拡張用）
+	inline constexpr std::uint64_t splitMix64(const std::uint64_t seed, const std::uint64_t index)
+	{
+		return splitMix64Mix1(seed + index * 0x9e3779b97f4a7c15ull);
+	}
+	//----------------------------------------
+	//64ビットの乱数を [0.0, 1.0) の float に変換
+	//※上位24ビットを使用する
+	inline float randomToFloat(const std::uint64_t value)
+	{
+		return static_cast<float>(value >> 40) * (1.f / 16777216.f);
+	}
+	//----------------------------------------
+	//64ビットの左回転
+	template<int SHIFT>
+	inline std::uint64_t randomRotl(const std::uint64_t value)
+	{
+		return (value << SHIFT) | (value >> (64 - SHIFT));
+	}
+}//namespace _private
+
+//----------------------------------------
+//文字列からシードを作成（64ビット FNV-1a）
+inline constexpr std::uint64_t randomSeed(const char* str)
+{
+	return str == nullptr ? 0 : _private::randomSeedFnv1a(str, 0xcbf29ce484222325ull);
+}
+
+//----------------------------------------
+//xoshiro256++
+
+//乱数を生成
+inline xoshiro256pp::result_type xoshiro256pp::operator()()
+{
+	const std::uint64_t result = _private::randomRotl<23>(m_s0 + m_s3) + m_s0;
+	const std::uint64_t t = m_s1 << 17;
+	m_s2 ^= m_s0;
+	m_s3 ^= m_s1;
+	m_s1 ^= m_s2;
+	m_s0 ^= m_s3;
+	m_s2 ^= t;
+	m_s3 = _private::randomRotl<45>(m_s3);
+	return result;
+}
+
+//32ビットの乱数を生成
+inline std::uint32_t xoshiro256pp::nextU32()
+{
+	return static_cast<std::uint32_t>((*this)() >> 32);
+}
+
+//[0.0, 1.0) の乱数を生成
+inline float xoshiro256pp::nextFloat()
+{
+	return _private::randomToFloat((*this)());
+}
+
+//状態を進める
+//※poly ... 状態遷移の多項式
+inline void xoshiro256pp::jump(const std::uint64_t (&poly)[4])
+{
+	std::uint64_t s0 = 0;
+	std::uint64_t s1 = 0;
+	std::uint64_t s2 = 0;
+	std::uint64_t s3 = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int bit = 0; bit < 64; ++bit)
+		{
+			if (poly[i] & (static_cast<std::uint64_t>(1) << bit))
+			{
+				s0 ^= m_s0;
+				s1 ^= m_s1;
+				s2 ^= m_s2;
+				s3 ^= m_s3;
+			}
+			(*this)();
+		}
+	}
+	m_s0 = s0;
+	m_s1 = s1;
+	m_s2 = s2;
+	m_s3 = s3;
+}
+
+//2^128 回分、状態を進める
+inline void xoshiro256pp::jump()
+{
+	static const std::uint64_t poly[4] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+	jump(poly);
+}
+
+//2^192 回分、状態を進める
+inline void xoshiro256pp::longJump()
+{
+	static const std::uint64_t poly[4] = { 0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull, 0x77710069854ee241ull, 0x39109bb02acbe635ull };
+	jump(poly);
+}
+
+//シードを設定
+inline void xoshiro256pp::seed(const std::uint64_t seed)
+{
+	m_s0 = _private::splitMix64(seed, 1);
+	m_s1 = _private::splitMix64(seed, 2);
+	m_s2 = _private::splitMix64(seed, 3);
+	m_s3 = _private::splitMix64(seed, 4);
+}
+
+//状態を取得
+inline std::uint64_t xoshiro256pp::state(const int index) const
+{
+	return index == 0 ? m_s0 : index == 1 ? m_s1 : index == 2 ? m_s2 : m_s3;
+}
+
+//状態を設定
+inline void xoshiro256pp::setState(const std::uint64_t s0, const std::uint64_t s1, const std::uint64_t s2, const std::uint64_t s3)
+{
+	m_s0 = s0;
+	m_s1 = s1;
+	m_s2 = s2;
+	m_s3 = s3;
+}
+
+//コンストラクタ
+inline constexpr xoshiro256pp::xoshiro256pp(const std::uint64_t seed) :
+	m_s0(_private::splitMix64(seed, 1)),
+	m_s1(_private::splitMix64(seed, 2)),
+	m_s2(_private::splitMix64(seed, 3)),
+	m_s3(_private::splitMix64(seed, 4))
+{}
+
+//----------------------------------------
+//PCG32（PCG-XSH-RR）
+
+//乱数を生成
+inline pcg32::result_type pcg32::operator()()
+{
+	const std::uint64_t old_state = m_state;
+	m_state = old_state * MULTIPLIER + m_inc;
+	const std::uint32_t xorshifted = static_cast<std::uint32_t>(((old_state >> 18) ^ old_state) >> 27);
+	const std::uint32_t rot = static_cast<std::uint32_t>(old_state >> 59);
+	return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+}
+
+//[0.0, 1.0) の乱数を生成
+inline float pcg32::nextFloat()
+{
+	return static_cast<float>((*this)() >> 8) * (1.f / 16777216.f);
+}
+
+//指定の回数分、状態を進める
+//※乗数と増分を二乗しながら合成し、O(log n) で進める
+inline void pcg32::advance(const std::uint64_t delta)
+{
+	std::uint64_t cur_mult = MULTIPLIER;
+	std::uint64_t cur_plus = m_inc;
+	std::uint64_t acc_mult = 1;
+	std::uint64_t acc_plus = 0;
+	for (std::uint64_t remain = delta; remain > 0; remain >>= 1)
+	{
+		if (remain & 1)
+		{
+			acc_mult *= cur_mult;
+			acc_plus = acc_plus * cur_mult + cur_plus;
+		}
+		cur_plus = (cur_mult + 1) * cur_plus;
+		cur_mult *= cur_mult;
+	}
+	m_state = acc_mult * m_state + acc_plus;
+}
+
+//2^48 回分、状態を進める
+inline void pcg32::jump()
+{
+	advance(static_cast<std::uint64_t>(1) << 48);
+}
+
+//シードを設定
+inline void pcg32::seed(const std::uint64_t seed, const std::uint64_t stream)
+{
+	m_inc = (stream << 1) | 1;
+	m_state = (m_inc + seed) * MULTIPLIER + m_inc;
+}
+
+//コンストラクタ
+//※状態を 0 にして1回進め、シードを足してもう1回進めた状態から始める（PCGの標準的な初期化と同じ）
+inline constexpr pcg32::pcg32(const std::uint64_t seed, const std::uint64_t stream) :
+	m_state((((stream << 1) | 1) + seed) * MULTIPLIER + ((stream << 1) | 1)),
+	m_inc((stream << 1) | 1)
+{}
+
+//----------------------------------------
+//xoshiro256++ 一括生成
+namespace _private
+{
+	//32ビットの値を格納
+	inline void randomBatchStore(std::uint32_t* out, const std::uint32_t value)
+	{
+		*out = value;
+	}
+	//32ビットの値を [0.0, 1.0) の float に変換して格納
+	inline void randomBatchStore(float* out, const std::uint32_t value)
+	{
+		*out = static_cast<float>(value >> 8) * (1.f / 16777216.f);
+	}
+
+#if defined(GASHA_USE_AVX2) || defined(GASHA_DISPATCH_AVX2)
+	//AVX2命令を使用するか？
+	//※実行時に振り分ける場合、CPUのAVX2命令対応を判定する
+	inline bool randomBatchIsAVX2()
+	{
+	#ifdef GASHA_USE_AVX2
+		return true;
+	#else//GASHA_USE_AVX2
+		return GASHA_ cpuFeatures::instance().hasAVX2();//実行時に判定（CPU機能の判定は初回のみ）
+	#endif//GASHA_USE_AVX2
+	}
+	//64ビットの左回転（4系統）
+	template<int SHIFT>
+	GASHA_TARGET_AVX2 inline __m256i randomRotl_avx2(const __m256i value)
+	{
+		return _mm256_or_si256(_mm256_slli_epi64(value, SHIFT), _mm256_srli_epi64(value, 64 - SHIFT));
+	}
+	//32ビットの値を格納（8個）
+	GASHA_TARGET_AVX2 inline void randomBatchStore_avx2(std::uint32_t* out, const __m256i value)
+	{
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), value);
+	}
+	//32ビットの値を [0.0, 1.0) の float に変換して格納（8個）
+	GASHA_TARGET_AVX2 inline void randomBatchStore_avx2(float* out, const __m256i value)
+	{
+		_mm256_storeu_ps(out, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(value, 8)), _mm256_set1_ps(1.f / 16777216.f)));
+	}
+	//AVX2命令版：4系統の状態を steps 回更新
+	//※AVX2命令に対応したCPUでのみ呼び出すこと
+	template<typename T>
+	GASHA_TARGET_AVX2 inline void randomBatchGenerate_avx2(std::uint64_t (&s)[4][xoshiro256ppBatch::LANE_NUM], T* out, const std::size_t steps)
+	{
+		__m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s[0]));
+		__m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s[1]));
+		__m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s[2]));
+		__m256i s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s[3]));
+		for (std::size_t step = 0; step < steps; ++step)
+		{
+			const __m256i result = _mm256_add_epi64(randomRotl_avx2<23>(_mm256_add_epi64(s0, s3)), s0);
+			const __m256i t = _mm256_slli_epi64(s1, 17);
+			s2 = _mm256_xor_si256(s2, s0);
+			s3 = _mm256_xor_si256(s3, s1);
+			s1 = _mm256_xor_si256(s1, s2);
+			s0 = _mm256_xor_si256(s0, s3);
+			s2 = _mm256_xor_si256(s2, t);
+			s3 = randomRotl_avx2<45>(s3);
+			randomBatchStore_avx2(out + step * xoshiro256ppBatch::U32_PER_STEP, result);
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(s[0]), s0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(s[1]), s1);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(s[2]), s2);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(s[3]), s3);
+	}
+#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+
+	//Box-Muller法で、[0.0, 1.0) の一様乱数16個を正規分布の乱数16個に変換
+	//※前半8個から半径、後半8個から角度を求め、前半に余弦、後半に正弦の成分を格納する
+	template<template<typename> class ARITH>
+	inline void randomBoxMuller(float* values, const float mean, const float stddev)
+	{
+		static const float TWO_PI = 6.28318530717958647692f;
+	#if defined(GASHA_FAST_ARITH_USE_AVX)
+		const __m256 u1_m256 = _mm256_sub_ps(_mm256_set1_ps(1.f), _mm256_loadu_ps(values));//(0.0, 1.0]
+		const __m256 u2_m256 = _mm256_loadu_ps(values + 8);
+		const __m256 radius_m256 = _mm256_mul_ps(_mm256_sqrt_ps(_mm256_mul_ps(_mm256_set1_ps(-2.f), GASHA_ fastLog<ARITH>(u1_m256))), _mm256_set1_ps(stddev));
+		__m256 sin_m256;
+		__m256 cos_m256;
+		GASHA_ fastSinCos<ARITH>(_mm256_mul_ps(u2_m256, _mm256_set1_ps(TWO_PI)), sin_m256, cos_m256);
+		const __m256 mean_m256 = _mm256_set1_ps(mean);
+		_mm256_storeu_ps(values, _mm256_add_ps(mean_m256, _mm256_mul_ps(radius_m256, cos_m256)));
+		_mm256_storeu_ps(values + 8, _mm256_add_ps(mean_m256, _mm256_mul_ps(radius_m256, sin_m256)));
+	#elif defined(GASHA_FAST_ARITH_USE_SSE2)
+		for (int half = 0; half < 8; half += 4)
+		{
+			const __m128 u1_m128 = _mm_sub_ps(_mm_set1_ps(1.f), _mm_loadu_ps(values + half));//(0.0, 1.0]
+			const __m128 u2_m128 = _mm_loadu_ps(values + 8 + half);
+			const __m128 radius_m128 = _mm_mul_ps(_mm_sqrt_ps(_mm_mul_ps(_mm_set1_ps(-2.f), GASHA_ fastLog<ARITH>(u1_m128))), _mm_set1_ps(stddev));
+			__m128 sin_m128;
+			__m128 cos_m128;
+			GASHA_ fastSinCos<ARITH>(_mm_mul_ps(u2_m128, _mm_set1_ps(TWO_PI)), sin_m128, cos_m128);
+			const __m128 mean_m128 = _mm_set1_ps(mean);
+			_mm_storeu_ps(values + half, _mm_add_ps(mean_m128, _mm_mul_ps(radius_m128, cos_m128)));
+			_mm_storeu_ps(values + 8 + half, _mm_add_ps(mean_m128, _mm_mul_ps(radius_m128, sin_m128)));
+		}
+	#else//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_USE_SSE2
+		for (int i = 0; i < 8; ++i)
+		{
+			const float radius = std::sqrt(-2.f * GASHA_ fastLog<ARITH>(1.f - values[i])) * stddev;
+			float sin_value;
+			float cos_value;
+			GASHA_ fastSinCos<ARITH>(values[i + 8] * TWO_PI, sin_value, cos_value);
+			values[i] = mean + radius * cos_value;
+			values[i + 8] = mean + radius * sin_value;
+		}
+	#endif//GASHA_FAST_ARITH_USE_AVX, GASHA_FAST_ARITH_USE_SSE2
+	}
+}//namespace _private
+
+//状態を steps 回更新し、32ビットの値を steps * U32_PER_STEP 個生成
+template<typename T>
+inline void xoshiro256ppBatch::generate(T* out, const std::size_t steps)
+{
+#if defined(GASHA_USE_AVX2) || defined(GASHA_DISPATCH_AVX2)
+	if (_private::randomBatchIsAVX2())
+	{
+		_private::randomBatchGenerate_avx2(m_s, out, steps);
+		return;
+	}
+#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+	//スカラー演算版
+	//※AVX2命令版と同じ順序（系統ごとに下位32ビット、上位32ビットの順）で格納する
+	for (std::size_t step = 0; step < steps; ++step)
+	{
+		for (int lane = 0; lane < LANE_NUM; ++lane)
+		{
+			std::uint64_t& s0 = m_s[0][lane];
+			std::uint64_t& s1 = m_s[1][lane];
+			std::uint64_t& s2 = m_s[2][lane];
+			std::uint64_t& s3 = m_s[3][lane];
+			const std::uint64_t result = _private::randomRotl<23>(s0 + s3) + s0;
+			const std::uint64_t t = s1 << 17;
+			s2 ^= s0;
+			s3 ^= s1;
+			s1 ^= s2;
+			s0 ^= s3;
+			s2 ^= t;
+			s3 = _private::randomRotl<45>(s3);
+			T* lane_out = out + step * U32_PER_STEP + lane * 2;
+			_private::randomBatchStore(lane_out, static_cast<std::uint32_t>(result));
+			_private::randomBatchStore(lane_out + 1, static_cast<std::uint32_t>(result >> 32));
+		}
+	}
+}
+
+//配列を埋める（端数の処理を含む）
+template<typename T>
+inline void xoshiro256ppBatch::fillImpl(T* out, const std::size_t n)
+{
+	const std::size_t steps = n / U32_PER_STEP;
+	generate(out, steps);
+	const std::size_t remain = n - steps * U32_PER_STEP;
+	if (remain > 0)
+	{
+		T tmp[U32_PER_STEP];
+		generate(tmp, 1);
+		std::memcpy(out + steps * U32_PER_STEP, tmp, sizeof(T) * remain);
+	}
+}
+
+//32ビットの乱数で配列を埋める
+inline void xoshiro256ppBatch::fill(std::uint32_t* out, const std::size_t n)
+{
+	fillImpl(out, n);
+}
+
+//[0.0, 1.0) の乱数で配列を埋める
+inline void xoshiro256ppBatch::fillFloat(float* out, const std::size_t n)
+{
+	fillImpl(out, n);
+}
+
+//正規分布の乱数で配列を埋める
+template<template<typename> class ARITH>
+inline void xoshiro256ppBatch::fillNormal(float* out, const std::size_t n, const float mean, const float stddev)
+{
+	static const std::size_t BLOCK_SIZE = U32_PER_STEP * 2;//Box-Muller法の1回の処理数
+	std::size_t i = 0;
+	for (; i + BLOCK_SIZE <= n; i += BLOCK_SIZE)
+	{
+		generate(out + i, 2);
+		_private::randomBoxMuller<ARITH>(out + i, mean, stddev);
+	}
+	if (i < n)
+	{
+		float tmp[BLOCK_SIZE];
+		generate(tmp, 2);
+		_private::randomBoxMuller<ARITH>(tmp, mean, stddev);
+		std::memcpy(out + i, tmp, sizeof(float) * (n - i));
+	}
+}
+
+//全ての系統の状態を 2^192 回分進める
+inline void xoshiro256ppBatch::longJump()
+{
+	for (int lane = 0; lane < LANE_NUM; ++lane)
+	{
+		xoshiro256pp engine;
+		engine.setState(m_s[0][lane], m_s[1][lane], m_s[2][lane], m_s[3][lane]);
+		engine.longJump();
+		for (int index = 0; index < 4; ++index)
+			m_s[index][lane] = engine.state(index);
+	}
+}
+
+//シードを設定
+inline void xoshiro256ppBatch::seed(const std::uint64_t seed)
+{
+	this->seed(xoshiro256pp(seed));
+}
+
+//エンジンから状態を設定
+inline void xoshiro256ppBatch::seed(const xoshiro256pp& engine)
+{
+	xoshiro256pp lane_engine = engine;
+	for (int lane = 0; lane < LANE_NUM; ++lane)
+	{
+		for (int index = 0; index < 4; ++index)
+			m_s[index][lane] = lane_engine.state(index);
+		lane_engine.jump();
+	}
+}
+
+//コンストラクタ
+inline xoshiro256ppBatch::xoshiro256ppBatch(const std::uint64_t seed)
+{
+	this->seed(seed);
+}
+inline xoshiro256ppBatch::xoshiro256ppBatch(const xoshiro256pp& engine)
+{
+	seed(engine);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_RANDOM_ENGINE_INL
+
+// End of file
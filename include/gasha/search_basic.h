@@ -13,6 +13,10 @@
 //     https://github.com/gakimaru/gasha/blob/master/LICENSE
 //--------------------------------------------------------------------------------
 
+#ifdef GASHA_IS_VC
+#include <intrin.h>//_BitScanForward64()
+#endif//GASHA_IS_VC
+
 GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 
 //========================================
@@ -48,6 +52,49 @@ struct compare_to{
 	}
 };
 
+//========================================
+//探索処理補助関数
+//========================================
+
+namespace _private
+{
+	//----------------------------------------
+	//下位から連続する 1 のビット数を数える
+	//※Eytzinger配置の探索終了位置の算出や、SIMDによる複数要素の比較結果（マスク）の集計に使用する。
+	inline unsigned int searchCountTrailingOnes(const unsigned long long value)
+	{
+		const unsigned long long inv = ~value;
+		if (inv == 0)
+			return 64;
+	#if defined(GASHA_IS_GCC)
+		return static_cast<unsigned int>(__builtin_ctzll(inv));
+	#elif defined(GASHA_IS_VC) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, inv);
+		return static_cast<unsigned int>(index);
+	#else
+		unsigned int count = 0;
+		for (unsigned long long bits = value; bits & 1; bits >>= 1)
+			++count;
+		return count;
+	#endif
+	}
+
+	//----------------------------------------
+	//1 のビット数を数える
+	//※SIMDによる複数要素の比較結果（マスク）の集計に使用する。
+	inline unsigned int searchCountBits(const unsigned int value)
+	{
+	#if defined(GASHA_IS_GCC)
+		return static_cast<unsigned int>(__builtin_popcount(value));
+	#else
+		unsigned int bits = value - ((value >> 1) & 0x55555555u);
+		bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+		return (((bits + (bits >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24;
+	#endif
+	}
+}//namespace _private
+
 //========================================
 //探索関数補助マクロ
 //========================================
@@ -246,6 +293,124 @@ struct compare_to{
 	GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_PREDICATE_OR_COMPARISON(func_name) \
 	GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_PREDICATE_ADN_VALUE(func_name) \
 	GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_DEFAULT_PREDICATE_AND_VALUE(func_name)
+//※探索値指定版：プレディケート関数と値で比較
+//※探索値とプレディケート関数を、そのまま本体（func_name##Value(T* array, size, value, predicate)）に渡す版
+//　本体側でプレディケート関数の型を判別して処理を切り替える場合に使用する。
+#define GASHA_OVERLOAD_SET_FOR_VALUE_SEARCH_WITH_PREDICATE(func_name) \
+	template<class T, typename V, class PREDICATE> \
+	inline const T* func_name##Value(const T* array, const std::size_t size, const V& value, PREDICATE predicate) \
+	{ \
+		return func_name##Value(const_cast<T*>(array), size, value, predicate); \
+	} \
+	template<class T, std::size_t N, typename V, class PREDICATE> \
+	inline T* func_name##Value(T(&array)[N], const V& value, PREDICATE predicate) \
+	{ \
+		return func_name##Value(array, N, value, predicate); \
+	} \
+	template<class T, std::size_t N, typename V, class PREDICATE> \
+	inline const T* func_name##Value(const T(&array)[N], const V& value, PREDICATE predicate) \
+	{ \
+		return func_name##Value(const_cast<T*>(array), N, value, predicate); \
+	} \
+	template<class T, typename V, class PREDICATE> \
+	inline T* func_name##Value(T* begin, T* end, const V& value, PREDICATE predicate) \
+	{ \
+		const std::size_t size = end - begin; \
+		return size == 0 ? nullptr : func_name##Value(begin, size, value, predicate); \
+	} \
+	template<class T, typename V, class PREDICATE> \
+	inline const T* func_name##Value(const T* begin, const T* end, const V& value, PREDICATE predicate) \
+	{ \
+		const std::size_t size = end - begin; \
+		return size == 0 ? nullptr : func_name##Value(const_cast<T*>(begin), size, value, predicate); \
+	} \
+	template<class ITERATOR, typename V, class PREDICATE> \
+	inline typename ITERATOR::value_type* func_name##Value(ITERATOR& begin, ITERATOR& end, const V& value, PREDICATE predicate) \
+	{ \
+		const std::size_t size = end - begin; \
+		return size == 0 ? nullptr : func_name##Value(&begin[0], size, value, predicate); \
+	} \
+	template<class ITERATOR, typename V, class PREDICATE> \
+	inline const typename ITERATOR::value_type* func_name##Value(const ITERATOR& begin, const ITERATOR& end, const V& value, PREDICATE predicate) \
+	{ \
+		const std::size_t size = end - begin; \
+		return size == 0 ? nullptr : func_name##Value(const_cast<typename ITERATOR::value_type*>(&begin[0]), size, value, predicate); \
+	} \
+	template<class CONTAINER, typename V, class PREDICATE> \
+	inline typename CONTAINER::value_type* func_name##Value(CONTAINER& con, const V& value, PREDICATE predicate) \
+	{ \
+		const std::size_t size = con.size(); \
+		return size == 0 ? nullptr : func_name##Value(&(con.at(0)), size, value, predicate); \
+	} \
+	template<class CONTAINER, typename V, class PREDICATE> \
+	inline const typename CONTAINER::value_type* func_name##Value(const CONTAINER& con, const V& value, PREDICATE predicate) \
+	{ \
+		const std::size_t size = con.size(); \
+		return size == 0 ? nullptr : func_name##Value(&(const_cast<CONTAINER*>(&con)->at(0)), size, value, predicate); \
+	}
+//※探索値指定版：標準のプレディケート関数と値で比較
+//※標準のプレディケート関数（equal_to）を、そのまま本体に渡す版
+#define GASHA_OVERLOAD_SET_FOR_VALUE_SEARCH_WITH_DEFAULT_PREDICATE(func_name) \
+	template<class T, typename V> \
+	inline T* func_name##Value(T* array, const std::size_t size, const V& value) \
+	{ \
+		return func_name##Value(array, size, value, equal_to<T>()); \
+	} \
+	template<class T, typename V> \
+	inline const T* func_name##Value(const T* array, const std::size_t size, const V& value) \
+	{ \
+		return func_name##Value(const_cast<T*>(array), size, value, equal_to<T>()); \
+	} \
+	template<class T, std::size_t N, typename V> \
+	inline T* func_name##Value(T(&array)[N], const V& value) \
+	{ \
+		return func_name##Value(array, N, value, equal_to<T>()); \
+	} \
+	template<class T, std::size_t N, typename V> \
+	inline const T* func_name##Value(const T(&array)[N], const V& value) \
+	{ \
+		return func_name##Value(const_cast<T*>(array), N, value, equal_to<T>()); \
+	} \
+	template<class T, typename V> \
+	inline T* func_name##Value(T* begin, T* end, const V& value) \
+	{ \
+		const std::size_t size = end - begin; \
+		return size == 0 ? nullptr : func_name##Value(begin, size, value, equal_to<T>()); \
+	} \
+	template<class T, typename V> \
+	inline const T* func_name##Value(const T* begin, const T* end, const V& value) \
+	{ \
+		const std::size_t size = end - begin; \
+		return size == 0 ? nullptr : func_name##Value(const_cast<T*>(begin), size, value, equal_to<T>()); \
+	} \
+	template<class ITERATOR, typename V> \
+	inline typename ITERATOR::value_type* func_name##Value(ITERATOR& begin, ITERATOR& end, const V& value) \
+	{ \
+		const std::size_t size = end - begin; \
+		return size == 0 ? nullptr : func_name##Value(&begin[0], size, value, equal_to<typename ITERATOR::value_type>()); \
+	} \
+	template<class ITERATOR, typename V> \
+	inline const typename ITERATOR::value_type* func_name##Value(const ITERATOR& begin, const ITERATOR& end, const V& value) \
+	{ \
+		const std::size_t size = end - begin; \
+		return size == 0 ? nullptr : func_name##Value(const_cast<typename ITERATOR::value_type*>(&begin[0]), size, value, equal_to<typename ITERATOR::value_type>()); \
+	} \
+	template<class CONTAINER, typename V> \
+	inline typename CONTAINER::value_type* func_name##Value(CONTAINER& con, const V& value) \
+	{ \
+		const std::size_t size = con.size(); \
+		return size == 0 ? nullptr : func_name##Value(&(con.at(0)), size, value, equal_to<typename CONTAINER::value_type>()); \
+	} \
+	template<class CONTAINER, typename V> \
+	inline const typename CONTAINER::value_type* func_name##Value(const CONTAINER& con, const V& value) \
+	{ \
+		const std::size_t size = con.size(); \
+		return size == 0 ? nullptr : func_name##Value(&(const_cast<CONTAINER*>(&con)->at(0)), size, value, equal_to<typename CONTAINER::value_type>()); \
+	}
+#define GASHA_OVERLOAD_SET_FOR_VALUE_SEARCH(func_name) \
+	GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_PREDICATE_OR_COMPARISON(func_name) \
+	GASHA_OVERLOAD_SET_FOR_VALUE_SEARCH_WITH_PREDICATE(func_name) \
+	GASHA_OVERLOAD_SET_FOR_VALUE_SEARCH_WITH_DEFAULT_PREDICATE(func_name)
 //※探索値指定版：比較関数と値で比較
 #define GASHA_OVERLOAD_SET_FOR_SEARCH_WITH_COMPARISON_AND_VALUE(func_name) \
 	template<class T, typename V, class COMPARISON> \
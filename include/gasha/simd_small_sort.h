@@ -0,0 +1,88 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_SIMD_SMALL_SORT_H
+#define GASHA_INCLUDED_SIMD_SMALL_SORT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// simd_small_sort.h
+// SIMD小規模ソート【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/sort_basic.h>//ソート処理基本
+
+#include <functional>//std::less
+#include <type_traits>//C++11 std::integral_constant
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズムの説明
+//========================================
+
+//・計算時間：
+//    - O(n)       ... データ件数分の時間
+//    - O(n ^ 2)   ... データ件数の２乗分の時間
+//    - O(log n)   ... log2(データ件数)分の時間（4→2, 16→4, 1024→10,1048576→20）
+//    - O(n log n) ... n×log n 分の時間
+//・メモリ使用量：
+//    - O(1)       ... １件分のメモリが必要
+//    - O(n)       ... データ件数分のメモリが必要
+//    - O(log n)   ... log2(データ件数)分のメモリが必要
+//・安定性：
+//    - ○         ... キーが同じデータの順序性が維持されることを保証する
+//                     例：{ 3-a, 5-b, 4-c, 5-d, 9-e, 3-f, 4-g, 3-h, 5-i } → { 3-a, 3-f, 3-h, 4-c, 4-g, 5-b, 5-d, 5-i, 9-e }
+//    - ×         ... 例：(同上)                        
+
+//========================================
+//ソートアルゴリズム分類：ソーティングネットワーク
+//========================================
+
+//----------------------------------------
+//アルゴリズム：SIMD小規模ソート（バイトニックソーティングネットワーク）
+//----------------------------------------
+//・最良計算時間：O(log^2 n) ※n≦64、レジスタ数×段数分のSIMD演算
+//・平均計算時間：O(log^2 n)
+//・最悪計算時間：O(log^2 n)
+//・メモリ使用量：O(1) ※最大64件分の一時領域
+//・安定性：　　　×
+//----------------------------------------
+//※AVX2命令を使用し、8/16/32/64件の std::int32_t, std::uint32_t, float の配列を、
+//　レジスタ上のバイトニックソーティングネットワークで昇順に整列する。
+//※件数が 8/16/32/64 件に満たない場合は、最大値で埋めて次のサイズのネットワークで整列する。
+//※プレディケート関数が less<T>（GASHA）または std::less<T> で、要素型が上記の型の場合のみSIMD版を使用する。
+//　それ以外の場合や、件数が64件を超える場合、AVX2が無効な場合は、シェルソートに切り替える。
+//※ビルド設定 GASHA_USE_RUNTIME_CPU_DISPATCH が有効で、AVX2命令がコンパイル時に無効な場合、
+//　CPUのAVX2命令対応を実行時に判定し、対応していなければシェルソートに切り替える。
+//※比較と分岐を伴わないため、イントロソートの小規模配列の整列処理としても使用する。
+//※SIMD版は交換回数を数えない（常に 0 を返す）。
+//※float の場合、NaN を含む配列の結果は不定。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value1, const T& value2)//value1 == value2 ならtrueを返す
+template<class T, class PREDICATE>
+inline std::size_t simdSmallSort(T* array, const std::size_t size, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_SORT(simdSmallSort);
+
+//----------------------------------------
+//SIMD小規模ソートの最大件数
+static const std::size_t SIMD_SMALL_SORT_SIZE_MAX = 64;
+
+//----------------------------------------
+//SIMD小規模ソートが使用可能な型とプレディケート関数の組み合わせか？
+//※AVX2が無効な場合は常に false（実行時に振り分ける場合は、CPUの対応に関わらず true）
+template<class T, class PREDICATE>
+struct isSimdSmallSortable;
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/simd_small_sort.inl>
+
+#endif//GASHA_INCLUDED_SIMD_SMALL_SORT_H
+
+// End of file
@@ -0,0 +1,242 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_SIMD_SMALL_SORT_INL
+#define GASHA_INCLUDED_SIMD_SMALL_SORT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// simd_small_sort.inl
+// SIMD小規模ソート【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/simd_small_sort.h>//SIMD小規模ソート【宣言部】
+
+#include <gasha/shell_sort.h>//シェルソート
+#include <gasha/limits.h>//限界値
+
+#include <cstdint>//C++11 std::int32_t, std::uint32_t
+#include <cstring>//std::memcpy()
+
+#if defined(GASHA_USE_AVX2) || defined(GASHA_DISPATCH_AVX2)
+#include <immintrin.h>//AVX2
+#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+
+#ifdef GASHA_DISPATCH_AVX2
+#include <gasha/cpu_features.h>//CPU機能判定
+#endif//GASHA_DISPATCH_AVX2
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズム分類：ソーティングネットワーク
+//========================================
+
+//----------------------------------------
+//SIMD小規模ソートが使用可能な型とプレディケート関数の組み合わせか？
+namespace _private
+{
+	//SIMD対応の要素型か？
+	template<class T>
+	struct isSimdSmallSortType : std::integral_constant<bool,
+	#if defined(GASHA_USE_AVX2) || defined(GASHA_DISPATCH_AVX2)
+		std::is_same<T, std::int32_t>::value ||
+		std::is_same<T, std::uint32_t>::value ||
+		std::is_same<T, float>::value
+	#else//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+		false
+	#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+	>{};
+	//昇順のプレディケート関数か？
+	template<class T, class PREDICATE>
+	struct isSimdSmallSortPredicate : std::integral_constant<bool,
+		std::is_same<PREDICATE, GASHA_ less<T>>::value ||
+		std::is_same<PREDICATE, std::less<T>>::value
+	>{};
+}//namespace _private
+template<class T, class PREDICATE>
+struct isSimdSmallSortable : std::integral_constant<bool,
+	_private::isSimdSmallSortType<T>::value &&
+	_private::isSimdSmallSortPredicate<T, PREDICATE>::value
+>{};
+
+//----------------------------------------
+//アルゴリズム：SIMD小規模ソート
+namespace _private
+{
+#if defined(GASHA_USE_AVX2) || defined(GASHA_DISPATCH_AVX2)
+	//SIMD演算
+	//※実行時に振り分ける場合、AVX2命令に対応したCPUでのみ呼び出すこと
+	template<class T>
+	struct simdSmallSortOpe;
+	//※std::int32_t用
+	template<>
+	struct simdSmallSortOpe<std::int32_t>
+	{
+		typedef std::int32_t value_type;
+		typedef __m256i vec_type;
+		GASHA_TARGET_AVX2 inline static vec_type load(const value_type* p){ return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+		GASHA_TARGET_AVX2 inline static void store(value_type* p, const vec_type v){ _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+		GASHA_TARGET_AVX2 inline static vec_type min(const vec_type a, const vec_type b){ return _mm256_min_epi32(a, b); }
+		GASHA_TARGET_AVX2 inline static vec_type max(const vec_type a, const vec_type b){ return _mm256_max_epi32(a, b); }
+		GASHA_TARGET_AVX2 inline static vec_type permute(const vec_type v, const __m256i idx){ return _mm256_permutevar8x32_epi32(v, idx); }
+		GASHA_TARGET_AVX2 inline static vec_type blend(const vec_type a, const vec_type b, const __m256i mask){ return _mm256_blendv_epi8(a, b, mask); }
+		inline static value_type maxValue(){ return GASHA_ numeric_limits<value_type>::MAX; }
+	};
+	//※std::uint32_t用
+	template<>
+	struct simdSmallSortOpe<std::uint32_t>
+	{
+		typedef std::uint32_t value_type;
+		typedef __m256i vec_type;
+		GASHA_TARGET_AVX2 inline static vec_type load(const value_type* p){ return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+		GASHA_TARGET_AVX2 inline static void store(value_type* p, const vec_type v){ _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+		GASHA_TARGET_AVX2 inline static vec_type min(const vec_type a, const vec_type b){ return _mm256_min_epu32(a, b); }
+		GASHA_TARGET_AVX2 inline static vec_type max(const vec_type a, const vec_type b){ return _mm256_max_epu32(a, b); }
+		GASHA_TARGET_AVX2 inline static vec_type permute(const vec_type v, const __m256i idx){ return _mm256_permutevar8x32_epi32(v, idx); }
+		GASHA_TARGET_AVX2 inline static vec_type blend(const vec_type a, const vec_type b, const __m256i mask){ return _mm256_blendv_epi8(a, b, mask); }
+		inline static value_type maxValue(){ return GASHA_ numeric_limits<value_type>::MAX; }
+	};
+	//※float用
+	template<>
+	struct simdSmallSortOpe<float>
+	{
+		typedef float value_type;
+		typedef __m256 vec_type;
+		GASHA_TARGET_AVX2 inline static vec_type load(const value_type* p){ return _mm256_load_ps(p); }
+		GASHA_TARGET_AVX2 inline static void store(value_type* p, const vec_type v){ _mm256_store_ps(p, v); }
+		GASHA_TARGET_AVX2 inline static vec_type min(const vec_type a, const vec_type b){ return _mm256_min_ps(a, b); }
+		GASHA_TARGET_AVX2 inline static vec_type max(const vec_type a, const vec_type b){ return _mm256_max_ps(a, b); }
+		GASHA_TARGET_AVX2 inline static vec_type permute(const vec_type v, const __m256i idx){ return _mm256_permutevar8x32_ps(v, idx); }
+		GASHA_TARGET_AVX2 inline static vec_type blend(const vec_type a, const vec_type b, const __m256i mask){ return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(mask)); }
+		inline static value_type maxValue(){ return GASHA_ numeric_limits<value_type>::infinity(); }
+	};
+
+	//バイトニックソーティングネットワーク
+	//※REG_NUM 個のレジスタ（REG_NUM×8件）を昇順に整列する。
+	//※要素 i（= レジスタ番号×8＋レーン番号）と要素 i^j を比較交換し、
+	//　(i & k) が 0 なら昇順、0 以外なら降順にする。
+	//※j が 8 以上ならレジスタ間、8 未満ならレジスタ内（レーンの入れ替え）で比較交換する。
+	template<class T, int REG_NUM>
+	GASHA_TARGET_AVX2 inline void simdSmallSortNetwork(typename simdSmallSortOpe<T>::vec_type* v)
+	{
+		typedef simdSmallSortOpe<T> ope;
+		typedef typename ope::vec_type vec_type;
+		static const int SIZE = REG_NUM * 8;
+		const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+		for (int k = 2; k <= SIZE; k <<= 1)
+		{
+			for (int j = k >> 1; j > 0; j >>= 1)
+			{
+				if (REG_NUM > 1 && j >= 8)//※REG_NUM が 1 の時は j < 8
+				{
+					//レジスタ間の比較交換
+					//※k > j >= 8 なので、昇順／降順はレジスタ単位で決まる
+					const int reg_j = j >> 3;
+					for (int reg = 0; reg < REG_NUM; ++reg)
+					{
+						const int partner = reg ^ reg_j;
+						if (partner < reg)
+							continue;
+						const vec_type min_v = ope::min(v[reg], v[partner]);
+						const vec_type max_v = ope::max(v[reg], v[partner]);
+						const bool is_desc = ((reg << 3) & k) != 0;
+						v[reg] = is_desc ? max_v : min_v;
+						v[partner] = is_desc ? min_v : max_v;
+					}
+				}
+				else
+				{
+					//レジスタ内の比較交換
+					const __m256i j_v = _mm256_set1_epi32(j);
+					const __m256i k_v = _mm256_set1_epi32(k);
+					const __m256i idx = _mm256_xor_si256(lane, j_v);//比較相手のレーン
+					const __m256i is_upper = _mm256_cmpeq_epi32(_mm256_and_si256(lane, j_v), j_v);//比較相手より後ろのレーンか？
+					for (int reg = 0; reg < REG_NUM; ++reg)
+					{
+						const __m256i index = _mm256_add_epi32(lane, _mm256_set1_epi32(reg << 3));
+						const __m256i is_desc = _mm256_cmpeq_epi32(_mm256_and_si256(index, k_v), k_v);//降順か？
+						const __m256i take_max = _mm256_xor_si256(is_upper, is_desc);//大きい方を取るレーン
+						const vec_type partner = ope::permute(v[reg], idx);
+						v[reg] = ope::blend(ope::min(v[reg], partner), ope::max(v[reg], partner), take_max);
+					}
+				}
+			}
+		}
+	}
+
+	//SIMD小規模ソート（ネットワークサイズ指定）
+	template<class T, int REG_NUM>
+	GASHA_TARGET_AVX2 inline void simdSmallSortExec(T* array, const std::size_t size)
+	{
+		typedef simdSmallSortOpe<T> ope;
+		typedef typename ope::vec_type vec_type;
+		static const std::size_t SIZE = REG_NUM * 8;
+		alignas(32) T buff[SIZE];
+		std::memcpy(buff, array, sizeof(T) * size);
+		const T max_value = ope::maxValue();
+		for (std::size_t index = size; index < SIZE; ++index)//最大値で埋める
+			buff[index] = max_value;
+		vec_type v[REG_NUM];
+		for (int reg = 0; reg < REG_NUM; ++reg)
+			v[reg] = ope::load(buff + reg * 8);
+		simdSmallSortNetwork<T, REG_NUM>(v);
+		for (int reg = 0; reg < REG_NUM; ++reg)
+			ope::store(buff + reg * 8, v[reg]);
+		std::memcpy(array, buff, sizeof(T) * size);
+	}
+#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+
+	//SIMD小規模ソート（処理の振り分け）
+	template<class T, class PREDICATE, bool IS_SIMD = isSimdSmallSortable<T, PREDICATE>::value>
+	struct simdSmallSort
+	{
+		inline static std::size_t exec(T* array, const std::size_t size, PREDICATE predicate)
+		{
+			return GASHA_ shellSort(array, size, predicate);//シェルソートに切り替え
+		}
+	};
+#if defined(GASHA_USE_AVX2) || defined(GASHA_DISPATCH_AVX2)
+	template<class T, class PREDICATE>
+	struct simdSmallSort<T, PREDICATE, true>
+	{
+		inline static std::size_t exec(T* array, const std::size_t size, PREDICATE predicate)
+		{
+		#ifndef GASHA_USE_AVX2
+			//実行時のCPU機能判定による振り分け
+			if (!GASHA_ cpuFeatures::instance().hasAVX2())
+				return GASHA_ shellSort(array, size, predicate);//シェルソートに切り替え
+		#endif//GASHA_USE_AVX2
+			if (size <= 8)
+				simdSmallSortExec<T, 1>(array, size);
+			else if (size <= 16)
+				simdSmallSortExec<T, 2>(array, size);
+			else if (size <= 32)
+				simdSmallSortExec<T, 4>(array, size);
+			else if (size <= 64)
+				simdSmallSortExec<T, 8>(array, size);
+			else
+				return GASHA_ shellSort(array, size, predicate);//シェルソートに切り替え
+			return 0;
+		}
+	};
+#endif//GASHA_USE_AVX2, GASHA_DISPATCH_AVX2
+}//namespace _private
+template<class T, class PREDICATE>
+inline std::size_t simdSmallSort(T* array, const std::size_t size, PREDICATE predicate)
+{
+	if (!array || size <= 1)
+		return 0;
+	return _private::simdSmallSort<T, PREDICATE>::exec(array, size, predicate);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_SIMD_SMALL_SORT_INL
+
+// End of file
@@ -13,6 +13,9 @@
 //     https://github.com/gakimaru/gasha/blob/master/LICENSE
 //--------------------------------------------------------------------------------
 
+#include <cstddef>//std::size_t
+#include <utility>//C++11 std::declval, std::forward
+
 GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
 
 //========================================
@@ -48,6 +51,38 @@ struct less{
 	}
 };
 
+//----------------------------------------
+//比較回数計測用プレディケート関数オブジェクト：countingPredicate
+//※ラップしたプレディケート関数（または探索用の比較関数）を呼び出すたびに、カウンタを加算する。
+//※ソート／探索アルゴリズムの比較回数の計測（ベンチマーク）に使用する。
+//※アルゴリズムはプレディケート関数を値渡しでコピーして扱うため、回数は参照先のカウンタに集計する。
+//※SIMD版を持つアルゴリズムは、プレディケート関数が less<T> などの場合のみSIMD版を使用するため、
+//　このオブジェクトでラップすると通常版の処理になる点に注意。
+template<class PREDICATE>
+struct countingPredicate{
+	template<typename... Tx>
+	inline auto operator()(Tx&&... args) const -> decltype(std::declval<const PREDICATE&>()(std::forward<Tx>(args)...))
+	{
+		++m_counter;
+		return m_predicate(std::forward<Tx>(args)...);
+	}
+	inline countingPredicate(PREDICATE predicate, std::size_t& counter) :
+		m_predicate(predicate),
+		m_counter(counter)
+	{}
+	PREDICATE m_predicate;//ラップしたプレディケート関数
+	std::size_t& m_counter;//比較回数のカウンタ
+};
+//※型を推論して作成
+//【使用例】
+//  std::size_t compare_count = 0;
+//  const std::size_t swapped_count = introSort(array, size, makeCountingPredicate(less<int>(), compare_count));
+template<class PREDICATE>
+inline countingPredicate<PREDICATE> makeCountingPredicate(PREDICATE predicate, std::size_t& counter)
+{
+	return countingPredicate<PREDICATE>(predicate, counter);
+}
+
 //========================================
 //ソート関数補助マクロ
 //========================================
@@ -185,6 +220,66 @@ struct less{
 #define GASHA_OVERLOAD_SET_FOR_DISTRIBUTED_SORT(func_name) \
 	GASHA_OVERLOAD_SET_FOR_DISTRIBUTED_SORT_WITH_FUNCTOR(func_name)
 
+//----------------------------------------
+//選択処理オーバーロード関数用マクロ
+//※nthElement(), partialSort() など、配列とサイズの後に位置（件数）を指定する関数用
+//※プレディケート関数指定版
+#define GASHA_OVERLOAD_SET_FOR_SELECTION_WITH_PREDICATE(func_name) \
+	template<class T, std::size_t N, class PREDICATE> \
+	inline std::size_t func_name(T(&array)[N], const std::size_t nth, PREDICATE predicate) \
+	{ \
+		return func_name(array, N, nth, predicate); \
+	} \
+	template<class T, class PREDICATE> \
+	inline std::size_t func_name(T* begin, T* end, const std::size_t nth, PREDICATE predicate) \
+	{ \
+		const std::size_t size = end - begin; \
+		return size == 0 ? 0 : func_name(begin, size, nth, predicate); \
+	} \
+	template<class ITERATOR, class PREDICATE> \
+	inline std::size_t func_name(ITERATOR& begin, ITERATOR& end, const std::size_t nth, PREDICATE predicate) \
+	{ \
+		const std::size_t size = end - begin; \
+		return size == 0 ? 0 : func_name(&begin[0], size, nth, predicate); \
+	} \
+	template<class CONTAINER, class PREDICATE> \
+	inline std::size_t func_name(CONTAINER& con, const std::size_t nth, PREDICATE predicate) \
+	{ \
+		const std::size_t size = con.size(); \
+		return size == 0 ? 0 : func_name(&(con.at(0)), size, nth, predicate); \
+	}
+//※標準プレディケート関数使用版
+#define GASHA_OVERLOAD_SET_FOR_SELECTION_WITH_DEFAULT_PREDICATE(func_name) \
+	template<class T> \
+	inline std::size_t func_name(T* array, const std::size_t size, const std::size_t nth) \
+	{ \
+		return func_name(array, size, nth, less<T>()); \
+	} \
+	template<class T, std::size_t N> \
+	inline std::size_t func_name(T(&array)[N], const std::size_t nth) \
+	{ \
+		return func_name(array, nth, less<T>()); \
+	} \
+	template<class T> \
+	inline std::size_t func_name(T* begin, T* end, const std::size_t nth) \
+	{ \
+		return func_name(begin, end, nth, less<T>()); \
+	} \
+	template<class ITERATOR> \
+	inline std::size_t func_name(ITERATOR& begin, ITERATOR& end, const std::size_t nth) \
+	{ \
+		return func_name(begin, end, nth, less<typename ITERATOR::value_type>()); \
+	} \
+	template<class CONTAINER> \
+	inline std::size_t func_name(CONTAINER& con, const std::size_t nth) \
+	{ \
+		return func_name(con, nth, less<typename CONTAINER::value_type>()); \
+	}
+//※全種
+#define GASHA_OVERLOAD_SET_FOR_SELECTION(func_name) \
+	GASHA_OVERLOAD_SET_FOR_SELECTION_WITH_PREDICATE(func_name) \
+	GASHA_OVERLOAD_SET_FOR_SELECTION_WITH_DEFAULT_PREDICATE(func_name)
+
 GASHA_NAMESPACE_END;//ネームスペース：終了
 
 #endif//GASHA_INCLUDED_SORT_BASIC_H
@@ -0,0 +1,358 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_SORT_BENCHMARK_H
+#define GASHA_INCLUDED_SORT_BENCHMARK_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// sort_benchmark.h
+// ソート／探索ベンチマーク【宣言部】
+//
+// ※全てのソート／探索アルゴリズムのヘッダーをインクルードするため、
+// 　ユニットテストなどのソースファイルでインクルードすること。
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/allocator_common.h>//メモリアロケータ共通設定
+#include <gasha/sort_basic.h>//ソート処理基本
+#include <gasha/search_basic.h>//探索処理基本
+#include <gasha/i_console.h>//コンソールインターフェース
+#include <gasha/benchmark_report.h>//ベンチマーク共通処理
+
+#include <cstddef>//std::size_t
+#include <cstdint>//C++11 std::uint32_t, std::uint64_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//ソート／探索ベンチマーク
+//※入力データの種類 × 要素のサイズ × 件数 の組み合わせごとに、全てのソート／探索アルゴリズムを実行し、
+//　処理時間、比較回数、交換回数、メモリ使用量のピークを計測する。
+//　・入力データ ... 乱数、整列済み、逆順、少種類（16種類の値）、Zipf分布（s=1 の連続近似）
+//　・要素サイズ ... 4バイト（std::uint32_t）、8バイト（std::uint64_t）、16バイト／64バイト（32ビットのキー＋ペイロード）
+//　・件数       ... 10件から10倍ずつ、条件の最大件数（デフォルトは1000万件）まで
+//　（入力データは固定シードの xoshiro256pp で作るため、毎回同じ内容になる）
+//※計測項目
+//　・処理時間 ... ソートは１要素あたり（ns/要素）、探索は１回あたり（ns/回）
+//　　件数が少ない場合は、件数×回数が条件の一定数（repeatElementNum）以上になるように、
+//　　入力データのコピーを複数用意してまとめて計測する。（コピーの時間は含まない）
+//　・比較回数 ... countingPredicate でプレディケート関数（探索は比較関数）をラップして、別途実行して数える。
+//　　（SIMD版の処理を持つアルゴリズムも、ラップすると通常版の処理になるため、処理時間の計測とは分けている）
+//　　分布ソート（基数ソート）と静的探索木は比較関数を使用しないため 0 になる。
+//　・交換回数 ... ソート関数の戻り値。（アルゴリズムごとに数え方が異なるので、同じアルゴリズムの比較にのみ使用する）
+//　・メモリ使用量のピーク ... ソート中に new で確保された作業領域のバイト数の最大値。
+//　　比較回数の計測時に、多態アロケータ（polyAllocator）にピークを記録するアロケータをセットして計測する。
+//　　そのため、GASHA_ENABLE_POLY_ALLOCATOR が無効な場合や、_aligned_malloc() で確保する領域、
+//　　OpenMP のワーカースレッドで確保する領域は計測できない。（再帰のスタックも含まない）
+//　　探索は、探索用に作成する配置（Eytzinger配置、静的探索木）のバイト数。
+//※計算量が O(n^2) のソートは slowSortSizeMax 件まで、O(n log^2 n) 程度のソート（シェアソート、
+//　インプレースマージソート）と線形探索は mediumSortSizeMax 件までに制限する。
+//　また、配列１本のサイズが arrayBytesMax を超える組み合わせは実行しない。
+//※全アルゴリズムの整列／探索結果を検証し、全て正しければ true を返す。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //コンソールに表を出力しつつ、CSVをバッファに作成
+//  static char csv[1024 * 1024];
+//  std::size_t csv_len;
+//  sortBenchmarkPrint(stdOutConsole::instance(), csv, sizeof(csv), csv_len);
+//
+//  //件数を制限して、表とCSVをバッファに作成
+//  sortBenchmark::condition cond;
+//  cond.m_sizeMax = 100000;
+//  static char table[1024 * 1024];
+//  std::size_t table_len;
+//  sortBenchmarkReport(table, sizeof(table), table_len, csv, sizeof(csv), csv_len, cond);
+//
+//  //ユニットテストで実行（計測結果を表示し、全ての結果が正しいか判定）
+//  GASHA_UT_BEGIN(sort_benchmark, 0, GASHA_ ut::ATTR_MANUAL)
+//  {
+//      GASHA_UT_SORT_BENCHMARK(10000000);
+//  }
+//  GASHA_UT_END()
+//--------------------------------------------------------------------------------
+
+namespace sortBenchmark
+{
+	//入力データの種類
+	enum input_type
+	{
+		inputRandom = 0,//乱数
+		inputSorted,//整列済み
+		inputReverse,//逆順に整列済み
+		inputFewUnique,//少種類の値（FEW_UNIQUE_NUM 種類）
+		inputZipf,//Zipf分布（上位の値ほど出現頻度が高い）
+	};
+	static const int INPUT_TYPE_NUM = 5;//入力データの種類数
+	static const std::uint64_t FEW_UNIQUE_NUM = 16;//少種類の値の種類数
+	static const std::uint64_t SEED = 0x5eed5eed5eed5eedull;//入力データ作成用の乱数のシード
+	//入力データの種類名
+	inline const char* inputName(const input_type input);
+
+	//要素型
+	//※32ビットのキーとペイロードで、指定のサイズにする
+	template<std::size_t SIZE>
+	struct element
+	{
+		static_assert(SIZE > sizeof(std::uint32_t), "SIZE must be greater than sizeof(std::uint32_t).");
+		std::uint32_t m_key;//キー
+		unsigned char m_payload[SIZE - sizeof(std::uint32_t)];//ペイロード
+		inline bool operator<(const element& rhs) const { return m_key < rhs.m_key; }
+		inline bool operator==(const element& rhs) const { return m_key == rhs.m_key; }
+	};
+
+	//キー取得用関数オブジェクト（分布ソート用）
+	template<class T>
+	struct getKey;
+	template<>
+	struct getKey<std::uint32_t>
+	{
+		typedef std::uint32_t key_type;
+		inline key_type operator()(const std::uint32_t& value) const { return value; }
+	};
+	template<>
+	struct getKey<std::uint64_t>
+	{
+		typedef std::uint64_t key_type;
+		inline key_type operator()(const std::uint64_t& value) const { return value; }
+	};
+	template<std::size_t SIZE>
+	struct getKey<element<SIZE>>
+	{
+		typedef std::uint32_t key_type;
+		inline key_type operator()(const element<SIZE>& value) const { return value.m_key; }
+	};
+
+	//計測条件
+	struct condition
+	{
+		std::size_t m_sizeMin;//最小件数（10倍ずつ最大件数まで計測）
+		std::size_t m_sizeMax;//最大件数
+		std::size_t m_slowSortSizeMax;//O(n^2) のソートの最大件数
+		std::size_t m_mediumSortSizeMax;//O(n log^2 n) 程度のソートと線形探索の最大件数
+		std::size_t m_arrayBytesMax;//配列１本の最大バイト数
+		std::size_t m_repeatElementNum;//１回の計測でソートする最小の要素数（件数×回数）
+		std::size_t m_searchQueryNum;//１回の計測で探索する回数
+		inline condition();
+	};
+
+	//計測結果
+	struct result
+	{
+		const char* m_algorithmName;//アルゴリズム名
+		bool m_isSearch;//探索か？（false ならソート）
+		input_type m_input;//入力データの種類
+		std::size_t m_elementSize;//要素のサイズ
+		std::size_t m_size;//件数
+		double m_nsPerElement;//処理時間：ソートは１要素あたり、探索は１回あたり（ナノ秒）
+		double m_comparisons;//比較回数：ソートは１回のソートあたり、探索は１回あたり
+		double m_swaps;//交換回数：ソートは１回のソートあたり（探索は 0）
+		std::size_t m_peakBytes;//メモリ使用量のピーク（バイト）
+		bool m_isOk;//結果が正しいか？
+	};
+
+	//ベンチマーク定義
+	//※benchmarkReport() などに渡す（benchmark_report.h 参照）
+	struct definition
+	{
+		typedef condition condition_type;//計測条件の型
+		typedef result result_type;//計測結果の型
+		//表のタイトル
+		inline static void writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond);
+		//表形式
+		inline static void writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+		inline static void writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+		//CSV形式
+		inline static void writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+		inline static void writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+		//全ての組み合わせを計測
+		template<class FUNCTOR>
+		inline static bool testAll(const condition_type& cond, FUNCTOR functor);
+	};
+
+	//メモリ使用量のピークを記録するアロケータ
+	//※_aligned_malloc() で確保し、確保サイズを先頭に記録する。
+	//※確保／解放は１スレッドで行うこと。
+	class peakAllocator
+	{
+	public:
+		typedef std::uint32_t size_type;//サイズ型
+	public:
+		//アクセッサ
+		const char* name() const { return "sortBenchmark::peakAllocator"; }
+		const char* mode() const { return "Peak"; }
+		inline size_type maxSize() const { return ~static_cast<size_type>(0); }
+		inline size_type size() const { return static_cast<size_type>(m_size); }
+		inline size_type remain() const { return maxSize() - size(); }
+		inline std::size_t peak() const { return m_peak; }//ピーク（バイト数）
+	public:
+		//メソッド
+		inline void* alloc(const std::size_t size, const std::size_t align = GASHA_ DEFAULT_ALIGN);
+		inline bool free(void* p);
+		template<typename T, typename...Tx>
+		T* newObj(Tx&&... args);
+		template<typename T, typename...Tx>
+		T* newArray(const std::size_t num, Tx&&... args);
+		template<typename T>
+		bool deleteObj(T* p);
+		template<typename T>
+		bool deleteArray(T* p, const std::size_t num);
+		inline std::size_t debugInfo(char* message, const std::size_t max_size) const;
+		//ピークをリセット
+		inline void resetPeak(){ m_peak = m_size; }
+	public:
+		inline peakAllocator();
+	private:
+		std::size_t m_size;//使用中のサイズ
+		std::size_t m_peak;//使用中のサイズのピーク
+	};
+}//namespace sortBenchmark
+
+//----------------------------------------
+//入力データの種類、要素型、件数を指定して、全てのソート／探索アルゴリズムを計測
+//※アルゴリズムごとに functor(const sortBenchmark::result&) を呼び出す
+//※全ての結果が正しければ true を返す
+template<class T, class FUNCTOR>
+bool sortBenchmarkTest(const sortBenchmark::input_type input, const std::size_t size, const sortBenchmark::condition& cond, FUNCTOR functor);
+
+//----------------------------------------
+//条件の全ての組み合わせを計測
+//※計測結果ごとに functor(const sortBenchmark::result&) を呼び出す
+//※全ての結果が正しければ true を返す
+template<class FUNCTOR>
+bool sortBenchmarkTestAll(const sortBenchmark::condition& cond, FUNCTOR functor);
+
+//----------------------------------------
+//全ての組み合わせを計測し、表とCSVを作成
+//※表またはCSVが不要な場合は、バッファに nullptr を指定する
+//※全ての結果が正しければ true を返す
+//※メッセージとそのサイズを受け取るための変数を引数に渡す（件数が1000万件なら、表／CSVともに512KBもあれば十分）。
+inline bool sortBenchmarkReport(char* table_message, const std::size_t table_max_size, std::size_t& table_message_len, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const sortBenchmark::condition& cond = sortBenchmark::condition());
+
+//----------------------------------------
+//全ての組み合わせを計測し、表をコンソールに出力しながら、CSVを作成
+//※CSVが不要な場合は、バッファに nullptr を指定する
+//※全ての結果が正しければ true を返す
+inline bool sortBenchmarkPrint(GASHA_ iConsole& console, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const sortBenchmark::condition& cond = sortBenchmark::condition());
+
+//--------------------------------------------------------------------------------
+//並列LSD基数ソートのスレッド数別ベンチマーク
+//※32ビット／64ビットのキー（std::uint32_t／std::uint64_t）の乱数の配列を、件数とスレッド数を変えて
+//　並列LSD基数ソート（parallelLsdRadixSortWithBuff）でソートし、処理時間とスレッド数１に対する速度向上率を計測する。
+//　・件数       ... 100万件から10倍ずつ、条件の最大件数（デフォルトは1億件）まで
+//　・スレッド数 ... 1, 2, 4, ... と倍にしていき、最後は最大スレッド数（デフォルトは omp_get_max_threads()）
+//　（OpenMPが無効な場合は、スレッド数１のみ）
+//※各組み合わせを repeatNum 回ソートし、最短の処理時間を採用する。（入力データの作成時間は含まない）
+//※作業用配列は事前に確保するため、処理時間にメモリ確保の時間は含まない。
+//※配列と作業用配列の２本を確保するため、件数×キーのサイズの２倍のメモリが必要。
+//　配列１本のサイズが arrayBytesMax を超える組み合わせは実行しない。
+//※全ての整列結果を検証し、全て正しければ true を返す。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //スレッド数を8までに制限して、表とCSVをバッファに作成
+//  sortBenchmark::threadScalingCondition cond;
+//  cond.m_threadNumMax = 8;
+//  static char table[64 * 1024];
+//  static char csv[64 * 1024];
+//  std::size_t table_len, csv_len;
+//  parallelLsdRadixSortBenchmarkReport(table, sizeof(table), table_len, csv, sizeof(csv), csv_len, cond);
+//
+//  //ユニットテストで実行（計測結果を表示し、全ての結果が正しいか判定）
+//  GASHA_UT_BEGIN(parallel_lsd_radix_sort_benchmark, 0, GASHA_ ut::ATTR_MANUAL)
+//  {
+//      GASHA_UT_PARALLEL_LSD_RADIX_SORT_BENCHMARK(100000000);
+//  }
+//  GASHA_UT_END()
+//--------------------------------------------------------------------------------
+
+namespace sortBenchmark
+{
+	//計測条件
+	struct threadScalingCondition
+	{
+		std::size_t m_sizeMin;//最小件数（10倍ずつ最大件数まで計測）
+		std::size_t m_sizeMax;//最大件数
+		int m_threadNumMax;//最大スレッド数（0 なら omp_get_max_threads()）
+		int m_repeatNum;//組み合わせごとのソート回数
+		std::size_t m_arrayBytesMax;//配列１本の最大バイト数
+		inline threadScalingCondition();
+	};
+
+	//計測結果
+	struct threadScalingResult
+	{
+		std::size_t m_keySize;//キーのサイズ
+		std::size_t m_size;//件数
+		int m_threadNum;//スレッド数
+		double m_nsPerElement;//１要素あたりの処理時間（ナノ秒）
+		double m_mKeysPerSec;//１秒あたりの処理件数（100万件単位）
+		double m_speedUp;//スレッド数１に対する速度向上率
+		bool m_isOk;//結果が正しいか？
+	};
+
+	//ベンチマーク定義
+	//※benchmarkReport() などに渡す（benchmark_report.h 参照）
+	struct threadScalingDefinition
+	{
+		typedef threadScalingCondition condition_type;//計測条件の型
+		typedef threadScalingResult result_type;//計測結果の型
+		//表のタイトル
+		inline static void writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond);
+		//表形式
+		inline static void writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+		inline static void writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+		//CSV形式
+		inline static void writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len);
+		inline static void writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result);
+		//全ての組み合わせを計測
+		template<class FUNCTOR>
+		inline static bool testAll(const condition_type& cond, FUNCTOR functor);
+	};
+}//namespace sortBenchmark
+
+//----------------------------------------
+//キー型と件数を指定して、スレッド数ごとに計測
+//※スレッド数ごとに functor(const sortBenchmark::threadScalingResult&) を呼び出す
+//※全ての結果が正しければ true を返す
+template<class T, class FUNCTOR>
+bool parallelLsdRadixSortBenchmarkTest(const std::size_t size, const sortBenchmark::threadScalingCondition& cond, FUNCTOR functor);
+
+//----------------------------------------
+//条件の全ての組み合わせを計測
+//※計測結果ごとに functor(const sortBenchmark::threadScalingResult&) を呼び出す
+//※全ての結果が正しければ true を返す
+template<class FUNCTOR>
+bool parallelLsdRadixSortBenchmarkTestAll(const sortBenchmark::threadScalingCondition& cond, FUNCTOR functor);
+
+//----------------------------------------
+//全ての組み合わせを計測し、表とCSVを作成
+//※表またはCSVが不要な場合は、バッファに nullptr を指定する
+//※全ての結果が正しければ true を返す
+inline bool parallelLsdRadixSortBenchmarkReport(char* table_message, const std::size_t table_max_size, std::size_t& table_message_len, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const sortBenchmark::threadScalingCondition& cond = sortBenchmark::threadScalingCondition());
+
+//----------------------------------------
+//ユニットテスト用マクロ
+//※GASHA_UT_BEGIN() ～ GASHA_UT_END() の中で使用する
+#define GASHA_UT_SORT_BENCHMARK(size_max) \
+	{ \
+		GASHA_ sortBenchmark::condition bench_cond; \
+		bench_cond.m_sizeMax = size_max; \
+		GASHA_UT_BENCHMARK(GASHA_ sortBenchmark::definition, bench_cond); \
+	}
+#define GASHA_UT_PARALLEL_LSD_RADIX_SORT_BENCHMARK(size_max) \
+	{ \
+		GASHA_ sortBenchmark::threadScalingCondition bench_cond; \
+		bench_cond.m_sizeMax = size_max; \
+		GASHA_UT_BENCHMARK(GASHA_ sortBenchmark::threadScalingDefinition, bench_cond); \
+	}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/sort_benchmark.inl>
+
+#endif//GASHA_INCLUDED_SORT_BENCHMARK_H
+
+// End of file
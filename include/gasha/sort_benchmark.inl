@@ -0,0 +1,686 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_SORT_BENCHMARK_INL
+#define GASHA_INCLUDED_SORT_BENCHMARK_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// sort_benchmark.inl
+// ソート／探索ベンチマーク【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/sort_benchmark.h>//ソート／探索ベンチマーク【宣言部】
+
+#include <gasha/bubble_sort.h>//バブルソート
+#include <gasha/shaker_sort.h>//シェーカーソート
+#include <gasha/odd_even_sort.h>//奇遇転置ソート
+#include <gasha/shear_sort.h>//シェアソート
+#include <gasha/selection_sort.h>//選択ソート
+#include <gasha/insertion_sort.h>//挿入ソート
+#include <gasha/gnome_sort.h>//ノームソート
+#include <gasha/shell_sort.h>//シェルソート
+#include <gasha/comb_sort.h>//コムソート
+#include <gasha/inplace_merge_sort.h>//インプレースマージソート
+#include <gasha/heap_sort.h>//ヒープソート
+#include <gasha/quick_sort.h>//クイックソート
+#include <gasha/intro_sort.h>//イントロソート
+#include <gasha/pdq_sort.h>//パターン打破クイックソート
+#include <gasha/tim_sort.h>//ティムソート
+#include <gasha/parallel_intro_sort.h>//並列イントロソート
+#include <gasha/parallel_merge_sort.h>//並列マージソート
+#include <gasha/radix_sort.h>//基数ソート
+#include <gasha/lsd_radix_sort.h>//LSD基数ソート
+#include <gasha/parallel_lsd_radix_sort.h>//並列LSD基数ソート
+#include <gasha/is_ordered.h>//整列状態確認
+
+#include <gasha/linear_search.h>//線形探索
+#include <gasha/binary_search.h>//二分探索
+#include <gasha/eytzinger_search.h>//Eytzinger配置探索
+#include <gasha/static_search_tree.h>//静的探索木
+
+#include <gasha/poly_allocator.h>//多態アロケータ
+#include <gasha/allocator_adapter.h>//アロケータアダプタ
+#include <gasha/memory.h>//メモリ操作：_aligned_malloc(), _aligned_free()
+#include <gasha/random_engine.h>//乱数生成器：xoshiro256pp
+#include <gasha/string.h>//文字列処理：spprintf()
+
+#include <cstring>//std::memcpy(), std::memset()
+#include <cmath>//std::log(), std::exp()
+#include <new>//std::nothrow
+#include <type_traits>//C++11 std::is_arithmetic, std::integral_constant
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+namespace sortBenchmark
+{
+	//入力データの種類名
+	inline const char* inputName(const input_type input)
+	{
+		switch (input)
+		{
+		case inputRandom: return "random";
+		case inputSorted: return "sorted";
+		case inputReverse: return "reverse";
+		case inputFewUnique: return "few-unique";
+		case inputZipf: return "zipf";
+		}
+		return "?";
+	}
+
+	//計測条件
+	inline condition::condition() :
+		m_sizeMin(10),
+		m_sizeMax(10000000),
+		m_slowSortSizeMax(10000),
+		m_mediumSortSizeMax(1000000),
+		m_arrayBytesMax(256 * 1024 * 1024),
+		m_repeatElementNum(10000),
+		m_searchQueryNum(100000)
+	{}
+
+	//メモリ使用量のピークを記録するアロケータ
+	//メモリ確保
+	//※先頭に確保サイズとヘッダーサイズを記録する（ヘッダーは16バイト以上、かつ、アラインメントの倍数）
+	inline void* peakAllocator::alloc(const std::size_t size, const std::size_t align)
+	{
+		const std::size_t header_size = align > 16 ? align : 16;
+		char* buff = static_cast<char*>(_aligned_malloc(header_size + size, header_size));
+		if (!buff)
+			return nullptr;
+		std::size_t* header = reinterpret_cast<std::size_t*>(buff + header_size) - 2;
+		header[0] = header_size;
+		header[1] = size;
+		m_size += size;
+		if (m_peak < m_size)
+			m_peak = m_size;
+		return buff + header_size;
+	}
+	//メモリ解放
+	inline bool peakAllocator::free(void* p)
+	{
+		if (!p)//nullptrの解放は常に成功扱い
+			return true;
+		const std::size_t* header = static_cast<const std::size_t*>(p) - 2;
+		const std::size_t header_size = header[0];
+		m_size -= header[1];
+		_aligned_free(static_cast<char*>(p) - header_size);
+		return true;
+	}
+	//メモリ確保とコンストラクタ呼び出し
+	template<typename T, typename...Tx>
+	T* peakAllocator::newObj(Tx&&... args)
+	{
+		void* p = alloc(sizeof(T), alignof(T));
+		if (!p)
+			return nullptr;
+		return GASHA_ callConstructor<T>(p, std::forward<Tx>(args)...);
+	}
+	//※配列用
+	template<typename T, typename...Tx>
+	T* peakAllocator::newArray(const std::size_t num, Tx&&... args)
+	{
+		void* p = alloc(sizeof(T) * num, alignof(T));
+		if (!p)
+			return nullptr;
+		T* top_obj = static_cast<T*>(p);
+		for (std::size_t i = 0; i < num; ++i)
+			GASHA_ callConstructor<T>(top_obj + i, std::forward<Tx>(args)...);
+		return top_obj;
+	}
+	//メモリ解放とデストラクタ呼び出し
+	template<typename T>
+	bool peakAllocator::deleteObj(T* p)
+	{
+		if (!p)//nullptrの解放は常に成功扱い
+			return true;
+		GASHA_ callDestructor(p);
+		return free(p);
+	}
+	//※配列用
+	template<typename T>
+	bool peakAllocator::deleteArray(T* p, const std::size_t num)
+	{
+		if (!p)//nullptrの解放は常に成功扱い
+			return true;
+		for (std::size_t i = 0; i < num; ++i)
+			GASHA_ callDestructor(p + i);
+		return free(p);
+	}
+	//デバッグ情報作成
+	inline std::size_t peakAllocator::debugInfo(char* message, const std::size_t max_size) const
+	{
+		std::size_t message_len = 0;
+		GASHA_ spprintf(message, max_size, message_len, "----- Debug-info for sortBenchmark::peakAllocator -----\n");
+		GASHA_ spprintf(message, max_size, message_len, "size=%llu, peak=%llu\n", static_cast<unsigned long long>(m_size), static_cast<unsigned long long>(m_peak));
+		GASHA_ spprintf(message, max_size, message_len, "-------------------------------------------------------");//最終行改行なし
+		return message_len;
+	}
+	//コンストラクタ
+	inline peakAllocator::peakAllocator() :
+		m_size(0),
+		m_peak(0)
+	{}
+
+	//ベンチマーク定義
+	//表のタイトル
+	inline void definition::writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "[ Sort/search benchmark (size=%llu-%llu) ]\n", static_cast<unsigned long long>(cond.m_sizeMin), static_cast<unsigned long long>(cond.m_sizeMax));
+	}
+	//表形式
+	inline void definition::writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%-22s %-6s %-10s %4s %9s %12s %14s %14s %12s %s\n", "algorithm", "kind", "input", "elem", "size", "ns/elem", "comparisons", "swaps", "peak(bytes)", "result");
+	}
+	inline void definition::writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%-22s %-6s %-10s %4d %9llu %12.2lf %14.1lf %14.1lf %12llu %s\n", result.m_algorithmName, result.m_isSearch ? "search" : "sort", inputName(result.m_input), static_cast<int>(result.m_elementSize), static_cast<unsigned long long>(result.m_size), result.m_nsPerElement, result.m_comparisons, result.m_swaps, static_cast<unsigned long long>(result.m_peakBytes), result.m_isOk ? "[OK]" : "[NG]");
+	}
+	//CSV形式
+	inline void definition::writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "algorithm,kind,input,element_bytes,size,ns_per_element,comparisons,swaps,peak_bytes,ok\n");
+	}
+	inline void definition::writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%s,%s,%s,%d,%llu,%.3lf,%.1lf,%.1lf,%llu,%d\n", result.m_algorithmName, result.m_isSearch ? "search" : "sort", inputName(result.m_input), static_cast<int>(result.m_elementSize), static_cast<unsigned long long>(result.m_size), result.m_nsPerElement, result.m_comparisons, result.m_swaps, static_cast<unsigned long long>(result.m_peakBytes), result.m_isOk ? 1 : 0);
+	}
+	//全ての組み合わせを計測
+	template<class FUNCTOR>
+	inline bool definition::testAll(const condition_type& cond, FUNCTOR functor)
+	{
+		return sortBenchmarkTestAll(cond, functor);
+	}
+}//namespace sortBenchmark
+
+namespace _private
+{
+	//----------------------------------------
+	//入力データの作成
+
+	//キーを設定
+	inline void sortBenchmarkSetKey(std::uint32_t& value, const std::uint64_t key){ value = static_cast<std::uint32_t>(key); }
+	inline void sortBenchmarkSetKey(std::uint64_t& value, const std::uint64_t key){ value = key; }
+	template<std::size_t SIZE>
+	inline void sortBenchmarkSetKey(sortBenchmark::element<SIZE>& value, const std::uint64_t key)
+	{
+		value.m_key = static_cast<std::uint32_t>(key);
+		std::memset(value.m_payload, static_cast<int>(key & 0xff), sizeof(value.m_payload));
+	}
+
+	//入力データを作成
+	//※少種類とZipf分布は、値の順位を SplitMix64 で散らしてキーにする
+	//※Zipf分布は、順位 k（1～size）の出現確率が 1/k に比例する分布の連続近似（k = size^u, u は [0, 1) の一様乱数）
+	template<class T>
+	void sortBenchmarkMakeInput(T* array, const std::size_t size, const sortBenchmark::input_type input)
+	{
+		GASHA_ xoshiro256pp rnd(sortBenchmark::SEED);
+		const double log_size = std::log(static_cast<double>(size));
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			std::uint64_t key = 0;
+			switch (input)
+			{
+			case sortBenchmark::inputRandom:
+				key = rnd();
+				break;
+			case sortBenchmark::inputSorted:
+				key = static_cast<std::uint64_t>(i);
+				break;
+			case sortBenchmark::inputReverse:
+				key = static_cast<std::uint64_t>(size - 1 - i);
+				break;
+			case sortBenchmark::inputFewUnique:
+				key = GASHA_ _private::splitMix64(sortBenchmark::SEED, rnd() % sortBenchmark::FEW_UNIQUE_NUM + 1);
+				break;
+			case sortBenchmark::inputZipf:
+				{
+					const double u = static_cast<double>(rnd() >> 11) * (1. / 9007199254740992.);//[0, 1) の一様乱数（53ビット）
+					const std::uint64_t rank = static_cast<std::uint64_t>(std::exp(u * log_size));
+					key = GASHA_ _private::splitMix64(sortBenchmark::SEED, rank);
+				}
+				break;
+			}
+			sortBenchmarkSetKey(array[i], key);
+		}
+	}
+
+	//----------------------------------------
+	//ソート関数オブジェクト
+	//※比較ソート
+	#define GASHA_SORT_BENCHMARK_COMPARISON_SORT(functor_name, func_name) \
+		struct functor_name \
+		{ \
+			template<class T, class PREDICATE> \
+			inline std::size_t operator()(T* array, const std::size_t size, PREDICATE predicate) const { return GASHA_ func_name(array, size, predicate); } \
+		};
+	//※分布ソート（プレディケート関数を使用しない）
+	#define GASHA_SORT_BENCHMARK_DISTRIBUTED_SORT(functor_name, func_name) \
+		struct functor_name \
+		{ \
+			template<class T, class PREDICATE> \
+			inline std::size_t operator()(T* array, const std::size_t size, PREDICATE predicate) const { return GASHA_ func_name(array, size, sortBenchmark::getKey<T>()); } \
+		};
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkBubbleSort, bubbleSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkShakerSort, shakerSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkOddEvenSort, oddEvenSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkSelectionSort, selectionSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkInsertionSort, insertionSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkGnomeSort, gnomeSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkShearSort, shearSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkInplaceMergeSort, inplaceMergeSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkShellSort, shellSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkCombSort, combSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkHeapSort, heapSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkQuickSort, quickSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkIntroSort, introSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkPdqSort, pdqSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkTimSort, timSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkParallelIntroSort, parallelIntroSort);
+	GASHA_SORT_BENCHMARK_COMPARISON_SORT(sortBenchmarkParallelMergeSort, parallelMergeSort);
+	GASHA_SORT_BENCHMARK_DISTRIBUTED_SORT(sortBenchmarkRadixSort, radixSort);
+	GASHA_SORT_BENCHMARK_DISTRIBUTED_SORT(sortBenchmarkLsdRadixSort, lsdRadixSort);
+	GASHA_SORT_BENCHMARK_DISTRIBUTED_SORT(sortBenchmarkParallelLsdRadixSort, parallelLsdRadixSort);
+	#undef GASHA_SORT_BENCHMARK_COMPARISON_SORT
+	#undef GASHA_SORT_BENCHMARK_DISTRIBUTED_SORT
+
+	//----------------------------------------
+	//ソートを計測
+	//※repeat 回分の入力データのコピーを work に用意してまとめてソートし、処理時間と交換回数を計測する
+	//※比較回数とメモリ使用量のピークは、別途１回だけソートして計測する
+	template<class T, class SORT_FUNCTOR, class FUNCTOR>
+	bool sortBenchmarkSort(const char* name, SORT_FUNCTOR sort_functor, const std::size_t size_max, const sortBenchmark::input_type input, const T* src, const std::size_t size, T* work, const std::size_t repeat, FUNCTOR& functor)
+	{
+		if (size > size_max)
+			return true;
+		sortBenchmark::result result = { name, false, input, sizeof(T), size, 0., 0., 0., 0, true };
+		//処理時間と交換回数
+		for (std::size_t r = 0; r < repeat; ++r)
+			std::memcpy(work + r * size, src, sizeof(T) * size);
+		std::size_t swapped_count = 0;
+		const double elapsed = GASHA_ benchmarkElapsedMin(1, repeat, [&](const std::size_t r)
+			{
+				swapped_count += sort_functor(work + r * size, size, GASHA_ less<T>());
+			});
+		for (std::size_t r = 0; r < repeat; ++r)
+		{
+			if (!GASHA_ isOrdered(work + r * size, size, GASHA_ less<T>()))
+				result.m_isOk = false;
+		}
+		//比較回数とメモリ使用量のピーク
+		std::memcpy(work, src, sizeof(T) * size);
+		std::size_t compare_count = 0;
+		{
+			//※並列ソートの比較回数を正確に数える（カウンタを非アトミックに加算する）ため、１スレッドで実行する
+			//※多態アロケータのアロケータはスレッドごとに設定されるため、ワーカースレッドでの確保を計測対象にする意味もある
+			benchmarkThreadScope single_thread(1);
+			sortBenchmark::peakAllocator allocator;
+			GASHA_ allocatorAdapter<sortBenchmark::peakAllocator> adapter(allocator, allocator.name(), allocator.mode());
+			{
+				GASHA_ polyAllocator poly_allocator(adapter);
+				sort_functor(work, size, GASHA_ makeCountingPredicate(GASHA_ less<T>(), compare_count));
+			}
+			result.m_peakBytes = allocator.peak();
+		}
+		if (!GASHA_ isOrdered(work, size, GASHA_ less<T>()))
+			result.m_isOk = false;
+		result.m_nsPerElement = elapsed * 1000000000. / static_cast<double>(size * repeat);
+		result.m_comparisons = static_cast<double>(compare_count);
+		result.m_swaps = static_cast<double>(swapped_count) / static_cast<double>(repeat);
+		functor(result);
+		return result.m_isOk;
+	}
+
+	//----------------------------------------
+	//探索関数オブジェクト
+	//※operator()(value) で探索し、operator()(value, counter) で比較回数を数えながら探索する
+	//※見つかった要素が探索値と一致すれば true を返す
+	template<class T>
+	struct sortBenchmarkLinearSearch
+	{
+		const T* m_array;
+		std::size_t m_size;
+		inline bool operator()(const T& value) const { const T* found = GASHA_ linearSearchValue(m_array, m_size, value, GASHA_ equal_to<T>()); return found && *found == value; }
+		inline bool operator()(const T& value, std::size_t& counter) const { const T* found = GASHA_ linearSearchValue(m_array, m_size, value, GASHA_ makeCountingPredicate(GASHA_ equal_to<T>(), counter)); return found && *found == value; }
+	};
+	template<class T>
+	struct sortBenchmarkBinarySearch
+	{
+		const T* m_array;
+		std::size_t m_size;
+		inline bool operator()(const T& value) const { const T* found = GASHA_ binarySearchValue(m_array, m_size, value, GASHA_ compare_to<T>()); return found && *found == value; }
+		inline bool operator()(const T& value, std::size_t& counter) const { const T* found = GASHA_ binarySearchValue(m_array, m_size, value, GASHA_ makeCountingPredicate(GASHA_ compare_to<T>(), counter)); return found && *found == value; }
+	};
+	template<class T>
+	struct sortBenchmarkBranchlessBinarySearch
+	{
+		const T* m_array;
+		std::size_t m_size;
+		inline bool operator()(const T& value) const { const T* found = GASHA_ branchlessBinarySearchValue(m_array, m_size, value, GASHA_ compare_to<T>()); return found && *found == value; }
+		inline bool operator()(const T& value, std::size_t& counter) const { const T* found = GASHA_ branchlessBinarySearchValue(m_array, m_size, value, GASHA_ makeCountingPredicate(GASHA_ compare_to<T>(), counter)); return found && *found == value; }
+	};
+	template<class T>
+	struct sortBenchmarkEytzingerSearch
+	{
+		const T* m_layout;
+		std::size_t m_size;
+		inline bool operator()(const T& value) const { const T* found = GASHA_ eytzingerSearchValue(m_layout, m_size, value, GASHA_ compare_to<T>()); return found && *found == value; }
+		inline bool operator()(const T& value, std::size_t& counter) const { const T* found = GASHA_ eytzingerSearchValue(m_layout, m_size, value, GASHA_ makeCountingPredicate(GASHA_ compare_to<T>(), counter)); return found && *found == value; }
+	};
+	template<class T>
+	struct sortBenchmarkStaticSearchTree
+	{
+		const GASHA_ staticSearchTree<T>* m_tree;
+		const T* m_sorted;
+		inline bool operator()(const T& value) const { const std::size_t index = m_tree->find(value); return index != m_tree->INVALID_INDEX && m_sorted[index] == value; }
+		inline bool operator()(const T& value, std::size_t& counter) const { return (*this)(value); }//比較関数を使用しない
+	};
+
+	//----------------------------------------
+	//探索を計測
+	template<class T, class SEARCH_FUNCTOR, class FUNCTOR>
+	bool sortBenchmarkSearch(const char* name, SEARCH_FUNCTOR search_functor, const std::size_t size_max, const sortBenchmark::input_type input, const std::size_t size, const T* queries, const std::size_t query_num, const std::size_t work_bytes, FUNCTOR& functor)
+	{
+		if (size > size_max || query_num == 0)
+			return true;
+		sortBenchmark::result result = { name, true, input, sizeof(T), size, 0., 0., 0., work_bytes, true };
+		//処理時間
+		std::size_t missed = 0;
+		const double elapsed = GASHA_ benchmarkElapsedMin(1, query_num, [&](const std::size_t q)
+			{
+				if (!search_functor(queries[q]))
+					++missed;
+			});
+		//比較回数
+		std::size_t compare_count = 0;
+		for (std::size_t q = 0; q < query_num; ++q)
+			search_functor(queries[q], compare_count);
+		result.m_isOk = missed == 0;
+		result.m_nsPerElement = elapsed * 1000000000. / static_cast<double>(query_num);
+		result.m_comparisons = static_cast<double>(compare_count) / static_cast<double>(query_num);
+		functor(result);
+		return result.m_isOk;
+	}
+
+	//静的探索木を計測
+	//※キーが算術型の場合のみ
+	template<class T, class FUNCTOR>
+	inline bool sortBenchmarkStaticSearchTreeSearch(const sortBenchmark::input_type input, const T* sorted, const std::size_t size, const T* queries, const std::size_t query_num, FUNCTOR& functor, std::true_type)
+	{
+		const std::size_t buff_size = GASHA_ staticSearchTree<T>::calcBufferSize(size);
+		T* buff = static_cast<T*>(_aligned_malloc(sizeof(T) * buff_size, 64));
+		if (!buff)
+			return false;
+		GASHA_ staticSearchTree<T> tree(sorted, size, buff, buff_size);
+		const sortBenchmarkStaticSearchTree<T> search_functor = { &tree, sorted };
+		const bool is_ok = sortBenchmarkSearch("staticSearchTree", search_functor, size, input, size, queries, query_num, sizeof(T) * buff_size, functor);
+		tree.clear();
+		_aligned_free(buff);
+		return is_ok;
+	}
+	template<class T, class FUNCTOR>
+	inline bool sortBenchmarkStaticSearchTreeSearch(const sortBenchmark::input_type input, const T* sorted, const std::size_t size, const T* queries, const std::size_t query_num, FUNCTOR& functor, std::false_type)
+	{
+		return true;
+	}
+}//namespace _private
+
+//----------------------------------------
+//入力データの種類、要素型、件数を指定して、全てのソート／探索アルゴリズムを計測
+template<class T, class FUNCTOR>
+bool sortBenchmarkTest(const sortBenchmark::input_type input, const std::size_t size, const sortBenchmark::condition& cond, FUNCTOR functor)
+{
+	if (size == 0 || sizeof(T) * size > cond.m_arrayBytesMax)
+		return true;
+	const std::size_t repeat = GASHA_ benchmarkBatchNum(size, cond.m_repeatElementNum);
+	const std::size_t query_num = cond.m_searchQueryNum;
+	T* src = new(std::nothrow) T[size];
+	T* work = new(std::nothrow) T[size * repeat];
+	T* queries = new(std::nothrow) T[query_num > 0 ? query_num : 1];
+	if (!src || !work || !queries)
+	{
+		delete[] src;
+		delete[] work;
+		delete[] queries;
+		return false;
+	}
+	_private::sortBenchmarkMakeInput(src, size, input);
+	bool is_ok = true;
+
+	//ソート
+	const std::size_t slow = cond.m_slowSortSizeMax;
+	const std::size_t medium = cond.m_mediumSortSizeMax;
+	const std::size_t unlimited = ~static_cast<std::size_t>(0);
+	is_ok &= _private::sortBenchmarkSort("bubbleSort", _private::sortBenchmarkBubbleSort(), slow, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("shakerSort", _private::sortBenchmarkShakerSort(), slow, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("oddEvenSort", _private::sortBenchmarkOddEvenSort(), slow, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("selectionSort", _private::sortBenchmarkSelectionSort(), slow, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("insertionSort", _private::sortBenchmarkInsertionSort(), slow, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("gnomeSort", _private::sortBenchmarkGnomeSort(), slow, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("shearSort", _private::sortBenchmarkShearSort(), medium, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("inplaceMergeSort", _private::sortBenchmarkInplaceMergeSort(), medium, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("shellSort", _private::sortBenchmarkShellSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("combSort", _private::sortBenchmarkCombSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("heapSort", _private::sortBenchmarkHeapSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("quickSort", _private::sortBenchmarkQuickSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("introSort", _private::sortBenchmarkIntroSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("pdqSort", _private::sortBenchmarkPdqSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("timSort", _private::sortBenchmarkTimSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("parallelIntroSort", _private::sortBenchmarkParallelIntroSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("parallelMergeSort", _private::sortBenchmarkParallelMergeSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("radixSort", _private::sortBenchmarkRadixSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("lsdRadixSort", _private::sortBenchmarkLsdRadixSort(), unlimited, input, src, size, work, repeat, functor);
+	is_ok &= _private::sortBenchmarkSort("parallelLsdRadixSort", _private::sortBenchmarkParallelLsdRadixSort(), unlimited, input, src, size, work, repeat, functor);
+
+	//探索
+	//※探索値は、入力データからランダムに選ぶ（Zipf分布なら、頻度の高い値ほど多く探索する）
+	T* sorted = work;
+	std::memcpy(sorted, src, sizeof(T) * size);
+	GASHA_ pdqSort(sorted, size, GASHA_ less<T>());
+	{
+		GASHA_ xoshiro256pp rnd(sortBenchmark::SEED + 1);
+		for (std::size_t q = 0; q < query_num; ++q)
+			queries[q] = src[rnd() % size];
+	}
+	{
+		const _private::sortBenchmarkLinearSearch<T> search_functor = { sorted, size };
+		is_ok &= _private::sortBenchmarkSearch("linearSearch", search_functor, medium, input, size, queries, query_num, 0, functor);
+	}
+	{
+		const _private::sortBenchmarkBinarySearch<T> search_functor = { sorted, size };
+		is_ok &= _private::sortBenchmarkSearch("binarySearch", search_functor, unlimited, input, size, queries, query_num, 0, functor);
+	}
+	{
+		const _private::sortBenchmarkBranchlessBinarySearch<T> search_functor = { sorted, size };
+		is_ok &= _private::sortBenchmarkSearch("branchlessBinarySearch", search_functor, unlimited, input, size, queries, query_num, 0, functor);
+	}
+	{
+		T* layout = new(std::nothrow) T[size];
+		if (layout)
+		{
+			GASHA_ buildEytzingerLayout(sorted, size, layout);
+			const _private::sortBenchmarkEytzingerSearch<T> search_functor = { layout, size };
+			is_ok &= _private::sortBenchmarkSearch("eytzingerSearch", search_functor, unlimited, input, size, queries, query_num, sizeof(T) * size, functor);
+			delete[] layout;
+		}
+		else
+			is_ok = false;
+	}
+	is_ok &= _private::sortBenchmarkStaticSearchTreeSearch(input, sorted, size, queries, query_num, functor, std::integral_constant<bool, std::is_arithmetic<T>::value>());
+
+	delete[] src;
+	delete[] work;
+	delete[] queries;
+	return is_ok;
+}
+
+//----------------------------------------
+//条件の全ての組み合わせを計測
+template<class FUNCTOR>
+bool sortBenchmarkTestAll(const sortBenchmark::condition& cond, FUNCTOR functor)
+{
+	bool is_ok = true;
+	for (std::size_t size = cond.m_sizeMin; size > 0 && size <= cond.m_sizeMax; size *= 10)
+	{
+		for (int input_index = 0; input_index < sortBenchmark::INPUT_TYPE_NUM; ++input_index)
+		{
+			const sortBenchmark::input_type input = static_cast<sortBenchmark::input_type>(input_index);
+			is_ok &= sortBenchmarkTest<std::uint32_t>(input, size, cond, functor);
+			is_ok &= sortBenchmarkTest<std::uint64_t>(input, size, cond, functor);
+			is_ok &= sortBenchmarkTest<sortBenchmark::element<16>>(input, size, cond, functor);
+			is_ok &= sortBenchmarkTest<sortBenchmark::element<64>>(input, size, cond, functor);
+		}
+	}
+	return is_ok;
+}
+
+//----------------------------------------
+//全ての組み合わせを計測し、表とCSVを作成
+inline bool sortBenchmarkReport(char* table_message, const std::size_t table_max_size, std::size_t& table_message_len, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const sortBenchmark::condition& cond)
+{
+	return GASHA_ benchmarkReport<sortBenchmark::definition>(table_message, table_max_size, table_message_len, csv_message, csv_max_size, csv_message_len, cond);
+}
+
+//----------------------------------------
+//全ての組み合わせを計測し、表をコンソールに出力しながら、CSVを作成
+inline bool sortBenchmarkPrint(GASHA_ iConsole& console, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const sortBenchmark::condition& cond)
+{
+	return GASHA_ benchmarkPrint<sortBenchmark::definition>([&console](const char* line)
+		{
+			console.begin();
+			console.put(line);
+			console.end();
+		}, csv_message, csv_max_size, csv_message_len, cond);
+}
+
+//--------------------------------------------------------------------------------
+//並列LSD基数ソートのスレッド数別ベンチマーク
+
+namespace sortBenchmark
+{
+	//計測条件
+	inline threadScalingCondition::threadScalingCondition() :
+		m_sizeMin(1000000),
+		m_sizeMax(100000000),
+		m_threadNumMax(0),
+		m_repeatNum(3),
+		m_arrayBytesMax(1024 * 1024 * 1024)
+	{}
+
+	//ベンチマーク定義
+	//表のタイトル
+	inline void threadScalingDefinition::writeTitle(char* message, const std::size_t max_size, std::size_t& message_len, const condition_type& cond)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "[ Parallel LSD radix sort benchmark (size=%llu-%llu, threads=1-%d) ]\n", static_cast<unsigned long long>(cond.m_sizeMin), static_cast<unsigned long long>(cond.m_sizeMax), cond.m_threadNumMax > 0 ? cond.m_threadNumMax : _private::benchmarkThreadNum());
+	}
+	//表形式
+	inline void threadScalingDefinition::writeTableHeader(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%-8s %10s %7s %10s %10s %8s %s\n", "key", "size", "threads", "ns/elem", "Mkeys/s", "speed-up", "result");
+	}
+	inline void threadScalingDefinition::writeTable(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%-8s %10llu %7d %10.3lf %10.1lf %7.2lfx %s\n", result.m_keySize == 4 ? "32bit" : "64bit", static_cast<unsigned long long>(result.m_size), result.m_threadNum, result.m_nsPerElement, result.m_mKeysPerSec, result.m_speedUp, result.m_isOk ? "[OK]" : "[NG]");
+	}
+	//CSV形式
+	inline void threadScalingDefinition::writeCsvHeader(char* message, const std::size_t max_size, std::size_t& message_len)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "key_bytes,size,threads,ns_per_element,mkeys_per_sec,speed_up,ok\n");
+	}
+	inline void threadScalingDefinition::writeCsv(char* message, const std::size_t max_size, std::size_t& message_len, const result_type& result)
+	{
+		GASHA_ spprintf(message, max_size, message_len, "%d,%llu,%d,%.3lf,%.3lf,%.3lf,%d\n", static_cast<int>(result.m_keySize), static_cast<unsigned long long>(result.m_size), result.m_threadNum, result.m_nsPerElement, result.m_mKeysPerSec, result.m_speedUp, result.m_isOk ? 1 : 0);
+	}
+	//全ての組み合わせを計測
+	template<class FUNCTOR>
+	inline bool threadScalingDefinition::testAll(const condition_type& cond, FUNCTOR functor)
+	{
+		return parallelLsdRadixSortBenchmarkTestAll(cond, functor);
+	}
+}//namespace sortBenchmark
+
+//----------------------------------------
+//キー型と件数を指定して、スレッド数ごとに計測
+template<class T, class FUNCTOR>
+bool parallelLsdRadixSortBenchmarkTest(const std::size_t size, const sortBenchmark::threadScalingCondition& cond, FUNCTOR functor)
+{
+	if (size == 0 || sizeof(T) * size > cond.m_arrayBytesMax)
+		return true;
+	T* array = new(std::nothrow) T[size];
+	T* work = new(std::nothrow) T[size];
+	if (!array || !work)
+	{
+		delete[] array;
+		delete[] work;
+		return false;
+	}
+	const int thread_num_max = cond.m_threadNumMax > 0 ? cond.m_threadNumMax : _private::benchmarkThreadNum();
+	bool is_ok = true;
+	double base_elapsed = 0.;
+	//スレッド数を 1, 2, 4, ... , 最大スレッド数 と変えて計測
+	for (int thread_num = 1; ; thread_num = thread_num * 2 < thread_num_max ? thread_num * 2 : thread_num_max)
+	{
+		sortBenchmark::threadScalingResult result = { sizeof(T), size, thread_num, 0., 0., 0., true };
+		double elapsed_min = 0.;
+		{
+			_private::benchmarkThreadScope thread_scope(thread_num);
+			//※計測ごとに入力データを作り直す（毎回同じ内容になるため、整列結果は最後の１回分のみ検証する）
+			elapsed_min = GASHA_ benchmarkElapsedMin(cond.m_repeatNum, 1,
+				[&]()
+				{
+					_private::sortBenchmarkMakeInput(array, size, sortBenchmark::inputRandom);
+				},
+				[&](const std::size_t)
+				{
+					GASHA_ parallelLsdRadixSortWithBuff(array, size, work, sortBenchmark::getKey<T>());
+				});
+		}
+		if (!GASHA_ isOrdered(array, size, GASHA_ less<T>()))
+			result.m_isOk = false;
+		if (thread_num == 1)
+			base_elapsed = elapsed_min;
+		result.m_nsPerElement = elapsed_min * 1000000000. / static_cast<double>(size);
+		result.m_mKeysPerSec = elapsed_min > 0. ? static_cast<double>(size) / elapsed_min / 1000000. : 0.;
+		result.m_speedUp = elapsed_min > 0. ? base_elapsed / elapsed_min : 0.;
+		functor(result);
+		is_ok &= result.m_isOk;
+		if (thread_num >= thread_num_max)
+			break;
+	}
+	delete[] array;
+	delete[] work;
+	return is_ok;
+}
+
+//----------------------------------------
+//条件の全ての組み合わせを計測
+template<class FUNCTOR>
+bool parallelLsdRadixSortBenchmarkTestAll(const sortBenchmark::threadScalingCondition& cond, FUNCTOR functor)
+{
+	bool is_ok = true;
+	for (std::size_t size = cond.m_sizeMin; size > 0 && size <= cond.m_sizeMax; size *= 10)
+	{
+		is_ok &= parallelLsdRadixSortBenchmarkTest<std::uint32_t>(size, cond, functor);
+		is_ok &= parallelLsdRadixSortBenchmarkTest<std::uint64_t>(size, cond, functor);
+	}
+	return is_ok;
+}
+
+//----------------------------------------
+//全ての組み合わせを計測し、表とCSVを作成
+inline bool parallelLsdRadixSortBenchmarkReport(char* table_message, const std::size_t table_max_size, std::size_t& table_message_len, char* csv_message, const std::size_t csv_max_size, std::size_t& csv_message_len, const sortBenchmark::threadScalingCondition& cond)
+{
+	return GASHA_ benchmarkReport<sortBenchmark::threadScalingDefinition>(table_message, table_max_size, table_message_len, csv_message, csv_max_size, csv_message_len, cond);
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_SORT_BENCHMARK_INL
+
+// End of file
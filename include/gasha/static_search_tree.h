@@ -0,0 +1,154 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_STATIC_SEARCH_TREE_H
+#define GASHA_INCLUDED_STATIC_SEARCH_TREE_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// static_search_tree.h
+// 静的探索木【宣言部】
+// ※データのメモリ管理を行わない擬似コンテナ
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/search_basic.h>//探索処理基本
+
+#include <cstddef>//std::size_t
+#include <type_traits>//C++11 std::is_arithmetic
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//静的探索木（静的B+木）
+//--------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------
+//データ構造とアルゴリズム
+//--------------------------------------------------------------------------------
+//【特徴】
+//・整列済みのキー配列から、読み取り専用の B+木（S+木）をポインタなしの配列上に構築し、
+//  キーの下限探索を行う。
+//　＜静的探索木のデータ構造＞
+//	  - １ノードに 16 件のキーを持ち、ノードは 17 件の子を持つ。
+//	    32ビットのキーなら、１ノードがキャッシュライン１本（64バイト）に収まる。
+//	  - 最下層（葉）には、整列済みのキーがそのまま順に並ぶ。
+//	  - 上位の層のノードの j 番目のキーには、j+1 番目の子の部分木の最小キーを持つ。
+//	  - 子の位置は計算で求まるため、連結情報が不要。
+//	  - 各層は配列上に連続して並び、根の層から順に配置する。
+//・１ノード内の比較は、SIMD命令で 16 件同時に行う。（std::int32_t, std::uint32_t, float の場合）
+//  １段あたりのメモリアクセスがキャッシュライン１本で済み、段数も log17(n) に減るため、
+//  二分探索と比べてキャッシュミスが大幅に少ない。
+//--------------------------------------------------------------------------------
+//【利点】
+//・大量のキーの探索が二分探索よりも高速。（100万件で、段数は 20 段から 5 段に減る）
+//・探索結果は整列済み配列上のインデックスのため、キーと並べて値の配列を持つことができる。
+//--------------------------------------------------------------------------------
+//【欠点】
+//・構築後にキーの追加・削除ができない。（作り直しが必要）
+//・整列済みのキー配列とは別に、キー数の約 1.07 倍（＋端数）のバッファが必要。
+//--------------------------------------------------------------------------------
+//【本プログラムにおける実装要件】
+//・バッファはユーザーが用意する。（calcBufferSize() で必要な要素数を求める）
+//  SIMD命令でノードを読み込むため、バッファは 64 バイト境界にアラインメントしておくと良い。
+//・キーの型は算術型に限る。
+//  std::uint32_t（crc32_t）は、符号ビットを反転して符号付きの比較命令で比較するため、
+//  バッファの内容はキーの値そのままではない点に注意。
+//・SSE2/AVX/AVX2 が無効な場合や、上記以外の型の場合は、ノード内の比較を通常の比較で行う。
+//・float のキーに NaN を含む場合の結果は不定。
+//--------------------------------------------------------------------------------
+//【想定する具的的な用途】
+//・アセットテーブルなどの、大量の静的なキー（CRC値など）の高速な探索。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  //整列済みのキーと、キーに対応する値
+//  const crc32_t* keys = ...;
+//  const assetInfo* infos = ...;
+//  //静的探索木を構築
+//  const std::size_t buff_size = staticSearchTree<crc32_t>::calcBufferSize(num);
+//  crc32_t* buff = static_cast<crc32_t*>(_aligned_malloc(sizeof(crc32_t) * buff_size, 64));
+//  staticSearchTree<crc32_t> tree(keys, num, buff, buff_size);
+//  //探索
+//  const std::size_t index = tree.find(calcCRC32("asset_name"));
+//  if (index != tree.INVALID_INDEX)
+//  {
+//      const assetInfo& info = infos[index];
+//      ...
+//  }
+//--------------------------------------------------------------------------------
+
+template<typename KEY_TYPE>
+class staticSearchTree
+{
+	static_assert(std::is_arithmetic<KEY_TYPE>::value, "KEY_TYPE is only supported arithmetic type.");
+public:
+	//型
+	typedef KEY_TYPE key_type;//キー型
+public:
+	//定数
+	static const std::size_t NODE_KEYS = 16;//１ノードのキー数
+	static const std::size_t NODE_CHILDREN = NODE_KEYS + 1;//１ノードの子の数
+	static const std::size_t LAYER_MAX = 16;//最大段数
+	static const std::size_t INVALID_INDEX = ~static_cast<std::size_t>(0);//無効なインデックス
+public:
+	//アクセッサ
+	inline std::size_t size() const { return m_size; }//キー数
+	inline bool empty() const { return m_size == 0; }//空か？
+	inline std::size_t height() const { return m_height; }//段数
+	inline std::size_t bufferSize() const { return m_buffSize; }//使用しているバッファの要素数
+public:
+	//メソッド
+	
+	//必要なバッファの要素数を計算
+	static std::size_t calcBufferSize(const std::size_t size);
+
+	//構築
+	//※sorted は昇順に整列済みであること
+	//※バッファが足りない場合は false を返す
+	bool build(const key_type* sorted, const std::size_t size, key_type* buff, const std::size_t buff_size);
+
+	//クリア
+	inline void clear();
+
+	//下限探索
+	//※キー以上となる最初のキーの、整列済み配列上のインデックスを返す
+	//　全てのキーが探索キーより小さい場合は size() を返す
+	std::size_t lowerBound(const key_type key) const;
+
+	//探索
+	//※キーと一致する最初のキーの、整列済み配列上のインデックスを返す
+	//　見つからなかった場合は INVALID_INDEX を返す
+	inline std::size_t find(const key_type key) const;
+
+private:
+	//段数と各段のノード数を計算
+	static std::size_t calcLayers(const std::size_t size, std::size_t* nodes);
+
+public:
+	//デフォルトコンストラクタ
+	inline staticSearchTree();
+	//コンストラクタ
+	//※構築を伴う
+	inline staticSearchTree(const key_type* sorted, const std::size_t size, key_type* buff, const std::size_t buff_size);
+	//デストラクタ
+	inline ~staticSearchTree();
+
+private:
+	//フィールド
+	key_type* m_buff;//バッファ
+	std::size_t m_buffSize;//使用しているバッファの要素数
+	std::size_t m_size;//キー数
+	std::size_t m_height;//段数
+	std::size_t m_layerOffset[LAYER_MAX];//各段の先頭位置 ※[0] が葉の段
+};
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/static_search_tree.inl>
+
+#endif//GASHA_INCLUDED_STATIC_SEARCH_TREE_H
+
+// End of file
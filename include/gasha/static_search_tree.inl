@@ -0,0 +1,291 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_STATIC_SEARCH_TREE_INL
+#define GASHA_INCLUDED_STATIC_SEARCH_TREE_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// static_search_tree.inl
+// 静的探索木【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/static_search_tree.h>//静的探索木【宣言部】
+
+#include <cstdint>//C++11 std::int32_t, std::uint32_t
+#include <limits>//std::numeric_limits
+
+#ifdef GASHA_USE_SSE
+#include <xmmintrin.h>//SSE1
+#endif//GASHA_USE_SSE
+
+#ifdef GASHA_USE_SSE2
+#include <emmintrin.h>//SSE2
+#endif//GASHA_USE_SSE2
+
+#ifdef GASHA_USE_AVX
+#include <immintrin.h>//AVX, AVX2
+#endif//GASHA_USE_AVX
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//静的探索木
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//静的探索木のノード操作
+namespace _private
+{
+	//ノード操作：汎用
+	//※バッファに格納するキーの変換と、ノード内の比較を行う
+	template<typename KEY_TYPE>
+	struct staticSearchTreeOpe
+	{
+		typedef KEY_TYPE key_type;
+		//バッファに格納するキーに変換
+		inline static key_type encode(const key_type key){ return key; }
+		//番兵（ノードの空きを埋めるキー）
+		//※どのキーよりも小さくならない値
+		inline static key_type sentinel(){ return std::numeric_limits<key_type>::has_infinity ? std::numeric_limits<key_type>::infinity() : std::numeric_limits<key_type>::max(); }
+		//ノード内で探索キーより小さいキーの数
+		//※ノード内のキーは昇順に並んでいる
+		inline static std::size_t rank(const key_type* node, const key_type key)
+		{
+			std::size_t count = 0;
+			for (std::size_t index = 0; index < 16; ++index)
+				count += (node[index] < key ? 1 : 0);
+			return count;
+		}
+	};
+#ifdef GASHA_USE_SSE2
+	//ノード操作：std::int32_t用
+	template<>
+	struct staticSearchTreeOpe<std::int32_t>
+	{
+		typedef std::int32_t key_type;
+		inline static key_type encode(const key_type key){ return key; }
+		inline static key_type sentinel(){ return std::numeric_limits<key_type>::max(); }
+		inline static std::size_t rank(const key_type* node, const key_type key)
+		{
+		#ifdef GASHA_USE_AVX2
+			const __m256i key_v = _mm256_set1_epi32(key);
+			const __m256i lt0 = _mm256_cmpgt_epi32(key_v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(node)));
+			const __m256i lt1 = _mm256_cmpgt_epi32(key_v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(node + 8)));
+			const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(lt0))) |
+			                          static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(lt1))) << 8;
+		#else//GASHA_USE_AVX2
+			const __m128i key_v = _mm_set1_epi32(key);
+			const __m128i lt0 = _mm_cmpgt_epi32(key_v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(node)));
+			const __m128i lt1 = _mm_cmpgt_epi32(key_v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(node + 4)));
+			const __m128i lt2 = _mm_cmpgt_epi32(key_v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(node + 8)));
+			const __m128i lt3 = _mm_cmpgt_epi32(key_v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(node + 12)));
+			//32ビット×16件の比較結果を、16ビット×8件に２回詰めてバイト単位のマスクにする
+			const __m128i lt = _mm_packs_epi16(_mm_packs_epi32(lt0, lt1), _mm_packs_epi32(lt2, lt3));
+			const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(lt));
+		#endif//GASHA_USE_AVX2
+			//キーは昇順に並んでいるため、比較結果は下位から連続する
+			return searchCountTrailingOnes(mask);
+		}
+	};
+	//ノード操作：std::uint32_t用
+	//※符号ビットを反転して格納し、符号付きの比較命令で比較する
+	template<>
+	struct staticSearchTreeOpe<std::uint32_t>
+	{
+		typedef std::uint32_t key_type;
+		inline static key_type encode(const key_type key){ return key ^ 0x80000000u; }
+		inline static key_type sentinel(){ return encode(std::numeric_limits<key_type>::max()); }
+		inline static std::size_t rank(const key_type* node, const key_type key)
+		{
+			return staticSearchTreeOpe<std::int32_t>::rank(reinterpret_cast<const std::int32_t*>(node), static_cast<std::int32_t>(key));
+		}
+	};
+#endif//GASHA_USE_SSE2
+#ifdef GASHA_USE_SSE
+	//ノード操作：float用
+	template<>
+	struct staticSearchTreeOpe<float>
+	{
+		typedef float key_type;
+		inline static key_type encode(const key_type key){ return key; }
+		inline static key_type sentinel(){ return std::numeric_limits<key_type>::infinity(); }
+		inline static std::size_t rank(const key_type* node, const key_type key)
+		{
+		#ifdef GASHA_USE_AVX
+			const __m256 key_v = _mm256_set1_ps(key);
+			const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(node), key_v, _CMP_LT_OQ))) |
+			                          static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(node + 8), key_v, _CMP_LT_OQ))) << 8;
+		#else//GASHA_USE_AVX
+			const __m128 key_v = _mm_set1_ps(key);
+			const unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(node), key_v))) |
+			                          static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(node + 4), key_v))) << 4 |
+			                          static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(node + 8), key_v))) << 8 |
+			                          static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(node + 12), key_v))) << 12;
+		#endif//GASHA_USE_AVX
+			return searchCountTrailingOnes(mask);
+		}
+	};
+#endif//GASHA_USE_SSE
+}//namespace _private
+
+//----------------------------------------
+//静的探索木
+
+//段数と各段のノード数を計算
+template<typename KEY_TYPE>
+std::size_t staticSearchTree<KEY_TYPE>::calcLayers(const std::size_t size, std::size_t* nodes)
+{
+	std::size_t height = 0;
+	std::size_t num = (size + NODE_KEYS - 1) / NODE_KEYS;//葉のノード数
+	while (true)
+	{
+		if (height == LAYER_MAX)
+			return 0;
+		nodes[height++] = num;
+		if (num <= 1)
+			break;
+		num = (num + NODE_CHILDREN - 1) / NODE_CHILDREN;//上の段のノード数
+	}
+	return height;
+}
+
+//必要なバッファの要素数を計算
+template<typename KEY_TYPE>
+std::size_t staticSearchTree<KEY_TYPE>::calcBufferSize(const std::size_t size)
+{
+	if (size == 0)
+		return 0;
+	std::size_t nodes[LAYER_MAX];
+	const std::size_t height = calcLayers(size, nodes);
+	std::size_t total = 0;
+	for (std::size_t layer = 0; layer < height; ++layer)
+		total += nodes[layer];
+	return total * NODE_KEYS;
+}
+
+//構築
+template<typename KEY_TYPE>
+bool staticSearchTree<KEY_TYPE>::build(const typename staticSearchTree<KEY_TYPE>::key_type* sorted, const std::size_t size, typename staticSearchTree<KEY_TYPE>::key_type* buff, const std::size_t buff_size)
+{
+	typedef _private::staticSearchTreeOpe<key_type> ope;
+	clear();
+	if (!sorted || size == 0)
+		return size == 0;
+	std::size_t nodes[LAYER_MAX];
+	const std::size_t height = calcLayers(size, nodes);
+	if (height == 0)
+		return false;
+	//各段の先頭位置を計算 ※根の段から順に配置
+	std::size_t offset = 0;
+	for (std::size_t layer = height; layer > 0; --layer)
+	{
+		m_layerOffset[layer - 1] = offset;
+		offset += nodes[layer - 1] * NODE_KEYS;
+	}
+	if (!buff || buff_size < offset)
+		return false;
+	const key_type sentinel = ope::sentinel();
+	//葉の段：キーをそのまま並べ、末尾の空きを番兵で埋める
+	key_type* leaf = buff + m_layerOffset[0];
+	for (std::size_t index = 0; index < size; ++index)
+		leaf[index] = ope::encode(sorted[index]);
+	for (std::size_t index = size; index < nodes[0] * NODE_KEYS; ++index)
+		leaf[index] = sentinel;
+	//上位の段：j 番目のキーに、j+1 番目の子の部分木の最小キー（最も左の葉の先頭キー）を設定
+	std::size_t leaves_per_child = 1;//子の部分木あたりの葉のノード数
+	for (std::size_t layer = 1; layer < height; ++layer)
+	{
+		key_type* node = buff + m_layerOffset[layer];
+		const std::size_t children = nodes[layer - 1];//下の段のノード数
+		for (std::size_t node_index = 0; node_index < nodes[layer]; ++node_index)
+		{
+			for (std::size_t key_index = 0; key_index < NODE_KEYS; ++key_index)
+			{
+				const std::size_t child = node_index * NODE_CHILDREN + key_index + 1;
+				node[node_index * NODE_KEYS + key_index] = child < children ? leaf[child * leaves_per_child * NODE_KEYS] : sentinel;
+			}
+		}
+		leaves_per_child *= NODE_CHILDREN;
+	}
+	m_buff = buff;
+	m_buffSize = offset;
+	m_size = size;
+	m_height = height;
+	return true;
+}
+
+//クリア
+template<typename KEY_TYPE>
+inline void staticSearchTree<KEY_TYPE>::clear()
+{
+	m_buff = nullptr;
+	m_buffSize = 0;
+	m_size = 0;
+	m_height = 0;
+}
+
+//下限探索
+template<typename KEY_TYPE>
+std::size_t staticSearchTree<KEY_TYPE>::lowerBound(const typename staticSearchTree<KEY_TYPE>::key_type key) const
+{
+	typedef _private::staticSearchTreeOpe<key_type> ope;
+	if (m_size == 0)
+		return 0;
+	const key_type encoded_key = ope::encode(key);
+	//根から葉の一つ上の段まで、探索キーより小さいキーの数で子を選んで降りる
+	std::size_t node_index = 0;
+	for (std::size_t layer = m_height - 1; layer > 0; --layer)
+		node_index = node_index * NODE_CHILDREN + ope::rank(m_buff + m_layerOffset[layer] + node_index * NODE_KEYS, encoded_key);
+	//葉の段
+	//※ノード内の全てのキーが探索キーより小さい場合は、次のノードの先頭が下限になる（葉は連続しているので、そのままインデックスを足せば良い）
+	const std::size_t index = node_index * NODE_KEYS + ope::rank(m_buff + m_layerOffset[0] + node_index * NODE_KEYS, encoded_key);
+	return index < m_size ? index : m_size;
+}
+
+//探索
+template<typename KEY_TYPE>
+inline std::size_t staticSearchTree<KEY_TYPE>::find(const typename staticSearchTree<KEY_TYPE>::key_type key) const
+{
+	typedef _private::staticSearchTreeOpe<key_type> ope;
+	const std::size_t index = lowerBound(key);
+	if (index >= m_size || m_buff[m_layerOffset[0] + index] != ope::encode(key))
+		return INVALID_INDEX;
+	return index;
+}
+
+//デフォルトコンストラクタ
+template<typename KEY_TYPE>
+inline staticSearchTree<KEY_TYPE>::staticSearchTree() :
+	m_buff(nullptr),
+	m_buffSize(0),
+	m_size(0),
+	m_height(0)
+{}
+
+//コンストラクタ
+template<typename KEY_TYPE>
+inline staticSearchTree<KEY_TYPE>::staticSearchTree(const typename staticSearchTree<KEY_TYPE>::key_type* sorted, const std::size_t size, typename staticSearchTree<KEY_TYPE>::key_type* buff, const std::size_t buff_size) :
+	m_buff(nullptr),
+	m_buffSize(0),
+	m_size(0),
+	m_height(0)
+{
+	build(sorted, size, buff, buff_size);
+}
+
+//デストラクタ
+template<typename KEY_TYPE>
+inline staticSearchTree<KEY_TYPE>::~staticSearchTree()
+{}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_STATIC_SEARCH_TREE_INL
+
+// End of file
@@ -0,0 +1,186 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_STL_ALLOCATOR_H
+#define GASHA_INCLUDED_STL_ALLOCATOR_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// stl_allocator.h
+// STLアロケータ【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/i_allocator_adapter.h>//アロケータアダプタインターフェース
+
+#include <cstddef>//std::size_t, std::ptrdiff_t
+#include <type_traits>//C++11 std::true_type, std::false_type
+
+//C++17 std::pmr::memory_resource が使用可能か？
+#ifdef GASHA_HAS_CPP17
+#if defined(__has_include)
+#if __has_include(<memory_resource>)
+#define GASHA_STL_ALLOCATOR_HAS_MEMORY_RESOURCE
+#endif//__has_include(<memory_resource>)
+#endif//__has_include
+#endif//GASHA_HAS_CPP17
+
+#ifdef GASHA_STL_ALLOCATOR_HAS_MEMORY_RESOURCE
+#include <memory_resource>//C++17 std::pmr::memory_resource
+#endif//GASHA_STL_ALLOCATOR_HAS_MEMORY_RESOURCE
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//STLアロケータ
+//※STLコンテナ（std::vector, std::unordered_map など）のメモリ確保／解放を、GASHAのアロケータに委譲する。
+//※多態アロケータ（polyAllocator）でスコープを区切らなくても、コンテナ単位で確保先のアロケータを指定できる。
+//※ALLOCATOR には、アロケータアダプタインターフェース（iAllocatorAdapter）のほか、
+//　alloc(size, align) / free(p) を持つ任意のGASHAのアロケータ（stackAllocator, lfPoolAllocator など）を指定できる。
+//※アロケータは参照で保持するため、コンテナより先に破棄してはいけない。
+//※スタックアロケータなど、free() でメモリが解放されないアロケータを使用する場合、
+//　コンテナの再配置（std::vector の拡張など）に伴う解放済み領域は、アロケータをクリアするまで再利用されない点に注意。
+//--------------------------------------------------------------------------------
+//【使用例】
+//  stackAllocator_withBuff<65536> stack;
+//  auto adapter = stack.adapter();
+//  stlAllocator<int> allocator(adapter);
+//  std::vector<int, stlAllocator<int>> vec(allocator);
+//--------------------------------------------------------------------------------
+
+//----------------------------------------
+//STLアロケータクラス
+template<typename T, class ALLOCATOR = GASHA_ iAllocatorAdapter>
+class stlAllocator
+{
+	template<typename U, class A>
+	friend class stlAllocator;
+public:
+	//型
+	typedef T value_type;//値型
+	typedef T* pointer;//値のポインタ型
+	typedef const T* const_pointer;//値のポインタ型
+	typedef T& reference;//値の参照型
+	typedef const T& const_reference;//値の参照型
+	typedef std::size_t size_type;//サイズ型
+	typedef std::ptrdiff_t difference_type;//ポインタの差分型
+	typedef ALLOCATOR allocator_type;//委譲先のアロケータ型
+	//※コンテナのムーブ／スワップ時はアロケータも移動する（コピー時は移動しない）
+	typedef std::false_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+
+	//再束縛用
+	template<typename U>
+	struct rebind
+	{
+		typedef stlAllocator<U, ALLOCATOR> other;
+	};
+
+public:
+	//アクセッサ
+	inline allocator_type& allocator() const { return *m_allocator; }//委譲先のアロケータ
+
+public:
+	//オペレータ
+	template<typename U>
+	inline bool operator==(const stlAllocator<U, ALLOCATOR>& rhs) const { return m_allocator == rhs.m_allocator; }
+	template<typename U>
+	inline bool operator!=(const stlAllocator<U, ALLOCATOR>& rhs) const { return m_allocator != rhs.m_allocator; }
+
+public:
+	//メソッド
+
+	//メモリ確保
+	//※確保に失敗した場合、例外が有効なら std::bad_alloc を投げ、無効なら nullptr を返す。
+	inline pointer allocate(const size_type num, const void* hint = nullptr);
+
+	//メモリ解放
+	inline void deallocate(pointer p, const size_type num);
+
+	//確保可能な最大要素数
+	inline size_type max_size() const;
+
+	//コンストラクタ呼び出し
+	//※C++11 std::allocator_traits に対応していない環境用
+	template<typename U, typename...Tx>
+	inline void construct(U* p, Tx&&... args);
+
+	//デストラクタ呼び出し
+	//※C++11 std::allocator_traits に対応していない環境用
+	template<typename U>
+	inline void destroy(U* p);
+
+public:
+	//コンストラクタ
+	inline stlAllocator(allocator_type& allocator);
+	//コピーコンストラクタ
+	inline stlAllocator(const stlAllocator<T, ALLOCATOR>& obj);
+	//※再束縛用
+	template<typename U>
+	inline stlAllocator(const stlAllocator<U, ALLOCATOR>& obj);
+	//デストラクタ
+	inline ~stlAllocator();
+
+private:
+	//フィールド
+	allocator_type* m_allocator;//委譲先のアロケータ
+};
+
+//----------------------------------------
+//STLアロケータ作成
+//※アロケータの型を推論して作成する
+template<typename T, class ALLOCATOR>
+inline stlAllocator<T, ALLOCATOR> makeStlAllocator(ALLOCATOR& allocator);
+
+#ifdef GASHA_STL_ALLOCATOR_HAS_MEMORY_RESOURCE
+
+//----------------------------------------
+//STLメモリリソースクラス
+//※C++17 std::pmr::memory_resource として、GASHAのアロケータを使用できるようにする。
+//※std::pmr::vector などの多態アロケータ（std::pmr::polymorphic_allocator）対応コンテナで使用する。
+//※確保に失敗した場合は std::bad_alloc を投げる。（std::pmr::memory_resource の仕様）
+template<class ALLOCATOR = GASHA_ iAllocatorAdapter>
+class stlMemoryResource : public std::pmr::memory_resource
+{
+public:
+	//型
+	typedef ALLOCATOR allocator_type;//委譲先のアロケータ型
+
+public:
+	//アクセッサ
+	inline allocator_type& allocator() const { return *m_allocator; }//委譲先のアロケータ
+
+private:
+	//メモリ確保
+	inline void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+	//メモリ解放
+	inline void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+	//同値判定
+	inline bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+	//コンストラクタ
+	inline stlMemoryResource(allocator_type& allocator);
+	//コピーコンストラクタ
+	stlMemoryResource(const stlMemoryResource&) = delete;
+	//デストラクタ
+	inline ~stlMemoryResource() override;
+
+private:
+	//フィールド
+	allocator_type* m_allocator;//委譲先のアロケータ
+};
+
+#endif//GASHA_STL_ALLOCATOR_HAS_MEMORY_RESOURCE
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/stl_allocator.inl>
+
+#endif//GASHA_INCLUDED_STL_ALLOCATOR_H
+
+// End of file
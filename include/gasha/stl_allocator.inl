@@ -0,0 +1,153 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_STL_ALLOCATOR_INL
+#define GASHA_INCLUDED_STL_ALLOCATOR_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// stl_allocator.inl
+// STLアロケータ【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/stl_allocator.h>//STLアロケータ【宣言部】
+
+#include <gasha/allocator_common.h>//アロケータ共通設定・処理：コンストラクタ／デストラクタ呼び出し
+
+#include <utility>//C++11 std::forward
+#include <new>//std::bad_alloc
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//--------------------------------------------------------------------------------
+//STLアロケータクラス
+
+//メモリ確保
+template<typename T, class ALLOCATOR>
+inline typename stlAllocator<T, ALLOCATOR>::pointer stlAllocator<T, ALLOCATOR>::allocate(const typename stlAllocator<T, ALLOCATOR>::size_type num, const void* hint)
+{
+	void* p = num <= max_size() ? m_allocator->alloc(sizeof(T) * num, alignof(T)) : nullptr;
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)//例外が有効な場合
+	if (!p)
+		throw std::bad_alloc();
+#endif//__cpp_exceptions
+	return static_cast<pointer>(p);
+}
+
+//メモリ解放
+template<typename T, class ALLOCATOR>
+inline void stlAllocator<T, ALLOCATOR>::deallocate(typename stlAllocator<T, ALLOCATOR>::pointer p, const typename stlAllocator<T, ALLOCATOR>::size_type num)
+{
+	m_allocator->free(p);
+}
+
+//確保可能な最大要素数
+template<typename T, class ALLOCATOR>
+inline typename stlAllocator<T, ALLOCATOR>::size_type stlAllocator<T, ALLOCATOR>::max_size() const
+{
+	return static_cast<size_type>(-1) / sizeof(T);
+}
+
+//コンストラクタ呼び出し
+template<typename T, class ALLOCATOR>
+template<typename U, typename...Tx>
+inline void stlAllocator<T, ALLOCATOR>::construct(U* p, Tx&&... args)
+{
+	GASHA_ callConstructor<U>(p, std::forward<Tx>(args)...);
+}
+
+//デストラクタ呼び出し
+template<typename T, class ALLOCATOR>
+template<typename U>
+inline void stlAllocator<T, ALLOCATOR>::destroy(U* p)
+{
+	GASHA_ callDestructor(p);
+}
+
+//コンストラクタ
+template<typename T, class ALLOCATOR>
+inline stlAllocator<T, ALLOCATOR>::stlAllocator(typename stlAllocator<T, ALLOCATOR>::allocator_type& allocator) :
+	m_allocator(&allocator)
+{}
+
+//コピーコンストラクタ
+template<typename T, class ALLOCATOR>
+inline stlAllocator<T, ALLOCATOR>::stlAllocator(const stlAllocator<T, ALLOCATOR>& obj) :
+	m_allocator(obj.m_allocator)
+{}
+//※再束縛用
+template<typename T, class ALLOCATOR>
+template<typename U>
+inline stlAllocator<T, ALLOCATOR>::stlAllocator(const stlAllocator<U, ALLOCATOR>& obj) :
+	m_allocator(obj.m_allocator)
+{}
+
+//デストラクタ
+template<typename T, class ALLOCATOR>
+inline stlAllocator<T, ALLOCATOR>::~stlAllocator()
+{}
+
+//----------------------------------------
+//STLアロケータ作成
+template<typename T, class ALLOCATOR>
+inline stlAllocator<T, ALLOCATOR> makeStlAllocator(ALLOCATOR& allocator)
+{
+	return stlAllocator<T, ALLOCATOR>(allocator);
+}
+
+#ifdef GASHA_STL_ALLOCATOR_HAS_MEMORY_RESOURCE
+
+//--------------------------------------------------------------------------------
+//STLメモリリソースクラス
+
+//メモリ確保
+template<class ALLOCATOR>
+inline void* stlMemoryResource<ALLOCATOR>::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+	void* p = m_allocator->alloc(bytes, alignment);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+//メモリ解放
+template<class ALLOCATOR>
+inline void stlMemoryResource<ALLOCATOR>::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+{
+	m_allocator->free(p);
+}
+
+//同値判定
+//※同じアロケータに委譲するメモリリソース同士なら等しい
+template<class ALLOCATOR>
+inline bool stlMemoryResource<ALLOCATOR>::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	if (this == &other)
+		return true;
+	const stlMemoryResource<ALLOCATOR>* other_resource = dynamic_cast<const stlMemoryResource<ALLOCATOR>*>(&other);
+	return other_resource && other_resource->m_allocator == m_allocator;
+}
+
+//コンストラクタ
+template<class ALLOCATOR>
+inline stlMemoryResource<ALLOCATOR>::stlMemoryResource(typename stlMemoryResource<ALLOCATOR>::allocator_type& allocator) :
+	m_allocator(&allocator)
+{}
+
+//デストラクタ
+template<class ALLOCATOR>
+inline stlMemoryResource<ALLOCATOR>::~stlMemoryResource()
+{}
+
+#endif//GASHA_STL_ALLOCATOR_HAS_MEMORY_RESOURCE
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_STL_ALLOCATOR_INL
+
+// End of file
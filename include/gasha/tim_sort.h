@@ -0,0 +1,144 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_TIM_SORT_H
+#define GASHA_INCLUDED_TIM_SORT_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// tim_sort.h
+// ティムソート【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/sort_basic.h>//ソート処理基本
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズムの説明
+//========================================
+
+//・計算時間：
+//    - O(n)       ... データ件数分の時間
+//    - O(n ^ 2)   ... データ件数の２乗分の時間
+//    - O(log n)   ... log2(データ件数)分の時間（4→2, 16→4, 1024→10,1048576→20）
+//    - O(n log n) ... n×log n 分の時間
+//・メモリ使用量：
+//    - O(1)       ... １件分のメモリが必要
+//    - O(n)       ... データ件数分のメモリが必要
+//    - O(log n)   ... log2(データ件数)分のメモリが必要
+//・安定性：
+//    - ○         ... キーが同じデータの順序性が維持されることを保証する
+//                     例：{ 3-a, 5-b, 4-c, 5-d, 9-e, 3-f, 4-g, 3-h, 5-i } → { 3-a, 3-f, 3-h, 4-c, 4-g, 5-b, 5-d, 5-i, 9-e }
+//    - ×         ... 例：(同上)                        
+
+//========================================
+//ソートアルゴリズム分類：マージソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：ティムソート
+//----------------------------------------
+//・最良計算時間：O(n) ※整列済み／逆順の配列
+//・平均計算時間：O(n log n)
+//・最悪計算時間：O(n log n)
+//・メモリ使用量：O(n) ※作業用配列(n/2件)
+//・安定性：　　　○
+//----------------------------------------
+//※配列を先頭から走査して、整列済みの区間（ラン）を検出しながらマージしていく、適応型の自然マージソート。
+//　ほぼ整列済みの配列（時系列順のイベント列など）で特に高速。
+//※狭義の降順のランは、反転して昇順のランにする。（同値キーを含まないため、安定性は保たれる）
+//※ランが一定数（32～64件）に満たない場合は、二分挿入ソートで延長する。
+//※ランの長さのバランスを保つようにスタックで管理し、マージの回数と作業量を抑える。
+//※マージの前に、既に正しい位置にある左ランの先頭部分と右ランの末尾部分を二分探索で除外し、
+//　作業用配列には短い方のランだけを退避する。
+//※マージ中に一方のランから連続して要素が選ばれる場合、ギャロップモード（指数探索）に切り替え、
+//　まとめて移動する。
+//※作業用配列は、呼び出し元で用意するか、GASHAのアロケータから確保する。
+//　作業用配列を指定しない場合は、new で確保する。（多態アロケータ（polyAllocator）の影響を受ける）
+//※作業用配列が確保できなかった場合は、インプレースマージソートに切り替える。
+//　作業用配列の件数が足りない場合は、収まらないマージのみ回転（ローテーション）によるインプレースマージで処理する。
+//※作業用配列の要素はムーブ代入されるため、要素型はデフォルトコンストラクタとムーブ代入が可能である必要がある。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value1, const T& value2)//value1 == value2 ならtrueを返す
+//作業用配列指定版
+//※work_array には (size / 2) 件以上の配列を指定すると、全てのマージを作業用配列で行う。
+//※work_array に nullptr を指定すると、インプレースマージソートに切り替える。
+template<class T, class PREDICATE>
+std::size_t timSortWithBuff(T* array, const std::size_t size, T* work_array, const std::size_t work_size, PREDICATE predicate);
+template<class T>
+inline std::size_t timSortWithBuff(T* array, const std::size_t size, T* work_array, const std::size_t work_size);
+//アロケータ指定版
+//※作業用配列を allocator.newArray() で確保し、ソート後に deleteArray() で解放する。
+template<class T, class ALLOCATOR, class PREDICATE>
+std::size_t timSortWithAllocator(T* array, const std::size_t size, ALLOCATOR& allocator, PREDICATE predicate);
+template<class T, class ALLOCATOR>
+inline std::size_t timSortWithAllocator(T* array, const std::size_t size, ALLOCATOR& allocator);
+//ティムソート本体
+//※作業用配列を new で確保する。
+template<class T, class PREDICATE>
+std::size_t timSort(T* array, const std::size_t size, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_SORT(timSort);
+
+//ティムソートの作業用配列の必要件数
+inline std::size_t timSortWorkSize(const std::size_t size){ return size / 2; }
+
+//----------------------------------------
+//アルゴリズム：ティムソート（自然マージソート）
+//※双方向連結リスト対応版
+//----------------------------------------
+//・最良計算時間：O(n) ※整列済み／逆順のリスト
+//・平均計算時間：O(n log n)
+//・最悪計算時間：O(n log n)
+//・メモリ使用量：O(1)
+//・安定性：　　　○
+//----------------------------------------
+//※配列版と同じく、ランを検出してスタックで管理しながらマージする。
+//※ノードの連結を組み替えてマージするため、作業用配列を使用しない。
+//※隣接するランが既に正しい順序で並んでいる場合は、マージを省略する。
+//※ランダムアクセスができないため、ギャロップモードは使用しない。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value1, const T& value2)//value1 == value2 ならtrueを返す
+//・T* GET_NEXT_FUNC(T& node)//次のノードを返す
+//・T* GET_PREV_FUNC(T& node)//前のノードを返す
+//・void INSERT_NODE_BEFORE_FUNC(T& new_node, T* target_node, T*& first_ref, T*& last_ref)//target_nodeの前にnew_nodeを連結する(target_nodeがnullptrだと末尾に連結)
+//・void REMOVE_NODE_FUNC(T& target_node, T*& first_ref, T*& last_ref)//target_nodeを連結から解除する
+template<class T, class GET_NEXT_FUNC, class GET_PREV_FUNC, class INSERT_NODE_BEFORE_FUNC, class REMOVE_NODE_FUNC, class PREDICATE>
+std::size_t linkedListTimSort(T*& first, T*& last, GET_NEXT_FUNC get_next_func, GET_PREV_FUNC get_prev_func, INSERT_NODE_BEFORE_FUNC insert_node_before_func, REMOVE_NODE_FUNC remove_node_func, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_LINKED_LIST_SORT(linkedListTimSort);
+
+//----------------------------------------
+//アルゴリズム：ティムソート（自然マージソート）
+//※片方向連結リスト対応版
+//----------------------------------------
+//・最良計算時間：O(n) ※整列済み／逆順のリスト
+//・平均計算時間：O(n log n)
+//・最悪計算時間：O(n log n)
+//・メモリ使用量：O(1)
+//・安定性：　　　○
+//----------------------------------------
+//※双方向連結リスト版と同じ。
+//※ランの延長に用いる挿入ソートは、挿入先の探索をランの先頭から行う。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value1, const T& value2)//value1 == value2 ならtrueを返す
+//・T* GET_NEXT_FUNC(T& node)//次のノードを返す
+//・void INSERT_NODE_AFTER_FUNC(T& new_node, T* target_node, T*& first_ref, T*& last_ref)//target_nodeの後にnew_nodeを連結する(target_nodeがnullptrだと先頭に連結)
+//・void REMOVE_NODE_AFTER_FUNC(T& prev_target_node, T*& first_ref, T*& last_ref)//prev_target_nodeの次のノードを連結から解除する
+template<class T, class GET_NEXT_FUNC, class INSERT_NODE_AFTER_FUNC, class REMOVE_NODE_AFTER_FUNC, class PREDICATE>
+std::size_t singlyLinkedListTimSort(T*& first, T*& last, GET_NEXT_FUNC get_next_func, INSERT_NODE_AFTER_FUNC insert_node_after_func, REMOVE_NODE_AFTER_FUNC remove_node_after_func, PREDICATE predicate);
+GASHA_OVERLOAD_SET_FOR_SINGLY_LINKED_LIST_SORT(singlyLinkedListTimSort);
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/tim_sort.inl>
+
+#endif//GASHA_INCLUDED_TIM_SORT_H
+
+// End of file
@@ -0,0 +1,971 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_TIM_SORT_INL
+#define GASHA_INCLUDED_TIM_SORT_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// tim_sort.inl
+// ティムソート【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/tim_sort.h>//ティムソート【宣言部】
+
+#include <gasha/is_ordered.h>//整列状態確認
+#include <gasha/utility.h>//汎用ユーティリティ（値交換用）
+
+#include <gasha/inplace_merge_sort.h>//インプレースマージソート
+
+#include <cstddef>//std::size_t, std::ptrdiff_t
+#include <utility>//C++11 std::move
+#include <new>//std::nothrow
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズム分類：マージソート
+//========================================
+
+//----------------------------------------
+//アルゴリズム：ティムソート
+namespace _private
+{
+	static const std::size_t TIM_SORT_MIN_MERGE = 64;//ランの最小件数の計算に用いる件数（これ未満の配列は二分挿入ソートのみで処理）
+	static const std::size_t TIM_SORT_MIN_GALLOP = 7;//ギャロップモードに切り替える連続選択回数の初期値
+	static const int TIM_SORT_STACK_DEPTH_MAX = 85;//ランのスタックの最大数※ランの長さがフィボナッチ数列以上に増加するため、2^64件まで対応可能
+
+	//ランの最小件数を計算
+	//※件数をランの最小件数で割った値が、２のべき乗かそれよりわずかに小さい値になるように調整する
+	inline std::size_t timSortMinRun(std::size_t size)
+	{
+		std::size_t r = 0;
+		while (size >= TIM_SORT_MIN_MERGE)
+		{
+			r |= (size & 1);
+			size >>= 1;
+		}
+		return size + r;
+	}
+
+	//範囲の反転
+	template<class T>
+	inline void timSortReverse(T* begin, T* end)
+	{
+		for (--end; begin < end; ++begin, --end)
+			GASHA_ swapValues(*begin, *end);
+	}
+
+	//ランの検出
+	//※狭義の降順のランは反転する
+	template<class T, class PREDICATE>
+	inline std::size_t timSortCountRun(T* begin, T* end, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		T* now = begin + 1;
+		if (now == end)
+			return 1;
+		if (predicate(*now, *begin))
+		{
+			//狭義の降順
+			for (++now; now < end && predicate(*now, *(now - 1)); ++now);
+			const std::size_t run = static_cast<std::size_t>(now - begin);
+			timSortReverse(begin, now);
+			swapped_count += run / 2;
+			return run;
+		}
+		//昇順
+		for (++now; now < end && !predicate(*now, *(now - 1)); ++now);
+		return static_cast<std::size_t>(now - begin);
+	}
+
+	//二分挿入ソート
+	//※[begin, start) が整列済みであることを前提に、[start, end) の要素を挿入する
+	template<class T, class PREDICATE>
+	inline void timSortBinaryInsertion(T* begin, T* end, T* start, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		for (; start < end; ++start)
+		{
+			//挿入位置を探索（安定性のため、等しい要素の後ろに挿入）
+			T* left = begin;
+			T* right = start;
+			while (left < right)
+			{
+				T* mid = left + ((right - left) >> 1);
+				if (predicate(*start, *mid))
+					right = mid;
+				else
+					left = mid + 1;
+			}
+			if (left == start)
+				continue;
+			T tmp(std::move(*start));
+			for (T* p = start; p > left; --p)
+				*p = std::move(*(p - 1));
+			*left = std::move(tmp);
+			++swapped_count;
+		}
+	}
+
+	//ギャロップ探索（左端）
+	//※key 以上の最初の要素の位置を、hint の位置から指数探索＋二分探索で求める
+	template<class T, class PREDICATE>
+	std::size_t timSortGallopLeft(const T& key, const T* array, const std::size_t size, const std::size_t hint, PREDICATE predicate)
+	{
+		std::ptrdiff_t last_ofs = 0;
+		std::ptrdiff_t ofs = 1;
+		const std::ptrdiff_t _hint = static_cast<std::ptrdiff_t>(hint);
+		if (predicate(array[_hint], key))
+		{
+			//右方向に探索：array[hint + last_ofs] < key <= array[hint + ofs]
+			const std::ptrdiff_t max_ofs = static_cast<std::ptrdiff_t>(size) - _hint;
+			while (ofs < max_ofs && predicate(array[_hint + ofs], key))
+			{
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+			}
+			if (ofs > max_ofs)
+				ofs = max_ofs;
+			last_ofs += _hint;
+			ofs += _hint;
+		}
+		else
+		{
+			//左方向に探索：array[hint - ofs] < key <= array[hint - last_ofs]
+			const std::ptrdiff_t max_ofs = _hint + 1;
+			while (ofs < max_ofs && !predicate(array[_hint - ofs], key))
+			{
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+			}
+			if (ofs > max_ofs)
+				ofs = max_ofs;
+			const std::ptrdiff_t tmp = last_ofs;
+			last_ofs = _hint - ofs;
+			ofs = _hint - tmp;
+		}
+		//array[last_ofs] < key <= array[ofs] の範囲を二分探索
+		++last_ofs;
+		while (last_ofs < ofs)
+		{
+			const std::ptrdiff_t mid = last_ofs + ((ofs - last_ofs) >> 1);
+			if (predicate(array[mid], key))
+				last_ofs = mid + 1;
+			else
+				ofs = mid;
+		}
+		return static_cast<std::size_t>(ofs);
+	}
+
+	//ギャロップ探索（右端）
+	//※key より大きい最初の要素の位置を、hint の位置から指数探索＋二分探索で求める
+	template<class T, class PREDICATE>
+	std::size_t timSortGallopRight(const T& key, const T* array, const std::size_t size, const std::size_t hint, PREDICATE predicate)
+	{
+		std::ptrdiff_t last_ofs = 0;
+		std::ptrdiff_t ofs = 1;
+		const std::ptrdiff_t _hint = static_cast<std::ptrdiff_t>(hint);
+		if (predicate(key, array[_hint]))
+		{
+			//左方向に探索：array[hint - ofs] <= key < array[hint - last_ofs]
+			const std::ptrdiff_t max_ofs = _hint + 1;
+			while (ofs < max_ofs && predicate(key, array[_hint - ofs]))
+			{
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+			}
+			if (ofs > max_ofs)
+				ofs = max_ofs;
+			const std::ptrdiff_t tmp = last_ofs;
+			last_ofs = _hint - ofs;
+			ofs = _hint - tmp;
+		}
+		else
+		{
+			//右方向に探索：array[hint + last_ofs] <= key < array[hint + ofs]
+			const std::ptrdiff_t max_ofs = static_cast<std::ptrdiff_t>(size) - _hint;
+			while (ofs < max_ofs && !predicate(key, array[_hint + ofs]))
+			{
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+			}
+			if (ofs > max_ofs)
+				ofs = max_ofs;
+			last_ofs += _hint;
+			ofs += _hint;
+		}
+		//array[last_ofs] <= key < array[ofs] の範囲を二分探索
+		++last_ofs;
+		while (last_ofs < ofs)
+		{
+			const std::ptrdiff_t mid = last_ofs + ((ofs - last_ofs) >> 1);
+			if (predicate(key, array[mid]))
+				ofs = mid;
+			else
+				last_ofs = mid + 1;
+		}
+		return static_cast<std::size_t>(ofs);
+	}
+
+	//範囲のムーブ（前方から）
+	template<class T>
+	inline T* timSortMove(T* src, T* src_end, T* dst)
+	{
+		while (src < src_end)
+			*dst++ = std::move(*src++);
+		return dst;
+	}
+	//範囲のムーブ（後方から）
+	template<class T>
+	inline T* timSortMoveBackward(T* src, T* src_end, T* dst_end)
+	{
+		while (src < src_end)
+			*--dst_end = std::move(*--src_end);
+		return dst_end;
+	}
+
+	//範囲の回転
+	//※[begin, mid) と [mid, end) を入れ替え、新しい境界位置を返す
+	template<class T>
+	inline T* timSortRotate(T* begin, T* mid, T* end)
+	{
+		if (begin == mid)
+			return end;
+		if (mid == end)
+			return begin;
+		timSortReverse(begin, mid);
+		timSortReverse(mid, end);
+		timSortReverse(begin, end);
+		return begin + (end - mid);
+	}
+
+	//インプレースマージ
+	//※作業用配列に収まらないマージ用
+	//※長い方のランを二等分し、もう一方のランの対応する位置を二分探索して、回転で入れ替えた後、再帰的にマージする
+	template<class T, class PREDICATE>
+	void timSortMergeInplace(T* begin, T* mid, T* end, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		std::size_t left_size = static_cast<std::size_t>(mid - begin);
+		std::size_t right_size = static_cast<std::size_t>(end - mid);
+		while (left_size > 0 && right_size > 0)
+		{
+			if (left_size + right_size == 2)
+			{
+				if (predicate(*mid, *begin))
+				{
+					GASHA_ swapValues(*begin, *mid);
+					++swapped_count;
+				}
+				return;
+			}
+			T* left_cut;
+			T* right_cut;
+			if (left_size > right_size)
+			{
+				left_cut = begin + left_size / 2;
+				right_cut = mid + timSortGallopLeft(*left_cut, mid, right_size, 0, predicate);
+			}
+			else
+			{
+				right_cut = mid + right_size / 2;
+				left_cut = begin + timSortGallopRight(*right_cut, begin, left_size, 0, predicate);
+			}
+			T* new_mid = timSortRotate(left_cut, mid, right_cut);
+			swapped_count += static_cast<std::size_t>(right_cut - mid);
+			//短い方を再帰処理し、長い方をループで処理
+			const std::size_t l_size = static_cast<std::size_t>(new_mid - begin);
+			const std::size_t r_size = static_cast<std::size_t>(end - new_mid);
+			if (l_size < r_size)
+			{
+				timSortMergeInplace(begin, left_cut, new_mid, predicate, swapped_count);
+				begin = new_mid;
+				mid = right_cut;
+			}
+			else
+			{
+				timSortMergeInplace(new_mid, right_cut, end, predicate, swapped_count);
+				end = new_mid;
+				mid = left_cut;
+			}
+			left_size = static_cast<std::size_t>(mid - begin);
+			right_size = static_cast<std::size_t>(end - mid);
+		}
+	}
+
+	//ティムソートの状態
+	template<class T>
+	struct timSortState
+	{
+		struct run_t
+		{
+			T* base;//ランの先頭
+			std::size_t size;//ランの件数
+		};
+		T* work;//作業用配列
+		std::size_t workSize;//作業用配列の件数
+		std::size_t minGallop;//ギャロップモードに切り替える連続選択回数（ギャロップモードの効果に応じて増減）
+		std::size_t swappedCount;//交換回数
+		int runNum;//スタック上のランの数
+		run_t runs[TIM_SORT_STACK_DEPTH_MAX];//ランのスタック
+	};
+
+	//左ランを作業用配列に退避してマージ（左ランの方が短い場合）
+	//※a[0] は b[0] より大きく、a[a_size - 1] は b[b_size - 1] より大きいことが前提
+	template<class T, class PREDICATE>
+	void timSortMergeLo(timSortState<T>& state, T* a, std::size_t a_size, T* b, std::size_t b_size, PREDICATE predicate)
+	{
+		T* dst = a;
+		T* pa = state.work;
+		T* pb = b;
+		timSortMove(a, a + a_size, pa);
+		std::size_t min_gallop = state.minGallop;
+		//b[0] が最小
+		*dst++ = std::move(*pb++);
+		state.swappedCount += a_size;
+		if (--b_size == 0)
+			goto succeed;
+		if (a_size == 1)
+			goto copy_b;
+		while (true)
+		{
+			std::size_t a_count = 0;//左ランから連続して選ばれた回数
+			std::size_t b_count = 0;//右ランから連続して選ばれた回数
+			//１件ずつマージ
+			while (true)
+			{
+				if (predicate(*pb, *pa))
+				{
+					*dst++ = std::move(*pb++);
+					state.swappedCount += a_size;
+					++b_count;
+					a_count = 0;
+					if (--b_size == 0)
+						goto succeed;
+					if (b_count >= min_gallop)
+						break;
+				}
+				else
+				{
+					*dst++ = std::move(*pa++);
+					++a_count;
+					b_count = 0;
+					if (--a_size == 1)
+						goto copy_b;
+					if (a_count >= min_gallop)
+						break;
+				}
+			}
+			//ギャロップモード
+			//※一方のランから連続して選ばれる件数を探索し、まとめて移動する
+			++min_gallop;
+			do
+			{
+				min_gallop -= min_gallop > 1;
+				a_count = timSortGallopRight(*pb, pa, a_size, 0, predicate);
+				if (a_count)
+				{
+					dst = timSortMove(pa, pa + a_count, dst);
+					pa += a_count;
+					a_size -= a_count;
+					if (a_size == 1)
+						goto copy_b;
+					if (a_size == 0)
+						goto succeed;
+				}
+				*dst++ = std::move(*pb++);
+				state.swappedCount += a_size;
+				if (--b_size == 0)
+					goto succeed;
+				b_count = timSortGallopLeft(*pa, pb, b_size, 0, predicate);
+				if (b_count)
+				{
+					dst = timSortMove(pb, pb + b_count, dst);
+					state.swappedCount += a_size * b_count;
+					pb += b_count;
+					b_size -= b_count;
+					if (b_size == 0)
+						goto succeed;
+				}
+				*dst++ = std::move(*pa++);
+				if (--a_size == 1)
+					goto copy_b;
+			} while (a_count >= TIM_SORT_MIN_GALLOP || b_count >= TIM_SORT_MIN_GALLOP);
+			++min_gallop;//ギャロップモードを抜けたら、切り替えにくくする
+		}
+	succeed:
+		//左ランの残りを戻す
+		timSortMove(pa, pa + a_size, dst);
+		state.minGallop = min_gallop < 1 ? 1 : min_gallop;
+		return;
+	copy_b:
+		//左ランの最後の１件（右ランの残りより大きい）を末尾に置く
+		dst = timSortMove(pb, pb + b_size, dst);
+		state.swappedCount += b_size;
+		*dst = std::move(*pa);
+		state.minGallop = min_gallop < 1 ? 1 : min_gallop;
+	}
+
+	//右ランを作業用配列に退避してマージ（右ランの方が短い場合）
+	//※a[0] は b[0] より大きく、a[a_size - 1] は b[b_size - 1] より大きいことが前提
+	template<class T, class PREDICATE>
+	void timSortMergeHi(timSortState<T>& state, T* a, std::size_t a_size, T* b, std::size_t b_size, PREDICATE predicate)
+	{
+		T* work = state.work;
+		timSortMove(b, b + b_size, work);
+		T* dst_end = b + b_size;//書き込み位置の終端
+		T* pa_end = a + a_size;//左ランの未処理範囲の終端
+		T* pb_end = work + b_size;//右ランの未処理範囲の終端
+		std::size_t min_gallop = state.minGallop;
+		//a[a_size - 1] が最大
+		*--dst_end = std::move(*--pa_end);
+		state.swappedCount += b_size;
+		if (--a_size == 0)
+			goto succeed;
+		if (b_size == 1)
+			goto copy_a;
+		while (true)
+		{
+			std::size_t a_count = 0;//左ランから連続して選ばれた回数
+			std::size_t b_count = 0;//右ランから連続して選ばれた回数
+			//１件ずつマージ
+			while (true)
+			{
+				if (predicate(*(pb_end - 1), *(pa_end - 1)))
+				{
+					*--dst_end = std::move(*--pa_end);
+					state.swappedCount += b_size;
+					++a_count;
+					b_count = 0;
+					if (--a_size == 0)
+						goto succeed;
+					if (a_count >= min_gallop)
+						break;
+				}
+				else
+				{
+					*--dst_end = std::move(*--pb_end);
+					++b_count;
+					a_count = 0;
+					if (--b_size == 1)
+						goto copy_a;
+					if (b_count >= min_gallop)
+						break;
+				}
+			}
+			//ギャロップモード
+			++min_gallop;
+			do
+			{
+				min_gallop -= min_gallop > 1;
+				a_count = a_size - timSortGallopRight(*(pb_end - 1), a, a_size, a_size - 1, predicate);
+				if (a_count)
+				{
+					dst_end = timSortMoveBackward(pa_end - a_count, pa_end, dst_end);
+					state.swappedCount += b_size * a_count;
+					pa_end -= a_count;
+					a_size -= a_count;
+					if (a_size == 0)
+						goto succeed;
+				}
+				*--dst_end = std::move(*--pb_end);
+				if (--b_size == 1)
+					goto copy_a;
+				b_count = b_size - timSortGallopLeft(*(pa_end - 1), work, b_size, b_size - 1, predicate);
+				if (b_count)
+				{
+					dst_end = timSortMoveBackward(pb_end - b_count, pb_end, dst_end);
+					pb_end -= b_count;
+					b_size -= b_count;
+					if (b_size == 1)
+						goto copy_a;
+					if (b_size == 0)
+						goto succeed;
+				}
+				*--dst_end = std::move(*--pa_end);
+				state.swappedCount += b_size;
+				if (--a_size == 0)
+					goto succeed;
+			} while (a_count >= TIM_SORT_MIN_GALLOP || b_count >= TIM_SORT_MIN_GALLOP);
+			++min_gallop;//ギャロップモードを抜けたら、切り替えにくくする
+		}
+	succeed:
+		//右ランの残りを戻す
+		timSortMoveBackward(work, work + b_size, dst_end);
+		state.minGallop = min_gallop < 1 ? 1 : min_gallop;
+		return;
+	copy_a:
+		//右ランの最初の１件（左ランの残りより小さい）を先頭に置く
+		dst_end = timSortMoveBackward(a, pa_end, dst_end);
+		state.swappedCount += a_size;
+		*--dst_end = std::move(*work);
+		state.minGallop = min_gallop < 1 ? 1 : min_gallop;
+	}
+
+	//スタック上の i 番目と i + 1 番目のランをマージ
+	template<class T, class PREDICATE>
+	void timSortMergeAt(timSortState<T>& state, const int i, PREDICATE predicate)
+	{
+		T* a = state.runs[i].base;
+		std::size_t a_size = state.runs[i].size;
+		T* b = state.runs[i + 1].base;
+		std::size_t b_size = state.runs[i + 1].size;
+		state.runs[i].size = a_size + b_size;
+		if (i == state.runNum - 3)
+			state.runs[i + 1] = state.runs[i + 2];
+		--state.runNum;
+		//左ランの先頭の、既に正しい位置にある要素を除外
+		const std::size_t k = timSortGallopRight(*b, a, a_size, 0, predicate);
+		a += k;
+		a_size -= k;
+		if (a_size == 0)
+			return;
+		//右ランの末尾の、既に正しい位置にある要素を除外
+		b_size = timSortGallopLeft(a[a_size - 1], b, b_size, b_size - 1, predicate);
+		if (b_size == 0)
+			return;
+		//短い方のランを作業用配列に退避してマージ
+		if (a_size <= b_size)
+		{
+			if (a_size <= state.workSize)
+				timSortMergeLo(state, a, a_size, b, b_size, predicate);
+			else
+				timSortMergeInplace(a, b, b + b_size, predicate, state.swappedCount);
+		}
+		else
+		{
+			if (b_size <= state.workSize)
+				timSortMergeHi(state, a, a_size, b, b_size, predicate);
+			else
+				timSortMergeInplace(a, b, b + b_size, predicate, state.swappedCount);
+		}
+	}
+
+	//ランのスタックの長さのバランスを保つようにマージ
+	//※スタックの上位３件のランの長さ A, B, C（C が最上位）について、
+	//　A > B + C かつ B > C を満たすまでマージする。（さらに一つ下のランも検査し、条件の破れを防ぐ）
+	template<class T, class PREDICATE>
+	void timSortMergeCollapse(timSortState<T>& state, PREDICATE predicate)
+	{
+		while (state.runNum > 1)
+		{
+			int i = state.runNum - 2;
+			if ((i > 0 && state.runs[i - 1].size <= state.runs[i].size + state.runs[i + 1].size) ||
+			    (i > 1 && state.runs[i - 2].size <= state.runs[i - 1].size + state.runs[i].size))
+			{
+				if (state.runs[i - 1].size < state.runs[i + 1].size)
+					--i;
+				timSortMergeAt(state, i, predicate);
+			}
+			else if (state.runs[i].size <= state.runs[i + 1].size)
+				timSortMergeAt(state, i, predicate);
+			else
+				break;
+		}
+	}
+
+	//スタック上の全てのランをマージ
+	template<class T, class PREDICATE>
+	void timSortMergeForceCollapse(timSortState<T>& state, PREDICATE predicate)
+	{
+		while (state.runNum > 1)
+		{
+			int i = state.runNum - 2;
+			if (i > 0 && state.runs[i - 1].size < state.runs[i + 1].size)
+				--i;
+			timSortMergeAt(state, i, predicate);
+		}
+	}
+
+	template<class T, class PREDICATE>
+	std::size_t timSort(T* array, const std::size_t size, T* work_array, const std::size_t work_size, PREDICATE predicate)
+	{
+		timSortState<T> state;
+		state.work = work_array;
+		state.workSize = work_size;
+		state.minGallop = TIM_SORT_MIN_GALLOP;
+		state.swappedCount = 0;
+		state.runNum = 0;
+		const std::size_t min_run = timSortMinRun(size);
+		T* now = array;
+		std::size_t remain = size;
+		while (remain > 0)
+		{
+			//ランを検出
+			std::size_t run = timSortCountRun(now, now + remain, predicate, state.swappedCount);
+			//ランが短ければ、二分挿入ソートで延長
+			if (run < min_run)
+			{
+				const std::size_t force = remain < min_run ? remain : min_run;
+				timSortBinaryInsertion(now, now + force, now + run, predicate, state.swappedCount);
+				run = force;
+			}
+			//ランをスタックにプッシュしてマージ
+			state.runs[state.runNum].base = now;
+			state.runs[state.runNum].size = run;
+			++state.runNum;
+			timSortMergeCollapse(state, predicate);
+			now += run;
+			remain -= run;
+		}
+		timSortMergeForceCollapse(state, predicate);
+		return state.swappedCount;
+	}
+}//namespace _private
+template<class T, class PREDICATE>
+std::size_t timSortWithBuff(T* array, const std::size_t size, T* work_array, const std::size_t work_size, PREDICATE predicate)
+{
+	if (!array || size <= 1)
+		return 0;
+	if (GASHA_ isOrdered(array, size, predicate))
+		return 0;
+	if (!work_array)
+		return GASHA_ inplaceMergeSort(array, size, predicate);//作業用配列がない場合はインプレースマージソートに切り替え
+	return _private::timSort(array, size, work_array, work_size, predicate);
+}
+template<class T>
+inline std::size_t timSortWithBuff(T* array, const std::size_t size, T* work_array, const std::size_t work_size)
+{
+	return timSortWithBuff(array, size, work_array, work_size, less<T>());
+}
+template<class T, class ALLOCATOR, class PREDICATE>
+std::size_t timSortWithAllocator(T* array, const std::size_t size, ALLOCATOR& allocator, PREDICATE predicate)
+{
+	if (!array || size <= 1)
+		return 0;
+	if (GASHA_ isOrdered(array, size, predicate))
+		return 0;
+	const std::size_t work_size = timSortWorkSize(size);
+	T* work_array = allocator.template newArray<T>(work_size);
+	if (!work_array)
+		return GASHA_ inplaceMergeSort(array, size, predicate);//作業用配列が確保できなかった場合はインプレースマージソートに切り替え
+	const std::size_t swapped_count = _private::timSort(array, size, work_array, work_size, predicate);
+	allocator.deleteArray(work_array, work_size);
+	return swapped_count;
+}
+template<class T, class ALLOCATOR>
+inline std::size_t timSortWithAllocator(T* array, const std::size_t size, ALLOCATOR& allocator)
+{
+	return timSortWithAllocator(array, size, allocator, less<T>());
+}
+template<class T, class PREDICATE>
+std::size_t timSort(T* array, const std::size_t size, PREDICATE predicate)
+{
+	if (!array || size <= 1)
+		return 0;
+	if (GASHA_ isOrdered(array, size, predicate))
+		return 0;
+	const std::size_t work_size = timSortWorkSize(size);
+	T* work_array = new(std::nothrow) T[work_size];
+	if (!work_array)
+		return GASHA_ inplaceMergeSort(array, size, predicate);//作業用配列が確保できなかった場合はインプレースマージソートに切り替え
+	const std::size_t swapped_count = _private::timSort(array, size, work_array, work_size, predicate);
+	delete[] work_array;
+	return swapped_count;
+}
+
+//----------------------------------------
+//アルゴリズム：ティムソート（自然マージソート）
+//※双方向連結リスト対応版
+namespace _private
+{
+	//リスト版のランの情報
+	//※ランの先頭ノードは、直前のランの末尾ノードの次のノード（スタックの先頭のランはリストの先頭ノード）
+	template<class T>
+	struct linkedListTimSortRun
+	{
+		T* last;//ランの末尾ノード
+		std::size_t size;//ランの件数
+	};
+	
+	//リストのノード数を計上
+	template<class T, class GET_NEXT_FUNC>
+	inline std::size_t linkedListTimSortCount(const T* node, GET_NEXT_FUNC get_next_func)
+	{
+		std::size_t count = 0;
+		for (; node; node = get_next_func(*node))
+			++count;
+		return count;
+	}
+
+	//スタック上の i 番目と i + 1 番目のランをマージ
+	template<class T, class GET_NEXT_FUNC, class INSERT_NODE_BEFORE_FUNC, class REMOVE_NODE_FUNC, class PREDICATE>
+	void linkedListTimSortMergeAt(T*& first, T*& last, linkedListTimSortRun<T>* runs, int& run_num, const int i, GET_NEXT_FUNC get_next_func, INSERT_NODE_BEFORE_FUNC insert_node_before_func, REMOVE_NODE_FUNC remove_node_func, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		linkedListTimSortRun<T>& run_a = runs[i];
+		const linkedListTimSortRun<T>& run_b = runs[i + 1];
+		T* a = i > 0 ? const_cast<T*>(get_next_func(*runs[i - 1].last)) : first;
+		T* b = const_cast<T*>(get_next_func(*run_a.last));
+		std::size_t a_size = run_a.size;
+		std::size_t b_size = run_b.size;
+		T* merged_last = run_b.last;
+		//既に正しい順序で並んでいればマージを省略
+		if (predicate(*b, *run_a.last))
+		{
+			while (a_size > 0 && b_size > 0)
+			{
+				if (predicate(*b, *a))
+				{
+					//右ランのノードを左ランのノードの前に移動
+					T* b_next = b_size > 1 ? const_cast<T*>(get_next_func(*b)) : nullptr;
+					remove_node_func(*b, first, last);
+					insert_node_before_func(*b, a, first, last);
+					++swapped_count;
+					b = b_next;
+					--b_size;
+				}
+				else
+				{
+					a = const_cast<T*>(get_next_func(*a));
+					--a_size;
+				}
+			}
+			if (b_size == 0)
+				merged_last = run_a.last;//左ランの末尾ノードがマージ後の末尾
+		}
+		run_a.last = merged_last;
+		run_a.size += run_b.size;
+		if (i == run_num - 3)
+			runs[i + 1] = runs[i + 2];
+		--run_num;
+	}
+}//namespace _private
+template<class T, class GET_NEXT_FUNC, class GET_PREV_FUNC, class INSERT_NODE_BEFORE_FUNC, class REMOVE_NODE_FUNC, class PREDICATE>
+std::size_t linkedListTimSort(T*& first, T*& last, GET_NEXT_FUNC get_next_func, GET_PREV_FUNC get_prev_func, INSERT_NODE_BEFORE_FUNC insert_node_before_func, REMOVE_NODE_FUNC remove_node_func, PREDICATE predicate)
+{
+	if (!first || !get_next_func(*first))
+		return 0;
+	std::size_t swapped_count = 0;
+	const std::size_t min_run = _private::timSortMinRun(_private::linkedListTimSortCount(first, get_next_func));
+	_private::linkedListTimSortRun<T> runs[_private::TIM_SORT_STACK_DEPTH_MAX];
+	int run_num = 0;
+	auto merge_at = [&](const int i)
+	{
+		_private::linkedListTimSortMergeAt(first, last, runs, run_num, i, get_next_func, insert_node_before_func, remove_node_func, predicate, swapped_count);
+	};
+	T* head = first;//ランの先頭ノード
+	while (head)
+	{
+		//ランを検出
+		T* tail = head;//ランの末尾ノード
+		std::size_t run = 1;
+		T* next = const_cast<T*>(get_next_func(*tail));
+		//狭義の降順のランは、ノードをランの先頭に移動して反転
+		while (next && predicate(*next, *head))
+		{
+			remove_node_func(*next, first, last);
+			insert_node_before_func(*next, head, first, last);
+			++swapped_count;
+			head = next;
+			++run;
+			next = const_cast<T*>(get_next_func(*tail));
+		}
+		//昇順のラン
+		//※ランが短ければ、挿入ソートで延長
+		while (next)
+		{
+			if (!predicate(*next, *tail))
+				tail = next;
+			else if (run < min_run)
+			{
+				//挿入位置をランの末尾から探索
+				T* ins = tail;
+				T* prev = const_cast<T*>(get_prev_func(*tail));
+				while (ins != head && predicate(*next, *prev))
+				{
+					ins = prev;
+					prev = const_cast<T*>(get_prev_func(*prev));
+				}
+				remove_node_func(*next, first, last);
+				insert_node_before_func(*next, ins, first, last);
+				++swapped_count;
+				if (ins == head)
+					head = next;
+			}
+			else
+				break;
+			++run;
+			next = const_cast<T*>(get_next_func(*tail));
+		}
+		//ランをスタックにプッシュしてマージ
+		runs[run_num].last = tail;
+		runs[run_num].size = run;
+		++run_num;
+		while (run_num > 1)
+		{
+			int i = run_num - 2;
+			if ((i > 0 && runs[i - 1].size <= runs[i].size + runs[i + 1].size) ||
+			    (i > 1 && runs[i - 2].size <= runs[i - 1].size + runs[i].size))
+			{
+				if (runs[i - 1].size < runs[i + 1].size)
+					--i;
+				merge_at(i);
+			}
+			else if (runs[i].size <= runs[i + 1].size)
+				merge_at(i);
+			else
+				break;
+		}
+		head = next;
+	}
+	//スタック上の全てのランをマージ
+	while (run_num > 1)
+	{
+		int i = run_num - 2;
+		if (i > 0 && runs[i - 1].size < runs[i + 1].size)
+			--i;
+		merge_at(i);
+	}
+	return swapped_count;
+}
+
+//----------------------------------------
+//アルゴリズム：ティムソート（自然マージソート）
+//※片方向連結リスト対応版
+namespace _private
+{
+	//スタック上の i 番目と i + 1 番目のランをマージ
+	template<class T, class GET_NEXT_FUNC, class INSERT_NODE_AFTER_FUNC, class REMOVE_NODE_AFTER_FUNC, class PREDICATE>
+	void singlyLinkedListTimSortMergeAt(T*& first, T*& last, linkedListTimSortRun<T>* runs, int& run_num, const int i, GET_NEXT_FUNC get_next_func, INSERT_NODE_AFTER_FUNC insert_node_after_func, REMOVE_NODE_AFTER_FUNC remove_node_after_func, PREDICATE predicate, std::size_t& swapped_count)
+	{
+		linkedListTimSortRun<T>& run_a = runs[i];
+		const linkedListTimSortRun<T>& run_b = runs[i + 1];
+		T* a_prev = i > 0 ? runs[i - 1].last : nullptr;//左ランの処理中のノードの前のノード
+		T* a = a_prev ? const_cast<T*>(get_next_func(*a_prev)) : first;
+		T* b_prev = run_a.last;//右ランの処理中のノードの前のノード（左ランの末尾ノードで固定）
+		T* b = const_cast<T*>(get_next_func(*b_prev));
+		std::size_t a_size = run_a.size;
+		std::size_t b_size = run_b.size;
+		T* merged_last = run_b.last;
+		//既に正しい順序で並んでいればマージを省略
+		if (predicate(*b, *run_a.last))
+		{
+			while (a_size > 0 && b_size > 0)
+			{
+				if (predicate(*b, *a))
+				{
+					//右ランのノードを左ランのノードの前に移動
+					T* b_next = b_size > 1 ? const_cast<T*>(get_next_func(*b)) : nullptr;
+					remove_node_after_func(b_prev, first, last);
+					insert_node_after_func(*b, a_prev, first, last);
+					++swapped_count;
+					a_prev = b;
+					b = b_next;
+					--b_size;
+				}
+				else
+				{
+					a_prev = a;
+					a = const_cast<T*>(get_next_func(*a));
+					--a_size;
+				}
+			}
+			if (b_size == 0)
+				merged_last = run_a.last;//左ランの末尾ノードがマージ後の末尾
+		}
+		run_a.last = merged_last;
+		run_a.size += run_b.size;
+		if (i == run_num - 3)
+			runs[i + 1] = runs[i + 2];
+		--run_num;
+	}
+}//namespace _private
+template<class T, class GET_NEXT_FUNC, class INSERT_NODE_AFTER_FUNC, class REMOVE_NODE_AFTER_FUNC, class PREDICATE>
+std::size_t singlyLinkedListTimSort(T*& first, T*& last, GET_NEXT_FUNC get_next_func, INSERT_NODE_AFTER_FUNC insert_node_after_func, REMOVE_NODE_AFTER_FUNC remove_node_after_func, PREDICATE predicate)
+{
+	if (!first || !get_next_func(*first))
+		return 0;
+	std::size_t swapped_count = 0;
+	const std::size_t min_run = _private::timSortMinRun(_private::linkedListTimSortCount(first, get_next_func));
+	_private::linkedListTimSortRun<T> runs[_private::TIM_SORT_STACK_DEPTH_MAX];
+	int run_num = 0;
+	auto merge_at = [&](const int i)
+	{
+		_private::singlyLinkedListTimSortMergeAt(first, last, runs, run_num, i, get_next_func, insert_node_after_func, remove_node_after_func, predicate, swapped_count);
+	};
+	T* head_prev = nullptr;//ランの先頭ノードの前のノード
+	T* head = first;//ランの先頭ノード
+	while (head)
+	{
+		//ランを検出
+		T* tail = head;//ランの末尾ノード
+		std::size_t run = 1;
+		T* next = const_cast<T*>(get_next_func(*tail));
+		//狭義の降順のランは、ノードをランの先頭に移動して反転
+		while (next && predicate(*next, *head))
+		{
+			remove_node_after_func(tail, first, last);
+			insert_node_after_func(*next, head_prev, first, last);
+			++swapped_count;
+			head = next;
+			++run;
+			next = const_cast<T*>(get_next_func(*tail));
+		}
+		//昇順のラン
+		//※ランが短ければ、挿入ソートで延長
+		while (next)
+		{
+			if (!predicate(*next, *tail))
+				tail = next;
+			else if (run < min_run)
+			{
+				//挿入位置をランの先頭から探索
+				T* ins_prev = head_prev;
+				T* ins = head;
+				while (!predicate(*next, *ins))
+				{
+					ins_prev = ins;
+					ins = const_cast<T*>(get_next_func(*ins));
+				}
+				remove_node_after_func(tail, first, last);
+				insert_node_after_func(*next, ins_prev, first, last);
+				++swapped_count;
+				if (ins == head)
+					head = next;
+			}
+			else
+				break;
+			++run;
+			next = const_cast<T*>(get_next_func(*tail));
+		}
+		//ランをスタックにプッシュしてマージ
+		runs[run_num].last = tail;
+		runs[run_num].size = run;
+		++run_num;
+		while (run_num > 1)
+		{
+			int i = run_num - 2;
+			if ((i > 0 && runs[i - 1].size <= runs[i].size + runs[i + 1].size) ||
+			    (i > 1 && runs[i - 2].size <= runs[i - 1].size + runs[i].size))
+			{
+				if (runs[i - 1].size < runs[i + 1].size)
+					--i;
+				merge_at(i);
+			}
+			else if (runs[i].size <= runs[i + 1].size)
+				merge_at(i);
+			else
+				break;
+		}
+		head_prev = runs[run_num - 1].last;
+		head = next;
+	}
+	//スタック上の全てのランをマージ
+	while (run_num > 1)
+	{
+		int i = run_num - 2;
+		if (i > 0 && runs[i - 1].size < runs[i + 1].size)
+			--i;
+		merge_at(i);
+	}
+	return swapped_count;
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_TIM_SORT_INL
+
+// End of file
@@ -0,0 +1,124 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_TOP_K_H
+#define GASHA_INCLUDED_TOP_K_H
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// top_k.h
+// 上位k件の逐次選択【宣言部】
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/binary_heap.h>//二分ヒープ（ヒープ操作関数）
+#include <gasha/sort_basic.h>//ソート処理基本（大小比較用）
+
+#include <cstddef>//std::size_t
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//========================================
+//ソートアルゴリズム分類：選択アルゴリズム
+//========================================
+
+//----------------------------------------
+//アルゴリズム：上位k件の逐次選択（ストリーミング top-k）
+//----------------------------------------
+//・プッシュ計算時間：O(log k) ※k=保持する件数
+//・メモリ使用量：O(k) ※固定長の内部バッファ
+//・安定性：　　　×
+//----------------------------------------
+//※逐次プッシュされる値のうち、PREDICATE で比較して大きい方から K 件を保持する。
+//　全データを配列に貯めずに、ランキングの上位 K 件を取得したい場合などに使用する。
+//※二分ヒープ（binary_heap）のヒープ操作関数を用いて、保持している中で最も小さい値を
+//　根とするヒープを構成する。満杯時は、根より大きい値がプッシュされた時だけ根を入れ替える。
+//※内部バッファの並び順はヒープ順（不定）。整列した結果が必要な場合は copySorted() を使用する。
+//※スレッドセーフではない。
+//----------------------------------------
+//プロトタイプ：
+//・bool PREDICATE(const T& value1, const T& value2)//value1 < value2 ならtrueを返す
+//----------------------------------------
+//【使用例】
+//  topK<int, 10> top10;
+//  for (auto value : values)
+//      top10.push(value);
+//  int ranking[10];
+//  const std::size_t num = top10.copySorted(ranking, 10);//大きい順にコピー
+//----------------------------------------
+template<typename T, std::size_t _K, class PREDICATE = GASHA_ less<T> >
+class topK
+{
+public:
+	//型
+	typedef T value_type;//値型
+	typedef PREDICATE predicate_type;//プレディケート型
+	typedef std::size_t size_type;//サイズ型
+	//二分ヒープ操作型
+	struct ope : public binary_heap::baseOpe<ope, _K, T>
+	{};
+	//ヒープ用プレディケート
+	//※根が最小値になるように、大小を逆転して比較する
+	struct heapPredicate
+	{
+		inline bool operator()(const value_type& lhs, const value_type& rhs) const { return m_predicate(rhs, lhs); }
+		inline heapPredicate(const predicate_type& predicate) :
+			m_predicate(predicate)
+		{}
+		const predicate_type& m_predicate;
+	};
+public:
+	//定数
+	static const size_type K = _K;//保持する件数
+public:
+	//アクセッサ
+	inline size_type size() const { return m_used; }//保持している件数
+	inline size_type capacity() const { return K; }//保持できる件数
+	inline bool empty() const { return m_used == 0; }//空か？
+	inline bool full() const { return m_used == K; }//満杯か？
+	inline const value_type* begin() const { return _refTop(); }//先頭（ヒープ順）
+	inline const value_type* end() const { return _refTop() + m_used; }//終端（ヒープ順）
+	//保持している中で最も小さい値
+	//※満杯時は、これより大きい値でなければ保持されない
+	//※空の場合は nullptr を返す
+	inline const value_type* bottom() const { return m_used == 0 ? nullptr : _refTop(); }
+private:
+	inline const value_type* _refTop() const { return reinterpret_cast<const value_type*>(m_table); }
+	inline value_type* _refTop(){ return reinterpret_cast<value_type*>(m_table); }
+public:
+	//メソッド
+	//プッシュ
+	//※値を保持した場合 true を返す
+	inline bool push(const value_type& value);
+	inline bool push(value_type&& value);
+	//保持しているか判定
+	//※プッシュした場合に値が保持されるか？
+	inline bool isAcceptable(const value_type& value) const;
+	//大きい順にコピー
+	//※コピーした件数を返す
+	//※内部バッファの並び順が変わるため const ではない（保持している値は変わらない）
+	std::size_t copySorted(value_type* dst, const std::size_t dst_size);
+	//クリア
+	void clear();
+public:
+	//コンストラクタ
+	inline topK(const predicate_type& predicate = predicate_type());
+	//デストラクタ
+	inline ~topK();
+private:
+	//フィールド
+	alignas(value_type) unsigned char m_table[K][sizeof(value_type)];//内部バッファ
+	size_type m_used;//保持している件数
+	predicate_type m_predicate;//プレディケート
+};
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+//.hファイルのインクルードに伴い、常に.inlファイルを自動インクルード
+#include <gasha/top_k.inl>
+
+#endif//GASHA_INCLUDED_TOP_K_H
+
+// End of file
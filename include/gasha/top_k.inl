@@ -0,0 +1,120 @@
+﻿#pragma once
+#ifndef GASHA_INCLUDED_TOP_K_INL
+#define GASHA_INCLUDED_TOP_K_INL
+
+//--------------------------------------------------------------------------------
+// 【テンプレートライブラリ】
+// top_k.inl
+// 上位k件の逐次選択【インライン関数／テンプレート関数定義部】
+//
+// ※基本的に明示的なインクルードの必要はなし。（.h ファイルの末尾でインクルード）
+//
+// Gakimaru's standard library for C++ - GASHA
+//   Copyright (c) 2014 Itagaki Mamoru
+//   Released under the MIT license.
+//     https://github.com/gakimaru/gasha/blob/master/LICENSE
+//--------------------------------------------------------------------------------
+
+#include <gasha/top_k.h>//上位k件の逐次選択【宣言部】
+
+#include <gasha/allocator_common.h>//アロケータ共通設定・処理：コンストラクタ／デストラクタ呼び出し
+#include <gasha/pdq_sort.h>//パターン打破クイックソート
+
+#include <utility>//C++11 std::move
+
+GASHA_NAMESPACE_BEGIN;//ネームスペース：開始
+
+//----------------------------------------
+//上位k件の逐次選択
+
+//プッシュ
+template<typename T, std::size_t _K, class PREDICATE>
+inline bool topK<T, _K, PREDICATE>::push(const typename topK<T, _K, PREDICATE>::value_type& value)
+{
+	value_type* top = _refTop();
+	if (m_used < K)
+	{
+		value_type* obj = GASHA_ callConstructor<value_type>(top + m_used, value);
+		++m_used;
+		binary_heap::upHeap<ope>(top, m_used, obj, heapPredicate(m_predicate));
+		return true;
+	}
+	if (K == 0 || !m_predicate(*top, value))
+		return false;
+	*top = value;
+	binary_heap::downHeap<ope>(top, m_used, top, heapPredicate(m_predicate));
+	return true;
+}
+template<typename T, std::size_t _K, class PREDICATE>
+inline bool topK<T, _K, PREDICATE>::push(typename topK<T, _K, PREDICATE>::value_type&& value)
+{
+	value_type* top = _refTop();
+	if (m_used < K)
+	{
+		value_type* obj = GASHA_ callConstructor<value_type>(top + m_used, std::move(value));
+		++m_used;
+		binary_heap::upHeap<ope>(top, m_used, obj, heapPredicate(m_predicate));
+		return true;
+	}
+	if (K == 0 || !m_predicate(*top, value))
+		return false;
+	*top = std::move(value);
+	binary_heap::downHeap<ope>(top, m_used, top, heapPredicate(m_predicate));
+	return true;
+}
+
+//保持しているか判定
+template<typename T, std::size_t _K, class PREDICATE>
+inline bool topK<T, _K, PREDICATE>::isAcceptable(const typename topK<T, _K, PREDICATE>::value_type& value) const
+{
+	if (m_used < K)
+		return true;
+	return K > 0 && m_predicate(*_refTop(), value);
+}
+
+//大きい順にコピー
+//※内部バッファを昇順に整列してからコピーする
+//　（昇順に整列した配列は、根が最小値のヒープの条件を満たすので、整列後もそのまま使用できる）
+template<typename T, std::size_t _K, class PREDICATE>
+std::size_t topK<T, _K, PREDICATE>::copySorted(typename topK<T, _K, PREDICATE>::value_type* dst, const std::size_t dst_size)
+{
+	if (!dst || dst_size == 0)
+		return 0;
+	value_type* top = _refTop();
+	GASHA_ pdqSort(top, m_used, m_predicate);
+	const std::size_t num = m_used < dst_size ? m_used : dst_size;
+	const value_type* src = top + m_used;
+	for (std::size_t index = 0; index < num; ++index)
+		dst[index] = *(--src);
+	return num;
+}
+
+//クリア
+template<typename T, std::size_t _K, class PREDICATE>
+void topK<T, _K, PREDICATE>::clear()
+{
+	value_type* top = _refTop();
+	for (std::size_t index = 0; index < m_used; ++index)
+		ope::callDestructor(top + index);
+	m_used = 0;
+}
+
+//コンストラクタ
+template<typename T, std::size_t _K, class PREDICATE>
+inline topK<T, _K, PREDICATE>::topK(const typename topK<T, _K, PREDICATE>::predicate_type& predicate) :
+	m_used(0),
+	m_predicate(predicate)
+{}
+
+//デストラクタ
+template<typename T, std::size_t _K, class PREDICATE>
+inline topK<T, _K, PREDICATE>::~topK()
+{
+	clear();
+}
+
+GASHA_NAMESPACE_END;//ネームスペース：終了
+
+#endif//GASHA_INCLUDED_TOP_K_INL
+
+// End of file